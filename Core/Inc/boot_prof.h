@@ -0,0 +1,144 @@
+/*
+ * boot_prof.h
+ *
+ * Boot-phase profiler and fast boot helpers
+ * Every boot phase is stamped with the DWT cycle counter into a record in the
+ * RAM2 no-init section, so the profile of the previous boot is still there
+ * after a warm reset and both are printed once the reader is polling. The
+ * fast boot path pulses the PN5180 reset before the MCU peripherals are
+ * initialised, the front-end boots in parallel and phhalHw_Pn5180_Init only
+ * waits for BUSY
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_BOOT_PROF_H_
+#define INC_BOOT_PROF_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define BOOT_PROF_MAGIC             0x424F4F54UL    /* "BOOT", record survived the reset */
+#define BOOT_PROF_NOT_REACHED       0xFFFFFFFFUL    /* Phase never stamped on this boot */
+
+#define BOOT_FAST_RESET_LOW_US      20U     /* RST low time of the early pulse, datasheet minimum 10 us */
+#define BOOT_FAST_PN5180_BOOT_US    2500U   /* Front-end firmware start-up after RST goes high */
+#define BOOT_FAST_PN5180_TIMEOUT_US 20000U  /* BUSY still high after this: fall back to the full HAL reset */
+
+/* ================== Types ================== */
+
+/* Each phase is stamped when it ends, BOOT_PHASE_MAIN is the time origin */
+typedef enum {
+    BOOT_PHASE_MAIN = 0,                    /* main() entered, DWT started */
+    BOOT_PHASE_HAL_INIT,                    /* HAL_Init */
+    BOOT_PHASE_CLOCK,                       /* SystemClock_Config, PLL at 80 MHz */
+    BOOT_PHASE_PERIPH,                      /* MX_*_Init (and the early PN5180 reset pulse) */
+    BOOT_PHASE_BANNER,                      /* Banner and RAM budget report on USART1 */
+    BOOT_PHASE_BEEP,                        /* Boot beep */
+    BOOT_PHASE_BAL,                         /* phApp_CPU_Init, phbalReg_Init, phNfcLib_SetContext */
+    BOOT_PHASE_NFCLIB,                      /* phNfcLib_Init, including the PN5180 HAL reset */
+    BOOT_PHASE_DRBG,                        /* DRBG seeded from the hardware RNG */
+    BOOT_PHASE_COMP,                        /* phApp_Comp_Init */
+    BOOT_PHASE_IRQ,                         /* phApp_Configure_IRQ */
+    BOOT_PHASE_PROFILE,                     /* LoadProfile, listen mode setup, field off */
+    BOOT_PHASE_FIRST_POLL,                  /* First phacDiscLoop_Run starts */
+    BOOT_PHASE_COUNT
+} BootProf_Phase_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t boot_count;                    /* Boots since the record was last invalid (power-on) */
+    uint32_t fast;                          /* Built with BOOT_FAST */
+    uint32_t t_us[BOOT_PHASE_COUNT];        /* End of each phase after main(), BOOT_PROF_NOT_REACHED if not stamped */
+    uint32_t check;                         /* Over all words above */
+} BootProf_Record_t;
+
+/* ================== Profiler ================== */
+
+/**
+ * @brief Start the profile of this boot
+ *
+ * First call in main(). Starts the DWT cycle counter, keeps a record that
+ * survived the reset as the previous boot and opens a new one.
+ *
+ * @param fast Non-zero when the fast boot path is built in
+ */
+void BootProf_Start(uint8_t fast);
+
+/**
+ * @brief Stamp the end of a phase
+ *
+ * A phase keeps its first stamp, calling this from a loop only costs the
+ * check.
+ *
+ * @param phase Phase that just ended
+ */
+void BootProf_Mark(BootProf_Phase_t phase);
+
+/**
+ * @brief Record of this boot
+ */
+const BootProf_Record_t *BootProf_Current(void);
+
+/**
+ * @brief Record of the boot before the last warm reset
+ * @return NULL after power-on or BootProf_Clear
+ */
+const BootProf_Record_t *BootProf_Previous(void);
+
+/**
+ * @brief Duration of a phase
+ * @param rec Record
+ * @param phase Phase
+ * @return Microseconds since the latest earlier phase that was stamped,
+ *         BOOT_PROF_NOT_REACHED when the phase itself was not
+ */
+uint32_t BootProf_PhaseUs(const BootProf_Record_t *rec, BootProf_Phase_t phase);
+
+/**
+ * @brief Name of a phase for the report
+ */
+const char *BootProf_PhaseName(BootProf_Phase_t phase);
+
+/**
+ * @brief Print this boot and the previous one side by side
+ */
+void BootProf_Report(void);
+
+/**
+ * @brief Drop both records, the next boot starts counting from 1
+ */
+void BootProf_Clear(void);
+
+/* ================== Fast boot ================== */
+
+/**
+ * @brief Reset pulse on the PN5180 before the MCU peripherals are initialised
+ *
+ * Configures RST as output, holds it low BOOT_FAST_RESET_LOW_US and releases
+ * it. The front-end firmware starts while MX_*_Init, the banner and the
+ * reader library initialisation run.
+ */
+void BootFast_Pn5180Reset(void);
+
+/**
+ * @brief Wait for the front-end after the early reset pulse
+ *
+ * Called once by phhalHw_Pn5180_Init in place of its own reset. Waits for
+ * BOOT_FAST_PN5180_BOOT_US after the release and then for BUSY low.
+ *
+ * @return 1 when the front-end is ready, 0 when there was no early pulse or BUSY
+ *         stayed high, the HAL then does its full reset
+ */
+uint8_t BootFast_Pn5180WaitReady(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_BOOT_PROF_H_ */
@@ -0,0 +1,220 @@
+/*
+ * cmd_plan.h
+ *
+ * On-device command plans for phNfcLib_Transmit / phNfcLib_Receive
+ * A plan is a compact bytecode uploaded once by the Linux host, the reader
+ * runs all its exchanges back to back while the card is in the field and
+ * returns the captured bytes in a single result frame
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_CMD_PLAN_H_
+#define INC_CMD_PLAN_H_
+
+#include "phNfcLib.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define CMD_PLAN_MAX_LEN            256U    /* Bytecode bytes of a loaded plan */
+#define CMD_PLAN_RX_SIZE            256U    /* Response of the last exchange */
+#define CMD_PLAN_MAX_STEPS          2048U   /* Executed instructions, bounds plans that loop */
+#define CMD_PLAN_OUT_SIZE           512U    /* Captured bytes returned to the host */
+#define CMD_PLAN_UPLOAD_TIMEOUT_MS  1000U
+
+/* Linux frames, same [AA 55][CMD][LEN_H][LEN_L][DATA][0D 0A] layout as the EMV link */
+#define CMD_PLAN_LINUX_CMD_UPLOAD   0x20    /* Host -> reader: DATA is the plan */
+#define CMD_PLAN_LINUX_CMD_RESULT   0x21    /* Reader -> host: see CmdPlan_BuildResultFrame */
+#define CMD_PLAN_RESULT_HEADER      10U     /* Result DATA bytes ahead of the captured bytes */
+
+/*
+ * Bytecode, multi-byte operands are big endian, jump targets are plan offsets
+ *
+ *   END                                    Plan done
+ *   XCHG    kind cmd arg_h arg_l cnt n tx[n]   One phNfcLib_Transmit + phNfcLib_Receive
+ *   EXPECT_OK                              Fail unless the last exchange succeeded
+ *   EXPECT_LEN  min_h min_l max_h max_l    Fail unless min <= response length <= max
+ *   BR      cond idx mask val tgt_h tgt_l  Jump when the condition holds
+ *   JMP     tgt_h tgt_l
+ *   CAPTURE off len                        Append response[off..off+len) to the output, len 0: up to the end
+ *   SET_I   val_h val_l                    Loop index I
+ *   LOOP    step lim_h lim_l tgt_h tgt_l   I += step, jump while I < lim
+ *   FAIL    code                           End with CMD_PLAN_ERR_ABORT and a plan defined code
+ *
+ * XCHG kind selects the phNfcLib_Transmit metadata, arg and cnt fill it:
+ *   RAW     tx is the ISO14443-3/-4 frame, cmd/arg/cnt unused
+ *   MFUL    bCommand = cmd, bPageNumber = arg, pBuffer = tx
+ *   MFC     bCommand = cmd, bBlockNumber = arg low, bKeyNumber = arg high, bKeyType = cnt, pBuffer = tx
+ *   I15693  bCommand = cmd, wBlockNumber = arg, wNumBlocks = cnt, pBuffer = tx
+ * With CMD_PLAN_KIND_ADD_I the loop index is added to arg.
+ */
+#define CMD_PLAN_OP_END             0x00U
+#define CMD_PLAN_OP_XCHG            0x01U
+#define CMD_PLAN_OP_EXPECT_OK       0x02U
+#define CMD_PLAN_OP_EXPECT_LEN      0x03U
+#define CMD_PLAN_OP_BR              0x04U
+#define CMD_PLAN_OP_JMP             0x05U
+#define CMD_PLAN_OP_CAPTURE         0x06U
+#define CMD_PLAN_OP_SET_I           0x07U
+#define CMD_PLAN_OP_LOOP            0x08U
+#define CMD_PLAN_OP_FAIL            0x09U
+
+#define CMD_PLAN_KIND_RAW           0x00U
+#define CMD_PLAN_KIND_MFUL          0x01U
+#define CMD_PLAN_KIND_MFC           0x02U
+#define CMD_PLAN_KIND_I15693        0x03U
+#define CMD_PLAN_KIND_ADD_I         0x80U
+
+#define CMD_PLAN_COND_BYTE_EQ       0x00U   /* (response[idx] & mask) == val */
+#define CMD_PLAN_COND_BYTE_NE       0x01U   /* (response[idx] & mask) != val */
+#define CMD_PLAN_COND_OK            0x02U   /* Last exchange succeeded, idx/mask/val unused */
+#define CMD_PLAN_COND_ERR           0x03U   /* Last exchange failed */
+#define CMD_PLAN_COND_LEN_LT        0x04U   /* Response length < val */
+
+/* Result codes, DATA[0] of the result frame */
+typedef enum {
+    CMD_PLAN_OK = 0,
+    CMD_PLAN_ERR_FORMAT,                    /* Truncated instruction, bad opcode/kind/cond, target off an instruction */
+    CMD_PLAN_ERR_EXCHANGE,                  /* EXPECT_OK on a failed exchange */
+    CMD_PLAN_ERR_LENGTH,                    /* EXPECT_LEN out of range */
+    CMD_PLAN_ERR_RANGE,                     /* BR or CAPTURE beyond the response */
+    CMD_PLAN_ERR_OVERFLOW,                  /* Output buffer full */
+    CMD_PLAN_ERR_STEPS,                     /* CMD_PLAN_MAX_STEPS reached */
+    CMD_PLAN_ERR_ABORT,                     /* FAIL instruction */
+    CMD_PLAN_ERR_NO_PLAN                    /* Nothing loaded */
+} CmdPlan_Code_t;
+
+/* ================== Types ================== */
+
+/* One decoded XCHG, arg already includes the loop index */
+typedef struct {
+    uint8_t kind;
+    uint8_t cmd;
+    uint16_t arg;
+    uint8_t cnt;
+    uint8_t tx_len;
+    const uint8_t *tx;
+} CmdPlan_Xchg_t;
+
+/**
+ * Exchange backend, rx_len is the buffer size on entry and the response length on return
+ */
+typedef phNfcLib_Status_t (*CmdPlan_ExchangeFct_t)(void *ctx, const CmdPlan_Xchg_t *x,
+                                                   uint8_t *rx, uint16_t *rx_len);
+
+typedef struct {
+    CmdPlan_Code_t code;
+    uint16_t pc;                            /* Offset of the instruction that ended the plan */
+    uint16_t steps;
+    uint16_t exchanges;
+    uint16_t out_len;
+    uint8_t fail_code;                      /* Operand of FAIL */
+    phNfcLib_Status_t last_status;
+} CmdPlan_Result_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Check a plan before it is loaded or run
+ *
+ * Every instruction must be complete, opcodes, kinds and conditions known and
+ * every jump target must be the first byte of an instruction.
+ *
+ * @param plan Bytecode
+ * @param len Bytecode length, at most CMD_PLAN_MAX_LEN
+ * @param bad_pc Offset of the first faulty instruction, may be NULL
+ * @return CMD_PLAN_OK or CMD_PLAN_ERR_FORMAT
+ */
+CmdPlan_Code_t CmdPlan_Validate(const uint8_t *plan, uint16_t len, uint16_t *bad_pc);
+
+/**
+ * @brief Validate a plan and keep a copy for CmdPlan_Run
+ * @return CMD_PLAN_OK or CMD_PLAN_ERR_FORMAT, a faulty plan leaves the loaded one unchanged
+ */
+CmdPlan_Code_t CmdPlan_Load(const uint8_t *plan, uint16_t len);
+
+/**
+ * @brief Select the exchange backend, NULL restores phNfcLib_Transmit / phNfcLib_Receive
+ */
+void CmdPlan_SetExchange(CmdPlan_ExchangeFct_t fct, void *ctx);
+
+/**
+ * @brief UID used by ISO15693 exchanges, the simplified API always sends them addressed
+ */
+void CmdPlan_SetUid(const uint8_t *uid);
+
+/**
+ * @brief Run a validated plan against the activated card
+ *
+ * No validation is repeated here, plans come from CmdPlan_Load or were
+ * checked with CmdPlan_Validate by the caller.
+ *
+ * @param plan Bytecode
+ * @param len Bytecode length
+ * @param out Captured bytes
+ * @param out_size Size of out
+ * @param result Code, failing instruction and counters
+ * @return result->code
+ */
+CmdPlan_Code_t CmdPlan_Execute(const uint8_t *plan, uint16_t len, uint8_t *out, uint16_t out_size,
+                               CmdPlan_Result_t *result);
+
+/**
+ * @brief Run the loaded plan, see CmdPlan_Execute
+ */
+CmdPlan_Code_t CmdPlan_Run(uint8_t *out, uint16_t out_size, CmdPlan_Result_t *result);
+
+/**
+ * @brief A plan has been loaded and CmdPlan_Run will execute it
+ */
+uint8_t CmdPlan_IsLoaded(void);
+
+/**
+ * @brief Build the result frame for the host
+ *
+ * DATA = [code][pc 2][exchanges 2][fail_code][last phNfcLib status 4][captured bytes], big endian
+ *
+ * @return Frame length, 0 when frame_size is too small
+ */
+uint16_t CmdPlan_BuildResultFrame(const CmdPlan_Result_t *result, const uint8_t *out,
+                                  uint8_t *frame, uint16_t frame_size);
+
+/**
+ * @brief Wait for a CMD_PLAN_LINUX_CMD_UPLOAD frame and load its plan
+ *
+ * The reader answers with a result frame carrying the validation code and,
+ * for a faulty plan, the offending offset in pc.
+ *
+ * @param timeout_ms Wait for the frame
+ * @return CMD_PLAN_OK, CMD_PLAN_ERR_FORMAT, or CMD_PLAN_ERR_NO_PLAN on timeout
+ */
+CmdPlan_Code_t CmdPlan_ReceiveFromHost(uint32_t timeout_ms);
+
+/**
+ * @brief Run the loaded plan on the activated card and send the result frame to the host
+ * @return Result code of the run
+ */
+CmdPlan_Code_t CmdPlan_RunAndReport(void);
+
+/**
+ * @brief UART command dispatch, call while the reader is idle
+ *
+ * Bytes collected by the USART1 RX interrupt that start with AA are taken as
+ * a host frame: the interrupt is paused, the frame is completed with
+ * CmdPlan_ReceiveFromHost and its result frame sent. Anything else is console
+ * input and is dropped.
+ *
+ * @return 1 when a host frame was handled
+ */
+uint8_t CmdPlan_PollHost(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_CMD_PLAN_H_ */
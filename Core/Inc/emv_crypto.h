@@ -0,0 +1,56 @@
+/*
+ * emv_crypto.h
+ *
+ * SHA-1 and RSA public key operation for EMV offline data authentication
+ * Plain C, sized for the EMV key lengths (up to 1984 bit)
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_EMV_CRYPTO_H_
+#define INC_EMV_CRYPTO_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define EMV_RSA_MAX_BYTES       248     /* 1984 bit, largest EMV CA key */
+#define EMV_RSA_MAX_WORDS       (EMV_RSA_MAX_BYTES / 4)
+#define EMV_SHA1_LEN            20
+
+/* ================== SHA-1 ================== */
+typedef struct {
+    uint32_t state[5];
+    uint32_t count;             /* Bytes hashed so far */
+    uint8_t block[64];
+} EMV_Sha1_Ctx_t;
+
+void EMV_Sha1_Init(EMV_Sha1_Ctx_t *ctx);
+void EMV_Sha1_Update(EMV_Sha1_Ctx_t *ctx, const uint8_t *data, uint16_t len);
+void EMV_Sha1_Final(EMV_Sha1_Ctx_t *ctx, uint8_t digest[EMV_SHA1_LEN]);
+
+/* ================== RSA ================== */
+
+/**
+ * @brief RSA public key operation out = in ^ exp mod mod (Montgomery)
+ * @param mod Modulus, big endian, odd
+ * @param mod_len Modulus length in bytes, at most EMV_RSA_MAX_BYTES
+ * @param exp Public exponent, big endian (EMV uses 3 or 65537)
+ * @param exp_len Exponent length in bytes (1..3)
+ * @param in Input, big endian, mod_len bytes, must be smaller than the modulus
+ * @param out Result, big endian, mod_len bytes (may be the same buffer as in)
+ * @return 0 on success, -1 on invalid parameters
+ */
+int EMV_Rsa_Public(const uint8_t *mod, uint16_t mod_len,
+                   const uint8_t *exp, uint8_t exp_len,
+                   const uint8_t *in, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_EMV_CRYPTO_H_ */
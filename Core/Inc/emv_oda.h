@@ -0,0 +1,126 @@
+/*
+ * emv_oda.h
+ *
+ * On-device EMV offline data authentication (SDA / DDA / fDDA)
+ * Certificates come from the records in EMV_Complete_Card_Data_t, recovered
+ * issuer keys are cached so a repeat tap of the same issuer skips the RSA work
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_EMV_ODA_H_
+#define INC_EMV_ODA_H_
+
+#include "emv_transaction.h"
+#include "emv_crypto.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define EMV_ODA_MAX_CA_KEYS         8       /* CA public keys known to the terminal */
+#define EMV_ODA_ISSUER_CACHE_SIZE   4       /* Recovered issuer public keys kept in RAM */
+
+/* Terminal values put into the PDOL / DDOL besides 9F37, 9F02, 5F2A and 9C */
+#define EMV_ODA_TERMINAL_COUNTRY    0x0156  /* 9F1A, n3 BCD */
+#define EMV_ODA_TERMINAL_TYPE       0x22    /* 9F35, attended, offline with online capability */
+#define EMV_ODA_TERMINAL_TTQ        {0x36, 0x00, 0x40, 0x00} /* 9F66, qVSDC, online PIN, signature, CDCVM */
+
+/* ================== Types ================== */
+typedef enum {
+    EMV_ODA_NONE = 0,
+    EMV_ODA_SDA,
+    EMV_ODA_DDA,
+    EMV_ODA_FDDA
+} EMV_ODA_Method_t;
+
+typedef enum {
+    EMV_ODA_OK = 0,             /* Card data authenticated */
+    EMV_ODA_FAILED,             /* Certificate or signature check failed */
+    EMV_ODA_NO_CA_KEY,          /* CA key of the card not loaded on the device */
+    EMV_ODA_NOT_SUPPORTED       /* Card data incomplete or no ODA method in the AIP */
+} EMV_ODA_Result_t;
+
+/* CA public key, the modulus stays in the caller's memory (normally flash) */
+typedef struct {
+    uint8_t rid[5];             /* Registered application provider ID */
+    uint8_t index;              /* CA public key index (tag 8F) */
+    const uint8_t *modulus;     /* Big endian */
+    uint16_t modulus_len;       /* Bytes, up to EMV_RSA_MAX_BYTES */
+    uint8_t exponent[3];
+    uint8_t exponent_len;
+} EMV_ODA_CaKey_t;
+
+/* Terminal data sent in the GPO for fDDA (PDOL values of 9F37, 9F02, 5F2A) */
+typedef struct {
+    uint8_t unpredictable_number[4];
+    uint8_t amount[6];          /* n12 BCD */
+    uint8_t currency[2];        /* n3 BCD */
+} EMV_ODA_TerminalData_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Register a CA public key
+ * @param key CA key, must stay valid while registered
+ * @return 0 on success, -1 if the table is full
+ */
+int EMV_ODA_AddCaKey(const EMV_ODA_CaKey_t *key);
+
+/**
+ * @brief Unpredictable number (9F37) from the reader library DRBG
+ * @param un Random bytes
+ * @param len Number of bytes
+ * @return 0 on success, -1 if the DRBG failed
+ */
+int EMV_ODA_Unpredictable(uint8_t *un, uint16_t len);
+
+/**
+ * @brief Terminal data of the transaction, as sent in the GPO
+ * @param card Card data, unpredictable_number, amount and currency_code are used
+ * @param terminal Filled in
+ */
+void EMV_ODA_GetTerminalData(const EMV_Complete_Card_Data_t *card, EMV_ODA_TerminalData_t *terminal);
+
+/**
+ * @brief PDOL related data for the GPO command
+ *
+ * Values for the PDOL (tag 9F38) of the SELECT response, tags the terminal
+ * has no value for are zero filled.
+ *
+ * @param card Card data, the unpredictable number must already be set
+ * @param out PDOL related data, the value of tag 83
+ * @param out_size Size of out
+ * @return Data length (0 without a PDOL), -1 if it does not fit
+ */
+int EMV_ODA_BuildPdol(const EMV_Complete_Card_Data_t *card, uint8_t *out, uint16_t out_size);
+
+/**
+ * @brief Authenticate the card data read so far
+ *
+ * Picks fDDA when the GPO returned signed dynamic data, else DDA or SDA from
+ * the AIP. DDA sends INTERNAL AUTHENTICATE to the card.
+ *
+ * @param card Card data (select response, GPO response and records)
+ * @param terminal Terminal data used in the GPO, see EMV_ODA_GetTerminalData.
+ *                 NULL leaves fDDA to the host, DDA then draws a new unpredictable number
+ * @param method Method that was used
+ * @return EMV_ODA_Result_t
+ */
+EMV_ODA_Result_t EMV_ODA_Authenticate(const EMV_Complete_Card_Data_t *card,
+                                      const EMV_ODA_TerminalData_t *terminal,
+                                      EMV_ODA_Method_t *method);
+
+/**
+ * @brief Drop all cached issuer public keys
+ */
+void EMV_ODA_ClearIssuerCache(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_EMV_ODA_H_ */
@@ -51,8 +51,35 @@ typedef enum {
     LINUX_CMD_ONLINE_PROCESSING = 0x14,     /* Online Processing */
     LINUX_CMD_ISSUER_AUTH = 0x15,          /* Issuer Authentication */
     LINUX_CMD_SCRIPT_PROCESSING = 0x16,     /* Script Processing */
+    LINUX_CMD_RECORD_UPLINK = 0x17,         /* Application record, streamed while reading */
+    LINUX_CMD_BATCH_DECISION = 0x18,        /* All host decisions of a tap in one round trip */
 } Linux_Command_t;
 
+/* ================== Batched Host Decisioning ================== */
+/*
+ * Request data:  [STAGES][AMOUNT(4)][CURRENCY(2)][TYPE][ODA][UID_LEN][UID]
+ *                [SEL_LEN(2)][SELECT RESP][GPO_LEN(2)][GPO RESP][IA_LEN(2)][INTERNAL AUTH RESP]
+ *                ODA = 1 when verified on the device, 0xFF when left to the host
+ * Response data: [DECIDED][one Linux_Response_t per requested stage, lowest bit first]
+ *                [AUTH_LEN(2)][AUTH RESP][SCRIPT_LEN(2)][SCRIPTS]
+ * Records are not repeated, they were streamed with LINUX_CMD_RECORD_UPLINK.
+ */
+#define EMV_STAGE_OFFLINE_DATA_AUTH     0x01
+#define EMV_STAGE_PROCESS_RESTRICTIONS  0x02
+#define EMV_STAGE_TERMINAL_RISK_MGMT    0x04
+#define EMV_STAGE_TERMINAL_ACTION       0x08
+#define EMV_STAGE_ONLINE_PROCESSING     0x10
+#define EMV_STAGE_ISSUER_AUTH           0x20
+#define EMV_STAGE_SCRIPT_PROCESSING     0x40
+#define EMV_STAGE_COUNT                 7
+
+#define EMV_LINUX_BATCH_ENABLE          1       /* 0: one blocking exchange per stage as before */
+#define EMV_LINUX_BATCH_TIMEOUT_MS      3000    /* No reply: stages fall back to the per-stage path */
+
+/* Decided on the device, never sent to the host */
+#define EMV_TERMINAL_FLOOR_LIMIT        10000U  /* Cents, above this the transaction goes online */
+#define EMV_TERMINAL_MAX_AMOUNT         9999999U /* Cents, processing restrictions upper bound */
+
 /* ================== Linux Response Code Definitions ================== */
 typedef enum {
     LINUX_RESP_SUCCESS = 0x00,
@@ -77,6 +104,10 @@ typedef struct {
     uint8_t risk_management_result;         /* Risk management result */
     uint8_t terminal_action_result;         /* Terminal action analysis result */
 
+    /* Batched host decisioning */
+    uint8_t batch_decided;                  /* EMV_STAGE_xxx bits answered by the host */
+    uint8_t batch_decision[EMV_STAGE_COUNT]; /* Linux_Response_t per stage bit */
+
     /* Online processing */
     uint8_t online_decision;                /* Online decision */
     uint8_t authorization_response[256];    /* Authorization response */
@@ -89,6 +120,10 @@ typedef struct {
     /* Error handling */
     EMV_Result_t last_error;                /* Last error */
     uint8_t retry_count;                    /* Retry count */
+    EMV_Payment_State_t failed_state;       /* First state that did not complete */
+
+    /* Tearing recovery */
+    uint8_t resuming;                       /* Re-tap of a torn transaction, see emv_resume.h */
 
 } EMV_Payment_Context_t;
 
@@ -171,6 +206,27 @@ Linux_Response_t EMV_SendToLinux(Linux_Command_t cmd,
  */
 Linux_Response_t EMV_FormatAndSendLinuxCommand(Linux_Command_t cmd, EMV_Payment_Context_t *context);
 
+/**
+ * @brief Ask the host for several stage decisions in one exchange
+ * @param context Context, decisions land in batch_decided / batch_decision
+ * @param stages EMV_STAGE_xxx bits
+ * @param ia_data INTERNAL AUTHENTICATE response for host side ODA (may be NULL)
+ * @param ia_len Length of ia_data
+ * @return EMV_SUCCESS, or EMV_ERROR_COMMUNICATION when the host did not answer
+ */
+EMV_Result_t EMV_Batch_RequestDecisions(EMV_Payment_Context_t *context, uint8_t stages,
+                                        const uint8_t *ia_data, uint16_t ia_len);
+
+/**
+ * @brief Queue an application record for the Linux host, sent in the background
+ * @param sfi Short file identifier
+ * @param record Record number
+ * @param data Record data
+ * @param data_len Record data length, at most 256
+ * @return 0 if queued, -1 if the uplink ring had no room (frame dropped)
+ */
+int EMV_QueueRecordToLinux(uint8_t sfi, uint8_t record, const uint8_t *data, uint16_t data_len);
+
 EMV_Result_t EMV_InternalAuthenticate(uint8_t *auth_data, uint16_t auth_data_len,
                                      uint8_t *response, uint16_t *response_len);
 
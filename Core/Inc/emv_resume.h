@@ -0,0 +1,146 @@
+/*
+ * emv_resume.h
+ *
+ * Tearing-tolerant EMV transaction resume
+ * When the card leaves the field halfway through the payment flow, the
+ * static card data read so far (AID, PDOL, records) is kept for a short
+ * window, keyed by UID, amount, the AID and PDOL of the SELECT response and
+ * a digest of the static part of the GPO response (AIP, AFL). A tear during
+ * application selection keeps the AID of the PPSE directory. On
+ * re-presentation the flow selects the cached AID directly without PPSE,
+ * always runs a fresh GPO (ATC and cryptograms are never reused) and only
+ * reads the records that were not read before the tear
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_EMV_RESUME_H_
+#define INC_EMV_RESUME_H_
+
+#include "emv_payment_flow.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define EMV_RESUME_ENABLE           1       /* 0: every tap runs the full flow */
+#define EMV_RESUME_WINDOW_MS        10000U  /* Re-tap later than this after the tear starts over */
+#define EMV_RESUME_MAX_AID          16U
+#define EMV_RESUME_MAX_PDOL         64U     /* Longer PDOLs are not kept */
+#define EMV_RESUME_MAX_RECORDS      10U     /* As EMV_Complete_Card_Data_t */
+
+/* ================== Types ================== */
+typedef struct {
+    uint32_t saved;                         /* Torn transactions kept */
+    uint32_t resumed;                       /* Re-taps that reused cached records */
+    uint32_t expired;                       /* Entry older than the window on re-tap */
+    uint32_t mismatched;                    /* UID, amount, SELECT, GPO or PAN record differed */
+    uint32_t records_reused;                /* READ RECORD commands not sent again */
+} EMV_Resume_Stats_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Keep the static data of a torn transaction
+ *
+ * Called when the flow fails with a card communication error. Before the
+ * application was selected only the highest priority AID of the PPSE
+ * directory is kept, nothing when the PPSE did not answer; a re-tap that
+ * tears again before it got further only restarts the window of the entry
+ * it was resuming.
+ *
+ * @param context Payment context, failed_state is the first incomplete state
+ * @param now_ms HAL_GetTick()
+ */
+void EMV_Resume_Save(const EMV_Payment_Context_t *context, uint32_t now_ms);
+
+/**
+ * @brief Check whether a newly activated card continues the torn transaction
+ *
+ * The UID has to match unless it is a random UID (4 bytes, first byte 08),
+ * then the record carrying the PAN is read again before anything is reused.
+ * An expired or non-matching entry is dropped.
+ *
+ * @param card Card data with UID, amount and currency of the new tap
+ * @param now_ms HAL_GetTick()
+ * @return 1 when the flow resumes, the entry stays armed until EMV_Resume_Clear
+ */
+uint8_t EMV_Resume_Lookup(const EMV_Complete_Card_Data_t *card, uint32_t now_ms);
+
+/**
+ * @brief AID selected before the tear or found in the PPSE, selected again directly
+ * @param aid_len AID length
+ * @return AID, NULL when no entry is armed
+ */
+const uint8_t *EMV_Resume_Aid(uint8_t *aid_len);
+
+/**
+ * @brief First state that did not complete before the tear
+ */
+EMV_Payment_State_t EMV_Resume_FailedState(void);
+
+/**
+ * @brief Compare AID and PDOL of the new SELECT response with the cached ones
+ *
+ * The rest of the FCI (label, language, issuer data) is not compared, AIP
+ * and AFL are checked after the GPO. An entry from a tear before SELECT
+ * only has the AID to compare.
+ *
+ * @return 1 on match, else 0 and the entry is dropped
+ */
+uint8_t EMV_Resume_MatchSelect(const EMV_Complete_Card_Data_t *card);
+
+/**
+ * @brief Compare AIP and AFL of the fresh GPO response with the cached digest
+ *
+ * The dynamic GPO data (ATC, cryptogram, SDAD) is not part of the digest.
+ *
+ * @return 1 on match or when the tear came before the GPO, else 0 and the entry is dropped
+ */
+uint8_t EMV_Resume_MatchGpo(const EMV_Complete_Card_Data_t *card);
+
+/**
+ * @brief Record to read again before the cached records are used
+ * @param sfi Short file identifier
+ * @param record Record number
+ * @param data Cached R-APDU including SW1 SW2
+ * @param len Its length
+ * @return 1 for a random UID, 0 when the UID already identifies the card
+ */
+uint8_t EMV_Resume_PanRecord(uint8_t *sfi, uint8_t *record, const uint8_t **data, uint16_t *len);
+
+/**
+ * @brief Copy the cached records into the card data of the new tap
+ * @param card Card data, select and GPO responses are left untouched
+ * @return Records restored
+ */
+uint8_t EMV_Resume_Restore(EMV_Complete_Card_Data_t *card);
+
+/**
+ * @brief All records were read before the tear, READ_APP_DATA can be skipped
+ */
+uint8_t EMV_Resume_RecordsComplete(void);
+
+/**
+ * @brief Drop the entry because the card did not match
+ */
+void EMV_Resume_Drop(void);
+
+/**
+ * @brief Drop the entry, transaction approved or declined
+ */
+void EMV_Resume_Clear(void);
+
+/**
+ * @brief Counters since reset
+ */
+const EMV_Resume_Stats_t *EMV_Resume_GetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_EMV_RESUME_H_ */
@@ -0,0 +1,111 @@
+/*
+ * emv_sched.h
+ *
+ * Cooperative background tasks for the EMV flow
+ * Runs registered tasks while an APDU is in flight on the RF interface
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_EMV_SCHED_H_
+#define INC_EMV_SCHED_H_
+
+#include "ph_Status.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define EMV_SCHED_MAX_TASKS         4       /* Maximum number of background tasks */
+#define EMV_SCHED_APDU_RX_MAX       512     /* Buffer for chained R-APDUs */
+#define EMV_UPLINK_BUF_SIZE         1024    /* UART uplink ring buffer size */
+
+/* Background task, must return quickly and never block on the RF interface */
+typedef void (*EMV_Sched_TaskFn_t)(void *ctx);
+
+/* ================== Scheduler ================== */
+
+/**
+ * @brief Register a background task
+ * @param fn Task function
+ * @param ctx Task context
+ * @return 0 on success, -1 if the task table is full
+ */
+int EMV_Sched_RegisterTask(EMV_Sched_TaskFn_t fn, void *ctx);
+
+/**
+ * @brief Remove a background task registered with the same function and context
+ * @param fn Task function
+ * @param ctx Task context
+ */
+void EMV_Sched_UnregisterTask(EMV_Sched_TaskFn_t fn, void *ctx);
+
+/**
+ * @brief Run every registered task once
+ */
+void EMV_Sched_RunOnce(void);
+
+/**
+ * @brief Exchange an APDU with the card, running background tasks while the card is busy
+ *
+ * Chained card responses are collected into an internal buffer, so *rx_buffer
+ * stays valid until the next call.
+ *
+ * @param apdu C-APDU
+ * @param apdu_len C-APDU length
+ * @param rx_buffer Pointer to R-APDU
+ * @param rx_len R-APDU length
+ * @return phStatus_t of the ISO14443-4 exchange
+ */
+phStatus_t EMV_Sched_ExchangeApdu(uint8_t *apdu, uint16_t apdu_len,
+                                  uint8_t **rx_buffer, uint16_t *rx_len);
+
+/* ================== UART Uplink ================== */
+
+/**
+ * @brief Start streaming queued data to the host as a background task
+ * @note USART1 is shared with DEBUG_PRINTF. While the uplink runs, __io_putchar hands
+ *       the text to EMV_Uplink_PutChar so that it only appears between frames.
+ */
+void EMV_Uplink_Start(void);
+
+/**
+ * @brief Queue a complete frame for the host
+ * @param data Frame
+ * @param len Frame length
+ * @return len, or 0 if the uplink is not started or the ring has no room for the
+ *         whole frame. Nothing is queued then and the frame counts as dropped.
+ */
+uint16_t EMV_Uplink_Queue(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Queue one character of debug output
+ * @param ch Character
+ * @return 1 if the uplink owns the UART (the character is queued, or dropped while
+ *         the ring is full), 0 if the caller writes the UART itself
+ */
+int EMV_Uplink_PutChar(uint8_t ch);
+
+/**
+ * @brief Number of frames EMV_Uplink_Queue dropped for lack of room since reset
+ */
+uint32_t EMV_Uplink_Dropped(void);
+
+/**
+ * @brief Send all queued data, the uplink stays started
+ */
+void EMV_Uplink_Drain(void);
+
+/**
+ * @brief Send all queued data and stop the uplink task
+ */
+void EMV_Uplink_Flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_EMV_SCHED_H_ */
@@ -11,7 +11,9 @@
 #include "phacDiscLoop.h"
 #include "phpalI14443p4.h"
 #include "phNfcLib.h"
+#if defined(STM32L431xx)
 #include "main.h"
+#endif
 #include <stdint.h>
 
 /* EMV结果代码枚举 */
@@ -59,12 +61,15 @@ typedef struct {
     // 应用记录数据
     uint8_t sfi_records[10][256];  // 最多10个记录
     uint16_t sfi_record_lens[10];
+    uint8_t sfi_record_sfi[10];    // 记录所在的SFI
+    uint8_t sfi_record_num[10];    // 记录号
     uint8_t sfi_record_count;
 
     // 交易参数
     uint32_t amount;
     uint16_t currency_code;
     uint8_t transaction_type;
+    uint8_t unpredictable_number[4];  // 9F37, GPO前由DRBG生成, DDA/fDDA使用
 
 } EMV_Complete_Card_Data_t;
 /* 主要接口函数声明 */
@@ -147,6 +152,7 @@ EMV_Result_t EMV_SendCompleteDataToLinux(EMV_Complete_Card_Data_t *card_data);
 EMV_Result_t EMV_WaitForLinuxResult(EMV_Complete_Card_Data_t *card_data);
 void EMV_ShowSuccessIndication(void);
 void EMV_ShowFailureIndication(void);
+void EMV_ShowCardTooSlowIndication(void);
 
 /* 常用的EMV常量定义 */
 
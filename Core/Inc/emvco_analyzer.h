@@ -0,0 +1,130 @@
+/*
+ * emvco_analyzer.h
+ *
+ * EMVCo loopback analyzer
+ * Each exchange of the EMVCo digital loopback (NfcrdlibEx1_EmvcoProfile.c)
+ * is timestamped with the DWT cycle counter. Round-trip time, S(WTX)
+ * requests, R(NAK) and I-Block retransmissions counted by phpalI14443p4_Sw
+ * and RF resets are collected per reporting window and sent to the Linux
+ * host as one binary frame every EMVCO_ANALYZER_REPORT_MS
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_EMVCO_ANALYZER_H_
+#define INC_EMVCO_ANALYZER_H_
+
+#include "ph_Status.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define EMVCO_ANALYZER_REPORT_MS        1000U   /* Summary period, also sent between activations */
+#define EMVCO_ANALYZER_RTT_BINS         16U     /* Bin 0: < 256 us, bin n: [2^(n+7), 2^(n+8)) us, last bin open */
+#define EMVCO_ANALYZER_RTT_MIN_LOG2     8U
+#define EMVCO_ANALYZER_EVENT_BINS       5U      /* Events per exchange: 0, 1, 2, 3, 4 or more */
+
+/*
+ * Linux frame, same [AA 55][CMD][LEN_H][LEN_L][DATA][0D 0A] layout as the EMV link,
+ * multi-byte fields big endian:
+ *
+ *   [VER][SEQ(2)][PERIOD_MS(4)][EXCHANGES(4)][ERRORS(4)][RF_RESETS(2)][LOOPBACKS(2)]
+ *   [WTX(4)][NAK(4)][RETRANSMIT(4)][TX_BYTES(4)][RX_BYTES(4)]
+ *   [RTT_MIN_US(4)][RTT_MAX_US(4)][RTT_SUM_US(4)]
+ *   [RTT_BINS][RTT_HIST(2) x RTT_BINS][EVENT_BINS][WTX_HIST(2) x EVENT_BINS][RETRY_HIST(2) x EVENT_BINS]
+ *
+ * Counters cover one window, histogram bins saturate at 0xFFFF. RTT_MIN_US is
+ * 0xFFFFFFFF for a window without exchanges.
+ */
+#define EMVCO_ANALYZER_LINUX_CMD_SUMMARY 0x30   /* Reader -> host */
+#define EMVCO_ANALYZER_VERSION          1U
+#define EMVCO_ANALYZER_SUMMARY_LEN      (51U + 1U + 2U * EMVCO_ANALYZER_RTT_BINS + 1U + 4U * EMVCO_ANALYZER_EVENT_BINS)
+#define EMVCO_ANALYZER_FRAME_LEN        (EMVCO_ANALYZER_SUMMARY_LEN + 7U)
+
+/* ================== Types ================== */
+typedef struct {
+    uint32_t exchanges;                     /* phpalI14443p4_Exchange calls of the loopback */
+    uint32_t errors;                        /* Exchanges that did not return PH_ERR_SUCCESS */
+    uint32_t rf_resets;
+    uint32_t loopbacks;                     /* Activations that entered the loopback */
+    uint32_t wtx;                           /* S(WTX) answered */
+    uint32_t naks;                          /* R(NAK) sent by the reader */
+    uint32_t retransmits;                   /* I-Blocks sent again on the card's request */
+    uint32_t tx_bytes;                      /* C-APDU bytes */
+    uint32_t rx_bytes;                      /* R-APDU bytes */
+    uint32_t rtt_min_us;
+    uint32_t rtt_max_us;
+    uint32_t rtt_sum_us;
+    uint16_t rtt_hist[EMVCO_ANALYZER_RTT_BINS];
+    uint16_t wtx_hist[EMVCO_ANALYZER_EVENT_BINS];
+    uint16_t retry_hist[EMVCO_ANALYZER_EVENT_BINS];  /* R(NAK) plus retransmissions */
+} EmvcoAnalyzer_Window_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Start the analyzer, first window opens
+ * @param pPalDataParams phpalI14443p4_Sw data parameters, its statistics are cleared
+ */
+void EmvcoAnalyzer_Init(void *pPalDataParams);
+
+/**
+ * @brief Stamp the start of a loopback exchange, right before phpalI14443p4_Exchange
+ */
+void EmvcoAnalyzer_Begin(void);
+
+/**
+ * @brief Account the exchange started by EmvcoAnalyzer_Begin
+ *
+ * Reads and clears the phpalI14443p4_Sw statistics, so each exchange sees only
+ * its own S(WTX), R(NAK) and retransmissions. Sends the summary when the
+ * window is over, after the exchange has been timed.
+ *
+ * @param status Status of phpalI14443p4_Exchange
+ * @param tx_len C-APDU length
+ * @param rx_len R-APDU length, 0 on error
+ */
+void EmvcoAnalyzer_End(phStatus_t status, uint16_t tx_len, uint16_t rx_len);
+
+/**
+ * @brief A loopback session started after activation
+ */
+void EmvcoAnalyzer_Loopback(void);
+
+/**
+ * @brief Field off / on of EmvcoRfReset
+ */
+void EmvcoAnalyzer_RfReset(void);
+
+/**
+ * @brief Send the summary when the window is over, from the poll loop
+ */
+void EmvcoAnalyzer_Poll(void);
+
+/**
+ * @brief Current window
+ */
+const EmvcoAnalyzer_Window_t *EmvcoAnalyzer_Window(void);
+
+/**
+ * @brief Build the summary frame of the current window
+ * @param frame Output, at least EMVCO_ANALYZER_FRAME_LEN bytes
+ * @param frame_size Size of frame
+ * @return Frame length, 0 if frame is too small
+ */
+uint16_t EmvcoAnalyzer_BuildSummary(uint8_t *frame, uint16_t frame_size);
+
+/**
+ * @brief Summaries sent since EmvcoAnalyzer_Init
+ */
+uint16_t EmvcoAnalyzer_Sequence(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_EMVCO_ANALYZER_H_ */
@@ -0,0 +1,108 @@
+/*
+ * feedback.h
+ *
+ * Buzzer / LED feedback scheduler
+ * A pattern is a table of steps (outputs, duration). Feedback_Play applies
+ * the first step and arms TIM7 in one-pulse mode for its duration, the
+ * update interrupt applies the next step and re-arms the timer. The CPU is
+ * only involved at the edges, the poll loop never waits for a pattern. A
+ * new pattern replaces the one playing
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_FEEDBACK_H_
+#define INC_FEEDBACK_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define FEEDBACK_TICK_HZ            10000U  /* TIM7 counter clock, a step lasts at most 6553 ms */
+#define FEEDBACK_STEP_MAX_MS        6000U
+#define FEEDBACK_IRQ_PRIORITY       7U      /* Below the PN5180 IRQ and TIM2 (5) */
+
+/* Step outputs */
+#define FEEDBACK_OUT_OFF            0x00U
+#define FEEDBACK_OUT_BUZZER         0x01U   /* TIM1 CH4 PWM on PA11 */
+#define FEEDBACK_OUT_LED            0x02U   /* FEEDBACK_LED_GPIO_Port / FEEDBACK_LED_Pin when the board has one */
+#define FEEDBACK_OUT_ON             (FEEDBACK_OUT_BUZZER | FEEDBACK_OUT_LED)
+
+/* ================== Types ================== */
+typedef enum {
+    FEEDBACK_NONE = 0,                      /* Nothing playing, Feedback_Play(FEEDBACK_NONE) stops */
+    FEEDBACK_BOOT,                          /* One 300 ms beep */
+    FEEDBACK_SUCCESS,                       /* Two beeps, transaction approved */
+    FEEDBACK_FAILURE,                       /* Three short beeps, declined or aborted */
+    FEEDBACK_TOO_SLOW,                      /* Short, short, long: card left the field during the transaction */
+    FEEDBACK_REMOVE_CARD,                   /* Short beep every second until replaced or stopped */
+    FEEDBACK_COUNT
+} Feedback_Pattern_t;
+
+typedef struct {
+    uint8_t outputs;                        /* FEEDBACK_OUT_* */
+    uint16_t ms;                            /* 1..FEEDBACK_STEP_MAX_MS */
+} Feedback_Step_t;
+
+typedef struct {
+    uint32_t plays;
+    uint32_t preempted;                     /* Pattern replaced before its last step */
+    uint32_t completed;
+    uint32_t edges;                         /* Timer interrupts, the only CPU time a pattern takes */
+} Feedback_Stats_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Set up TIM7 and its interrupt, outputs off
+ *
+ * After MX_TIM1_Init. The blocking beep_start may still be used before the
+ * first Feedback_Play.
+ */
+void Feedback_Init(void);
+
+/**
+ * @brief Start a pattern, the one playing is cut off
+ *
+ * Returns after the first edge, from the poll loop or the EMV flow.
+ *
+ * @param pattern Pattern, FEEDBACK_NONE switches the outputs off
+ */
+void Feedback_Play(Feedback_Pattern_t pattern);
+
+/**
+ * @brief Stop the pattern playing, outputs off
+ */
+void Feedback_Stop(void);
+
+/**
+ * @brief Pattern playing, FEEDBACK_NONE when idle
+ */
+Feedback_Pattern_t Feedback_Current(void);
+
+/**
+ * @brief Length of one run of a pattern
+ * @param pattern Pattern
+ * @return Milliseconds, one period for a repeating pattern
+ */
+uint32_t Feedback_PatternMs(Feedback_Pattern_t pattern);
+
+/**
+ * @brief Counters since Feedback_Init
+ */
+const Feedback_Stats_t *Feedback_GetStats(void);
+
+/**
+ * @brief Step timer expired, from TIM7_IRQHandler
+ */
+void Feedback_OnTimer(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_FEEDBACK_H_ */
@@ -0,0 +1,112 @@
+/*
+ * felica_batch.h
+ *
+ * FeliCa batch engine
+ * Multi-card polling with time slots (424 kbit/s first, then 212 kbit/s) and
+ * Read / Write Without Encryption over arbitrary service/block lists, packed
+ * into as few commands as the card accepts
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_FELICA_BATCH_H_
+#define INC_FELICA_BATCH_H_
+
+#include "ph_Status.h"
+#include "phpalFelica.h"
+#include "phalFelica.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define FELICA_BATCH_MAX_CARDS          8U      /* Cards reported by one poll */
+#define FELICA_BATCH_POLL_ROUNDS        6U      /* ReqC rounds per data rate */
+#define FELICA_BATCH_GUARD_TIME_US      20400U  /* Field on to first ReqC */
+#define FELICA_BATCH_MAX_SERVICES       16U     /* Services per command, JIS X 6319-4 */
+#define FELICA_BATCH_MAX_FRAME          254U    /* LEN byte limit of a FeliCa frame */
+#define FELICA_BATCH_BLOCK_SIZE         16U
+
+/* Blocks per command when the card type is not known, reduced automatically on "illegal number of blocks" */
+#define FELICA_BATCH_DEFAULT_READ_BLOCKS    15U
+#define FELICA_BATCH_DEFAULT_WRITE_BLOCKS   11U
+
+#define FELICA_BATCH_RATE_212           0U
+#define FELICA_BATCH_RATE_424           1U
+
+/* ================== Types ================== */
+typedef struct {
+    uint8_t idm_pmm[16];
+    uint8_t rate;                       /* FELICA_BATCH_RATE_xxx the card answered at */
+} FelicaBatch_Card_t;
+
+typedef struct {
+    uint16_t service;                   /* Service code as sent on air (little endian) */
+    uint16_t block;
+} FelicaBatch_Item_t;
+
+typedef struct {
+    uint8_t max_blocks;                 /* Blocks per command that the card accepted */
+    uint8_t commands;
+    uint16_t blocks;                    /* Blocks transferred */
+    uint32_t elapsed_ms;
+} FelicaBatch_Stats_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Poll all FeliCa cards of a system code
+ *
+ * ReqC rounds start with 4 time slots and go up to 16 while collisions are
+ * reported. Cards are polled at 424 kbit/s first, cards that only answer at
+ * 212 kbit/s are added by a second pass.
+ *
+ * @param pPal FeliCa PAL
+ * @param system_code System code, 0xFF 0xFF for all
+ * @param cards Cards found
+ * @param pCount Number of cards found
+ * @return PH_ERR_SUCCESS, PH_ERR_IO_TIMEOUT when no card answered, or the HAL error
+ */
+phStatus_t FelicaBatch_Poll(phpalFelica_Sw_DataParams_t *pPal, const uint8_t system_code[2],
+                            FelicaBatch_Card_t cards[FELICA_BATCH_MAX_CARDS], uint8_t *pCount);
+
+/**
+ * @brief Address a polled card with the following commands, at the rate it was found at
+ * @param pPal FeliCa PAL
+ * @param card Card from FelicaBatch_Poll
+ * @return PH_ERR_SUCCESS or the HAL error
+ */
+phStatus_t FelicaBatch_SelectCard(phpalFelica_Sw_DataParams_t *pPal, const FelicaBatch_Card_t *card);
+
+/**
+ * @brief Read blocks with Read Without Encryption, as many per command as the card accepts
+ * @param pAl FeliCa AL of the selected card
+ * @param items Service / block pairs, any order and any number of services
+ * @param count Number of items
+ * @param data Block data, 16 bytes per item in item order
+ * @param stats Commands used and blocks per command
+ * @return PH_ERR_SUCCESS, PHAL_FELICA_ERR_FELICA with the status flags in the AL, or the PAL error
+ */
+phStatus_t FelicaBatch_Read(phalFelica_Sw_DataParams_t *pAl, const FelicaBatch_Item_t *items, uint16_t count,
+                            uint8_t *data, FelicaBatch_Stats_t *stats);
+
+/**
+ * @brief Write blocks with Write Without Encryption, as many per command as the card accepts
+ * @param pAl FeliCa AL of the selected card
+ * @param items Service / block pairs
+ * @param count Number of items
+ * @param data Block data, 16 bytes per item in item order
+ * @param stats Commands used and blocks per command
+ * @return PH_ERR_SUCCESS, PHAL_FELICA_ERR_FELICA with the status flags in the AL, or the PAL error
+ */
+phStatus_t FelicaBatch_Write(phalFelica_Sw_DataParams_t *pAl, const FelicaBatch_Item_t *items, uint16_t count,
+                             const uint8_t *data, FelicaBatch_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_FELICA_BATCH_H_ */
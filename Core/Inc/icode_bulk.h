@@ -0,0 +1,84 @@
+/*
+ * icode_bulk.h
+ *
+ * ISO15693 (ICODE / NTAG 5) whole-memory reader
+ * Memory layout, supported read command and data rate are learned once per
+ * UID and cached, later taps go straight to the fastest read path
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_ICODE_BULK_H_
+#define INC_ICODE_BULK_H_
+
+#include "ph_Status.h"
+#include "phalICode.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define ICODE_BULK_CACHE_ENTRIES    4U      /* UIDs remembered with their memory layout */
+#define ICODE_BULK_RX_OVERHEAD      3U      /* Response flags + CRC around the block data */
+
+/* Highest data rate the reader may select, 212 kbit/s needs a tag with active load modulation */
+#define ICODE_BULK_RATE_26          0U
+#define ICODE_BULK_RATE_53          1U
+#define ICODE_BULK_RATE_106         2U
+#define ICODE_BULK_RATE_212         3U
+
+/* Read command in use */
+typedef enum {
+    ICODE_BULK_READ_MULTIPLE = 0,           /* READ MULTIPLE BLOCKS, 26 kbit/s reply */
+    ICODE_BULK_READ_FAST,                   /* FAST READ MULTIPLE BLOCKS, 53 kbit/s reply */
+    ICODE_BULK_READ_EXT,                    /* EXTENDED READ MULTIPLE BLOCKS, more than 256 blocks */
+    ICODE_BULK_READ_EXT_FAST                /* EXTENDED FAST READ MULTIPLE BLOCKS */
+} IcodeBulk_Read_t;
+
+/* ================== Types ================== */
+typedef struct {
+    uint16_t blocks;
+    uint8_t block_size;
+    uint16_t bytes;                         /* Bytes written to the dump */
+    IcodeBulk_Read_t read_cmd;
+    uint8_t rate;                           /* ICODE_BULK_RATE_xxx of the tag reply during the dump */
+    uint8_t requests;                       /* Read commands sent */
+    uint8_t cache_hit;                      /* 1: layout came from the cache, no GetSystemInformation */
+    uint32_t elapsed_ms;
+} IcodeBulk_Result_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Read the whole user memory of the activated ISO15693 tag
+ *
+ * The first tap of a UID issues GetSystemInformation (extended for tags with
+ * more than 256 blocks) and ParameterRequest, later taps reuse the cached
+ * result. When the tag offers a higher data rate it is selected with
+ * ParameterSelect for the dump and reset to 26 kbit/s afterwards, otherwise
+ * the FAST read variants are used on NXP tags. Each request asks for as many
+ * blocks as fit the HAL receive buffer.
+ *
+ * @param pAlICode ICODE AL of the activated tag
+ * @param max_rate Highest ICODE_BULK_RATE_xxx the reader may select
+ * @param data Dump buffer
+ * @param data_size Size of the dump buffer, the dump stops at the last block that fits
+ * @param result Layout, read path and timing
+ * @return PH_ERR_SUCCESS, or the error of the command that failed
+ */
+phStatus_t IcodeBulk_ReadAll(phalICode_Sw_DataParams_t *pAlICode, uint8_t max_rate,
+                             uint8_t *data, uint16_t data_size, IcodeBulk_Result_t *result);
+
+/**
+ * @brief Forget all cached tag layouts
+ */
+void IcodeBulk_ClearCache(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ICODE_BULK_H_ */
@@ -0,0 +1,66 @@
+/*
+ * inventory_a.h
+ *
+ * Bulk ISO14443-3A inventory
+ * Enumerates every Type A card in the field in one call: collision branches
+ * are kept with the UID bits already learned, each resolved card is halted
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_INVENTORY_A_H_
+#define INC_INVENTORY_A_H_
+
+#include "ph_Status.h"
+#include "phpalI14443p3a.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define INVENTORY_A_MAX_CARDS       16U     /* Cards reported per call */
+#define INVENTORY_A_MAX_BRANCHES    32U     /* Pending collision branches, overflow is picked up by a new REQA round */
+#define INVENTORY_A_GUARD_TIME_US   5100U   /* Field on to first REQA */
+
+/* ================== Types ================== */
+typedef struct {
+    uint8_t uid[10];
+    uint8_t uid_len;                /* 4, 7 or 10 */
+    uint8_t sak;
+    uint8_t atqa[2];
+    uint8_t atqa_valid;             /* 0: several cards answered the REQA, atqa holds the merged value */
+} InventoryA_Card_t;
+
+typedef struct {
+    InventoryA_Card_t cards[INVENTORY_A_MAX_CARDS];
+    uint8_t count;
+    uint8_t complete;               /* 1: no idle card answered the last REQA */
+    uint16_t frames;                /* REQA / ANTICOLLISION / SELECT / HLTA frames sent */
+    uint32_t elapsed_ms;
+} InventoryA_Result_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Enumerate all Type A cards in the field
+ *
+ * Switches the field on with ISO14443A settings, then resolves cards until
+ * none answers REQA, the result is full or the time budget is used up.
+ * Resolved cards are left in HALT state, the field stays on.
+ *
+ * @param pPal ISO14443-3A PAL of the reader
+ * @param budget_ms Time budget in ms
+ * @param result Cards found, frame count and elapsed time
+ * @return PH_ERR_SUCCESS, or a HAL error that stopped the inventory
+ */
+phStatus_t InventoryA_Run(phpalI14443p3a_Sw_DataParams_t *pPal, uint32_t budget_ms,
+                          InventoryA_Result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_INVENTORY_A_H_ */
@@ -0,0 +1,90 @@
+/*
+ * inventory_epc.h
+ *
+ * ISO18000-3 mode 3 (EPC Gen2 HF) inventory with adaptive Q
+ * Rounds run on the PN5180 inventory engine, Q of the next round follows the
+ * slot statistics (empty / success / collision) of the previous one: the tags
+ * left are estimated from the collisions and the round sized to them
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_INVENTORY_EPC_H_
+#define INC_INVENTORY_EPC_H_
+
+#include "ph_Status.h"
+#include "phpalI18000p3m3.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define INVENTORY_EPC_MAX_TAGS      32U     /* Tags stored per call, further tags are only counted */
+#define INVENTORY_EPC_UII_MAX       32U     /* Stored UII bytes per tag */
+#define INVENTORY_EPC_GUARD_TIME_US 5100U   /* Field on to first BeginRound */
+#define INVENTORY_EPC_Q_MAX         15U
+#define INVENTORY_EPC_SLOTS_PER_TAG 2U      /* Slots of the next round per tag left */
+
+/* ================== Types ================== */
+typedef struct {
+    uint8_t session;                /* PHPAL_I18000P3M3_SESSION_S0 or PHPAL_I18000P3M3_SESSION_S2 */
+    uint8_t sel;                    /* PHPAL_I18000P3M3_SEL_xxx, tags taking part in the rounds */
+    uint8_t reset_flags;            /* 1: Select all inventoried flags of the session back to A first */
+    uint8_t q_start;                /* Q of the first round */
+    uint8_t adaptive;               /* 0: every round at q_start */
+    uint8_t dr;                     /* PHPAL_I18000P3M3_LF_xxx */
+    uint8_t m;                      /* PHPAL_I18000P3M3_M_xxx */
+    uint8_t max_rounds;
+    uint32_t budget_ms;
+} InventoryEpc_Config_t;
+
+typedef struct {
+    uint8_t pc[2];                  /* StoredPC / PacketPC */
+    uint8_t uii[INVENTORY_EPC_UII_MAX];
+    uint8_t uii_len;                /* Bytes stored */
+} InventoryEpc_Tag_t;
+
+typedef struct {
+    InventoryEpc_Tag_t tags[INVENTORY_EPC_MAX_TAGS];
+    uint8_t count;                  /* Tags stored */
+    uint16_t tags_seen;             /* Tags read, including the ones that did not fit */
+    uint16_t slots_success;
+    uint16_t slots_empty;
+    uint16_t slots_collision;
+    uint8_t rounds;
+    uint8_t last_q;
+    uint8_t complete;               /* 1: last round had neither replies nor collisions */
+    uint32_t elapsed_ms;
+} InventoryEpc_Result_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Default configuration: session S0, all tags, flags reset, adaptive Q from 4, 847kHz Manchester 4
+ * @param cfg Configuration to fill
+ */
+void InventoryEpc_DefaultConfig(InventoryEpc_Config_t *cfg);
+
+/**
+ * @brief Inventory all ISO18000-3m3 tags in the field
+ *
+ * Tags that answered are acknowledged and flip their inventoried flag, so they
+ * stay out of the following rounds. Calling again with reset_flags = 0 and
+ * session S2 only reports tags that arrived since the last call.
+ *
+ * @param pPal ISO18000-3m3 PAL of the reader
+ * @param cfg Round parameters and time budget
+ * @param result Tags and slot statistics
+ * @return PH_ERR_SUCCESS, or the HAL error that stopped the inventory
+ */
+phStatus_t InventoryEpc_Run(phpalI18000p3m3_Sw_DataParams_t *pPal, const InventoryEpc_Config_t *cfg,
+                            InventoryEpc_Result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_INVENTORY_EPC_H_ */
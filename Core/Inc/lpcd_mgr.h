@@ -0,0 +1,180 @@
+/*
+ * lpcd_mgr.h
+ *
+ * Self-calibrating LPCD manager for the PN5180
+ * The AGC reference is re-measured periodically and after every false wake
+ * and averaged, the detection threshold and wake-up period follow the
+ * observed false-wake rate
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_LPCD_MGR_H_
+#define INC_LPCD_MGR_H_
+
+#include "ph_Status.h"
+#include "phhalHw.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define LPCD_MGR_SAMPLES            4U      /* AGC reads averaged per measurement */
+#define LPCD_MGR_SETTLE_US          5100U   /* Field on to first AGC read */
+#define LPCD_MGR_SAMPLE_GAP_US      500U    /* Between AGC reads of one measurement */
+#define LPCD_MGR_NOISE_FACTOR       3U      /* Threshold floor in multiples of the measured noise */
+
+/* ================== Types ================== */
+
+/**
+ * @brief AGC measurement source, one call returns gear and value as in AGC_REF_CONFIG
+ *
+ * The default source switches the field on and reads the PN5180 register,
+ * a simulated source can return any AGC sequence instead.
+ */
+typedef phStatus_t (*LpcdMgr_AgcSource_t)(void *ctx, uint16_t *pAgc);
+
+typedef struct {
+    uint8_t threshold_init;             /* AGC counts, also written to E2PROM 0x37 */
+    uint8_t threshold_min;
+    uint8_t threshold_max;
+    uint8_t e2prom_hyst;                /* E2PROM threshold rewritten once the adapted one moved this far */
+    uint16_t period_min_ms;             /* LPCD wake-up period range */
+    uint16_t period_max_ms;
+    uint32_t recal_interval_ms;         /* Reference refresh while nothing happens */
+    uint8_t ema_shift;                  /* Reference moving average weight 1/2^n */
+    uint8_t window;                     /* Wakes per adaptation step */
+    uint8_t false_high_pct;             /* Desensitize above this false-wake rate */
+    uint8_t false_low_pct;              /* Sensitize below this false-wake rate */
+} LpcdMgr_Config_t;
+
+typedef struct {
+    uint32_t wakes;                     /* LPCD wake-ups */
+    uint32_t false_wakes;               /* Wake-ups where the discovery found nothing */
+    uint32_t detections;                /* Wake-ups followed by a card */
+    uint32_t recalibrations;
+    uint32_t latency_last_ms;           /* Wake-up to discovery result */
+    uint32_t latency_avg_ms;
+    uint32_t latency_max_ms;
+    uint16_t reference;                 /* Gear and value in use */
+    uint16_t noise;                     /* Averaged deviation of the measurements */
+    uint8_t threshold;                  /* Adapted threshold */
+    uint8_t threshold_e2prom;           /* Threshold the PN5180 runs LPCD with */
+    uint32_t e2prom_writes;
+    uint16_t period_ms;
+} LpcdMgr_Stats_t;
+
+typedef struct {
+    phhalHw_Pn5180_DataParams_t *pHal;
+    LpcdMgr_Config_t cfg;
+    LpcdMgr_AgcSource_t agc_source;
+    void *agc_ctx;
+
+    uint32_t ref_q4;                    /* Reference value, 4 fractional bits */
+    uint32_t noise_q4;
+    uint16_t gear;
+    uint8_t threshold_written;          /* Threshold currently in E2PROM */
+    uint8_t calibrated;
+    uint32_t last_recal_ms;
+    uint32_t wake_ms;
+    uint8_t woken;
+    uint8_t win_wakes;
+    uint8_t win_false;
+
+    LpcdMgr_Stats_t stats;
+} LpcdMgr_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Default configuration, tuned for an open antenna
+ * @param cfg Configuration to fill
+ */
+void LpcdMgr_DefaultConfig(LpcdMgr_Config_t *cfg);
+
+/**
+ * @brief Prepare the manager and the PN5180 for power-down LPCD
+ *
+ * Switches the reference source to the AGC_REF_CONFIG register, so that
+ * recalibrations do not write the E2PROM, and takes a first reference.
+ *
+ * @param mgr Manager
+ * @param pHal PN5180 HAL, NULL to run on an injected AGC source only
+ * @param cfg Configuration, NULL for the defaults
+ * @return PH_ERR_SUCCESS or the HAL error
+ */
+phStatus_t LpcdMgr_Init(LpcdMgr_t *mgr, phhalHw_Pn5180_DataParams_t *pHal, const LpcdMgr_Config_t *cfg);
+
+/**
+ * @brief Replace the AGC measurement, e.g. with an injected sequence on the simulated BAL
+ * @param mgr Manager
+ * @param source Measurement function, NULL for the PN5180 register
+ * @param ctx Passed to the source
+ */
+void LpcdMgr_SetAgcSource(LpcdMgr_t *mgr, LpcdMgr_AgcSource_t source, void *ctx);
+
+/**
+ * @brief Take one AGC measurement with no card in the field and fold it into the reference
+ *
+ * A gear change, or a move beyond the threshold, restarts the average. The
+ * reference is pushed to the PN5180 when a HAL is attached.
+ *
+ * @param mgr Manager
+ * @return PH_ERR_SUCCESS or the measurement error
+ */
+phStatus_t LpcdMgr_Calibrate(LpcdMgr_t *mgr);
+
+/**
+ * @brief Refresh the reference when due and load threshold and period before LPCD
+ *
+ * The periodic measurement is dropped when it moved beyond the threshold,
+ * it may be a card; the LPCD wake-up and the discovery loop tell.
+ *
+ * The threshold goes to the E2PROM only when it moved by cfg.e2prom_hyst
+ * since the last write, or when the written one is below the noise floor.
+ *
+ * @param mgr Manager
+ * @return PH_ERR_SUCCESS or the HAL error
+ */
+phStatus_t LpcdMgr_Arm(LpcdMgr_t *mgr);
+
+/**
+ * @brief Block in power-down LPCD until the field changes
+ * @param mgr Manager
+ * @return PH_ERR_SUCCESS on a wake-up, or the HAL error
+ */
+phStatus_t LpcdMgr_Wait(LpcdMgr_t *mgr);
+
+/**
+ * @brief Record a wake-up that happened outside LpcdMgr_Wait
+ * @param mgr Manager
+ */
+void LpcdMgr_OnWake(LpcdMgr_t *mgr);
+
+/**
+ * @brief Report the discovery result of the last wake-up
+ *
+ * A wake-up without a card counts as a false wake and triggers a new
+ * measurement. Every cfg.window wake-ups threshold and period are adapted:
+ * up on a high false-wake rate, down again on a low one.
+ *
+ * @param mgr Manager
+ * @param card_found 1 when the discovery found a card or device
+ */
+void LpcdMgr_OnDiscovery(LpcdMgr_t *mgr, uint8_t card_found);
+
+/**
+ * @brief Counters and the current settings
+ * @param mgr Manager
+ * @return Statistics, valid until the next call into the manager
+ */
+const LpcdMgr_Stats_t *LpcdMgr_GetStats(const LpcdMgr_t *mgr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_LPCD_MGR_H_ */
@@ -41,6 +41,12 @@ extern "C" {
 
 /* Exported constants --------------------------------------------------------*/
 /* USER CODE BEGIN EC */
+/* 快速启动（可选）：PN5180复位与MCU外设初始化并行，异步蜂鸣，DRBG播种和RAM报告推迟到第一次空闲
+ * Fast boot, opt-in: skips the PN5180 HAL reset and its 1 s settle delays once BUSY is low (boot_prof.h),
+ * not yet validated against the firmware-version read on every board; 0 keeps the original sequential boot */
+#ifndef BOOT_FAST
+#define BOOT_FAST       0
+#endif
 
 /* USER CODE END EC */
 
@@ -0,0 +1,100 @@
+/*
+ * mfc_dump.h
+ *
+ * MIFARE Classic full-card dump
+ * Sectors are read in order with one authentication each, the key that
+ * opened a sector is remembered per UID so the next tap of the same card
+ * authenticates every sector at the first attempt
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_MFC_DUMP_H_
+#define INC_MFC_DUMP_H_
+
+#include "ph_Status.h"
+#include "phpalI14443p3a.h"
+#include "phpalMifare.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define MFC_DUMP_MAX_SECTORS        40U     /* MIFARE Classic 4K: 32 x 4 blocks + 8 x 16 blocks */
+#define MFC_DUMP_CACHE_ENTRIES      8U      /* UIDs remembered by the key cache */
+#define MFC_DUMP_BLOCK_SIZE         16U
+
+/* sector_key[] encoding */
+#define MFC_DUMP_KEY_B              0x80U   /* Set: sector opened with key B */
+#define MFC_DUMP_KEY_NONE           0xFFU   /* No key of the list opened the sector */
+
+/* ================== Types ================== */
+typedef struct {
+    uint8_t sectors;                            /* Sectors on the card */
+    uint8_t sectors_read;                       /* Sectors authenticated and read completely */
+    uint8_t sector_key[MFC_DUMP_MAX_SECTORS];   /* Index into the key list | MFC_DUMP_KEY_B, or MFC_DUMP_KEY_NONE */
+    uint8_t cache_hit;                          /* 1: key map of this UID came from the cache */
+    uint16_t auth_attempts;
+    uint16_t reactivations;                     /* WUPA + SELECT after a failed authentication */
+    uint16_t field_resets;                      /* Card did not wake up, field was cycled */
+    uint32_t elapsed_ms;
+} MfcDump_Result_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Sectors of a MIFARE Classic card from its SAK
+ * @param sak SAK of the activated card
+ * @return 5 (Mini), 16 (1K), 32 (2K), 40 (4K), 0 if not a MIFARE Classic SAK
+ */
+uint8_t MfcDump_SectorCount(uint8_t sak);
+
+/**
+ * @brief Byte offset of the first block of a sector in the dump
+ * @param sector Sector number
+ * @return Offset in bytes
+ */
+uint16_t MfcDump_SectorOffset(uint8_t sector);
+
+/**
+ * @brief Read every sector of an activated MIFARE Classic card
+ *
+ * Each sector is authenticated once and all its blocks are read in sequence.
+ * Keys are tried in the order: cached key of this UID and sector, key that
+ * opened the previous sector, then the list with key A and key B. A failed
+ * authentication is recovered with WUPA + SELECT of the known UID, the field
+ * is only cycled when the card does not wake up.
+ * Blocks of sectors that could not be opened are left untouched. The known
+ * key is written into the trailer image since the card reads it back as 0.
+ *
+ * @param pPal3a ISO14443-3A PAL the card was activated with
+ * @param pPalMifare MIFARE PAL on top of it
+ * @param uid UID of the card (4 or 7 bytes)
+ * @param uid_len UID length
+ * @param sak SAK of the card
+ * @param keys Candidate keys
+ * @param key_count Number of keys (< 0x7F)
+ * @param data Dump buffer, MfcDump_SectorOffset(sectors) bytes at least
+ * @param data_size Size of the dump buffer
+ * @param result Key map and statistics
+ * @return PH_ERR_SUCCESS when all sectors were read, PH_ERR_AUTH_ERROR when some stayed closed,
+ *         or the error that stopped the dump
+ */
+phStatus_t MfcDump_Run(phpalI14443p3a_Sw_DataParams_t *pPal3a, phpalMifare_Sw_DataParams_t *pPalMifare,
+                       const uint8_t *uid, uint8_t uid_len, uint8_t sak,
+                       const uint8_t (*keys)[PHPAL_MIFARE_KEY_LENGTH], uint8_t key_count,
+                       uint8_t *data, uint16_t data_size, MfcDump_Result_t *result);
+
+/**
+ * @brief Forget all cached key maps
+ */
+void MfcDump_ClearCache(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MFC_DUMP_H_ */
@@ -0,0 +1,108 @@
+/*
+ * mful_bulk.h
+ *
+ * MIFARE Ultralight / NTAG whole-memory reader and bulk writer
+ * GET_VERSION is issued once per UID and the memory layout cached, the dump
+ * uses the fewest FAST_READ commands the HAL receive buffer allows and writes
+ * skip the pages that already hold the new data
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_MFUL_BULK_H_
+#define INC_MFUL_BULK_H_
+
+#include "ph_Status.h"
+#include "phalMful.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define MFUL_BULK_CACHE_ENTRIES     4U      /* UIDs remembered with their GET_VERSION reply */
+#define MFUL_BULK_RX_OVERHEAD       2U      /* CRC behind the page data */
+#define MFUL_BULK_MAX_UID           10U
+#define MFUL_BULK_MAX_PAGES         482U    /* NTAG I2C plus 2k: pages 0x00..0xE1 of sector 0 and sector 1 */
+#define MFUL_BULK_SRAM_SIZE         64U     /* FAST_WRITE, pages 0xF0..0xFF */
+
+/* ================== Types ================== */
+typedef struct {
+    const char *profile;                    /* Tag recognised from GET_VERSION */
+    uint16_t pages;                         /* Pages of the whole dump, all sectors */
+    uint16_t user_first;                    /* User memory as page index into the dump */
+    uint16_t user_pages;
+    uint16_t bytes;                         /* Bytes read into the dump */
+    uint16_t requests;                      /* FAST_READ, WRITE and FAST_WRITE commands sent */
+    uint8_t sector_selects;
+    uint16_t pages_written;
+    uint16_t pages_skipped;                 /* Already held the new data */
+    uint8_t cache_hit;                      /* 1: layout came from the cache, no GET_VERSION */
+    uint32_t elapsed_ms;
+} MfulBulk_Result_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Read the whole memory of the activated Ultralight / NTAG
+ *
+ * The first tap of a UID issues GET_VERSION, later taps reuse the cached
+ * layout. Each FAST_READ asks for as many pages as fit the HAL receive
+ * buffer and never crosses a sector, SECTOR_SELECT is only sent on NTAG I2C
+ * 2k and sector 0 is selected again at the end.
+ *
+ * @param pAlMful Ultralight AL of the activated tag
+ * @param uid UID from activation
+ * @param uid_len UID length
+ * @param data Dump buffer, page index n of the result is at data[4 * n]
+ * @param data_size Size of the dump buffer, the dump stops at the last page that fits
+ * @param result Layout, commands and timing
+ * @return PH_ERR_SUCCESS, PH_ERR_UNSUPPORTED_COMMAND for an unknown GET_VERSION reply,
+ *         or the error of the command that failed
+ */
+phStatus_t MfulBulk_ReadAll(phalMful_Sw_DataParams_t *pAlMful, const uint8_t *uid, uint8_t uid_len,
+                            uint8_t *data, uint16_t data_size, MfulBulk_Result_t *result);
+
+/**
+ * @brief Write pages of the user memory
+ *
+ * The range is read back with FAST_READ first, only the pages that differ
+ * are written. WRITE programs one page at a time, so on a tag that already
+ * holds most of the data this saves the EEPROM programming time.
+ *
+ * @param pAlMful Ultralight AL of the activated tag
+ * @param uid UID from activation
+ * @param uid_len UID length
+ * @param page First page, index into the dump as returned by MfulBulk_ReadAll
+ * @param data New page contents
+ * @param len Multiple of 4, the range must stay inside the user memory
+ * @param result Layout, pages written and skipped, timing
+ * @return PH_ERR_SUCCESS, PH_ERR_INVALID_PARAMETER for a range outside the user memory,
+ *         or the error of the command that failed
+ */
+phStatus_t MfulBulk_WriteRange(phalMful_Sw_DataParams_t *pAlMful, const uint8_t *uid, uint8_t uid_len,
+                               uint16_t page, const uint8_t *data, uint16_t len, MfulBulk_Result_t *result);
+
+/**
+ * @brief Write the 64 byte SRAM of an NTAG I2C plus with one FAST_WRITE
+ *
+ * Reaches the user memory only where the SRAM is mirrored into it (NC_REG
+ * SRAM_MIRROR_ON_OFF), the EEPROM itself is never written this way.
+ *
+ * @return PH_ERR_SUCCESS, or PH_ERR_UNSUPPORTED_COMMAND when the tag has no FAST_WRITE
+ */
+phStatus_t MfulBulk_WriteSram(phalMful_Sw_DataParams_t *pAlMful, const uint8_t *uid, uint8_t uid_len,
+                              const uint8_t *data, MfulBulk_Result_t *result);
+
+/**
+ * @brief Forget all cached tag layouts
+ */
+void MfulBulk_ClearCache(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MFUL_BULK_H_ */
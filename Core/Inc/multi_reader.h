@@ -0,0 +1,92 @@
+/*
+ * multi_reader.h
+ *
+ * Several PN5180 front-ends on one MCU
+ * Each reader has its own NFC library instance, discovery is interleaved
+ * across the readers on the shared SPI bus
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_MULTI_READER_H_
+#define INC_MULTI_READER_H_
+
+#include "ph_Status.h"
+#include "phNfcLib.h"
+#if defined(STM32L431xx)
+#include "BoardSelection.h"
+#endif
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+/* Host builds have no board header, the bench sets the wired reader count */
+#ifndef PHDRIVER_READER_COUNT
+#define PHDRIVER_READER_COUNT       1U
+#endif
+
+/* Readers actually driven, limited by the board wiring and the library instances */
+#if (PHDRIVER_READER_COUNT < PH_NXPNFCRDLIB_CONFIG_READER_COUNT)
+#define MULTI_READER_COUNT          PHDRIVER_READER_COUNT
+#else
+#define MULTI_READER_COUNT          PH_NXPNFCRDLIB_CONFIG_READER_COUNT
+#endif
+
+#define MULTI_READER_FIELD_OFF_MS   7U      /* Field off time before the same reader polls again (>= 5.1ms on a 1ms tick) */
+#define MULTI_READER_GUARD_MS       7U      /* Field on before the WUPA, GTA >= 5.1ms on a 1ms tick */
+#define MULTI_READER_ATQA_US        145U    /* WUPA answer timeout, selection time + margin as phpalI14443p3a */
+#define MULTI_READER_IRQ_MS         2U      /* Poll the HAL once this late even without an IRQ seen */
+#define MULTI_READER_FULL_POLL_ROUNDS 8U    /* Every Nth round runs the full discovery loop (Type B/F/V) */
+
+/**
+ * @brief Called for every reader whose discovery loop found a peer
+ *
+ * The reader is selected while the callback runs, so pHal, pDiscLoop and the
+ * phNfcLib_GetDataParams() pointers all refer to it.
+ *
+ * @param reader Reader index
+ * @param pDiscLoop Discovery loop of the reader
+ * @param status phacDiscLoop_Run status
+ */
+typedef void (*MultiReader_CardFn_t)(uint8_t reader, void *pDiscLoop, phStatus_t status);
+
+/**
+ * @brief Bring up the BAL, NFC library and discovery loop of every reader
+ * @return PH_ERR_SUCCESS, or the status of the first reader that failed
+ * @note Reader 0 is selected on return
+ */
+phStatus_t MultiReader_Init(void);
+
+/**
+ * @brief Switch the NFC library and the pHal / pDiscLoop globals to a reader
+ * @param reader Reader index
+ * @return PH_ERR_SUCCESS, PH_ERR_INVALID_PARAMETER if the reader does not exist
+ */
+phStatus_t MultiReader_Select(uint8_t reader);
+
+/**
+ * @brief Run one discovery poll on every reader
+ *
+ * All readers switch their field on and send WUPA before any answer is
+ * waited for, so the guard time and the answer timeout of the readers
+ * overlap. A reader is serviced when its IRQ is pending (or its deadline has
+ * passed); only readers that saw an answer run the full discovery loop for
+ * activation. A reader whose field has not been off for
+ * MULTI_READER_FIELD_OFF_MS yet sits the round out instead of being waited for.
+ * Every MULTI_READER_FULL_POLL_ROUNDS round runs the complete discovery loop
+ * on each reader so the other technologies are still found.
+ *
+ * @param card_fn Called for readers that activated a peer, may be NULL
+ * @return Bit mask of the readers that activated a peer
+ */
+uint32_t MultiReader_PollRound(MultiReader_CardFn_t card_fn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MULTI_READER_H_ */
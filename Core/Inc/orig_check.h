@@ -0,0 +1,115 @@
+/*
+ * orig_check.h
+ *
+ * NXP originality signature check
+ * ECDSA verification of the signature returned by phalMful_Sw_ReadSign,
+ * phalICode_Sw_ReadSignature and phalMfNtag42XDna_Sw_ReadSign. The public
+ * keys never change, so u1*G + u2*Q is evaluated with fixed-base comb tables
+ * for both points and genuine UIDs can be remembered
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_ORIG_CHECK_H_
+#define INC_ORIG_CHECK_H_
+
+#include "ph_Status.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define ORIG_CHECK_CACHE_ENTRIES    8U      /* Verified UID/signature pairs kept, 0: no cache */
+#define ORIG_CHECK_MAX_UID          10U
+#define ORIG_CHECK_MAX_SIG          56U     /* r || s, secp224r1 */
+#define ORIG_CHECK_MAX_KEY          57U     /* 04 || X || Y, secp224r1 */
+
+/* ================== Types ================== */
+
+/* The signature is over the UID, MSB first, without hashing */
+typedef enum {
+    ORIG_TAG_MFUL = 0,                  /* Ultralight EV1/C/AES, NTAG21x: secp128r1, 7 byte UID, 32 byte signature */
+    ORIG_TAG_ICODE,                     /* ICODE SLIX2/DNA, NTAG 5: secp128r1, 8 byte UID (E0 first), 32 byte signature */
+    ORIG_TAG_NTAG42X,                   /* NTAG 424 DNA: secp224r1, 7 byte UID, 56 byte signature */
+    ORIG_TAG_COUNT
+} OrigCheck_TagType_t;
+
+typedef enum {
+    ORIG_CHECK_OK = 0,                  /* Genuine NXP tag */
+    ORIG_CHECK_ERR_PARAM,               /* Tag type, UID or signature length, key not on the curve */
+    ORIG_CHECK_ERR_NO_KEY,              /* No public key for the tag type */
+    ORIG_CHECK_ERR_SIGNATURE            /* Signature does not verify */
+} OrigCheck_Result_t;
+
+typedef struct {
+    uint32_t verified;                  /* Signatures verified with the comb tables */
+    uint32_t cache_hits;                /* Answered from the UID cache */
+    uint32_t failures;                  /* ORIG_CHECK_ERR_SIGNATURE */
+} OrigCheck_Stats_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Reset the UID cache and the statistics
+ *
+ * The NXP keys of all tag types and their tables are built in, for
+ * ORIG_TAG_ICODE the ICODE SLIX2 / DNA one.
+ */
+void OrigCheck_Init(void);
+
+/**
+ * @brief Set the public key of a tag type and build its comb table
+ *
+ * Replaces the built-in key, the cached UIDs of that type are dropped.
+ * Building the table costs about fifteen signature checks, once.
+ *
+ * @param type Tag type
+ * @param key Uncompressed point 04 || X || Y
+ * @param key_len 33 for secp128r1, 57 for secp224r1
+ * @return ORIG_CHECK_OK, or ORIG_CHECK_ERR_PARAM when the point is not on the curve
+ */
+OrigCheck_Result_t OrigCheck_SetPublicKey(OrigCheck_TagType_t type, const uint8_t *key, uint8_t key_len);
+
+/**
+ * @brief Check the originality signature of a tag
+ * @param uid UID, MSB first
+ * @param uid_len UID length of the tag type
+ * @param sig Signature r || s as read from the tag
+ * @param sig_len 32 for secp128r1, 56 for secp224r1
+ * @param type Tag type
+ * @return ORIG_CHECK_OK for a genuine tag, ORIG_CHECK_ERR_SIGNATURE always for the all-zero UID
+ */
+OrigCheck_Result_t OrigCheck_VerifyOriginality(const uint8_t *uid, uint8_t uid_len,
+                                               const uint8_t *sig, uint8_t sig_len,
+                                               OrigCheck_TagType_t type);
+
+/**
+ * @brief Same check with plain double-and-add and without the UID cache
+ *
+ * The general purpose path the tables replace, kept as reference.
+ */
+OrigCheck_Result_t OrigCheck_VerifyGeneric(const uint8_t *uid, uint8_t uid_len,
+                                           const uint8_t *sig, uint8_t sig_len,
+                                           OrigCheck_TagType_t type);
+
+/**
+ * @brief Rebuild the built-in tables and compare them with the stored ones
+ * @return ORIG_CHECK_OK when all match
+ */
+OrigCheck_Result_t OrigCheck_SelfTest(void);
+
+/**
+ * @brief Forget the verified UIDs
+ */
+void OrigCheck_ClearCache(void);
+
+void OrigCheck_GetStats(OrigCheck_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ORIG_CHECK_H_ */
@@ -0,0 +1,77 @@
+/*
+ * ram_budget.h
+ *
+ * Static RAM budgets and runtime stack watermark
+ * The per-component .bss bounds are emitted by the linker script, so the
+ * table always matches the image that was built. The free RAM below the
+ * stack is painted by the startup code and scanned for the high watermark
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_RAM_BUDGET_H_
+#define INC_RAM_BUDGET_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define RAM_BUDGET_STACK_PAINT      0xA5A5A5A5UL    /* Fill pattern written by Reset_Handler */
+
+/* Budgets in bytes, RamBudget_Report flags every component above its budget */
+#define RAM_BUDGET_NFCLIB           16384U  /* NXP reader library (HAL, PAL, AL, discovery loop) */
+#define RAM_BUDGET_DAL              512U    /* Board / BAL / OSAL */
+#define RAM_BUDGET_DEMO             2048U   /* Discovery loop and EMVCo demos */
+#define RAM_BUDGET_EMV              6144U   /* EMV transaction, ODA and crypto state */
+#define RAM_BUDGET_APP              4096U   /* Other Core/Src modules */
+#define RAM_BUDGET_RAM2             15360U  /* Buffers placed with PH_MEMLOC_RAM2, see below */
+
+/*
+ * SRAM2 is 16 KB: NFC library reader state, TMI, RNG and key store about 4 KB,
+ * EMV payment context 4.2 KB, resume entry 2.6 KB, originality tables 2.5 KB.
+ * The last 1 KB is left to .ram2_noinit (boot profile kept over a warm reset).
+ */
+
+/* ================== Types ================== */
+typedef struct {
+    const char *name;
+    uint32_t size;                  /* Bytes used in the built image */
+    uint32_t budget;
+} RamBudget_Entry_t;
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Peak stack usage since reset
+ * @return Bytes between the top of RAM and the deepest word that lost the paint pattern
+ */
+uint32_t Stack_HighWatermark(void);
+
+/**
+ * @brief Check whether the stack went below the _Min_Stack_Size reservation
+ * @return 1 when the reservation was exceeded at any point since reset
+ */
+uint8_t Stack_Overflowed(void);
+
+/**
+ * @brief Fill the budget table of the built image
+ * @param entries Table to fill
+ * @param max_entries Size of the table
+ * @return Number of entries written
+ */
+uint8_t RamBudget_Get(RamBudget_Entry_t *entries, uint8_t max_entries);
+
+/**
+ * @brief Print the budget table and the stack watermark
+ */
+void RamBudget_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_RAM_BUDGET_H_ */
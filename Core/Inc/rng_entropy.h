@@ -0,0 +1,91 @@
+/*
+ * rng_entropy.h
+ *
+ * Hardware entropy for the reader library DRBG
+ * On the STM32L4 the RNG peripheral (HSI48 clocked) provides the entropy,
+ * host builds read RNG_ENTROPY_HOST_FILE instead
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef INC_RNG_ENTROPY_H_
+#define INC_RNG_ENTROPY_H_
+
+#include "ph_Status.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define RNG_ENTROPY_TIMEOUT_MS          10U         /* Per 32-bit word */
+#define RNG_ENTROPY_RESEED_INTERVAL     1024U       /* DRBG requests between two reseeds */
+
+#ifndef RNG_ENTROPY_HOST_FILE
+#define RNG_ENTROPY_HOST_FILE           "/dev/urandom"
+#endif
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Start the entropy source (HSI48, RNG clock and peripheral)
+ * @return PH_ERR_SUCCESS, or PH_ERR_INTERNAL_ERROR when HSI48 does not start
+ */
+phStatus_t RngEntropy_Init(void);
+
+/**
+ * @brief Read entropy, signature of phCryptoRng_Sw_EntropyCb_t
+ *
+ * Words flagged by a seed or clock error and words equal to their
+ * predecessor are discarded, a seed error restarts the peripheral.
+ *
+ * @param ctx Unused
+ * @param buf Entropy bytes
+ * @param len Number of bytes
+ * @return PH_ERR_SUCCESS, or PH_ERR_IO_TIMEOUT when the source stalls
+ */
+phStatus_t RngEntropy_Read(void *ctx, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief Seed the reader library DRBG from the entropy source and fill its random pool
+ *
+ * Also registers the pool refill as a background task, so it runs while
+ * APDUs are in flight. RngEntropy_Idle refills it from the main loop.
+ *
+ * @param pCryptoRng phCryptoRng_Sw data params, e.g. phNfcLib_GetDataParams(PH_COMP_CRYPTORNG)
+ * @return PH_ERR_SUCCESS or the DRBG / entropy error
+ */
+phStatus_t RngEntropy_AttachDrbg(void *pCryptoRng);
+
+/**
+ * @brief Note the DRBG for RngEntropy_AttachDrbg at the first idle time or first use
+ *
+ * Keeps HSI48 start-up, seeding and the pool fill out of the boot path.
+ * Until then the DRBG runs on the seed phNfcLib_Init gave it, so whatever
+ * needs hardware entropy calls RngEntropy_AttachPending first.
+ *
+ * @param pCryptoRng phCryptoRng_Sw data params
+ * @return PH_ERR_SUCCESS, or PH_ERR_INVALID_DATA_PARAMS for another component
+ */
+phStatus_t RngEntropy_DeferAttach(void *pCryptoRng);
+
+/**
+ * @brief Complete a deferred RngEntropy_AttachDrbg, nothing to do when none is pending
+ * @return PH_ERR_SUCCESS or the error of RngEntropy_AttachDrbg
+ */
+phStatus_t RngEntropy_AttachPending(void);
+
+/**
+ * @brief Refill the DRBG pool and reseed when due, call from idle time
+ *
+ * Completes a deferred attach first.
+ */
+void RngEntropy_Idle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_RNG_ENTROPY_H_ */
@@ -59,7 +59,7 @@ void EXTI4_IRQHandler(void);
 void TIM2_IRQHandler(void);
 void USART1_IRQHandler(void);
 /* USER CODE BEGIN EFP */
-
+void TIM7_IRQHandler(void);
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
@@ -48,6 +48,9 @@ extern uint8_t	g_uart1_bytes;		/* 指向实际的 buf 大小 */
 void MX_USART1_UART_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+/* 阻塞式接收整帧(HAL_UART_Receive)前暂停中断接收，结束后恢复 */
+void uart1_rx_pause(void);
+void uart1_rx_resume(void);
 
 /* USER CODE END Prototypes */
 
@@ -0,0 +1,283 @@
+/*
+ * boot_prof.c
+ *
+ * Boot-phase profiler and fast boot helpers
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "boot_prof.h"
+#include "phApp_Init.h"
+#include <stddef.h>
+#include <stdio.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+
+/* Not zeroed by Reset_Handler, keeps its content over a warm reset (SRAM2 parity left disabled) */
+#define BOOT_PROF_RETAINED          __attribute__((section(".ram2_noinit")))
+
+static uint32_t BootProf_Cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+static uint32_t BootProf_Hz(void)
+{
+    return SystemCoreClock;
+}
+
+#else /* Host stand-in, the bench drives the counter and the core clock */
+
+#define BOOT_PROF_RETAINED
+
+extern uint32_t BootProf_HostCycles(void);
+extern uint32_t BootProf_HostHz(void);
+
+static uint32_t BootProf_Cycles(void)
+{
+    return BootProf_HostCycles();
+}
+
+static uint32_t BootProf_Hz(void)
+{
+    return BootProf_HostHz();
+}
+
+#endif /* STM32L431xx */
+
+static struct {
+    BootProf_Record_t cur;
+    BootProf_Record_t prev;
+} s_boot BOOT_PROF_RETAINED;
+
+/* Cycle to microsecond conversion, each interval at the clock of its start */
+static uint32_t s_last_cyc;
+static uint32_t s_last_mhz;
+static uint32_t s_rem_cyc;
+static uint32_t s_now_us;
+
+static const char *const s_phase_names[BOOT_PHASE_COUNT] = {
+    "main", "hal_init", "clock", "periph", "banner", "beep", "bal",
+    "nfclib", "drbg", "comp", "irq", "profile", "first_poll"
+};
+
+/* ================== Record ================== */
+
+static uint32_t BootProf_Check(const BootProf_Record_t *rec)
+{
+    const uint32_t *w = (const uint32_t *)rec;
+    uint32_t n = (uint32_t)(offsetof(BootProf_Record_t, check) / sizeof(uint32_t));
+    uint32_t c = 0x5A5A5A5AUL;
+
+    while (n-- > 0U) {
+        c = ((c << 5) | (c >> 27)) ^ *w++;
+    }
+    return c;
+}
+
+static uint8_t BootProf_Valid(const BootProf_Record_t *rec)
+{
+    return (rec->magic == BOOT_PROF_MAGIC && rec->check == BootProf_Check(rec)) ? 1U : 0U;
+}
+
+static uint32_t BootProf_Mhz(void)
+{
+    uint32_t mhz = BootProf_Hz() / 1000000U;
+
+    return (mhz != 0U) ? mhz : 1U;
+}
+
+/* ================== Profiler ================== */
+
+void BootProf_Start(uint8_t fast)
+{
+    uint32_t count = 1;
+
+#if defined(STM32L431xx)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    if (BootProf_Valid(&s_boot.cur)) {
+        s_boot.prev = s_boot.cur;
+        count = s_boot.cur.boot_count + 1U;
+    } else {
+        /* Power-on: RAM2 holds noise, there is no previous boot */
+        s_boot.prev.magic = 0;
+    }
+
+    s_boot.cur.magic = BOOT_PROF_MAGIC;
+    s_boot.cur.boot_count = count;
+    s_boot.cur.fast = fast;
+    for (uint8_t i = 0; i < (uint8_t)BOOT_PHASE_COUNT; i++) {
+        s_boot.cur.t_us[i] = BOOT_PROF_NOT_REACHED;
+    }
+    s_boot.cur.t_us[BOOT_PHASE_MAIN] = 0;
+    s_boot.cur.check = BootProf_Check(&s_boot.cur);
+
+    s_last_cyc = BootProf_Cycles();
+    s_last_mhz = BootProf_Mhz();
+    s_rem_cyc = 0;
+    s_now_us = 0;
+}
+
+void BootProf_Mark(BootProf_Phase_t phase)
+{
+    uint32_t cyc, elapsed;
+
+    if ((uint32_t)phase >= (uint32_t)BOOT_PHASE_COUNT || s_boot.cur.t_us[phase] != BOOT_PROF_NOT_REACHED) {
+        return;
+    }
+
+    /* SystemClock_Config switches 4 MHz MSI to 80 MHz PLL inside its own interval,
+     * counting the whole interval at the old clock overstates only that phase */
+    cyc = BootProf_Cycles();
+    elapsed = cyc - s_last_cyc;
+    s_now_us += elapsed / s_last_mhz;
+    s_rem_cyc += elapsed % s_last_mhz;
+    if (s_rem_cyc >= s_last_mhz) {
+        s_now_us += s_rem_cyc / s_last_mhz;
+        s_rem_cyc %= s_last_mhz;
+    }
+    s_last_cyc = cyc;
+    s_last_mhz = BootProf_Mhz();
+
+    s_boot.cur.t_us[phase] = s_now_us;
+    s_boot.cur.check = BootProf_Check(&s_boot.cur);
+}
+
+const BootProf_Record_t *BootProf_Current(void)
+{
+    return &s_boot.cur;
+}
+
+const BootProf_Record_t *BootProf_Previous(void)
+{
+    return BootProf_Valid(&s_boot.prev) ? &s_boot.prev : NULL;
+}
+
+uint32_t BootProf_PhaseUs(const BootProf_Record_t *rec, BootProf_Phase_t phase)
+{
+    int8_t p;
+
+    if (rec == NULL || (uint32_t)phase >= (uint32_t)BOOT_PHASE_COUNT || rec->t_us[phase] == BOOT_PROF_NOT_REACHED) {
+        return BOOT_PROF_NOT_REACHED;
+    }
+    for (p = (int8_t)phase - 1; p >= 0; p--) {
+        if (rec->t_us[p] != BOOT_PROF_NOT_REACHED) {
+            return rec->t_us[phase] - rec->t_us[p];
+        }
+    }
+    return 0;
+}
+
+const char *BootProf_PhaseName(BootProf_Phase_t phase)
+{
+    return ((uint32_t)phase < (uint32_t)BOOT_PHASE_COUNT) ? s_phase_names[phase] : "?";
+}
+
+static const char *BootProf_Col(char *buf, size_t size, uint32_t us)
+{
+    if (us == BOOT_PROF_NOT_REACHED) {
+        return "-";
+    }
+    (void)snprintf(buf, size, "%lu", (unsigned long)us);
+    return buf;
+}
+
+void BootProf_Report(void)
+{
+    const BootProf_Record_t *cur = BootProf_Current();
+    const BootProf_Record_t *prev = BootProf_Previous();
+    char a[12], b[12];
+
+    /* Unused when DEBUG_PRINTF is compiled out */
+    (void)cur;
+    (void)prev;
+    (void)a;
+    (void)b;
+    (void)BootProf_Col;
+
+    DEBUG_PRINTF("Boot #%lu (%s), phase times in us, previous boot %s\r\n", (unsigned long)cur->boot_count,
+                 cur->fast ? "fast" : "normal", (prev == NULL) ? "not retained" : (prev->fast ? "fast" : "normal"));
+    for (uint8_t i = 1; i < (uint8_t)BOOT_PHASE_COUNT; i++) {
+        DEBUG_PRINTF("  %-10s %9s %9s\r\n", s_phase_names[i],
+                     BootProf_Col(a, sizeof(a), BootProf_PhaseUs(cur, (BootProf_Phase_t)i)),
+                     BootProf_Col(b, sizeof(b), BootProf_PhaseUs(prev, (BootProf_Phase_t)i)));
+    }
+    DEBUG_PRINTF("  %-10s %9s %9s\r\n", "to poll",
+                 BootProf_Col(a, sizeof(a), cur->t_us[BOOT_PHASE_FIRST_POLL]),
+                 BootProf_Col(b, sizeof(b), (prev == NULL) ? BOOT_PROF_NOT_REACHED : prev->t_us[BOOT_PHASE_FIRST_POLL]));
+}
+
+void BootProf_Clear(void)
+{
+    s_boot.prev.magic = 0;
+    s_boot.cur.magic = 0;
+}
+
+/* ================== Fast boot ================== */
+
+#if defined(STM32L431xx)
+
+static uint32_t s_release_cyc;
+static uint8_t s_early_reset;
+
+void BootFast_Pn5180Reset(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    uint32_t start;
+
+    /* Same pin setup as MX_GPIO_Init, which later only writes RST high again */
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    HAL_GPIO_WritePin(PN5180_RST_GPIO_Port, PN5180_RST_Pin, GPIO_PIN_RESET);
+    GPIO_InitStruct.Pin = PN5180_RST_Pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    HAL_GPIO_Init(PN5180_RST_GPIO_Port, &GPIO_InitStruct);
+
+    start = DWT->CYCCNT;
+    while ((DWT->CYCCNT - start) < BOOT_FAST_RESET_LOW_US * BootProf_Mhz()) {
+    }
+    HAL_GPIO_WritePin(PN5180_RST_GPIO_Port, PN5180_RST_Pin, GPIO_PIN_SET);
+
+    s_release_cyc = DWT->CYCCNT;
+    s_early_reset = 1;
+}
+
+uint8_t BootFast_Pn5180WaitReady(void)
+{
+    uint32_t mhz = BootProf_Mhz();
+
+    if (!s_early_reset) {
+        return 0;
+    }
+    /* Only the first HAL initialisation after the pulse, a re-init resets again */
+    s_early_reset = 0;
+
+    while ((DWT->CYCCNT - s_release_cyc) < BOOT_FAST_PN5180_BOOT_US * mhz) {
+    }
+    while (HAL_GPIO_ReadPin(PN5180_BUSY_GPIO_Port, PN5180_BUSY_Pin) == GPIO_PIN_SET) {
+        if ((DWT->CYCCNT - s_release_cyc) >= (BOOT_FAST_PN5180_BOOT_US + BOOT_FAST_PN5180_TIMEOUT_US) * mhz) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#else /* Host stand-in */
+
+void BootFast_Pn5180Reset(void)
+{
+}
+
+uint8_t BootFast_Pn5180WaitReady(void)
+{
+    return 0;
+}
+
+#endif /* STM32L431xx */
@@ -0,0 +1,494 @@
+/*
+ * cmd_plan.c
+ *
+ * On-device command plans for phNfcLib_Transmit / phNfcLib_Receive
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "cmd_plan.h"
+#include "phApp_Init.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+#include "usart.h"
+#endif
+
+static phNfcLib_Status_t CmdPlan_NfcLibExchange(void *ctx, const CmdPlan_Xchg_t *x,
+                                                uint8_t *rx, uint16_t *rx_len);
+
+static uint8_t s_plan[CMD_PLAN_MAX_LEN];
+static uint16_t s_plan_len;
+static uint8_t s_rx[CMD_PLAN_RX_SIZE];
+static uint8_t s_tx[255];                           /* pBuffer of phNfcLib_Transmit is not const */
+static uint8_t s_uid[8];
+static CmdPlan_ExchangeFct_t s_exchange = CmdPlan_NfcLibExchange;
+static void *s_exchange_ctx = NULL;
+
+#define CMD_PLAN_U16(p)     ((uint16_t)(((uint16_t)(p)[0] << 8) | (p)[1]))
+
+/* ================== Bytecode ================== */
+
+/* Length of the instruction at pc, 0 when unknown or truncated */
+static uint16_t CmdPlan_OpLen(const uint8_t *plan, uint16_t pc, uint16_t len)
+{
+    uint16_t n;
+
+    switch (plan[pc]) {
+    case CMD_PLAN_OP_END:
+    case CMD_PLAN_OP_EXPECT_OK:
+        n = 1U;
+        break;
+    case CMD_PLAN_OP_FAIL:
+        n = 2U;
+        break;
+    case CMD_PLAN_OP_JMP:
+    case CMD_PLAN_OP_CAPTURE:
+    case CMD_PLAN_OP_SET_I:
+        n = 3U;
+        break;
+    case CMD_PLAN_OP_EXPECT_LEN:
+        n = 5U;
+        break;
+    case CMD_PLAN_OP_LOOP:
+        n = 6U;
+        break;
+    case CMD_PLAN_OP_BR:
+        n = 7U;
+        break;
+    case CMD_PLAN_OP_XCHG:
+        /* tx length is the last header byte */
+        if ((uint32_t)pc + 7U > len) {
+            return 0;
+        }
+        n = (uint16_t)(7U + plan[pc + 6U]);
+        break;
+    default:
+        return 0;
+    }
+    return ((uint32_t)pc + n > len) ? 0U : n;
+}
+
+CmdPlan_Code_t CmdPlan_Validate(const uint8_t *plan, uint16_t len, uint16_t *bad_pc)
+{
+    uint8_t starts[CMD_PLAN_MAX_LEN / 8U];
+    uint16_t pc, n, target;
+    uint8_t op;
+
+    if (plan == NULL || len == 0U || len > CMD_PLAN_MAX_LEN) {
+        if (bad_pc != NULL) {
+            *bad_pc = 0;
+        }
+        return CMD_PLAN_ERR_FORMAT;
+    }
+
+    /* Pass 1: instruction boundaries, operands known without jumping */
+    memset(starts, 0, sizeof(starts));
+    for (pc = 0; pc < len; pc = (uint16_t)(pc + n)) {
+        n = CmdPlan_OpLen(plan, pc, len);
+        if (n == 0U) {
+            goto fail;
+        }
+        starts[pc >> 3] |= (uint8_t)(1U << (pc & 7U));
+        op = plan[pc];
+        if (op == CMD_PLAN_OP_XCHG && (plan[pc + 1U] & (uint8_t)~CMD_PLAN_KIND_ADD_I) > CMD_PLAN_KIND_I15693) {
+            goto fail;
+        }
+        if (op == CMD_PLAN_OP_BR && plan[pc + 1U] > CMD_PLAN_COND_LEN_LT) {
+            goto fail;
+        }
+    }
+
+    /* Pass 2: every jump lands on an instruction */
+    for (pc = 0; pc < len; pc = (uint16_t)(pc + CmdPlan_OpLen(plan, pc, len))) {
+        switch (plan[pc]) {
+        case CMD_PLAN_OP_BR:
+            target = CMD_PLAN_U16(&plan[pc + 5U]);
+            break;
+        case CMD_PLAN_OP_JMP:
+            target = CMD_PLAN_U16(&plan[pc + 1U]);
+            break;
+        case CMD_PLAN_OP_LOOP:
+            target = CMD_PLAN_U16(&plan[pc + 4U]);
+            break;
+        default:
+            continue;
+        }
+        if (target >= len || (starts[target >> 3] & (1U << (target & 7U))) == 0U) {
+            goto fail;
+        }
+    }
+    return CMD_PLAN_OK;
+
+fail:
+    if (bad_pc != NULL) {
+        *bad_pc = pc;
+    }
+    return CMD_PLAN_ERR_FORMAT;
+}
+
+CmdPlan_Code_t CmdPlan_Load(const uint8_t *plan, uint16_t len)
+{
+    if (CmdPlan_Validate(plan, len, NULL) != CMD_PLAN_OK) {
+        return CMD_PLAN_ERR_FORMAT;
+    }
+    memcpy(s_plan, plan, len);
+    s_plan_len = len;
+    return CMD_PLAN_OK;
+}
+
+/* ================== Exchange backend ================== */
+
+void CmdPlan_SetExchange(CmdPlan_ExchangeFct_t fct, void *ctx)
+{
+    s_exchange = (fct != NULL) ? fct : CmdPlan_NfcLibExchange;
+    s_exchange_ctx = (fct != NULL) ? ctx : NULL;
+}
+
+void CmdPlan_SetUid(const uint8_t *uid)
+{
+    memcpy(s_uid, uid, sizeof(s_uid));
+}
+
+/* XCHG to simplified API metadata, one phNfcLib_Transmit and the matching phNfcLib_Receive */
+static phNfcLib_Status_t CmdPlan_NfcLibExchange(void *ctx, const CmdPlan_Xchg_t *x,
+                                                uint8_t *rx, uint16_t *rx_len)
+{
+    phNfcLib_Transmit_t meta;
+    phNfcLib_Status_t status;
+    uint16_t tx_len = 0;
+
+    (void)ctx;
+    memset(&meta, 0, sizeof(meta));
+    memcpy(s_tx, x->tx, x->tx_len);
+
+    switch (x->kind) {
+    case CMD_PLAN_KIND_RAW:
+        meta.phNfcLib_RawTransmit.pBuffer = s_tx;
+        tx_len = x->tx_len;
+        break;
+    case CMD_PLAN_KIND_MFUL:
+        meta.phNfcLib_MifareUltraLight.bCommand = (phNfcLib_MFUL_Commands_t)x->cmd;
+        meta.phNfcLib_MifareUltraLight.bPageNumber = (uint8_t)x->arg;
+        meta.phNfcLib_MifareUltraLight.pBuffer = s_tx;
+        break;
+    case CMD_PLAN_KIND_MFC:
+        meta.phNfcLib_MifareClassic.bCommand = (phNfcLib_MFC_Commands_t)x->cmd;
+        meta.phNfcLib_MifareClassic.bBlockNumber = (uint8_t)x->arg;
+        meta.phNfcLib_MifareClassic.bKeyNumber = (uint8_t)(x->arg >> 8);
+        meta.phNfcLib_MifareClassic.bKeyType = x->cnt;
+        meta.phNfcLib_MifareClassic.pBuffer = s_tx;
+        break;
+    default:
+        meta.phNfcLib_ISO15693.bCommand = (phNfcLib_I15693_Commands_t)x->cmd;
+        meta.phNfcLib_ISO15693.wBlockNumber = x->arg;
+        meta.phNfcLib_ISO15693.wNumBlocks = x->cnt;
+        memcpy(meta.phNfcLib_ISO15693.bUid, s_uid, sizeof(s_uid));
+        meta.phNfcLib_ISO15693.pBuffer = s_tx;
+        break;
+    }
+
+    status = phNfcLib_Transmit(&meta, tx_len);
+    if (status != PH_NFCLIB_STATUS_SUCCESS) {
+        *rx_len = 0;
+        return status;
+    }
+    /* No more-data pointer, a response larger than rx is an error rather than silently cut */
+    return phNfcLib_Receive(rx, rx_len, NULL);
+}
+
+/* ================== Interpreter ================== */
+
+CmdPlan_Code_t CmdPlan_Execute(const uint8_t *plan, uint16_t len, uint8_t *out, uint16_t out_size,
+                               CmdPlan_Result_t *result)
+{
+    CmdPlan_Xchg_t x;
+    CmdPlan_Code_t code = CMD_PLAN_OK;
+    uint16_t pc = 0, next;
+    uint16_t rx_len = 0;
+    uint16_t loop_i = 0;
+    uint16_t off, n;
+    uint8_t cond, hold;
+    const uint8_t *ins;
+
+    memset(result, 0, sizeof(*result));
+    result->last_status = PH_NFCLIB_STATUS_SUCCESS;
+
+    while (pc < len) {
+        if (result->steps >= CMD_PLAN_MAX_STEPS) {
+            code = CMD_PLAN_ERR_STEPS;
+            break;
+        }
+        n = CmdPlan_OpLen(plan, pc, len);
+        if (n == 0U) {
+            /* Unvalidated plans stop at anything unknown or truncated */
+            break;
+        }
+        result->steps++;
+        ins = &plan[pc];
+        next = (uint16_t)(pc + n);
+
+        switch (ins[0]) {
+        case CMD_PLAN_OP_XCHG:
+            x.kind = (uint8_t)(ins[1] & (uint8_t)~CMD_PLAN_KIND_ADD_I);
+            x.cmd = ins[2];
+            x.arg = CMD_PLAN_U16(&ins[3]);
+            if ((ins[1] & CMD_PLAN_KIND_ADD_I) != 0U) {
+                x.arg = (uint16_t)(x.arg + loop_i);
+            }
+            x.cnt = ins[5];
+            x.tx_len = ins[6];
+            x.tx = &ins[7];
+            rx_len = (uint16_t)sizeof(s_rx);
+            result->last_status = s_exchange(s_exchange_ctx, &x, s_rx, &rx_len);
+            if (result->last_status != PH_NFCLIB_STATUS_SUCCESS) {
+                rx_len = 0;
+            }
+            result->exchanges++;
+            break;
+
+        case CMD_PLAN_OP_EXPECT_OK:
+            if (result->last_status != PH_NFCLIB_STATUS_SUCCESS) {
+                code = CMD_PLAN_ERR_EXCHANGE;
+            }
+            break;
+
+        case CMD_PLAN_OP_EXPECT_LEN:
+            if (rx_len < CMD_PLAN_U16(&ins[1]) || rx_len > CMD_PLAN_U16(&ins[3])) {
+                code = CMD_PLAN_ERR_LENGTH;
+            }
+            break;
+
+        case CMD_PLAN_OP_BR:
+            cond = ins[1];
+            if (cond == CMD_PLAN_COND_OK || cond == CMD_PLAN_COND_ERR) {
+                hold = (uint8_t)((result->last_status == PH_NFCLIB_STATUS_SUCCESS) == (cond == CMD_PLAN_COND_OK));
+            } else if (cond == CMD_PLAN_COND_LEN_LT) {
+                hold = (uint8_t)(rx_len < ins[4]);
+            } else if (ins[2] >= rx_len) {
+                code = CMD_PLAN_ERR_RANGE;
+                break;
+            } else {
+                hold = (uint8_t)(((s_rx[ins[2]] & ins[3]) == ins[4]) == (cond == CMD_PLAN_COND_BYTE_EQ));
+            }
+            if (hold) {
+                next = CMD_PLAN_U16(&ins[5]);
+            }
+            break;
+
+        case CMD_PLAN_OP_JMP:
+            next = CMD_PLAN_U16(&ins[1]);
+            break;
+
+        case CMD_PLAN_OP_CAPTURE:
+            off = ins[1];
+            n = (ins[2] != 0U) ? ins[2] : (uint16_t)((off < rx_len) ? (uint16_t)(rx_len - off) : 0U);
+            if ((uint32_t)off + n > rx_len) {
+                code = CMD_PLAN_ERR_RANGE;
+            } else if ((uint32_t)result->out_len + n > out_size) {
+                code = CMD_PLAN_ERR_OVERFLOW;
+            } else {
+                memcpy(&out[result->out_len], &s_rx[off], n);
+                result->out_len = (uint16_t)(result->out_len + n);
+            }
+            break;
+
+        case CMD_PLAN_OP_SET_I:
+            loop_i = CMD_PLAN_U16(&ins[1]);
+            break;
+
+        case CMD_PLAN_OP_LOOP:
+            loop_i = (uint16_t)(loop_i + ins[1]);
+            if (loop_i < CMD_PLAN_U16(&ins[2])) {
+                next = CMD_PLAN_U16(&ins[4]);
+            }
+            break;
+
+        case CMD_PLAN_OP_FAIL:
+            result->fail_code = ins[1];
+            code = CMD_PLAN_ERR_ABORT;
+            break;
+
+        default:
+            next = len;
+            break;
+        }
+
+        if (code != CMD_PLAN_OK) {
+            break;
+        }
+        pc = next;
+    }
+
+    result->code = code;
+    result->pc = pc;
+    return code;
+}
+
+CmdPlan_Code_t CmdPlan_Run(uint8_t *out, uint16_t out_size, CmdPlan_Result_t *result)
+{
+    if (s_plan_len == 0U) {
+        memset(result, 0, sizeof(*result));
+        result->code = CMD_PLAN_ERR_NO_PLAN;
+        return CMD_PLAN_ERR_NO_PLAN;
+    }
+    return CmdPlan_Execute(s_plan, s_plan_len, out, out_size, result);
+}
+
+uint8_t CmdPlan_IsLoaded(void)
+{
+    return (s_plan_len != 0U) ? 1U : 0U;
+}
+
+/* ================== Linux link ================== */
+
+uint16_t CmdPlan_BuildResultFrame(const CmdPlan_Result_t *result, const uint8_t *out,
+                                  uint8_t *frame, uint16_t frame_size)
+{
+    uint16_t data_len = (uint16_t)(CMD_PLAN_RESULT_HEADER + result->out_len);
+    uint16_t pos = 0;
+
+    if ((uint32_t)data_len + 7U > frame_size) {
+        return 0;
+    }
+    frame[pos++] = 0xAA;
+    frame[pos++] = 0x55;
+    frame[pos++] = CMD_PLAN_LINUX_CMD_RESULT;
+    frame[pos++] = (uint8_t)(data_len >> 8);
+    frame[pos++] = (uint8_t)data_len;
+    frame[pos++] = (uint8_t)result->code;
+    frame[pos++] = (uint8_t)(result->pc >> 8);
+    frame[pos++] = (uint8_t)result->pc;
+    frame[pos++] = (uint8_t)(result->exchanges >> 8);
+    frame[pos++] = (uint8_t)result->exchanges;
+    frame[pos++] = result->fail_code;
+    frame[pos++] = (uint8_t)(result->last_status >> 24);
+    frame[pos++] = (uint8_t)(result->last_status >> 16);
+    frame[pos++] = (uint8_t)(result->last_status >> 8);
+    frame[pos++] = (uint8_t)result->last_status;
+    if (result->out_len > 0U) {
+        memcpy(&frame[pos], out, result->out_len);
+        pos = (uint16_t)(pos + result->out_len);
+    }
+    frame[pos++] = 0x0D;
+    frame[pos++] = 0x0A;
+    return pos;
+}
+
+#if defined(STM32L431xx)
+
+static uint8_t s_frame[CMD_PLAN_RESULT_HEADER + CMD_PLAN_OUT_SIZE + 7U];
+static uint8_t s_out[CMD_PLAN_OUT_SIZE];
+
+/* Bytes the RX interrupt took before CmdPlan_PollHost saw the frame start */
+static uint8_t s_pre[sizeof(g_uart1_rxbuf)];
+static uint16_t s_pre_len;
+static uint16_t s_pre_pos;
+
+/* HAL_UART_Receive behind the bytes already taken by the RX interrupt */
+static HAL_StatusTypeDef CmdPlan_UartRead(uint8_t *buf, uint16_t len, uint32_t timeout_ms)
+{
+    while (len > 0U && s_pre_pos < s_pre_len) {
+        *buf++ = s_pre[s_pre_pos++];
+        len--;
+    }
+    if (len == 0U) {
+        return HAL_OK;
+    }
+    return HAL_UART_Receive(&huart1, buf, len, timeout_ms);
+}
+
+static void CmdPlan_SendResult(const CmdPlan_Result_t *result, const uint8_t *out)
+{
+    uint16_t len = CmdPlan_BuildResultFrame(result, out, s_frame, (uint16_t)sizeof(s_frame));
+
+    if (len == 0U || HAL_UART_Transmit(&huart1, s_frame, len, 5000) != HAL_OK) {
+        DEBUG_PRINTF("Plan result not sent\r\n");
+    }
+}
+
+CmdPlan_Code_t CmdPlan_ReceiveFromHost(uint32_t timeout_ms)
+{
+    CmdPlan_Result_t result;
+    uint32_t start = HAL_GetTick();
+    uint8_t header[3];
+    uint8_t sync = 0;
+    uint8_t b;
+    uint16_t len;
+
+    /* Resync on AA 55 as EMV_ReceiveLinuxFrame does, the plan is read into the frame buffer */
+    while (sync < 2U) {
+        uint32_t elapsed = HAL_GetTick() - start;
+        if (elapsed >= timeout_ms ||
+            CmdPlan_UartRead(&b, 1, timeout_ms - elapsed) != HAL_OK) {
+            return CMD_PLAN_ERR_NO_PLAN;
+        }
+        if (b == 0xAA) {
+            sync = 1;
+        } else if (sync == 1U && b == 0x55) {
+            sync = 2;
+        } else {
+            sync = 0;
+        }
+    }
+    if (CmdPlan_UartRead(header, sizeof(header), timeout_ms) != HAL_OK) {
+        return CMD_PLAN_ERR_NO_PLAN;
+    }
+    len = (uint16_t)((header[1] << 8) | header[2]);
+    if (header[0] != CMD_PLAN_LINUX_CMD_UPLOAD || len + 2U > sizeof(s_frame) ||
+        CmdPlan_UartRead(s_frame, len + 2U, timeout_ms) != HAL_OK ||
+        s_frame[len] != 0x0D || s_frame[len + 1U] != 0x0A) {
+        return CMD_PLAN_ERR_NO_PLAN;
+    }
+
+    memset(&result, 0, sizeof(result));
+    result.code = CmdPlan_Validate(s_frame, len, &result.pc);
+    if (result.code == CMD_PLAN_OK) {
+        memcpy(s_plan, s_frame, len);
+        s_plan_len = len;
+    }
+    DEBUG_PRINTF("Plan upload: %d bytes, code %d at %d\r\n", len, result.code, result.pc);
+    CmdPlan_SendResult(&result, s_out);
+    return result.code;
+}
+
+CmdPlan_Code_t CmdPlan_RunAndReport(void)
+{
+    CmdPlan_Result_t result;
+
+    (void)CmdPlan_Run(s_out, (uint16_t)sizeof(s_out), &result);
+    DEBUG_PRINTF("Plan run: code %d, %d exchanges, %d bytes\r\n", result.code, result.exchanges, result.out_len);
+    CmdPlan_SendResult(&result, s_out);
+    return result.code;
+}
+
+uint8_t CmdPlan_PollHost(void)
+{
+    CmdPlan_Code_t code;
+
+    if (g_uart1_bytes == 0U) {
+        return 0;
+    }
+    if ((uint8_t)g_uart1_rxbuf[0] != 0xAAU) {
+        /* Console input, not a host frame */
+        clear_uart1_rxbuf();
+        return 0;
+    }
+
+    /* The rest of the frame is read blocking, the interrupt must not take its bytes */
+    uart1_rx_pause();
+    s_pre_len = g_uart1_bytes;
+    s_pre_pos = 0;
+    memcpy(s_pre, g_uart1_rxbuf, s_pre_len);
+    clear_uart1_rxbuf();
+
+    code = CmdPlan_ReceiveFromHost(CMD_PLAN_UPLOAD_TIMEOUT_MS);
+
+    s_pre_len = 0;
+    uart1_rx_resume();
+    return (code == CMD_PLAN_ERR_NO_PLAN) ? 0U : 1U;
+}
+
+#endif /* STM32L431xx */
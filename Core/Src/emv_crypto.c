@@ -0,0 +1,275 @@
+/*
+ * emv_crypto.c
+ *
+ * SHA-1 and RSA public key operation for EMV offline data authentication
+ * Plain C, sized for the EMV key lengths (up to 1984 bit)
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "emv_crypto.h"
+#include <string.h>
+
+/* ================== SHA-1 ================== */
+
+#define SHA1_ROL(x, n)  (((x) << (n)) | ((x) >> (32 - (n))))
+
+static void EMV_Sha1_Block(EMV_Sha1_Ctx_t *ctx, const uint8_t *p)
+{
+    uint32_t w[16];
+    uint32_t a = ctx->state[0], b = ctx->state[1], c = ctx->state[2];
+    uint32_t d = ctx->state[3], e = ctx->state[4];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)p[4 * i] << 24) | ((uint32_t)p[4 * i + 1] << 16) |
+               ((uint32_t)p[4 * i + 2] << 8) | p[4 * i + 3];
+    }
+
+    /* 16 word ring buffer instead of the 80 word schedule */
+    for (int i = 0; i < 80; i++) {
+        uint32_t f, k, t;
+
+        if (i >= 16) {
+            t = w[(i + 13) & 15] ^ w[(i + 8) & 15] ^ w[(i + 2) & 15] ^ w[i & 15];
+            w[i & 15] = SHA1_ROL(t, 1);
+        }
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+        }
+        t = SHA1_ROL(a, 5) + f + e + k + w[i & 15];
+        e = d;
+        d = c;
+        c = SHA1_ROL(b, 30);
+        b = a;
+        a = t;
+    }
+
+    ctx->state[0] += a;
+    ctx->state[1] += b;
+    ctx->state[2] += c;
+    ctx->state[3] += d;
+    ctx->state[4] += e;
+}
+
+void EMV_Sha1_Init(EMV_Sha1_Ctx_t *ctx)
+{
+    ctx->state[0] = 0x67452301;
+    ctx->state[1] = 0xEFCDAB89;
+    ctx->state[2] = 0x98BADCFE;
+    ctx->state[3] = 0x10325476;
+    ctx->state[4] = 0xC3D2E1F0;
+    ctx->count = 0;
+}
+
+void EMV_Sha1_Update(EMV_Sha1_Ctx_t *ctx, const uint8_t *data, uint16_t len)
+{
+    while (len > 0) {
+        uint16_t used = ctx->count & 63;
+        uint16_t n = 64 - used;
+
+        if (n > len) {
+            n = len;
+        }
+        memcpy(&ctx->block[used], data, n);
+        ctx->count += n;
+        data += n;
+        len -= n;
+
+        if ((ctx->count & 63) == 0) {
+            EMV_Sha1_Block(ctx, ctx->block);
+        }
+    }
+}
+
+void EMV_Sha1_Final(EMV_Sha1_Ctx_t *ctx, uint8_t digest[EMV_SHA1_LEN])
+{
+    uint32_t bits = ctx->count * 8;
+    uint16_t used = ctx->count & 63;
+
+    ctx->block[used++] = 0x80;
+    if (used > 56) {
+        memset(&ctx->block[used], 0, 64 - used);
+        EMV_Sha1_Block(ctx, ctx->block);
+        used = 0;
+    }
+    /* Messages here are far below 512 MB, the upper length word stays 0 */
+    memset(&ctx->block[used], 0, 60 - used);
+    ctx->block[60] = (uint8_t)(bits >> 24);
+    ctx->block[61] = (uint8_t)(bits >> 16);
+    ctx->block[62] = (uint8_t)(bits >> 8);
+    ctx->block[63] = (uint8_t)bits;
+    EMV_Sha1_Block(ctx, ctx->block);
+
+    for (int i = 0; i < 5; i++) {
+        digest[4 * i] = (uint8_t)(ctx->state[i] >> 24);
+        digest[4 * i + 1] = (uint8_t)(ctx->state[i] >> 16);
+        digest[4 * i + 2] = (uint8_t)(ctx->state[i] >> 8);
+        digest[4 * i + 3] = (uint8_t)ctx->state[i];
+    }
+}
+
+/* ================== RSA (Montgomery, 32 bit limbs, little endian) ================== */
+
+/* Work buffers are static, the EMV flow already keeps a large context on the stack */
+static uint32_t s_n[EMV_RSA_MAX_WORDS];
+static uint32_t s_rr[EMV_RSA_MAX_WORDS];
+static uint32_t s_x[EMV_RSA_MAX_WORDS];
+static uint32_t s_acc[EMV_RSA_MAX_WORDS];
+static uint32_t s_t[EMV_RSA_MAX_WORDS + 2];
+
+static void EMV_Rsa_FromBytes(uint32_t *w, uint16_t words, const uint8_t *p, uint16_t len)
+{
+    memset(w, 0, words * sizeof(uint32_t));
+    for (uint16_t i = 0; i < len; i++) {
+        uint16_t pos = len - 1 - i;
+        w[pos / 4] |= (uint32_t)p[i] << (8 * (pos % 4));
+    }
+}
+
+static void EMV_Rsa_ToBytes(uint8_t *p, uint16_t len, const uint32_t *w)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        uint16_t pos = len - 1 - i;
+        p[i] = (uint8_t)(w[pos / 4] >> (8 * (pos % 4)));
+    }
+}
+
+/* a >= b */
+static int EMV_Rsa_Geq(const uint32_t *a, const uint32_t *b, uint16_t words)
+{
+    for (int i = words - 1; i >= 0; i--) {
+        if (a[i] != b[i]) {
+            return a[i] > b[i];
+        }
+    }
+    return 1;
+}
+
+/* a -= b, returns the borrow */
+static uint32_t EMV_Rsa_Sub(uint32_t *a, const uint32_t *b, uint16_t words)
+{
+    uint32_t borrow = 0;
+
+    for (uint16_t i = 0; i < words; i++) {
+        uint64_t d = (uint64_t)a[i] - b[i] - borrow;
+        a[i] = (uint32_t)d;
+        borrow = (uint32_t)(d >> 63);
+    }
+    return borrow;
+}
+
+/* r = a * b * R^-1 mod n, CIOS; r may alias a or b */
+static void EMV_Rsa_MontMul(uint32_t *r, const uint32_t *a, const uint32_t *b,
+                            uint32_t n0inv, uint16_t s)
+{
+    uint32_t *t = s_t;
+
+    memset(t, 0, (s + 2) * sizeof(uint32_t));
+
+    for (uint16_t i = 0; i < s; i++) {
+        uint64_t c = 0;
+        uint32_t m;
+
+        for (uint16_t j = 0; j < s; j++) {
+            c = (uint64_t)a[j] * b[i] + t[j] + (c >> 32);
+            t[j] = (uint32_t)c;
+        }
+        c = (uint64_t)t[s] + (c >> 32);
+        t[s] = (uint32_t)c;
+        t[s + 1] = (uint32_t)(c >> 32);
+
+        m = t[0] * n0inv;
+        c = (uint64_t)m * s_n[0] + t[0];
+        for (uint16_t j = 1; j < s; j++) {
+            c = (uint64_t)m * s_n[j] + t[j] + (c >> 32);
+            t[j - 1] = (uint32_t)c;
+        }
+        c = (uint64_t)t[s] + (c >> 32);
+        t[s - 1] = (uint32_t)c;
+        t[s] = t[s + 1] + (uint32_t)(c >> 32);
+    }
+
+    if (t[s] != 0 || EMV_Rsa_Geq(t, s_n, s)) {
+        EMV_Rsa_Sub(t, s_n, s);
+    }
+    memcpy(r, t, s * sizeof(uint32_t));
+}
+
+int EMV_Rsa_Public(const uint8_t *mod, uint16_t mod_len,
+                   const uint8_t *exp, uint8_t exp_len,
+                   const uint8_t *in, uint8_t *out)
+{
+    uint16_t s = (mod_len + 3) / 4;
+    uint32_t e = 0;
+    uint32_t inv = 1;
+    int top;
+
+    if (mod_len == 0 || mod_len > EMV_RSA_MAX_BYTES || exp_len == 0 || exp_len > 3 ||
+        (mod[mod_len - 1] & 0x01) == 0) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < exp_len; i++) {
+        e = (e << 8) | exp[i];
+    }
+    if (e == 0) {
+        return -1;
+    }
+
+    EMV_Rsa_FromBytes(s_n, s, mod, mod_len);
+    EMV_Rsa_FromBytes(s_x, s, in, mod_len);
+    if (EMV_Rsa_Geq(s_x, s_n, s)) {
+        return -1;
+    }
+
+    /* -n^-1 mod 2^32 by Newton iteration */
+    for (int i = 0; i < 5; i++) {
+        inv *= 2 - s_n[0] * inv;
+    }
+    inv = 0 - inv;
+
+    /* R^2 mod n by doubling 1, R = 2^(32s) */
+    memset(s_rr, 0, s * sizeof(uint32_t));
+    s_rr[0] = 1;
+    for (uint32_t i = 0; i < 64U * s; i++) {
+        uint32_t carry = s_rr[s - 1] >> 31;
+
+        for (int j = s - 1; j > 0; j--) {
+            s_rr[j] = (s_rr[j] << 1) | (s_rr[j - 1] >> 31);
+        }
+        s_rr[0] <<= 1;
+        if (carry || EMV_Rsa_Geq(s_rr, s_n, s)) {
+            EMV_Rsa_Sub(s_rr, s_n, s);
+        }
+    }
+
+    /* Left to right square and multiply, the exponent is at most 24 bit */
+    EMV_Rsa_MontMul(s_x, s_x, s_rr, inv, s);
+    memcpy(s_acc, s_x, s * sizeof(uint32_t));
+    for (top = 23; top > 0 && !(e & (1UL << top)); top--) {
+    }
+    for (int i = top - 1; i >= 0; i--) {
+        EMV_Rsa_MontMul(s_acc, s_acc, s_acc, inv, s);
+        if (e & (1UL << i)) {
+            EMV_Rsa_MontMul(s_acc, s_acc, s_x, inv, s);
+        }
+    }
+
+    /* Leave the Montgomery domain */
+    memset(s_rr, 0, s * sizeof(uint32_t));
+    s_rr[0] = 1;
+    EMV_Rsa_MontMul(s_acc, s_acc, s_rr, inv, s);
+
+    EMV_Rsa_ToBytes(out, mod_len, s_acc);
+    return 0;
+}
@@ -0,0 +1,818 @@
+/*
+ * emv_oda.c
+ *
+ * On-device EMV offline data authentication (SDA / DDA / fDDA)
+ * Certificates come from the records in EMV_Complete_Card_Data_t, recovered
+ * issuer keys are cached so a repeat tap of the same issuer skips the RSA work
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "emv_oda.h"
+#include "emv_payment_flow.h"
+#include "rng_entropy.h"
+#include "phCryptoRng.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+
+/* Cycle counter for the per-recovery timing */
+static void EMV_ODA_CyclesStart(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static uint32_t EMV_ODA_Cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+#else /* Host stand-in, the bench runs the checks without a cycle counter */
+
+static void EMV_ODA_CyclesStart(void)
+{
+}
+
+static uint32_t EMV_ODA_Cycles(void)
+{
+    return 0;
+}
+
+#endif /* STM32L431xx */
+
+/* Recovered issuer public key, keyed by (RID, CA index, issuer ID) */
+typedef struct {
+    uint8_t valid;
+    uint8_t rid[5];
+    uint8_t ca_index;
+    uint8_t issuer_id[4];
+    uint8_t cert_hash[EMV_SHA1_LEN];    /* SHA-1 over tags 90, 92 and 9F32 as read from the card */
+    uint8_t modulus[EMV_RSA_MAX_BYTES];
+    uint16_t modulus_len;
+    uint8_t exponent[3];
+    uint8_t exponent_len;
+    uint32_t last_used;
+} EMV_ODA_IssuerKey_t;
+
+/* ICC public key, only kept for one authentication */
+typedef struct {
+    uint8_t modulus[EMV_RSA_MAX_BYTES];
+    uint16_t modulus_len;
+    uint8_t exponent[3];
+    uint8_t exponent_len;
+} EMV_ODA_IccKey_t;
+
+static const EMV_ODA_CaKey_t *s_ca_keys[EMV_ODA_MAX_CA_KEYS];
+static EMV_ODA_IssuerKey_t s_issuer_cache[EMV_ODA_ISSUER_CACHE_SIZE];
+static uint32_t s_cache_clock;
+static EMV_ODA_IccKey_t s_icc_key;
+static uint8_t s_recovered[EMV_RSA_MAX_BYTES];
+
+/* ================== TLV helpers ================== */
+
+/* Find a tag, descending into constructed templates */
+static const uint8_t *EMV_ODA_FindTlv(const uint8_t *buf, uint16_t len, uint16_t tag, uint16_t *out_len)
+{
+    uint16_t pos = 0;
+
+    while (pos < len) {
+        uint16_t t;
+        uint16_t l;
+        uint8_t constructed;
+
+        /* Padding between TLV objects */
+        if (buf[pos] == 0x00 || buf[pos] == 0xFF) {
+            pos++;
+            continue;
+        }
+
+        constructed = buf[pos] & 0x20;
+        t = buf[pos];
+        if ((buf[pos++] & 0x1F) == 0x1F) {
+            if (pos >= len) {
+                return NULL;
+            }
+            t = (t << 8) | buf[pos++];
+        }
+
+        if (pos >= len) {
+            return NULL;
+        }
+        l = buf[pos++];
+        if (l & 0x80) {
+            uint8_t n = l & 0x7F;
+
+            if (n == 0 || n > 2 || pos + n > len) {
+                return NULL;
+            }
+            l = 0;
+            while (n--) {
+                l = (l << 8) | buf[pos++];
+            }
+        }
+        if (pos + l > len) {
+            return NULL;
+        }
+
+        if (t == tag) {
+            *out_len = l;
+            return &buf[pos];
+        }
+        if (constructed) {
+            const uint8_t *p = EMV_ODA_FindTlv(&buf[pos], l, tag, out_len);
+            if (p != NULL) {
+                return p;
+            }
+        }
+        pos += l;
+    }
+    return NULL;
+}
+
+/* Search records, GPO and SELECT responses (stored with SW1 SW2) */
+static const uint8_t *EMV_ODA_FindCardTag(const EMV_Complete_Card_Data_t *card, uint16_t tag, uint16_t *out_len)
+{
+    const uint8_t *p;
+
+    for (uint8_t i = 0; i < card->sfi_record_count; i++) {
+        if (card->sfi_record_lens[i] > 2 &&
+            (p = EMV_ODA_FindTlv(card->sfi_records[i], card->sfi_record_lens[i] - 2, tag, out_len)) != NULL) {
+            return p;
+        }
+    }
+    if (card->gpo_len > 2 &&
+        (p = EMV_ODA_FindTlv(card->gpo_data, card->gpo_len - 2, tag, out_len)) != NULL) {
+        return p;
+    }
+    if (card->app_select_len > 2 &&
+        (p = EMV_ODA_FindTlv(card->app_select_data, card->app_select_len - 2, tag, out_len)) != NULL) {
+        return p;
+    }
+    return NULL;
+}
+
+/* AIP and AFL from a format 1 (80) or format 2 (77) GPO response */
+static int EMV_ODA_GetAipAfl(const EMV_Complete_Card_Data_t *card, const uint8_t **aip,
+                             const uint8_t **afl, uint16_t *afl_len)
+{
+    uint16_t l;
+
+    if (card->gpo_len > 2 && card->gpo_data[0] == 0x80) {
+        const uint8_t *p = EMV_ODA_FindTlv(card->gpo_data, card->gpo_len - 2, 0x80, &l);
+        if (p == NULL || l < 2) {
+            return -1;
+        }
+        *aip = p;
+        *afl = p + 2;
+        *afl_len = l - 2;
+        return 0;
+    }
+
+    *aip = EMV_ODA_FindCardTag(card, 0x82, &l);
+    if (*aip == NULL || l != 2) {
+        return -1;
+    }
+    *afl = EMV_ODA_FindCardTag(card, 0x94, afl_len);
+    if (*afl == NULL) {
+        *afl_len = 0;
+    }
+    return 0;
+}
+
+/* Compare a BCD identifier right padded with F against the leftmost PAN digits */
+static int EMV_ODA_MatchPan(const uint8_t *id, uint8_t id_len, const uint8_t *pan, uint16_t pan_len,
+                            uint8_t whole_pan)
+{
+    uint8_t i;
+    uint8_t pan_digits = 0;
+
+    for (i = 0; i < id_len * 2; i++) {
+        uint8_t d = (i & 1) ? (id[i / 2] & 0x0F) : (id[i / 2] >> 4);
+        uint8_t p;
+
+        if (d == 0x0F) {
+            break;
+        }
+        if (i / 2 >= pan_len) {
+            return -1;
+        }
+        p = (i & 1) ? (pan[i / 2] & 0x0F) : (pan[i / 2] >> 4);
+        if (p != d) {
+            return -1;
+        }
+    }
+    if (i < 3) {
+        return -1;
+    }
+    for (uint8_t j = i; j < id_len * 2; j++) {
+        if (((j & 1) ? (id[j / 2] & 0x0F) : (id[j / 2] >> 4)) != 0x0F) {
+            return -1;
+        }
+    }
+
+    if (whole_pan) {
+        while (pan_digits < pan_len * 2 &&
+               ((pan_digits & 1) ? (pan[pan_digits / 2] & 0x0F) : (pan[pan_digits / 2] >> 4)) != 0x0F) {
+            pan_digits++;
+        }
+        if (pan_digits != i) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* ================== Recovery helpers ================== */
+
+/* RSA recover into s_recovered and check the 6A <format> ... BC frame */
+static int EMV_ODA_Recover(const uint8_t *mod, uint16_t mod_len, const uint8_t *exp, uint8_t exp_len,
+                           const uint8_t *data, uint16_t data_len, uint8_t format)
+{
+    uint32_t start;
+
+    if (data_len != mod_len) {
+        return -1;
+    }
+
+    start = EMV_ODA_Cycles();
+    if (EMV_Rsa_Public(mod, mod_len, exp, exp_len, data, s_recovered) != 0) {
+        return -1;
+    }
+    DEBUG_PRINTF("ODA: RSA-%u recover, %lu cycles\r\n", mod_len * 8, EMV_ODA_Cycles() - start);
+    (void)start;    /* Unused when DEBUG_PRINTF is compiled out */
+
+    if (s_recovered[0] != 0x6A || s_recovered[1] != format || s_recovered[mod_len - 1] != 0xBC) {
+        return -1;
+    }
+    return 0;
+}
+
+/* Hash of the recovered data between the header and the hash field */
+static void EMV_ODA_HashStart(EMV_Sha1_Ctx_t *sha, uint16_t mod_len)
+{
+    EMV_Sha1_Init(sha);
+    EMV_Sha1_Update(sha, &s_recovered[1], mod_len - 22);
+}
+
+static int EMV_ODA_HashCheck(EMV_Sha1_Ctx_t *sha, uint16_t mod_len)
+{
+    uint8_t digest[EMV_SHA1_LEN];
+
+    EMV_Sha1_Final(sha, digest);
+    return (memcmp(digest, &s_recovered[mod_len - 21], EMV_SHA1_LEN) == 0) ? 0 : -1;
+}
+
+/* Records flagged for offline authentication in the AFL, in AFL order, plus the AIP if 9F4A asks for it */
+static int EMV_ODA_HashStaticData(EMV_Sha1_Ctx_t *sha, const EMV_Complete_Card_Data_t *card,
+                                  const uint8_t *aip, const uint8_t *afl, uint16_t afl_len)
+{
+    const uint8_t *tag_list;
+    uint16_t tag_list_len;
+
+    for (uint16_t a = 0; a + 4 <= afl_len; a += 4) {
+        uint8_t sfi = afl[a] >> 3;
+
+        for (uint16_t rec = afl[a + 1]; rec < afl[a + 1] + afl[a + 3] && rec <= afl[a + 2]; rec++) {
+            int idx = -1;
+
+            for (uint8_t i = 0; i < card->sfi_record_count; i++) {
+                if (card->sfi_record_sfi[i] == sfi && card->sfi_record_num[i] == rec) {
+                    idx = i;
+                    break;
+                }
+            }
+            if (idx < 0 || card->sfi_record_lens[idx] <= 2) {
+                return -1;
+            }
+
+            if (sfi <= 10) {
+                /* SFI 1-10: value of the record template only */
+                uint16_t vl;
+                const uint8_t *v;
+
+                if (card->sfi_records[idx][0] != 0x70) {
+                    return -1;
+                }
+                v = EMV_ODA_FindTlv(card->sfi_records[idx], card->sfi_record_lens[idx] - 2, 0x70, &vl);
+                if (v == NULL) {
+                    return -1;
+                }
+                EMV_Sha1_Update(sha, v, vl);
+            } else {
+                EMV_Sha1_Update(sha, card->sfi_records[idx], card->sfi_record_lens[idx] - 2);
+            }
+        }
+    }
+
+    tag_list = EMV_ODA_FindCardTag(card, 0x9F4A, &tag_list_len);
+    if (tag_list != NULL) {
+        if (tag_list_len != 1 || tag_list[0] != 0x82) {
+            return -1;
+        }
+        EMV_Sha1_Update(sha, aip, 2);
+    }
+    return 0;
+}
+
+static const EMV_ODA_CaKey_t *EMV_ODA_FindCaKey(const uint8_t *rid, uint8_t index)
+{
+    for (int i = 0; i < EMV_ODA_MAX_CA_KEYS; i++) {
+        if (s_ca_keys[i] != NULL && s_ca_keys[i]->index == index &&
+            memcmp(s_ca_keys[i]->rid, rid, 5) == 0) {
+            return s_ca_keys[i];
+        }
+    }
+    return NULL;
+}
+
+/* Issuer public key from the cache, or recovered from tag 90 with the CA key */
+static const EMV_ODA_IssuerKey_t *EMV_ODA_GetIssuerKey(const EMV_Complete_Card_Data_t *card,
+                                                       const uint8_t *rid, EMV_ODA_Result_t *res)
+{
+    const uint8_t *cert, *index, *exp, *rem, *pan;
+    uint16_t cert_len, index_len, exp_len, rem_len = 0, pan_len;
+    uint8_t cert_hash[EMV_SHA1_LEN];
+    EMV_Sha1_Ctx_t sha;
+    const EMV_ODA_CaKey_t *ca;
+    EMV_ODA_IssuerKey_t *slot;
+    uint16_t n, ni, left;
+
+    *res = EMV_ODA_NOT_SUPPORTED;
+    cert = EMV_ODA_FindCardTag(card, 0x90, &cert_len);
+    index = EMV_ODA_FindCardTag(card, 0x8F, &index_len);
+    exp = EMV_ODA_FindCardTag(card, 0x9F32, &exp_len);
+    rem = EMV_ODA_FindCardTag(card, 0x92, &rem_len);
+    pan = EMV_ODA_FindCardTag(card, 0x5A, &pan_len);
+    if (cert == NULL || index == NULL || index_len != 1 || exp == NULL || exp_len == 0 ||
+        exp_len > 3 || pan == NULL) {
+        return NULL;
+    }
+    if (rem == NULL) {
+        rem_len = 0;
+    }
+
+    EMV_Sha1_Init(&sha);
+    EMV_Sha1_Update(&sha, cert, cert_len);
+    EMV_Sha1_Update(&sha, rem, rem_len);
+    EMV_Sha1_Update(&sha, exp, exp_len);
+    EMV_Sha1_Final(&sha, cert_hash);
+
+    /* Repeat tap of the same issuer: same certificate, no RSA needed */
+    for (int i = 0; i < EMV_ODA_ISSUER_CACHE_SIZE; i++) {
+        slot = &s_issuer_cache[i];
+        if (slot->valid && slot->ca_index == index[0] && memcmp(slot->rid, rid, 5) == 0 &&
+            memcmp(slot->cert_hash, cert_hash, EMV_SHA1_LEN) == 0 &&
+            EMV_ODA_MatchPan(slot->issuer_id, 4, pan, pan_len, 0) == 0) {
+            slot->last_used = ++s_cache_clock;
+            DEBUG_PRINTF("ODA: issuer key cache hit\r\n");
+            *res = EMV_ODA_OK;
+            return slot;
+        }
+    }
+
+    ca = EMV_ODA_FindCaKey(rid, index[0]);
+    if (ca == NULL) {
+        DEBUG_PRINTF("ODA: no CA key %02X for RID %02X%02X%02X%02X%02X\r\n",
+                     index[0], rid[0], rid[1], rid[2], rid[3], rid[4]);
+        *res = EMV_ODA_NO_CA_KEY;
+        return NULL;
+    }
+
+    *res = EMV_ODA_FAILED;
+    n = ca->modulus_len;
+    if (n < 36 || EMV_ODA_Recover(ca->modulus, n, ca->exponent, ca->exponent_len, cert, cert_len, 0x02) != 0) {
+        return NULL;
+    }
+
+    /* Hash and public key algorithm 01 (SHA-1, RSA) */
+    if (s_recovered[11] != 0x01 || s_recovered[12] != 0x01) {
+        return NULL;
+    }
+    ni = s_recovered[13];
+    left = n - 36;
+    if (ni > EMV_RSA_MAX_BYTES || s_recovered[14] != exp_len ||
+        (ni > left && rem_len != ni - left)) {
+        return NULL;
+    }
+    if (EMV_ODA_MatchPan(&s_recovered[2], 4, pan, pan_len, 0) != 0) {
+        return NULL;
+    }
+
+    EMV_ODA_HashStart(&sha, n);
+    EMV_Sha1_Update(&sha, rem, rem_len);
+    EMV_Sha1_Update(&sha, exp, exp_len);
+    if (EMV_ODA_HashCheck(&sha, n) != 0) {
+        return NULL;
+    }
+    /* Certificate expiry (bytes 6-7) is not checked, the board has no calendar */
+
+    /* Free slot, or the least recently used one */
+    slot = &s_issuer_cache[0];
+    for (int i = 0; i < EMV_ODA_ISSUER_CACHE_SIZE; i++) {
+        if (!s_issuer_cache[i].valid) {
+            slot = &s_issuer_cache[i];
+            break;
+        }
+        if (s_issuer_cache[i].last_used < slot->last_used) {
+            slot = &s_issuer_cache[i];
+        }
+    }
+
+    memcpy(slot->rid, rid, 5);
+    slot->ca_index = index[0];
+    memcpy(slot->issuer_id, &s_recovered[2], 4);
+    memcpy(slot->cert_hash, cert_hash, EMV_SHA1_LEN);
+    if (ni <= left) {
+        memcpy(slot->modulus, &s_recovered[15], ni);
+    } else {
+        memcpy(slot->modulus, &s_recovered[15], left);
+        memcpy(&slot->modulus[left], rem, ni - left);
+    }
+    slot->modulus_len = ni;
+    memcpy(slot->exponent, exp, exp_len);
+    slot->exponent_len = (uint8_t)exp_len;
+    slot->last_used = ++s_cache_clock;
+    slot->valid = 1;
+
+    *res = EMV_ODA_OK;
+    return slot;
+}
+
+/* ICC public key from tag 9F46, also authenticates the static data */
+static EMV_ODA_Result_t EMV_ODA_GetIccKey(const EMV_Complete_Card_Data_t *card, const EMV_ODA_IssuerKey_t *issuer,
+                                          const uint8_t *aip, const uint8_t *afl, uint16_t afl_len)
+{
+    const uint8_t *cert, *exp, *rem, *pan;
+    uint16_t cert_len, exp_len, rem_len = 0, pan_len;
+    EMV_Sha1_Ctx_t sha;
+    uint16_t n = issuer->modulus_len;
+    uint16_t nic, left;
+
+    cert = EMV_ODA_FindCardTag(card, 0x9F46, &cert_len);
+    exp = EMV_ODA_FindCardTag(card, 0x9F47, &exp_len);
+    rem = EMV_ODA_FindCardTag(card, 0x9F48, &rem_len);
+    pan = EMV_ODA_FindCardTag(card, 0x5A, &pan_len);
+    if (cert == NULL || exp == NULL || exp_len == 0 || exp_len > 3 || pan == NULL) {
+        return EMV_ODA_NOT_SUPPORTED;
+    }
+    if (rem == NULL) {
+        rem_len = 0;
+    }
+
+    if (n < 42 || EMV_ODA_Recover(issuer->modulus, n, issuer->exponent, issuer->exponent_len,
+                                  cert, cert_len, 0x04) != 0) {
+        return EMV_ODA_FAILED;
+    }
+    if (s_recovered[17] != 0x01 || s_recovered[18] != 0x01) {
+        return EMV_ODA_FAILED;
+    }
+    nic = s_recovered[19];
+    left = n - 42;
+    if (nic > EMV_RSA_MAX_BYTES || s_recovered[20] != exp_len ||
+        (nic > left && rem_len != nic - left)) {
+        return EMV_ODA_FAILED;
+    }
+    if (EMV_ODA_MatchPan(&s_recovered[2], 10, pan, pan_len, 1) != 0) {
+        return EMV_ODA_FAILED;
+    }
+
+    EMV_ODA_HashStart(&sha, n);
+    EMV_Sha1_Update(&sha, rem, rem_len);
+    EMV_Sha1_Update(&sha, exp, exp_len);
+    if (EMV_ODA_HashStaticData(&sha, card, aip, afl, afl_len) != 0 ||
+        EMV_ODA_HashCheck(&sha, n) != 0) {
+        return EMV_ODA_FAILED;
+    }
+
+    if (nic <= left) {
+        memcpy(s_icc_key.modulus, &s_recovered[21], nic);
+    } else {
+        memcpy(s_icc_key.modulus, &s_recovered[21], left);
+        memcpy(&s_icc_key.modulus[left], rem, nic - left);
+    }
+    s_icc_key.modulus_len = nic;
+    memcpy(s_icc_key.exponent, exp, exp_len);
+    s_icc_key.exponent_len = (uint8_t)exp_len;
+    return EMV_ODA_OK;
+}
+
+/* Signed Dynamic Application Data check, dyn_data is the terminal data hashed after the recovered part */
+static EMV_ODA_Result_t EMV_ODA_CheckSdad(const uint8_t *sdad, uint16_t sdad_len,
+                                          const uint8_t *dyn_data, uint16_t dyn_len,
+                                          const uint8_t *extra, uint16_t extra_len)
+{
+    EMV_Sha1_Ctx_t sha;
+    uint16_t n = s_icc_key.modulus_len;
+
+    if (n < 26 || EMV_ODA_Recover(s_icc_key.modulus, n, s_icc_key.exponent, s_icc_key.exponent_len,
+                                  sdad, sdad_len, 0x05) != 0) {
+        return EMV_ODA_FAILED;
+    }
+    if (s_recovered[2] != 0x01 || s_recovered[3] > n - 25) {
+        return EMV_ODA_FAILED;
+    }
+
+    EMV_ODA_HashStart(&sha, n);
+    EMV_Sha1_Update(&sha, dyn_data, dyn_len);
+    EMV_Sha1_Update(&sha, extra, extra_len);
+    return (EMV_ODA_HashCheck(&sha, n) == 0) ? EMV_ODA_OK : EMV_ODA_FAILED;
+}
+
+/* ================== Terminal data ================== */
+
+/* Value of a DOL entry: numeric values are right aligned, binary ones left aligned */
+static void EMV_ODA_DolValue(uint8_t *out, uint8_t l, const uint8_t *val, uint8_t val_len, uint8_t numeric)
+{
+    memset(out, 0, l);
+    if (val == NULL) {
+        return;
+    }
+    if (!numeric) {
+        memcpy(out, val, (val_len < l) ? val_len : l);
+    } else if (val_len >= l) {
+        memcpy(out, &val[val_len - l], l);
+    } else {
+        memcpy(&out[l - val_len], val, val_len);
+    }
+}
+
+/* Fill a data object list (PDOL, DDOL), tags without a terminal value are zero filled */
+static int EMV_ODA_BuildDol(const uint8_t *dol, uint16_t dol_len, const EMV_Complete_Card_Data_t *card,
+                            const EMV_ODA_TerminalData_t *terminal, uint8_t *out, uint16_t out_size)
+{
+    static const uint8_t ttq[] = EMV_ODA_TERMINAL_TTQ;
+    const uint8_t country[2] = {(uint8_t)(EMV_ODA_TERMINAL_COUNTRY >> 8), (uint8_t)EMV_ODA_TERMINAL_COUNTRY};
+    const uint8_t type = EMV_ODA_TERMINAL_TYPE;
+    uint16_t out_len = 0;
+
+    for (uint16_t pos = 0; pos < dol_len;) {
+        uint16_t tag = dol[pos++];
+        const uint8_t *val = NULL;
+        uint8_t val_len = 0;
+        uint8_t numeric = 0;
+        uint8_t l;
+
+        if ((tag & 0x1F) == 0x1F && pos < dol_len) {
+            tag = (tag << 8) | dol[pos++];
+        }
+        if (pos >= dol_len) {
+            break;
+        }
+        l = dol[pos++];
+        if (out_len + l > out_size) {
+            return -1;
+        }
+
+        switch (tag) {
+        case 0x9F37:
+            val = terminal->unpredictable_number;
+            val_len = sizeof(terminal->unpredictable_number);
+            break;
+        case 0x9F02:
+            val = terminal->amount;
+            val_len = sizeof(terminal->amount);
+            numeric = 1;
+            break;
+        case 0x5F2A:
+            val = terminal->currency;
+            val_len = sizeof(terminal->currency);
+            numeric = 1;
+            break;
+        case 0x9C:
+            val = &card->transaction_type;
+            val_len = 1;
+            numeric = 1;
+            break;
+        case 0x9F1A:
+            val = country;
+            val_len = sizeof(country);
+            numeric = 1;
+            break;
+        case 0x9F35:
+            val = &type;
+            val_len = 1;
+            numeric = 1;
+            break;
+        case 0x9F66:
+            val = ttq;
+            val_len = sizeof(ttq);
+            break;
+        default:
+            break;
+        }
+        EMV_ODA_DolValue(&out[out_len], l, val, val_len, numeric);
+        out_len += l;
+    }
+    return out_len;
+}
+
+static EMV_ODA_Result_t EMV_ODA_Dda(const EMV_Complete_Card_Data_t *card,
+                                    const EMV_ODA_TerminalData_t *terminal)
+{
+    static const uint8_t default_ddol[] = {0x9F, 0x37, 0x04};
+    EMV_ODA_TerminalData_t fresh;
+    uint8_t ddol_data[32];
+    int ddol_data_len;
+    uint8_t response[256];
+    uint16_t response_len = 0;
+    const uint8_t *ddol, *sdad;
+    uint16_t ddol_len, sdad_len;
+
+    if (terminal == NULL) {
+        EMV_ODA_GetTerminalData(card, &fresh);
+        if (EMV_ODA_Unpredictable(fresh.unpredictable_number, sizeof(fresh.unpredictable_number)) != 0) {
+            return EMV_ODA_FAILED;
+        }
+        terminal = &fresh;
+    }
+
+    ddol = EMV_ODA_FindCardTag(card, 0x9F49, &ddol_len);
+    if (ddol == NULL) {
+        ddol = default_ddol;
+        ddol_len = sizeof(default_ddol);
+    }
+    ddol_data_len = EMV_ODA_BuildDol(ddol, ddol_len, card, terminal, ddol_data, sizeof(ddol_data));
+    if (ddol_data_len < 0) {
+        return EMV_ODA_NOT_SUPPORTED;
+    }
+
+    if (EMV_InternalAuthenticate(ddol_data, (uint16_t)ddol_data_len, response, &response_len) != EMV_SUCCESS ||
+        response_len < 2) {
+        return EMV_ODA_FAILED;
+    }
+
+    if (response[0] == 0x80) {
+        sdad = EMV_ODA_FindTlv(response, response_len, 0x80, &sdad_len);
+    } else {
+        sdad = EMV_ODA_FindTlv(response, response_len, 0x9F4B, &sdad_len);
+    }
+    if (sdad == NULL) {
+        return EMV_ODA_FAILED;
+    }
+    return EMV_ODA_CheckSdad(sdad, sdad_len, ddol_data, (uint16_t)ddol_data_len, NULL, 0);
+}
+
+static EMV_ODA_Result_t EMV_ODA_Fdda(const EMV_Complete_Card_Data_t *card,
+                                     const EMV_ODA_TerminalData_t *terminal,
+                                     const uint8_t *sdad, uint16_t sdad_len)
+{
+    uint8_t dyn_data[12];                   /* 9F37 || 9F02 || 5F2A */
+    const uint8_t *card_auth;
+    uint16_t card_auth_len;
+
+    /* The card signed the GPO values, without them there is nothing to check against */
+    if (terminal == NULL) {
+        return EMV_ODA_NOT_SUPPORTED;
+    }
+    memcpy(dyn_data, terminal->unpredictable_number, 4);
+    memcpy(&dyn_data[4], terminal->amount, 6);
+    memcpy(&dyn_data[10], terminal->currency, 2);
+
+    /* Card Authentication Related Data, absent on fDDA version 00 */
+    card_auth = EMV_ODA_FindCardTag(card, 0x9F69, &card_auth_len);
+    if (card_auth == NULL) {
+        card_auth_len = 0;
+    }
+
+    return EMV_ODA_CheckSdad(sdad, sdad_len, dyn_data, sizeof(dyn_data), card_auth, card_auth_len);
+}
+
+/* ================== Interface ================== */
+
+int EMV_ODA_Unpredictable(uint8_t *un, uint16_t len)
+{
+    /* Hardware entropy may still be waiting for the first idle time */
+    (void)RngEntropy_AttachPending();
+    return (phCryptoRng_Rnd(phNfcLib_GetDataParams(PH_COMP_CRYPTORNG), len, un) == PH_ERR_SUCCESS) ? 0 : -1;
+}
+
+void EMV_ODA_GetTerminalData(const EMV_Complete_Card_Data_t *card, EMV_ODA_TerminalData_t *terminal)
+{
+    uint32_t amount = card->amount;
+
+    memcpy(terminal->unpredictable_number, card->unpredictable_number, sizeof(terminal->unpredictable_number));
+
+    /* n12: two decimal digits per byte, least significant last */
+    for (int i = sizeof(terminal->amount) - 1; i >= 0; i--) {
+        terminal->amount[i] = (uint8_t)(amount % 10);
+        amount /= 10;
+        terminal->amount[i] |= (uint8_t)((amount % 10) << 4);
+        amount /= 10;
+    }
+
+    /* Currency codes are kept as BCD already, 0x0156 for CNY */
+    terminal->currency[0] = (uint8_t)(card->currency_code >> 8);
+    terminal->currency[1] = (uint8_t)card->currency_code;
+}
+
+int EMV_ODA_BuildPdol(const EMV_Complete_Card_Data_t *card, uint8_t *out, uint16_t out_size)
+{
+    EMV_ODA_TerminalData_t terminal;
+    const uint8_t *pdol;
+    uint16_t pdol_len;
+
+    if (card->app_select_len <= 2) {
+        return 0;
+    }
+    pdol = EMV_ODA_FindTlv(card->app_select_data, card->app_select_len - 2, 0x9F38, &pdol_len);
+    if (pdol == NULL) {
+        return 0;
+    }
+
+    EMV_ODA_GetTerminalData(card, &terminal);
+    return EMV_ODA_BuildDol(pdol, pdol_len, card, &terminal, out, out_size);
+}
+
+int EMV_ODA_AddCaKey(const EMV_ODA_CaKey_t *key)
+{
+    for (int i = 0; i < EMV_ODA_MAX_CA_KEYS; i++) {
+        if (s_ca_keys[i] == NULL || s_ca_keys[i] == key) {
+            s_ca_keys[i] = key;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void EMV_ODA_ClearIssuerCache(void)
+{
+    memset(s_issuer_cache, 0, sizeof(s_issuer_cache));
+}
+
+EMV_ODA_Result_t EMV_ODA_Authenticate(const EMV_Complete_Card_Data_t *card,
+                                      const EMV_ODA_TerminalData_t *terminal,
+                                      EMV_ODA_Method_t *method)
+{
+    const uint8_t *aip, *afl, *aid, *sdad;
+    uint16_t afl_len, aid_len, sdad_len = 0;
+    const EMV_ODA_IssuerKey_t *issuer;
+    EMV_ODA_Result_t res;
+
+    *method = EMV_ODA_NONE;
+
+    EMV_ODA_CyclesStart();
+
+    if (EMV_ODA_GetAipAfl(card, &aip, &afl, &afl_len) != 0) {
+        return EMV_ODA_NOT_SUPPORTED;
+    }
+
+    /* RID from the DF name of the selected application */
+    aid = EMV_ODA_FindTlv(card->app_select_data, card->app_select_len > 2 ? card->app_select_len - 2 : 0,
+                          0x84, &aid_len);
+    if (aid == NULL || aid_len < 5) {
+        return EMV_ODA_NOT_SUPPORTED;
+    }
+
+    if (card->gpo_len > 2) {
+        sdad = EMV_ODA_FindTlv(card->gpo_data, card->gpo_len - 2, 0x9F4B, &sdad_len);
+    } else {
+        sdad = NULL;
+    }
+
+    if (sdad != NULL) {
+        *method = EMV_ODA_FDDA;
+    } else if (aip[0] & 0x20) {
+        *method = EMV_ODA_DDA;
+    } else if (aip[0] & 0x40) {
+        *method = EMV_ODA_SDA;
+    } else {
+        return EMV_ODA_NOT_SUPPORTED;
+    }
+
+    issuer = EMV_ODA_GetIssuerKey(card, aid, &res);
+    if (issuer == NULL) {
+        return res;
+    }
+
+    if (*method == EMV_ODA_SDA) {
+        const uint8_t *ssad = EMV_ODA_FindCardTag(card, 0x93, &sdad_len);
+        EMV_Sha1_Ctx_t sha;
+        uint16_t n = issuer->modulus_len;
+
+        if (ssad == NULL) {
+            return EMV_ODA_NOT_SUPPORTED;
+        }
+        if (n < 26 || EMV_ODA_Recover(issuer->modulus, n, issuer->exponent, issuer->exponent_len,
+                                      ssad, sdad_len, 0x03) != 0 || s_recovered[2] != 0x01) {
+            return EMV_ODA_FAILED;
+        }
+        EMV_ODA_HashStart(&sha, n);
+        if (EMV_ODA_HashStaticData(&sha, card, aip, afl, afl_len) != 0) {
+            return EMV_ODA_FAILED;
+        }
+        return (EMV_ODA_HashCheck(&sha, n) == 0) ? EMV_ODA_OK : EMV_ODA_FAILED;
+    }
+
+    res = EMV_ODA_GetIccKey(card, issuer, aip, afl, afl_len);
+    if (res != EMV_ODA_OK) {
+        return res;
+    }
+
+    if (*method == EMV_ODA_FDDA) {
+        return EMV_ODA_Fdda(card, terminal, sdad, sdad_len);
+    }
+    return EMV_ODA_Dda(card, terminal);
+}
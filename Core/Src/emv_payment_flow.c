@@ -9,12 +9,128 @@
  */
 
 #include "emv_payment_flow.h"
+#include "emv_sched.h"
+#include "emv_oda.h"
+#include "emv_resume.h"
 #include "phApp_Init.h"
 #include "main.h"
 
 /* External UART handle for Linux communication */
 extern UART_HandleTypeDef huart1;
 
+/* Batch request / reply frame, kept off the stack */
+static uint8_t s_batch_frame[1024];
+
+/**
+ * Decision of a stage: from the batch reply if the host answered it, else one exchange
+ */
+static Linux_Response_t EMV_DecideStage(EMV_Payment_Context_t *context, uint8_t stage, Linux_Command_t cmd)
+{
+    if (context->batch_decided & stage) {
+        uint8_t i = 0;
+
+        while (!(stage & (1U << i))) {
+            i++;
+        }
+        return (Linux_Response_t)context->batch_decision[i];
+    }
+    return EMV_FormatAndSendLinuxCommand(cmd, context);
+}
+
+/**
+ * Queue every record of the card, waiting for the UART when the ring is full.
+ * Only used while no APDU is in flight.
+ */
+static void EMV_UplinkAllRecords(const EMV_Complete_Card_Data_t *card)
+{
+    for(uint8_t i = 0; i < card->sfi_record_count; i++) {
+        if(EMV_QueueRecordToLinux(card->sfi_record_sfi[i], card->sfi_record_num[i],
+                                  card->sfi_records[i], card->sfi_record_lens[i]) != 0) {
+            EMV_Uplink_Drain();
+            (void)EMV_QueueRecordToLinux(card->sfi_record_sfi[i], card->sfi_record_num[i],
+                                         card->sfi_records[i], card->sfi_record_lens[i]);
+        }
+    }
+}
+
+#if EMV_RESUME_ENABLE
+
+/**
+ * The card lost its selection with the field: SELECT the cached AID again, no PPSE
+ */
+static EMV_Result_t EMV_ResumeReselect(EMV_Payment_Context_t *context)
+{
+    EMV_Complete_Card_Data_t *card = &context->card_data;
+    uint8_t apdu[6 + EMV_RESUME_MAX_AID];
+    uint8_t aid_len = 0;
+    const uint8_t *aid = EMV_Resume_Aid(&aid_len);
+    uint8_t *rx;
+    uint16_t rx_len = 0;
+
+    if(aid == NULL) {
+        return EMV_ERROR_APP_SELECT;
+    }
+    apdu[0] = 0x00;
+    apdu[1] = 0xA4;
+    apdu[2] = 0x04;
+    apdu[3] = 0x00;
+    apdu[4] = aid_len;
+    memcpy(&apdu[5], aid, aid_len);
+    apdu[5 + aid_len] = 0x00;
+
+    if(EMV_Sched_ExchangeApdu(apdu, 6 + aid_len, &rx, &rx_len) != PH_ERR_SUCCESS) {
+        return EMV_ERROR_COMMUNICATION;
+    }
+    if(rx_len < 2 || rx_len > sizeof(card->app_select_data) ||
+       rx[rx_len - 2] != 0x90 || rx[rx_len - 1] != 0x00) {
+        EMV_Resume_Drop();
+        return EMV_ERROR_APP_SELECT;
+    }
+    memcpy(card->app_select_data, rx, rx_len);
+    card->app_select_len = rx_len;
+
+    return EMV_Resume_MatchSelect(card) ? EMV_SUCCESS : EMV_ERROR_APP_SELECT;
+}
+
+/**
+ * After the fresh GPO: check the card behind a random UID, then reuse the cached records
+ */
+static EMV_Result_t EMV_ResumeRecords(EMV_Payment_Context_t *context)
+{
+    uint8_t sfi, record;
+    const uint8_t *cached;
+    uint16_t cached_len;
+    uint8_t n;
+
+    if(EMV_Resume_PanRecord(&sfi, &record, &cached, &cached_len)) {
+        uint8_t apdu[5] = {0x00, 0xB2, record, (uint8_t)((sfi << 3) | 0x04), 0x00};
+        uint8_t *rx;
+        uint16_t rx_len = 0;
+
+        if(EMV_Sched_ExchangeApdu(apdu, sizeof(apdu), &rx, &rx_len) != PH_ERR_SUCCESS) {
+            return EMV_ERROR_COMMUNICATION;
+        }
+        if(rx_len != cached_len || memcmp(rx, cached, rx_len) != 0) {
+            DEBUG_PRINTF("Resume: PAN record differs, reading all records\r\n");
+            EMV_Resume_Drop();
+            context->resuming = 0;
+            return EMV_SUCCESS;
+        }
+    }
+
+    n = EMV_Resume_Restore(&context->card_data);
+    DEBUG_PRINTF("Resume: %d records reused\r\n", n);
+    (void)n;    /* Unused when DEBUG_PRINTF is compiled out */
+
+    if(EMV_Resume_RecordsComplete()) {
+        EMV_Uplink_Start();
+        EMV_UplinkAllRecords(&context->card_data);
+        EMV_Uplink_Flush();
+    }
+    return EMV_SUCCESS;
+}
+#endif /* EMV_RESUME_ENABLE */
+
 /* ================== Implementation ================== */
 
 /**
@@ -91,6 +207,12 @@ EMV_Result_t EMV_Payment_ProcessStateMachine(EMV_Payment_Context_t *context)
             result = EMV_State_ApplicationInitialization(context);
             if(result == EMV_SUCCESS) {
                 context->next_state = EMV_STATE_READ_APP_DATA;
+#if EMV_RESUME_ENABLE
+                /* Every record was read before the tear: continue at the first state not completed */
+                if(context->resuming && EMV_Resume_RecordsComplete()) {
+                    context->next_state = EMV_STATE_OFFLINE_DATA_AUTH;
+                }
+#endif
             }
             break;
 
@@ -195,6 +317,7 @@ EMV_Result_t EMV_Payment_ProcessStateMachine(EMV_Payment_Context_t *context)
         DEBUG_PRINTF("<<< Transition to: %s\r\n",
                     EMV_Payment_GetStateDescription(context->next_state));
     } else {
+        context->failed_state = context->current_state;
         context->current_state = EMV_STATE_FAILED;
         context->last_error = result;
         DEBUG_PRINTF("<<< State processing failed, error code: %d\r\n", result);
@@ -212,6 +335,18 @@ EMV_Result_t EMV_State_ApplicationSelection(EMV_Payment_Context_t *context)
 {
     DEBUG_PRINTF("Executing Application Selection...\r\n");
 
+#if EMV_RESUME_ENABLE
+    if(context->resuming) {
+        EMV_Result_t resumed = EMV_ResumeReselect(context);
+
+        if(resumed == EMV_SUCCESS || resumed == EMV_ERROR_COMMUNICATION) {
+            return resumed;
+        }
+        DEBUG_PRINTF("Resume: different application, full selection\r\n");
+        context->resuming = 0;
+    }
+#endif
+
     /* Reuse existing PPSE selection logic */
     EMV_Result_t result = EMV_CollectPPSEInfo(&context->card_data);
     if(result != EMV_SUCCESS) {
@@ -244,6 +379,21 @@ EMV_Result_t EMV_State_ApplicationInitialization(EMV_Payment_Context_t *context)
         return result;
     }
 
+#if EMV_RESUME_ENABLE
+    /* GPO always runs again, ATC and cryptogram are new: only AIP and AFL have to match */
+    if(context->resuming) {
+        if(!EMV_Resume_MatchGpo(&context->card_data)) {
+            DEBUG_PRINTF("Resume: AIP / AFL changed, reading all records\r\n");
+            context->resuming = 0;
+        } else {
+            result = EMV_ResumeRecords(context);
+            if(result != EMV_SUCCESS) {
+                return result;
+            }
+        }
+    }
+#endif
+
     DEBUG_PRINTF("Application initialization completed\r\n");
     return EMV_SUCCESS;
 }
@@ -255,8 +405,24 @@ EMV_Result_t EMV_State_ReadApplicationData(EMV_Payment_Context_t *context)
 {
     DEBUG_PRINTF("Reading Application Data...\r\n");
 
+    /* Stream each record to Linux while the next one is being read */
+    uint32_t dropped = EMV_Uplink_Dropped();
+    EMV_Uplink_Start();
+#if EMV_RESUME_ENABLE
+    /* Records from before the tear are sent first, only the missing ones are read */
+    if(context->resuming) {
+        EMV_UplinkAllRecords(&context->card_data);
+    }
+#endif
+
     /* Reuse existing record reading logic */
     EMV_Result_t result = EMV_CollectAllRecords(&context->card_data);
+    if(result == EMV_SUCCESS && EMV_Uplink_Dropped() != dropped) {
+        /* The ring was full for some record, send them all again, the host keys them by SFI and record */
+        EMV_Uplink_Drain();
+        EMV_UplinkAllRecords(&context->card_data);
+    }
+    EMV_Uplink_Flush();
     if(result != EMV_SUCCESS) {
         DEBUG_PRINTF("Read application data failed\r\n");
         return result;
@@ -274,17 +440,47 @@ EMV_Result_t EMV_State_OfflineDataAuthentication(EMV_Payment_Context_t *context)
 {
     DEBUG_PRINTF("Executing Offline Data Authentication...\r\n");
 
-    uint8_t auth_data[] = {0xEF, 0x08, 0x3F, 0x1A};
+    /* Certificates checked on the device when the CA key is loaded, fDDA against the GPO values */
+    EMV_ODA_Method_t method;
+    EMV_ODA_TerminalData_t terminal;
+    EMV_ODA_GetTerminalData(&context->card_data, &terminal);
+    EMV_ODA_Result_t oda = EMV_ODA_Authenticate(&context->card_data, &terminal, &method);
+
+    if (oda == EMV_ODA_FAILED) {
+        context->offline_auth_result = 0;
+        DEBUG_PRINTF("Offline data authentication failed (method %d)\r\n", method);
+        return EMV_ERROR_TRANSACTION_DECLINED;
+    }
+
     uint8_t internal_auth_response[256];
     uint16_t internal_auth_len = 0;
 
-    DEBUG_PRINTF("SEND INTERNAL AUTHENTICATE CMD...\r\n");
-    EMV_InternalAuthenticate(auth_data, sizeof(auth_data),
-                            internal_auth_response, &internal_auth_len);
+    if (oda == EMV_ODA_OK) {
+        context->offline_auth_result = 1;
+    } else {
+        DEBUG_PRINTF("SEND INTERNAL AUTHENTICATE CMD...\r\n");
+        EMV_InternalAuthenticate(terminal.unpredictable_number, sizeof(terminal.unpredictable_number),
+                                internal_auth_response, &internal_auth_len);
+    }
+
+    /* Every host decision of this tap in one round trip, restrictions and risk stay local */
+    uint8_t stages = EMV_STAGE_TERMINAL_ACTION | EMV_STAGE_SCRIPT_PROCESSING;
+    if (oda != EMV_ODA_OK) {
+        stages |= EMV_STAGE_OFFLINE_DATA_AUTH;
+    }
+    if (context->card_data.amount > EMV_TERMINAL_FLOOR_LIMIT) {
+        stages |= EMV_STAGE_ONLINE_PROCESSING | EMV_STAGE_ISSUER_AUTH;
+    }
+    (void)EMV_Batch_RequestDecisions(context, stages, internal_auth_response, internal_auth_len);
+
+    if (oda == EMV_ODA_OK) {
+        DEBUG_PRINTF("Offline data authentication successful (method %d)\r\n", method);
+        return EMV_SUCCESS;
+    }
 
-    /* Send certificate data to Linux for verification */
-    Linux_Response_t response = EMV_FormatAndSendLinuxCommand(
-        LINUX_CMD_OFFLINE_DATA_AUTH, context);
+    /* No CA key or no ODA data: let Linux verify */
+    Linux_Response_t response = EMV_DecideStage(context, EMV_STAGE_OFFLINE_DATA_AUTH,
+                                                LINUX_CMD_OFFLINE_DATA_AUTH);
 
     switch(response) {
         case LINUX_RESP_SUCCESS:
@@ -310,25 +506,17 @@ EMV_Result_t EMV_State_ProcessingRestrictions(EMV_Payment_Context_t *context)
 {
     DEBUG_PRINTF("Checking Processing Restrictions...\r\n");
 
-    /* Send transaction amount and restriction info to Linux for checking */
-    Linux_Response_t response = EMV_FormatAndSendLinuxCommand(
-        LINUX_CMD_PROCESS_RESTRICTIONS, context);
-
-    switch(response) {
-        case LINUX_RESP_SUCCESS:
-            context->restrictions_result = 1; /* Passed restriction check */
-            DEBUG_PRINTF("Processing restrictions check passed\r\n");
-            return EMV_SUCCESS;
-
-        case LINUX_RESP_DECLINED:
-            context->restrictions_result = 0; /* Failed restriction check */
-            DEBUG_PRINTF("Processing restrictions check failed\r\n");
-            return EMV_ERROR_TRANSACTION_DECLINED;
-
-        default:
-            DEBUG_PRINTF("Linux communication failed\r\n");
-            return EMV_ERROR_COMMUNICATION;
+    /* Amount limits are terminal configuration, no need to ask Linux */
+    if(context->card_data.amount == 0 ||
+       context->card_data.amount > EMV_TERMINAL_MAX_AMOUNT) {
+        context->restrictions_result = 0; /* Failed restriction check */
+        DEBUG_PRINTF("Processing restrictions check failed\r\n");
+        return EMV_ERROR_TRANSACTION_DECLINED;
     }
+
+    context->restrictions_result = 1; /* Passed restriction check */
+    DEBUG_PRINTF("Processing restrictions check passed\r\n");
+    return EMV_SUCCESS;
 }
 
 /**
@@ -356,31 +544,15 @@ EMV_Result_t EMV_State_TerminalRiskManagement(EMV_Payment_Context_t *context)
 {
     DEBUG_PRINTF("Executing Terminal Risk Management...\r\n");
 
-    /* Send transaction data to Linux for risk assessment */
-    Linux_Response_t response = EMV_FormatAndSendLinuxCommand(
-        LINUX_CMD_TERMINAL_RISK_MGMT, context);
-
-    switch(response) {
-        case LINUX_RESP_SUCCESS:
-        case LINUX_RESP_OFFLINE_APPROVED:
-            context->risk_management_result = 1; /* Risk acceptable */
-            DEBUG_PRINTF("Terminal risk management passed\r\n");
-            return EMV_SUCCESS;
-
-        case LINUX_RESP_ONLINE_REQUIRED:
-            context->risk_management_result = 2; /* Online required */
-            DEBUG_PRINTF("Terminal risk management requires online processing\r\n");
-            return EMV_SUCCESS;
-
-        case LINUX_RESP_DECLINED:
-            context->risk_management_result = 0; /* Risk too high */
-            DEBUG_PRINTF("Terminal risk management declined transaction\r\n");
-            return EMV_ERROR_TRANSACTION_DECLINED;
-
-        default:
-            DEBUG_PRINTF("Linux communication failed\r\n");
-            return EMV_ERROR_COMMUNICATION;
+    /* Floor limit check, decided locally */
+    if(context->card_data.amount > EMV_TERMINAL_FLOOR_LIMIT) {
+        context->risk_management_result = 2; /* Online required */
+        DEBUG_PRINTF("Terminal risk management requires online processing\r\n");
+    } else {
+        context->risk_management_result = 1; /* Risk acceptable */
+        DEBUG_PRINTF("Terminal risk management passed\r\n");
     }
+    return EMV_SUCCESS;
 }
 
 /**
@@ -391,8 +563,8 @@ EMV_Result_t EMV_State_TerminalActionAnalysis(EMV_Payment_Context_t *context)
     DEBUG_PRINTF("Executing Terminal Action Analysis...\r\n");
 
     /* Send historical transaction data to Linux for behavior analysis */
-    Linux_Response_t response = EMV_FormatAndSendLinuxCommand(
-        LINUX_CMD_TERMINAL_ACTION_ANALYSIS, context);
+    Linux_Response_t response = EMV_DecideStage(context, EMV_STAGE_TERMINAL_ACTION,
+                                                LINUX_CMD_TERMINAL_ACTION_ANALYSIS);
 
     switch(response) {
         case LINUX_RESP_SUCCESS:
@@ -445,8 +617,8 @@ EMV_Result_t EMV_State_OnlineProcessing(EMV_Payment_Context_t *context)
     DEBUG_PRINTF("Executing Online Processing...\r\n");
 
     /* Send transaction request to Linux for online authorization */
-    Linux_Response_t response = EMV_FormatAndSendLinuxCommand(
-        LINUX_CMD_ONLINE_PROCESSING, context);
+    Linux_Response_t response = EMV_DecideStage(context, EMV_STAGE_ONLINE_PROCESSING,
+                                                LINUX_CMD_ONLINE_PROCESSING);
 
     switch(response) {
         case LINUX_RESP_APPROVED:
@@ -471,8 +643,8 @@ EMV_Result_t EMV_State_IssuerAuthentication(EMV_Payment_Context_t *context)
     DEBUG_PRINTF("Executing Issuer Authentication...\r\n");
 
     /* Send ARPC for issuer authentication */
-    Linux_Response_t response = EMV_FormatAndSendLinuxCommand(
-        LINUX_CMD_ISSUER_AUTH, context);
+    Linux_Response_t response = EMV_DecideStage(context, EMV_STAGE_ISSUER_AUTH,
+                                                LINUX_CMD_ISSUER_AUTH);
 
     switch(response) {
         case LINUX_RESP_SUCCESS:
@@ -525,8 +697,8 @@ EMV_Result_t EMV_State_ScriptProcessing(EMV_Payment_Context_t *context)
         DEBUG_PRINTF("Executing issuer scripts (%d bytes)...\r\n", context->script_len);
 
         /* Send scripts to Linux for processing */
-        Linux_Response_t response = EMV_FormatAndSendLinuxCommand(
-            LINUX_CMD_SCRIPT_PROCESSING, context);
+        Linux_Response_t response = EMV_DecideStage(context, EMV_STAGE_SCRIPT_PROCESSING,
+                                                    LINUX_CMD_SCRIPT_PROCESSING);
 
         if(response != LINUX_RESP_SUCCESS) {
             DEBUG_PRINTF("Script execution failed\r\n");
@@ -634,6 +806,184 @@ Linux_Response_t EMV_SendToLinux(Linux_Command_t cmd,
     return resp_code;
 }
 
+/**
+ * Receive one [HEAD][RESP][LEN_H][LEN_L][DATA][TAIL] frame, returns the data length or -1
+ */
+static int EMV_ReceiveLinuxFrame(uint8_t *resp_code, uint8_t *data, uint16_t size, uint32_t timeout)
+{
+    uint32_t start = HAL_GetTick();
+    uint8_t header[3];
+    uint8_t sync = 0;
+    uint8_t b;
+    uint16_t len;
+
+    /* Resync on AA 55, only complete frames are read so no fixed size wait */
+    while(sync < 2) {
+        uint32_t elapsed = HAL_GetTick() - start;
+        if(elapsed >= timeout ||
+           HAL_UART_Receive(&huart1, &b, 1, timeout - elapsed) != HAL_OK) {
+            return -1;
+        }
+        if(b == 0xAA) {
+            sync = 1;
+        } else if(sync == 1 && b == 0x55) {
+            sync = 2;
+        } else {
+            sync = 0;
+        }
+    }
+
+    if(HAL_UART_Receive(&huart1, header, sizeof(header), timeout) != HAL_OK) {
+        return -1;
+    }
+    len = (header[1] << 8) | header[2];
+    if(len + 2 > size ||
+       HAL_UART_Receive(&huart1, data, len + 2, timeout) != HAL_OK ||
+       data[len] != 0x0D || data[len + 1] != 0x0A) {
+        return -1;
+    }
+
+    *resp_code = header[0];
+    return len;
+}
+
+/**
+ * Batched decision request, see the frame layout in emv_payment_flow.h
+ */
+EMV_Result_t EMV_Batch_RequestDecisions(EMV_Payment_Context_t *context, uint8_t stages,
+                                        const uint8_t *ia_data, uint16_t ia_len)
+{
+    EMV_Complete_Card_Data_t *card = &context->card_data;
+    uint8_t *frame = s_batch_frame;
+    uint16_t pos = 5;
+    uint16_t data_len;
+    uint8_t resp_code;
+    uint32_t start;
+    int rx_len;
+
+    context->batch_decided = 0;
+
+#if !EMV_LINUX_BATCH_ENABLE
+    return EMV_ERROR_COMMUNICATION;
+#endif
+
+    if(ia_data == NULL) {
+        ia_len = 0;
+    }
+
+    frame[pos++] = stages;
+    frame[pos++] = (uint8_t)(card->amount >> 24);
+    frame[pos++] = (uint8_t)(card->amount >> 16);
+    frame[pos++] = (uint8_t)(card->amount >> 8);
+    frame[pos++] = (uint8_t)card->amount;
+    frame[pos++] = (uint8_t)(card->currency_code >> 8);
+    frame[pos++] = (uint8_t)card->currency_code;
+    frame[pos++] = card->transaction_type;
+    frame[pos++] = (stages & EMV_STAGE_OFFLINE_DATA_AUTH) ? 0xFF : context->offline_auth_result;
+    frame[pos++] = card->card_uid_len;
+    memcpy(&frame[pos], card->card_uid, card->card_uid_len);
+    pos += card->card_uid_len;
+
+    frame[pos++] = (uint8_t)(card->app_select_len >> 8);
+    frame[pos++] = (uint8_t)card->app_select_len;
+    memcpy(&frame[pos], card->app_select_data, card->app_select_len);
+    pos += card->app_select_len;
+
+    frame[pos++] = (uint8_t)(card->gpo_len >> 8);
+    frame[pos++] = (uint8_t)card->gpo_len;
+    memcpy(&frame[pos], card->gpo_data, card->gpo_len);
+    pos += card->gpo_len;
+
+    frame[pos++] = (uint8_t)(ia_len >> 8);
+    frame[pos++] = (uint8_t)ia_len;
+    memcpy(&frame[pos], ia_data, ia_len);
+    pos += ia_len;
+
+    data_len = pos - 5;
+    frame[0] = 0xAA;
+    frame[1] = 0x55;
+    frame[2] = LINUX_CMD_BATCH_DECISION;
+    frame[3] = (data_len >> 8) & 0xFF;
+    frame[4] = data_len & 0xFF;
+    frame[pos++] = 0x0D;
+    frame[pos++] = 0x0A;
+
+    DEBUG_PRINTF("Batch decision request, stages 0x%02X, %d bytes\r\n", stages, pos);
+
+    start = HAL_GetTick();
+    if(HAL_UART_Transmit(&huart1, frame, pos, 5000) != HAL_OK) {
+        return EMV_ERROR_COMMUNICATION;
+    }
+    rx_len = EMV_ReceiveLinuxFrame(&resp_code, frame, sizeof(s_batch_frame), EMV_LINUX_BATCH_TIMEOUT_MS);
+    if(rx_len < 1 || resp_code != LINUX_RESP_SUCCESS) {
+        DEBUG_PRINTF("Batch decision: no reply, per-stage fallback\r\n");
+        return EMV_ERROR_COMMUNICATION;
+    }
+
+    /* One decision byte for each requested stage */
+    pos = 1;
+    for(uint8_t i = 0; i < EMV_STAGE_COUNT; i++) {
+        if(stages & (1U << i)) {
+            if(pos >= rx_len) {
+                return EMV_ERROR_COMMUNICATION;
+            }
+            context->batch_decision[i] = frame[pos++];
+        }
+    }
+
+    if(pos + 2 <= rx_len) {
+        uint16_t len = (frame[pos] << 8) | frame[pos + 1];
+        pos += 2;
+        if(len > sizeof(context->authorization_response) || pos + len > rx_len) {
+            return EMV_ERROR_COMMUNICATION;
+        }
+        memcpy(context->authorization_response, &frame[pos], len);
+        context->auth_response_len = len;
+        pos += len;
+    }
+    if(pos + 2 <= rx_len) {
+        uint16_t len = (frame[pos] << 8) | frame[pos + 1];
+        pos += 2;
+        if(len > sizeof(context->issuer_scripts) || pos + len > rx_len) {
+            return EMV_ERROR_COMMUNICATION;
+        }
+        memcpy(context->issuer_scripts, &frame[pos], len);
+        context->script_len = len;
+    }
+
+    context->batch_decided = frame[0] & stages;
+    DEBUG_PRINTF("Batch decision: stages 0x%02X decided in %lu ms\r\n",
+                context->batch_decided, HAL_GetTick() - start);
+    (void)start;    /* Unused when DEBUG_PRINTF is compiled out */
+    return EMV_SUCCESS;
+}
+
+/**
+ * Queue record frame: [HEAD][CMD][LEN_H][LEN_L][SFI][REC][DATA][TAIL]
+ */
+int EMV_QueueRecordToLinux(uint8_t sfi, uint8_t record, const uint8_t *data, uint16_t data_len)
+{
+    static uint8_t frame[7 + 256 + 2];
+    uint16_t len = data_len + 2;
+
+    if(data_len > 256) {
+        return -1;
+    }
+    frame[0] = 0xAA;
+    frame[1] = 0x55;
+    frame[2] = LINUX_CMD_RECORD_UPLINK;
+    frame[3] = (len >> 8) & 0xFF;
+    frame[4] = len & 0xFF;
+    frame[5] = sfi;
+    frame[6] = record;
+    memcpy(&frame[7], data, data_len);
+    frame[7 + data_len] = 0x0D;
+    frame[8 + data_len] = 0x0A;
+
+    /* One queue call, the frame is either sent whole or dropped */
+    return (EMV_Uplink_Queue(frame, (uint16_t)(data_len + 9)) != 0) ? 0 : -1;
+}
+
 /**
  * Format and send Linux command (SIMULATION MODE)
  */
@@ -691,6 +1041,16 @@ Linux_Response_t EMV_FormatAndSendLinuxCommand(Linux_Command_t cmd, EMV_Payment_
             DEBUG_PRINTF("Expected: Process post-transaction commands\r\n");
             DEBUG_PRINTF("Action: Parse scripts -> Execute updates -> Log results\r\n");
             break;
+
+        case LINUX_CMD_RECORD_UPLINK:
+            /* Streamed by EMV_QueueRecordToLinux, never a request */
+            DEBUG_PRINTF("Command: 0x%02X - Record uplink is not a request\r\n", cmd);
+            break;
+
+        case LINUX_CMD_BATCH_DECISION:
+            /* Sent by EMV_Batch_RequestDecisions, never a per-stage request */
+            DEBUG_PRINTF("Command: 0x%02X - Batch decision is not a per-stage request\r\n", cmd);
+            break;
     }
 
     DEBUG_PRINTF("=== ASSUMING SUCCESS, CONTINUE ===\r\n\r\n");
@@ -723,56 +1083,90 @@ Linux_Response_t EMV_FormatAndSendLinuxCommand(Linux_Command_t cmd, EMV_Payment_
 
 /* ================== Main Integration Interface ================== */
 
+/* 4.2 KB, more than the whole 4 KB stack: kept in SRAM2 with the other large buffers */
+PH_MEMLOC_RAM2 static EMV_Payment_Context_t s_payment_context;
+
 /**
  * Main EMV payment flow entry function - replaces EMV_ProcessTransaction_Enhanced
  */
 EMV_Result_t EMV_ProcessPaymentFlow(void *pDataParams, uint32_t amount, uint16_t currency_code)
 {
-    EMV_Payment_Context_t payment_context;
     EMV_Result_t result;
 
     /* 1. Initialize payment flow */
-    result = EMV_Payment_Initialize(&payment_context, pDataParams, amount, currency_code);
+    result = EMV_Payment_Initialize(&s_payment_context, pDataParams, amount, currency_code);
     if(result != EMV_SUCCESS) {
         DEBUG_PRINTF("Payment flow initialization failed\r\n");
         return result;
     }
 
     /* 2. Collect basic card information first */
-    result = EMV_CollectCardBasicInfo((phacDiscLoop_Sw_DataParams_t*)pDataParams, &payment_context.card_data);
+    result = EMV_CollectCardBasicInfo((phacDiscLoop_Sw_DataParams_t*)pDataParams, &s_payment_context.card_data);
     if(result != EMV_SUCCESS) {
         DEBUG_PRINTF("Card basic information collection failed\r\n");
         return result;
     }
 
+#if EMV_RESUME_ENABLE
+    /* Same card and purchase shortly after a tear: reuse what was read */
+    s_payment_context.resuming = EMV_Resume_Lookup(&s_payment_context.card_data, HAL_GetTick());
+    if(s_payment_context.resuming) {
+        DEBUG_PRINTF("Resuming torn transaction, stopped at: %s\r\n",
+                    EMV_Payment_GetStateDescription(EMV_Resume_FailedState()));
+    }
+#endif
+
     /* 3. Execute state machine until completion or failure */
-    while(payment_context.current_state != EMV_STATE_SUCCESS &&
-          payment_context.current_state != EMV_STATE_FAILED) {
+    while(s_payment_context.current_state != EMV_STATE_SUCCESS &&
+          s_payment_context.current_state != EMV_STATE_FAILED) {
 
-        result = EMV_Payment_ProcessStateMachine(&payment_context);
+        result = EMV_Payment_ProcessStateMachine(&s_payment_context);
 
         if(result != EMV_SUCCESS) {
             DEBUG_PRINTF("State machine processing failed: %s\r\n",
-                        EMV_Payment_GetStateDescription(payment_context.current_state));
+                        EMV_Payment_GetStateDescription(s_payment_context.current_state));
             break;
         }
 
         /* Add small delay for process observation */
+#if EMV_RESUME_ENABLE
+        /* Not on a resumed tap: the card already left the field once, keep its field time short */
+        if(!s_payment_context.resuming)
+#endif
         HAL_Delay(500);
     }
 
     /* 4. Display final result */
-    if(payment_context.current_state == EMV_STATE_SUCCESS) {
+    if(s_payment_context.current_state == EMV_STATE_SUCCESS) {
         DEBUG_PRINTF("\r\n=== EMV Payment Flow Completed Successfully ===\r\n");
+#if EMV_RESUME_ENABLE
+        EMV_Resume_Clear();
+#endif
         EMV_ShowSuccessIndication();
         return EMV_SUCCESS;
     } else {
         DEBUG_PRINTF("\r\n=== EMV Payment Flow Failed ===\r\n");
         DEBUG_PRINTF("Last error: %d, Failed state: %s\r\n",
-                    payment_context.last_error,
-                    EMV_Payment_GetStateDescription(payment_context.current_state));
-        EMV_ShowFailureIndication();
-        return payment_context.last_error;
+                    s_payment_context.last_error,
+                    EMV_Payment_GetStateDescription(s_payment_context.current_state));
+#if EMV_RESUME_ENABLE
+        /* Card errors may be a tear, a decision is final */
+        if(s_payment_context.last_error == EMV_ERROR_COMMUNICATION ||
+           s_payment_context.last_error == EMV_ERROR_APP_SELECT ||
+           s_payment_context.last_error == EMV_ERROR_GPO ||
+           s_payment_context.last_error == EMV_ERROR_READ_RECORD) {
+            EMV_Resume_Save(&s_payment_context, HAL_GetTick());
+        } else {
+            EMV_Resume_Clear();
+        }
+#endif
+        if(s_payment_context.last_error == EMV_ERROR_COMMUNICATION) {
+            /* Exchange failed mid-transaction: card removed before the flow ended */
+            EMV_ShowCardTooSlowIndication();
+        } else {
+            EMV_ShowFailureIndication();
+        }
+        return s_payment_context.last_error;
     }
 }
 
@@ -804,9 +1198,7 @@ EMV_Result_t EMV_InternalAuthenticate(uint8_t *auth_data, uint16_t auth_data_len
     uint8_t *rx_buffer;
     uint16_t rx_len = 0;
 
-    status = phpalI14443p4_Exchange(
-        phNfcLib_GetDataParams(PH_COMP_PAL_ISO14443P4),
-        PH_EXCHANGE_DEFAULT, apdu, apdu_len, &rx_buffer, &rx_len);
+    status = EMV_Sched_ExchangeApdu(apdu, apdu_len, &rx_buffer, &rx_len);
 
     if (status == PH_ERR_SUCCESS && rx_len >= 2) {
         uint8_t sw1 = rx_buffer[rx_len-2];
@@ -0,0 +1,413 @@
+/*
+ * emv_resume.c
+ *
+ * Tearing-tolerant EMV transaction resume
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "emv_resume.h"
+#include <ph_RefDefs.h>
+#include <string.h>
+
+#define EMV_RESUME_NO_RECORD        0xFFU
+
+/* Static card data of the last torn transaction */
+typedef struct {
+    uint8_t valid;
+    uint8_t armed;                          /* Matched by EMV_Resume_Lookup for the tap in progress */
+    uint32_t stamp_ms;                      /* Tear, or the last re-tap that tore again */
+
+    /* Key */
+    uint8_t uid[10];
+    uint8_t uid_len;
+    uint8_t random_uid;
+    uint32_t amount;
+    uint16_t currency_code;
+    uint8_t has_select;                     /* 0: torn in application selection, AID from the PPSE directory */
+    uint8_t pdol[EMV_RESUME_MAX_PDOL];      /* 9F38 of the SELECT response, what GPO is built from */
+    uint8_t pdol_len;
+    uint8_t has_gpo;
+    uint32_t gpo_digest;                    /* AIP and AFL only */
+
+    /* Progress */
+    EMV_Payment_State_t failed_state;
+    uint8_t aid[EMV_RESUME_MAX_AID];
+    uint8_t aid_len;
+    uint8_t pan_record;                     /* Record carrying tag 5A or 57, EMV_RESUME_NO_RECORD if none */
+    uint8_t record_count;
+    uint8_t records[EMV_RESUME_MAX_RECORDS][256];
+    uint16_t record_lens[EMV_RESUME_MAX_RECORDS];
+    uint8_t record_sfi[EMV_RESUME_MAX_RECORDS];
+    uint8_t record_num[EMV_RESUME_MAX_RECORDS];
+} EMV_Resume_Entry_t;
+
+/* 2.7 KB, kept out of the main RAM bank like the other large buffers */
+PH_MEMLOC_RAM2 static EMV_Resume_Entry_t s_entry;
+static EMV_Resume_Stats_t s_stats;
+
+/* ================== Helpers ================== */
+
+/* FNV-1a, a cache key and not a MAC: a collision is caught by the SELECT / GPO / PAN checks that follow */
+static uint32_t EMV_Resume_Digest(uint32_t h, const uint8_t *data, uint16_t len)
+{
+    while (len--) {
+        h ^= *data++;
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+#define EMV_RESUME_DIGEST_INIT      2166136261UL
+
+/* Find a tag among the TLV objects at one level, the templates used here are not nested deeper */
+static const uint8_t *EMV_Resume_FindTlv(const uint8_t *buf, uint16_t len, uint16_t tag, uint16_t *out_len)
+{
+    uint16_t pos = 0;
+
+    while (pos < len) {
+        uint16_t t;
+        uint16_t l;
+
+        if (buf[pos] == 0x00 || buf[pos] == 0xFF) {
+            pos++;
+            continue;
+        }
+        t = buf[pos];
+        if ((buf[pos++] & 0x1F) == 0x1F) {
+            if (pos >= len) {
+                return NULL;
+            }
+            t = (t << 8) | buf[pos++];
+        }
+        if (pos >= len) {
+            return NULL;
+        }
+        l = buf[pos++];
+        if (l & 0x80) {
+            uint8_t n = l & 0x7F;
+
+            if (n == 0 || n > 2 || pos + n > len) {
+                return NULL;
+            }
+            l = 0;
+            while (n--) {
+                l = (l << 8) | buf[pos++];
+            }
+        }
+        if (pos + l > len) {
+            return NULL;
+        }
+        if (t == tag) {
+            *out_len = l;
+            return &buf[pos];
+        }
+        pos += l;
+    }
+    return NULL;
+}
+
+/* Tag inside a template, responses stored with SW1 SW2 */
+static const uint8_t *EMV_Resume_FindIn(const uint8_t *resp, uint16_t resp_len, uint16_t tmpl, uint16_t tag,
+                                        uint16_t *out_len)
+{
+    const uint8_t *t;
+    uint16_t tl;
+
+    if (resp_len <= 2 || (t = EMV_Resume_FindTlv(resp, resp_len - 2, tmpl, &tl)) == NULL) {
+        return NULL;
+    }
+    return EMV_Resume_FindTlv(t, tl, tag, out_len);
+}
+
+/* PDOL of a SELECT response, 6F / A5 / 9F38, empty when the card asks for no terminal data */
+static const uint8_t *EMV_Resume_Pdol(const EMV_Complete_Card_Data_t *card, uint16_t *pdol_len)
+{
+    const uint8_t *a5, *pdol;
+    uint16_t a5_len;
+
+    *pdol_len = 0;
+    a5 = EMV_Resume_FindIn(card->app_select_data, card->app_select_len, 0x6F, 0xA5, &a5_len);
+    if (a5 == NULL || (pdol = EMV_Resume_FindTlv(a5, a5_len, 0x9F38, pdol_len)) == NULL) {
+        *pdol_len = 0;
+        return NULL;
+    }
+    return pdol;
+}
+
+/* Highest priority AID of the PPSE directory, 6F / A5 / BF0C / 61 / 4F and 87, none before the PPSE answered */
+static const uint8_t *EMV_Resume_PpseAid(const EMV_Complete_Card_Data_t *card, uint16_t *aid_len)
+{
+    const uint8_t *a5, *dir, *best = NULL;
+    uint16_t a5_len, dir_len, pos = 0;
+    uint8_t best_prio = 0xFF;
+
+    a5 = EMV_Resume_FindIn(card->ppse_data, card->ppse_len, 0x6F, 0xA5, &a5_len);
+    if (a5 == NULL || (dir = EMV_Resume_FindTlv(a5, a5_len, 0xBF0C, &dir_len)) == NULL) {
+        return NULL;
+    }
+
+    /* One 61 entry per application, walked here because FindTlv stops at the first */
+    while (pos + 2 <= dir_len) {
+        const uint8_t *aid, *prio;
+        uint16_t l = dir[pos + 1], al, pl;
+
+        if ((dir[pos + 1] & 0x80) || pos + 2 + l > dir_len) {
+            break;
+        }
+        if (dir[pos] == 0x61 && (aid = EMV_Resume_FindTlv(&dir[pos + 2], l, 0x4F, &al)) != NULL) {
+            /* Priority in the low nibble of 87, an entry without 87 comes last */
+            prio = EMV_Resume_FindTlv(&dir[pos + 2], l, 0x87, &pl);
+            if (best == NULL || (prio != NULL && pl > 0 && (prio[0] & 0x0F) < best_prio)) {
+                best = aid;
+                *aid_len = al;
+                best_prio = (prio != NULL && pl > 0) ? (prio[0] & 0x0F) : 0xFF;
+            }
+        }
+        pos += 2 + l;
+    }
+    return best;
+}
+
+/* AIP and AFL from a format 1 (80) or format 2 (77) GPO response */
+static uint8_t EMV_Resume_GpoDigest(const EMV_Complete_Card_Data_t *card, uint32_t *digest)
+{
+    const uint8_t *aip, *afl;
+    uint16_t aip_len, afl_len;
+
+    if (card->gpo_len <= 2) {
+        return 0;
+    }
+    if (card->gpo_data[0] == 0x80) {
+        aip = EMV_Resume_FindTlv(card->gpo_data, card->gpo_len - 2, 0x80, &aip_len);
+        if (aip == NULL || aip_len < 2) {
+            return 0;
+        }
+        *digest = EMV_Resume_Digest(EMV_RESUME_DIGEST_INIT, aip, aip_len);
+        return 1;
+    }
+    aip = EMV_Resume_FindIn(card->gpo_data, card->gpo_len, 0x77, 0x82, &aip_len);
+    afl = EMV_Resume_FindIn(card->gpo_data, card->gpo_len, 0x77, 0x94, &afl_len);
+    if (aip == NULL || afl == NULL) {
+        return 0;
+    }
+    *digest = EMV_Resume_Digest(EMV_Resume_Digest(EMV_RESUME_DIGEST_INIT, aip, aip_len), afl, afl_len);
+    return 1;
+}
+
+static uint8_t EMV_Resume_IsRandomUid(const uint8_t *uid, uint8_t uid_len)
+{
+    return (uid_len == 4 && uid[0] == 0x08) ? 1 : 0;
+}
+
+/* ================== Interface ================== */
+
+void EMV_Resume_Save(const EMV_Payment_Context_t *context, uint32_t now_ms)
+{
+    const EMV_Complete_Card_Data_t *card = &context->card_data;
+    const uint8_t *aid, *pdol = NULL;
+    uint16_t aid_len = 0, pdol_len = 0;
+    uint8_t has_select = 1;
+    uint8_t i;
+
+    aid = EMV_Resume_FindIn(card->app_select_data, card->app_select_len, 0x6F, 0x84, &aid_len);
+    if (aid != NULL) {
+        pdol = EMV_Resume_Pdol(card, &pdol_len);
+    } else if (context->failed_state == EMV_STATE_APP_SELECTION) {
+        /* Torn between PPSE and the AID SELECT: the re-tap selects the directory entry directly */
+        aid = EMV_Resume_PpseAid(card, &aid_len);
+        has_select = 0;
+    }
+
+    /* Re-tap torn before it got as far as the entry it resumes: keep that one */
+    if (s_entry.valid && s_entry.armed &&
+        (aid == NULL || has_select < s_entry.has_select || card->sfi_record_count < s_entry.record_count)) {
+        s_entry.stamp_ms = now_ms;
+        s_entry.armed = 0;
+        return;
+    }
+    if (aid == NULL || aid_len == 0 || aid_len > EMV_RESUME_MAX_AID || pdol_len > EMV_RESUME_MAX_PDOL) {
+        return;
+    }
+
+    memcpy(s_entry.uid, card->card_uid, sizeof(s_entry.uid));
+    s_entry.uid_len = card->card_uid_len;
+    s_entry.random_uid = EMV_Resume_IsRandomUid(card->card_uid, card->card_uid_len);
+    s_entry.amount = card->amount;
+    s_entry.currency_code = card->currency_code;
+    s_entry.has_select = has_select;
+    if (pdol_len > 0) {
+        memcpy(s_entry.pdol, pdol, pdol_len);
+    }
+    s_entry.pdol_len = (uint8_t)pdol_len;
+    s_entry.has_gpo = has_select ? EMV_Resume_GpoDigest(card, &s_entry.gpo_digest) : 0;
+
+    s_entry.failed_state = context->failed_state;
+    memcpy(s_entry.aid, aid, aid_len);
+    s_entry.aid_len = (uint8_t)aid_len;
+
+    s_entry.record_count = (card->sfi_record_count < EMV_RESUME_MAX_RECORDS) ? card->sfi_record_count
+                                                                             : EMV_RESUME_MAX_RECORDS;
+    s_entry.pan_record = EMV_RESUME_NO_RECORD;
+    for (i = 0; i < s_entry.record_count; i++) {
+        uint16_t l;
+        const uint8_t *r;
+
+        memcpy(s_entry.records[i], card->sfi_records[i], card->sfi_record_lens[i]);
+        s_entry.record_lens[i] = card->sfi_record_lens[i];
+        s_entry.record_sfi[i] = card->sfi_record_sfi[i];
+        s_entry.record_num[i] = card->sfi_record_num[i];
+
+        r = EMV_Resume_FindIn(card->sfi_records[i], card->sfi_record_lens[i], 0x70, 0x5A, &l);
+        if (r == NULL) {
+            r = EMV_Resume_FindIn(card->sfi_records[i], card->sfi_record_lens[i], 0x70, 0x57, &l);
+        }
+        if (r != NULL && s_entry.pan_record == EMV_RESUME_NO_RECORD) {
+            s_entry.pan_record = i;
+        }
+    }
+
+    s_entry.stamp_ms = now_ms;
+    s_entry.armed = 0;
+    s_entry.valid = 1;
+    s_stats.saved++;
+}
+
+uint8_t EMV_Resume_Lookup(const EMV_Complete_Card_Data_t *card, uint32_t now_ms)
+{
+    uint8_t random_uid;
+
+    s_entry.armed = 0;
+    if (!s_entry.valid) {
+        return 0;
+    }
+    if ((uint32_t)(now_ms - s_entry.stamp_ms) > EMV_RESUME_WINDOW_MS) {
+        s_entry.valid = 0;
+        s_stats.expired++;
+        return 0;
+    }
+
+    random_uid = EMV_Resume_IsRandomUid(card->card_uid, card->card_uid_len);
+    if (card->amount != s_entry.amount || card->currency_code != s_entry.currency_code ||
+        random_uid != s_entry.random_uid ||
+        (!random_uid && (card->card_uid_len != s_entry.uid_len ||
+                         memcmp(card->card_uid, s_entry.uid, s_entry.uid_len) != 0)) ||
+        (random_uid && s_entry.record_count > 0 && s_entry.pan_record == EMV_RESUME_NO_RECORD)) {
+        /* Another card or another purchase, a random UID without a record to check is not trusted */
+        EMV_Resume_Drop();
+        return 0;
+    }
+
+    s_entry.armed = 1;
+    return 1;
+}
+
+const uint8_t *EMV_Resume_Aid(uint8_t *aid_len)
+{
+    if (!s_entry.armed) {
+        return NULL;
+    }
+    *aid_len = s_entry.aid_len;
+    return s_entry.aid;
+}
+
+EMV_Payment_State_t EMV_Resume_FailedState(void)
+{
+    return s_entry.valid ? s_entry.failed_state : EMV_STATE_IDLE;
+}
+
+uint8_t EMV_Resume_MatchSelect(const EMV_Complete_Card_Data_t *card)
+{
+    const uint8_t *aid, *pdol;
+    uint16_t aid_len = 0, pdol_len;
+
+    if (!s_entry.armed) {
+        return 0;
+    }
+    aid = EMV_Resume_FindIn(card->app_select_data, card->app_select_len, 0x6F, 0x84, &aid_len);
+    pdol = EMV_Resume_Pdol(card, &pdol_len);
+    if (aid == NULL || aid_len != s_entry.aid_len || memcmp(aid, s_entry.aid, aid_len) != 0 ||
+        (s_entry.has_select && (pdol_len != s_entry.pdol_len ||
+                                (pdol_len > 0 && memcmp(pdol, s_entry.pdol, pdol_len) != 0)))) {
+        EMV_Resume_Drop();
+        return 0;
+    }
+    return 1;
+}
+
+uint8_t EMV_Resume_MatchGpo(const EMV_Complete_Card_Data_t *card)
+{
+    uint32_t digest;
+
+    if (!s_entry.armed) {
+        return 0;
+    }
+    if (!s_entry.has_gpo) {
+        return 1;
+    }
+    if (!EMV_Resume_GpoDigest(card, &digest) || digest != s_entry.gpo_digest) {
+        EMV_Resume_Drop();
+        return 0;
+    }
+    return 1;
+}
+
+uint8_t EMV_Resume_PanRecord(uint8_t *sfi, uint8_t *record, const uint8_t **data, uint16_t *len)
+{
+    uint8_t i = s_entry.pan_record;
+
+    if (!s_entry.armed || !s_entry.random_uid || i == EMV_RESUME_NO_RECORD) {
+        return 0;
+    }
+    *sfi = s_entry.record_sfi[i];
+    *record = s_entry.record_num[i];
+    *data = s_entry.records[i];
+    *len = s_entry.record_lens[i];
+    return 1;
+}
+
+uint8_t EMV_Resume_Restore(EMV_Complete_Card_Data_t *card)
+{
+    uint8_t i;
+
+    if (!s_entry.armed) {
+        return 0;
+    }
+    for (i = 0; i < s_entry.record_count; i++) {
+        memcpy(card->sfi_records[i], s_entry.records[i], s_entry.record_lens[i]);
+        card->sfi_record_lens[i] = s_entry.record_lens[i];
+        card->sfi_record_sfi[i] = s_entry.record_sfi[i];
+        card->sfi_record_num[i] = s_entry.record_num[i];
+    }
+    card->sfi_record_count = s_entry.record_count;
+
+    s_stats.resumed++;
+    s_stats.records_reused += s_entry.record_count;
+    return s_entry.record_count;
+}
+
+uint8_t EMV_Resume_RecordsComplete(void)
+{
+    return (s_entry.armed && s_entry.failed_state > EMV_STATE_READ_APP_DATA) ? 1 : 0;
+}
+
+void EMV_Resume_Drop(void)
+{
+    if (s_entry.valid) {
+        s_stats.mismatched++;
+    }
+    s_entry.valid = 0;
+    s_entry.armed = 0;
+}
+
+void EMV_Resume_Clear(void)
+{
+    s_entry.valid = 0;
+    s_entry.armed = 0;
+}
+
+const EMV_Resume_Stats_t *EMV_Resume_GetStats(void)
+{
+    return &s_stats;
+}
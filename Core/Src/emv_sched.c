@@ -0,0 +1,286 @@
+/*
+ * emv_sched.c
+ *
+ * Cooperative background tasks for the EMV flow
+ * Runs registered tasks while an APDU is in flight on the RF interface
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "emv_sched.h"
+#include "phpalI14443p4.h"
+#include "phNfcLib.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+
+/* UART shared with the Linux host */
+extern UART_HandleTypeDef huart1;
+
+static uint32_t EMV_Uplink_Lock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    return primask;
+}
+
+static void EMV_Uplink_Unlock(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
+
+static int EMV_Uplink_TxEmpty(void)
+{
+    return __HAL_UART_GET_FLAG(&huart1, UART_FLAG_TXE) ? 1 : 0;
+}
+
+static void EMV_Uplink_TxByte(uint8_t b)
+{
+    huart1.Instance->TDR = b;
+}
+
+static int EMV_Uplink_TxDone(void)
+{
+    return __HAL_UART_GET_FLAG(&huart1, UART_FLAG_TC) ? 1 : 0;
+}
+
+#else /* Host stand-in, the bench models the UART */
+
+extern int EMV_Uplink_HostTxEmpty(void);
+extern void EMV_Uplink_HostTxByte(uint8_t b);
+extern int EMV_Uplink_HostTxDone(void);
+
+static uint32_t EMV_Uplink_Lock(void)
+{
+    return 0;
+}
+
+static void EMV_Uplink_Unlock(uint32_t primask)
+{
+    (void)primask;
+}
+
+static int EMV_Uplink_TxEmpty(void)
+{
+    return EMV_Uplink_HostTxEmpty();
+}
+
+static void EMV_Uplink_TxByte(uint8_t b)
+{
+    EMV_Uplink_HostTxByte(b);
+}
+
+static int EMV_Uplink_TxDone(void)
+{
+    return EMV_Uplink_HostTxDone();
+}
+
+#endif /* STM32L431xx */
+
+typedef struct {
+    EMV_Sched_TaskFn_t fn;
+    void *ctx;
+} EMV_Sched_Task_t;
+
+static EMV_Sched_Task_t s_tasks[EMV_SCHED_MAX_TASKS];
+static uint8_t s_apdu_rx[EMV_SCHED_APDU_RX_MAX];
+
+/* Uplink ring buffer, drained one TXE at a time by the uplink task.
+ * Frames and debug text are written under the lock (printf may run in an ISR), only the task moves the tail. */
+static uint8_t s_uplink_buf[EMV_UPLINK_BUF_SIZE];
+static volatile uint16_t s_uplink_head;
+static volatile uint16_t s_uplink_tail;
+static volatile uint8_t s_uplink_active;
+static uint32_t s_uplink_dropped;
+
+/* ================== Scheduler ================== */
+
+int EMV_Sched_RegisterTask(EMV_Sched_TaskFn_t fn, void *ctx)
+{
+    for (int i = 0; i < EMV_SCHED_MAX_TASKS; i++) {
+        if (s_tasks[i].fn == NULL) {
+            s_tasks[i].fn = fn;
+            s_tasks[i].ctx = ctx;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void EMV_Sched_UnregisterTask(EMV_Sched_TaskFn_t fn, void *ctx)
+{
+    for (int i = 0; i < EMV_SCHED_MAX_TASKS; i++) {
+        if (s_tasks[i].fn == fn && s_tasks[i].ctx == ctx) {
+            s_tasks[i].fn = NULL;
+            s_tasks[i].ctx = NULL;
+        }
+    }
+}
+
+void EMV_Sched_RunOnce(void)
+{
+    for (int i = 0; i < EMV_SCHED_MAX_TASKS; i++) {
+        if (s_tasks[i].fn != NULL) {
+            s_tasks[i].fn(s_tasks[i].ctx);
+        }
+    }
+}
+
+phStatus_t EMV_Sched_ExchangeApdu(uint8_t *apdu, uint16_t apdu_len,
+                                  uint8_t **rx_buffer, uint16_t *rx_len)
+{
+    void *pal = phNfcLib_GetDataParams(PH_COMP_PAL_ISO14443P4);
+    phStatus_t status;
+    uint8_t *chunk;
+    uint16_t chunk_len = 0;
+    uint16_t total = 0;
+
+    *rx_len = 0;
+
+    status = phpalI14443p4_ExchangeSubmit(pal, apdu, apdu_len);
+    if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+        return status;
+    }
+
+    /* Card is working on the command (FWT / WTX), let the other tasks run */
+    do {
+        EMV_Sched_RunOnce();
+        status = phpalI14443p4_ExchangePoll(pal, &chunk, &chunk_len);
+    } while ((status & PH_ERR_MASK) == PH_ERR_SUCCESS_PENDING);
+
+    if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+        *rx_buffer = chunk;
+        *rx_len = chunk_len;
+        return status;
+    }
+
+    /* Chained response: the next blocks are short, fetch them with the blocking exchange */
+    while ((status & PH_ERR_MASK) == PH_ERR_SUCCESS_CHAINING) {
+        if ((uint32_t)total + chunk_len > sizeof(s_apdu_rx)) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_BUFFER_OVERFLOW, PH_COMP_PAL_ISO14443P4);
+        }
+        memcpy(&s_apdu_rx[total], chunk, chunk_len);
+        total += chunk_len;
+
+        status = phpalI14443p4_Exchange(pal, PH_EXCHANGE_RXCHAINING, NULL, 0, &chunk, &chunk_len);
+        if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+            if ((uint32_t)total + chunk_len > sizeof(s_apdu_rx)) {
+                return PH_ADD_COMPCODE_FIXED(PH_ERR_BUFFER_OVERFLOW, PH_COMP_PAL_ISO14443P4);
+            }
+            memcpy(&s_apdu_rx[total], chunk, chunk_len);
+            total += chunk_len;
+
+            *rx_buffer = s_apdu_rx;
+            *rx_len = total;
+        }
+    }
+
+    return status;
+}
+
+/* ================== UART Uplink ================== */
+
+static void EMV_Uplink_Task(void *ctx)
+{
+    (void)ctx;
+
+    /* Only feed the data register, never wait for the UART */
+    while (s_uplink_tail != s_uplink_head && EMV_Uplink_TxEmpty()) {
+        EMV_Uplink_TxByte(s_uplink_buf[s_uplink_tail]);
+        s_uplink_tail = (s_uplink_tail + 1) % EMV_UPLINK_BUF_SIZE;
+    }
+}
+
+/* All or nothing, a frame is never split by a full ring or by debug text */
+static uint16_t EMV_Uplink_Put(const uint8_t *data, uint16_t len)
+{
+    uint32_t primask = EMV_Uplink_Lock();
+    uint16_t head = s_uplink_head;
+    uint16_t used = (uint16_t)((head + EMV_UPLINK_BUF_SIZE - s_uplink_tail) % EMV_UPLINK_BUF_SIZE);
+
+    if (!s_uplink_active || len > EMV_UPLINK_BUF_SIZE - 1 - used) {
+        EMV_Uplink_Unlock(primask);
+        return 0;
+    }
+    for (uint16_t i = 0; i < len; i++) {
+        s_uplink_buf[head] = data[i];
+        head = (head + 1) % EMV_UPLINK_BUF_SIZE;
+    }
+    s_uplink_head = head;
+    EMV_Uplink_Unlock(primask);
+    return len;
+}
+
+void EMV_Uplink_Start(void)
+{
+    if (s_uplink_active) {
+        return;
+    }
+    s_uplink_head = 0;
+    s_uplink_tail = 0;
+    if (EMV_Sched_RegisterTask(EMV_Uplink_Task, NULL) == 0) {
+        s_uplink_active = 1;
+    }
+}
+
+uint16_t EMV_Uplink_Queue(const uint8_t *data, uint16_t len)
+{
+    if (!s_uplink_active || len == 0) {
+        return 0;
+    }
+    if (EMV_Uplink_Put(data, len) == 0) {
+        s_uplink_dropped++;
+        return 0;
+    }
+    return len;
+}
+
+int EMV_Uplink_PutChar(uint8_t ch)
+{
+    if (!s_uplink_active) {
+        return 0;
+    }
+    /* Debug text is dropped silently while the ring is full */
+    (void)EMV_Uplink_Put(&ch, 1);
+    return 1;
+}
+
+uint32_t EMV_Uplink_Dropped(void)
+{
+    return s_uplink_dropped;
+}
+
+void EMV_Uplink_Drain(void)
+{
+    while (s_uplink_active && s_uplink_tail != s_uplink_head) {
+        EMV_Uplink_Task(NULL);
+    }
+}
+
+void EMV_Uplink_Flush(void)
+{
+    uint32_t primask;
+
+    if (!s_uplink_active) {
+        return;
+    }
+
+    /* printf from an ISR may add text until the uplink is marked inactive */
+    for (;;) {
+        EMV_Uplink_Drain();
+        primask = EMV_Uplink_Lock();
+        if (s_uplink_tail == s_uplink_head) {
+            s_uplink_active = 0;
+            EMV_Uplink_Unlock(primask);
+            break;
+        }
+        EMV_Uplink_Unlock(primask);
+    }
+    while (!EMV_Uplink_TxDone()) {
+    }
+
+    EMV_Sched_UnregisterTask(EMV_Uplink_Task, NULL);
+}
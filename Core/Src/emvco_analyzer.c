@@ -0,0 +1,277 @@
+/*
+ * emvco_analyzer.c
+ *
+ * EMVCo loopback analyzer
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "emvco_analyzer.h"
+#include "phApp_Init.h"
+#include <phpalI14443p4.h>
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+extern UART_HandleTypeDef huart1;
+
+static uint32_t EmvcoAnalyzer_Cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+static uint32_t EmvcoAnalyzer_Hz(void)
+{
+    return SystemCoreClock;
+}
+
+static uint32_t EmvcoAnalyzer_Ms(void)
+{
+    return HAL_GetTick();
+}
+
+static void EmvcoAnalyzer_Send(const uint8_t *frame, uint16_t len)
+{
+    /* Blocking, 112 bytes at 115200 Bd take 10 ms: sent between exchanges, never inside a timed one */
+    if (HAL_UART_Transmit(&huart1, (uint8_t *)frame, len, 100) != HAL_OK) {
+        DEBUG_PRINTF("Analyzer summary not sent\r\n");
+    }
+}
+
+#else /* Host stand-in, the bench drives the clocks and collects the frames */
+
+extern uint32_t EmvcoAnalyzer_HostCycles(void);
+extern uint32_t EmvcoAnalyzer_HostHz(void);
+extern uint32_t EmvcoAnalyzer_HostMs(void);
+extern void EmvcoAnalyzer_HostSend(const uint8_t *frame, uint16_t len);
+
+static uint32_t EmvcoAnalyzer_Cycles(void)
+{
+    return EmvcoAnalyzer_HostCycles();
+}
+
+static uint32_t EmvcoAnalyzer_Hz(void)
+{
+    return EmvcoAnalyzer_HostHz();
+}
+
+static uint32_t EmvcoAnalyzer_Ms(void)
+{
+    return EmvcoAnalyzer_HostMs();
+}
+
+static void EmvcoAnalyzer_Send(const uint8_t *frame, uint16_t len)
+{
+    EmvcoAnalyzer_HostSend(frame, len);
+}
+
+#endif /* STM32L431xx */
+
+static EmvcoAnalyzer_Window_t s_win;
+static void *s_pal;
+static uint32_t s_begin_cyc;
+static uint32_t s_window_ms;                /* Start of the current window */
+static uint16_t s_seq;
+static uint8_t s_frame[EMVCO_ANALYZER_FRAME_LEN];
+
+/* ================== Helpers ================== */
+
+static void EmvcoAnalyzer_Reset(uint32_t now_ms)
+{
+    memset(&s_win, 0, sizeof(s_win));
+    s_win.rtt_min_us = 0xFFFFFFFFUL;
+    s_window_ms = now_ms;
+}
+
+static void EmvcoAnalyzer_Bump(uint16_t *bin)
+{
+    if (*bin != 0xFFFFU) {
+        (*bin)++;
+    }
+}
+
+static uint8_t EmvcoAnalyzer_RttBin(uint32_t us)
+{
+    uint8_t bin = 0;
+
+    us >>= (EMVCO_ANALYZER_RTT_MIN_LOG2 - 1U);
+    while (us > 1U && bin < EMVCO_ANALYZER_RTT_BINS - 1U) {
+        us >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+static uint8_t EmvcoAnalyzer_EventBin(uint16_t n)
+{
+    return (n < EMVCO_ANALYZER_EVENT_BINS - 1U) ? (uint8_t)n : (uint8_t)(EMVCO_ANALYZER_EVENT_BINS - 1U);
+}
+
+/* Statistics of phpalI14443p4_Sw since the last call, cleared for the next exchange */
+static uint16_t EmvcoAnalyzer_PalTake(uint16_t wConfig)
+{
+    uint16_t value = 0;
+
+    if (s_pal == NULL || phpalI14443p4_GetConfig(s_pal, wConfig, &value) != PH_ERR_SUCCESS) {
+        return 0;
+    }
+    (void)phpalI14443p4_SetConfig(s_pal, wConfig, 0);
+    return value;
+}
+
+static uint16_t EmvcoAnalyzer_Put32(uint8_t *p, uint16_t pos, uint32_t v)
+{
+    p[pos++] = (uint8_t)(v >> 24);
+    p[pos++] = (uint8_t)(v >> 16);
+    p[pos++] = (uint8_t)(v >> 8);
+    p[pos++] = (uint8_t)v;
+    return pos;
+}
+
+static uint16_t EmvcoAnalyzer_Put16(uint8_t *p, uint16_t pos, uint32_t v)
+{
+    if (v > 0xFFFFU) {
+        v = 0xFFFFU;
+    }
+    p[pos++] = (uint8_t)(v >> 8);
+    p[pos++] = (uint8_t)v;
+    return pos;
+}
+
+/* ================== Interface ================== */
+
+void EmvcoAnalyzer_Init(void *pPalDataParams)
+{
+#if defined(STM32L431xx)
+    /* Normally on since BootProf_Start, CYCCNT is not reset here */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    s_pal = pPalDataParams;
+    s_seq = 0;
+    EmvcoAnalyzer_Reset(EmvcoAnalyzer_Ms());
+    (void)EmvcoAnalyzer_PalTake(PHPAL_I14443P4_CONFIG_STAT_WTX);
+    (void)EmvcoAnalyzer_PalTake(PHPAL_I14443P4_CONFIG_STAT_NAK);
+    (void)EmvcoAnalyzer_PalTake(PHPAL_I14443P4_CONFIG_STAT_RETRANSMIT);
+}
+
+void EmvcoAnalyzer_Begin(void)
+{
+    s_begin_cyc = EmvcoAnalyzer_Cycles();
+}
+
+void EmvcoAnalyzer_End(phStatus_t status, uint16_t tx_len, uint16_t rx_len)
+{
+    uint32_t mhz = EmvcoAnalyzer_Hz() / 1000000U;
+    uint32_t us = EmvcoAnalyzer_Cycles() - s_begin_cyc;
+    uint16_t wtx, nak, retransmit;
+
+    /* Read right after the exchange, the GetConfig / SetConfig calls stay out of the RTT */
+    us /= (mhz != 0U) ? mhz : 1U;
+    wtx = EmvcoAnalyzer_PalTake(PHPAL_I14443P4_CONFIG_STAT_WTX);
+    nak = EmvcoAnalyzer_PalTake(PHPAL_I14443P4_CONFIG_STAT_NAK);
+    retransmit = EmvcoAnalyzer_PalTake(PHPAL_I14443P4_CONFIG_STAT_RETRANSMIT);
+
+    s_win.exchanges++;
+    if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+        s_win.errors++;
+        rx_len = 0;
+    }
+    s_win.tx_bytes += tx_len;
+    s_win.rx_bytes += rx_len;
+    s_win.wtx += wtx;
+    s_win.naks += nak;
+    s_win.retransmits += retransmit;
+
+    if (us < s_win.rtt_min_us) {
+        s_win.rtt_min_us = us;
+    }
+    if (us > s_win.rtt_max_us) {
+        s_win.rtt_max_us = us;
+    }
+    s_win.rtt_sum_us += us;
+    EmvcoAnalyzer_Bump(&s_win.rtt_hist[EmvcoAnalyzer_RttBin(us)]);
+    EmvcoAnalyzer_Bump(&s_win.wtx_hist[EmvcoAnalyzer_EventBin(wtx)]);
+    EmvcoAnalyzer_Bump(&s_win.retry_hist[EmvcoAnalyzer_EventBin((uint16_t)(nak + retransmit))]);
+
+    EmvcoAnalyzer_Poll();
+}
+
+void EmvcoAnalyzer_Loopback(void)
+{
+    s_win.loopbacks++;
+}
+
+void EmvcoAnalyzer_RfReset(void)
+{
+    s_win.rf_resets++;
+}
+
+void EmvcoAnalyzer_Poll(void)
+{
+    uint32_t now = EmvcoAnalyzer_Ms();
+    uint16_t len;
+
+    if ((uint32_t)(now - s_window_ms) < EMVCO_ANALYZER_REPORT_MS) {
+        return;
+    }
+    len = EmvcoAnalyzer_BuildSummary(s_frame, (uint16_t)sizeof(s_frame));
+    EmvcoAnalyzer_Send(s_frame, len);
+    s_seq++;
+    /* The next window starts after the UART, its time is not part of any exchange */
+    EmvcoAnalyzer_Reset(EmvcoAnalyzer_Ms());
+}
+
+const EmvcoAnalyzer_Window_t *EmvcoAnalyzer_Window(void)
+{
+    return &s_win;
+}
+
+uint16_t EmvcoAnalyzer_BuildSummary(uint8_t *frame, uint16_t frame_size)
+{
+    uint16_t pos = 0;
+    uint8_t i;
+
+    if (frame_size < EMVCO_ANALYZER_FRAME_LEN) {
+        return 0;
+    }
+    frame[pos++] = 0xAA;
+    frame[pos++] = 0x55;
+    frame[pos++] = EMVCO_ANALYZER_LINUX_CMD_SUMMARY;
+    pos = EmvcoAnalyzer_Put16(frame, pos, EMVCO_ANALYZER_SUMMARY_LEN);
+    frame[pos++] = EMVCO_ANALYZER_VERSION;
+    pos = EmvcoAnalyzer_Put16(frame, pos, s_seq);
+    pos = EmvcoAnalyzer_Put32(frame, pos, EmvcoAnalyzer_Ms() - s_window_ms);
+    pos = EmvcoAnalyzer_Put32(frame, pos, s_win.exchanges);
+    pos = EmvcoAnalyzer_Put32(frame, pos, s_win.errors);
+    pos = EmvcoAnalyzer_Put16(frame, pos, s_win.rf_resets);
+    pos = EmvcoAnalyzer_Put16(frame, pos, s_win.loopbacks);
+    pos = EmvcoAnalyzer_Put32(frame, pos, s_win.wtx);
+    pos = EmvcoAnalyzer_Put32(frame, pos, s_win.naks);
+    pos = EmvcoAnalyzer_Put32(frame, pos, s_win.retransmits);
+    pos = EmvcoAnalyzer_Put32(frame, pos, s_win.tx_bytes);
+    pos = EmvcoAnalyzer_Put32(frame, pos, s_win.rx_bytes);
+    pos = EmvcoAnalyzer_Put32(frame, pos, s_win.rtt_min_us);
+    pos = EmvcoAnalyzer_Put32(frame, pos, s_win.rtt_max_us);
+    pos = EmvcoAnalyzer_Put32(frame, pos, s_win.rtt_sum_us);
+    frame[pos++] = EMVCO_ANALYZER_RTT_BINS;
+    for (i = 0; i < EMVCO_ANALYZER_RTT_BINS; i++) {
+        pos = EmvcoAnalyzer_Put16(frame, pos, s_win.rtt_hist[i]);
+    }
+    frame[pos++] = EMVCO_ANALYZER_EVENT_BINS;
+    for (i = 0; i < EMVCO_ANALYZER_EVENT_BINS; i++) {
+        pos = EmvcoAnalyzer_Put16(frame, pos, s_win.wtx_hist[i]);
+    }
+    for (i = 0; i < EMVCO_ANALYZER_EVENT_BINS; i++) {
+        pos = EmvcoAnalyzer_Put16(frame, pos, s_win.retry_hist[i]);
+    }
+    frame[pos++] = 0x0D;
+    frame[pos++] = 0x0A;
+    return pos;
+}
+
+uint16_t EmvcoAnalyzer_Sequence(void)
+{
+    return s_seq;
+}
@@ -0,0 +1,253 @@
+/*
+ * feedback.c
+ *
+ * Buzzer / LED feedback scheduler
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "feedback.h"
+#include <stddef.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+#include "tim.h"
+
+static uint8_t s_buzzer_on;
+
+static uint32_t Feedback_Lock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    return primask;
+}
+
+static void Feedback_Unlock(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
+
+static void Feedback_Outputs(uint8_t outputs)
+{
+    /* Start/Stop only on a change, the HAL refuses to start a running channel */
+    if ((outputs & FEEDBACK_OUT_BUZZER) && !s_buzzer_on) {
+        (void)HAL_TIM_PWM_Start(&htim1, TIM_CHANNEL_4);
+        s_buzzer_on = 1;
+    } else if (!(outputs & FEEDBACK_OUT_BUZZER) && s_buzzer_on) {
+        (void)HAL_TIM_PWM_Stop(&htim1, TIM_CHANNEL_4);
+        s_buzzer_on = 0;
+    }
+#if defined(FEEDBACK_LED_Pin)
+    HAL_GPIO_WritePin(FEEDBACK_LED_GPIO_Port, FEEDBACK_LED_Pin, (outputs & FEEDBACK_OUT_LED) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+#endif
+}
+
+static void Feedback_Arm(uint16_t ms)
+{
+    /* One-pulse: the counter stops by itself at the update event */
+    TIM7->CR1 &= ~TIM_CR1_CEN;
+    TIM7->CNT = 0;
+    TIM7->ARR = (uint32_t)ms * (FEEDBACK_TICK_HZ / 1000U) - 1U;
+    TIM7->SR = 0;
+    TIM7->CR1 |= TIM_CR1_CEN;
+}
+
+static void Feedback_Disarm(void)
+{
+    TIM7->CR1 &= ~TIM_CR1_CEN;
+    TIM7->SR = 0;
+    NVIC_ClearPendingIRQ(TIM7_IRQn);
+}
+
+static void Feedback_PortInit(void)
+{
+    __HAL_RCC_TIM7_CLK_ENABLE();
+    /* URS: the UG below loads the prescaler without raising an interrupt */
+    TIM7->CR1 = TIM_CR1_OPM | TIM_CR1_URS;
+    TIM7->PSC = SystemCoreClock / FEEDBACK_TICK_HZ - 1U;
+    TIM7->ARR = 0xFFFFU;
+    TIM7->EGR = TIM_EGR_UG;
+    TIM7->SR = 0;
+    TIM7->DIER = TIM_DIER_UIE;
+    HAL_NVIC_SetPriority(TIM7_IRQn, FEEDBACK_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(TIM7_IRQn);
+}
+
+#else /* Host stand-in, the bench provides the outputs and a mock one-shot timer */
+
+extern void Feedback_HostOutputs(uint8_t outputs);
+extern void Feedback_HostArm(uint16_t ms);
+extern void Feedback_HostDisarm(void);
+
+static uint32_t Feedback_Lock(void)
+{
+    return 0;
+}
+
+static void Feedback_Unlock(uint32_t primask)
+{
+    (void)primask;
+}
+
+static void Feedback_Outputs(uint8_t outputs)
+{
+    Feedback_HostOutputs(outputs);
+}
+
+static void Feedback_Arm(uint16_t ms)
+{
+    Feedback_HostArm(ms);
+}
+
+static void Feedback_Disarm(void)
+{
+    Feedback_HostDisarm();
+}
+
+static void Feedback_PortInit(void)
+{
+}
+
+#endif /* STM32L431xx */
+
+/* ================== Patterns ================== */
+
+typedef struct {
+    const Feedback_Step_t *steps;
+    uint8_t count;
+    uint8_t repeat;                         /* Start over after the last step */
+} Feedback_PatternDef_t;
+
+static const Feedback_Step_t s_boot[] = {
+    { FEEDBACK_OUT_ON, 300 }
+};
+static const Feedback_Step_t s_success[] = {
+    { FEEDBACK_OUT_ON, 200 }, { FEEDBACK_OUT_OFF, 200 }, { FEEDBACK_OUT_ON, 200 }
+};
+static const Feedback_Step_t s_failure[] = {
+    { FEEDBACK_OUT_ON, 100 }, { FEEDBACK_OUT_OFF, 100 }, { FEEDBACK_OUT_ON, 100 }, { FEEDBACK_OUT_OFF, 100 },
+    { FEEDBACK_OUT_ON, 100 }
+};
+static const Feedback_Step_t s_too_slow[] = {
+    { FEEDBACK_OUT_ON, 60 }, { FEEDBACK_OUT_OFF, 60 }, { FEEDBACK_OUT_ON, 60 }, { FEEDBACK_OUT_OFF, 60 },
+    { FEEDBACK_OUT_ON, 400 }
+};
+static const Feedback_Step_t s_remove_card[] = {
+    { FEEDBACK_OUT_ON, 80 }, { FEEDBACK_OUT_OFF, 920 }
+};
+
+#define FEEDBACK_DEF(steps, repeat)     { steps, (uint8_t)(sizeof(steps) / sizeof(steps[0])), repeat }
+
+static const Feedback_PatternDef_t s_patterns[FEEDBACK_COUNT] = {
+    { NULL, 0, 0 },
+    FEEDBACK_DEF(s_boot, 0),
+    FEEDBACK_DEF(s_success, 0),
+    FEEDBACK_DEF(s_failure, 0),
+    FEEDBACK_DEF(s_too_slow, 0),
+    FEEDBACK_DEF(s_remove_card, 1)
+};
+
+/* ================== Scheduler ================== */
+
+static const Feedback_PatternDef_t *s_def;
+static uint8_t s_index;
+static volatile Feedback_Pattern_t s_current = FEEDBACK_NONE;
+static Feedback_Stats_t s_stats;
+
+static void Feedback_Apply(const Feedback_Step_t *step)
+{
+    uint16_t ms = step->ms;
+
+    if (ms == 0U) {
+        ms = 1U;
+    } else if (ms > FEEDBACK_STEP_MAX_MS) {
+        ms = FEEDBACK_STEP_MAX_MS;
+    }
+    Feedback_Outputs(step->outputs);
+    Feedback_Arm(ms);
+}
+
+void Feedback_Init(void)
+{
+    Feedback_PortInit();
+    Feedback_Disarm();
+    Feedback_Outputs(FEEDBACK_OUT_OFF);
+    s_current = FEEDBACK_NONE;
+    s_def = NULL;
+    s_stats.plays = 0;
+    s_stats.preempted = 0;
+    s_stats.completed = 0;
+    s_stats.edges = 0;
+}
+
+void Feedback_Play(Feedback_Pattern_t pattern)
+{
+    uint32_t primask = Feedback_Lock();
+
+    /* Timer stopped and its pending interrupt dropped, the old pattern cannot take another edge */
+    Feedback_Disarm();
+    if (s_current != FEEDBACK_NONE) {
+        s_stats.preempted++;
+    }
+    if ((uint32_t)pattern == (uint32_t)FEEDBACK_NONE || (uint32_t)pattern >= (uint32_t)FEEDBACK_COUNT) {
+        Feedback_Outputs(FEEDBACK_OUT_OFF);
+        s_current = FEEDBACK_NONE;
+        Feedback_Unlock(primask);
+        return;
+    }
+
+    s_def = &s_patterns[pattern];
+    s_index = 0;
+    s_current = pattern;
+    s_stats.plays++;
+    Feedback_Apply(&s_def->steps[0]);
+    Feedback_Unlock(primask);
+}
+
+void Feedback_Stop(void)
+{
+    Feedback_Play(FEEDBACK_NONE);
+}
+
+Feedback_Pattern_t Feedback_Current(void)
+{
+    return s_current;
+}
+
+uint32_t Feedback_PatternMs(Feedback_Pattern_t pattern)
+{
+    uint32_t ms = 0;
+
+    if ((uint32_t)pattern < (uint32_t)FEEDBACK_COUNT) {
+        for (uint8_t i = 0; i < s_patterns[pattern].count; i++) {
+            ms += s_patterns[pattern].steps[i].ms;
+        }
+    }
+    return ms;
+}
+
+const Feedback_Stats_t *Feedback_GetStats(void)
+{
+    return &s_stats;
+}
+
+void Feedback_OnTimer(void)
+{
+    if (s_current == FEEDBACK_NONE) {
+        return;
+    }
+    s_stats.edges++;
+
+    if (++s_index >= s_def->count) {
+        if (!s_def->repeat) {
+            Feedback_Outputs(FEEDBACK_OUT_OFF);
+            s_current = FEEDBACK_NONE;
+            s_stats.completed++;
+            return;
+        }
+        s_index = 0;
+    }
+    Feedback_Apply(&s_def->steps[s_index]);
+}
@@ -0,0 +1,267 @@
+/*
+ * felica_batch.c
+ *
+ * FeliCa batch engine
+ * Block list elements use the 2-byte form (block < 256) and the 3-byte form
+ * otherwise, services are deduplicated into the service code list, and a
+ * command is closed when the card limit, 16 services or the frame size is hit
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "felica_batch.h"
+#include "phhalHw.h"
+#include "phApp_Init.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+
+static uint32_t FelicaBatch_Tick(void)
+{
+    return HAL_GetTick();
+}
+
+#else /* Host stand-in, the bench drives the millisecond tick */
+
+extern uint32_t FelicaBatch_HostTick(void);
+
+static uint32_t FelicaBatch_Tick(void)
+{
+    return FelicaBatch_HostTick();
+}
+
+#endif /* STM32L431xx */
+
+#define FELICA_IC_TYPE_POS          9U      /* PMm[1] */
+#define FELICA_IC_LITE              0xF0U
+#define FELICA_IC_LITE_S            0xF1U
+#define FELICA_IC_LINK              0xF2U
+#define FELICA_SF2_NUM_BLOCKS       0xA2U   /* Status flag 2: illegal number of blocks */
+
+/* LEN + code + IDm + number of services / blocks, and the largest block count a frame can carry */
+#define FELICA_CMD_OVERHEAD         12U
+#define FELICA_READ_RSP_OVERHEAD    13U
+#define FELICA_MAX_BLOCKS_FRAME     ((FELICA_BATCH_MAX_FRAME - FELICA_READ_RSP_OVERHEAD) / FELICA_BATCH_BLOCK_SIZE)
+
+/* ================== Polling ================== */
+
+static uint8_t FelicaBatch_AddCard(FelicaBatch_Card_t *cards, uint8_t *pCount, const uint8_t *idm_pmm, uint8_t rate)
+{
+    for (uint8_t i = 0; i < *pCount; i++) {
+        if (memcmp(cards[i].idm_pmm, idm_pmm, 8) == 0) {
+            return 0;
+        }
+    }
+    if (*pCount >= FELICA_BATCH_MAX_CARDS) {
+        return 0;
+    }
+    memcpy(cards[*pCount].idm_pmm, idm_pmm, sizeof(cards[*pCount].idm_pmm));
+    cards[*pCount].rate = rate;
+    (*pCount)++;
+    return 1;
+}
+
+phStatus_t FelicaBatch_Poll(phpalFelica_Sw_DataParams_t *pPal, const uint8_t system_code[2],
+                            FelicaBatch_Card_t cards[FELICA_BATCH_MAX_CARDS], uint8_t *pCount)
+{
+    static const uint16_t s_cardtype[2] = { PHHAL_HW_CARDTYPE_FELICA_424, PHHAL_HW_CARDTYPE_FELICA_212 };
+    static const uint8_t s_rate[2] = { FELICA_BATCH_RATE_424, FELICA_BATCH_RATE_212 };
+    phStatus_t status;
+    uint8_t sc[2];
+    uint8_t *rx;
+    uint16_t rx_len;
+    uint8_t *id;
+    uint8_t id_len;
+    uint16_t frame_status;
+
+    *pCount = 0;
+    sc[0] = system_code[0];
+    sc[1] = system_code[1];
+
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_FieldOn(pPal->pHalDataParams));
+
+    for (uint8_t r = 0; r < 2U && *pCount < FELICA_BATCH_MAX_CARDS; r++) {
+        uint8_t slots = PHPAL_FELICA_NUMSLOTS_4;
+
+        PH_CHECK_SUCCESS_FCT(status, phhalHw_ApplyProtocolSettings(pPal->pHalDataParams, s_cardtype[r]));
+        if (r == 0U) {
+            PH_CHECK_SUCCESS_FCT(status, phhalHw_Wait(pPal->pHalDataParams, PHHAL_HW_TIME_MICROSECONDS,
+                                                      FELICA_BATCH_GUARD_TIME_US));
+        }
+
+        for (uint8_t round = 0; round < FELICA_BATCH_POLL_ROUNDS && *pCount < FELICA_BATCH_MAX_CARDS; round++) {
+            uint8_t added = 0;
+            uint8_t collided = 0;
+
+            status = phpalFelica_ReqC(pPal, sc, slots, &rx, &rx_len);
+            if ((status & PH_ERR_MASK) == PH_ERR_IO_TIMEOUT) {
+                break;
+            }
+            if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+                /* Garbled slot data of overlapping replies, poll again with more slots */
+                collided = 1;
+            } else {
+                for (uint8_t f = 1; f <= pPal->bTotalFrames; f++) {
+                    if ((phpalFelica_GetFrameInfo(pPal, f, rx, &frame_status, &id, &id_len) & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+                        collided = 1;
+                    } else if (frame_status == PH_ERR_SUCCESS && id_len >= 16U) {
+                        added = (uint8_t)(added + FelicaBatch_AddCard(cards, pCount, id, s_rate[r]));
+                    } else if (frame_status != PH_ERR_SUCCESS) {
+                        collided = 1;
+                    }
+                }
+            }
+
+            /* Cards pick a new random slot every ReqC, stop once a round brings nothing new */
+            if (collided && slots < PHPAL_FELICA_NUMSLOTS_16) {
+                slots = (uint8_t)((slots << 1) | 1U);
+            } else if (!added && !collided) {
+                break;
+            }
+        }
+    }
+
+    DEBUG_PRINTF("FeliCa poll: %d card(s)\r\n", *pCount);
+    return (*pCount != 0U) ? PH_ERR_SUCCESS : PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_GENERIC);
+}
+
+phStatus_t FelicaBatch_SelectCard(phpalFelica_Sw_DataParams_t *pPal, const FelicaBatch_Card_t *card)
+{
+    phStatus_t status;
+
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_ApplyProtocolSettings(pPal->pHalDataParams,
+        (card->rate == FELICA_BATCH_RATE_424) ? PHHAL_HW_CARDTYPE_FELICA_424 : PHHAL_HW_CARDTYPE_FELICA_212));
+    return phpalFelica_SetSerialNo(pPal, (uint8_t *)card->idm_pmm);
+}
+
+/* ================== Read / Write ================== */
+
+/* Blocks per command from the IC type in PMm */
+static uint8_t FelicaBatch_CardLimit(phalFelica_Sw_DataParams_t *pAl, uint8_t write)
+{
+    uint8_t ic = ((phpalFelica_Sw_DataParams_t *)pAl->pPalFelicaDataParams)->aIDmPMm[FELICA_IC_TYPE_POS];
+
+    if (ic == FELICA_IC_LITE || ic == FELICA_IC_LITE_S || ic == FELICA_IC_LINK) {
+        return write ? 1U : 4U;
+    }
+    return write ? FELICA_BATCH_DEFAULT_WRITE_BLOCKS : FELICA_BATCH_DEFAULT_READ_BLOCKS;
+}
+
+/* Pack items into one command, returns the number of items taken */
+static uint8_t FelicaBatch_Pack(const FelicaBatch_Item_t *items, uint16_t count, uint8_t max_blocks, uint8_t write,
+                                uint8_t *svc, uint8_t *pSvcCount, uint8_t *blk, uint8_t *pBlkLen)
+{
+    uint8_t n = 0;
+    uint8_t idx;
+    uint16_t tx_len;
+
+    *pSvcCount = 0;
+    *pBlkLen = 0;
+
+    while (n < count && n < max_blocks && n < FELICA_MAX_BLOCKS_FRAME) {
+        const FelicaBatch_Item_t *item = &items[n];
+        uint8_t new_svc;
+        uint8_t elem_len = (item->block < 256U) ? 2U : 3U;
+
+        for (idx = 0; idx < *pSvcCount; idx++) {
+            if (svc[idx * 2U] == (uint8_t)item->service && svc[idx * 2U + 1U] == (uint8_t)(item->service >> 8)) {
+                break;
+            }
+        }
+        new_svc = (idx == *pSvcCount) ? 1U : 0U;
+        if (new_svc && *pSvcCount >= FELICA_BATCH_MAX_SERVICES) {
+            break;
+        }
+
+        tx_len = (uint16_t)(FELICA_CMD_OVERHEAD + (*pSvcCount + new_svc) * 2U + *pBlkLen + elem_len);
+        if (write) {
+            tx_len = (uint16_t)(tx_len + (n + 1U) * FELICA_BATCH_BLOCK_SIZE);
+        }
+        if (tx_len > FELICA_BATCH_MAX_FRAME) {
+            break;
+        }
+
+        if (new_svc) {
+            svc[idx * 2U] = (uint8_t)item->service;
+            svc[idx * 2U + 1U] = (uint8_t)(item->service >> 8);
+            (*pSvcCount)++;
+        }
+        if (elem_len == 2U) {
+            blk[(*pBlkLen)++] = (uint8_t)(0x80U | idx);
+            blk[(*pBlkLen)++] = (uint8_t)item->block;
+        } else {
+            blk[(*pBlkLen)++] = idx;
+            blk[(*pBlkLen)++] = (uint8_t)item->block;
+            blk[(*pBlkLen)++] = (uint8_t)(item->block >> 8);
+        }
+        n++;
+    }
+    return n;
+}
+
+static phStatus_t FelicaBatch_Transfer(phalFelica_Sw_DataParams_t *pAl, const FelicaBatch_Item_t *items, uint16_t count,
+                                       uint8_t *data, uint8_t write, FelicaBatch_Stats_t *stats)
+{
+    phStatus_t status = PH_ERR_SUCCESS;
+    uint32_t start = FelicaBatch_Tick();
+    uint8_t svc[FELICA_BATCH_MAX_SERVICES * 2U];
+    uint8_t blk[FELICA_MAX_BLOCKS_FRAME * 3U];
+    uint8_t svc_count;
+    uint8_t blk_len;
+    uint8_t rx_blocks;
+    uint16_t add_info;
+    uint16_t done = 0;
+    uint8_t n;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->max_blocks = FelicaBatch_CardLimit(pAl, write);
+
+    while (done < count) {
+        n = FelicaBatch_Pack(&items[done], (uint16_t)(count - done), stats->max_blocks, write,
+                             svc, &svc_count, blk, &blk_len);
+        if (n == 0U) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_GENERIC);
+        }
+
+        if (write) {
+            status = phalFelica_Write(pAl, svc_count, svc, n, blk, blk_len, &data[done * FELICA_BATCH_BLOCK_SIZE]);
+        } else {
+            status = phalFelica_Read(pAl, svc_count, svc, n, blk, blk_len, &rx_blocks, &data[done * FELICA_BATCH_BLOCK_SIZE]);
+        }
+        stats->commands++;
+
+        if ((status & PH_ERR_MASK) == PHAL_FELICA_ERR_FELICA && stats->max_blocks > 1U) {
+            (void)phalFelica_GetConfig(pAl, PHAL_FELICA_CONFIG_ADD_INFO, &add_info);
+            if ((add_info & 0x00FFU) == FELICA_SF2_NUM_BLOCKS) {
+                /* Card takes fewer blocks per command, retry the same items */
+                stats->max_blocks = (uint8_t)(stats->max_blocks / 2U);
+                continue;
+            }
+        }
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+            break;
+        }
+        done = (uint16_t)(done + n);
+    }
+
+    stats->blocks = done;
+    stats->elapsed_ms = FelicaBatch_Tick() - start;
+    DEBUG_PRINTF("FeliCa %s: %u blocks, %u commands (%u per command), %lu ms\r\n", write ? "write" : "read",
+                 stats->blocks, stats->commands, stats->max_blocks, stats->elapsed_ms);
+    return status;
+}
+
+phStatus_t FelicaBatch_Read(phalFelica_Sw_DataParams_t *pAl, const FelicaBatch_Item_t *items, uint16_t count,
+                            uint8_t *data, FelicaBatch_Stats_t *stats)
+{
+    return FelicaBatch_Transfer(pAl, items, count, data, 0, stats);
+}
+
+phStatus_t FelicaBatch_Write(phalFelica_Sw_DataParams_t *pAl, const FelicaBatch_Item_t *items, uint16_t count,
+                             const uint8_t *data, FelicaBatch_Stats_t *stats)
+{
+    /* Write only reads from the data buffer */
+    return FelicaBatch_Transfer(pAl, items, count, (uint8_t *)data, 1, stats);
+}
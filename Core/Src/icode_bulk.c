@@ -0,0 +1,290 @@
+/*
+ * icode_bulk.c
+ *
+ * ISO15693 (ICODE / NTAG 5) whole-memory reader
+ * The read path is chosen from what the tag offers:
+ *   - ParameterSelect to 53/106/212 kbit/s and plain (extended) READ MULTIPLE, or
+ *   - FAST (extended) READ MULTIPLE at 53 kbit/s on NXP tags, or
+ *   - plain (extended) READ MULTIPLE at 26 kbit/s
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "icode_bulk.h"
+#include "phpalSli15693.h"
+#include "phhalHw.h"
+#include "phApp_Init.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+
+static uint32_t IcodeBulk_Tick(void)
+{
+    return HAL_GetTick();
+}
+
+#else /* Host stand-in, the bench drives the millisecond tick */
+
+extern uint32_t IcodeBulk_HostTick(void);
+
+static uint32_t IcodeBulk_Tick(void)
+{
+    return IcodeBulk_HostTick();
+}
+
+#endif /* STM32L431xx */
+
+#define ICODE_BULK_NXP_MFG_CODE     0x04U   /* UID6 of NXP tags */
+#define ICODE_BULK_MAX_STD_BLOCKS   256U    /* Above: extended commands needed */
+
+/* Learned layout of one tag */
+typedef struct {
+    uint8_t uid[8];
+    uint8_t valid;
+    uint16_t blocks;
+    uint8_t block_size;
+    uint8_t read_cmd;                       /* IcodeBulk_Read_t that worked at 26 kbit/s */
+    uint8_t bitrate;                        /* ParameterRequest reply, 0 when not supported */
+    uint8_t timing;
+    uint32_t last_used;
+} IcodeBulk_CacheEntry_t;
+
+static IcodeBulk_CacheEntry_t s_cache[ICODE_BULK_CACHE_ENTRIES];
+static uint32_t s_cache_clock;
+
+/* ================== Layout cache ================== */
+
+static IcodeBulk_CacheEntry_t *IcodeBulk_CacheGet(const uint8_t *uid, uint8_t *pHit)
+{
+    IcodeBulk_CacheEntry_t *victim = &s_cache[0];
+
+    for (uint8_t i = 0; i < ICODE_BULK_CACHE_ENTRIES; i++) {
+        if (s_cache[i].valid && memcmp(s_cache[i].uid, uid, 8) == 0) {
+            s_cache[i].last_used = ++s_cache_clock;
+            *pHit = 1;
+            return &s_cache[i];
+        }
+        if (!s_cache[i].valid || (victim->valid && s_cache[i].last_used < victim->last_used)) {
+            victim = &s_cache[i];
+        }
+    }
+
+    /* Least recently used entry is reused, filled by IcodeBulk_Learn */
+    memset(victim, 0, sizeof(*victim));
+    memcpy(victim->uid, uid, 8);
+    victim->last_used = ++s_cache_clock;
+    *pHit = 0;
+    return victim;
+}
+
+void IcodeBulk_ClearCache(void)
+{
+    memset(s_cache, 0, sizeof(s_cache));
+    s_cache_clock = 0;
+}
+
+/* ================== Discovery ================== */
+
+/* Memory size field: blocks - 1 (1 or 2 bytes), block size - 1 */
+static void IcodeBulk_ParseMemSize(const uint8_t *info, uint16_t len, uint8_t ext, IcodeBulk_CacheEntry_t *entry)
+{
+    uint16_t idx = 9;                       /* Info flags + UID */
+
+    if (len < idx || (info[0] & PHAL_ICODE_INFO_PARAMS_REQUEST_VICC_MEM_SIZE) == 0U) {
+        return;
+    }
+    if (info[0] & PHAL_ICODE_INFO_PARAMS_REQUEST_DSFID) {
+        idx++;
+    }
+    if (info[0] & PHAL_ICODE_INFO_PARAMS_REQUEST_AFI) {
+        idx++;
+    }
+
+    if (ext && len >= idx + 3U) {
+        entry->blocks = (uint16_t)((info[idx] | ((uint16_t)info[idx + 1U] << 8)) + 1U);
+        entry->block_size = (uint8_t)((info[idx + 2U] & 0x1FU) + 1U);
+    } else if (!ext && len >= idx + 2U) {
+        entry->blocks = (uint16_t)(info[idx] + 1U);
+        entry->block_size = (uint8_t)((info[idx + 1U] & 0x1FU) + 1U);
+    }
+}
+
+/* GetSystemInformation, extended version when the tag may have more than 256 blocks, and ParameterRequest */
+static phStatus_t IcodeBulk_Learn(phalICode_Sw_DataParams_t *pAlICode, IcodeBulk_CacheEntry_t *entry)
+{
+    phStatus_t status;
+    uint8_t *info;
+    uint16_t len = 0;
+    uint8_t nxp = (entry->uid[6] == ICODE_BULK_NXP_MFG_CODE) ? 1U : 0U;
+
+    status = phalICode_GetSystemInformation(pAlICode, &info, &len);
+    if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+        IcodeBulk_ParseMemSize(info, len, 0, entry);
+    }
+
+    if (entry->blocks == 0U || entry->blocks == ICODE_BULK_MAX_STD_BLOCKS) {
+        status = phalICode_ExtendedGetSystemInformation(pAlICode, PHAL_ICODE_INFO_PARAMS_REQUEST_VICC_MEM_SIZE,
+                                                        &info, &len);
+        if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+            IcodeBulk_ParseMemSize(info, len, 1, entry);
+        }
+    }
+    if (entry->blocks == 0U) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_GENERIC);
+    }
+
+    if (entry->blocks > ICODE_BULK_MAX_STD_BLOCKS) {
+        entry->read_cmd = nxp ? ICODE_BULK_READ_EXT_FAST : ICODE_BULK_READ_EXT;
+    } else {
+        entry->read_cmd = nxp ? ICODE_BULK_READ_FAST : ICODE_BULK_READ_MULTIPLE;
+    }
+
+    /* Only NTAG 5 and a few ICODE DNA answer this, a miss costs one short timeout once per UID */
+    if ((phalICode_ParameterRequest(pAlICode, &entry->bitrate, &entry->timing) & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+        entry->bitrate = 0;
+        entry->timing = 0;
+    }
+
+    entry->valid = 1;
+    return PH_ERR_SUCCESS;
+}
+
+/* Highest rate allowed in the tag reply direction, pSelect gets the ParameterSelect bit rate byte */
+static uint8_t IcodeBulk_PickRate(const IcodeBulk_CacheEntry_t *entry, uint8_t max_rate, uint8_t *pSelect)
+{
+    for (uint8_t rate = max_rate; rate > ICODE_BULK_RATE_26; rate--) {
+        uint8_t rx_bit = (uint8_t)(PHAL_ICODE_PARAMETERS_BITRATE_53KBPS_VICC_VCD << (rate - 1U));
+        uint8_t tx_bit = (uint8_t)(PHAL_ICODE_PARAMETERS_BITRATE_53KBPS_VCD_VICC << (rate - 1U));
+
+        if ((entry->bitrate & rx_bit) == 0U) {
+            continue;
+        }
+        if (entry->bitrate & tx_bit) {
+            *pSelect = (uint8_t)(rx_bit | tx_bit);
+        } else if (entry->timing & PHAL_ICODE_PARAMETERS_TIMING_SAME_BOTH_DIRECTIONS) {
+            continue;
+        } else {
+            *pSelect = rx_bit;
+        }
+        return rate;
+    }
+    return ICODE_BULK_RATE_26;
+}
+
+/* ================== Dump ================== */
+
+static phStatus_t IcodeBulk_Read(phalICode_Sw_DataParams_t *pAlICode, IcodeBulk_Read_t cmd, uint16_t block,
+                                 uint16_t count, uint8_t *dst, uint16_t *pLen)
+{
+    switch (cmd) {
+    case ICODE_BULK_READ_FAST:
+        return phalICode_FastReadMultipleBlocks(pAlICode, PHAL_ICODE_OPTION_OFF, (uint8_t)block, (uint8_t)count, dst, pLen);
+    case ICODE_BULK_READ_EXT:
+        return phalICode_ExtendedReadMultipleBlocks(pAlICode, PHAL_ICODE_OPTION_OFF, block, count, dst, pLen);
+    case ICODE_BULK_READ_EXT_FAST:
+        return phalICode_ExtendedFastReadMultipleBlocks(pAlICode, PHAL_ICODE_OPTION_OFF, block, count, dst, pLen);
+    default:
+        return phalICode_ReadMultipleBlocks(pAlICode, PHAL_ICODE_OPTION_OFF, (uint8_t)block, (uint8_t)count, dst, pLen);
+    }
+}
+
+phStatus_t IcodeBulk_ReadAll(phalICode_Sw_DataParams_t *pAlICode, uint8_t max_rate,
+                             uint8_t *data, uint16_t data_size, IcodeBulk_Result_t *result)
+{
+    phStatus_t status;
+    uint32_t start = IcodeBulk_Tick();
+    phpalSli15693_Sw_DataParams_t *pPal = (phpalSli15693_Sw_DataParams_t *)pAlICode->pPalSli15693DataParams;
+    IcodeBulk_CacheEntry_t *entry;
+    IcodeBulk_Read_t cmd;
+    uint8_t uid[8];
+    uint8_t uid_len = 0;
+    uint8_t select = 0;
+    uint16_t rx_buf_size = 0;
+    uint16_t per_request;
+    uint16_t total;
+    uint16_t block = 0;
+    uint16_t len;
+
+    memset(result, 0, sizeof(*result));
+
+    PH_CHECK_SUCCESS_FCT(status, phpalSli15693_GetSerialNo(pPal, uid, &uid_len));
+    entry = IcodeBulk_CacheGet(uid, &result->cache_hit);
+    if (!result->cache_hit) {
+        PH_CHECK_SUCCESS_FCT(status, IcodeBulk_Learn(pAlICode, entry));
+    }
+
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_GetConfig(pPal->pHalDataParams, PHHAL_HW_CONFIG_RXBUFFER_BUFSIZE, &rx_buf_size));
+    per_request = (rx_buf_size > ICODE_BULK_RX_OVERHEAD) ?
+                  (uint16_t)((rx_buf_size - ICODE_BULK_RX_OVERHEAD) / entry->block_size) : 1U;
+    if (per_request == 0U) {
+        per_request = 1;
+    }
+
+    total = entry->blocks;
+    if ((uint32_t)total * entry->block_size > data_size) {
+        total = (uint16_t)(data_size / entry->block_size);
+    }
+
+    /* Higher data rate: FAST commands would force their own reply rate, use the plain ones */
+    cmd = (IcodeBulk_Read_t)entry->read_cmd;
+    result->rate = (cmd == ICODE_BULK_READ_FAST || cmd == ICODE_BULK_READ_EXT_FAST) ? ICODE_BULK_RATE_53 : ICODE_BULK_RATE_26;
+    if (IcodeBulk_PickRate(entry, max_rate, &select) > result->rate) {
+        uint8_t timing = (entry->timing & PHAL_ICODE_PARAMETERS_TIMING_80_2_US) ? PHAL_ICODE_PARAMETERS_TIMING_80_2_US :
+                         (entry->timing & PHAL_ICODE_PARAMETERS_TIMING_160_5_US) ? PHAL_ICODE_PARAMETERS_TIMING_160_5_US :
+                         PHAL_ICODE_PARAMETERS_TIMING_320_9_US;
+
+        if ((phalICode_ParameterSelect(pAlICode, select, timing) & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+            result->rate = IcodeBulk_PickRate(entry, max_rate, &select);
+            cmd = (entry->blocks > ICODE_BULK_MAX_STD_BLOCKS) ? ICODE_BULK_READ_EXT : ICODE_BULK_READ_MULTIPLE;
+        } else {
+            select = 0;
+        }
+    } else {
+        select = 0;
+    }
+
+    while (block < total) {
+        uint16_t count = (uint16_t)(total - block);
+
+        if (count > per_request) {
+            count = per_request;
+        }
+        if ((cmd == ICODE_BULK_READ_MULTIPLE || cmd == ICODE_BULK_READ_FAST) && count > 255U) {
+            count = 255;
+        }
+
+        len = 0;
+        status = IcodeBulk_Read(pAlICode, cmd, block, count, &data[block * entry->block_size], &len);
+        result->requests++;
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+            /* FAST variant not supported by this tag, fall back once and remember */
+            if (cmd == ICODE_BULK_READ_FAST || cmd == ICODE_BULK_READ_EXT_FAST) {
+                cmd = (cmd == ICODE_BULK_READ_FAST) ? ICODE_BULK_READ_MULTIPLE : ICODE_BULK_READ_EXT;
+                entry->read_cmd = cmd;
+                result->rate = ICODE_BULK_RATE_26;
+                continue;
+            }
+            break;
+        }
+        block = (uint16_t)(block + count);
+    }
+
+    /* Back to 26 kbit/s, tag and PAL */
+    if (select != 0U) {
+        (void)phalICode_ParameterSelect(pAlICode, PHAL_ICODE_PARAMETERS_BITRATE_26KBPS_BOTH_DIRECTIONS,
+                                        PHAL_ICODE_PARAMETERS_TIMING_320_9_US);
+    }
+
+    result->blocks = entry->blocks;
+    result->block_size = entry->block_size;
+    result->bytes = (uint16_t)(block * entry->block_size);
+    result->read_cmd = cmd;
+    result->elapsed_ms = IcodeBulk_Tick() - start;
+    DEBUG_PRINTF("ICODE dump: %u bytes (%u x %u), %u requests, cmd %d, rate %d, %lu ms%s\r\n",
+                 result->bytes, result->blocks, result->block_size, result->requests, result->read_cmd,
+                 result->rate, result->elapsed_ms, result->cache_hit ? " (cached layout)" : "");
+
+    return ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) ? PH_ERR_SUCCESS : status;
+}
@@ -0,0 +1,207 @@
+/*
+ * inventory_a.c
+ *
+ * Bulk ISO14443-3A inventory
+ * Binary tree walk over the UID space: on a collision the reader follows the
+ * 1 branch and keeps the 0 branch with the bits learned so far, so later
+ * branches restart at the collision point instead of from an empty UID
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "inventory_a.h"
+#include "phhalHw.h"
+#include "phApp_Init.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+
+static uint32_t InventoryA_Tick(void)
+{
+    return HAL_GetTick();
+}
+
+#else /* Host stand-in, the bench drives the millisecond tick */
+
+extern uint32_t InventoryA_HostTick(void);
+
+static uint32_t InventoryA_Tick(void)
+{
+    return InventoryA_HostTick();
+}
+
+#endif /* STM32L431xx */
+
+/* Pending branch: selected UID of the lower cascade levels plus the known bits of the current one */
+typedef struct {
+    uint8_t level;                  /* Cascade level index 0..2 */
+    uint8_t done[2][4];             /* UID CLn of the levels below */
+    uint8_t uid[5];                 /* Known bits of this level */
+    uint8_t nvb;                    /* Valid bits, ANTICOLLISION NVB format */
+} InventoryA_Branch_t;
+
+static const uint8_t s_cascade[3] = {
+    PHPAL_I14443P3A_CASCADE_LEVEL_1,
+    PHPAL_I14443P3A_CASCADE_LEVEL_2,
+    PHPAL_I14443P3A_CASCADE_LEVEL_3
+};
+
+static InventoryA_Branch_t s_branch[INVENTORY_A_MAX_BRANCHES];
+static uint8_t s_depth;
+
+/* Add the bit after nvb with the given value */
+static void InventoryA_AppendBit(uint8_t *uid, uint8_t *nvb, uint8_t bit)
+{
+    uint8_t byte;
+    uint8_t mask;
+
+    if ((*nvb & 0x07U) < 7U) {
+        (*nvb)++;
+        byte = (*nvb & 0xF0U) >> 4U;
+        mask = (uint8_t)(1U << ((*nvb & 0x07U) - 1U));
+    } else {
+        *nvb = (uint8_t)((((*nvb & 0xF0U) >> 4U) + 1U) << 4U);
+        byte = ((*nvb & 0xF0U) >> 4U) - 1U;
+        mask = 0x80U;
+    }
+
+    if (bit) {
+        uid[byte] |= mask;
+    } else {
+        uid[byte] &= (uint8_t)~mask;
+    }
+}
+
+/*
+ * Resolve one card starting from a branch, collisions on the way push the 0 branches.
+ * PH_ERR_IO_TIMEOUT means no card is left on this branch.
+ */
+static phStatus_t InventoryA_Resolve(phpalI14443p3a_Sw_DataParams_t *pPal, InventoryA_Branch_t *b,
+                                     InventoryA_Result_t *result, uint8_t *pSak)
+{
+    phStatus_t status;
+
+    /* Re-select the levels already known, cards of other branches drop back to IDLE */
+    for (uint8_t l = 0; l < b->level; l++) {
+        result->frames++;
+        status = phpalI14443p3a_Select(pPal, s_cascade[l], b->done[l], pSak);
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+            return status;
+        }
+    }
+
+    for (;;) {
+        while (b->nvb != 0x40U) {
+            result->frames++;
+            status = phpalI14443p3a_Anticollision(pPal, s_cascade[b->level], b->uid, b->nvb, b->uid, &b->nvb);
+
+            if ((status & PH_ERR_MASK) == PH_ERR_COLLISION_ERROR) {
+                /* Keep the 0 branch with everything learned up to here */
+                if (s_depth < INVENTORY_A_MAX_BRANCHES) {
+                    InventoryA_Branch_t *sibling = &s_branch[s_depth++];
+
+                    *sibling = *b;
+                    InventoryA_AppendBit(sibling->uid, &sibling->nvb, 0);
+                }
+                InventoryA_AppendBit(b->uid, &b->nvb, 1);
+            } else if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+                return status;
+            }
+        }
+
+        result->frames++;
+        status = phpalI14443p3a_Select(pPal, s_cascade[b->level], b->uid, pSak);
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+            return status;
+        }
+        if ((*pSak & 0x04U) == 0U) {
+            return PH_ERR_SUCCESS;
+        }
+        if (b->level >= 2U) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_GENERIC);
+        }
+
+        /* UID continues on the next cascade level */
+        memcpy(b->done[b->level], b->uid, 4);
+        b->level++;
+        memset(b->uid, 0, sizeof(b->uid));
+        b->nvb = 0;
+    }
+}
+
+phStatus_t InventoryA_Run(phpalI14443p3a_Sw_DataParams_t *pPal, uint32_t budget_ms,
+                          InventoryA_Result_t *result)
+{
+    phStatus_t status;
+    uint32_t start = InventoryA_Tick();
+    uint8_t atqa[2];
+    uint8_t atqa_valid;
+
+    memset(result, 0, sizeof(*result));
+    s_depth = 0;
+
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_ApplyProtocolSettings(pPal->pHalDataParams, PHHAL_HW_CARDTYPE_ISO14443A));
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_FieldOn(pPal->pHalDataParams));
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_Wait(pPal->pHalDataParams, PHHAL_HW_TIME_MICROSECONDS, INVENTORY_A_GUARD_TIME_US));
+
+    while (result->count < INVENTORY_A_MAX_CARDS && (InventoryA_Tick() - start) < budget_ms) {
+        InventoryA_Branch_t branch;
+        InventoryA_Card_t *card = &result->cards[result->count];
+
+        /* Halted cards stay silent, only unresolved ones answer */
+        result->frames++;
+        status = phpalI14443p3a_RequestA(pPal, atqa);
+        if ((status & PH_ERR_MASK) == PH_ERR_IO_TIMEOUT) {
+            result->complete = 1;
+            break;
+        }
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS && (status & PH_ERR_MASK) != PH_ERR_COLLISION_ERROR) {
+            /* Garbled ATQA of overlapping cards, try again */
+            if ((status & PH_ERR_MASK) == PH_ERR_INTEGRITY_ERROR || (status & PH_ERR_MASK) == PH_ERR_PROTOCOL_ERROR) {
+                continue;
+            }
+            return status;
+        }
+        atqa_valid = ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) ? 1U : 0U;
+
+        if (s_depth == 0U) {
+            memset(&s_branch[0], 0, sizeof(s_branch[0]));
+            s_depth = 1;
+        }
+        branch = s_branch[--s_depth];
+
+        status = InventoryA_Resolve(pPal, &branch, result, &card->sak);
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+            /* Branch empty or disturbed, cards left behind answer the next REQA */
+            if ((status & PH_ERR_MASK) == PH_ERR_IO_TIMEOUT || (status & PH_ERR_MASK) == PH_ERR_COLLISION_ERROR ||
+                (status & PH_ERR_MASK) == PH_ERR_INTEGRITY_ERROR || (status & PH_ERR_MASK) == PH_ERR_PROTOCOL_ERROR) {
+                continue;
+            }
+            return status;
+        }
+
+        PH_CHECK_SUCCESS_FCT(status, phpalI14443p3a_GetSerialNo(pPal, card->uid, &card->uid_len));
+        card->atqa[0] = atqa[0];
+        card->atqa[1] = atqa[1];
+        card->atqa_valid = atqa_valid;
+        result->count++;
+
+        result->frames++;
+        (void)phpalI14443p3a_HaltA(pPal);
+    }
+
+    /* Table full: tell the caller whether cards were left behind */
+    if (result->count == INVENTORY_A_MAX_CARDS) {
+        result->frames++;
+        if ((phpalI14443p3a_RequestA(pPal, atqa) & PH_ERR_MASK) == PH_ERR_IO_TIMEOUT) {
+            result->complete = 1;
+        }
+    }
+
+    result->elapsed_ms = InventoryA_Tick() - start;
+    DEBUG_PRINTF("Inventory A: %d cards, %u frames, %lu ms%s\r\n", result->count, result->frames,
+                 result->elapsed_ms, result->complete ? "" : " (budget or table full)");
+    return PH_ERR_SUCCESS;
+}
@@ -0,0 +1,236 @@
+/*
+ * inventory_epc.c
+ *
+ * ISO18000-3 mode 3 (EPC Gen2 HF) inventory with adaptive Q
+ * Each round is run by the PN5180 (BeginRound, Ack and NextSlot in firmware),
+ * the result buffer is drained with ResumeInventory until all 2^Q slots are in.
+ * The reader cannot send QueryAdjust inside a firmware round, so the Qfp slot
+ * by slot update of the Gen2 air interface is replaced by a frame size per
+ * round: the tags left are estimated from the collided slots of the round
+ * (Schoute, 2.39 tags per collision) and the next round gets about two slots
+ * per tag, the optimum when an empty slot costs a third of a collision
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "inventory_epc.h"
+#include "phhalHw.h"
+#include "phApp_Init.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+
+static uint32_t InventoryEpc_Tick(void)
+{
+    return HAL_GetTick();
+}
+
+#else /* Host stand-in, the bench drives the millisecond tick */
+
+extern uint32_t InventoryEpc_HostTick(void);
+
+static uint32_t InventoryEpc_Tick(void)
+{
+    return InventoryEpc_HostTick();
+}
+
+#endif /* STM32L431xx */
+
+/* Slot status bytes of the inventory result */
+#define EPC_SLOT_TAG            0U
+#define EPC_SLOT_TAG_HANDLE     1U
+#define EPC_SLOT_EMPTY          2U
+#define EPC_SLOT_COLLISION      3U
+
+/* Round statistics */
+typedef struct {
+    uint16_t success;
+    uint16_t empty;
+    uint16_t collision;
+} InventoryEpc_Round_t;
+
+/* Store one tag reply: PC, optional XPC words, UII, PacketCRC when XPC is present */
+static void InventoryEpc_StoreTag(const uint8_t *reply, uint8_t len, InventoryEpc_Result_t *result)
+{
+    InventoryEpc_Tag_t *tag;
+    uint8_t pc_len = 2;
+    uint8_t crc_len = 0;
+    uint8_t uii_len;
+
+    result->tags_seen++;
+    if (result->count >= INVENTORY_EPC_MAX_TAGS || len < 2U) {
+        return;
+    }
+
+    /* XPC indicator */
+    if (reply[1] & 0x02U) {
+        pc_len += 2U;
+        crc_len = 2;
+        if (len > 2U && (reply[2] & 0x80U)) {
+            pc_len += 2U;
+        }
+    }
+
+    tag = &result->tags[result->count++];
+    tag->pc[0] = reply[0];
+    tag->pc[1] = reply[1];
+    uii_len = (len > pc_len + crc_len) ? (uint8_t)(len - pc_len - crc_len) : 0U;
+    if (uii_len > INVENTORY_EPC_UII_MAX) {
+        uii_len = INVENTORY_EPC_UII_MAX;
+    }
+    memcpy(tag->uii, &reply[pc_len], uii_len);
+    tag->uii_len = uii_len;
+}
+
+/* Parse slot records, returns the number of slots consumed or -1 on a malformed buffer */
+static int InventoryEpc_ParseSlots(const uint8_t *rx, uint16_t rx_len, uint16_t slots_left,
+                                   InventoryEpc_Round_t *round, InventoryEpc_Result_t *result)
+{
+    uint16_t idx = 0;
+    int slots = 0;
+
+    while ((idx + 3U) <= rx_len && slots < slots_left) {
+        switch (rx[idx]) {
+        case EPC_SLOT_TAG:
+        case EPC_SLOT_TAG_HANDLE:
+            if ((uint16_t)(idx + 3U + rx[idx + 1U]) > rx_len) {
+                return -1;
+            }
+            InventoryEpc_StoreTag(&rx[idx + 3U], rx[idx + 1U], result);
+            round->success++;
+            idx = (uint16_t)(idx + 3U + rx[idx + 1U] + ((rx[idx] == EPC_SLOT_TAG_HANDLE) ? 2U : 0U));
+            break;
+
+        case EPC_SLOT_EMPTY:
+            round->empty++;
+            idx += 3U;
+            break;
+
+        case EPC_SLOT_COLLISION:
+            round->collision++;
+            idx += 3U;
+            break;
+
+        default:
+            return -1;
+        }
+        slots++;
+    }
+    return slots;
+}
+
+/* Q of the next round: 2^Q at least INVENTORY_EPC_SLOTS_PER_TAG slots per tag still unread */
+static uint8_t InventoryEpc_NextQ(const InventoryEpc_Round_t *round)
+{
+    uint32_t slots = ((uint32_t)round->collision * 239U + 99U) / 100U * INVENTORY_EPC_SLOTS_PER_TAG;
+    uint8_t q = 0;
+
+    while ((1UL << q) < slots && q < INVENTORY_EPC_Q_MAX) {
+        q++;
+    }
+    return q;
+}
+
+void InventoryEpc_DefaultConfig(InventoryEpc_Config_t *cfg)
+{
+    cfg->session = PHPAL_I18000P3M3_SESSION_S0;
+    cfg->sel = PHPAL_I18000P3M3_SEL_ALL_00;
+    cfg->reset_flags = 1;
+    cfg->q_start = 4;
+    cfg->adaptive = 1;
+    cfg->dr = PHPAL_I18000P3M3_LF_847KHZ;
+    cfg->m = PHPAL_I18000P3M3_M_MANCHESTER_4;
+    cfg->max_rounds = 32;
+    cfg->budget_ms = 1000;
+}
+
+phStatus_t InventoryEpc_Run(phpalI18000p3m3_Sw_DataParams_t *pPal, const InventoryEpc_Config_t *cfg,
+                            InventoryEpc_Result_t *result)
+{
+    phStatus_t status;
+    void *pHal = pPal->pHalDataParams;
+    uint32_t start = InventoryEpc_Tick();
+    uint8_t begin_round[3];
+    uint8_t no_select = 0;
+    uint8_t q = cfg->q_start;
+
+    memset(result, 0, sizeof(*result));
+    if (q > INVENTORY_EPC_Q_MAX) {
+        q = INVENTORY_EPC_Q_MAX;
+    }
+
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_ApplyProtocolSettings(pHal, PHHAL_HW_CARDTYPE_I18000P3M3));
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_FieldOn(pHal));
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_Wait(pHal, PHHAL_HW_TIME_MICROSECONDS, INVENTORY_EPC_GUARD_TIME_US));
+
+    if (cfg->reset_flags) {
+        /* Empty mask matches every tag: inventoried flag of the session -> A */
+        status = phpalI18000p3m3_Select(pPal, cfg->session, 0, PHPAL_I18000P3M3_MEMBANK_UII,
+                                        &no_select, 0, NULL, 0, PH_OFF);
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS && (status & PH_ERR_MASK) != PH_ERR_IO_TIMEOUT) {
+            return status;
+        }
+    }
+
+    while (result->rounds < cfg->max_rounds && (InventoryEpc_Tick() - start) < cfg->budget_ms) {
+        InventoryEpc_Round_t round = {0};
+        uint16_t slots_left = (uint16_t)(1U << q);
+        uint8_t *rx = NULL;
+        uint16_t rx_len = 0;
+        int parsed;
+
+        PH_CHECK_SUCCESS_FCT(status, phpalI18000p3m3_CreateBeginRoundCmd(pPal, cfg->dr, cfg->m, PH_OFF,
+                                                                          cfg->sel, cfg->session, 0, q, begin_round));
+
+        /* The firmware skips the Select frame when collecting a whole round */
+        status = phhalHw_I18000p3m3Inventory(pHal, &no_select, 0, 0, begin_round,
+                                             PHHAL_HW_I18000P3M3_GET_MAX_RESPS, &rx, &rx_len);
+
+        for (;;) {
+            if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS && (status & PH_ERR_MASK) != PH_ERR_IO_TIMEOUT &&
+                (status & PH_ERR_MASK) != PH_ERR_COLLISION_ERROR) {
+                return status;
+            }
+            if (rx_len == 0U) {
+                /* Nothing came back, count the rest of the round as empty */
+                round.empty = (uint16_t)(round.empty + slots_left);
+                break;
+            }
+
+            parsed = InventoryEpc_ParseSlots(rx, rx_len, slots_left, &round, result);
+            if (parsed < 0) {
+                return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_GENERIC);
+            }
+            slots_left = (uint16_t)(slots_left - parsed);
+            if (slots_left == 0U || parsed == 0) {
+                break;
+            }
+
+            /* Result buffer was full, continue with the next slots */
+            rx_len = 0;
+            status = phhalHw_I18000p3m3ResumeInventory(pHal, &rx, &rx_len);
+        }
+
+        result->rounds++;
+        result->last_q = q;
+        result->slots_success = (uint16_t)(result->slots_success + round.success);
+        result->slots_empty = (uint16_t)(result->slots_empty + round.empty);
+        result->slots_collision = (uint16_t)(result->slots_collision + round.collision);
+
+        if (round.success == 0U && round.collision == 0U) {
+            result->complete = 1;
+            break;
+        }
+        if (cfg->adaptive) {
+            q = InventoryEpc_NextQ(&round);
+        }
+    }
+
+    result->elapsed_ms = InventoryEpc_Tick() - start;
+    DEBUG_PRINTF("EPC inventory: %u tags, %u rounds, slots %u/%u/%u (tag/empty/coll), %lu ms\r\n",
+                 result->tags_seen, result->rounds, result->slots_success, result->slots_empty,
+                 result->slots_collision, result->elapsed_ms);
+    return PH_ERR_SUCCESS;
+}
@@ -0,0 +1,328 @@
+/*
+ * lpcd_mgr.c
+ *
+ * Self-calibrating LPCD manager for the PN5180
+ * The reference is an exponential moving average of AGC measurements taken
+ * with no card present, the noise is the averaged deviation from it. The
+ * threshold never drops below LPCD_MGR_NOISE_FACTOR times the noise
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "lpcd_mgr.h"
+#include "phhalHw_Pn5180_Instr.h"
+#include "phhalHw_Pn5180_Reg.h"
+#include "phApp_Init.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+
+static uint32_t LpcdMgr_Tick(void)
+{
+    return HAL_GetTick();
+}
+
+#else /* Host stand-in, the bench drives the millisecond tick */
+
+extern uint32_t LpcdMgr_HostTick(void);
+
+static uint32_t LpcdMgr_Tick(void)
+{
+    return LpcdMgr_HostTick();
+}
+
+#endif /* STM32L431xx */
+
+#define LPCD_THRESHOLD_E2PROM_ADDR      0x37U
+#define LPCD_REFVAL_CONTROL_E2PROM_ADDR 0x38U
+#define LPCD_REFVAL_CONTROL_MASK        0x03U
+#define LPCD_REFVAL_CONTROL_REGISTER    0x01U   /* Reference from AGC_REF_CONFIG */
+
+/* ================== AGC measurement ================== */
+
+static phStatus_t LpcdMgr_ReadAgc(void *ctx, uint16_t *pAgc)
+{
+    phhalHw_Pn5180_DataParams_t *pHal = (phhalHw_Pn5180_DataParams_t *)ctx;
+    phStatus_t status;
+    uint32_t reg;
+    uint32_t sum = 0;
+
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_FieldOn(pHal));
+    status = phhalHw_Wait(pHal, PHHAL_HW_TIME_MICROSECONDS, LPCD_MGR_SETTLE_US);
+
+    for (uint8_t i = 0; i < LPCD_MGR_SAMPLES && (status & PH_ERR_MASK) == PH_ERR_SUCCESS; i++) {
+        status = phhalHw_Pn5180_Instr_ReadRegister(pHal, AGC_REF_CONFIG, &reg);
+        sum += reg & AGC_REF_CONFIG_AGC_VALUE_MASK;
+        if (i + 1U < LPCD_MGR_SAMPLES && (status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+            status = phhalHw_Wait(pHal, PHHAL_HW_TIME_MICROSECONDS, LPCD_MGR_SAMPLE_GAP_US);
+        }
+    }
+    (void)phhalHw_FieldOff(pHal);
+    PH_CHECK_SUCCESS(status);
+
+    *pAgc = (uint16_t)((reg & AGC_REF_CONFIG_AGC_GEAR_MASK) | ((sum + LPCD_MGR_SAMPLES / 2U) / LPCD_MGR_SAMPLES));
+    return PH_ERR_SUCCESS;
+}
+
+/* ================== Helpers ================== */
+
+static uint8_t LpcdMgr_NoiseFloor(const LpcdMgr_t *mgr)
+{
+    uint32_t floor = ((mgr->noise_q4 * LPCD_MGR_NOISE_FACTOR) >> 4) + 1U;
+
+    if (floor < mgr->cfg.threshold_min) {
+        floor = mgr->cfg.threshold_min;
+    }
+    return (uint8_t)((floor > mgr->cfg.threshold_max) ? mgr->cfg.threshold_max : floor);
+}
+
+static void LpcdMgr_Adapt(LpcdMgr_t *mgr)
+{
+    LpcdMgr_Stats_t *st = &mgr->stats;
+    uint32_t rate = (uint32_t)mgr->win_false * 100U / mgr->win_wakes;
+    uint32_t th = st->threshold;
+    uint32_t period = st->period_ms;
+
+    if (rate > mgr->cfg.false_high_pct) {
+        /* Phantom wakes: less sensitive and less often */
+        th += (th / 4U > 1U) ? th / 4U : 1U;
+        period *= 2U;
+    } else if (rate < mgr->cfg.false_low_pct) {
+        /* Quiet environment: creep back towards sensitivity and responsiveness */
+        th -= (th / 8U > 1U) ? th / 8U : 1U;
+        period /= 2U;
+    }
+
+    if (th > mgr->cfg.threshold_max) {
+        th = mgr->cfg.threshold_max;
+    }
+    if (th < LpcdMgr_NoiseFloor(mgr)) {
+        th = LpcdMgr_NoiseFloor(mgr);
+    }
+    if (period > mgr->cfg.period_max_ms) {
+        period = mgr->cfg.period_max_ms;
+    }
+    if (period < mgr->cfg.period_min_ms) {
+        period = mgr->cfg.period_min_ms;
+    }
+
+    if (th != st->threshold || period != st->period_ms) {
+        DEBUG_PRINTF("LPCD adapt: false %lu%%, threshold %d -> %lu, period %d -> %lu ms\r\n",
+                     rate, st->threshold, th, st->period_ms, period);
+    }
+    st->threshold = (uint8_t)th;
+    st->period_ms = (uint16_t)period;
+    mgr->win_wakes = 0;
+    mgr->win_false = 0;
+}
+
+/*
+ * The E2PROM threshold trails the adapted one: rewritten once they differ by
+ * the hysteresis, and always when it fell below the noise floor
+ */
+static uint8_t LpcdMgr_ThresholdDue(const LpcdMgr_t *mgr)
+{
+    uint8_t th = mgr->stats.threshold;
+    uint8_t written = mgr->threshold_written;
+    uint8_t diff = (uint8_t)((th > written) ? th - written : written - th);
+
+    if (diff == 0U) {
+        return 0;
+    }
+    return (diff >= mgr->cfg.e2prom_hyst || written < LpcdMgr_NoiseFloor(mgr)) ? 1U : 0U;
+}
+
+/* ================== Interface ================== */
+
+void LpcdMgr_DefaultConfig(LpcdMgr_Config_t *cfg)
+{
+    cfg->threshold_init = 0x10U;
+    cfg->threshold_min = 0x04U;
+    cfg->threshold_max = 0x60U;
+    cfg->e2prom_hyst = 4U;
+    cfg->period_min_ms = 100U;
+    cfg->period_max_ms = 1600U;
+    cfg->recal_interval_ms = 60000U;
+    cfg->ema_shift = 3U;
+    cfg->window = 8U;
+    cfg->false_high_pct = 25U;
+    cfg->false_low_pct = 5U;
+}
+
+phStatus_t LpcdMgr_Init(LpcdMgr_t *mgr, phhalHw_Pn5180_DataParams_t *pHal, const LpcdMgr_Config_t *cfg)
+{
+    phStatus_t status;
+    uint8_t control;
+
+    memset(mgr, 0, sizeof(*mgr));
+    if (cfg != NULL) {
+        mgr->cfg = *cfg;
+    } else {
+        LpcdMgr_DefaultConfig(&mgr->cfg);
+    }
+    if (mgr->cfg.window == 0U) {
+        mgr->cfg.window = 1U;
+    }
+    mgr->pHal = pHal;
+    mgr->agc_source = LpcdMgr_ReadAgc;
+    mgr->agc_ctx = pHal;
+    mgr->stats.threshold = mgr->cfg.threshold_init;
+    mgr->stats.period_ms = mgr->cfg.period_max_ms;
+
+    if (pHal != NULL) {
+        PH_CHECK_SUCCESS_FCT(status, phhalHw_Pn5180_Int_LPCD_SetConfig(pHal, PHHAL_HW_CONFIG_LPCD_MODE,
+                                                                       PHHAL_HW_PN5180_LPCD_MODE_POWERDOWN));
+
+        /* Reference in the register, the E2PROM only takes threshold moves beyond the hysteresis */
+        PH_CHECK_SUCCESS_FCT(status, phhalHw_Pn5180_Instr_ReadE2Prom(pHal, LPCD_REFVAL_CONTROL_E2PROM_ADDR, &control, 1U));
+        if ((control & LPCD_REFVAL_CONTROL_MASK) != LPCD_REFVAL_CONTROL_REGISTER) {
+            control = (uint8_t)((control & (uint8_t)~LPCD_REFVAL_CONTROL_MASK) | LPCD_REFVAL_CONTROL_REGISTER);
+            PH_CHECK_SUCCESS_FCT(status, phhalHw_Pn5180_Instr_WriteE2Prom(pHal, LPCD_REFVAL_CONTROL_E2PROM_ADDR, &control, 1U));
+        }
+        PH_CHECK_SUCCESS_FCT(status, phhalHw_Pn5180_Instr_ReadE2Prom(pHal, LPCD_THRESHOLD_E2PROM_ADDR,
+                                                                     &mgr->threshold_written, 1U));
+        mgr->stats.threshold_e2prom = mgr->threshold_written;
+    }
+
+    /* Without a HAL the first reference comes from the injected source */
+    return (pHal != NULL) ? LpcdMgr_Calibrate(mgr) : PH_ERR_SUCCESS;
+}
+
+void LpcdMgr_SetAgcSource(LpcdMgr_t *mgr, LpcdMgr_AgcSource_t source, void *ctx)
+{
+    mgr->agc_source = (source != NULL) ? source : LpcdMgr_ReadAgc;
+    mgr->agc_ctx = (source != NULL) ? ctx : mgr->pHal;
+}
+
+/*
+ * One AGC measurement into the average. empty: the field is known to hold no
+ * card, so a move beyond the threshold is a new background and restarts the
+ * average. Otherwise such a measurement may be a card and is left to the
+ * LPCD wake-up and the discovery loop after it
+ */
+static phStatus_t LpcdMgr_Measure(LpcdMgr_t *mgr, uint8_t empty)
+{
+    phStatus_t status;
+    uint16_t agc;
+    uint16_t gear;
+    uint32_t value_q4;
+    uint32_t dev_q4;
+
+    PH_CHECK_SUCCESS_FCT(status, mgr->agc_source(mgr->agc_ctx, &agc));
+    mgr->last_recal_ms = LpcdMgr_Tick();
+
+    gear = (uint16_t)(agc & AGC_REF_CONFIG_AGC_GEAR_MASK);
+    value_q4 = (uint32_t)(agc & AGC_REF_CONFIG_AGC_VALUE_MASK) << 4;
+    dev_q4 = (value_q4 > mgr->ref_q4) ? value_q4 - mgr->ref_q4 : mgr->ref_q4 - value_q4;
+
+    if (mgr->calibrated && gear == mgr->gear && dev_q4 > ((uint32_t)mgr->stats.threshold << 4)) {
+        if (!empty) {
+            return PH_ERR_SUCCESS;
+        }
+        mgr->calibrated = 0;
+    }
+
+    if (!mgr->calibrated || gear != mgr->gear) {
+        /* First measurement, a different receiver gear or a new background, the old average does not apply */
+        mgr->ref_q4 = value_q4;
+        mgr->gear = gear;
+        mgr->calibrated = 1;
+    } else {
+        mgr->noise_q4 = mgr->noise_q4 - (mgr->noise_q4 >> mgr->cfg.ema_shift) + (dev_q4 >> mgr->cfg.ema_shift);
+        mgr->ref_q4 = mgr->ref_q4 - (mgr->ref_q4 >> mgr->cfg.ema_shift) + (value_q4 >> mgr->cfg.ema_shift);
+    }
+
+    mgr->stats.reference = (uint16_t)(mgr->gear | ((mgr->ref_q4 + 8U) >> 4));
+    mgr->stats.noise = (uint16_t)((mgr->noise_q4 + 8U) >> 4);
+    mgr->stats.recalibrations++;
+
+    if (mgr->stats.threshold < LpcdMgr_NoiseFloor(mgr)) {
+        mgr->stats.threshold = LpcdMgr_NoiseFloor(mgr);
+    }
+
+    if (mgr->pHal != NULL) {
+        PH_CHECK_SUCCESS_FCT(status, phhalHw_Pn5180_Int_LPCD_SetConfig(mgr->pHal, PHHAL_HW_CONFIG_LPCD_REF,
+                                                                       mgr->stats.reference));
+    }
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t LpcdMgr_Calibrate(LpcdMgr_t *mgr)
+{
+    return LpcdMgr_Measure(mgr, 1);
+}
+
+phStatus_t LpcdMgr_Arm(LpcdMgr_t *mgr)
+{
+    phStatus_t status;
+
+    /* A card may be on the antenna, the periodic measurement does not trust a large move */
+    if ((LpcdMgr_Tick() - mgr->last_recal_ms) >= mgr->cfg.recal_interval_ms) {
+        PH_CHECK_SUCCESS_FCT(status, LpcdMgr_Measure(mgr, 0));
+    }
+    if (mgr->pHal == NULL) {
+        return PH_ERR_SUCCESS;
+    }
+
+    if (LpcdMgr_ThresholdDue(mgr)) {
+        PH_CHECK_SUCCESS_FCT(status, phhalHw_Pn5180_Instr_WriteE2Prom(mgr->pHal, LPCD_THRESHOLD_E2PROM_ADDR,
+                                                                      &mgr->stats.threshold, 1U));
+        mgr->threshold_written = mgr->stats.threshold;
+        mgr->stats.e2prom_writes++;
+    }
+    mgr->stats.threshold_e2prom = mgr->threshold_written;
+    return phhalHw_Pn5180_Int_LPCD_SetConfig(mgr->pHal, PHHAL_HW_CONFIG_SET_LPCD_WAKEUPTIME_MS, mgr->stats.period_ms);
+}
+
+phStatus_t LpcdMgr_Wait(LpcdMgr_t *mgr)
+{
+    phStatus_t status;
+
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_Lpcd(mgr->pHal));
+    LpcdMgr_OnWake(mgr);
+    return PH_ERR_SUCCESS;
+}
+
+void LpcdMgr_OnWake(LpcdMgr_t *mgr)
+{
+    mgr->wake_ms = LpcdMgr_Tick();
+    mgr->woken = 1;
+    mgr->stats.wakes++;
+}
+
+void LpcdMgr_OnDiscovery(LpcdMgr_t *mgr, uint8_t card_found)
+{
+    LpcdMgr_Stats_t *st = &mgr->stats;
+
+    if (!mgr->woken) {
+        return;
+    }
+    mgr->woken = 0;
+    mgr->win_wakes++;
+
+    if (card_found) {
+        st->detections++;
+        st->latency_last_ms = LpcdMgr_Tick() - mgr->wake_ms;
+        st->latency_avg_ms = (st->detections == 1U) ? st->latency_last_ms
+                           : st->latency_avg_ms - st->latency_avg_ms / 8U + st->latency_last_ms / 8U;
+        if (st->latency_last_ms > st->latency_max_ms) {
+            st->latency_max_ms = st->latency_last_ms;
+        }
+    } else {
+        st->false_wakes++;
+        mgr->win_false++;
+        /* Nothing in the field, so the field changed: measure the new background */
+        (void)LpcdMgr_Calibrate(mgr);
+    }
+
+    if (mgr->win_wakes >= mgr->cfg.window) {
+        LpcdMgr_Adapt(mgr);
+    }
+}
+
+const LpcdMgr_Stats_t *LpcdMgr_GetStats(const LpcdMgr_t *mgr)
+{
+    return &mgr->stats;
+}
@@ -37,6 +37,9 @@
 #include "phApp_Init.h"			// include pHal 声明
 #include "Board_Stm32l431_Pn5180.h"
 #include "NfcrdlibEx1_DiscoveryLoop.h"  // 包含demo头文件
+#include "ram_budget.h"
+#include "boot_prof.h"
+#include "feedback.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -83,7 +86,7 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
-
+  BootProf_Start(BOOT_FAST);	/* 启动阶段计时 Boot-phase timestamps */
   /* USER CODE END 1 */
 
   /* MCU Configuration--------------------------------------------------------*/
@@ -92,14 +95,17 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-
+  BootProf_Mark(BOOT_PHASE_HAL_INIT);
   /* USER CODE END Init */
 
   /* Configure the system clock */
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
-
+  BootProf_Mark(BOOT_PHASE_CLOCK);
+#if BOOT_FAST
+  BootFast_Pn5180Reset();	/* PN5180在外设初始化期间启动 The front-end boots while the peripherals come up */
+#endif
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
@@ -110,10 +116,22 @@ int main(void)
   MX_SPI3_Init();
   MX_TIM2_Init();
   /* USER CODE BEGIN 2 */
+  BootProf_Mark(BOOT_PHASE_PERIPH);
 
   printf("Start Iskboard NFC Program v1.0\r\n");
+#if !BOOT_FAST
+  RamBudget_Report();	/* 静态RAM预算与栈水位，快速启动时在第一次轮询后打印 */
+#endif
+  BootProf_Mark(BOOT_PHASE_BANNER);
 
+#if BOOT_FAST
+  Feedback_Init();
+  Feedback_Play(FEEDBACK_BOOT);	/* 蜂鸣器响1声，由TIM7中断关闭 */
+#else
   beep_start(1, 300); 	/* 蜂鸣器响1声 */
+  Feedback_Init();
+#endif
+  BootProf_Mark(BOOT_PHASE_BEEP);
 
   /* 调用NFC Discovery功能*/
   nfc_discovery_main();
@@ -0,0 +1,321 @@
+/*
+ * mfc_dump.c
+ *
+ * MIFARE Classic full-card dump
+ * One authentication per sector, then the blocks of the sector back to back.
+ * A wrong key leaves the card in IDLE, it is brought back with WUPA + SELECT
+ * of the known UID instead of a field reset
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "mfc_dump.h"
+#include "phhalHw.h"
+#include "phApp_Init.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+
+static uint32_t MfcDump_Tick(void)
+{
+    return HAL_GetTick();
+}
+
+#else /* Host stand-in, the bench drives the millisecond tick */
+
+extern uint32_t MfcDump_HostTick(void);
+
+static uint32_t MfcDump_Tick(void)
+{
+    return MfcDump_HostTick();
+}
+
+#endif /* STM32L431xx */
+
+#define MFC_CMD_READ            0x30U
+#define MFC_KEY_INDEX_MASK      0x7FU
+
+/* Key map of one card */
+typedef struct {
+    uint8_t uid[7];
+    uint8_t uid_len;                            /* 0: entry free */
+    uint8_t sector_key[MFC_DUMP_MAX_SECTORS];
+    uint32_t last_used;
+} MfcDump_CacheEntry_t;
+
+/* State of a running dump */
+typedef struct {
+    phpalI14443p3a_Sw_DataParams_t *pPal3a;
+    phpalMifare_Sw_DataParams_t *pPalMifare;
+    uint8_t uid[7];
+    uint8_t uid_len;
+    uint8_t *auth_uid;                          /* 4 bytes used by the authentication */
+    const uint8_t (*keys)[PHPAL_MIFARE_KEY_LENGTH];
+    uint8_t key_count;
+    MfcDump_Result_t *result;
+} MfcDump_Ctx_t;
+
+static MfcDump_CacheEntry_t s_cache[MFC_DUMP_CACHE_ENTRIES];
+static uint32_t s_cache_clock;
+
+/* ================== Key cache ================== */
+
+static MfcDump_CacheEntry_t *MfcDump_CacheFind(const uint8_t *uid, uint8_t uid_len)
+{
+    for (uint8_t i = 0; i < MFC_DUMP_CACHE_ENTRIES; i++) {
+        if (s_cache[i].uid_len == uid_len && memcmp(s_cache[i].uid, uid, uid_len) == 0) {
+            s_cache[i].last_used = ++s_cache_clock;
+            return &s_cache[i];
+        }
+    }
+    return NULL;
+}
+
+/* Store the key map of a card, evicting the least recently used entry */
+static void MfcDump_CacheStore(const uint8_t *uid, uint8_t uid_len, const uint8_t *sector_key)
+{
+    MfcDump_CacheEntry_t *entry = MfcDump_CacheFind(uid, uid_len);
+
+    if (entry == NULL) {
+        entry = &s_cache[0];
+        for (uint8_t i = 1; i < MFC_DUMP_CACHE_ENTRIES && entry->uid_len != 0U; i++) {
+            if (s_cache[i].uid_len == 0U || s_cache[i].last_used < entry->last_used) {
+                entry = &s_cache[i];
+            }
+        }
+        memcpy(entry->uid, uid, uid_len);
+        entry->uid_len = uid_len;
+        entry->last_used = ++s_cache_clock;
+    }
+    memcpy(entry->sector_key, sector_key, MFC_DUMP_MAX_SECTORS);
+}
+
+void MfcDump_ClearCache(void)
+{
+    memset(s_cache, 0, sizeof(s_cache));
+    s_cache_clock = 0;
+}
+
+/* ================== Card layout ================== */
+
+uint8_t MfcDump_SectorCount(uint8_t sak)
+{
+    switch (sak & 0x1FU) {
+    case 0x09: return 5;
+    case 0x08: return 16;
+    case 0x19: return 32;
+    case 0x18: return 40;
+    default:   return 0;
+    }
+}
+
+static uint8_t MfcDump_FirstBlock(uint8_t sector)
+{
+    return (sector < 32U) ? (uint8_t)(sector * 4U) : (uint8_t)(128U + (sector - 32U) * 16U);
+}
+
+static uint8_t MfcDump_BlockCount(uint8_t sector)
+{
+    return (sector < 32U) ? 4U : 16U;
+}
+
+uint16_t MfcDump_SectorOffset(uint8_t sector)
+{
+    return (sector < 40U) ? (uint16_t)(MfcDump_FirstBlock(sector) * MFC_DUMP_BLOCK_SIZE) : 4096U;
+}
+
+/* ================== Authentication ================== */
+
+/* Bring the card back after a failed authentication: WUPA + SELECT, field reset as last resort */
+static phStatus_t MfcDump_Reactivate(MfcDump_Ctx_t *ctx)
+{
+    phStatus_t status;
+    void *pHal = ctx->pPal3a->pHalDataParams;
+    uint8_t uid_out[10];
+    uint8_t uid_out_len;
+    uint8_t sak;
+    uint8_t more;
+
+    (void)phhalHw_SetConfig(pHal, PHHAL_HW_CONFIG_DISABLE_MF_CRYPTO1, PH_ON);
+
+    ctx->result->reactivations++;
+    status = phpalI14443p3a_ActivateCard(ctx->pPal3a, ctx->uid, ctx->uid_len, uid_out, &uid_out_len, &sak, &more);
+    if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+        return PH_ERR_SUCCESS;
+    }
+
+    ctx->result->field_resets++;
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_FieldReset(pHal));
+    return phpalI14443p3a_ActivateCard(ctx->pPal3a, ctx->uid, ctx->uid_len, uid_out, &uid_out_len, &sak, &more);
+}
+
+/* One authentication attempt, the card is reactivated when it fails */
+static phStatus_t MfcDump_TryKey(MfcDump_Ctx_t *ctx, uint8_t sector, uint8_t code)
+{
+    phStatus_t status;
+    uint8_t index = code & MFC_KEY_INDEX_MASK;
+    uint8_t key_type = (code & MFC_DUMP_KEY_B) ? PHPAL_MIFARE_KEYB : PHPAL_MIFARE_KEYA;
+
+    if (index >= ctx->key_count) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_GENERIC);
+    }
+
+    ctx->result->auth_attempts++;
+    status = phpalMifare_MfcAuthenticate(ctx->pPalMifare, MfcDump_FirstBlock(sector), key_type,
+                                         (uint8_t *)ctx->keys[index], ctx->auth_uid);
+    if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+        return PH_ERR_SUCCESS;
+    }
+
+    PH_CHECK_SUCCESS_FCT(status, MfcDump_Reactivate(ctx));
+    return PH_ADD_COMPCODE_FIXED(PH_ERR_AUTH_ERROR, PH_COMP_GENERIC);
+}
+
+/*
+ * Open a sector: cached key, key of the previous sector, then the whole list with A and B.
+ * Returns the key code, MFC_DUMP_KEY_NONE, or a status through pStatus when the card is gone.
+ */
+static uint8_t MfcDump_OpenSector(MfcDump_Ctx_t *ctx, uint8_t sector, uint8_t cached, uint8_t previous,
+                                  phStatus_t *pStatus)
+{
+    uint8_t code;
+
+    *pStatus = PH_ERR_SUCCESS;
+
+    if (cached != MFC_DUMP_KEY_NONE && (cached & MFC_KEY_INDEX_MASK) < ctx->key_count) {
+        *pStatus = MfcDump_TryKey(ctx, sector, cached);
+        if ((*pStatus & PH_ERR_MASK) != PH_ERR_AUTH_ERROR) {
+            return ((*pStatus & PH_ERR_MASK) == PH_ERR_SUCCESS) ? cached : MFC_DUMP_KEY_NONE;
+        }
+    }
+    if (previous != MFC_DUMP_KEY_NONE && previous != cached) {
+        *pStatus = MfcDump_TryKey(ctx, sector, previous);
+        if ((*pStatus & PH_ERR_MASK) != PH_ERR_AUTH_ERROR) {
+            return ((*pStatus & PH_ERR_MASK) == PH_ERR_SUCCESS) ? previous : MFC_DUMP_KEY_NONE;
+        }
+    }
+
+    for (uint8_t pass = 0; pass < 2U; pass++) {
+        for (uint8_t i = 0; i < ctx->key_count; i++) {
+            code = (uint8_t)(i | (pass ? MFC_DUMP_KEY_B : 0U));
+            if (code == cached || code == previous) {
+                continue;
+            }
+            *pStatus = MfcDump_TryKey(ctx, sector, code);
+            if ((*pStatus & PH_ERR_MASK) != PH_ERR_AUTH_ERROR) {
+                return ((*pStatus & PH_ERR_MASK) == PH_ERR_SUCCESS) ? code : MFC_DUMP_KEY_NONE;
+            }
+        }
+    }
+
+    *pStatus = PH_ERR_SUCCESS;
+    return MFC_DUMP_KEY_NONE;
+}
+
+/* ================== Dump ================== */
+
+/* Read all blocks of an authenticated sector into the dump */
+static phStatus_t MfcDump_ReadSector(MfcDump_Ctx_t *ctx, uint8_t sector, uint8_t *dst)
+{
+    phStatus_t status;
+    uint8_t cmd[2];
+    uint8_t *rx;
+    uint16_t rx_len;
+    uint8_t first = MfcDump_FirstBlock(sector);
+    uint8_t blocks = MfcDump_BlockCount(sector);
+
+    cmd[0] = MFC_CMD_READ;
+    for (uint8_t b = 0; b < blocks; b++) {
+        cmd[1] = (uint8_t)(first + b);
+        PH_CHECK_SUCCESS_FCT(status, phpalMifare_ExchangeL3(ctx->pPalMifare, PH_EXCHANGE_DEFAULT, cmd, 2, &rx, &rx_len));
+        if (rx_len != MFC_DUMP_BLOCK_SIZE) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_GENERIC);
+        }
+        memcpy(&dst[b * MFC_DUMP_BLOCK_SIZE], rx, MFC_DUMP_BLOCK_SIZE);
+    }
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t MfcDump_Run(phpalI14443p3a_Sw_DataParams_t *pPal3a, phpalMifare_Sw_DataParams_t *pPalMifare,
+                       const uint8_t *uid, uint8_t uid_len, uint8_t sak,
+                       const uint8_t (*keys)[PHPAL_MIFARE_KEY_LENGTH], uint8_t key_count,
+                       uint8_t *data, uint16_t data_size, MfcDump_Result_t *result)
+{
+    phStatus_t status = PH_ERR_SUCCESS;
+    uint32_t start = MfcDump_Tick();
+    MfcDump_Ctx_t ctx;
+    MfcDump_CacheEntry_t *entry;
+    uint8_t previous = MFC_DUMP_KEY_NONE;
+    uint8_t code;
+
+    memset(result, 0, sizeof(*result));
+    memset(result->sector_key, MFC_DUMP_KEY_NONE, sizeof(result->sector_key));
+    result->sectors = MfcDump_SectorCount(sak);
+
+    if ((uid_len != 4U && uid_len != 7U) || key_count > MFC_KEY_INDEX_MASK || result->sectors == 0U ||
+        data_size < MfcDump_SectorOffset(result->sectors)) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_GENERIC);
+    }
+
+    ctx.pPal3a = pPal3a;
+    ctx.pPalMifare = pPalMifare;
+    memcpy(ctx.uid, uid, uid_len);
+    ctx.uid_len = uid_len;
+    ctx.auth_uid = (uid_len == 4U) ? &ctx.uid[0] : &ctx.uid[3];
+    ctx.keys = keys;
+    ctx.key_count = key_count;
+    ctx.result = result;
+
+    entry = MfcDump_CacheFind(uid, uid_len);
+    result->cache_hit = (entry != NULL) ? 1U : 0U;
+
+    for (uint8_t s = 0; s < result->sectors; s++) {
+        uint8_t *dst = &data[MfcDump_SectorOffset(s)];
+        uint8_t *trailer = dst + (MfcDump_BlockCount(s) - 1U) * MFC_DUMP_BLOCK_SIZE;
+
+        code = MfcDump_OpenSector(&ctx, s, (entry != NULL) ? entry->sector_key[s] : MFC_DUMP_KEY_NONE,
+                                  previous, &status);
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+            break;
+        }
+        if (code == MFC_DUMP_KEY_NONE) {
+            continue;
+        }
+        previous = code;
+
+        status = MfcDump_ReadSector(&ctx, s, dst);
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+            /* Access bits deny a block with this key, the card dropped the session */
+            PH_CHECK_SUCCESS_FCT(status, MfcDump_Reactivate(&ctx));
+            continue;
+        }
+
+        /* Keys read back as 0, put the one that is known into the image */
+        if (code & MFC_DUMP_KEY_B) {
+            memcpy(&trailer[10], keys[code & MFC_KEY_INDEX_MASK], PHPAL_MIFARE_KEY_LENGTH);
+        } else {
+            memcpy(&trailer[0], keys[code], PHPAL_MIFARE_KEY_LENGTH);
+        }
+        result->sector_key[s] = code;
+        result->sectors_read++;
+    }
+
+    if (result->sectors_read != 0U) {
+        MfcDump_CacheStore(uid, uid_len, result->sector_key);
+    }
+
+    result->elapsed_ms = MfcDump_Tick() - start;
+    DEBUG_PRINTF("MFC dump: %d/%d sectors, %u auth, %u reactivations, %lu ms%s\r\n",
+                 result->sectors_read, result->sectors, result->auth_attempts, result->reactivations,
+                 result->elapsed_ms, result->cache_hit ? " (cached keys)" : "");
+
+    if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+        return status;
+    }
+    if (result->sectors_read != result->sectors) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_AUTH_ERROR, PH_COMP_GENERIC);
+    }
+    return PH_ERR_SUCCESS;
+}
@@ -0,0 +1,382 @@
+/*
+ * mful_bulk.c
+ *
+ * MIFARE Ultralight / NTAG whole-memory reader and bulk writer
+ * Layouts are looked up from the GET_VERSION reply:
+ *   - one sector tags (Ultralight EV1, NTAG21x, NTAG I2C 1k) are read with
+ *     FAST_READ in chunks of the HAL receive buffer size
+ *   - NTAG I2C 2k continues in sector 1, reached with SECTOR_SELECT
+ *   - NTAG I2C plus additionally takes FAST_WRITE into its SRAM
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "mful_bulk.h"
+#include "phpalMifare.h"
+#include "phhalHw.h"
+#include "phApp_Init.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+#define MFUL_BULK_TICK()            HAL_GetTick()
+#else
+#define MFUL_BULK_TICK()            0U
+#endif
+
+#define MFUL_BULK_PAGE_SIZE         4U
+#define MFUL_BULK_MAX_SEGMENTS      2U
+
+/* Layout flags */
+#define MFUL_BULK_FAST_WRITE        0x01U   /* FAST_WRITE into the SRAM at 0xF0..0xFF */
+
+/* Readable pages of one sector */
+typedef struct {
+    uint8_t sector;
+    uint8_t first;
+    uint8_t last;
+} MfulBulk_Segment_t;
+
+typedef struct {
+    const char *name;
+    uint8_t version[5];                     /* GET_VERSION bytes 2..6: type, subtype, major, minor, storage size */
+    uint8_t segments;
+    MfulBulk_Segment_t segment[MFUL_BULK_MAX_SEGMENTS];
+    uint16_t user_first;                    /* Index into the dump */
+    uint16_t user_last;
+    uint8_t flags;
+} MfulBulk_Layout_t;
+
+/* User memory must be contiguous in the dump, NTAG I2C plus 2k leaves out its sector 0 configuration pages */
+static const MfulBulk_Layout_t s_layouts[] = {
+    { "MF0UL11",          { 0x03, 0x01, 0x01, 0x00, 0x0B }, 1, { { 0, 0x00, 0x13 } },                   0x04, 0x0F, 0 },
+    { "MF0UL21",          { 0x03, 0x01, 0x01, 0x00, 0x0E }, 1, { { 0, 0x00, 0x28 } },                   0x04, 0x23, 0 },
+    { "NTAG213",          { 0x04, 0x02, 0x01, 0x00, 0x0F }, 1, { { 0, 0x00, 0x2C } },                   0x04, 0x27, 0 },
+    { "NTAG215",          { 0x04, 0x02, 0x01, 0x00, 0x11 }, 1, { { 0, 0x00, 0x86 } },                   0x04, 0x81, 0 },
+    { "NTAG216",          { 0x04, 0x02, 0x01, 0x00, 0x13 }, 1, { { 0, 0x00, 0xE6 } },                   0x04, 0xE1, 0 },
+    { "NTAG I2C 1k",      { 0x04, 0x05, 0x02, 0x01, 0x13 }, 1, { { 0, 0x00, 0xE2 } },                   0x04, 0xE1, 0 },
+    { "NTAG I2C 2k",      { 0x04, 0x05, 0x02, 0x01, 0x15 }, 2, { { 0, 0x00, 0xFF }, { 1, 0x00, 0xDF } }, 0x04, 0x1DF, 0 },
+    { "NTAG I2C plus 1k", { 0x04, 0x05, 0x02, 0x02, 0x13 }, 1, { { 0, 0x00, 0xE6 } },                   0x04, 0xE1, MFUL_BULK_FAST_WRITE },
+    { "NTAG I2C plus 2k", { 0x04, 0x05, 0x02, 0x02, 0x15 }, 2, { { 0, 0x00, 0xE1 }, { 1, 0x00, 0xFF } }, 0x04, 0x1E1, MFUL_BULK_FAST_WRITE },
+};
+
+#define MFUL_BULK_LAYOUTS           (sizeof(s_layouts) / sizeof(s_layouts[0]))
+
+/* GET_VERSION result of one tag */
+typedef struct {
+    uint8_t uid[MFUL_BULK_MAX_UID];
+    uint8_t uid_len;
+    uint8_t valid;
+    uint8_t layout;                         /* Index into s_layouts */
+    uint32_t last_used;
+} MfulBulk_CacheEntry_t;
+
+static MfulBulk_CacheEntry_t s_cache[MFUL_BULK_CACHE_ENTRIES];
+static uint32_t s_cache_clock;
+
+/* Pages of a WriteRange that differ from the tag */
+static uint8_t s_dirty[(MFUL_BULK_MAX_PAGES + 7U) / 8U];
+
+/* ================== Layout cache ================== */
+
+static MfulBulk_CacheEntry_t *MfulBulk_CacheGet(const uint8_t *uid, uint8_t uid_len, uint8_t *pHit)
+{
+    MfulBulk_CacheEntry_t *victim = &s_cache[0];
+
+    for (uint8_t i = 0; i < MFUL_BULK_CACHE_ENTRIES; i++) {
+        if (s_cache[i].valid && s_cache[i].uid_len == uid_len && memcmp(s_cache[i].uid, uid, uid_len) == 0) {
+            s_cache[i].last_used = ++s_cache_clock;
+            *pHit = 1;
+            return &s_cache[i];
+        }
+        if (!s_cache[i].valid || (victim->valid && s_cache[i].last_used < victim->last_used)) {
+            victim = &s_cache[i];
+        }
+    }
+
+    /* Least recently used entry is reused, filled by MfulBulk_Learn */
+    memset(victim, 0, sizeof(*victim));
+    memcpy(victim->uid, uid, uid_len);
+    victim->uid_len = uid_len;
+    victim->last_used = ++s_cache_clock;
+    *pHit = 0;
+    return victim;
+}
+
+void MfulBulk_ClearCache(void)
+{
+    memset(s_cache, 0, sizeof(s_cache));
+    s_cache_clock = 0;
+}
+
+/* ================== Discovery ================== */
+
+/* GET_VERSION, Ultralight and Ultralight C do not answer it and are not handled */
+static phStatus_t MfulBulk_Learn(phalMful_Sw_DataParams_t *pAlMful, MfulBulk_CacheEntry_t *entry)
+{
+    phStatus_t status;
+    uint8_t version[PHAL_MFUL_VERSION_LENGTH];
+
+    PH_CHECK_SUCCESS_FCT(status, phalMful_GetVersion(pAlMful, version));
+
+    for (uint8_t i = 0; i < MFUL_BULK_LAYOUTS; i++) {
+        if (memcmp(&version[2], s_layouts[i].version, sizeof(s_layouts[i].version)) == 0) {
+            entry->layout = i;
+            entry->valid = 1;
+            return PH_ERR_SUCCESS;
+        }
+    }
+    return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_GENERIC);
+}
+
+static uint16_t MfulBulk_Pages(const MfulBulk_Layout_t *layout)
+{
+    uint16_t pages = 0;
+
+    for (uint8_t i = 0; i < layout->segments; i++) {
+        pages = (uint16_t)(pages + layout->segment[i].last - layout->segment[i].first + 1U);
+    }
+    return pages;
+}
+
+/* Segment holding dump page index, pPage gets the page address inside its sector */
+static const MfulBulk_Segment_t *MfulBulk_Locate(const MfulBulk_Layout_t *layout, uint16_t index, uint8_t *pPage)
+{
+    for (uint8_t i = 0; i < layout->segments; i++) {
+        const MfulBulk_Segment_t *seg = &layout->segment[i];
+        uint16_t count = (uint16_t)(seg->last - seg->first + 1U);
+
+        if (index < count) {
+            *pPage = (uint8_t)(seg->first + index);
+            return seg;
+        }
+        index = (uint16_t)(index - count);
+    }
+    return NULL;
+}
+
+/* Layout of the tag from the cache or GET_VERSION, fills the layout part of result */
+static phStatus_t MfulBulk_Prepare(phalMful_Sw_DataParams_t *pAlMful, const uint8_t *uid, uint8_t uid_len,
+                                   MfulBulk_Result_t *result, const MfulBulk_Layout_t **ppLayout)
+{
+    phStatus_t status;
+    MfulBulk_CacheEntry_t *entry;
+    const MfulBulk_Layout_t *layout;
+
+    memset(result, 0, sizeof(*result));
+    if (uid_len == 0U || uid_len > MFUL_BULK_MAX_UID) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_GENERIC);
+    }
+
+    entry = MfulBulk_CacheGet(uid, uid_len, &result->cache_hit);
+    if (!result->cache_hit) {
+        PH_CHECK_SUCCESS_FCT(status, MfulBulk_Learn(pAlMful, entry));
+    }
+
+    layout = &s_layouts[entry->layout];
+    result->profile = layout->name;
+    result->pages = MfulBulk_Pages(layout);
+    result->user_first = layout->user_first;
+    result->user_pages = (uint16_t)(layout->user_last - layout->user_first + 1U);
+    *ppLayout = layout;
+    return PH_ERR_SUCCESS;
+}
+
+/* ================== Transfer ================== */
+
+static phStatus_t MfulBulk_Select(phalMful_Sw_DataParams_t *pAlMful, uint8_t *pCurrent, uint8_t sector,
+                                  MfulBulk_Result_t *result)
+{
+    phStatus_t status;
+
+    if (*pCurrent == sector) {
+        return PH_ERR_SUCCESS;
+    }
+    PH_CHECK_SUCCESS_FCT(status, phalMful_SectorSelect(pAlMful, sector));
+    *pCurrent = sector;
+    result->sector_selects++;
+    return PH_ERR_SUCCESS;
+}
+
+/* Pages a FAST_READ may return, limited by the HAL receive buffer */
+static phStatus_t MfulBulk_PagesPerRead(phalMful_Sw_DataParams_t *pAlMful, uint16_t *pCount)
+{
+    phStatus_t status;
+    phpalMifare_Sw_DataParams_t *pPal = (phpalMifare_Sw_DataParams_t *)pAlMful->pPalMifareDataParams;
+    uint16_t rx_buf_size = 0;
+
+    PH_CHECK_SUCCESS_FCT(status, phhalHw_GetConfig(pPal->pHalDataParams, PHHAL_HW_CONFIG_RXBUFFER_BUFSIZE, &rx_buf_size));
+    *pCount = (rx_buf_size > MFUL_BULK_RX_OVERHEAD) ?
+              (uint16_t)((rx_buf_size - MFUL_BULK_RX_OVERHEAD) / MFUL_BULK_PAGE_SIZE) : 1U;
+    if (*pCount == 0U) {
+        *pCount = 1;
+    }
+    return PH_ERR_SUCCESS;
+}
+
+/*
+ * FAST_READ of count pages from dump index first. With dst the pages are
+ * copied, with cmp they are compared and the differing ones marked in s_dirty.
+ */
+static phStatus_t MfulBulk_ReadPages(phalMful_Sw_DataParams_t *pAlMful, const MfulBulk_Layout_t *layout,
+                                     uint16_t first, uint16_t count, uint8_t *dst, const uint8_t *cmp,
+                                     uint8_t *pSector, MfulBulk_Result_t *result)
+{
+    phStatus_t status;
+    uint16_t per_request;
+    uint16_t done = 0;
+
+    PH_CHECK_SUCCESS_FCT(status, MfulBulk_PagesPerRead(pAlMful, &per_request));
+
+    while (done < count) {
+        uint8_t page = 0;
+        const MfulBulk_Segment_t *seg = MfulBulk_Locate(layout, (uint16_t)(first + done), &page);
+        uint16_t n = (uint16_t)(count - done);
+        uint8_t *rx = NULL;
+        uint16_t rx_len = 0;
+
+        if (seg == NULL) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_GENERIC);
+        }
+        if (n > (uint16_t)(seg->last - page + 1U)) {
+            n = (uint16_t)(seg->last - page + 1U);
+        }
+        if (n > per_request) {
+            n = per_request;
+        }
+
+        PH_CHECK_SUCCESS_FCT(status, MfulBulk_Select(pAlMful, pSector, seg->sector, result));
+        PH_CHECK_SUCCESS_FCT(status, phalMful_FastRead(pAlMful, page, (uint8_t)(page + n - 1U), &rx, &rx_len));
+        result->requests++;
+        if (rx_len != n * MFUL_BULK_PAGE_SIZE) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_GENERIC);
+        }
+
+        if (dst != NULL) {
+            memcpy(&dst[done * MFUL_BULK_PAGE_SIZE], rx, rx_len);
+        } else {
+            for (uint16_t i = 0; i < n; i++) {
+                uint16_t idx = (uint16_t)(done + i);
+
+                if (memcmp(&rx[i * MFUL_BULK_PAGE_SIZE], &cmp[idx * MFUL_BULK_PAGE_SIZE], MFUL_BULK_PAGE_SIZE) != 0) {
+                    s_dirty[idx >> 3] |= (uint8_t)(1U << (idx & 7U));
+                }
+            }
+        }
+        done = (uint16_t)(done + n);
+    }
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t MfulBulk_ReadAll(phalMful_Sw_DataParams_t *pAlMful, const uint8_t *uid, uint8_t uid_len,
+                            uint8_t *data, uint16_t data_size, MfulBulk_Result_t *result)
+{
+    phStatus_t status;
+    uint32_t start = MFUL_BULK_TICK();
+    const MfulBulk_Layout_t *layout = NULL;
+    uint8_t sector = 0;
+    uint16_t total;
+
+    PH_CHECK_SUCCESS_FCT(status, MfulBulk_Prepare(pAlMful, uid, uid_len, result, &layout));
+
+    total = result->pages;
+    if ((uint32_t)total * MFUL_BULK_PAGE_SIZE > data_size) {
+        total = (uint16_t)(data_size / MFUL_BULK_PAGE_SIZE);
+    }
+
+    status = MfulBulk_ReadPages(pAlMful, layout, 0, total, data, NULL, &sector, result);
+    if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+        result->bytes = (uint16_t)(total * MFUL_BULK_PAGE_SIZE);
+    }
+
+    /* Sector 0 again for the next command and phalTop */
+    if (sector != 0U) {
+        phStatus_t restore = MfulBulk_Select(pAlMful, &sector, 0, result);
+        if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+            status = restore;
+        }
+    }
+
+    result->elapsed_ms = MFUL_BULK_TICK() - start;
+    DEBUG_PRINTF("MFUL dump: %s, %u bytes (%u pages), %u requests, %u sector selects, %lu ms%s\r\n",
+                 result->profile, result->bytes, result->pages, result->requests, result->sector_selects,
+                 (unsigned long)result->elapsed_ms, result->cache_hit ? " (cached layout)" : "");
+
+    return ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) ? PH_ERR_SUCCESS : status;
+}
+
+phStatus_t MfulBulk_WriteRange(phalMful_Sw_DataParams_t *pAlMful, const uint8_t *uid, uint8_t uid_len,
+                               uint16_t page, const uint8_t *data, uint16_t len, MfulBulk_Result_t *result)
+{
+    phStatus_t status;
+    uint32_t start = MFUL_BULK_TICK();
+    const MfulBulk_Layout_t *layout = NULL;
+    uint8_t sector = 0;
+    uint16_t count = (uint16_t)(len / MFUL_BULK_PAGE_SIZE);
+
+    PH_CHECK_SUCCESS_FCT(status, MfulBulk_Prepare(pAlMful, uid, uid_len, result, &layout));
+
+    if ((len % MFUL_BULK_PAGE_SIZE) != 0U || count == 0U || page < layout->user_first ||
+        (uint32_t)page + count - 1U > layout->user_last) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_GENERIC);
+    }
+
+    memset(s_dirty, 0, sizeof(s_dirty));
+    status = MfulBulk_ReadPages(pAlMful, layout, page, count, NULL, data, &sector, result);
+
+    for (uint16_t i = 0; i < count && (status & PH_ERR_MASK) == PH_ERR_SUCCESS; i++) {
+        uint8_t addr = 0;
+        const MfulBulk_Segment_t *seg;
+
+        if ((s_dirty[i >> 3] & (1U << (i & 7U))) == 0U) {
+            result->pages_skipped++;
+            continue;
+        }
+        seg = MfulBulk_Locate(layout, (uint16_t)(page + i), &addr);
+        status = MfulBulk_Select(pAlMful, &sector, seg->sector, result);
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS) {
+            break;
+        }
+        status = phalMful_Write(pAlMful, addr, (uint8_t *)&data[i * MFUL_BULK_PAGE_SIZE]);
+        result->requests++;
+        if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+            result->pages_written++;
+        }
+    }
+
+    if (sector != 0U) {
+        phStatus_t restore = MfulBulk_Select(pAlMful, &sector, 0, result);
+        if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+            status = restore;
+        }
+    }
+
+    result->elapsed_ms = MFUL_BULK_TICK() - start;
+    DEBUG_PRINTF("MFUL write: %s, %u pages written, %u unchanged, %u requests, %lu ms\r\n",
+                 result->profile, result->pages_written, result->pages_skipped, result->requests,
+                 (unsigned long)result->elapsed_ms);
+
+    return ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) ? PH_ERR_SUCCESS : status;
+}
+
+phStatus_t MfulBulk_WriteSram(phalMful_Sw_DataParams_t *pAlMful, const uint8_t *uid, uint8_t uid_len,
+                              const uint8_t *data, MfulBulk_Result_t *result)
+{
+    phStatus_t status;
+    uint32_t start = MFUL_BULK_TICK();
+    const MfulBulk_Layout_t *layout = NULL;
+
+    PH_CHECK_SUCCESS_FCT(status, MfulBulk_Prepare(pAlMful, uid, uid_len, result, &layout));
+    if ((layout->flags & MFUL_BULK_FAST_WRITE) == 0U) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_GENERIC);
+    }
+
+    status = phalMful_FastWrite(pAlMful, (uint8_t *)data);
+    result->requests = 1;
+    if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS) {
+        result->bytes = MFUL_BULK_SRAM_SIZE;
+    }
+    result->elapsed_ms = MFUL_BULK_TICK() - start;
+    return status;
+}
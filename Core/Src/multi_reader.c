@@ -0,0 +1,286 @@
+/*
+ * multi_reader.c
+ *
+ * Several PN5180 front-ends on one MCU
+ * Each reader has its own NFC library instance, discovery is interleaved
+ * across the readers on the shared SPI bus
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "multi_reader.h"
+#include "phApp_Init.h"
+
+#if defined(STM32L431xx)
+#include "main.h"
+
+static uint32_t MultiReader_Tick(void)
+{
+    return HAL_GetTick();
+}
+
+#else /* Host stand-in, the bench drives the millisecond tick */
+
+extern uint32_t MultiReader_HostTick(void);
+
+static uint32_t MultiReader_Tick(void)
+{
+    return MultiReader_HostTick();
+}
+
+#endif /* STM32L431xx */
+
+/* Discovery loop of the selected reader, defined in NfcrdlibEx1_DiscoveryLoop.c */
+extern phacDiscLoop_Sw_DataParams_t *pDiscLoop;
+
+/* ================== Reader state ================== */
+
+typedef enum {
+    MULTI_READER_IDLE = 0,                  /* Field off */
+    MULTI_READER_GUARD,                     /* Field on, guard time running */
+    MULTI_READER_WUPA                       /* WUPA sent, answer or timeout pending */
+} MultiReader_State_t;
+
+typedef struct {
+    uint32_t field_off_tick;
+    uint32_t deadline;
+    uint8_t state;
+} MultiReader_Ctx_t;
+
+/* BAL of each reader */
+static phbalReg_Type_t s_bal[MULTI_READER_COUNT];
+static MultiReader_Ctx_t s_ctx[MULTI_READER_COUNT];
+static uint8_t s_ready_mask;
+static uint32_t s_round;
+
+phStatus_t MultiReader_Select(uint8_t reader)
+{
+    if (reader >= MULTI_READER_COUNT) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_GENERIC);
+    }
+    if (phNfcLib_SelectReader(reader) != PH_NFCLIB_STATUS_SUCCESS) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_GENERIC);
+    }
+
+    /* Demo code works on these globals */
+    pHal = phNfcLib_GetDataParams(PH_COMP_HAL);
+    pDiscLoop = phNfcLib_GetDataParams(PH_COMP_AC_DISCLOOP);
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t MultiReader_Init(void)
+{
+    phNfcLib_AppContext_t AppContext = {0};
+    phStatus_t status = PH_ERR_SUCCESS;
+
+    s_ready_mask = 0;
+    s_round = 0;
+
+    for (uint8_t i = 0; i < MULTI_READER_COUNT; i++) {
+        if (phNfcLib_SelectReader(i) != PH_NFCLIB_STATUS_SUCCESS) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_GENERIC);
+        }
+
+        status = phbalReg_Init(&s_bal[i], sizeof(phbalReg_Type_t));
+        if (status != PH_ERR_SUCCESS) break;
+
+        /* NSS/BUSY/RST/IRQ and SPI bus of this reader */
+        status = phbalReg_SetConfig(&s_bal[i], PHBAL_CONFIG_READER, i);
+        if (status != PH_ERR_SUCCESS) break;
+
+        AppContext.pBalDataparams = &s_bal[i];
+        if (phNfcLib_SetContext(&AppContext) != PH_NFCLIB_STATUS_SUCCESS ||
+            phNfcLib_Init() != PH_NFCLIB_STATUS_SUCCESS) {
+            DEBUG_PRINTF("Reader %d: NFC library init failed\r\n", i);
+            status = PH_ADD_COMPCODE_FIXED(PH_ERR_INTERNAL_ERROR, PH_COMP_GENERIC);
+            break;
+        }
+
+        status = phApp_Comp_Init(phNfcLib_GetDataParams(PH_COMP_AC_DISCLOOP));
+        if (status != PH_ERR_SUCCESS) break;
+
+        (void)phhalHw_FieldOff(phNfcLib_GetDataParams(PH_COMP_HAL));
+        s_ctx[i].field_off_tick = MultiReader_Tick();
+        s_ctx[i].state = MULTI_READER_IDLE;
+        s_ready_mask |= (uint8_t)(1U << i);
+
+        DEBUG_PRINTF("Reader %d ready\r\n", i);
+    }
+
+    (void)MultiReader_Select(0);
+    return status;
+}
+
+/* ================== Polling ================== */
+
+static uint8_t MultiReader_Due(uint32_t now, uint32_t deadline)
+{
+    return ((int32_t)(now - deadline) >= 0) ? 1U : 0U;
+}
+
+/* Field off on the selected reader, its recovery time starts now */
+static void MultiReader_Off(uint8_t reader)
+{
+    (void)phhalHw_FieldOff(pHal);
+    s_ctx[reader].field_off_tick = MultiReader_Tick();
+    s_ctx[reader].state = MULTI_READER_IDLE;
+}
+
+/* Reader may start a poll, its field has been off long enough to reset the cards */
+static uint8_t MultiReader_Rested(uint8_t reader)
+{
+    if (!(s_ready_mask & (1U << reader))) {
+        return 0;
+    }
+    return MultiReader_Due(MultiReader_Tick(), s_ctx[reader].field_off_tick + MULTI_READER_FIELD_OFF_MS);
+}
+
+/* Full discovery loop on the selected reader, ends with the field off */
+static uint32_t MultiReader_Discover(uint8_t reader, MultiReader_CardFn_t card_fn)
+{
+    phStatus_t status;
+    uint32_t found = 0;
+
+    (void)phacDiscLoop_SetConfig(pDiscLoop, PHAC_DISCLOOP_CONFIG_NEXT_POLL_STATE, PHAC_DISCLOOP_POLL_STATE_DETECTION);
+    status = phacDiscLoop_Run(pDiscLoop, PHAC_DISCLOOP_ENTRY_POINT_POLL);
+
+    if ((status & PH_ERR_MASK) == PHAC_DISCLOOP_DEVICE_ACTIVATED) {
+        found = 1U << reader;
+        if (card_fn != NULL) {
+            card_fn(reader, pDiscLoop, status);
+        }
+    }
+
+    MultiReader_Off(reader);
+    return found;
+}
+
+/* Type A settings and field on, the guard time runs from here */
+static phStatus_t MultiReader_FieldOn(uint8_t reader)
+{
+    phStatus_t status;
+
+    status = phhalHw_ApplyProtocolSettings(pHal, PHHAL_HW_CARDTYPE_ISO14443A);
+    if (status == PH_ERR_SUCCESS) {
+        status = phhalHw_FieldOn(pHal);
+    }
+    s_ctx[reader].deadline = MultiReader_Tick() + MULTI_READER_GUARD_MS;
+    s_ctx[reader].state = MULTI_READER_GUARD;
+    return status;
+}
+
+/* WUPA without waiting for the answer, the HAL signals the end on the IRQ pin */
+static phStatus_t MultiReader_SendWupa(uint8_t reader)
+{
+    phStatus_t status;
+    uint8_t cmd = 0x52U;
+
+    status = phhalHw_SetConfig(pHal, PHHAL_HW_CONFIG_TIMEOUT_VALUE_US, MULTI_READER_ATQA_US);
+    if (status == PH_ERR_SUCCESS) {
+        status = phhalHw_SetConfig(pHal, PHHAL_HW_CONFIG_TXCRC, PH_OFF);
+    }
+    if (status == PH_ERR_SUCCESS) {
+        status = phhalHw_SetConfig(pHal, PHHAL_HW_CONFIG_RXCRC, PH_OFF);
+    }
+    if (status == PH_ERR_SUCCESS) {
+        status = phhalHw_SetConfig(pHal, PHHAL_HW_CONFIG_TXLASTBITS, 7U);
+    }
+    if (status == PH_ERR_SUCCESS) {
+        /* An edge left over from the previous command must not complete this one early */
+        (void)phDriver_ReaderIrqPending(reader);
+        status = phhalHw_ExchangeSubmit(pHal, PH_EXCHANGE_DEFAULT, &cmd, 1U);
+    }
+    s_ctx[reader].deadline = MultiReader_Tick() + MULTI_READER_IRQ_MS;
+    s_ctx[reader].state = MULTI_READER_WUPA;
+    return status;
+}
+
+static uint32_t MultiReader_FullRound(MultiReader_CardFn_t card_fn)
+{
+    uint32_t found = 0;
+
+    for (uint8_t i = 0; i < MULTI_READER_COUNT; i++) {
+        if (!MultiReader_Rested(i) || MultiReader_Select(i) != PH_ERR_SUCCESS) {
+            continue;
+        }
+        found |= MultiReader_Discover(i, card_fn);
+    }
+    return found;
+}
+
+uint32_t MultiReader_PollRound(MultiReader_CardFn_t card_fn)
+{
+    phStatus_t status;
+    uint8_t *rx;
+    uint16_t rx_len;
+    uint32_t busy = 0;                      /* Readers with a WUPA probe in progress */
+    uint32_t seen = 0;                      /* Readers that got an answer */
+    uint32_t found = 0;
+    uint32_t now;
+
+    s_round++;
+    if ((s_round % MULTI_READER_FULL_POLL_ROUNDS) == 0U) {
+        return MultiReader_FullRound(card_fn);
+    }
+
+    /* Every rested reader switches its field on before anyone waits */
+    for (uint8_t i = 0; i < MULTI_READER_COUNT; i++) {
+        if (!MultiReader_Rested(i) || MultiReader_Select(i) != PH_ERR_SUCCESS) {
+            continue;
+        }
+        if (MultiReader_FieldOn(i) == PH_ERR_SUCCESS) {
+            busy |= 1U << i;
+        } else {
+            MultiReader_Off(i);
+        }
+    }
+
+    /* Service whichever reader is due: guard time over, or its IRQ went off */
+    while (busy != 0U) {
+        for (uint8_t i = 0; i < MULTI_READER_COUNT; i++) {
+            if (!(busy & (1U << i))) {
+                continue;
+            }
+            now = MultiReader_Tick();
+            if (s_ctx[i].state == MULTI_READER_GUARD) {
+                if (!MultiReader_Due(now, s_ctx[i].deadline) || MultiReader_Select(i) != PH_ERR_SUCCESS) {
+                    continue;
+                }
+                if (MultiReader_SendWupa(i) != PH_ERR_SUCCESS) {
+                    MultiReader_Off(i);
+                    busy &= ~(1U << i);
+                }
+                continue;
+            }
+
+            if (!phDriver_ReaderIrqPending(i) && !MultiReader_Due(now, s_ctx[i].deadline)) {
+                continue;
+            }
+            if (MultiReader_Select(i) != PH_ERR_SUCCESS) {
+                continue;
+            }
+            status = phhalHw_ExchangePoll(pHal, &rx, &rx_len);
+            if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS_PENDING) {
+                continue;
+            }
+            busy &= ~(1U << i);
+
+            /* ATQA, or several cards answering at once */
+            if ((status & PH_ERR_MASK) != PH_ERR_IO_TIMEOUT) {
+                seen |= 1U << i;
+            } else {
+                MultiReader_Off(i);
+            }
+        }
+    }
+
+    /* Activation only where a card is in the field */
+    for (uint8_t i = 0; i < MULTI_READER_COUNT; i++) {
+        if ((seen & (1U << i)) && MultiReader_Select(i) == PH_ERR_SUCCESS) {
+            found |= MultiReader_Discover(i, card_fn);
+        }
+    }
+
+    return found;
+}
@@ -0,0 +1,909 @@
+/*
+ * orig_check.c
+ *
+ * NXP originality signature check with fixed-base comb tables
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "orig_check.h"
+#include <ph_RefDefs.h>
+#include <string.h>
+
+/* ================== Curves ================== */
+
+#define OC_WORDS_MAX        7U      /* secp224r1 */
+#define OC_TEETH            4U      /* Comb width of the stored tables */
+#define OC_TABLE_POINTS     ((1U << OC_TEETH) - 1U)
+
+/* Big endian constants, a = -3 on both curves */
+typedef struct {
+    uint8_t len;                    /* Bytes of p and n */
+    uint8_t words;
+    const uint8_t *p;
+    const uint8_t *b;
+    const uint8_t *n;
+    const uint32_t *tab_g;          /* Comb table of G */
+} OC_CurveDef_t;
+
+static const uint8_t s_p128[16] = {
+    0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+static const uint8_t s_b128[16] = {
+    0xE8, 0x75, 0x79, 0xC1, 0x10, 0x79, 0xF4, 0x3D, 0xD8, 0x24, 0x99, 0x3C, 0x2C, 0xEE, 0x5E, 0xD3
+};
+static const uint8_t s_n128[16] = {
+    0xFF, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x75, 0xA3, 0x0D, 0x1B, 0x90, 0x38, 0xA1, 0x15
+};
+static const uint8_t s_g128[33] = {
+    0x04,
+    0x16, 0x1F, 0xF7, 0x52, 0x8B, 0x89, 0x9B, 0x2D, 0x0C, 0x28, 0x60, 0x7C, 0xA5, 0x2C, 0x5B, 0x86,
+    0xCF, 0x5A, 0xC8, 0x39, 0x5B, 0xAF, 0xEB, 0x13, 0xC0, 0x2D, 0xA2, 0x92, 0xDD, 0xED, 0x7A, 0x83
+};
+
+static const uint8_t s_p224[28] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+};
+static const uint8_t s_b224[28] = {
+    0xB4, 0x05, 0x0A, 0x85, 0x0C, 0x04, 0xB3, 0xAB, 0xF5, 0x41, 0x32, 0x56, 0x50, 0x44, 0xB0, 0xB7,
+    0xD7, 0xBF, 0xD8, 0xBA, 0x27, 0x0B, 0x39, 0x43, 0x23, 0x55, 0xFF, 0xB4
+};
+static const uint8_t s_n224[28] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x16, 0xA2,
+    0xE0, 0xB8, 0xF0, 0x3E, 0x13, 0xDD, 0x29, 0x45, 0x5C, 0x5C, 0x2A, 0x3D
+};
+static const uint8_t s_g224[57] = {
+    0x04,
+    0xB7, 0x0E, 0x0C, 0xBD, 0x6B, 0xB4, 0xBF, 0x7F, 0x32, 0x13, 0x90, 0xB9, 0x4A, 0x03, 0xC1, 0xD3,
+    0x56, 0xC2, 0x11, 0x22, 0x34, 0x32, 0x80, 0xD6, 0x11, 0x5C, 0x1D, 0x21,
+    0xBD, 0x37, 0x63, 0x88, 0xB5, 0xF7, 0x23, 0xFB, 0x4C, 0x22, 0xDF, 0xE6, 0xCD, 0x43, 0x75, 0xA0,
+    0x5A, 0x07, 0x47, 0x64, 0x44, 0xD5, 0x81, 0x99, 0x85, 0x00, 0x7E, 0x34
+};
+
+/* NXP originality keys, Ultralight EV1 / NTAG21x (AN11350), ICODE SLIX2 / DNA and NTAG 424 DNA (AN12196) */
+static const uint8_t s_key_mful[33] = {
+    0x04,
+    0x49, 0x4E, 0x1A, 0x38, 0x6D, 0x3D, 0x3C, 0xFE, 0x3D, 0xC1, 0x0E, 0x5D, 0xE6, 0x8A, 0x49, 0x9B,
+    0x1C, 0x20, 0x2D, 0xB5, 0xB1, 0x32, 0x39, 0x3E, 0x89, 0xED, 0x19, 0xFE, 0x5B, 0xE8, 0xBC, 0x61
+};
+static const uint8_t s_key_icode[33] = {
+    0x04,
+    0x88, 0x78, 0xA2, 0xA2, 0xD3, 0xEE, 0xC3, 0x36, 0xB4, 0xF2, 0x61, 0xA0, 0x82, 0xBD, 0x71, 0xF9,
+    0xBE, 0x11, 0xC4, 0xE2, 0xE8, 0x96, 0x64, 0x8B, 0x32, 0xEF, 0xA5, 0x9C, 0xEA, 0x6E, 0x59, 0xF0
+};
+static const uint8_t s_key_ntag42x[57] = {
+    0x04,
+    0x8A, 0x9B, 0x38, 0x0A, 0xF2, 0xEE, 0x1B, 0x98, 0xDC, 0x41, 0x7F, 0xEC, 0xC2, 0x63, 0xF8, 0x44,
+    0x9C, 0x76, 0x25, 0xCE, 0xCE, 0x82, 0xD9, 0xB9, 0x16, 0xC9, 0x92, 0xDA,
+    0x20, 0x9D, 0x68, 0x42, 0x2B, 0x81, 0xEC, 0x20, 0xB6, 0x5A, 0x66, 0xB5, 0x10, 0x2A, 0x61, 0x59,
+    0x6A, 0xF3, 0x37, 0x92, 0x00, 0x59, 0x93, 0x16, 0xA0, 0x0A, 0x14, 0x10
+};
+
+/*
+ * Comb tables: entry j - 1 = sum of 2^(i*d) * P over the set bits i of j,
+ * d = bits / OC_TEETH, affine X then Y, Montgomery form, little endian words.
+ * OrigCheck_SelfTest recomputes them with OC_BuildTable.
+ */
+static const uint32_t s_tab_g128[OC_TABLE_POINTS][2 * 4] = {
+    { 0x9CA343C9U, 0x7BBB7421U, 0xB7C989D2U, 0x4F667EE4U, 0x47DEADD0U, 0xB4F899A6U, 0xFA657B89U, 0x5F1823DAU },
+    { 0x70A66287U, 0x051E0FADU, 0xD47E0859U, 0x0C217839U, 0x5EE30ED8U, 0xCA6B2236U, 0x20ED340BU, 0x97C8310DU },
+    { 0xC5A63A46U, 0xD18CC0DBU, 0x600A069FU, 0x89C666FCU, 0x545F3828U, 0xD3616028U, 0x6C63C8F1U, 0x20EF83B7U },
+    { 0x913576E1U, 0xA8479BF8U, 0xA69B54FBU, 0xAD247E41U, 0x996AD951U, 0x151684F5U, 0x6A8152DDU, 0x2D0574D7U },
+    { 0x5A52FB32U, 0x39B9B671U, 0x2FA44261U, 0x3E95226EU, 0x5CE1FD7BU, 0xCB77F97EU, 0xB0214FF8U, 0xB0280B5DU },
+    { 0x27287995U, 0x0B9924D8U, 0xCA544A88U, 0x2EA55C43U, 0xE8F4F692U, 0x9CE31354U, 0xBF2E9D40U, 0x5267ADEEU },
+    { 0x3C8F8FC3U, 0x05749890U, 0x2B6EF296U, 0x9EFD4AE2U, 0x8AF1A9DDU, 0x96E96FC3U, 0xF94A3B96U, 0xB83F801FU },
+    { 0x1629031FU, 0x950A6632U, 0x68487361U, 0x6CE1BA95U, 0xDACEF4D7U, 0x6F558825U, 0x98F06685U, 0x503C661EU },
+    { 0x5332BB6AU, 0xBE9C33B4U, 0xC6D3965BU, 0x727EF0D2U, 0x3D055534U, 0xA3CA79AAU, 0x798BEBFBU, 0x53BED682U },
+    { 0xECB612F4U, 0xD3231A19U, 0x15720BC1U, 0xE41D09C0U, 0xB8052D09U, 0xF44EBCEEU, 0x24C454EEU, 0xC9D649B9U },
+    { 0x4D9A0238U, 0xA53A83A9U, 0x55A57B4FU, 0xF55B6C7FU, 0x10FC0053U, 0xD5A056A3U, 0xB6F61D9EU, 0x7ABC5AF7U },
+    { 0xAFAB379CU, 0x88A86E6AU, 0x96B07F7BU, 0x5C714B0AU, 0xD0C8438EU, 0x9A07DEC4U, 0xC57A2523U, 0xA924A4D2U },
+    { 0x1B418358U, 0x35278C14U, 0xEA369185U, 0xC38F972BU, 0x6ECEAB51U, 0xEAC23819U, 0x6C2CF7F1U, 0x1C98E02FU },
+    { 0xD8921E8AU, 0x9194425CU, 0xBE9A810CU, 0x620E1212U, 0x3083BD7CU, 0x93700FE5U, 0x84734490U, 0xB19E542EU },
+    { 0xB5C958EFU, 0xD977F5B3U, 0x600C7E11U, 0x127BD275U, 0x2D883AA0U, 0x876B1851U, 0xD038D6C5U, 0xBA1DAFADU },
+};
+
+static const uint32_t s_tab_mful[OC_TABLE_POINTS][2 * 4] = {
+    { 0x61722C18U, 0x3D73F13EU, 0xFFD97170U, 0x0C327268U, 0x158D4307U, 0x5CD24353U, 0xE97294AAU, 0x473AB3C3U },
+    { 0x524233A2U, 0x97DCBE4EU, 0x1B4295A4U, 0xC3134CF1U, 0xD22DCAF6U, 0xD89ADBDEU, 0x5A09CD0DU, 0xBC178651U },
+    { 0x365DFDF1U, 0x42412135U, 0x2FB4EFB9U, 0x704EBC32U, 0x9700260FU, 0x8CBDE4C1U, 0x6ABA4752U, 0xF497EA99U },
+    { 0x7E9F9C28U, 0x1BF4B0BCU, 0xA78C81D9U, 0x2A801F5CU, 0xC8BEDA3CU, 0x91682AA6U, 0xE4C61741U, 0x0954A8DCU },
+    { 0xD16E1DCEU, 0x0669F26FU, 0xA62C7B89U, 0x29D5EC43U, 0xCE1BFCACU, 0xFEAB7E6AU, 0x4B382CA2U, 0x34CB0E62U },
+    { 0xCD52E53BU, 0x5411C79CU, 0xC19D9FF9U, 0x982C5F91U, 0xA19F9CEAU, 0x3B592D92U, 0x1A2D5343U, 0x361A6AD3U },
+    { 0xB6B29328U, 0x2982BD34U, 0x77AF678AU, 0x0AB15D22U, 0xEA87C027U, 0x7BC8FA0AU, 0x78954DF7U, 0xB7F8F1CDU },
+    { 0x21DCBDAEU, 0x9F6E19CCU, 0xB4DB29B1U, 0xF5EA57ADU, 0x703351D9U, 0x4B7165DAU, 0x3B9172E0U, 0x4748E949U },
+    { 0x6754AFE5U, 0x79DA8010U, 0x17C46BF0U, 0x482918EAU, 0xDA58E618U, 0xB70407FBU, 0x42E28D27U, 0x51F47724U },
+    { 0x835A3AC5U, 0xD8489E14U, 0x0ED76078U, 0xF157AB44U, 0x641CC54AU, 0xBF4EA846U, 0xA875C02DU, 0x48EF300EU },
+    { 0xBC50FA80U, 0xA40D0BCEU, 0x5FC75297U, 0x3700E26EU, 0x158B2F1EU, 0x9A507DD4U, 0xC57AAE94U, 0xF2856D3CU },
+    { 0x7DCA2FCCU, 0xBC31285BU, 0xB9B5ECB8U, 0x67424EB2U, 0xA9A94339U, 0xFB5D0744U, 0x805903B7U, 0xCD7FAE06U },
+    { 0x9EA66506U, 0x1114195FU, 0x5F60D39AU, 0xCAFCBFF4U, 0x73DFE771U, 0x86CA9A61U, 0x26B5CEB2U, 0x2542BABDU },
+    { 0x984603ADU, 0x5507FC8CU, 0xC4CB738FU, 0x7FFDC792U, 0xE0CF7F73U, 0x364A9435U, 0x683CDF9FU, 0x4D9698DCU },
+    { 0x853B19FDU, 0xDB464BA7U, 0xE0846882U, 0x2CE76052U, 0x1527F126U, 0x82B9A08AU, 0x8C722BABU, 0xE4FF8ABFU },
+};
+
+static const uint32_t s_tab_icode[OC_TABLE_POINTS][2 * 4] = {
+    { 0x80225734U, 0x7EB2729DU, 0xE4E0087EU, 0x88BD510BU, 0xE3355E7AU, 0xFC638244U, 0x64B9EE53U, 0x847C81D8U },
+    { 0x838F2B9BU, 0xA5295867U, 0x38BF93CCU, 0x4EECEF89U, 0x7BB2E788U, 0x6BBDC40EU, 0xFABCDC9AU, 0x6192E7BEU },
+    { 0x6635B81EU, 0xB9341959U, 0xBCE5B815U, 0x9DD92B0CU, 0x050C1B09U, 0x606AE395U, 0x139466B7U, 0xBE30C1C0U },
+    { 0x8221F9FCU, 0x82DA8ACDU, 0x38B66EDAU, 0xB1E9E979U, 0xDA221B30U, 0xCB4D58C5U, 0x7C41848BU, 0x1AF84E75U },
+    { 0x2464423DU, 0xB90A9B3EU, 0xCE810420U, 0x461FAB2AU, 0xD70D935AU, 0x3C5C2A00U, 0xBDDE9BB6U, 0x39D5FDA5U },
+    { 0x8AAFF5C0U, 0x88F24417U, 0x5BD69E91U, 0x73488391U, 0x0D1A9246U, 0x12E298D3U, 0x4894CA61U, 0x86AC4290U },
+    { 0x45CF4869U, 0x5E17CCF7U, 0xE4753191U, 0x90114088U, 0xFD7CD341U, 0x4733F3FFU, 0x23A1C00AU, 0xD95B85D2U },
+    { 0x8CA1FF34U, 0x17C99490U, 0x6E425760U, 0x9949C31CU, 0x9C9FD242U, 0x867C5134U, 0x0D0FBF9BU, 0x9750E011U },
+    { 0x6367BB94U, 0x4F2DD933U, 0xA931C1CBU, 0x9D758AB5U, 0x1989365AU, 0xFCEC7BA1U, 0x18BC5476U, 0x3AFB1212U },
+    { 0xAE47CD7FU, 0x88707660U, 0x51BED11BU, 0xCD44A3CBU, 0xCDBF2D11U, 0xD46D4F5BU, 0x180037A8U, 0xDEE5A2C6U },
+    { 0xB557E525U, 0x1481E41EU, 0x59FF239AU, 0x40D0F6BFU, 0x7BA3122BU, 0x018BD0ABU, 0x441FD01AU, 0xEEF95ADCU },
+    { 0xE1549876U, 0x2DBF9FBCU, 0xFD0E6E08U, 0x93F8D658U, 0xD2118718U, 0xE8892258U, 0x1B5FB113U, 0x460CDBC7U },
+    { 0x3617C434U, 0x7A32D8EFU, 0x71D2C5FCU, 0x2FA99C51U, 0xDC8E3BC7U, 0x523B53D5U, 0x0C147B26U, 0x93479DEBU },
+    { 0x33E92293U, 0x10D202E2U, 0x230672FFU, 0x296BF683U, 0x823A5447U, 0xC00CEC52U, 0x39C210C9U, 0xF3F8C74DU },
+    { 0x6823A2CCU, 0xF9B53719U, 0x3955286EU, 0x3BAAC4DCU, 0xF0400A7DU, 0x01C9AB58U, 0x449DC6FCU, 0xFF50DDCCU },
+};
+
+static const uint32_t s_tab_g224[OC_TABLE_POINTS][2 * 7] = {
+    { 0xBC905227U, 0x6018BFAAU, 0xF22FE220U, 0xF96BEC04U, 0x6DD3AF9BU, 0xA21B5E60U, 0x92F5B516U,
+      0x2EDCA1E6U, 0x05335A6BU, 0xE8C15513U, 0x03DFE878U, 0xAEA9C5AEU, 0x614786F1U, 0x100C1218U },
+    { 0x56B1B68DU, 0xA766A468U, 0x7A690380U, 0x7F0A8CCBU, 0x15B9CE0DU, 0x8BFB375DU, 0x0AFA00F6U,
+      0xE7944B6BU, 0xE502FD6AU, 0x0768EBCAU, 0x079AC7ACU, 0x956DEA42U, 0x3FC3F258U, 0x78BE0F9AU },
+    { 0x88FEB57BU, 0x4BEB7981U, 0x24067FC4U, 0xECC1F4E5U, 0xCA70CAAFU, 0x19523824U, 0x9B6288C7U,
+      0xDA4A9304U, 0x8F04493DU, 0xEE8D204BU, 0x75C8C108U, 0x38967032U, 0x8068C883U, 0x53393238U },
+    { 0xA72D343CU, 0x006AFF79U, 0xD1D45AC5U, 0x1EC739C8U, 0x136D5BA5U, 0xCE9CE64BU, 0x3571E770U,
+      0xB11EA221U, 0x7BFE943DU, 0x6D87FBD7U, 0x57DAD905U, 0xAC86BD3FU, 0x5EEBA8A6U, 0x8DEF8E05U },
+    { 0x92A60569U, 0xB48FC676U, 0x6C444ABEU, 0xA4A8F236U, 0x193554B7U, 0x1D361164U, 0x3585B1A2U,
+      0x2963485FU, 0xF65ADBC4U, 0x54608B7EU, 0x2DF5763AU, 0x1D2E4859U, 0x92994983U, 0x5668C076U },
+    { 0x9A559F12U, 0x6C0B73ECU, 0xB91B3046U, 0x4A05C0D0U, 0x54BD5797U, 0xC2727383U, 0x5812EBC0U,
+      0xB94ED4BAU, 0x2561E55AU, 0x1322E974U, 0x1C314D4AU, 0x46C39C83U, 0xFEFAD1C8U, 0x0B84656AU },
+    { 0xA8AABF96U, 0x3ABB176FU, 0xED47BB12U, 0xCBD86F4DU, 0x381125C6U, 0x08BFFAEEU, 0x656C1D88U,
+      0x693216ECU, 0xE40A1C34U, 0x866BD462U, 0x5A441B57U, 0xAFEE4856U, 0x58E31906U, 0x3E21E8D4U },
+    { 0x1AA93495U, 0x07822BD8U, 0x98675E63U, 0x690A044FU, 0x411C39E9U, 0xDDFD5A23U, 0x768594DAU,
+      0x5D8DA0B0U, 0x74DCEC38U, 0x3C14E211U, 0xA51C46EEU, 0x6B77F2B0U, 0x1367898AU, 0x8AD0BFDFU },
+    { 0x3340AF6EU, 0x4FEF792FU, 0x318DA887U, 0x28DEDBE8U, 0x12675247U, 0xD36639C0U, 0x6216ED40U,
+      0x069FE5C0U, 0x22E16EDDU, 0x51A63257U, 0x9F79DC71U, 0xDEF15163U, 0x2721268BU, 0x4B883A8EU },
+    { 0xA212204AU, 0x45D628F4U, 0x2179451FU, 0x9F359B85U, 0x7F6FDFD2U, 0x1B379600U, 0xF3ABE723U,
+      0x8D6079A0U, 0x325133EFU, 0x9638D400U, 0xB44F6E03U, 0x4BD84353U, 0xE08EAA6DU, 0xFA4CE67CU },
+    { 0x7A0CF558U, 0xB69DE6B5U, 0xBCC7D7D3U, 0x01185CBEU, 0x3CDE1E02U, 0x9D8EA412U, 0x6D74EEC6U,
+      0xF9C6A6B2U, 0x2F756C14U, 0xB0F61B65U, 0xB80A3590U, 0xB1AEEB39U, 0xEDF67B4EU, 0x6B8D0DE3U },
+    { 0xB1C41573U, 0x71EAFDE6U, 0x0CEB7312U, 0xD93D3CA4U, 0xDF8F073EU, 0xB756A924U, 0x08806200U,
+      0x558465F9U, 0xD766000CU, 0xF54977E6U, 0x2786E589U, 0x942DAC3EU, 0x1C1C2776U, 0x5A8786C9U },
+    { 0x082B4C0AU, 0xC7BEEC6EU, 0xC66ED283U, 0x0104AA60U, 0x4886A44AU, 0x6D90D5BFU, 0xD579EFABU,
+      0x9338CEC3U, 0xF8467D2CU, 0xC378A1FFU, 0x8411401FU, 0xD60045F3U, 0xA459A479U, 0x00D1FC6CU },
+    { 0x2B404F50U, 0xDB46A69BU, 0x447CF42EU, 0x01F90476U, 0xFB37C52FU, 0x6F7B22B4U, 0x0AB3990AU,
+      0x6890A915U, 0x9074B1C8U, 0xD1A6BC6EU, 0x00FB4E72U, 0x2D1FA86BU, 0xA8F6869CU, 0x784B1C86U },
+    { 0x6C343485U, 0x69E47567U, 0x7C7E8150U, 0xEA58C4ACU, 0x7F182406U, 0x3A0525B0U, 0xB7C4137DU,
+      0xF97657A7U, 0x8DFD885DU, 0x0A1DA4DDU, 0x2FF5C9ABU, 0xCB7E3446U, 0x5FBD02ADU, 0xE7EC978EU },
+};
+
+static const uint32_t s_tab_ntag42x[OC_TABLE_POINTS][2 * 7] = {
+    { 0x0CF4ED3AU, 0x3E8F0AAEU, 0xD8EEA226U, 0x30A71A80U, 0xE52F7565U, 0x34234240U, 0x37C8C03AU,
+      0xA99B853CU, 0xD42480C8U, 0x746F602BU, 0x463A196AU, 0x75811882U, 0x600EB3B3U, 0xEF8CF917U },
+    { 0x5703586BU, 0x5FD6E984U, 0x5ED1FD6AU, 0x16E774D9U, 0x32C87FBAU, 0xF088E7D6U, 0x485326B5U,
+      0x08372203U, 0x1F15E695U, 0xEE595EB2U, 0x6BACA1A8U, 0xED9BB542U, 0x975AA490U, 0x5CD0AA4BU },
+    { 0x1C2EDE63U, 0x75070B98U, 0x8682681DU, 0x73863727U, 0x55DBE0CAU, 0x383DF9D1U, 0x9F989F98U,
+      0x1E96F071U, 0x3BFE734FU, 0xFE96AF3AU, 0x1408B244U, 0xCE3630FAU, 0x897C4C96U, 0xEC2CC618U },
+    { 0x19024620U, 0x5BC99B68U, 0xA6927483U, 0x2CF6B5DBU, 0xA04B08EAU, 0x64936999U, 0x4AC71B53U,
+      0x57B8C3EBU, 0x9CCD3D2FU, 0x092DE153U, 0x82F46998U, 0xBBE6DCBCU, 0xD046831BU, 0x58F8C29EU },
+    { 0xD6E84233U, 0xF50EF9C5U, 0x65057DCCU, 0x93A271D2U, 0xB13F7F59U, 0x575E0DAEU, 0xDCF07CFDU,
+      0x578A08B3U, 0x95CC92CAU, 0x80E6C434U, 0x660DEDF1U, 0x7070D114U, 0xB0F94585U, 0x0B57A54BU },
+    { 0xB0E3614AU, 0x76F4726BU, 0x496001A7U, 0x2DB08648U, 0xF504FECCU, 0x6A108655U, 0x8252E933U,
+      0xA67C6B24U, 0x3168D224U, 0x71AAC4F7U, 0x40444BAAU, 0x596EAB18U, 0x355418ABU, 0x852DE0F7U },
+    { 0xDABE1A3CU, 0x0D85C5B6U, 0x4E087289U, 0xEA00117EU, 0xF4C9CABBU, 0xAD5731E4U, 0x384E9872U,
+      0xF41B43A2U, 0xC9A070D2U, 0xD8B157ECU, 0x5F3B43ADU, 0xAB388636U, 0x3E8BF9C0U, 0xAB461CD8U },
+    { 0xB4E4A3D6U, 0xA55E2550U, 0x457E6B53U, 0x30DF4D4CU, 0x5ACE970AU, 0x729E1215U, 0xEE54587EU,
+      0x2CD2F5FFU, 0x0AE9A20AU, 0x26F677E9U, 0x72F75857U, 0x1CD565E4U, 0x40610D9DU, 0x9F496A06U },
+    { 0x62265E6BU, 0x7494D7A3U, 0x3567B019U, 0x96785233U, 0xAFB2A1F8U, 0x51E550C5U, 0x98522622U,
+      0xE833F55DU, 0xF1DE22FDU, 0x2BA65805U, 0x2512B1C3U, 0xCE0C31D2U, 0xBA6C2C4FU, 0xEF55B417U },
+    { 0xF3B30344U, 0x13833F25U, 0x65541FC2U, 0x01749785U, 0xDF9DA0FEU, 0xD5012803U, 0x3982CAABU,
+      0x4434E6F0U, 0x9F7EED33U, 0x3441AC8CU, 0x18461524U, 0x82870DAEU, 0xC7A4836CU, 0x69857436U },
+    { 0xD882C336U, 0x156E19CCU, 0xC2209257U, 0x91338599U, 0xB9C422A6U, 0xCB40347DU, 0x357A2EDAU,
+      0x9154ADAEU, 0x56A3BABEU, 0xAD392ED0U, 0xD9CA48C9U, 0x0D7DF888U, 0x1BA4C1E9U, 0x42D2D26CU },
+    { 0x1E154A07U, 0x8728F6B4U, 0x0EB07A6AU, 0x842C84CFU, 0xBFF2410AU, 0xE984F94AU, 0x488257FFU,
+      0xB51376F8U, 0x7F4DD4BAU, 0x55BEB609U, 0x555FE3B4U, 0x746FA6FCU, 0x48412ECEU, 0xED9A0F67U },
+    { 0xD3C348A6U, 0x197B0AB3U, 0xC4B91B00U, 0x29D52893U, 0xD7BEB408U, 0x43AE9DFCU, 0x672D5151U,
+      0x74CED1E4U, 0xA812F7BDU, 0x58C53481U, 0x8355DC88U, 0x4C8221B2U, 0x4F1919C3U, 0x02E8FE80U },
+    { 0xCB6C7E5CU, 0x44FBF035U, 0x71DF2E07U, 0xE702C030U, 0x74E50E41U, 0xA3F2D3A4U, 0xE678FFDCU,
+      0xDD256E19U, 0x5048B0D5U, 0x62698CC8U, 0xE4CBE94FU, 0x16D6AFC5U, 0x736CF151U, 0x79A69473U },
+    { 0x93B9716EU, 0x08163CB2U, 0x1BB3CFF8U, 0x5118A9F4U, 0x3BE413EFU, 0xFF03E4CEU, 0xF6ACE08CU,
+      0xBA053E8BU, 0x5587DE03U, 0x31500682U, 0xF0219FE4U, 0xBBA53C0CU, 0xF9C5C663U, 0x8BB8B921U },
+};
+
+static const OC_CurveDef_t s_curve_def[2] = {
+    { 16, 4, s_p128, s_b128, s_n128, &s_tab_g128[0][0] },
+    { 28, 7, s_p224, s_b224, s_n224, &s_tab_g224[0][0] }
+};
+
+typedef struct {
+    uint8_t curve;                  /* Index into s_curve_def */
+    uint8_t uid_len;
+    const uint8_t *key;             /* Built-in key, NULL: OrigCheck_SetPublicKey only */
+    const uint32_t *tab;            /* Built-in table */
+} OC_TagDef_t;
+
+static const OC_TagDef_t s_tag_def[ORIG_TAG_COUNT] = {
+    { 0, 7, s_key_mful, &s_tab_mful[0][0] },
+    { 0, 8, s_key_icode, &s_tab_icode[0][0] },
+    { 1, 7, s_key_ntag42x, &s_tab_ntag42x[0][0] }
+};
+
+/* ================== Modular arithmetic (Montgomery, 32 bit limbs, little endian) ================== */
+
+typedef struct {
+    uint32_t m[OC_WORDS_MAX];
+    uint32_t rr[OC_WORDS_MAX];      /* R^2 mod m */
+    uint32_t one[OC_WORDS_MAX];     /* R mod m */
+    uint32_t inv;                   /* -m^-1 mod 2^32 */
+    uint8_t s;
+} OC_Mod_t;
+
+typedef struct {
+    OC_Mod_t p;
+    OC_Mod_t n;
+    uint32_t b[OC_WORDS_MAX];       /* Montgomery form */
+    uint32_t g[2 * OC_WORDS_MAX];   /* Affine, Montgomery form */
+    uint8_t ready;
+} OC_Curve_t;
+
+typedef struct {
+    uint32_t x[OC_WORDS_MAX];
+    uint32_t y[OC_WORDS_MAX];
+    uint32_t z[OC_WORDS_MAX];       /* 0: point at infinity */
+} OC_Jac_t;
+
+static OC_Curve_t s_curve[2];
+
+/* Keys from OrigCheck_SetPublicKey, tables in the second RAM bank */
+PH_MEMLOC_RAM2 static uint32_t s_tab_ram[ORIG_TAG_COUNT][OC_TABLE_POINTS * 2 * OC_WORDS_MAX];
+static uint32_t s_key_ram[ORIG_TAG_COUNT][2 * OC_WORDS_MAX];
+static uint8_t s_key_set[ORIG_TAG_COUNT];
+
+static void OC_FromBytes(uint32_t *w, uint8_t words, const uint8_t *p, uint8_t len)
+{
+    memset(w, 0, words * sizeof(uint32_t));
+    for (uint8_t i = 0; i < len; i++) {
+        uint8_t pos = (uint8_t)(len - 1U - i);
+        w[pos / 4U] |= (uint32_t)p[i] << (8U * (pos % 4U));
+    }
+}
+
+/* a >= b */
+static int OC_Geq(const uint32_t *a, const uint32_t *b, uint8_t s)
+{
+    for (int i = s - 1; i >= 0; i--) {
+        if (a[i] != b[i]) {
+            return a[i] > b[i];
+        }
+    }
+    return 1;
+}
+
+static int OC_IsZero(const uint32_t *a, uint8_t s)
+{
+    uint32_t acc = 0;
+
+    for (uint8_t i = 0; i < s; i++) {
+        acc |= a[i];
+    }
+    return acc == 0U;
+}
+
+/* r = a + b mod m */
+static void OC_Add(uint32_t *r, const uint32_t *a, const uint32_t *b, const OC_Mod_t *m)
+{
+    uint64_t c = 0;
+    uint32_t borrow = 0;
+
+    for (uint8_t i = 0; i < m->s; i++) {
+        c = (uint64_t)a[i] + b[i] + (c >> 32);
+        r[i] = (uint32_t)c;
+    }
+    if ((c >> 32) != 0U || OC_Geq(r, m->m, m->s)) {
+        for (uint8_t i = 0; i < m->s; i++) {
+            uint64_t d = (uint64_t)r[i] - m->m[i] - borrow;
+            r[i] = (uint32_t)d;
+            borrow = (uint32_t)(d >> 63);
+        }
+    }
+}
+
+/* r = a - b mod m */
+static void OC_Sub(uint32_t *r, const uint32_t *a, const uint32_t *b, const OC_Mod_t *m)
+{
+    uint32_t borrow = 0;
+    uint64_t c = 0;
+
+    for (uint8_t i = 0; i < m->s; i++) {
+        uint64_t d = (uint64_t)a[i] - b[i] - borrow;
+        r[i] = (uint32_t)d;
+        borrow = (uint32_t)(d >> 63);
+    }
+    if (borrow != 0U) {
+        for (uint8_t i = 0; i < m->s; i++) {
+            c = (uint64_t)r[i] + m->m[i] + (c >> 32);
+            r[i] = (uint32_t)c;
+        }
+    }
+}
+
+/* r = a * b * R^-1 mod m, CIOS; r may alias a or b */
+static void OC_Mul(uint32_t *r, const uint32_t *a, const uint32_t *b, const OC_Mod_t *m)
+{
+    uint32_t t[OC_WORDS_MAX + 2];
+    uint8_t s = m->s;
+
+    memset(t, 0, sizeof(t));
+    for (uint8_t i = 0; i < s; i++) {
+        uint64_t c = 0;
+        uint32_t q;
+
+        for (uint8_t j = 0; j < s; j++) {
+            c = (uint64_t)a[j] * b[i] + t[j] + (c >> 32);
+            t[j] = (uint32_t)c;
+        }
+        c = (uint64_t)t[s] + (c >> 32);
+        t[s] = (uint32_t)c;
+        t[s + 1] = (uint32_t)(c >> 32);
+
+        q = t[0] * m->inv;
+        c = (uint64_t)q * m->m[0] + t[0];
+        for (uint8_t j = 1; j < s; j++) {
+            c = (uint64_t)q * m->m[j] + t[j] + (c >> 32);
+            t[j - 1] = (uint32_t)c;
+        }
+        c = (uint64_t)t[s] + (c >> 32);
+        t[s - 1] = (uint32_t)c;
+        t[s] = t[s + 1] + (uint32_t)(c >> 32);
+    }
+
+    if (t[s] != 0U || OC_Geq(t, m->m, s)) {
+        uint32_t borrow = 0;
+        for (uint8_t i = 0; i < s; i++) {
+            uint64_t d = (uint64_t)t[i] - m->m[i] - borrow;
+            t[i] = (uint32_t)d;
+            borrow = (uint32_t)(d >> 63);
+        }
+    }
+    memcpy(r, t, s * sizeof(uint32_t));
+}
+
+/* r = a^(m-2) = a^-1, Montgomery form in and out */
+static void OC_Inv(uint32_t *r, const uint32_t *a, const OC_Mod_t *m)
+{
+    uint32_t e[OC_WORDS_MAX];
+    uint32_t acc[OC_WORDS_MAX];
+    uint32_t borrow = 2;
+    int top;
+
+    for (uint8_t i = 0; i < m->s; i++) {
+        uint64_t d = (uint64_t)m->m[i] - borrow;
+        e[i] = (uint32_t)d;
+        borrow = (uint32_t)(d >> 63);
+    }
+    for (top = 32 * m->s - 1; top > 0 && !(e[top / 32] & (1UL << (top % 32))); top--) {
+    }
+    memcpy(acc, a, sizeof(acc));
+    for (int i = top - 1; i >= 0; i--) {
+        OC_Mul(acc, acc, acc, m);
+        if (e[i / 32] & (1UL << (i % 32))) {
+            OC_Mul(acc, acc, a, m);
+        }
+    }
+    memcpy(r, acc, m->s * sizeof(uint32_t));
+}
+
+static void OC_ModInit(OC_Mod_t *m, const uint8_t *mod, uint8_t len, uint8_t s)
+{
+    uint32_t inv = 1;
+
+    memset(m, 0, sizeof(*m));
+    m->s = s;
+    OC_FromBytes(m->m, s, mod, len);
+    for (int i = 0; i < 5; i++) {
+        inv *= 2U - m->m[0] * inv;
+    }
+    m->inv = 0U - inv;
+
+    /* R mod m and R^2 mod m by doubling, R = 2^(32s) */
+    m->one[0] = 1;
+    for (uint32_t i = 0; i < 64U * s; i++) {
+        uint32_t *v = (i < 32U * s) ? m->one : m->rr;
+        OC_Add(v, v, v, m);
+        if (i + 1U == 32U * s) {
+            memcpy(m->rr, m->one, sizeof(m->rr));
+        }
+    }
+}
+
+/* Byte string to Montgomery form, 0 when the value is not below the modulus */
+static int OC_ToMont(uint32_t *r, const uint8_t *p, uint8_t len, const OC_Mod_t *m)
+{
+    OC_FromBytes(r, m->s, p, len);
+    if (OC_Geq(r, m->m, m->s)) {
+        return 0;
+    }
+    OC_Mul(r, r, m->rr, m);
+    return 1;
+}
+
+static const OC_Curve_t *OC_Curve(uint8_t idx)
+{
+    OC_Curve_t *c = &s_curve[idx];
+    const OC_CurveDef_t *def = &s_curve_def[idx];
+
+    if (!c->ready) {
+        OC_ModInit(&c->p, def->p, def->len, def->words);
+        OC_ModInit(&c->n, def->n, def->len, def->words);
+        (void)OC_ToMont(c->b, def->b, def->len, &c->p);
+        (void)OC_ToMont(&c->g[0], (idx == 0U) ? &s_g128[1] : &s_g224[1], def->len, &c->p);
+        (void)OC_ToMont(&c->g[def->words], (idx == 0U) ? &s_g128[1 + 16] : &s_g224[1 + 28], def->len, &c->p);
+        c->ready = 1;
+    }
+    return c;
+}
+
+/* ================== Point arithmetic (Jacobian, a = -3) ================== */
+
+static void OC_Double(OC_Jac_t *r, const OC_Jac_t *a, const OC_Mod_t *p)
+{
+    uint32_t t1[OC_WORDS_MAX], t2[OC_WORDS_MAX], m[OC_WORDS_MAX], s[OC_WORDS_MAX], y2[OC_WORDS_MAX];
+
+    if (OC_IsZero(a->z, p->s) || OC_IsZero(a->y, p->s)) {
+        memset(r->z, 0, sizeof(r->z));
+        return;
+    }
+    /* M = 3 (X - Z^2)(X + Z^2) */
+    OC_Mul(t1, a->z, a->z, p);
+    OC_Sub(t2, a->x, t1, p);
+    OC_Add(t1, a->x, t1, p);
+    OC_Mul(m, t1, t2, p);
+    OC_Add(t1, m, m, p);
+    OC_Add(m, t1, m, p);
+    /* Z' = 2 Y Z, S = 4 X Y^2 */
+    OC_Mul(t1, a->y, a->z, p);
+    OC_Add(r->z, t1, t1, p);
+    OC_Mul(y2, a->y, a->y, p);
+    OC_Mul(s, a->x, y2, p);
+    OC_Add(s, s, s, p);
+    OC_Add(s, s, s, p);
+    /* X' = M^2 - 2 S, Y' = M (S - X') - 8 Y^4 */
+    OC_Mul(t1, m, m, p);
+    OC_Sub(t1, t1, s, p);
+    OC_Sub(r->x, t1, s, p);
+    OC_Sub(t2, s, r->x, p);
+    OC_Mul(t2, m, t2, p);
+    OC_Mul(t1, y2, y2, p);
+    OC_Add(t1, t1, t1, p);
+    OC_Add(t1, t1, t1, p);
+    OC_Add(t1, t1, t1, p);
+    OC_Sub(r->y, t2, t1, p);
+}
+
+/* r = a + (qx, qy), r may alias a */
+static void OC_AddAffine(OC_Jac_t *r, const OC_Jac_t *a, const uint32_t *qx, const uint32_t *qy,
+                         const OC_Mod_t *p)
+{
+    uint32_t zz[OC_WORDS_MAX], h[OC_WORDS_MAX], rr[OC_WORDS_MAX], hh[OC_WORDS_MAX], v[OC_WORDS_MAX];
+    uint32_t t[OC_WORDS_MAX];
+
+    if (OC_IsZero(a->z, p->s)) {
+        memcpy(r->x, qx, p->s * sizeof(uint32_t));
+        memcpy(r->y, qy, p->s * sizeof(uint32_t));
+        memcpy(r->z, p->one, sizeof(r->z));
+        return;
+    }
+    /* H = qx Z^2 - X, r = qy Z^3 - Y */
+    OC_Mul(zz, a->z, a->z, p);
+    OC_Mul(h, qx, zz, p);
+    OC_Sub(h, h, a->x, p);
+    OC_Mul(t, a->z, zz, p);
+    OC_Mul(rr, qy, t, p);
+    OC_Sub(rr, rr, a->y, p);
+    if (OC_IsZero(h, p->s)) {
+        if (OC_IsZero(rr, p->s)) {
+            OC_Double(r, a, p);
+        } else {
+            memset(r->z, 0, sizeof(r->z));
+        }
+        return;
+    }
+    /* X' = r^2 - H^3 - 2 X H^2, Y' = r (X H^2 - X') - Y H^3, Z' = Z H */
+    OC_Mul(hh, h, h, p);
+    OC_Mul(v, a->x, hh, p);
+    OC_Mul(hh, hh, h, p);
+    OC_Mul(r->z, a->z, h, p);
+    OC_Mul(t, a->y, hh, p);
+    OC_Mul(h, rr, rr, p);
+    OC_Sub(h, h, hh, p);
+    OC_Sub(h, h, v, p);
+    OC_Sub(r->x, h, v, p);
+    OC_Sub(v, v, r->x, p);
+    OC_Mul(v, rr, v, p);
+    OC_Sub(r->y, v, t, p);
+}
+
+static void OC_ToAffine(uint32_t *x, uint32_t *y, const OC_Jac_t *a, const OC_Mod_t *p)
+{
+    uint32_t zi[OC_WORDS_MAX], t[OC_WORDS_MAX];
+
+    OC_Inv(zi, a->z, p);
+    OC_Mul(t, zi, zi, p);
+    OC_Mul(x, a->x, t, p);
+    OC_Mul(t, t, zi, p);
+    OC_Mul(y, a->y, t, p);
+}
+
+static uint8_t OC_Bit(const uint32_t *k, uint16_t pos, uint16_t bits)
+{
+    return (pos < bits) ? (uint8_t)((k[pos / 32U] >> (pos % 32U)) & 1U) : 0U;
+}
+
+/* Comb table of the affine point q, see the stored tables */
+static void OC_BuildTable(uint32_t *tab, const uint32_t *q, const OC_Curve_t *c)
+{
+    const OC_Mod_t *p = &c->p;
+    uint8_t s = p->s;
+    uint16_t d = (uint16_t)((32U * s + OC_TEETH - 1U) / OC_TEETH);
+    OC_Jac_t acc;
+
+    memcpy(&tab[0], q, 2U * s * sizeof(uint32_t));
+    for (uint8_t i = 1; i < OC_TEETH; i++) {
+        const uint32_t *prev = &tab[((1U << (i - 1U)) - 1U) * 2U * s];
+        uint32_t *base = &tab[((1U << i) - 1U) * 2U * s];
+
+        memset(&acc, 0, sizeof(acc));
+        OC_AddAffine(&acc, &acc, prev, prev + s, p);
+        for (uint16_t k = 0; k < d; k++) {
+            OC_Double(&acc, &acc, p);
+        }
+        OC_ToAffine(base, base + s, &acc, p);
+    }
+    for (uint32_t j = 3; j <= OC_TABLE_POINTS; j++) {
+        uint32_t top = 1;
+
+        if ((j & (j - 1U)) == 0U) {
+            continue;
+        }
+        while ((top << 1) <= j) {
+            top <<= 1;
+        }
+        memset(&acc, 0, sizeof(acc));
+        OC_AddAffine(&acc, &acc, &tab[(j - top - 1U) * 2U * s], &tab[(j - top - 1U) * 2U * s + s], p);
+        OC_AddAffine(&acc, &acc, &tab[(top - 1U) * 2U * s], &tab[(top - 1U) * 2U * s + s], p);
+        OC_ToAffine(&tab[(j - 1U) * 2U * s], &tab[(j - 1U) * 2U * s + s], &acc, p);
+    }
+}
+
+/* r = k1 G + k2 Q, both from comb tables, the doublings are shared */
+static void OC_CombMul2(OC_Jac_t *r, const uint32_t *k1, const uint32_t *tab1,
+                        const uint32_t *k2, const uint32_t *tab2, const OC_Curve_t *c)
+{
+    const OC_Mod_t *p = &c->p;
+    uint8_t s = p->s;
+    uint16_t bits = (uint16_t)(32U * s);
+    uint16_t d = (uint16_t)((bits + OC_TEETH - 1U) / OC_TEETH);
+
+    memset(r, 0, sizeof(*r));
+    for (int col = d - 1; col >= 0; col--) {
+        uint32_t i1 = 0, i2 = 0;
+
+        for (uint8_t t = 0; t < OC_TEETH; t++) {
+            i1 |= (uint32_t)OC_Bit(k1, (uint16_t)(t * d + col), bits) << t;
+            i2 |= (uint32_t)OC_Bit(k2, (uint16_t)(t * d + col), bits) << t;
+        }
+        OC_Double(r, r, p);
+        if (i1 != 0U) {
+            const uint32_t *e = &tab1[(i1 - 1U) * 2U * s];
+            OC_AddAffine(r, r, e, e + s, p);
+        }
+        if (i2 != 0U) {
+            const uint32_t *e = &tab2[(i2 - 1U) * 2U * s];
+            OC_AddAffine(r, r, e, e + s, p);
+        }
+    }
+}
+
+/* r = k1 G + k2 Q, one bit at a time */
+static void OC_Mul2Generic(OC_Jac_t *r, const uint32_t *k1, const uint32_t *g,
+                           const uint32_t *k2, const uint32_t *q, const OC_Curve_t *c)
+{
+    const OC_Mod_t *p = &c->p;
+    uint8_t s = p->s;
+    uint16_t bits = (uint16_t)(32U * s);
+
+    memset(r, 0, sizeof(*r));
+    for (int i = bits - 1; i >= 0; i--) {
+        OC_Double(r, r, p);
+        if (OC_Bit(k1, (uint16_t)i, bits)) {
+            OC_AddAffine(r, r, g, g + s, p);
+        }
+        if (OC_Bit(k2, (uint16_t)i, bits)) {
+            OC_AddAffine(r, r, q, q + s, p);
+        }
+    }
+}
+
+/* y^2 = x^3 - 3x + b, Montgomery form */
+static int OC_OnCurve(const uint32_t *x, const uint32_t *y, const OC_Curve_t *c)
+{
+    const OC_Mod_t *p = &c->p;
+    uint32_t l[OC_WORDS_MAX], r[OC_WORDS_MAX], t[OC_WORDS_MAX];
+
+    OC_Mul(l, y, y, p);
+    OC_Mul(r, x, x, p);
+    OC_Mul(r, r, x, p);
+    OC_Add(t, x, x, p);
+    OC_Add(t, t, x, p);
+    OC_Sub(r, r, t, p);
+    OC_Add(r, r, c->b, p);
+    return memcmp(l, r, p->s * sizeof(uint32_t)) == 0;
+}
+
+static int OC_LoadPoint(uint32_t *pt, const uint8_t *key, uint8_t key_len, const OC_Curve_t *c, uint8_t len)
+{
+    if (key_len != 1U + 2U * len || key[0] != 0x04U) {
+        return 0;
+    }
+    if (!OC_ToMont(&pt[0], &key[1], len, &c->p) || !OC_ToMont(&pt[c->p.s], &key[1 + len], len, &c->p)) {
+        return 0;
+    }
+    return OC_OnCurve(&pt[0], &pt[c->p.s], c);
+}
+
+/* ================== UID cache ================== */
+
+typedef struct {
+    uint8_t type;
+    uint8_t uid_len;
+    uint8_t sig_len;
+    uint8_t uid[ORIG_CHECK_MAX_UID];
+    uint8_t sig[ORIG_CHECK_MAX_SIG];
+    uint32_t stamp;                 /* 0: free */
+} OC_CacheEntry_t;
+
+#if ORIG_CHECK_CACHE_ENTRIES > 0
+static OC_CacheEntry_t s_cache[ORIG_CHECK_CACHE_ENTRIES];
+#endif
+static uint32_t s_cache_stamp;
+static OrigCheck_Stats_t s_stats;
+
+/* The signature is kept too, a clone with a copied UID still has to present it */
+static OC_CacheEntry_t *OC_CacheFind(OrigCheck_TagType_t type, const uint8_t *uid, uint8_t uid_len,
+                                     const uint8_t *sig, uint8_t sig_len)
+{
+#if ORIG_CHECK_CACHE_ENTRIES > 0
+    for (uint8_t i = 0; i < ORIG_CHECK_CACHE_ENTRIES; i++) {
+        OC_CacheEntry_t *e = &s_cache[i];
+        if (e->stamp != 0U && e->type == type && e->uid_len == uid_len && e->sig_len == sig_len &&
+            memcmp(e->uid, uid, uid_len) == 0 && memcmp(e->sig, sig, sig_len) == 0) {
+            return e;
+        }
+    }
+#else
+    (void)type; (void)uid; (void)uid_len; (void)sig; (void)sig_len;
+#endif
+    return NULL;
+}
+
+static void OC_CacheAdd(OrigCheck_TagType_t type, const uint8_t *uid, uint8_t uid_len,
+                        const uint8_t *sig, uint8_t sig_len)
+{
+#if ORIG_CHECK_CACHE_ENTRIES > 0
+    OC_CacheEntry_t *victim = &s_cache[0];
+
+    for (uint8_t i = 1; i < ORIG_CHECK_CACHE_ENTRIES; i++) {
+        if (s_cache[i].stamp < victim->stamp) {
+            victim = &s_cache[i];
+        }
+    }
+    victim->type = (uint8_t)type;
+    victim->uid_len = uid_len;
+    victim->sig_len = sig_len;
+    memcpy(victim->uid, uid, uid_len);
+    memcpy(victim->sig, sig, sig_len);
+    victim->stamp = ++s_cache_stamp;
+#else
+    (void)type; (void)uid; (void)uid_len; (void)sig; (void)sig_len;
+#endif
+}
+
+/* ================== Verification ================== */
+
+static OrigCheck_Result_t OC_Verify(const uint8_t *uid, uint8_t uid_len, const uint8_t *sig, uint8_t sig_len,
+                                    OrigCheck_TagType_t type, uint8_t use_tables)
+{
+    const OC_TagDef_t *tag;
+    const OC_CurveDef_t *def;
+    const OC_Curve_t *c;
+    uint32_t r[OC_WORDS_MAX], w[OC_WORDS_MAX], e[OC_WORDS_MAX], u1[OC_WORDS_MAX], u2[OC_WORDS_MAX];
+    uint32_t q[2 * OC_WORDS_MAX];
+    uint32_t t[OC_WORDS_MAX], zz[OC_WORDS_MAX];
+    OC_Jac_t acc;
+    uint8_t s;
+
+    if ((unsigned)type >= ORIG_TAG_COUNT || uid == NULL || sig == NULL) {
+        return ORIG_CHECK_ERR_PARAM;
+    }
+    tag = &s_tag_def[type];
+    def = &s_curve_def[tag->curve];
+    if (uid_len != tag->uid_len || sig_len != 2U * def->len) {
+        return ORIG_CHECK_ERR_PARAM;
+    }
+    if (tag->key == NULL && !s_key_set[type]) {
+        return ORIG_CHECK_ERR_NO_KEY;
+    }
+    c = OC_Curve(tag->curve);
+    s = def->words;
+
+    /* 0 < r, s < n; the Montgomery conversion also rejects values >= n */
+    if (!OC_ToMont(w, &sig[def->len], def->len, &c->n) || OC_IsZero(w, s)) {
+        return ORIG_CHECK_ERR_SIGNATURE;
+    }
+    OC_FromBytes(r, s, sig, def->len);
+    if (OC_IsZero(r, s) || OC_Geq(r, c->n.m, s)) {
+        return ORIG_CHECK_ERR_SIGNATURE;
+    }
+
+    /* e = UID, shorter than n, no hashing. u1 = e / s, u2 = r / s mod n */
+    OC_FromBytes(e, s, uid, uid_len);
+    /* UID 0 makes u1 = 0, a signature for it follows from the public key alone; no genuine tag has it */
+    if (OC_IsZero(e, s)) {
+        return ORIG_CHECK_ERR_SIGNATURE;
+    }
+    OC_Inv(w, w, &c->n);
+    OC_Mul(u1, e, w, &c->n);
+    OC_Mul(u2, r, w, &c->n);
+
+    if (use_tables) {
+        const uint32_t *tab_q = s_key_set[type] ? s_tab_ram[type] : tag->tab;
+        OC_CombMul2(&acc, u1, def->tab_g, u2, tab_q, c);
+    } else {
+        if (s_key_set[type]) {
+            memcpy(q, s_key_ram[type], sizeof(q));
+        } else {
+            (void)OC_LoadPoint(q, tag->key, (uint8_t)(1U + 2U * def->len), c, def->len);
+        }
+        OC_Mul2Generic(&acc, u1, c->g, u2, q, c);
+    }
+    if (OC_IsZero(acc.z, s)) {
+        return ORIG_CHECK_ERR_SIGNATURE;
+    }
+
+    /* x(R) mod n == r, compared as r Z^2 == X, without an inversion mod p */
+    OC_Mul(zz, acc.z, acc.z, &c->p);
+    if (!OC_Geq(r, c->p.m, s)) {
+        OC_Mul(t, r, c->p.rr, &c->p);
+        OC_Mul(t, t, zz, &c->p);
+        if (memcmp(t, acc.x, s * sizeof(uint32_t)) == 0) {
+            return ORIG_CHECK_OK;
+        }
+    }
+    /* x in [n, p) */
+    if (!OC_Geq(c->n.m, c->p.m, s)) {
+        uint64_t carry = 0;
+        for (uint8_t i = 0; i < s; i++) {
+            carry = (uint64_t)r[i] + c->n.m[i] + (carry >> 32);
+            t[i] = (uint32_t)carry;
+        }
+        if ((carry >> 32) == 0U && !OC_Geq(t, c->p.m, s)) {
+            OC_Mul(t, t, c->p.rr, &c->p);
+            OC_Mul(t, t, zz, &c->p);
+            if (memcmp(t, acc.x, s * sizeof(uint32_t)) == 0) {
+                return ORIG_CHECK_OK;
+            }
+        }
+    }
+    return ORIG_CHECK_ERR_SIGNATURE;
+}
+
+/* ================== Interface ================== */
+
+void OrigCheck_Init(void)
+{
+    OrigCheck_ClearCache();
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+OrigCheck_Result_t OrigCheck_SetPublicKey(OrigCheck_TagType_t type, const uint8_t *key, uint8_t key_len)
+{
+    const OC_Curve_t *c;
+    uint32_t q[2 * OC_WORDS_MAX];
+
+    if ((unsigned)type >= ORIG_TAG_COUNT || key == NULL) {
+        return ORIG_CHECK_ERR_PARAM;
+    }
+    c = OC_Curve(s_tag_def[type].curve);
+    if (!OC_LoadPoint(q, key, key_len, c, s_curve_def[s_tag_def[type].curve].len)) {
+        return ORIG_CHECK_ERR_PARAM;
+    }
+    s_key_set[type] = 0;
+    OC_BuildTable(s_tab_ram[type], q, c);
+    memcpy(s_key_ram[type], q, sizeof(q));
+    s_key_set[type] = 1;
+
+#if ORIG_CHECK_CACHE_ENTRIES > 0
+    for (uint8_t i = 0; i < ORIG_CHECK_CACHE_ENTRIES; i++) {
+        if (s_cache[i].type == type) {
+            s_cache[i].stamp = 0;
+        }
+    }
+#endif
+    return ORIG_CHECK_OK;
+}
+
+OrigCheck_Result_t OrigCheck_VerifyOriginality(const uint8_t *uid, uint8_t uid_len,
+                                               const uint8_t *sig, uint8_t sig_len,
+                                               OrigCheck_TagType_t type)
+{
+    OrigCheck_Result_t res;
+    OC_CacheEntry_t *hit;
+
+    if ((unsigned)type < ORIG_TAG_COUNT && uid != NULL && sig != NULL &&
+        uid_len <= ORIG_CHECK_MAX_UID && sig_len <= ORIG_CHECK_MAX_SIG) {
+        hit = OC_CacheFind(type, uid, uid_len, sig, sig_len);
+        if (hit != NULL) {
+            hit->stamp = ++s_cache_stamp;
+            s_stats.cache_hits++;
+            return ORIG_CHECK_OK;
+        }
+    }
+
+    res = OC_Verify(uid, uid_len, sig, sig_len, type, 1);
+    if (res == ORIG_CHECK_OK) {
+        s_stats.verified++;
+        OC_CacheAdd(type, uid, uid_len, sig, sig_len);
+    } else if (res == ORIG_CHECK_ERR_SIGNATURE) {
+        s_stats.failures++;
+    }
+    return res;
+}
+
+OrigCheck_Result_t OrigCheck_VerifyGeneric(const uint8_t *uid, uint8_t uid_len,
+                                           const uint8_t *sig, uint8_t sig_len,
+                                           OrigCheck_TagType_t type)
+{
+    return OC_Verify(uid, uid_len, sig, sig_len, type, 0);
+}
+
+OrigCheck_Result_t OrigCheck_SelfTest(void)
+{
+    static uint32_t tab[OC_TABLE_POINTS * 2 * OC_WORDS_MAX];
+    uint32_t q[2 * OC_WORDS_MAX];
+
+    for (uint8_t idx = 0; idx < 2U; idx++) {
+        const OC_Curve_t *c = OC_Curve(idx);
+        const OC_CurveDef_t *def = &s_curve_def[idx];
+
+        OC_BuildTable(tab, c->g, c);
+        if (memcmp(tab, def->tab_g, OC_TABLE_POINTS * 2U * def->words * sizeof(uint32_t)) != 0) {
+            return ORIG_CHECK_ERR_PARAM;
+        }
+    }
+    for (uint8_t type = 0; type < ORIG_TAG_COUNT; type++) {
+        const OC_TagDef_t *tag = &s_tag_def[type];
+        const OC_CurveDef_t *def = &s_curve_def[tag->curve];
+        const OC_Curve_t *c = OC_Curve(tag->curve);
+
+        if (tag->key == NULL) {
+            continue;
+        }
+        if (!OC_LoadPoint(q, tag->key, (uint8_t)(1U + 2U * def->len), c, def->len)) {
+            return ORIG_CHECK_ERR_PARAM;
+        }
+        OC_BuildTable(tab, q, c);
+        if (memcmp(tab, tag->tab, OC_TABLE_POINTS * 2U * def->words * sizeof(uint32_t)) != 0) {
+            return ORIG_CHECK_ERR_PARAM;
+        }
+    }
+    return ORIG_CHECK_OK;
+}
+
+void OrigCheck_ClearCache(void)
+{
+#if ORIG_CHECK_CACHE_ENTRIES > 0
+    memset(s_cache, 0, sizeof(s_cache));
+#endif
+    s_cache_stamp = 0;
+}
+
+void OrigCheck_GetStats(OrigCheck_Stats_t *stats)
+{
+    *stats = s_stats;
+}
@@ -0,0 +1,83 @@
+/*
+ * ram_budget.c
+ *
+ * Static RAM budgets and runtime stack watermark
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "ram_budget.h"
+#include "phApp_Init.h"
+#include <stddef.h>
+
+/* Symbols defined in STM32L431RCTX_FLASH.ld */
+extern uint8_t _sdata, _edata;
+extern uint8_t _sbss, _ebss;
+extern uint8_t _sbss_nfclib, _ebss_nfclib;
+extern uint8_t _sbss_dal, _ebss_dal;
+extern uint8_t _sbss_demo, _ebss_demo;
+extern uint8_t _sbss_emv, _ebss_emv;
+extern uint8_t _sbss_app, _ebss_app;
+extern uint8_t _sram2_bss, _eram2_bss;
+extern uint8_t _estack;
+extern uint32_t _Min_Stack_Size;
+extern uint32_t _Min_Heap_Size;
+
+extern void *_sbrk(ptrdiff_t incr);
+
+#define RAM_BUDGET_SPAN(s, e)   ((uint32_t)(&(e)) - (uint32_t)(&(s)))
+
+/* ================== Stack ================== */
+
+uint32_t Stack_HighWatermark(void)
+{
+    /* Everything between the heap end and the stack pointer was painted at reset */
+    const uint32_t *p = (const uint32_t *)(((uint32_t)_sbrk(0) + 3U) & ~3UL);
+    const uint32_t *top = (const uint32_t *)&_estack;
+
+    while (p < top && *p == RAM_BUDGET_STACK_PAINT) {
+        p++;
+    }
+    return (uint32_t)top - (uint32_t)p;
+}
+
+uint8_t Stack_Overflowed(void)
+{
+    return (Stack_HighWatermark() > (uint32_t)&_Min_Stack_Size) ? 1U : 0U;
+}
+
+/* ================== Budget table ================== */
+
+uint8_t RamBudget_Get(RamBudget_Entry_t *entries, uint8_t max_entries)
+{
+    const RamBudget_Entry_t table[] = {
+        { "nfclib", RAM_BUDGET_SPAN(_sbss_nfclib, _ebss_nfclib), RAM_BUDGET_NFCLIB },
+        { "dal",    RAM_BUDGET_SPAN(_sbss_dal, _ebss_dal),       RAM_BUDGET_DAL },
+        { "demo",   RAM_BUDGET_SPAN(_sbss_demo, _ebss_demo),     RAM_BUDGET_DEMO },
+        { "emv",    RAM_BUDGET_SPAN(_sbss_emv, _ebss_emv),       RAM_BUDGET_EMV },
+        { "app",    RAM_BUDGET_SPAN(_sbss_app, _ebss_app),       RAM_BUDGET_APP },
+        { "ram2",   RAM_BUDGET_SPAN(_sram2_bss, _eram2_bss),     RAM_BUDGET_RAM2 },
+        { "stack",  Stack_HighWatermark(),                       (uint32_t)&_Min_Stack_Size },
+    };
+    uint8_t n = 0;
+
+    while (n < max_entries && n < (uint8_t)(sizeof(table) / sizeof(table[0]))) {
+        entries[n] = table[n];
+        n++;
+    }
+    return n;
+}
+
+void RamBudget_Report(void)
+{
+    RamBudget_Entry_t entries[8];
+    uint8_t n = RamBudget_Get(entries, (uint8_t)(sizeof(entries) / sizeof(entries[0])));
+
+    DEBUG_PRINTF("RAM: data %lu, bss %lu, heap %lu\r\n", RAM_BUDGET_SPAN(_sdata, _edata),
+                 RAM_BUDGET_SPAN(_sbss, _ebss), (uint32_t)&_Min_Heap_Size);
+    for (uint8_t i = 0; i < n; i++) {
+        DEBUG_PRINTF("  %-6s %5lu / %5lu%s\r\n", entries[i].name, entries[i].size, entries[i].budget,
+                     (entries[i].size > entries[i].budget) ? "  OVER BUDGET" : "");
+    }
+}
@@ -0,0 +1,183 @@
+/*
+ * rng_entropy.c
+ *
+ * Hardware entropy for the reader library DRBG
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "rng_entropy.h"
+#include "phCryptoRng.h"
+#include "emv_sched.h"
+#include "phApp_Init.h"
+#include <string.h>
+
+#if defined(STM32L431xx)
+#include "main.h"
+#else
+#include <stdio.h>
+#endif
+
+static phCryptoRng_Sw_DataParams_t *s_drbg = NULL;
+static void *s_pending = NULL;
+
+/* ================== Entropy source ================== */
+
+#if defined(STM32L431xx)
+
+static uint32_t s_last_word;
+static uint8_t s_have_last;
+
+static void RngEntropy_Restart(void)
+{
+    /* Seed error recovery, RM0394 RNG chapter: clear SEIS and restart the generator */
+    RNG->CR &= ~RNG_CR_RNGEN;
+    RNG->SR &= ~(RNG_SR_SEIS | RNG_SR_CEIS);
+    RNG->CR |= RNG_CR_RNGEN;
+    s_have_last = 0;
+}
+
+phStatus_t RngEntropy_Init(void)
+{
+    uint32_t start = HAL_GetTick();
+
+    __HAL_RCC_HSI48_ENABLE();
+    while ((RCC->CRRCR & RCC_CRRCR_HSI48RDY) == 0U) {
+        if ((HAL_GetTick() - start) > RNG_ENTROPY_TIMEOUT_MS) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_INTERNAL_ERROR, PH_COMP_GENERIC);
+        }
+    }
+    __HAL_RCC_RNG_CONFIG(RCC_RNGCLKSOURCE_HSI48);
+    __HAL_RCC_RNG_CLK_ENABLE();
+
+    RNG->CR |= RNG_CR_RNGEN;
+    s_have_last = 0;
+    return PH_ERR_SUCCESS;
+}
+
+static phStatus_t RngEntropy_Word(uint32_t *pWord)
+{
+    uint32_t start = HAL_GetTick();
+    uint32_t sr;
+
+    for (;;) {
+        sr = RNG->SR;
+        if ((sr & (RNG_SR_SECS | RNG_SR_SEIS)) != 0U) {
+            RngEntropy_Restart();
+        } else if ((sr & RNG_SR_CEIS) != 0U) {
+            /* Clock error, the word in DR is not to be trusted */
+            RNG->SR &= ~RNG_SR_CEIS;
+            (void)RNG->DR;
+        } else if ((sr & RNG_SR_DRDY) != 0U) {
+            *pWord = RNG->DR;
+            /* Repetition test: two equal words in a row mean a stuck source */
+            if (!s_have_last || *pWord != s_last_word) {
+                s_last_word = *pWord;
+                s_have_last = 1;
+                return PH_ERR_SUCCESS;
+            }
+        }
+        if ((HAL_GetTick() - start) > RNG_ENTROPY_TIMEOUT_MS) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_GENERIC);
+        }
+    }
+}
+
+phStatus_t RngEntropy_Read(void *ctx, uint8_t *buf, uint16_t len)
+{
+    phStatus_t status;
+    uint32_t word;
+    uint16_t n;
+
+    (void)ctx;
+    while (len > 0U) {
+        PH_CHECK_SUCCESS_FCT(status, RngEntropy_Word(&word));
+        n = (len < 4U) ? len : 4U;
+        memcpy(buf, &word, n);
+        buf += n;
+        len = (uint16_t)(len - n);
+    }
+    word = 0;
+    return PH_ERR_SUCCESS;
+}
+
+#else /* Host stand-in */
+
+phStatus_t RngEntropy_Init(void)
+{
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t RngEntropy_Read(void *ctx, uint8_t *buf, uint16_t len)
+{
+    FILE *f = fopen(RNG_ENTROPY_HOST_FILE, "rb");
+    size_t got;
+
+    (void)ctx;
+    if (f == NULL) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_GENERIC);
+    }
+    got = fread(buf, 1, len, f);
+    fclose(f);
+    return (got == len) ? PH_ERR_SUCCESS : PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_GENERIC);
+}
+
+#endif /* STM32L431xx */
+
+/* ================== DRBG pool ================== */
+
+static void RngEntropy_RefillTask(void *ctx)
+{
+    (void)phCryptoRng_Sw_RefillPool((phCryptoRng_Sw_DataParams_t *)ctx);
+}
+
+phStatus_t RngEntropy_AttachDrbg(void *pCryptoRng)
+{
+    phStatus_t status;
+
+    if (pCryptoRng == NULL || PH_GET_COMPID(pCryptoRng) != PH_CRYPTORNG_SW_ID) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_DATA_PARAMS, PH_COMP_GENERIC);
+    }
+    s_drbg = (phCryptoRng_Sw_DataParams_t *)pCryptoRng;
+
+    PH_CHECK_SUCCESS_FCT(status, RngEntropy_Init());
+    PH_CHECK_SUCCESS_FCT(status, phCryptoRng_Sw_SetEntropySource(s_drbg, RngEntropy_Read, NULL,
+                                                                 RNG_ENTROPY_RESEED_INTERVAL));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoRng_Sw_RefillPool(s_drbg));
+
+    (void)EMV_Sched_RegisterTask(RngEntropy_RefillTask, s_drbg);
+    DEBUG_PRINTF("DRBG seeded from hardware entropy, pool %d bytes\r\n", s_drbg->wPoolLen);
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t RngEntropy_DeferAttach(void *pCryptoRng)
+{
+    if (pCryptoRng == NULL || PH_GET_COMPID(pCryptoRng) != PH_CRYPTORNG_SW_ID) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_DATA_PARAMS, PH_COMP_GENERIC);
+    }
+    s_pending = pCryptoRng;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t RngEntropy_AttachPending(void)
+{
+    void *p = s_pending;
+
+    if (p == NULL) {
+        return PH_ERR_SUCCESS;
+    }
+    s_pending = NULL;
+    return RngEntropy_AttachDrbg(p);
+}
+
+void RngEntropy_Idle(void)
+{
+    if (s_pending != NULL) {
+        (void)RngEntropy_AttachPending();
+        return;
+    }
+    if (s_drbg != NULL && s_drbg->wPoolLen < PH_CRYPTORNG_SW_POOL_SIZE) {
+        (void)phCryptoRng_Sw_RefillPool(s_drbg);
+    }
+}
@@ -22,6 +22,7 @@
 #include "stm32l4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "feedback.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -242,5 +243,15 @@ void USART1_IRQHandler(void)
 }
 
 /* USER CODE BEGIN 1 */
-
+/**
+  * @brief This function handles TIM7 global interrupt, feedback pattern edges.
+  */
+void TIM7_IRQHandler(void)
+{
+  if (TIM7->SR & TIM_SR_UIF)
+  {
+    TIM7->SR = (uint32_t)~TIM_SR_UIF;
+    Feedback_OnTimer();
+  }
+}
 /* USER CODE END 1 */
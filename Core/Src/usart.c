@@ -21,6 +21,8 @@
 #include "usart.h"
 
 /* USER CODE BEGIN 0 */
+#include "emv_sched.h"
+
 static uint8_t		s_uart1_rxch;		/* 一个字节(字符)的中断服务处理程序 所用的暂存器 */
 char				g_uart1_rxbuf[256];	/* 接收到的所有字符 */
 uint8_t				g_uart1_bytes;		/* 指向实际的 buf 大小 */
@@ -139,6 +141,11 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
 #endif
 PUTCHAR_PROTOTYPE
 {
+	/* While the EMV uplink streams records, the text goes through its ring and never splits a frame */
+	if( EMV_Uplink_PutChar((uint8_t)ch) )
+	{
+		return ch;
+	}
 	HAL_UART_Transmit(&huart1, (uint8_t *)&ch, 1, 0xFFFF);
 	return ch;
 }
@@ -158,4 +165,16 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 		HAL_UART_Receive_IT(&huart1, &s_uart1_rxch, 1);
 	}
 }
+
+/* 中断接收占着 huart1 时 HAL_UART_Receive 返回 HAL_BUSY，先停掉单字节中断接收 */
+void uart1_rx_pause(void)
+{
+	HAL_UART_AbortReceive_IT(&huart1);
+}
+
+/* 重新使能单字节中断接收 */
+void uart1_rx_resume(void)
+{
+	HAL_UART_Receive_IT(&huart1, &s_uart1_rxch, 1);
+}
 /* USER CODE END 1 */
@@ -95,6 +95,33 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Zero fill the RAM2 bss segment. */
+  ldr r2, =_sram2_bss
+  ldr r4, =_eram2_bss
+  b LoopFillZeroRam2
+
+FillZeroRam2:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopFillZeroRam2:
+  cmp r2, r4
+  bcc FillZeroRam2
+
+/* Paint the free RAM up to the stack pointer for the stack watermark. */
+  ldr r2, =_end
+  mov r4, sp
+  ldr r3, =0xA5A5A5A5
+  b LoopPaintStack
+
+PaintStack:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopPaintStack:
+  cmp r2, r4
+  bcc PaintStack
+
 /* Call static constructors */
     bl __libc_init_array
 /* Call the application's entry point.*/
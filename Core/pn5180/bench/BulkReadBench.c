@@ -0,0 +1,2048 @@
+/*
+ * BulkReadBench.c
+ *
+ * Multi-card inventories and whole-card reads of the application modules
+ * against simulated cards behind the PAL / HAL stubs below. The real module
+ * sources are linked, time is the simulated air time of every frame, which
+ * also drives the time budgets of the modules.
+ * Results are written as JSON to stdout.
+ *
+ * Usage: bulk_read_bench
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include <ph_Status.h>
+#include <phhalHw.h>
+#include <phpalI14443p3a.h>
+#include <phpalI18000p3m3.h>
+#include <phpalMifare.h>
+#include <phpalSli15693.h>
+#include <phalICode.h>
+#include <phpalFelica.h>
+#include <phalFelica.h>
+#include "inventory_a.h"
+#include "inventory_epc.h"
+#include "mfc_dump.h"
+#include "icode_bulk.h"
+#include "felica_batch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef NFCRDLIB_BENCH_REV
+#define NFCRDLIB_BENCH_REV              "unknown"
+#endif
+
+/* ================== Configuration ================== */
+
+/* Type A air time at 106 kbit/s: frame, FDT and answer, timeouts as set by the PAL */
+#define BENCH_A_REQA_US                 250U
+#define BENCH_A_ANTICOLL_US             750U        /* SEL NVB + up to 5 bytes back */
+#define BENCH_A_SELECT_US               1100U       /* 9 bytes with CRC + SAK */
+#define BENCH_A_HLTA_US                 1250U       /* No answer, the PAL waits out the 1 ms timeout */
+#define BENCH_A_TIMEOUT_US              350U        /* Nobody answered */
+#define BENCH_A_MAX_CARDS               20U
+#define BENCH_A_BUDGET_MS               1000U
+
+/* ISO18000-3m3 at 847 kHz Manchester 4, run by the PN5180 inventory engine */
+#define BENCH_EPC_BEGIN_ROUND_US        700U
+#define BENCH_EPC_EMPTY_US              350U        /* NextSlot, no RN16 within T1 + T3 */
+#define BENCH_EPC_COLLISION_US          1200U       /* Garbled RN16 */
+#define BENCH_EPC_SUCCESS_US            3400U       /* RN16, ACK, PC + UII */
+#define BENCH_EPC_RX_SIZE               256U        /* HAL Rx buffer the round result is drained through */
+#define BENCH_EPC_MAX_TAGS              500U
+#define BENCH_EPC_VERIFY_TAGS           64U         /* Every population up to this one is verified */
+#define BENCH_EPC_SWEEP_BUDGET_MS       10000U      /* Budget and rounds of the report, enough for 500 tags */
+#define BENCH_EPC_SWEEP_ROUNDS          64U
+#define BENCH_EPC_SWEEP_SEEDS           16U
+#define BENCH_EPC_UII_LEN               12U         /* EPC-96 */
+#define BENCH_EPC_CMD_BEGIN_ROUND       0x08U       /* phpalI18000p3m3_Sw_Int.h */
+
+/* MIFARE Classic at 106 kbit/s */
+#define BENCH_MFC_AUTH_US               2200U       /* Three pass authentication */
+#define BENCH_MFC_AUTH_FAIL_US          1600U       /* Card stays silent after the reader token */
+#define BENCH_MFC_READ_US               1500U       /* READ + 16 bytes and CRC */
+#define BENCH_MFC_ACTIVATE_US           3200U       /* WUPA, ANTICOLLISION, SELECT of a known UID */
+#define BENCH_MFC_FIELD_RESET_US        10200U      /* Field off 5.1 ms + guard time */
+#define BENCH_MFC_SECTORS               40U
+#define BENCH_MFC_KEY_UNKNOWN           0xFFU       /* Sector key not in the reader's list */
+
+/* ISO15693, addressed requests: 1 out of 4 at 26.48 kbit/s, replies at the selected rate */
+#define BENCH_V_BYTE_26_CUS             30208U      /* Byte time in 1/100 us at 26.48 kbit/s */
+#define BENCH_V_T1_US                   320U
+#define BENCH_V_SOF_EOF_US              150U
+#define BENCH_V_TIMEOUT_US              1000U       /* No answer to a command the tag does not know */
+#define BENCH_V_RX_BUFSIZE              600U        /* PH_NXPNFCRDLIB_CONFIG_HAL_RX_BUFFSIZE */
+#define BENCH_V_MAX_BYTES               2048U
+
+/* FeliCa: byte times with preamble, sync and CRC per frame, card response times from a typical PMm */
+#define BENCH_F_BYTE_212_CUS            3776U       /* Byte time in 1/100 us at 212 kbit/s */
+#define BENCH_F_FRAME_BYTES             10U         /* Preamble 6, sync 2, CRC 2 */
+#define BENCH_F_REQC_US                 2417U       /* Until the end of slot 0 */
+#define BENCH_F_SLOT_US                 1208U
+#define BENCH_F_READ_US                 600U        /* Plus BENCH_F_READ_BLOCK_US per block */
+#define BENCH_F_READ_BLOCK_US           300U
+#define BENCH_F_WRITE_BLOCK_US          2400U
+#define BENCH_F_TIMEOUT_US              2000U
+#define BENCH_F_MAX_CARDS               10U
+#define BENCH_F_LOG_SIZE                64U         /* Blocks written per run */
+#define BENCH_F_IC_LITE_S               0xF1U
+#define BENCH_F_IC_STANDARD             0x32U
+
+/* ================== Simulated time ================== */
+
+static uint64_t s_sim_us;
+
+static void Bench_Air(uint32_t us)
+{
+    s_sim_us += us;
+}
+
+uint32_t InventoryA_HostTick(void)
+{
+    return (uint32_t)(s_sim_us / 1000U);
+}
+
+uint32_t InventoryEpc_HostTick(void)
+{
+    return (uint32_t)(s_sim_us / 1000U);
+}
+
+uint32_t MfcDump_HostTick(void)
+{
+    return (uint32_t)(s_sim_us / 1000U);
+}
+
+uint32_t IcodeBulk_HostTick(void)
+{
+    return (uint32_t)(s_sim_us / 1000U);
+}
+
+uint32_t FelicaBatch_HostTick(void)
+{
+    return (uint32_t)(s_sim_us / 1000U);
+}
+
+/* ================== HAL stubs ================== */
+
+static phhalHw_Pn5180_DataParams_t s_hal;
+static uint8_t s_hal_cardtype;
+
+phStatus_t phhalHw_Pn5180_ApplyProtocolSettings(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t bCardType)
+{
+    (void)pDataParams;
+    s_hal_cardtype = bCardType;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_FieldOn(phhalHw_Pn5180_DataParams_t *pDataParams)
+{
+    (void)pDataParams;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_Wait(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t bUnit, uint16_t wTimeout)
+{
+    (void)pDataParams;
+    Bench_Air((bUnit == PHHAL_HW_TIME_MILLISECONDS) ? (uint32_t)wTimeout * 1000U : wTimeout);
+    return PH_ERR_SUCCESS;
+}
+
+/* ================== Type A cards behind the ISO14443-3A PAL ================== */
+
+typedef enum {
+    BENCH_A_IDLE = 0,
+    BENCH_A_READY,
+    BENCH_A_ACTIVE,
+    BENCH_A_HALT
+} Bench_AState_t;
+
+typedef struct {
+    uint8_t uid[10];
+    uint8_t uid_len;
+    uint8_t sak;
+    uint8_t atqa[2];
+    uint8_t state;
+    uint8_t level;                  /* Cascade level the card is at while READY */
+} Bench_ACard_t;
+
+static phpalI14443p3a_Sw_DataParams_t s_pal_a;
+static Bench_ACard_t s_a_cards[BENCH_A_MAX_CARDS];
+static uint32_t s_a_count;
+static int32_t s_a_selected = -1;
+
+/* UID CLn of a card: cascade tag 0x88 in front while the UID continues */
+static void Bench_ACl(const Bench_ACard_t *card, uint8_t level, uint8_t *cl)
+{
+    uint8_t levels = (uint8_t)((card->uid_len == 4U) ? 1U : ((card->uid_len == 7U) ? 2U : 3U));
+
+    if (level + 1U < levels) {
+        cl[0] = 0x88;
+        memcpy(&cl[1], &card->uid[level * 3U], 3U);
+    } else {
+        memcpy(cl, &card->uid[level * 3U], 4U);
+    }
+}
+
+static uint8_t Bench_ALevel(uint8_t bCascadeLevel)
+{
+    return (bCascadeLevel == PHPAL_I14443P3A_CASCADE_LEVEL_1) ? 0U :
+           ((bCascadeLevel == PHPAL_I14443P3A_CASCADE_LEVEL_2) ? 1U : 2U);
+}
+
+static uint8_t Bench_ABit(const uint8_t *uid, uint32_t bit)
+{
+    return (uint8_t)((uid[bit / 8U] >> (bit % 8U)) & 1U);
+}
+
+phStatus_t phpalI14443p3a_Sw_RequestA(phpalI14443p3a_Sw_DataParams_t *pDataParams, uint8_t *pAtqa)
+{
+    uint32_t answered = 0;
+    uint8_t differ = 0;
+
+    (void)pDataParams;
+    for (uint32_t i = 0; i < s_a_count; i++) {
+        if (s_a_cards[i].state == BENCH_A_HALT) {
+            continue;
+        }
+        s_a_cards[i].state = BENCH_A_READY;
+        s_a_cards[i].level = 0;
+        if (answered != 0U && (pAtqa[0] != s_a_cards[i].atqa[0] || pAtqa[1] != s_a_cards[i].atqa[1])) {
+            differ = 1;
+        }
+        pAtqa[0] = (uint8_t)((answered ? pAtqa[0] : 0U) | s_a_cards[i].atqa[0]);
+        pAtqa[1] = (uint8_t)((answered ? pAtqa[1] : 0U) | s_a_cards[i].atqa[1]);
+        answered++;
+    }
+    s_a_selected = -1;
+
+    if (answered == 0U) {
+        Bench_Air(BENCH_A_TIMEOUT_US);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_ISO14443P3A);
+    }
+    Bench_Air(BENCH_A_REQA_US);
+    return differ ? PH_ADD_COMPCODE_FIXED(PH_ERR_COLLISION_ERROR, PH_COMP_PAL_ISO14443P3A) : PH_ERR_SUCCESS;
+}
+
+phStatus_t phpalI14443p3a_Sw_Anticollision(phpalI14443p3a_Sw_DataParams_t *pDataParams, uint8_t bCascadeLevel,
+                                           uint8_t *pUidIn, uint8_t bNvbUidIn, uint8_t *pUidOut, uint8_t *pNvbUidOut)
+{
+    uint8_t level = Bench_ALevel(bCascadeLevel);
+    uint32_t known = ((uint32_t)(bNvbUidIn >> 4) * 8U) + (bNvbUidIn & 0x07U);
+    uint8_t first[4], cl[4], in[5];
+    uint32_t answered = 0;
+    uint32_t coll = 32U;
+
+    (void)pDataParams;
+    memcpy(in, pUidIn, sizeof(in));
+    for (uint32_t i = 0; i < s_a_count; i++) {
+        uint32_t b;
+
+        if (s_a_cards[i].state != BENCH_A_READY || s_a_cards[i].level != level) {
+            continue;
+        }
+        Bench_ACl(&s_a_cards[i], level, cl);
+        for (b = 0; b < known && Bench_ABit(cl, b) == Bench_ABit(in, b); b++) {
+        }
+        if (b < known) {
+            continue;
+        }
+        if (answered++ == 0U) {
+            memcpy(first, cl, sizeof(first));
+            continue;
+        }
+        for (b = known; b < coll && Bench_ABit(cl, b) == Bench_ABit(first, b); b++) {
+        }
+        coll = b;
+    }
+
+    if (answered == 0U) {
+        Bench_Air(BENCH_A_TIMEOUT_US);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_ISO14443P3A);
+    }
+    Bench_Air(BENCH_A_ANTICOLL_US);
+
+    /* Bits up to the first one the cards disagree on */
+    memset(pUidOut, 0, 5U);
+    memcpy(pUidOut, first, (coll + 7U) / 8U);
+    if ((coll % 8U) != 0U) {
+        pUidOut[coll / 8U] &= (uint8_t)((1U << (coll % 8U)) - 1U);
+    }
+    *pNvbUidOut = (uint8_t)(((coll / 8U) << 4) | (coll % 8U));
+    return (coll < 32U) ? PH_ADD_COMPCODE_FIXED(PH_ERR_COLLISION_ERROR, PH_COMP_PAL_ISO14443P3A) : PH_ERR_SUCCESS;
+}
+
+phStatus_t phpalI14443p3a_Sw_Select(phpalI14443p3a_Sw_DataParams_t *pDataParams, uint8_t bCascadeLevel,
+                                    uint8_t *pUidIn, uint8_t *pSak)
+{
+    uint8_t level = Bench_ALevel(bCascadeLevel);
+    uint32_t answered = 0;
+    uint8_t cl[4];
+
+    (void)pDataParams;
+    for (uint32_t i = 0; i < s_a_count; i++) {
+        Bench_ACard_t *card = &s_a_cards[i];
+
+        if (card->state != BENCH_A_READY || card->level != level) {
+            continue;
+        }
+        Bench_ACl(card, level, cl);
+        if (memcmp(cl, pUidIn, 4U) != 0) {
+            /* SELECT of another UID sends a READY card back to IDLE */
+            card->state = BENCH_A_IDLE;
+            continue;
+        }
+        answered++;
+
+        /* Cards sharing this cascade level all move on to the next one */
+        if (cl[0] == 0x88U) {
+            card->level++;
+            *pSak = 0x04;
+        } else {
+            card->state = BENCH_A_ACTIVE;
+            s_a_selected = (int32_t)i;
+            *pSak = card->sak;
+        }
+    }
+
+    if (answered == 0U) {
+        Bench_Air(BENCH_A_TIMEOUT_US);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_ISO14443P3A);
+    }
+    Bench_Air(BENCH_A_SELECT_US);
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phpalI14443p3a_Sw_HaltA(phpalI14443p3a_Sw_DataParams_t *pDataParams)
+{
+    (void)pDataParams;
+    Bench_Air(BENCH_A_HLTA_US);
+    if (s_a_selected >= 0) {
+        s_a_cards[s_a_selected].state = BENCH_A_HALT;
+        s_a_selected = -1;
+    }
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phpalI14443p3a_Sw_GetSerialNo(phpalI14443p3a_Sw_DataParams_t *pDataParams, uint8_t *pUidOut,
+                                         uint8_t *pLenUidOut)
+{
+    (void)pDataParams;
+    if (s_a_selected < 0) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_PAL_ISO14443P3A);
+    }
+    memcpy(pUidOut, s_a_cards[s_a_selected].uid, s_a_cards[s_a_selected].uid_len);
+    *pLenUidOut = s_a_cards[s_a_selected].uid_len;
+    return PH_ERR_SUCCESS;
+}
+
+/*
+ * Field with n cards. Adversarial: all UIDs equal up to the last byte, so every
+ * card is told apart only in the last bits. Mixed: 4, 7 and 10 byte UIDs, the
+ * longer ones sharing their first cascade level.
+ */
+#define BENCH_A_ADVERSARIAL             0U
+#define BENCH_A_MIXED                   1U
+
+static void Bench_ALoad(uint32_t n, uint8_t mix)
+{
+    static const uint8_t sizes[3] = { 4U, 7U, 10U };
+
+    memset(s_a_cards, 0, sizeof(s_a_cards));
+    s_a_count = n;
+    s_a_selected = -1;
+    s_sim_us = 0;
+    s_pal_a.pHalDataParams = &s_hal;
+
+    for (uint32_t i = 0; i < n; i++) {
+        Bench_ACard_t *card = &s_a_cards[i];
+
+        card->uid_len = (mix == BENCH_A_MIXED) ? sizes[i % 3U] : 4U;
+        card->uid[0] = 0x04;
+        for (uint8_t b = 1; b < card->uid_len; b++) {
+            card->uid[b] = 0xA5;
+        }
+        /* Bit reversed index in the last byte: neighbours differ in the last bit sent */
+        card->uid[card->uid_len - 1U] = (uint8_t)(((i & 1U) << 7) | ((i & 2U) << 5) | ((i & 4U) << 3) |
+                                                  ((i & 8U) << 1) | ((i & 16U) >> 1));
+        card->sak = (card->uid_len == 4U) ? 0x08U : 0x00U;
+        card->atqa[0] = (uint8_t)((card->uid_len == 4U) ? 0x04U : ((card->uid_len == 7U) ? 0x44U : 0x84U));
+        card->atqa[1] = 0x00;
+    }
+}
+
+/* Every card of the field reported once with its UID and final SAK */
+static uint8_t Bench_AFoundAll(const InventoryA_Result_t *result)
+{
+    if (result->count != s_a_count) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < s_a_count; i++) {
+        uint32_t hits = 0;
+
+        for (uint32_t j = 0; j < result->count; j++) {
+            if (result->cards[j].uid_len == s_a_cards[i].uid_len &&
+                memcmp(result->cards[j].uid, s_a_cards[i].uid, s_a_cards[i].uid_len) == 0 &&
+                result->cards[j].sak == s_a_cards[i].sak) {
+                hits++;
+            }
+        }
+        if (hits != 1U) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ================== ISO18000-3m3 tags behind the PN5180 inventory engine ================== */
+
+typedef struct {
+    uint8_t uii[BENCH_EPC_UII_LEN];
+    uint8_t flag_b;                 /* Inventoried flag of the session is B: out of the rounds */
+    uint16_t slot;                  /* Slot picked in the current round */
+} Bench_EpcTag_t;
+
+static phpalI18000p3m3_Sw_DataParams_t s_pal_epc;
+static Bench_EpcTag_t s_epc_tags[BENCH_EPC_MAX_TAGS];
+static uint32_t s_epc_count;
+static uint32_t s_epc_rng;
+static uint32_t s_epc_slot;         /* Next slot of the round to report */
+static uint32_t s_epc_slots;        /* Slots of the round, 2^Q */
+static uint32_t s_epc_resumes;
+static uint8_t s_epc_rx[BENCH_EPC_RX_SIZE];
+
+static uint32_t Bench_EpcRand(void)
+{
+    s_epc_rng ^= s_epc_rng << 13;
+    s_epc_rng ^= s_epc_rng >> 17;
+    s_epc_rng ^= s_epc_rng << 5;
+    return s_epc_rng;
+}
+
+phStatus_t phpalI18000p3m3_Sw_CreateBeginRoundCmd(phpalI18000p3m3_Sw_DataParams_t *pDataParams, uint8_t bDr,
+                                                  uint8_t bM, uint8_t bTRext, uint8_t bSel, uint8_t bSession,
+                                                  uint8_t bRfu, uint8_t bQ, uint8_t *pBeginRnd)
+{
+    if (bQ > 0x0FU) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_PAL_I18000P3M3);
+    }
+    pDataParams->bSession = bSession;
+    pBeginRnd[0] = (uint8_t)((BENCH_EPC_CMD_BEGIN_ROUND << 4U) | (bDr << 3U) | (bM << 1U) | (bTRext ? 1U : 0U));
+    pBeginRnd[1] = (uint8_t)((bSel << 6U) | (bSession << 4U) | (bRfu << 3U) | (bQ >> 1U));
+    pBeginRnd[2] = (uint8_t)(bQ << 7U);
+    return PH_ERR_SUCCESS;
+}
+
+/* Select with an empty mask: every tag back to A */
+phStatus_t phpalI18000p3m3_Sw_Select(phpalI18000p3m3_Sw_DataParams_t *pDataParams, uint8_t bTarget,
+                                     uint8_t bAction, uint8_t bMemBank, uint8_t *pPointer, uint8_t bPointerLength,
+                                     uint8_t *pMask, uint8_t bMaskBitLength, uint8_t bTruncate)
+{
+    (void)pDataParams;
+    (void)bTarget;
+    (void)bAction;
+    (void)bMemBank;
+    (void)pPointer;
+    (void)bPointerLength;
+    (void)pMask;
+    (void)bMaskBitLength;
+    (void)bTruncate;
+    for (uint32_t i = 0; i < s_epc_count; i++) {
+        s_epc_tags[i].flag_b = 0;
+    }
+    Bench_Air(BENCH_EPC_BEGIN_ROUND_US);
+    return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_I18000P3M3);
+}
+
+/* Slot records of the round from s_epc_slot on, until the Rx buffer is full */
+static phStatus_t Bench_EpcDrain(uint8_t **ppRxBuffer, uint16_t *wRxBufferLen)
+{
+    uint16_t len = 0;
+
+    while (s_epc_slot < s_epc_slots) {
+        uint32_t hits = 0;
+        uint32_t tag = 0;
+
+        for (uint32_t i = 0; i < s_epc_count; i++) {
+            if (!s_epc_tags[i].flag_b && s_epc_tags[i].slot == s_epc_slot) {
+                hits++;
+                tag = i;
+            }
+        }
+        if (len + ((hits == 1U) ? 3U + 2U + BENCH_EPC_UII_LEN : 3U) > BENCH_EPC_RX_SIZE) {
+            break;
+        }
+
+        if (hits == 0U) {
+            s_epc_rx[len++] = 2;
+            Bench_Air(BENCH_EPC_EMPTY_US);
+        } else if (hits > 1U) {
+            s_epc_rx[len++] = 3;
+            Bench_Air(BENCH_EPC_COLLISION_US);
+        } else {
+            /* PC: 6 UII words, no XPC */
+            s_epc_rx[len++] = 0;
+            s_epc_rx[len++] = (uint8_t)(2U + BENCH_EPC_UII_LEN);
+            s_epc_rx[len++] = 0;
+            s_epc_rx[len++] = 0x30;
+            s_epc_rx[len++] = 0x00;
+            memcpy(&s_epc_rx[len], s_epc_tags[tag].uii, BENCH_EPC_UII_LEN);
+            len = (uint16_t)(len + BENCH_EPC_UII_LEN);
+            s_epc_tags[tag].flag_b = 1;
+            Bench_Air(BENCH_EPC_SUCCESS_US);
+            s_epc_slot++;
+            continue;
+        }
+        s_epc_rx[len++] = 0;
+        s_epc_rx[len++] = 0;
+        s_epc_slot++;
+    }
+
+    *ppRxBuffer = s_epc_rx;
+    *wRxBufferLen = len;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_I18000p3m3Inventory(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t *pSelCmd,
+                                              uint8_t bSelCmdLen, uint8_t bNumValidBitsinLastByte,
+                                              uint8_t *pBeginRndCmd, uint8_t bTSprocessing,
+                                              uint8_t **ppRxBuffer, uint16_t *wRxBufferLen)
+{
+    uint8_t q = (uint8_t)(((pBeginRndCmd[1] & 0x07U) << 1) | (pBeginRndCmd[2] >> 7));
+
+    (void)pDataParams;
+    (void)pSelCmd;
+    (void)bSelCmdLen;
+    (void)bNumValidBitsinLastByte;
+    (void)bTSprocessing;
+
+    /* Every tag still at A picks its slot */
+    s_epc_slots = 1UL << q;
+    s_epc_slot = 0;
+    for (uint32_t i = 0; i < s_epc_count; i++) {
+        s_epc_tags[i].slot = (uint16_t)(Bench_EpcRand() & (s_epc_slots - 1U));
+    }
+    Bench_Air(BENCH_EPC_BEGIN_ROUND_US);
+    return Bench_EpcDrain(ppRxBuffer, wRxBufferLen);
+}
+
+phStatus_t phhalHw_Pn5180_18000p3m3ResumeInventory(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t **ppRxBuffer,
+                                                   uint16_t *wRxBufferLen)
+{
+    (void)pDataParams;
+    s_epc_resumes++;
+    return Bench_EpcDrain(ppRxBuffer, wRxBufferLen);
+}
+
+static void Bench_EpcLoad(uint32_t n)
+{
+    memset(s_epc_tags, 0, sizeof(s_epc_tags));
+    s_epc_count = n;
+    s_epc_rng = 0x2545F491U;
+    s_epc_resumes = 0;
+    s_sim_us = 0;
+    s_pal_epc.pHalDataParams = &s_hal;
+
+    for (uint32_t i = 0; i < n; i++) {
+        s_epc_tags[i].uii[0] = 0xE2;
+        s_epc_tags[i].uii[BENCH_EPC_UII_LEN - 2U] = (uint8_t)(i >> 8);
+        s_epc_tags[i].uii[BENCH_EPC_UII_LEN - 1U] = (uint8_t)i;
+    }
+}
+
+/* Every tag read once, the stored ones with their UII */
+static uint8_t Bench_EpcFoundAll(const InventoryEpc_Result_t *result)
+{
+    uint32_t stored = (s_epc_count < INVENTORY_EPC_MAX_TAGS) ? s_epc_count : INVENTORY_EPC_MAX_TAGS;
+
+    if (result->tags_seen != s_epc_count || result->count != stored) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < s_epc_count; i++) {
+        if (!s_epc_tags[i].flag_b) {
+            return 0;
+        }
+    }
+    for (uint32_t j = 0; j < result->count; j++) {
+        uint32_t i = ((uint32_t)result->tags[j].uii[BENCH_EPC_UII_LEN - 2U] << 8) |
+                     result->tags[j].uii[BENCH_EPC_UII_LEN - 1U];
+
+        if (result->tags[j].uii_len != BENCH_EPC_UII_LEN || i >= s_epc_count ||
+            memcmp(result->tags[j].uii, s_epc_tags[i].uii, BENCH_EPC_UII_LEN) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ================== MIFARE Classic card behind the MIFARE PAL ================== */
+
+typedef enum {
+    BENCH_MFC_IDLE = 0,
+    BENCH_MFC_ACTIVE,
+    BENCH_MFC_AUTH
+} Bench_MfcState_t;
+
+/* Keys of the reader's list, index 4 is on no list */
+static const uint8_t s_mfc_keys[5][PHPAL_MIFARE_KEY_LENGTH] = {
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },
+    { 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5 },
+    { 0xD3, 0xF7, 0xD3, 0xF7, 0xD3, 0xF7 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x4D, 0x3A, 0x99, 0xC3, 0x51, 0xDD },
+};
+#define BENCH_MFC_LIST_KEYS             4U
+
+typedef struct {
+    uint8_t uid[4];
+    uint8_t sak;
+    uint8_t key_a[BENCH_MFC_SECTORS];           /* Index into s_mfc_keys or BENCH_MFC_KEY_UNKNOWN */
+    uint8_t key_b[BENCH_MFC_SECTORS];
+    uint8_t deny_a[BENCH_MFC_SECTORS];          /* Access bits: data blocks not readable with key A */
+    uint8_t state;
+    uint8_t sector;                             /* Authenticated sector */
+    uint8_t key_type;
+    uint8_t wupa_fail;                          /* WUPA attempts that go unanswered */
+} Bench_MfcCard_t;
+
+static phpalI14443p3a_Sw_DataParams_t s_pal_mfc3a;
+static phpalMifare_Sw_DataParams_t s_pal_mfc;
+static Bench_MfcCard_t s_mfc;
+static uint8_t s_mfc_rx[MFC_DUMP_BLOCK_SIZE];
+
+static uint8_t Bench_MfcSector(uint8_t block)
+{
+    return (block < 128U) ? (uint8_t)(block / 4U) : (uint8_t)(32U + (block - 128U) / 16U);
+}
+
+static uint8_t Bench_MfcTrailer(uint8_t block)
+{
+    return (block < 128U) ? ((block % 4U) == 3U) : ((block % 16U) == 15U);
+}
+
+/* Block content as stored on the card, keys read back as 0 */
+static void Bench_MfcBlock(uint8_t block, uint8_t *out)
+{
+    if (Bench_MfcTrailer(block)) {
+        memset(out, 0, MFC_DUMP_BLOCK_SIZE);
+        out[6] = 0xFF;
+        out[7] = 0x07;
+        out[8] = 0x80;
+        out[9] = 0x69;
+        return;
+    }
+    for (uint8_t i = 0; i < MFC_DUMP_BLOCK_SIZE; i++) {
+        out[i] = (uint8_t)(block * 7U + i + s_mfc.uid[0]);
+    }
+}
+
+phStatus_t phhalHw_Pn5180_SetConfig(phhalHw_Pn5180_DataParams_t *pDataParams, uint16_t wConfig, uint16_t wValue)
+{
+    (void)pDataParams;
+    (void)wConfig;
+    (void)wValue;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_FieldReset(phhalHw_Pn5180_DataParams_t *pDataParams)
+{
+    (void)pDataParams;
+    Bench_Air(BENCH_MFC_FIELD_RESET_US);
+    s_mfc.state = BENCH_MFC_IDLE;
+    s_mfc.wupa_fail = 0;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phpalI14443p3a_Sw_ActivateCard(phpalI14443p3a_Sw_DataParams_t *pDataParams, uint8_t *pUidIn,
+                                          uint8_t bLenUidIn, uint8_t *pUidOut, uint8_t *pLenUidOut, uint8_t *pSak,
+                                          uint8_t *pMoreCardsAvailable)
+{
+    (void)pDataParams;
+    if (s_mfc.wupa_fail != 0U || bLenUidIn != 4U || memcmp(pUidIn, s_mfc.uid, 4U) != 0) {
+        if (s_mfc.wupa_fail != 0U) {
+            s_mfc.wupa_fail--;
+        }
+        Bench_Air(BENCH_A_TIMEOUT_US);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_ISO14443P3A);
+    }
+    Bench_Air(BENCH_MFC_ACTIVATE_US);
+    s_mfc.state = BENCH_MFC_ACTIVE;
+    memcpy(pUidOut, s_mfc.uid, 4U);
+    *pLenUidOut = 4;
+    *pSak = s_mfc.sak;
+    *pMoreCardsAvailable = 0;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phpalMifare_Sw_MfcAuthenticate(phpalMifare_Sw_DataParams_t *pDataParams, uint8_t bBlockNo,
+                                          uint8_t bKeyType, uint8_t *pKey, uint8_t *pUid)
+{
+    uint8_t sector = Bench_MfcSector(bBlockNo);
+    uint8_t key = (bKeyType == PHPAL_MIFARE_KEYA) ? s_mfc.key_a[sector] : s_mfc.key_b[sector];
+
+    (void)pDataParams;
+    if (s_mfc.state == BENCH_MFC_IDLE || memcmp(pUid, s_mfc.uid, 4U) != 0) {
+        Bench_Air(BENCH_A_TIMEOUT_US);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_MIFARE);
+    }
+    if (key == BENCH_MFC_KEY_UNKNOWN || memcmp(pKey, s_mfc_keys[key], PHPAL_MIFARE_KEY_LENGTH) != 0) {
+        /* Wrong key: the card drops out until the next WUPA */
+        Bench_Air(BENCH_MFC_AUTH_FAIL_US);
+        s_mfc.state = BENCH_MFC_IDLE;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_AUTH_ERROR, PH_COMP_PAL_MIFARE);
+    }
+    Bench_Air(BENCH_MFC_AUTH_US);
+    s_mfc.state = BENCH_MFC_AUTH;
+    s_mfc.sector = sector;
+    s_mfc.key_type = bKeyType;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phpalMifare_Sw_ExchangeL3(phpalMifare_Sw_DataParams_t *pDataParams, uint16_t wOption,
+                                     uint8_t *pTxBuffer, uint16_t wTxLength, uint8_t **ppRxBuffer,
+                                     uint16_t *pRxLength)
+{
+    uint8_t block = pTxBuffer[1];
+
+    (void)pDataParams;
+    (void)wOption;
+    *pRxLength = 0;
+    if (s_mfc.state != BENCH_MFC_AUTH || wTxLength != 2U || pTxBuffer[0] != 0x30U) {
+        Bench_Air(BENCH_A_TIMEOUT_US);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_MIFARE);
+    }
+    if (Bench_MfcSector(block) != s_mfc.sector ||
+        (s_mfc.key_type == PHPAL_MIFARE_KEYA && s_mfc.deny_a[s_mfc.sector] && !Bench_MfcTrailer(block))) {
+        /* NAK, the card leaves the session */
+        Bench_Air(BENCH_MFC_READ_US);
+        s_mfc.state = BENCH_MFC_IDLE;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_AUTH_ERROR, PH_COMP_PAL_MIFARE);
+    }
+    Bench_Air(BENCH_MFC_READ_US);
+    Bench_MfcBlock(block, s_mfc_rx);
+    *ppRxBuffer = s_mfc_rx;
+    *pRxLength = MFC_DUMP_BLOCK_SIZE;
+    return PH_ERR_SUCCESS;
+}
+
+/*
+ * Card with the UID byte given. Mixed keys: sector s opens with list key s % 4
+ * as key A, every fifth sector only with key B, as found on transit and access cards.
+ */
+#define BENCH_MFC_ALL_DEFAULT           0U
+#define BENCH_MFC_MIXED                 1U
+
+static void Bench_MfcLoad(uint8_t uid0, uint8_t sak, uint8_t keys)
+{
+    memset(&s_mfc, 0, sizeof(s_mfc));
+    s_mfc.uid[0] = uid0;
+    s_mfc.uid[1] = 0x5C;
+    s_mfc.uid[2] = 0x21;
+    s_mfc.uid[3] = 0x9E;
+    s_mfc.sak = sak;
+    s_mfc.state = BENCH_MFC_ACTIVE;
+    s_sim_us = 0;
+    s_pal_mfc3a.pHalDataParams = &s_hal;
+    s_pal_mfc.pHalDataParams = &s_hal;
+
+    for (uint8_t sct = 0; sct < BENCH_MFC_SECTORS; sct++) {
+        if (keys == BENCH_MFC_ALL_DEFAULT) {
+            s_mfc.key_a[sct] = 0;
+            s_mfc.key_b[sct] = 0;
+        } else if ((sct % 5U) == 4U) {
+            s_mfc.key_a[sct] = BENCH_MFC_KEY_UNKNOWN;
+            s_mfc.key_b[sct] = (uint8_t)(sct % BENCH_MFC_LIST_KEYS);
+        } else {
+            s_mfc.key_a[sct] = (uint8_t)(sct % BENCH_MFC_LIST_KEYS);
+            s_mfc.key_b[sct] = BENCH_MFC_KEY_UNKNOWN;
+        }
+    }
+}
+
+static phStatus_t Bench_MfcRun(uint8_t *data, uint16_t size, MfcDump_Result_t *result)
+{
+    return MfcDump_Run(&s_pal_mfc3a, &s_pal_mfc, s_mfc.uid, 4, s_mfc.sak, s_mfc_keys,
+                       (uint8_t)BENCH_MFC_LIST_KEYS, data, size, result);
+}
+
+/* Dump image of sector s: card content, the key that opened it in the trailer */
+static uint8_t Bench_MfcSectorOk(const uint8_t *data, const MfcDump_Result_t *result, uint8_t sct)
+{
+    uint8_t expect[MFC_DUMP_BLOCK_SIZE];
+    uint8_t code = result->sector_key[sct];
+    uint16_t offset = MfcDump_SectorOffset(sct);
+    uint8_t blocks = (uint8_t)((MfcDump_SectorOffset((uint8_t)(sct + 1U)) - offset) / MFC_DUMP_BLOCK_SIZE);
+    uint8_t first = (uint8_t)(offset / MFC_DUMP_BLOCK_SIZE);
+
+    for (uint8_t b = 0; b < blocks; b++) {
+        Bench_MfcBlock((uint8_t)(first + b), expect);
+        if (b + 1U == blocks) {
+            memcpy(&expect[(code & MFC_DUMP_KEY_B) ? 10U : 0U], s_mfc_keys[code & 0x7FU], PHPAL_MIFARE_KEY_LENGTH);
+        }
+        if (memcmp(&data[offset + b * MFC_DUMP_BLOCK_SIZE], expect, MFC_DUMP_BLOCK_SIZE) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static uint8_t Bench_MfcAllOk(const uint8_t *data, const MfcDump_Result_t *result)
+{
+    if (result->sectors_read != result->sectors) {
+        return 0;
+    }
+    for (uint8_t sct = 0; sct < result->sectors; sct++) {
+        if (!Bench_MfcSectorOk(data, result, sct)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ================== ISO15693 tag behind the ICODE AL ================== */
+
+typedef struct {
+    uint8_t uid[8];                 /* uid[6]: IC manufacturer, 0x04 NXP */
+    uint16_t blocks;
+    uint8_t block_size;
+    uint8_t fast;                   /* FAST READ variants supported */
+    uint8_t param;                  /* Answers ParameterRequest */
+    uint8_t bitrate;
+    uint8_t timing;
+    uint8_t rx_rate;                /* ICODE_BULK_RATE_xxx of the tag replies */
+    uint8_t tx_rate;                /* ICODE_BULK_RATE_xxx of the reader requests */
+    uint32_t sysinfo;               /* (Extended) GetSystemInformation requests */
+    uint32_t fast_errors;
+} Bench_VTag_t;
+
+static phalICode_Sw_DataParams_t s_al_icode;
+static phpalSli15693_Sw_DataParams_t s_pal_v;
+static Bench_VTag_t s_v;
+static uint8_t s_v_rx[32];
+
+/* Request of req bytes, reply of rsp data bytes plus flags and CRC at the given rate */
+static void Bench_VFrame(uint32_t req, uint32_t rsp, uint8_t rx_rate)
+{
+    Bench_Air((uint32_t)((req * (BENCH_V_BYTE_26_CUS >> s_v.tx_rate) + (rsp + 3U) * (BENCH_V_BYTE_26_CUS >> rx_rate)) /
+                         100U) + BENCH_V_T1_US + 2U * BENCH_V_SOF_EOF_US);
+}
+
+static uint8_t Bench_VByte(uint32_t offset)
+{
+    return (uint8_t)((offset * 3U) ^ s_v.uid[0]);
+}
+
+phStatus_t phhalHw_Pn5180_GetConfig(phhalHw_Pn5180_DataParams_t *pDataParams, uint16_t wConfig, uint16_t *pValue)
+{
+    (void)pDataParams;
+    if (wConfig != PHHAL_HW_CONFIG_RXBUFFER_BUFSIZE) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_PARAMETER, PH_COMP_HAL);
+    }
+    *pValue = BENCH_V_RX_BUFSIZE;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phpalSli15693_Sw_GetSerialNo(phpalSli15693_Sw_DataParams_t *pDataParams, uint8_t *pUid,
+                                        uint8_t *pUidLength)
+{
+    (void)pDataParams;
+    memcpy(pUid, s_v.uid, 8U);
+    *pUidLength = 8;
+    return PH_ERR_SUCCESS;
+}
+
+/* Info flags, UID, DSFID, AFI, blocks - 1, block size - 1, IC reference */
+phStatus_t phalICode_Sw_GetSystemInformation(phalICode_Sw_DataParams_t *pDataParams, uint8_t **ppSystemInfo,
+                                             uint16_t *pSystemInfoLen)
+{
+    (void)pDataParams;
+    s_v.sysinfo++;
+    s_v_rx[0] = 0x0F;
+    memcpy(&s_v_rx[1], s_v.uid, 8U);
+    s_v_rx[9] = 0x00;
+    s_v_rx[10] = 0x00;
+    s_v_rx[11] = (uint8_t)((s_v.blocks > 256U) ? 0xFFU : (s_v.blocks - 1U));
+    s_v_rx[12] = (uint8_t)(s_v.block_size - 1U);
+    s_v_rx[13] = 0x01;
+    *ppSystemInfo = s_v_rx;
+    *pSystemInfoLen = 14;
+    Bench_VFrame(12, 14, s_v.rx_rate);
+    return PH_ERR_SUCCESS;
+}
+
+/* Requested memory size only: info flags, UID, blocks - 1 (2 bytes), block size - 1 */
+phStatus_t phalICode_Sw_ExtendedGetSystemInformation(phalICode_Sw_DataParams_t *pDataParams, uint8_t bInfoParams,
+                                                     uint8_t **ppSystemInfo, uint16_t *pSystemInfoLen)
+{
+    (void)pDataParams;
+    (void)bInfoParams;
+    s_v.sysinfo++;
+    s_v_rx[0] = PHAL_ICODE_INFO_PARAMS_REQUEST_VICC_MEM_SIZE;
+    memcpy(&s_v_rx[1], s_v.uid, 8U);
+    s_v_rx[9] = (uint8_t)(s_v.blocks - 1U);
+    s_v_rx[10] = (uint8_t)((s_v.blocks - 1U) >> 8);
+    s_v_rx[11] = (uint8_t)(s_v.block_size - 1U);
+    *ppSystemInfo = s_v_rx;
+    *pSystemInfoLen = 12;
+    Bench_VFrame(13, 12, s_v.rx_rate);
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phalICode_Sw_ParameterRequest(phalICode_Sw_DataParams_t *pDataParams, uint8_t *pBitRate,
+                                         uint8_t *pTiming)
+{
+    (void)pDataParams;
+    if (!s_v.param) {
+        Bench_Air(BENCH_V_TIMEOUT_US);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_SLI15693);
+    }
+    *pBitRate = s_v.bitrate;
+    *pTiming = s_v.timing;
+    Bench_VFrame(12, 2, s_v.rx_rate);
+    return PH_ERR_SUCCESS;
+}
+
+static uint8_t Bench_VRate(uint8_t bits)
+{
+    return (bits & 0x04U) ? ICODE_BULK_RATE_212 : ((bits & 0x02U) ? ICODE_BULK_RATE_106 :
+                                                   ((bits & 0x01U) ? ICODE_BULK_RATE_53 : ICODE_BULK_RATE_26));
+}
+
+phStatus_t phalICode_Sw_ParameterSelect(phalICode_Sw_DataParams_t *pDataParams, uint8_t bBitRate, uint8_t bTiming)
+{
+    (void)pDataParams;
+    (void)bTiming;
+    if (!s_v.param || (bBitRate & (uint8_t)~s_v.bitrate) != 0U) {
+        Bench_Air(BENCH_V_TIMEOUT_US);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_PAL_SLI15693);
+    }
+    /* Answered at the old rate, the new one applies from the next frame */
+    Bench_VFrame(13, 0, s_v.rx_rate);
+    s_v.rx_rate = Bench_VRate((uint8_t)(bBitRate >> 4));
+    s_v.tx_rate = Bench_VRate((uint8_t)(bBitRate & 0x07U));
+    return PH_ERR_SUCCESS;
+}
+
+static phStatus_t Bench_VRead(uint8_t fast, uint8_t ext, uint16_t block, uint16_t count, uint8_t *pData,
+                              uint16_t *pDataLen)
+{
+    uint32_t bytes = (uint32_t)count * s_v.block_size;
+
+    *pDataLen = 0;
+    if ((fast && !s_v.fast) || count == 0U || (uint32_t)block + count > s_v.blocks ||
+        (!ext && ((uint32_t)block + count > 256U)) || bytes + 3U > BENCH_V_RX_BUFSIZE) {
+        /* Error flag set in the reply */
+        if (fast && !s_v.fast) {
+            s_v.fast_errors++;
+        }
+        Bench_VFrame(ext ? 16U : 14U, 1, s_v.rx_rate);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_AL_ICODE);
+    }
+
+    for (uint32_t i = 0; i < bytes; i++) {
+        pData[i] = Bench_VByte((uint32_t)block * s_v.block_size + i);
+    }
+    *pDataLen = (uint16_t)bytes;
+    /* FAST variants answer at twice 26 kbit/s, custom commands carry the manufacturer code */
+    Bench_VFrame((ext ? 16U : 14U) + (fast ? 1U : 0U), bytes, fast ? ICODE_BULK_RATE_53 : s_v.rx_rate);
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phalICode_Sw_ReadMultipleBlocks(phalICode_Sw_DataParams_t *pDataParams, uint8_t bOption,
+                                           uint8_t bBlockNo, uint8_t bNumBlocks, uint8_t *pData, uint16_t *pDataLen)
+{
+    (void)pDataParams;
+    (void)bOption;
+    return Bench_VRead(0, 0, bBlockNo, bNumBlocks, pData, pDataLen);
+}
+
+phStatus_t phalICode_Sw_FastReadMultipleBlocks(phalICode_Sw_DataParams_t *pDataParams, uint8_t bOption,
+                                               uint8_t bBlockNo, uint8_t bNumBlocks, uint8_t *pData,
+                                               uint16_t *pDataLen)
+{
+    (void)pDataParams;
+    (void)bOption;
+    return Bench_VRead(1, 0, bBlockNo, bNumBlocks, pData, pDataLen);
+}
+
+phStatus_t phalICode_Sw_ExtendedReadMultipleBlocks(phalICode_Sw_DataParams_t *pDataParams, uint8_t bOption,
+                                                   uint16_t wBlockNo, uint16_t wNumBlocks, uint8_t *pData,
+                                                   uint16_t *pDataLen)
+{
+    (void)pDataParams;
+    (void)bOption;
+    return Bench_VRead(0, 1, wBlockNo, wNumBlocks, pData, pDataLen);
+}
+
+phStatus_t phalICode_Sw_ExtendedFastReadMultipleBlocks(phalICode_Sw_DataParams_t *pDataParams, uint8_t bOption,
+                                                       uint16_t wBlockNo, uint16_t wNumBlocks, uint8_t *pData,
+                                                       uint16_t *pDataLen)
+{
+    (void)pDataParams;
+    (void)bOption;
+    return Bench_VRead(1, 1, wBlockNo, wNumBlocks, pData, pDataLen);
+}
+
+/* Tags of the field: ICODE SLIX2, a non NXP tag, an NXP tag without FAST READ, NTAG 5 link */
+#define BENCH_V_SLIX2                   0U
+#define BENCH_V_OTHER                   1U
+#define BENCH_V_NOFAST                  2U
+#define BENCH_V_NTAG5                   3U
+
+static void Bench_VLoad(uint8_t kind)
+{
+    memset(&s_v, 0, sizeof(s_v));
+    s_v.uid[0] = (uint8_t)(0x31U + kind);
+    s_v.uid[6] = (kind == BENCH_V_OTHER) ? 0x07U : 0x04U;
+    s_v.uid[7] = 0xE0;
+    s_v.block_size = 4;
+    s_v.fast = (kind == BENCH_V_SLIX2 || kind == BENCH_V_NTAG5) ? 1U : 0U;
+    s_v.blocks = (kind == BENCH_V_NTAG5) ? 512U : ((kind == BENCH_V_OTHER) ? 64U : 80U);
+    if (kind == BENCH_V_NTAG5) {
+        /* 53, 106 and 212 kbit/s both directions */
+        s_v.param = 1;
+        s_v.bitrate = 0x77;
+        s_v.timing = PHAL_ICODE_PARAMETERS_TIMING_80_2_US;
+    }
+    s_sim_us = 0;
+    s_pal_v.pHalDataParams = &s_hal;
+    s_al_icode.pPalSli15693DataParams = &s_pal_v;
+}
+
+static uint8_t Bench_VDataOk(const uint8_t *data, uint16_t bytes)
+{
+    for (uint16_t i = 0; i < bytes; i++) {
+        if (data[i] != Bench_VByte(i)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ================== FeliCa cards behind the PAL / AL ================== */
+
+typedef struct {
+    uint8_t idm_pmm[16];            /* idm_pmm[9]: IC type in PMm */
+    uint8_t only_212;               /* Does not answer at 424 kbit/s */
+    uint8_t max_read;               /* Blocks per command the card accepts */
+    uint8_t max_write;
+    uint16_t bad_service;           /* Service the card does not have, 0 for none */
+} Bench_FCard_t;
+
+typedef struct {
+    uint8_t card;
+    uint16_t service;
+    uint16_t block;
+    uint8_t data[FELICA_BATCH_BLOCK_SIZE];
+} Bench_FWrite_t;
+
+static phpalFelica_Sw_DataParams_t s_pal_f;
+static phalFelica_Sw_DataParams_t s_al_f;
+static Bench_FCard_t s_f_cards[BENCH_F_MAX_CARDS];
+static uint8_t s_f_count;
+static Bench_FWrite_t s_f_log[BENCH_F_LOG_SIZE];
+static uint8_t s_f_log_count;
+static uint8_t s_f_rx[16U * 32U];
+static uint32_t s_f_rand;
+static uint32_t s_f_oversize;
+
+/* Frame of len bytes at the selected rate */
+static void Bench_FFrame(uint32_t len)
+{
+    uint32_t cus = (s_hal_cardtype == PHHAL_HW_CARDTYPE_FELICA_424) ? BENCH_F_BYTE_212_CUS / 2U : BENCH_F_BYTE_212_CUS;
+
+    Bench_Air((len + BENCH_F_FRAME_BYTES) * cus / 100U);
+}
+
+static uint8_t Bench_FAnswers(const Bench_FCard_t *card)
+{
+    return (s_hal_cardtype == PHHAL_HW_CARDTYPE_FELICA_212 || !card->only_212) ? 1U : 0U;
+}
+
+/* Time slot of every card: all cards pick a new one per ReqC */
+phStatus_t phpalFelica_Sw_ReqC(phpalFelica_Sw_DataParams_t *pDataParams, uint8_t *pSystemCode, uint8_t bNumTimeSlots,
+                               uint8_t **ppRxBuffer, uint16_t *pRxLength)
+{
+    uint8_t in_slot[16] = { 0 };
+    uint8_t who[16];
+    uint8_t frames = 0;
+
+    (void)pSystemCode;
+    Bench_FFrame(6);
+    Bench_Air(BENCH_F_REQC_US + BENCH_F_SLOT_US * bNumTimeSlots);
+
+    for (uint8_t i = 0; i < s_f_count; i++) {
+        uint8_t slot;
+
+        if (!Bench_FAnswers(&s_f_cards[i])) {
+            continue;
+        }
+        s_f_rand = s_f_rand * 1103515245U + 12345U;
+        slot = (uint8_t)((s_f_rand >> 16) % (bNumTimeSlots + 1U));
+        in_slot[slot]++;
+        who[slot] = i;
+    }
+
+    /* One 32 byte frame per occupied slot: LEN, 01, IDm PMm, status in byte 30 */
+    memset(s_f_rx, 0, sizeof(s_f_rx));
+    for (uint8_t slot = 0; slot <= bNumTimeSlots; slot++) {
+        uint8_t *frame = &s_f_rx[frames * 32U];
+
+        if (in_slot[slot] == 0U) {
+            continue;
+        }
+        frame[0] = 18;
+        frame[1] = 0x01;
+        memcpy(&frame[2], s_f_cards[who[slot]].idm_pmm, 16U);
+        frame[30] = (in_slot[slot] > 1U) ? 0x03U : 0x00U;
+        frames++;
+    }
+    pDataParams->bTotalFrames = frames;
+    *ppRxBuffer = s_f_rx;
+    *pRxLength = (uint16_t)(frames * 32U);
+    return (frames != 0U) ? PH_ERR_SUCCESS : PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_FELICA);
+}
+
+phStatus_t phpalFelica_Sw_GetFrameInfo(phpalFelica_Sw_DataParams_t *pDataParams, uint8_t bFrameNum,
+                                       uint8_t *pResponseBuffer, uint16_t *pwStatus, uint8_t **ppID, uint8_t *pLen)
+{
+    uint8_t *frame;
+
+    if (bFrameNum == 0U || bFrameNum > pDataParams->bTotalFrames) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_PAL_FELICA);
+    }
+    frame = &pResponseBuffer[(bFrameNum - 1U) * 32U];
+    *pwStatus = (frame[30] != 0U) ? PH_ERR_COLLISION_ERROR : PH_ERR_SUCCESS;
+    *ppID = &frame[2];
+    *pLen = 16;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phpalFelica_Sw_SetSerialNo(phpalFelica_Sw_DataParams_t *pDataParams, uint8_t *pIDmPMm)
+{
+    memcpy(pDataParams->aIDmPMm, pIDmPMm, 16U);
+    pDataParams->bIDmPMmValid = 1;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phalFelica_Sw_GetConfig(phalFelica_Sw_DataParams_t *pDataParams, uint16_t wConfig, uint16_t *pValue)
+{
+    if (wConfig != PHAL_FELICA_CONFIG_ADD_INFO) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_PARAMETER, PH_COMP_AL_FELICA);
+    }
+    *pValue = pDataParams->wAdditionalInfo;
+    return PH_ERR_SUCCESS;
+}
+
+/* Card addressed by the IDm in the PAL, -1 when it does not answer at this rate */
+static int Bench_FSelected(void)
+{
+    for (uint8_t i = 0; i < s_f_count; i++) {
+        if (memcmp(s_f_cards[i].idm_pmm, s_pal_f.aIDmPMm, 8U) == 0 && Bench_FAnswers(&s_f_cards[i])) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static Bench_FWrite_t *Bench_FFind(uint8_t card, uint16_t service, uint16_t block)
+{
+    for (uint8_t i = 0; i < s_f_log_count; i++) {
+        if (s_f_log[i].card == card && s_f_log[i].service == service && s_f_log[i].block == block) {
+            return &s_f_log[i];
+        }
+    }
+    return NULL;
+}
+
+/* Block content: written data, else a pattern of card, service and block */
+static void Bench_FBlock(uint8_t card, uint16_t service, uint16_t block, uint8_t *data)
+{
+    const Bench_FWrite_t *w = Bench_FFind(card, service, block);
+
+    for (uint8_t j = 0; j < FELICA_BATCH_BLOCK_SIZE; j++) {
+        data[j] = (w != NULL) ? w->data[j] : (uint8_t)(service ^ (block * 7U) ^ j ^ s_f_cards[card].idm_pmm[7]);
+    }
+}
+
+/*
+ * Checks a Read / Write Without Encryption request, fills in the service and block of every element.
+ * Returns status flag 2 of the card, 0 when the request is accepted.
+ */
+static uint8_t Bench_FCheck(const Bench_FCard_t *card, uint8_t bNumServices, const uint8_t *pServiceList,
+                            uint8_t bNumBlocks, const uint8_t *pBlockList, uint8_t bBlockListLength, uint8_t limit,
+                            uint16_t *services, uint16_t *blocks)
+{
+    uint8_t pos = 0;
+
+    if (bNumBlocks > limit) {
+        return 0xA2;
+    }
+    if (bNumServices == 0U || bNumServices > FELICA_BATCH_MAX_SERVICES) {
+        return 0xA1;
+    }
+    for (uint8_t i = 0; i < bNumBlocks; i++) {
+        uint8_t idx;
+
+        if (pos >= bBlockListLength) {
+            return 0xA2;
+        }
+        idx = (uint8_t)(pBlockList[pos] & 0x0FU);
+        if (idx >= bNumServices) {
+            return 0xA3;
+        }
+        services[i] = (uint16_t)(pServiceList[idx * 2U] | (pServiceList[idx * 2U + 1U] << 8));
+        if (pBlockList[pos] & 0x80U) {
+            blocks[i] = pBlockList[pos + 1U];
+            pos = (uint8_t)(pos + 2U);
+        } else {
+            blocks[i] = (uint16_t)(pBlockList[pos + 1U] | (pBlockList[pos + 2U] << 8));
+            pos = (uint8_t)(pos + 3U);
+        }
+        if (card->bad_service != 0U && services[i] == card->bad_service) {
+            return 0xA6;
+        }
+    }
+    return (pos == bBlockListLength) ? 0U : 0xA2U;
+}
+
+static phStatus_t Bench_FStatus(uint8_t sf2)
+{
+    s_al_f.wAdditionalInfo = (uint16_t)(0xFF00U | sf2);
+    return PH_ADD_COMPCODE_FIXED(PHAL_FELICA_ERR_FELICA, PH_COMP_AL_FELICA);
+}
+
+phStatus_t phalFelica_Sw_Read(phalFelica_Sw_DataParams_t *pDataParams, uint8_t bNumServices, uint8_t *pServiceList,
+                              uint8_t bTxNumBlocks, uint8_t *pBlockList, uint8_t bBlockListLength,
+                              uint8_t *pRxNumBlocks, uint8_t *pBlockData)
+{
+    uint16_t services[FELICA_BATCH_MAX_FRAME];
+    uint16_t blocks[FELICA_BATCH_MAX_FRAME];
+    uint32_t tx_len = 12U + bNumServices * 2U + bBlockListLength;
+    int card = Bench_FSelected();
+    uint8_t sf2;
+
+    (void)pDataParams;
+    *pRxNumBlocks = 0;
+    if (card < 0) {
+        Bench_Air(BENCH_F_TIMEOUT_US);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_FELICA);
+    }
+    if (tx_len > FELICA_BATCH_MAX_FRAME || 13U + bTxNumBlocks * 16U > FELICA_BATCH_MAX_FRAME) {
+        s_f_oversize++;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_LENGTH_ERROR, PH_COMP_PAL_FELICA);
+    }
+
+    Bench_FFrame(tx_len);
+    sf2 = Bench_FCheck(&s_f_cards[card], bNumServices, pServiceList, bTxNumBlocks, pBlockList, bBlockListLength,
+                       s_f_cards[card].max_read, services, blocks);
+    Bench_Air(BENCH_F_READ_US + BENCH_F_READ_BLOCK_US * bTxNumBlocks);
+    if (sf2 != 0U) {
+        Bench_FFrame(12);
+        return Bench_FStatus(sf2);
+    }
+
+    for (uint8_t i = 0; i < bTxNumBlocks; i++) {
+        Bench_FBlock((uint8_t)card, services[i], blocks[i], &pBlockData[i * FELICA_BATCH_BLOCK_SIZE]);
+    }
+    *pRxNumBlocks = bTxNumBlocks;
+    Bench_FFrame(13U + bTxNumBlocks * 16U);
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phalFelica_Sw_Write(phalFelica_Sw_DataParams_t *pDataParams, uint8_t bNumServices, uint8_t *pServiceList,
+                               uint8_t bNumBlocks, uint8_t *pBlockList, uint8_t bBlockListLength,
+                               uint8_t *pBlockData)
+{
+    uint16_t services[FELICA_BATCH_MAX_FRAME];
+    uint16_t blocks[FELICA_BATCH_MAX_FRAME];
+    uint32_t tx_len = 12U + bNumServices * 2U + bBlockListLength + bNumBlocks * 16U;
+    int card = Bench_FSelected();
+    uint8_t sf2;
+
+    (void)pDataParams;
+    if (card < 0) {
+        Bench_Air(BENCH_F_TIMEOUT_US);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_PAL_FELICA);
+    }
+    if (tx_len > FELICA_BATCH_MAX_FRAME) {
+        s_f_oversize++;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_LENGTH_ERROR, PH_COMP_PAL_FELICA);
+    }
+
+    Bench_FFrame(tx_len);
+    sf2 = Bench_FCheck(&s_f_cards[card], bNumServices, pServiceList, bNumBlocks, pBlockList, bBlockListLength,
+                       s_f_cards[card].max_write, services, blocks);
+    Bench_Air(BENCH_F_READ_US + (sf2 ? 0U : BENCH_F_WRITE_BLOCK_US * bNumBlocks));
+    Bench_FFrame(12);
+    if (sf2 != 0U) {
+        return Bench_FStatus(sf2);
+    }
+
+    for (uint8_t i = 0; i < bNumBlocks; i++) {
+        Bench_FWrite_t *w = Bench_FFind((uint8_t)card, services[i], blocks[i]);
+
+        if (w == NULL && s_f_log_count < BENCH_F_LOG_SIZE) {
+            w = &s_f_log[s_f_log_count++];
+        }
+        if (w != NULL) {
+            w->card = (uint8_t)card;
+            w->service = services[i];
+            w->block = blocks[i];
+            memcpy(w->data, &pBlockData[i * FELICA_BATCH_BLOCK_SIZE], FELICA_BATCH_BLOCK_SIZE);
+        }
+    }
+    return PH_ERR_SUCCESS;
+}
+
+/* cards_424 cards answering at both rates, then cards_212 that only answer at 212 kbit/s */
+static void Bench_FLoad(uint8_t cards_424, uint8_t cards_212, uint8_t ic)
+{
+    memset(s_f_cards, 0, sizeof(s_f_cards));
+    s_f_count = (uint8_t)(cards_424 + cards_212);
+    for (uint8_t i = 0; i < s_f_count; i++) {
+        Bench_FCard_t *card = &s_f_cards[i];
+
+        card->idm_pmm[0] = 0x01;
+        card->idm_pmm[1] = 0x2E;
+        card->idm_pmm[7] = (uint8_t)(0x51U + i);
+        card->idm_pmm[9] = ic;
+        card->only_212 = (i >= cards_424) ? 1U : 0U;
+        card->max_read = (ic == BENCH_F_IC_LITE_S) ? 4U : 8U;
+        card->max_write = (ic == BENCH_F_IC_LITE_S) ? 1U : 6U;
+    }
+    s_f_log_count = 0;
+    s_f_rand = 0x2545F491U;
+    s_sim_us = 0;
+    s_hal_cardtype = 0;
+    memset(&s_pal_f, 0, sizeof(s_pal_f));
+    memset(&s_al_f, 0, sizeof(s_al_f));
+    s_pal_f.pHalDataParams = &s_hal;
+    s_al_f.pPalFelicaDataParams = &s_pal_f;
+}
+
+static uint8_t Bench_FDataOk(uint8_t card, const FelicaBatch_Item_t *items, uint16_t count, const uint8_t *data)
+{
+    uint8_t expect[FELICA_BATCH_BLOCK_SIZE];
+
+    for (uint16_t i = 0; i < count; i++) {
+        Bench_FBlock(card, items[i].service, items[i].block, expect);
+        if (memcmp(expect, &data[i * FELICA_BATCH_BLOCK_SIZE], FELICA_BATCH_BLOCK_SIZE) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* count items of services, blocks from first, services cycled per item */
+static void Bench_FItems(FelicaBatch_Item_t *items, uint16_t count, const uint16_t *services, uint8_t service_count,
+                         uint16_t first)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        items[i].service = services[i % service_count];
+        items[i].block = (uint16_t)(first + i);
+    }
+}
+
+/* ================== Verification ================== */
+
+static uint32_t Bench_VerifyInventoryA(uint32_t *pFailures)
+{
+    static InventoryA_Result_t result;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+
+    /* 1..16 cards, both UID sets: all found, nothing left answering */
+    for (uint8_t mix = 0; mix < 2U; mix++) {
+        for (uint32_t n = 1; n <= INVENTORY_A_MAX_CARDS; n++) {
+            cases++;
+            Bench_ALoad(n, mix);
+            if (InventoryA_Run(&s_pal_a, BENCH_A_BUDGET_MS, &result) != PH_ERR_SUCCESS || !Bench_AFoundAll(&result) ||
+                !result.complete) {
+                (*pFailures)++;
+            }
+        }
+    }
+
+    /* Empty field */
+    cases++;
+    Bench_ALoad(0, BENCH_A_ADVERSARIAL);
+    if (InventoryA_Run(&s_pal_a, BENCH_A_BUDGET_MS, &result) != PH_ERR_SUCCESS || result.count != 0U ||
+        !result.complete) {
+        (*pFailures)++;
+    }
+
+    /* More cards than the table holds: table full, reported as incomplete */
+    cases++;
+    Bench_ALoad(BENCH_A_MAX_CARDS, BENCH_A_ADVERSARIAL);
+    if (InventoryA_Run(&s_pal_a, BENCH_A_BUDGET_MS, &result) != PH_ERR_SUCCESS ||
+        result.count != INVENTORY_A_MAX_CARDS || result.complete) {
+        (*pFailures)++;
+    }
+
+    /* Time budget: stops after the card that crossed it */
+    cases++;
+    Bench_ALoad(INVENTORY_A_MAX_CARDS, BENCH_A_MIXED);
+    if (InventoryA_Run(&s_pal_a, 20U, &result) != PH_ERR_SUCCESS || result.count == 0U ||
+        result.count >= INVENTORY_A_MAX_CARDS || result.complete || result.elapsed_ms < 20U) {
+        (*pFailures)++;
+    }
+
+    return cases;
+}
+
+static uint32_t Bench_VerifyInventoryEpc(uint32_t *pFailures)
+{
+    static InventoryEpc_Result_t result;
+    InventoryEpc_Config_t cfg;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+    InventoryEpc_DefaultConfig(&cfg);
+
+    /* 1..64 tags: every one read once, more than the table holds are counted */
+    for (uint32_t n = 1; n <= BENCH_EPC_VERIFY_TAGS; n++) {
+        cases++;
+        Bench_EpcLoad(n);
+        if (InventoryEpc_Run(&s_pal_epc, &cfg, &result) != PH_ERR_SUCCESS || !Bench_EpcFoundAll(&result) ||
+            !result.complete) {
+            (*pFailures)++;
+        }
+    }
+
+    /* Empty field: one round of empty slots */
+    cases++;
+    Bench_EpcLoad(0);
+    if (InventoryEpc_Run(&s_pal_epc, &cfg, &result) != PH_ERR_SUCCESS || result.tags_seen != 0U ||
+        result.rounds != 1U || !result.complete) {
+        (*pFailures)++;
+    }
+
+    /* Empty slots lower Q: one tag at Q 8, the closing round is down to Q 0 */
+    cases++;
+    cfg.q_start = 8;
+    Bench_EpcLoad(1);
+    if (InventoryEpc_Run(&s_pal_epc, &cfg, &result) != PH_ERR_SUCCESS || !Bench_EpcFoundAll(&result) ||
+        result.rounds != 2U || result.last_q != 0U) {
+        (*pFailures)++;
+    }
+
+    /* Collisions raise Q: 16 tags from Q 0 get through, a fixed Q 0 never does */
+    cases++;
+    cfg.q_start = 0;
+    Bench_EpcLoad(16);
+    if (InventoryEpc_Run(&s_pal_epc, &cfg, &result) != PH_ERR_SUCCESS || !Bench_EpcFoundAll(&result) ||
+        !result.complete) {
+        (*pFailures)++;
+    }
+    cases++;
+    cfg.adaptive = 0;
+    Bench_EpcLoad(16);
+    if (InventoryEpc_Run(&s_pal_epc, &cfg, &result) != PH_ERR_SUCCESS || result.tags_seen != 0U ||
+        result.complete || result.slots_collision != result.rounds) {
+        (*pFailures)++;
+    }
+
+    /* Round result larger than the Rx buffer: drained with ResumeInventory */
+    cases++;
+    InventoryEpc_DefaultConfig(&cfg);
+    cfg.q_start = 7;
+    Bench_EpcLoad(BENCH_EPC_VERIFY_TAGS);
+    if (InventoryEpc_Run(&s_pal_epc, &cfg, &result) != PH_ERR_SUCCESS || !Bench_EpcFoundAll(&result) ||
+        s_epc_resumes == 0U) {
+        (*pFailures)++;
+    }
+
+    /* Time budget */
+    cases++;
+    InventoryEpc_DefaultConfig(&cfg);
+    cfg.budget_ms = 20;
+    Bench_EpcLoad(BENCH_EPC_VERIFY_TAGS);
+    if (InventoryEpc_Run(&s_pal_epc, &cfg, &result) != PH_ERR_SUCCESS || result.complete ||
+        result.tags_seen >= BENCH_EPC_VERIFY_TAGS || result.elapsed_ms < 20U) {
+        (*pFailures)++;
+    }
+
+    /* 500 tags from Q 4: the saturated first rounds grow Q until every tag is read */
+    cases++;
+    InventoryEpc_DefaultConfig(&cfg);
+    cfg.budget_ms = BENCH_EPC_SWEEP_BUDGET_MS;
+    cfg.max_rounds = BENCH_EPC_SWEEP_ROUNDS;
+    Bench_EpcLoad(BENCH_EPC_MAX_TAGS);
+    if (InventoryEpc_Run(&s_pal_epc, &cfg, &result) != PH_ERR_SUCCESS || !Bench_EpcFoundAll(&result) ||
+        !result.complete) {
+        (*pFailures)++;
+    }
+
+    return cases;
+}
+
+static uint32_t Bench_VerifyMfcDump(uint32_t *pFailures)
+{
+    static uint8_t data[4096];
+    static MfcDump_Result_t result;
+    uint32_t cases = 0;
+    phStatus_t status;
+
+    *pFailures = 0;
+    MfcDump_ClearCache();
+
+    /* 1K, transport keys: one authentication per sector */
+    cases++;
+    Bench_MfcLoad(0x11, 0x08, BENCH_MFC_ALL_DEFAULT);
+    if (Bench_MfcRun(data, sizeof(data), &result) != PH_ERR_SUCCESS || result.sectors != 16U ||
+        !Bench_MfcAllOk(data, &result) || result.auth_attempts != 16U || result.reactivations != 0U) {
+        (*pFailures)++;
+    }
+
+    /* 1K and 4K with mixed keys: all sectors open, key B where key A is unknown */
+    for (uint8_t k = 0; k < 2U; k++) {
+        cases++;
+        Bench_MfcLoad((uint8_t)(0x20 + k), k ? 0x18 : 0x08, BENCH_MFC_MIXED);
+        if (Bench_MfcRun(data, sizeof(data), &result) != PH_ERR_SUCCESS || !Bench_MfcAllOk(data, &result) ||
+            result.cache_hit || (result.sector_key[4] & MFC_DUMP_KEY_B) == 0U || result.field_resets != 0U) {
+            (*pFailures)++;
+        }
+
+        /* Next tap of the same card: cached keys, no failed authentication */
+        cases++;
+        Bench_MfcLoad((uint8_t)(0x20 + k), k ? 0x18 : 0x08, BENCH_MFC_MIXED);
+        if (Bench_MfcRun(data, sizeof(data), &result) != PH_ERR_SUCCESS || !Bench_MfcAllOk(data, &result) ||
+            !result.cache_hit || result.auth_attempts != result.sectors || result.reactivations != 0U) {
+            (*pFailures)++;
+        }
+    }
+
+    /* A sector no key opens: reported, its image left alone */
+    cases++;
+    Bench_MfcLoad(0x31, 0x08, BENCH_MFC_ALL_DEFAULT);
+    s_mfc.key_a[5] = BENCH_MFC_KEY_UNKNOWN;
+    s_mfc.key_b[5] = BENCH_MFC_KEY_UNKNOWN;
+    memset(data, 0xEE, sizeof(data));
+    status = Bench_MfcRun(data, sizeof(data), &result);
+    if ((status & PH_ERR_MASK) != PH_ERR_AUTH_ERROR || result.sectors_read != 15U ||
+        result.sector_key[5] != MFC_DUMP_KEY_NONE || data[MfcDump_SectorOffset(5)] != 0xEEU ||
+        !Bench_MfcSectorOk(data, &result, 6)) {
+        (*pFailures)++;
+    }
+
+    /* Card misses the WUPA after a wrong key: one field reset */
+    cases++;
+    Bench_MfcLoad(0x41, 0x08, BENCH_MFC_MIXED);
+    s_mfc.wupa_fail = 1;
+    if (Bench_MfcRun(data, sizeof(data), &result) != PH_ERR_SUCCESS || !Bench_MfcAllOk(data, &result) ||
+        result.field_resets != 1U) {
+        (*pFailures)++;
+    }
+
+    /* Access bits deny key A on data blocks: session dropped, card reactivated */
+    cases++;
+    Bench_MfcLoad(0x51, 0x08, BENCH_MFC_ALL_DEFAULT);
+    s_mfc.deny_a[2] = 1;
+    status = Bench_MfcRun(data, sizeof(data), &result);
+    if ((status & PH_ERR_MASK) != PH_ERR_AUTH_ERROR || result.sector_key[2] != MFC_DUMP_KEY_NONE ||
+        result.sectors_read != 15U || result.reactivations != 1U || !Bench_MfcSectorOk(data, &result, 3)) {
+        (*pFailures)++;
+    }
+
+    /* Not a MIFARE Classic SAK, dump buffer too small */
+    cases++;
+    Bench_MfcLoad(0x61, 0x20, BENCH_MFC_ALL_DEFAULT);
+    if ((Bench_MfcRun(data, sizeof(data), &result) & PH_ERR_MASK) != PH_ERR_INVALID_PARAMETER) {
+        (*pFailures)++;
+    }
+    cases++;
+    Bench_MfcLoad(0x61, 0x18, BENCH_MFC_ALL_DEFAULT);
+    if ((Bench_MfcRun(data, 1024, &result) & PH_ERR_MASK) != PH_ERR_INVALID_PARAMETER) {
+        (*pFailures)++;
+    }
+
+    return cases;
+}
+
+static uint32_t Bench_VerifyIcodeBulk(uint32_t *pFailures)
+{
+    static uint8_t data[BENCH_V_MAX_BYTES];
+    static IcodeBulk_Result_t result;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+    IcodeBulk_ClearCache();
+
+    /* SLIX2: FAST READ MULTIPLE at 53 kbit/s, one request */
+    cases++;
+    Bench_VLoad(BENCH_V_SLIX2);
+    if (IcodeBulk_ReadAll(&s_al_icode, ICODE_BULK_RATE_212, data, sizeof(data), &result) != PH_ERR_SUCCESS ||
+        result.bytes != 320U || !Bench_VDataOk(data, result.bytes) || result.read_cmd != ICODE_BULK_READ_FAST ||
+        result.rate != ICODE_BULK_RATE_53 || result.requests != 1U || result.cache_hit) {
+        (*pFailures)++;
+    }
+
+    /* Second tap: layout from the cache, no GetSystemInformation */
+    cases++;
+    Bench_VLoad(BENCH_V_SLIX2);
+    if (IcodeBulk_ReadAll(&s_al_icode, ICODE_BULK_RATE_212, data, sizeof(data), &result) != PH_ERR_SUCCESS ||
+        !result.cache_hit || s_v.sysinfo != 0U || !Bench_VDataOk(data, result.bytes)) {
+        (*pFailures)++;
+    }
+
+    /* Other manufacturer: plain READ MULTIPLE at 26 kbit/s */
+    cases++;
+    Bench_VLoad(BENCH_V_OTHER);
+    if (IcodeBulk_ReadAll(&s_al_icode, ICODE_BULK_RATE_212, data, sizeof(data), &result) != PH_ERR_SUCCESS ||
+        result.bytes != 256U || !Bench_VDataOk(data, result.bytes) || result.read_cmd != ICODE_BULK_READ_MULTIPLE ||
+        result.rate != ICODE_BULK_RATE_26) {
+        (*pFailures)++;
+    }
+
+    /* NXP tag without FAST READ: one failed request, then remembered */
+    cases++;
+    Bench_VLoad(BENCH_V_NOFAST);
+    if (IcodeBulk_ReadAll(&s_al_icode, ICODE_BULK_RATE_212, data, sizeof(data), &result) != PH_ERR_SUCCESS ||
+        !Bench_VDataOk(data, result.bytes) || result.bytes != 320U || s_v.fast_errors != 1U ||
+        result.read_cmd != ICODE_BULK_READ_MULTIPLE || result.rate != ICODE_BULK_RATE_26) {
+        (*pFailures)++;
+    }
+    cases++;
+    Bench_VLoad(BENCH_V_NOFAST);
+    if (IcodeBulk_ReadAll(&s_al_icode, ICODE_BULK_RATE_212, data, sizeof(data), &result) != PH_ERR_SUCCESS ||
+        s_v.fast_errors != 0U || result.requests != 1U) {
+        (*pFailures)++;
+    }
+
+    /* NTAG 5 link: extended commands, ParameterSelect up to the allowed rate, back to 26 kbit/s afterwards */
+    for (uint8_t rate = ICODE_BULK_RATE_106; rate <= ICODE_BULK_RATE_212; rate++) {
+        cases++;
+        IcodeBulk_ClearCache();
+        Bench_VLoad(BENCH_V_NTAG5);
+        if (IcodeBulk_ReadAll(&s_al_icode, rate, data, sizeof(data), &result) != PH_ERR_SUCCESS ||
+            result.blocks != 512U || result.bytes != 2048U || !Bench_VDataOk(data, result.bytes) ||
+            result.read_cmd != ICODE_BULK_READ_EXT || result.rate != rate || s_v.sysinfo != 2U ||
+            result.requests != (2048U + 595U) / 596U || s_v.rx_rate != ICODE_BULK_RATE_26 ||
+            s_v.tx_rate != ICODE_BULK_RATE_26) {
+            (*pFailures)++;
+        }
+    }
+
+    /* Same tag, reader limited to 26 kbit/s: FAST extended read, no ParameterSelect */
+    cases++;
+    Bench_VLoad(BENCH_V_NTAG5);
+    if (IcodeBulk_ReadAll(&s_al_icode, ICODE_BULK_RATE_26, data, sizeof(data), &result) != PH_ERR_SUCCESS ||
+        result.read_cmd != ICODE_BULK_READ_EXT_FAST || result.rate != ICODE_BULK_RATE_53 ||
+        !Bench_VDataOk(data, result.bytes)) {
+        (*pFailures)++;
+    }
+
+    /* Tag reply rate only with the same rate both ways: not selectable for replies alone */
+    cases++;
+    IcodeBulk_ClearCache();
+    Bench_VLoad(BENCH_V_NTAG5);
+    s_v.bitrate = 0x20;
+    s_v.timing = PHAL_ICODE_PARAMETERS_TIMING_SAME_BOTH_DIRECTIONS;
+    if (IcodeBulk_ReadAll(&s_al_icode, ICODE_BULK_RATE_212, data, sizeof(data), &result) != PH_ERR_SUCCESS ||
+        result.read_cmd != ICODE_BULK_READ_EXT_FAST || result.rate != ICODE_BULK_RATE_53) {
+        (*pFailures)++;
+    }
+
+    /* Dump buffer smaller than the memory: stops at the last whole block */
+    cases++;
+    Bench_VLoad(BENCH_V_NTAG5);
+    memset(data, 0xEE, sizeof(data));
+    if (IcodeBulk_ReadAll(&s_al_icode, ICODE_BULK_RATE_212, data, 1023, &result) != PH_ERR_SUCCESS ||
+        result.bytes != 1020U || !Bench_VDataOk(data, result.bytes) || data[1020] != 0xEEU) {
+        (*pFailures)++;
+    }
+
+    return cases;
+}
+
+static uint32_t Bench_VerifyFelicaBatch(uint32_t *pFailures)
+{
+    static const uint8_t sc_all[2] = { 0xFF, 0xFF };
+    static const uint16_t svc_one[1] = { 0x000B };
+    static const uint16_t svc_three[3] = { 0x0009, 0x1009, 0x100B };
+    static FelicaBatch_Card_t cards[FELICA_BATCH_MAX_CARDS];
+    static FelicaBatch_Item_t items[64];
+    static uint8_t data[64U * FELICA_BATCH_BLOCK_SIZE];
+    static uint8_t back[64U * FELICA_BATCH_BLOCK_SIZE];
+    uint16_t services[20];
+    FelicaBatch_Stats_t stats;
+    uint32_t cases = 0;
+    uint8_t count;
+    uint8_t found_212;
+
+    *pFailures = 0;
+    s_f_oversize = 0;
+
+    /* Empty field */
+    cases++;
+    Bench_FLoad(0, 0, BENCH_F_IC_LITE_S);
+    if ((FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count) & PH_ERR_MASK) != PH_ERR_IO_TIMEOUT || count != 0U) {
+        (*pFailures)++;
+    }
+
+    /* One card, found at 424 kbit/s */
+    cases++;
+    Bench_FLoad(1, 0, BENCH_F_IC_LITE_S);
+    if (FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count) != PH_ERR_SUCCESS || count != 1U ||
+        cards[0].rate != FELICA_BATCH_RATE_424 || memcmp(cards[0].idm_pmm, s_f_cards[0].idm_pmm, 16U) != 0) {
+        (*pFailures)++;
+    }
+
+    /* Several cards: slots grow while replies collide */
+    for (uint8_t n = 2; n <= 6U; n++) {
+        cases++;
+        Bench_FLoad(n, 0, BENCH_F_IC_LITE_S);
+        if (FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count) != PH_ERR_SUCCESS || count != n) {
+            (*pFailures)++;
+        }
+    }
+
+    /* Cards that only answer at 212 kbit/s come from the second pass */
+    cases++;
+    Bench_FLoad(3, 2, BENCH_F_IC_LITE_S);
+    found_212 = 0;
+    if (FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count) != PH_ERR_SUCCESS || count != 5U) {
+        (*pFailures)++;
+    } else {
+        for (uint8_t i = 0; i < count; i++) {
+            found_212 = (uint8_t)(found_212 + ((cards[i].rate == FELICA_BATCH_RATE_212) ? 1U : 0U));
+        }
+        if (found_212 != 2U) {
+            (*pFailures)++;
+        }
+    }
+
+    /* Selected at 212 kbit/s, readable */
+    cases++;
+    Bench_FItems(items, 4, svc_one, 1, 0);
+    if (count != 5U || FelicaBatch_SelectCard(&s_pal_f, &cards[count - 1U]) != PH_ERR_SUCCESS ||
+        FelicaBatch_Read(&s_al_f, items, 4, data, &stats) != PH_ERR_SUCCESS ||
+        !Bench_FDataOk((uint8_t)Bench_FSelected(), items, 4, data)) {
+        (*pFailures)++;
+    }
+
+    /* Lite-S: 4 blocks per read command from PMm, no probing */
+    cases++;
+    Bench_FLoad(1, 0, BENCH_F_IC_LITE_S);
+    (void)FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count);
+    (void)FelicaBatch_SelectCard(&s_pal_f, &cards[0]);
+    Bench_FItems(items, 20, svc_one, 1, 0);
+    if (FelicaBatch_Read(&s_al_f, items, 20, data, &stats) != PH_ERR_SUCCESS || stats.max_blocks != 4U ||
+        stats.commands != 5U || stats.blocks != 20U || !Bench_FDataOk(0, items, 20, data)) {
+        (*pFailures)++;
+    }
+
+    /* Lite-S write: one block per command, read back */
+    cases++;
+    Bench_FItems(items, 3, svc_one, 1, 4);
+    for (uint16_t i = 0; i < 3U * FELICA_BATCH_BLOCK_SIZE; i++) {
+        data[i] = (uint8_t)(0xA0U + i);
+    }
+    if (FelicaBatch_Write(&s_al_f, items, 3, data, &stats) != PH_ERR_SUCCESS || stats.commands != 3U ||
+        FelicaBatch_Read(&s_al_f, items, 3, back, &stats) != PH_ERR_SUCCESS ||
+        memcmp(data, back, 3U * FELICA_BATCH_BLOCK_SIZE) != 0) {
+        (*pFailures)++;
+    }
+
+    /* Unknown IC: 15 blocks rejected with "illegal number of blocks", halved to 7, 2 and 3 byte elements */
+    cases++;
+    Bench_FLoad(1, 0, BENCH_F_IC_STANDARD);
+    (void)FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count);
+    (void)FelicaBatch_SelectCard(&s_pal_f, &cards[0]);
+    Bench_FItems(items, 30, svc_three, 3, 240);
+    if (FelicaBatch_Read(&s_al_f, items, 30, data, &stats) != PH_ERR_SUCCESS || stats.max_blocks != 7U ||
+        stats.commands != 6U || stats.blocks != 30U || !Bench_FDataOk(0, items, 30, data)) {
+        (*pFailures)++;
+    }
+
+    /* Unknown IC write: 11 rejected, 5 per command */
+    cases++;
+    Bench_FItems(items, 12, svc_three, 3, 250);
+    for (uint16_t i = 0; i < 12U * FELICA_BATCH_BLOCK_SIZE; i++) {
+        data[i] = (uint8_t)(i * 5U);
+    }
+    if (FelicaBatch_Write(&s_al_f, items, 12, data, &stats) != PH_ERR_SUCCESS || stats.max_blocks != 5U ||
+        stats.commands != 4U || FelicaBatch_Read(&s_al_f, items, 12, back, &stats) != PH_ERR_SUCCESS ||
+        memcmp(data, back, 12U * FELICA_BATCH_BLOCK_SIZE) != 0) {
+        (*pFailures)++;
+    }
+
+    /* 20 services in one list: a command closes at 16 services */
+    cases++;
+    Bench_FLoad(1, 0, BENCH_F_IC_STANDARD);
+    s_f_cards[0].max_read = 15;
+    (void)FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count);
+    (void)FelicaBatch_SelectCard(&s_pal_f, &cards[0]);
+    for (uint16_t i = 0; i < 20U; i++) {
+        services[i] = (uint16_t)(0x000BU + (i << 6));
+    }
+    Bench_FItems(items, 20, services, 20, 0);
+    if (FelicaBatch_Read(&s_al_f, items, 20, data, &stats) != PH_ERR_SUCCESS || stats.commands != 2U ||
+        !Bench_FDataOk(0, items, 20, data)) {
+        (*pFailures)++;
+    }
+
+    /* Service the card does not have: status flags in the AL, blocks of the earlier commands kept */
+    cases++;
+    Bench_FLoad(1, 0, BENCH_F_IC_LITE_S);
+    s_f_cards[0].bad_service = 0x1009;
+    (void)FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count);
+    (void)FelicaBatch_SelectCard(&s_pal_f, &cards[0]);
+    Bench_FItems(items, 8, svc_one, 1, 0);
+    items[6].service = 0x1009;
+    if ((FelicaBatch_Read(&s_al_f, items, 8, data, &stats) & PH_ERR_MASK) != PHAL_FELICA_ERR_FELICA ||
+        stats.blocks != 4U || (s_al_f.wAdditionalInfo & 0x00FFU) != 0xA6U) {
+        (*pFailures)++;
+    }
+
+    /* No request went over the FeliCa frame size */
+    cases++;
+    if (s_f_oversize != 0U) {
+        (*pFailures)++;
+    }
+
+    return cases;
+}
+
+/* ================== Simulator reports ================== */
+
+static void Bench_InventoryASimReport(void)
+{
+    static InventoryA_Result_t result;
+
+    printf("  \"inventory_a_sim\": [\n");
+    for (uint32_t n = 1; n <= INVENTORY_A_MAX_CARDS; n++) {
+        uint32_t frames[2];
+        double ms[2];
+
+        for (uint8_t mix = 0; mix < 2U; mix++) {
+            Bench_ALoad(n, mix);
+            (void)InventoryA_Run(&s_pal_a, BENCH_A_BUDGET_MS, &result);
+            frames[mix] = result.frames;
+            ms[mix] = (double)s_sim_us / 1000.0;
+        }
+        printf("    {\"cards\": %u, \"adversarial_frames\": %u, \"adversarial_ms\": %.2f, "
+               "\"mixed_frames\": %u, \"mixed_ms\": %.2f}%s\n",
+               (unsigned)n, (unsigned)frames[0], ms[0], (unsigned)frames[1], ms[1],
+               (n == INVENTORY_A_MAX_CARDS) ? "" : ",");
+    }
+    printf("  ],\n");
+}
+
+/* Adaptive Q against a fixed Q of q_start, both from the default Q 4, each population averaged over
+ * BENCH_EPC_SWEEP_SEEDS slot draws: tags per second and slot efficiency, the share of slots with a single reply */
+static void Bench_InventoryEpcSimReport(void)
+{
+    static const uint32_t tags[] = { 1, 2, 4, 8, 16, 24, 32, 48, 64, 100, 200, 300, 400, 500 };
+    static InventoryEpc_Result_t result;
+    InventoryEpc_Config_t cfg;
+
+    printf("  \"inventory_epc_sim\": [\n");
+    for (uint32_t t = 0; t < sizeof(tags) / sizeof(tags[0]); t++) {
+        printf("    {\"tags\": %u", (unsigned)tags[t]);
+        for (uint8_t fixed = 0; fixed < 2U; fixed++) {
+            uint32_t read = 0, rounds = 0, success = 0, empty = 0, collision = 0;
+            uint64_t us = 0;
+
+            InventoryEpc_DefaultConfig(&cfg);
+            cfg.budget_ms = BENCH_EPC_SWEEP_BUDGET_MS;
+            cfg.max_rounds = BENCH_EPC_SWEEP_ROUNDS;
+            cfg.adaptive = fixed ? 0U : 1U;
+            for (uint32_t seed = 0; seed < BENCH_EPC_SWEEP_SEEDS; seed++) {
+                Bench_EpcLoad(tags[t]);
+                s_epc_rng += seed * 0x9E3779B9U;
+                (void)InventoryEpc_Run(&s_pal_epc, &cfg, &result);
+                read += result.tags_seen;
+                rounds += result.rounds;
+                success += result.slots_success;
+                empty += result.slots_empty;
+                collision += result.slots_collision;
+                us += s_sim_us;
+            }
+            printf(", \"%s\": {\"read\": %.1f, \"rounds\": %.1f, \"slots\": [%.1f, %.1f, %.1f], \"ms\": %.2f, "
+                   "\"tags_per_s\": %.1f, \"slot_efficiency\": %.3f}",
+                   fixed ? "fixed_q" : "adaptive_q", (double)read / BENCH_EPC_SWEEP_SEEDS,
+                   (double)rounds / BENCH_EPC_SWEEP_SEEDS, (double)success / BENCH_EPC_SWEEP_SEEDS,
+                   (double)empty / BENCH_EPC_SWEEP_SEEDS, (double)collision / BENCH_EPC_SWEEP_SEEDS,
+                   (double)us / BENCH_EPC_SWEEP_SEEDS / 1000.0, read * 1e6 / (double)us,
+                   (success + empty + collision) ? (double)success / (success + empty + collision) : 0.0);
+        }
+        printf("}%s\n", (t + 1U == sizeof(tags) / sizeof(tags[0])) ? "" : ",");
+    }
+    printf("  ],\n");
+}
+
+/* Mixed keys, first tap with an empty key cache and the tap after it */
+static void Bench_MfcDumpSimReport(void)
+{
+    static const uint8_t saks[2] = { 0x08, 0x18 };
+    static uint8_t data[4096];
+    static MfcDump_Result_t result;
+
+    printf("  \"mfc_dump_sim\": [\n");
+    for (uint8_t k = 0; k < 2U; k++) {
+        MfcDump_ClearCache();
+        printf("    {\"sectors\": %u", (unsigned)MfcDump_SectorCount(saks[k]));
+        for (uint8_t tap = 0; tap < 2U; tap++) {
+            Bench_MfcLoad(0x70, saks[k], BENCH_MFC_MIXED);
+            (void)Bench_MfcRun(data, sizeof(data), &result);
+            printf(", \"%s\": {\"read\": %u, \"auth\": %u, \"reactivations\": %u, \"ms\": %.2f}",
+                   tap ? "cached" : "cold", (unsigned)result.sectors_read, (unsigned)result.auth_attempts,
+                   (unsigned)result.reactivations, (double)s_sim_us / 1000.0);
+        }
+        printf("}%s\n", k ? "" : ",");
+    }
+    printf("  ],\n");
+}
+
+/* SLIX2 and NTAG 5 link: first tap and cached tap, NTAG 5 per allowed rate */
+static void Bench_IcodeBulkSimReport(void)
+{
+    static const char *const names[4] = { "slix2", "other", "nxp_no_fast", "ntag5" };
+    static uint8_t data[BENCH_V_MAX_BYTES];
+    static IcodeBulk_Result_t result;
+
+    printf("  \"icode_bulk_sim\": [\n");
+    for (uint8_t kind = 0; kind < 4U; kind++) {
+        IcodeBulk_ClearCache();
+        printf("    {\"tag\": \"%s\"", names[kind]);
+        for (uint8_t rate = ICODE_BULK_RATE_26; rate <= ICODE_BULK_RATE_212; rate++) {
+            for (uint8_t tap = 0; tap < 2U; tap++) {
+                Bench_VLoad(kind);
+                (void)IcodeBulk_ReadAll(&s_al_icode, rate, data, sizeof(data), &result);
+                printf(", \"max%u_%s\": {\"bytes\": %u, \"rate\": %u, \"requests\": %u, \"ms\": %.2f}",
+                       (unsigned)rate, tap ? "cached" : "cold", (unsigned)result.bytes, (unsigned)result.rate,
+                       (unsigned)result.requests, (double)s_sim_us / 1000.0);
+            }
+        }
+        printf("}%s\n", (kind == 3U) ? "" : ",");
+    }
+    printf("  ],\n");
+}
+
+/* Poll time per number of cards, read / write time of 32 blocks on Lite-S and an unknown IC,
+ * read throughput of 64 to 256 blocks at 212 and 424 kbit/s, packed and one block per command */
+static void Bench_FelicaBatchSimReport(void)
+{
+    static const uint16_t sweep[3] = { 64, 128, 256 };
+    static FelicaBatch_Item_t sweep_items[256];
+    static uint8_t sweep_data[256U * FELICA_BATCH_BLOCK_SIZE];
+    static const uint8_t sc_all[2] = { 0xFF, 0xFF };
+    static const uint16_t svc[2] = { 0x000B, 0x0009 };
+    static const uint8_t ics[2] = { BENCH_F_IC_LITE_S, BENCH_F_IC_STANDARD };
+    static FelicaBatch_Card_t cards[FELICA_BATCH_MAX_CARDS];
+    static FelicaBatch_Item_t items[32];
+    static uint8_t data[32U * FELICA_BATCH_BLOCK_SIZE];
+    FelicaBatch_Stats_t stats;
+    uint8_t count;
+
+    printf("  \"felica_batch_sim\": {\n    \"poll\": [");
+    for (uint8_t n = 1; n <= FELICA_BATCH_MAX_CARDS; n++) {
+        Bench_FLoad(n, 0, BENCH_F_IC_LITE_S);
+        (void)FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count);
+        printf("%s{\"cards\": %u, \"found\": %u, \"ms\": %.2f}", (n == 1U) ? "" : ", ", (unsigned)n, (unsigned)count,
+               (double)s_sim_us / 1000.0);
+    }
+    printf("],\n    \"transfer\": [\n");
+    for (uint8_t k = 0; k < 2U; k++) {
+        for (uint8_t write = 0; write < 2U; write++) {
+            Bench_FLoad(1, 0, ics[k]);
+            (void)FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count);
+            (void)FelicaBatch_SelectCard(&s_pal_f, &cards[0]);
+            Bench_FItems(items, 32, svc, 2, 0);
+            memset(data, 0x5A, sizeof(data));
+            s_sim_us = 0;
+            if (write) {
+                (void)FelicaBatch_Write(&s_al_f, items, 32, data, &stats);
+            } else {
+                (void)FelicaBatch_Read(&s_al_f, items, 32, data, &stats);
+            }
+            printf("      {\"ic\": \"%s\", \"op\": \"%s\", \"blocks\": %u, \"commands\": %u, \"per_command\": %u, "
+                   "\"ms\": %.2f}%s\n", (k == 0U) ? "lite_s" : "standard", write ? "write" : "read",
+                   (unsigned)stats.blocks, (unsigned)stats.commands, (unsigned)stats.max_blocks,
+                   (double)s_sim_us / 1000.0, (k == 1U && write) ? "" : ",");
+        }
+    }
+    printf("    ],\n    \"read_sweep\": [\n");
+    for (uint8_t k = 0; k < 2U; k++) {
+        for (uint8_t rate = FELICA_BATCH_RATE_212; rate <= FELICA_BATCH_RATE_424; rate++) {
+            for (uint8_t n = 0; n < 3U; n++) {
+                uint64_t single_us = 0;
+                uint8_t ok;
+
+                /* A card that only answers at 212 kbit/s is found and read at that rate */
+                Bench_FLoad((rate == FELICA_BATCH_RATE_424) ? 1U : 0U, (rate == FELICA_BATCH_RATE_424) ? 0U : 1U,
+                            ics[k]);
+                (void)FelicaBatch_Poll(&s_pal_f, sc_all, cards, &count);
+                (void)FelicaBatch_SelectCard(&s_pal_f, &cards[0]);
+                Bench_FItems(sweep_items, sweep[n], svc, 2, 0);
+                for (uint16_t i = 0; i < sweep[n]; i++) {
+                    s_sim_us = 0;
+                    (void)FelicaBatch_Read(&s_al_f, &sweep_items[i], 1, &sweep_data[i * FELICA_BATCH_BLOCK_SIZE],
+                                           &stats);
+                    single_us += s_sim_us;
+                }
+                memset(sweep_data, 0, sizeof(sweep_data));
+                s_sim_us = 0;
+                (void)FelicaBatch_Read(&s_al_f, sweep_items, sweep[n], sweep_data, &stats);
+                ok = (count == 1U && cards[0].rate == rate && stats.blocks == sweep[n] &&
+                      Bench_FDataOk(0, sweep_items, sweep[n], sweep_data)) ? 1U : 0U;
+                printf("      {\"ic\": \"%s\", \"kbps\": %u, \"blocks\": %u, \"ok\": %u, \"commands\": %u, "
+                       "\"ms\": %.2f, \"bytes_per_s\": %.0f, \"single_ms\": %.2f, \"single_bytes_per_s\": %.0f}%s\n",
+                       (k == 0U) ? "lite_s" : "standard", (rate == FELICA_BATCH_RATE_424) ? 424U : 212U,
+                       (unsigned)sweep[n], (unsigned)ok, (unsigned)stats.commands, (double)s_sim_us / 1000.0,
+                       sweep[n] * FELICA_BATCH_BLOCK_SIZE * 1e6 / (double)s_sim_us, (double)single_us / 1000.0,
+                       sweep[n] * FELICA_BATCH_BLOCK_SIZE * 1e6 / (double)single_us,
+                       (k == 1U && rate == FELICA_BATCH_RATE_424 && n == 2U) ? "" : ",");
+            }
+        }
+    }
+    printf("    ]\n  },\n");
+}
+
+/* ================== Main ================== */
+
+typedef struct {
+    const char *name;
+    uint32_t (*verify)(uint32_t *pFailures);
+    void (*report)(void);
+} Bench_Module_t;
+
+static const Bench_Module_t s_modules[] = {
+    { "inventory_a", Bench_VerifyInventoryA, Bench_InventoryASimReport },
+    { "inventory_epc", Bench_VerifyInventoryEpc, Bench_InventoryEpcSimReport },
+    { "mfc_dump", Bench_VerifyMfcDump, Bench_MfcDumpSimReport },
+    { "icode_bulk", Bench_VerifyIcodeBulk, Bench_IcodeBulkSimReport },
+    { "felica_batch", Bench_VerifyFelicaBatch, Bench_FelicaBatchSimReport },
+};
+
+#define BENCH_MODULES   (sizeof(s_modules) / sizeof(s_modules[0]))
+
+int main(void)
+{
+    uint32_t cases[BENCH_MODULES], failures[BENCH_MODULES];
+    uint32_t total = 0;
+
+    for (uint32_t m = 0; m < BENCH_MODULES; m++) {
+        cases[m] = s_modules[m].verify(&failures[m]);
+        total += failures[m];
+    }
+
+    printf("{\n  \"rev\": \"%s\",\n", NFCRDLIB_BENCH_REV);
+    for (uint32_t m = 0; m < BENCH_MODULES; m++) {
+        s_modules[m].report();
+    }
+    printf("  \"verify\": {\n");
+    for (uint32_t m = 0; m < BENCH_MODULES; m++) {
+        printf("    \"%s\": {\"cases\": %u, \"failures\": %u}%s\n", s_modules[m].name, (unsigned)cases[m],
+               (unsigned)failures[m], (m + 1U == BENCH_MODULES) ? "" : ",");
+    }
+    printf("  }\n}\n");
+
+    return (total == 0U) ? 0 : 1;
+}
@@ -0,0 +1,486 @@
+/*
+ * EmvLinkBench.c
+ *
+ * Host decisions of an EMV tap over a pty, one exchange per stage against one
+ * LINUX_CMD_BATCH_DECISION round trip. The reader side sends the frames of
+ * emv_payment_flow.c, the other end of the pty is EmvResponder.
+ * The records of every tap are uplinked first, some of them twice as after a
+ * resumed tap. Results are written as JSON to stdout.
+ *
+ * Usage: emv_link_bench [--taps <n>] [--amount <cents>]
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#define _GNU_SOURCE
+#include "../host/EmvResponder.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef NFCRDLIB_BENCH_REV
+#define NFCRDLIB_BENCH_REV              "unknown"
+#endif
+
+/* ================== Configuration ================== */
+#define EMV_LINK_TAPS_DEFAULT           500U
+#define EMV_LINK_AMOUNT_DEFAULT         25000U      /* Cents, above the floor limit: online stages included */
+#define EMV_LINK_RECORDS                6U          /* Records read per tap */
+#define EMV_LINK_RECORD_LEN             120U
+#define EMV_LINK_BAUD                   115200U     /* USART1 of the reader, for the wire time estimate */
+
+/* Stages the reader asks the host for, restrictions and risk management are decided locally */
+#define EMV_LINK_BATCH_STAGES           (EMV_RESP_STAGE_OFFLINE_DATA_AUTH | EMV_RESP_STAGE_TERMINAL_ACTION | \
+                                         EMV_RESP_STAGE_ONLINE_PROCESSING | EMV_RESP_STAGE_ISSUER_AUTH | \
+                                         EMV_RESP_STAGE_SCRIPT_PROCESSING)
+
+/* ================== Fixtures ================== */
+
+static EmvResponder_t s_resp;
+static int s_master = -1;
+static int s_slave = -1;
+
+static uint64_t s_wire_bytes;               /* Both directions, reset per mode */
+
+static uint64_t Bench_NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int Bench_CompareU64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Host side: everything the master end receives goes through the responder */
+static void *Bench_HostThread(void *pArg)
+{
+    static uint8_t aRx[2048];
+    static uint8_t aTx[4U * EMV_RESP_FRAME_SIZE];
+
+    (void)pArg;
+    for (;;) {
+        ssize_t n = read(s_master, aRx, sizeof(aRx));
+        uint32_t dwOut;
+
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        dwOut = EmvResponder_Feed(&s_resp, aRx, (uint32_t)n, aTx, sizeof(aTx));
+        for (uint32_t pos = 0; pos < dwOut;) {
+            n = write(s_master, &aTx[pos], dwOut - pos);
+            if (n <= 0) {
+                return NULL;
+            }
+            pos += (uint32_t)n;
+        }
+    }
+    return NULL;
+}
+
+static int Bench_OpenPty(void)
+{
+    struct termios tio;
+
+    s_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (s_master < 0 || grantpt(s_master) != 0 || unlockpt(s_master) != 0) {
+        return -1;
+    }
+    s_slave = open(ptsname(s_master), O_RDWR | O_NOCTTY);
+    if (s_slave < 0) {
+        return -1;
+    }
+    /* Raw on both ends, no echo or line discipline in the way of the binary frames */
+    if (tcgetattr(s_slave, &tio) != 0) {
+        return -1;
+    }
+    cfmakeraw(&tio);
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    return tcsetattr(s_slave, TCSANOW, &tio);
+}
+
+/* ================== Reader side ================== */
+
+static int Bench_Send(uint8_t bCmd, const uint8_t *pData, uint16_t wLen)
+{
+    uint8_t aFrame[EMV_RESP_FRAME_SIZE + 7U];
+    uint32_t dwLen = 5U + wLen + 2U;
+
+    aFrame[0] = 0xAA;
+    aFrame[1] = 0x55;
+    aFrame[2] = bCmd;
+    aFrame[3] = (uint8_t)(wLen >> 8);
+    aFrame[4] = (uint8_t)wLen;
+    memcpy(&aFrame[5], pData, wLen);
+    aFrame[5U + wLen] = 0x0D;
+    aFrame[6U + wLen] = 0x0A;
+
+    s_wire_bytes += dwLen;
+    for (uint32_t pos = 0; pos < dwLen;) {
+        ssize_t n = write(s_slave, &aFrame[pos], dwLen - pos);
+        if (n <= 0) {
+            return -1;
+        }
+        pos += (uint32_t)n;
+    }
+    return 0;
+}
+
+static int Bench_ReadExact(uint8_t *pBuf, uint32_t dwLen)
+{
+    for (uint32_t pos = 0; pos < dwLen;) {
+        ssize_t n = read(s_slave, &pBuf[pos], dwLen - pos);
+        if (n <= 0) {
+            return -1;
+        }
+        pos += (uint32_t)n;
+    }
+    return 0;
+}
+
+/* One reply frame as EMV_ReceiveLinuxFrame reads it, returns the data length or -1 */
+static int Bench_Receive(uint8_t *pResp, uint8_t *pData, uint16_t wSize)
+{
+    uint8_t aHead[5];
+    uint16_t wLen;
+
+    if (Bench_ReadExact(aHead, sizeof(aHead)) != 0 || aHead[0] != 0xAA || aHead[1] != 0x55) {
+        return -1;
+    }
+    wLen = (uint16_t)((aHead[3] << 8) | aHead[4]);
+    if ((uint32_t)wLen + 2U > wSize || Bench_ReadExact(pData, wLen + 2U) != 0 ||
+        pData[wLen] != 0x0D || pData[wLen + 1U] != 0x0A) {
+        return -1;
+    }
+    s_wire_bytes += 5U + wLen + 2U;
+    *pResp = aHead[2];
+    return wLen;
+}
+
+/* Batch request data, the per-stage requests carry the same */
+static uint16_t Bench_RequestData(uint8_t *pData, uint8_t bStages, uint32_t dwAmount)
+{
+    static const uint8_t aUid[4] = { 0x08, 0x12, 0x34, 0x56 };
+    static const uint8_t aSelect[] = { 0x6F, 0x10, 0x84, 0x07, 0xA0, 0x00, 0x00, 0x00, 0x03, 0x10, 0x10,
+                                       0xA5, 0x05, 0x50, 0x03, 0x56, 0x49, 0x53, 0x90, 0x00 };
+    static const uint8_t aGpo[] = { 0x80, 0x0A, 0x5C, 0x00, 0x08, 0x01, 0x01, 0x00, 0x10, 0x01, 0x03,
+                                    0x00, 0x90, 0x00 };
+    uint16_t wPos = 0;
+
+    pData[wPos++] = bStages;
+    pData[wPos++] = (uint8_t)(dwAmount >> 24);
+    pData[wPos++] = (uint8_t)(dwAmount >> 16);
+    pData[wPos++] = (uint8_t)(dwAmount >> 8);
+    pData[wPos++] = (uint8_t)dwAmount;
+    pData[wPos++] = 0x09;
+    pData[wPos++] = 0x78;
+    pData[wPos++] = 0x00;
+    pData[wPos++] = 0xFF;
+    pData[wPos++] = (uint8_t)sizeof(aUid);
+    memcpy(&pData[wPos], aUid, sizeof(aUid));
+    wPos += (uint16_t)sizeof(aUid);
+    pData[wPos++] = 0;
+    pData[wPos++] = (uint8_t)sizeof(aSelect);
+    memcpy(&pData[wPos], aSelect, sizeof(aSelect));
+    wPos += (uint16_t)sizeof(aSelect);
+    pData[wPos++] = 0;
+    pData[wPos++] = (uint8_t)sizeof(aGpo);
+    memcpy(&pData[wPos], aGpo, sizeof(aGpo));
+    wPos += (uint16_t)sizeof(aGpo);
+    pData[wPos++] = 0;
+    pData[wPos++] = 0;
+    return wPos;
+}
+
+/* Records of a tap, the last two once more as a resumed tap sends them */
+static int Bench_UplinkRecords(uint32_t dwTap)
+{
+    uint8_t aRec[2U + EMV_LINK_RECORD_LEN];
+
+    for (uint32_t i = 0; i < EMV_LINK_RECORDS + 2U; i++) {
+        uint32_t r = (i < EMV_LINK_RECORDS) ? i : (i - 2U);
+
+        aRec[0] = (uint8_t)(1U + r / 3U);
+        aRec[1] = (uint8_t)(1U + r % 3U);
+        memset(&aRec[2], (int)(dwTap + r), EMV_LINK_RECORD_LEN);
+        if (Bench_Send(EMV_RESP_CMD_RECORD_UPLINK, aRec, sizeof(aRec)) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Decisions of one tap in aDecision[stage], 0xFF for stages not asked */
+static int Bench_TapPerStage(uint32_t dwAmount, uint8_t *aDecision)
+{
+    uint8_t aData[EMV_RESP_FRAME_SIZE];
+    uint8_t bResp;
+
+    for (uint8_t i = 0; i < EMV_RESP_STAGE_COUNT; i++) {
+        uint16_t wLen = Bench_RequestData(aData, (uint8_t)(1U << i), dwAmount);
+
+        if (Bench_Send((uint8_t)(EMV_RESP_CMD_OFFLINE_DATA_AUTH + i), aData, wLen) != 0 ||
+            Bench_Receive(&bResp, aData, sizeof(aData)) < 0) {
+            return -1;
+        }
+        aDecision[i] = bResp;
+    }
+    return 0;
+}
+
+static int Bench_TapBatch(uint32_t dwAmount, uint8_t *aDecision)
+{
+    uint8_t aData[EMV_RESP_FRAME_SIZE];
+    uint16_t wPos = 1;
+    uint8_t bResp;
+    int len;
+
+    if (Bench_Send(EMV_RESP_CMD_BATCH_DECISION, aData, Bench_RequestData(aData, EMV_LINK_BATCH_STAGES, dwAmount)) != 0) {
+        return -1;
+    }
+    len = Bench_Receive(&bResp, aData, sizeof(aData));
+    if (len < 1 || bResp != EMV_RESP_SUCCESS || aData[0] != EMV_LINK_BATCH_STAGES) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < EMV_RESP_STAGE_COUNT; i++) {
+        aDecision[i] = 0xFF;
+        if (EMV_LINK_BATCH_STAGES & (1U << i)) {
+            if (wPos >= (uint16_t)len) {
+                return -1;
+            }
+            aDecision[i] = aData[wPos++];
+        }
+    }
+    return 0;
+}
+
+/* ================== Verification ================== */
+
+static uint32_t Bench_VerifyResponder(uint32_t *pFailures)
+{
+    static EmvResponder_t resp;
+    uint8_t aFrame[64], aReply[256], aSplit[256];
+    const EmvResponder_Record_t *pRec;
+    uint32_t dwOut, dwSplit = 0;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+    EmvResponder_Init(&resp);
+
+    /* (sfi, rec) is the key: the same record number in two SFIs, and one record sent twice */
+    cases++;
+    {
+        static const uint8_t aUp[][9] = {
+            { 0xAA, 0x55, 0x17, 0x00, 0x03, 0x01, 0x01, 0x11, 0x0D },
+            { 0xAA, 0x55, 0x17, 0x00, 0x03, 0x02, 0x01, 0x22, 0x0D },
+            { 0xAA, 0x55, 0x17, 0x00, 0x03, 0x01, 0x01, 0x33, 0x0D },
+        };
+        for (uint32_t i = 0; i < 3U; i++) {
+            memcpy(aFrame, aUp[i], sizeof(aUp[i]));
+            aFrame[9] = 0x0A;
+            (void)EmvResponder_Feed(&resp, aFrame, 10U, aReply, sizeof(aReply));
+        }
+        pRec = EmvResponder_FindRecord(&resp, 1U, 1U);
+        if (resp.dwRecordCount != 2U || resp.dwRecordsReplaced != 1U || pRec == NULL || pRec->aData[0] != 0x33U ||
+            EmvResponder_FindRecord(&resp, 2U, 1U) == NULL || EmvResponder_FindRecord(&resp, 1U, 2U) != NULL) {
+            (*pFailures)++;
+        }
+    }
+
+    /* Batch above the floor limit, fed a byte at a time after line noise */
+    cases++;
+    {
+        uint8_t aData[EMV_RESP_FRAME_SIZE];
+        uint16_t wLen = Bench_RequestData(aData, EMV_LINK_BATCH_STAGES, 25000U);
+        static const uint8_t aNoise[] = { 0x00, 0xAA, 0x00, 0x55, 0xAA };
+
+        for (uint32_t i = 0; i < sizeof(aNoise); i++) {
+            dwSplit += EmvResponder_Feed(&resp, &aNoise[i], 1U, aSplit, sizeof(aSplit));
+        }
+        aFrame[0] = 0x55;
+        aFrame[1] = EMV_RESP_CMD_BATCH_DECISION;
+        aFrame[2] = (uint8_t)(wLen >> 8);
+        aFrame[3] = (uint8_t)wLen;
+        for (uint32_t i = 0; i < 4U; i++) {
+            dwSplit += EmvResponder_Feed(&resp, &aFrame[i], 1U, aSplit, sizeof(aSplit));
+        }
+        for (uint32_t i = 0; i < wLen; i++) {
+            dwSplit += EmvResponder_Feed(&resp, &aData[i], 1U, aSplit, sizeof(aSplit));
+        }
+        aFrame[0] = 0x0D;
+        dwSplit += EmvResponder_Feed(&resp, aFrame, 1U, aSplit, sizeof(aSplit));
+        aFrame[0] = 0x0A;
+        dwOut = EmvResponder_Feed(&resp, aFrame, 1U, aReply, sizeof(aReply));
+        /* 02 of 5 decisions, ODA / TAA / online / issuer auth / scripts, then 8A 02 30 30 and no scripts */
+        if (dwSplit != 0U || dwOut != 5U + 1U + 5U + 2U + 4U + 2U + 2U || aReply[2] != EMV_RESP_SUCCESS ||
+            aReply[5] != EMV_LINK_BATCH_STAGES || aReply[6] != EMV_RESP_SUCCESS || aReply[7] != EMV_RESP_ONLINE_REQUIRED ||
+            aReply[8] != EMV_RESP_APPROVED || aReply[9] != EMV_RESP_SUCCESS || aReply[10] != EMV_RESP_SUCCESS ||
+            aReply[12] != 4U || aReply[13] != 0x8AU || aReply[18] != 0U) {
+            (*pFailures)++;
+        }
+    }
+
+    /* The first record after a decision starts the next tap */
+    cases++;
+    aFrame[0] = 0xAA;
+    aFrame[1] = 0x55;
+    aFrame[2] = EMV_RESP_CMD_RECORD_UPLINK;
+    aFrame[3] = 0x00;
+    aFrame[4] = 0x03;
+    aFrame[5] = 0x02;
+    aFrame[6] = 0x04;
+    aFrame[7] = 0x44;
+    aFrame[8] = 0x0D;
+    aFrame[9] = 0x0A;
+    (void)EmvResponder_Feed(&resp, aFrame, 10U, aReply, sizeof(aReply));
+    if (resp.dwRecordCount != 1U || EmvResponder_FindRecord(&resp, 1U, 1U) != NULL ||
+        EmvResponder_FindRecord(&resp, 2U, 4U) == NULL) {
+        (*pFailures)++;
+    }
+
+    /* Below the floor limit the action analysis approves offline, no record: ODA declined */
+    cases++;
+    {
+        uint8_t aData[EMV_RESP_FRAME_SIZE];
+        uint16_t wLen = Bench_RequestData(&aData[5], EMV_RESP_STAGE_OFFLINE_DATA_AUTH | EMV_RESP_STAGE_TERMINAL_ACTION, 500U);
+
+        EmvResponder_Init(&resp);
+        aData[0] = 0xAA;
+        aData[1] = 0x55;
+        aData[2] = EMV_RESP_CMD_BATCH_DECISION;
+        aData[3] = (uint8_t)(wLen >> 8);
+        aData[4] = (uint8_t)wLen;
+        aData[5U + wLen] = 0x0D;
+        aData[6U + wLen] = 0x0A;
+        dwOut = EmvResponder_Feed(&resp, aData, 7U + wLen, aReply, sizeof(aReply));
+        if (dwOut < 8U || aReply[6] != EMV_RESP_DECLINED || aReply[7] != EMV_RESP_OFFLINE_APPROVED ||
+            aReply[8] != 0U || aReply[9] != 0U) {
+            (*pFailures)++;
+        }
+    }
+
+    /* Unknown command and a broken tail */
+    cases++;
+    {
+        static const uint8_t aBad[] = { 0xAA, 0x55, 0x42, 0x00, 0x00, 0x0D, 0x0A,
+                                        0xAA, 0x55, 0x17, 0x00, 0x02, 0x01, 0x01, 0x0D, 0x0B };
+        EmvResponder_Init(&resp);
+        dwOut = EmvResponder_Feed(&resp, aBad, sizeof(aBad), aReply, sizeof(aReply));
+        if (dwOut != 7U || aReply[2] != EMV_RESP_ERROR || resp.dwBadFrames != 2U || resp.dwRecordCount != 0U) {
+            (*pFailures)++;
+        }
+    }
+
+    return cases;
+}
+
+/* ================== Main ================== */
+
+int main(int argc, char **argv)
+{
+    uint32_t dwTaps = EMV_LINK_TAPS_DEFAULT;
+    uint32_t dwAmount = EMV_LINK_AMOUNT_DEFAULT;
+    uint32_t dwCases, dwFailures, dwMismatch = 0, dwErrors = 0;
+    uint8_t aPerStage[EMV_RESP_STAGE_COUNT], aBatch[EMV_RESP_STAGE_COUNT];
+    uint64_t *pNs[2];
+    uint64_t aWire[2];
+    uint64_t qwT0;
+    double aMedian[2];
+    pthread_t host;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--taps") == 0 && i + 1 < argc) {
+            dwTaps = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--amount") == 0 && i + 1 < argc) {
+            dwAmount = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [--taps <n>] [--amount <cents>]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (dwTaps == 0U) {
+        fprintf(stderr, "taps must be > 0\n");
+        return 2;
+    }
+
+    dwCases = Bench_VerifyResponder(&dwFailures);
+
+    pNs[0] = calloc(dwTaps, sizeof(uint64_t));
+    pNs[1] = calloc(dwTaps, sizeof(uint64_t));
+    EmvResponder_Init(&s_resp);
+    if (pNs[0] == NULL || pNs[1] == NULL || Bench_OpenPty() != 0 ||
+        pthread_create(&host, NULL, Bench_HostThread, NULL) != 0) {
+        fprintf(stderr, "pty setup failed\n");
+        return 1;
+    }
+
+    /* Records are streamed while the card is read in both modes, only the decisions are timed */
+    for (uint32_t m = 0; m < 2U; m++) {
+        s_wire_bytes = 0;
+        for (uint32_t t = 0; t < dwTaps; t++) {
+            int rc;
+
+            if (Bench_UplinkRecords(t) != 0) {
+                dwErrors++;
+                continue;
+            }
+            qwT0 = Bench_NowNs();
+            rc = (m == 0U) ? Bench_TapPerStage(dwAmount, aPerStage) : Bench_TapBatch(dwAmount, aBatch);
+            pNs[m][t] = Bench_NowNs() - qwT0;
+            if (rc != 0) {
+                dwErrors++;
+            }
+        }
+        aWire[m] = s_wire_bytes - (uint64_t)dwTaps * (EMV_LINK_RECORDS + 2U) * (9U + EMV_LINK_RECORD_LEN);
+        qsort(pNs[m], dwTaps, sizeof(uint64_t), Bench_CompareU64);
+        aMedian[m] = (double)pNs[m][dwTaps / 2U];
+    }
+
+    /* Same answer for every stage the batch asked */
+    for (uint8_t s = 0; s < EMV_RESP_STAGE_COUNT; s++) {
+        if (aBatch[s] != 0xFFU && aBatch[s] != aPerStage[s]) {
+            dwMismatch++;
+        }
+    }
+    if (s_resp.dwRecordCount != EMV_LINK_RECORDS || s_resp.dwRecordsReplaced != (uint32_t)dwTaps * 2U * 2U) {
+        dwMismatch++;
+    }
+
+    printf("{\n  \"rev\": \"%s\",\n  \"taps\": %u,\n  \"amount\": %u,\n", NFCRDLIB_BENCH_REV, dwTaps, dwAmount);
+    printf("  \"verify\": { \"responder\": { \"cases\": %u, \"failures\": %u }, \"mismatches\": %u, \"errors\": %u },\n",
+           dwCases, dwFailures, dwMismatch, dwErrors);
+    for (uint32_t m = 0; m < 2U; m++) {
+        double wire_ms = (double)aWire[m] / dwTaps * 10.0 * 1000.0 / EMV_LINK_BAUD;
+
+        printf("  \"%s\": { \"round_trips\": %u, \"pty_ns_median\": %.0f, \"wire_bytes\": %.0f, \"wire_ms_115200\": %.2f },\n",
+               (m == 0U) ? "per_stage" : "batch", (m == 0U) ? EMV_RESP_STAGE_COUNT : 1U, aMedian[m],
+               (double)aWire[m] / dwTaps, wire_ms);
+    }
+    printf("  \"gain\": %.2f\n}\n", (aMedian[1] > 0.0) ? aMedian[0] / aMedian[1] : 0.0);
+
+    close(s_slave);
+    close(s_master);
+    pthread_join(host, NULL);
+    free(pNs[0]);
+    free(pNs[1]);
+    return (dwFailures == 0U && dwMismatch == 0U && dwErrors == 0U) ? 0 : 1;
+}
@@ -0,0 +1,1162 @@
+/*
+ * LlcpLoopBench.c
+ *
+ * SNEP PUT over an LLCP data link connection on a loopback MAC
+ * A 64 KB NDEF message is transferred with the real SNEP and LLCP sources
+ * (phnpSnep_Sw, phlnLlcp_Sw) against a scripted remote LLC, in both directions:
+ *   put    the local SNEP client (phnpSnep_Sw_Put) sends to a remote SNEP
+ *          server. The remote announces MIU and RW in CC and forwards the
+ *          received fragments to its host at --rx-bps, an I PDU is only
+ *          acknowledged once forwarded (a receive slot is free again).
+ *   serve  a remote SNEP client PUTs to the local SNEP server
+ *          (phnpSnep_Sw_ServerListen/ServerSendResponse). The local RW is the
+ *          number of receive slots of the server socket buffer.
+ * The application calls the SNEP API from its own thread, the LLCP task loop
+ * of phlnLlcp_Sw_Activate is replayed here one MAC turn at a time. The OSAL
+ * semaphores and the message queue are provided below, an empty queue at the
+ * turn queues SYMM as if the SYMM timer had expired.
+ * Air time is the NFC-DEP turn model at 424 kbit/s, LLC PDUs above one DEP
+ * frame are chained (one ACK frame per chained frame). Results are written as
+ * JSON to stdout. Exit code is non-zero if any check fails.
+ *
+ * Usage: llcp_loop_bench [--len <bytes>] [--rx-bps <bytes/s>]
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include <ph_Status.h>
+#include <phlnLlcp.h>
+#include <phnpSnep.h>
+#include <phTools.h>
+#include <phOsal.h>
+#include "../library/comps/phlnLlcp/src/Sw/phlnLlcp_Sw.h"
+#include "../library/comps/phlnLlcp/src/Sw/phlnLlcp_Sw_Int.h"
+#include "../library/comps/phlnLlcp/src/Sw/phlnLlcp_Sw_Mac.h"
+#include "../library/comps/phlnLlcp/src/Sw/phlnLlcp_Timers.h"
+#include "../library/comps/phnpSnep/src/Sw/phnpSnep_Sw.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef NFCRDLIB_BENCH_REV
+#define NFCRDLIB_BENCH_REV              "unknown"
+#endif
+
+/* ================== Configuration ================== */
+#define LLCP_BENCH_LEN_DEFAULT          65536U      /* NDEF message of the SNEP PUT */
+#define LLCP_BENCH_LEN_MAX              65536U
+#define LLCP_BENCH_RX_BPS_DEFAULT       92160U      /* Remote forwards to its host over a 921600 baud UART */
+#define LLCP_BENCH_REMOTE_CLIENT_SAP    0x20U
+#define LLCP_BENCH_Q_POOL               8U
+#define LLCP_BENCH_SEM_POOL             8U
+#define LLCP_BENCH_TURN_LIMIT           400000U     /* Turns without completion count as deadlock */
+
+/* NFC-DEP framing around the LLC PDU: SoD, LEN, CMD0/1, PFB, CRC */
+#define LLCP_BENCH_DEP_OVERHEAD         7U
+#define LLCP_BENCH_DEP_FRAME            251U        /* LLC bytes per DEP frame (LR 254 less the DEP header) */
+#define LLCP_BENCH_BITRATE              424000U
+#define LLCP_BENCH_TURNAROUND_US        300U        /* Initiator and target processing per half-turn */
+#define LLCP_BENCH_RW_TLV_US            57U         /* Air time of the RW TLV in CC, rounded up */
+
+#define LLCP_BENCH_SCN_PUT              0U
+#define LLCP_BENCH_SCN_SERVE            1U
+
+/* ================== Loopback OSAL ================== */
+
+typedef struct
+{
+    uint32_t dwCount;
+} LlcpBench_Sem_t;
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_cond = PTHREAD_COND_INITIALIZER;
+static LlcpBench_Sem_t s_sem_pool[LLCP_BENCH_SEM_POOL];
+static uint32_t s_sem_used;
+static LlcpBench_Sem_t *s_app_wait;         /* Semaphore the application is blocked on */
+static volatile uint8_t s_app_done;
+
+phStatus_t phOsal_SemCreate(phOsal_Semaphore_t *semHandle, pphOsal_SemObj_t semObj, phOsal_SemOpt_t opt)
+{
+    (void)opt;
+    if (s_sem_used >= LLCP_BENCH_SEM_POOL)
+    {
+        return PH_OSAL_FAILURE;
+    }
+    s_sem_pool[s_sem_used].dwCount = semObj->semInitialCount;
+    *semHandle = &s_sem_pool[s_sem_used++];
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phOsal_SemDelete(phOsal_Semaphore_t *semHandle)
+{
+    (void)semHandle;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phOsal_SemPend(phOsal_Semaphore_t *semHandle, phOsal_TimerPeriodObj_t timePeriodToWait)
+{
+    LlcpBench_Sem_t *pSem = (LlcpBench_Sem_t *)*semHandle;
+
+    (void)timePeriodToWait;
+    /* Only the application blocks, the caller holds s_lock. */
+    while (pSem->dwCount == 0U)
+    {
+        s_app_wait = pSem;
+        (void)pthread_cond_broadcast(&s_cond);
+        (void)pthread_cond_wait(&s_cond, &s_lock);
+    }
+    s_app_wait = NULL;
+    pSem->dwCount--;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phOsal_SemPost(phOsal_Semaphore_t *semHandle, phOsal_SemOpt_t opt)
+{
+    LlcpBench_Sem_t *pSem = (LlcpBench_Sem_t *)*semHandle;
+
+    (void)opt;
+    /* Signalling semaphores have a maximum count of one, as with the RTOS a second post fails. */
+    if (pSem->dwCount != 0U)
+    {
+        return PH_OSAL_FAILURE;
+    }
+    pSem->dwCount++;
+    (void)pthread_cond_broadcast(&s_cond);
+    return PH_ERR_SUCCESS;
+}
+
+/* Activation, link deactivation and the LLCP timers are not part of the replayed task loop. */
+phStatus_t phOsal_EventCreate(phOsal_Event_t *eventHandle, pphOsal_EventObj_t eventObj)
+{
+    (void)eventHandle;
+    (void)eventObj;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phOsal_EventPend(volatile phOsal_Event_t *eventHandle, phOsal_EventOpt_t options, phOsal_Ticks_t ticksToWait,
+    phOsal_EventBits_t FlagsToWait, phOsal_EventBits_t *pCurrFlags)
+{
+    (void)eventHandle;
+    (void)options;
+    (void)ticksToWait;
+    (void)FlagsToWait;
+    (void)pCurrFlags;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phOsal_EventPost(phOsal_Event_t *eventHandle, phOsal_EventOpt_t options, phOsal_EventBits_t FlagsToPost,
+    phOsal_EventBits_t *pCurrFlags)
+{
+    (void)eventHandle;
+    (void)options;
+    (void)FlagsToPost;
+    (void)pCurrFlags;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phOsal_EventClear(phOsal_Event_t *eventHandle, phOsal_EventOpt_t options, phOsal_EventBits_t FlagsToClear,
+    phOsal_EventBits_t *pCurrFlags)
+{
+    (void)eventHandle;
+    (void)options;
+    (void)FlagsToClear;
+    (void)pCurrFlags;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phOsal_TimerStop(phOsal_Timer_t *timerHandle)
+{
+    (void)timerHandle;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phlnLlcp_Timers_SymStart(phlnLlcp_Sw_DataParams_t *pDataParams)
+{
+    (void)pDataParams;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phlnLlcp_Timers_LtoStart(phlnLlcp_Sw_DataParams_t *pDataParams)
+{
+    (void)pDataParams;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phlnLlcp_Timers_StopLto(phlnLlcp_Sw_DataParams_t *pDataParams)
+{
+    (void)pDataParams;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phlnLlcp_Timers_DeInitSym(phlnLlcp_Sw_DataParams_t *pDataParams)
+{
+    (void)pDataParams;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phlnLlcp_Timers_DeInitLto(phlnLlcp_Sw_DataParams_t *pDataParams)
+{
+    (void)pDataParams;
+    return PH_ERR_SUCCESS;
+}
+
+/* ================== Loopback queue ================== */
+
+static phTools_Q_t s_q_pool[LLCP_BENCH_Q_POOL];
+static phTools_Q_t *s_q_free;
+static phTools_Q_t *s_q_head;
+
+phStatus_t phTools_Q_Init(void)
+{
+    uint32_t i;
+
+    (void)memset(s_q_pool, 0, sizeof(s_q_pool));
+    s_q_free = NULL;
+    s_q_head = NULL;
+    for (i = 0; i < LLCP_BENCH_Q_POOL; i++)
+    {
+        s_q_pool[i].pNext = s_q_free;
+        s_q_free = &s_q_pool[i];
+    }
+    return PH_ERR_SUCCESS;
+}
+
+void phTools_Q_DeInit(void)
+{
+}
+
+phTools_Q_t *phTools_Q_Get(uint32_t dwBlockTime, uint8_t bPriority)
+{
+    phTools_Q_t *pQ = s_q_free;
+
+    (void)dwBlockTime;
+    (void)bPriority;
+    if (pQ != NULL)
+    {
+        s_q_free = pQ->pNext;
+        (void)memset(pQ, 0, sizeof(*pQ));
+    }
+    return pQ;
+}
+
+phStatus_t phTools_Q_Send(phTools_Q_t *psMsgQueue, uint32_t dwBlockTime, uint16_t wFrameOpt)
+{
+    phTools_Q_t **ppTail = &s_q_head;
+
+    (void)dwBlockTime;
+    (void)wFrameOpt;
+    while (*ppTail != NULL)
+    {
+        ppTail = &(*ppTail)->pNext;
+    }
+    psMsgQueue->pNext = NULL;
+    *ppTail = psMsgQueue;
+    (void)pthread_cond_broadcast(&s_cond);
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phTools_Q_SendFront(phTools_Q_t *psMsgQueue, uint32_t dwBlockTime, uint16_t wFrameOpt)
+{
+    (void)dwBlockTime;
+    (void)wFrameOpt;
+    psMsgQueue->pNext = s_q_head;
+    s_q_head = psMsgQueue;
+    return PH_ERR_SUCCESS;
+}
+
+phTools_Q_t *phTools_Q_Receive(uint32_t dwBlockTime)
+{
+    phTools_Q_t *pQ = s_q_head;
+
+    (void)dwBlockTime;
+    if (pQ != NULL)
+    {
+        s_q_head = pQ->pNext;
+    }
+    return pQ;
+}
+
+phStatus_t phTools_Q_Release(phTools_Q_t *psMsgQueue, uint32_t dwBlockTime)
+{
+    (void)dwBlockTime;
+    psMsgQueue->pNext = s_q_free;
+    s_q_free = psMsgQueue;
+    return PH_ERR_SUCCESS;
+}
+
+/* ================== Loopback MAC ================== */
+
+static uint8_t s_tx_frame[PHLN_LLCP_MIU + 16U];
+static uint16_t s_tx_len;
+static uint8_t s_tx_ready;
+static uint16_t s_mac_miu;
+
+phStatus_t phlnLlcp_MacTransmit(uint16_t wFrameOpt, uint8_t *pTxBuffer, uint16_t wTxLength)
+{
+    if ((wFrameOpt == PH_TRANSMIT_DEFAULT) || (wFrameOpt == PH_TRANSMIT_BUFFER_FIRST))
+    {
+        s_tx_len = 0;
+    }
+    if ((size_t)s_tx_len + wTxLength > sizeof(s_tx_frame))
+    {
+        return (PH_ERR_BUFFER_OVERFLOW | PH_COMP_LN_LLCP);
+    }
+    if (wTxLength != 0U)
+    {
+        (void)memcpy(&s_tx_frame[s_tx_len], pTxBuffer, wTxLength);
+    }
+    s_tx_len = (uint16_t)(s_tx_len + wTxLength);
+    s_tx_ready = ((wFrameOpt == PH_TRANSMIT_DEFAULT) || (wFrameOpt == PH_TRANSMIT_BUFFER_LAST)) ? 1U : 0U;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phlnLlcp_MacReceive(uint16_t wFrameOpt, uint8_t **ppRxBuffer, uint16_t *pRxLength)
+{
+    (void)wFrameOpt;
+    (void)ppRxBuffer;
+    (void)pRxLength;
+    return (PH_ERR_USE_CONDITION | PH_COMP_LN_LLCP);
+}
+
+phStatus_t phlnLlcp_MacDeactivation(phlnLlcp_Sw_DataParams_t *pDataParams)
+{
+    (void)pDataParams;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phlnLlcp_Sw_MacInit(phlnLlcp_Sw_DataParams_t *pDataParams, uint8_t bConfig, uint16_t *wSymmTime,
+    uint16_t *wLtoTime)
+{
+    (void)pDataParams;
+    (void)bConfig;
+    (void)wSymmTime;
+    (void)wLtoTime;
+    return (PH_ERR_USE_CONDITION | PH_COMP_LN_LLCP);
+}
+
+uint16_t phlnLlcp_Sw_MacGetMaxMiu(void)
+{
+    return s_mac_miu;
+}
+
+/* ================== Remote LLC ================== */
+
+typedef struct
+{
+    uint8_t bScenario;
+    uint8_t bRw;                /* put: RW announced in CC */
+    uint16_t wMiu;              /* put: MIU announced in CC */
+    uint32_t dwRxBps;           /* put: rate the remote forwards received data to its host, 0 = at once */
+    uint32_t dwMsgLen;          /* serve: NDEF message to PUT */
+
+    uint8_t bLocalSap;
+    uint8_t bRemoteSap;
+    uint8_t bConnected;
+    int16_t wLocalRw;           /* RW TLV of the local CONNECT/CC, -1 if absent */
+    uint16_t wLocalMiu;         /* MIU of the local CONNECT/CC */
+    uint8_t bVs;                /* V(S) */
+    uint8_t bVsa;               /* V(SA), N(R) received from the local LLC */
+    uint8_t bVr;                /* V(R) */
+    uint8_t bVra;               /* V(RA), N(R) sent to the local LLC */
+
+    /* put: receive slots of the remote, time each buffered I PDU is forwarded */
+    uint64_t aqwDone[PHLN_LLCP_RW_MAX + 1U];
+    uint8_t bHead;
+    uint8_t bBuffered;
+    uint8_t bCredit;            /* RW 0: RR sent, one I PDU may follow */
+    uint64_t qwBusyUntil;
+
+    /* SNEP */
+    uint32_t dwTotal;           /* NDEF length of the PUT request */
+    uint32_t dwBytes;           /* NDEF bytes received (put) or sent (serve) */
+    uint8_t bResponse;          /* put: SNEP response to send, 0 if none */
+    uint8_t bSuccessSent;
+    uint8_t bContinue;          /* serve: CONTINUE received */
+    uint8_t bSuccess;           /* serve: SUCCESS received */
+
+    uint32_t dwIPdus;
+    uint32_t dwRrSent;
+    uint32_t dwRnr;
+    uint32_t dwWindowViolations;
+    uint32_t dwSeqErrors;
+    uint32_t dwDataErrors;
+} LlcpBench_Peer_t;
+
+static uint8_t LlcpBench_Pattern(uint32_t dwPos)
+{
+    return (uint8_t)((dwPos * 7U) + (dwPos >> 8U));
+}
+
+static uint16_t LlcpBench_Header(LlcpBench_Peer_t *pPeer, uint8_t bPtype, uint8_t *pFrame)
+{
+    pFrame[0] = (uint8_t)((pPeer->bLocalSap << 2U) | (bPtype >> 2U));
+    pFrame[1] = (uint8_t)(((bPtype & 0x03U) << 6U) | pPeer->bRemoteSap);
+    return 2U;
+}
+
+static uint16_t LlcpBench_Rr(LlcpBench_Peer_t *pPeer, uint8_t bNr, uint8_t *pFrame)
+{
+    uint16_t wLen = LlcpBench_Header(pPeer, PHLN_LLCP_PTYPE_RR, pFrame);
+
+    pFrame[wLen++] = bNr;
+    pPeer->bVra = bNr;
+    pPeer->dwRrSent++;
+    return wLen;
+}
+
+static uint16_t LlcpBench_IHeader(LlcpBench_Peer_t *pPeer, uint8_t bNr, uint8_t *pFrame)
+{
+    uint16_t wLen = LlcpBench_Header(pPeer, PHLN_LLCP_PTYPE_INFO, pFrame);
+
+    pFrame[wLen++] = (uint8_t)((pPeer->bVs << 4U) | bNr);
+    pPeer->bVs = (uint8_t)((pPeer->bVs + 1U) & 0x0FU);
+    pPeer->bVra = bNr;
+    return wLen;
+}
+
+static void LlcpBench_ParseTlv(LlcpBench_Peer_t *pPeer, const uint8_t *pRx, uint16_t wRxLen)
+{
+    uint16_t wPos;
+
+    pPeer->wLocalRw = -1;
+    pPeer->wLocalMiu = PHLN_LLCP_DEFAULT_SPEC_MIU;
+    for (wPos = 2U; (wPos + 2U) <= wRxLen; wPos = (uint16_t)(wPos + 2U + pRx[wPos + 1U]))
+    {
+        if ((pRx[wPos] == PHLN_LLCP_TLV_TYPE_RW) && (pRx[wPos + 1U] == PHLN_LLCP_TLV_LENGTH_RW))
+        {
+            pPeer->wLocalRw = pRx[wPos + 2U];
+        }
+        else if ((pRx[wPos] == PHLN_LLCP_TLV_TYPE_MIUX) && (pRx[wPos + 1U] == PHLN_LLCP_TLV_LENGTH_MIUX))
+        {
+            pPeer->wLocalMiu = (uint16_t)(PHLN_LLCP_DEFAULT_SPEC_MIU +
+                ((((uint16_t)pRx[wPos + 2U] << 8U) | pRx[wPos + 3U]) & PHLN_LLCP_SW_MIUX_MASK));
+        }
+        else
+        {
+            /* Other TLVs are not used by the remote. */
+        }
+    }
+}
+
+/* Sequence checks of a received I PDU, N(R) of I and RR PDUs. */
+static void LlcpBench_Sequence(LlcpBench_Peer_t *pPeer, uint8_t bPtype, const uint8_t *pRx)
+{
+    uint8_t bNr = pRx[2] & 0x0FU;
+
+    if ((bPtype == PHLN_LLCP_PTYPE_INFO) && ((pRx[2] >> 4U) != pPeer->bVr))
+    {
+        pPeer->dwSeqErrors++;
+    }
+    if (PHLN_LLCP_SW_MOD16_DIFF(bNr, pPeer->bVsa) > PHLN_LLCP_SW_MOD16_DIFF(pPeer->bVs, pPeer->bVsa))
+    {
+        /* Acknowledges an I PDU that was never sent. */
+        pPeer->dwSeqErrors++;
+    }
+    pPeer->bVsa = bNr;
+}
+
+/* Window the local LLC accepts, RW TLV absent means the default RW. */
+static uint8_t LlcpBench_LocalRw(const LlcpBench_Peer_t *pPeer)
+{
+    return (pPeer->wLocalRw < 0) ? PHLN_LLCP_RW_DEFAULT : (uint8_t)pPeer->wLocalRw;
+}
+
+/* put: remote SNEP server. Buffers I PDUs in its receive slots, forwards them at dwRxBps and only acknowledges
+ * forwarded ones, so the local LLC can keep up to RW fragments in flight. */
+static uint16_t LlcpBench_ServerRespond(LlcpBench_Peer_t *pPeer, uint64_t qwNowUs, const uint8_t *pRx,
+    uint16_t wRxLen, uint8_t *pFrame)
+{
+    uint8_t bPtype = (uint8_t)PHLN_LLCP_PDU_GET_PTYPE(pRx[0], pRx[1]);
+    uint16_t wLen;
+    uint16_t wData;
+    uint16_t i;
+    uint64_t qwStart;
+    uint8_t bAck;
+
+    switch (bPtype)
+    {
+    case PHLN_LLCP_PTYPE_CONNECT:
+        LlcpBench_ParseTlv(pPeer, pRx, wRxLen);
+        pPeer->bLocalSap = (uint8_t)PHLN_LLCP_PDU_GET_SSAP(pRx[1]);
+        pPeer->bRemoteSap = PHNP_SNEP_DEFAULT_SERVER_SAP;
+        wLen = LlcpBench_Header(pPeer, PHLN_LLCP_PTYPE_CC, pFrame);
+        pFrame[wLen++] = PHLN_LLCP_TLV_TYPE_MIUX;
+        pFrame[wLen++] = PHLN_LLCP_TLV_LENGTH_MIUX;
+        pFrame[wLen++] = (uint8_t)((pPeer->wMiu - PHLN_LLCP_DEFAULT_SPEC_MIU) >> 8U);
+        pFrame[wLen++] = (uint8_t)(pPeer->wMiu - PHLN_LLCP_DEFAULT_SPEC_MIU);
+        pFrame[wLen++] = PHLN_LLCP_TLV_TYPE_RW;
+        pFrame[wLen++] = PHLN_LLCP_TLV_LENGTH_RW;
+        pFrame[wLen++] = pPeer->bRw;
+        pPeer->bConnected = 1U;
+        return wLen;
+
+    case PHLN_LLCP_PTYPE_INFO:
+        LlcpBench_Sequence(pPeer, bPtype, pRx);
+        if (pPeer->bRw == 0U)
+        {
+            if (pPeer->bCredit == 0U)
+            {
+                pPeer->dwWindowViolations++;
+            }
+            pPeer->bCredit = 0;
+        }
+        else if ((pPeer->bBuffered >= pPeer->bRw) || ((uint16_t)(wRxLen - 3U) > pPeer->wMiu))
+        {
+            pPeer->dwWindowViolations++;
+        }
+        else
+        {
+            /* Inside the window */
+        }
+        if (pPeer->bBuffered > PHLN_LLCP_RW_MAX)
+        {
+            pPeer->dwWindowViolations++;
+            break;
+        }
+
+        i = 3U;
+        if (pPeer->dwIPdus == 0U)
+        {
+            /* PUT request header */
+            if ((wRxLen < (3U + PHNP_SNEP_HEADER_SIZE)) || (pRx[3] != PHNP_SNEP_VER) ||
+                (pRx[4] != PHNP_SNEP_REQ_PUT))
+            {
+                pPeer->dwDataErrors++;
+                break;
+            }
+            pPeer->dwTotal = ((uint32_t)pRx[5] << 24U) | ((uint32_t)pRx[6] << 16U) | ((uint32_t)pRx[7] << 8U) | pRx[8];
+            i = (uint16_t)(3U + PHNP_SNEP_HEADER_SIZE);
+        }
+        wData = (uint16_t)(wRxLen - i);
+        for (; i < wRxLen; i++)
+        {
+            if (pRx[i] != LlcpBench_Pattern(pPeer->dwBytes + i - (wRxLen - wData)))
+            {
+                pPeer->dwDataErrors++;
+                break;
+            }
+        }
+        pPeer->dwBytes += wData;
+        if ((pPeer->dwIPdus == 0U) && (pPeer->dwBytes < pPeer->dwTotal))
+        {
+            pPeer->bResponse = PHNP_SNEP_RES_CONT;
+        }
+        pPeer->dwIPdus++;
+        pPeer->bVr = (uint8_t)((pPeer->bVr + 1U) & 0x0FU);
+
+        /* Forward to the host in order, the slot is free once forwarded. */
+        qwStart = (pPeer->qwBusyUntil > qwNowUs) ? pPeer->qwBusyUntil : qwNowUs;
+        pPeer->qwBusyUntil = qwStart +
+            ((pPeer->dwRxBps != 0U) ? (((uint64_t)wRxLen - 3U) * 1000000U) / pPeer->dwRxBps : 0U);
+        pPeer->aqwDone[(pPeer->bHead + pPeer->bBuffered) % (PHLN_LLCP_RW_MAX + 1U)] = pPeer->qwBusyUntil;
+        pPeer->bBuffered++;
+        break;
+
+    case PHLN_LLCP_PTYPE_RR:
+        LlcpBench_Sequence(pPeer, bPtype, pRx);
+        break;
+
+    case PHLN_LLCP_PTYPE_RNR:
+        pPeer->dwRnr++;
+        break;
+
+    default:
+        break;
+    }
+
+    if (pPeer->bConnected == 0U)
+    {
+        pFrame[0] = 0x00U;
+        pFrame[1] = 0x00U;
+        return 2U;
+    }
+
+    while ((pPeer->bBuffered != 0U) && (pPeer->aqwDone[pPeer->bHead] <= qwNowUs))
+    {
+        pPeer->bHead = (uint8_t)((pPeer->bHead + 1U) % (PHLN_LLCP_RW_MAX + 1U));
+        pPeer->bBuffered--;
+    }
+    bAck = (uint8_t)((pPeer->bVr + 16U - pPeer->bBuffered) & 0x0FU);
+    if ((pPeer->dwIPdus != 0U) && (pPeer->dwBytes >= pPeer->dwTotal) && (pPeer->bBuffered == 0U) &&
+        (pPeer->bSuccessSent == 0U) && (pPeer->bResponse == 0U))
+    {
+        /* Whole message received and forwarded */
+        pPeer->bResponse = PHNP_SNEP_RES_SUCCESS;
+    }
+
+    if ((pPeer->bResponse != 0U) &&
+        (PHLN_LLCP_SW_MOD16_DIFF(pPeer->bVs, pPeer->bVsa) < LlcpBench_LocalRw(pPeer)))
+    {
+        wLen = LlcpBench_IHeader(pPeer, bAck, pFrame);
+        pFrame[wLen++] = PHNP_SNEP_VER;
+        pFrame[wLen++] = pPeer->bResponse;
+        (void)memset(&pFrame[wLen], 0, 4U);
+        wLen = (uint16_t)(wLen + 4U);
+        pPeer->bSuccessSent = (pPeer->bResponse == PHNP_SNEP_RES_SUCCESS) ? 1U : pPeer->bSuccessSent;
+        pPeer->bResponse = 0U;
+        return wLen;
+    }
+    if (pPeer->bRw == 0U)
+    {
+        /* RW 0: every I PDU needs an RR, given once the previous one is forwarded. */
+        if ((pPeer->bCredit == 0U) && (pPeer->bBuffered == 0U) &&
+            ((pPeer->dwIPdus == 0U) || (pPeer->dwBytes < pPeer->dwTotal)))
+        {
+            pPeer->bCredit = 1U;
+            return LlcpBench_Rr(pPeer, bAck, pFrame);
+        }
+    }
+    else if (bAck != pPeer->bVra)
+    {
+        return LlcpBench_Rr(pPeer, bAck, pFrame);
+    }
+    else
+    {
+        /* Nothing to acknowledge */
+    }
+
+    pFrame[0] = 0x00U;
+    pFrame[1] = 0x00U;
+    return 2U;
+}
+
+/* serve: remote SNEP client. Connects by service name, PUTs the message in fragments of the MIU announced in CC
+ * and keeps up to the local RW fragments unacknowledged. */
+static uint16_t LlcpBench_ClientRespond(LlcpBench_Peer_t *pPeer, const uint8_t *pRx, uint16_t wRxLen,
+    uint8_t *pFrame)
+{
+    static const uint8_t aSnepUri[] = "urn:nfc:sn:snep";
+    uint8_t bPtype = (uint8_t)PHLN_LLCP_PDU_GET_PTYPE(pRx[0], pRx[1]);
+    uint16_t wLen;
+    uint16_t wData;
+    uint16_t i;
+
+    switch (bPtype)
+    {
+    case PHLN_LLCP_PTYPE_SYMM:
+        if (pPeer->bConnected == 0U)
+        {
+            pPeer->bConnected = 1U;
+            pPeer->bLocalSap = 0x01U;
+            pPeer->bRemoteSap = LLCP_BENCH_REMOTE_CLIENT_SAP;
+            wLen = LlcpBench_Header(pPeer, PHLN_LLCP_PTYPE_CONNECT, pFrame);
+            pFrame[wLen++] = PHLN_LLCP_TLV_TYPE_MIUX;
+            pFrame[wLen++] = PHLN_LLCP_TLV_LENGTH_MIUX;
+            pFrame[wLen++] = 0x00U;
+            pFrame[wLen++] = 0x00U;
+            pFrame[wLen++] = PHLN_LLCP_TLV_TYPE_RW;
+            pFrame[wLen++] = PHLN_LLCP_TLV_LENGTH_RW;
+            pFrame[wLen++] = PHLN_LLCP_RW_DEFAULT;
+            pFrame[wLen++] = PHLN_LLCP_TLV_TYPE_SN;
+            pFrame[wLen++] = (uint8_t)(sizeof(aSnepUri) - 1U);
+            (void)memcpy(&pFrame[wLen], aSnepUri, sizeof(aSnepUri) - 1U);
+            return (uint16_t)(wLen + sizeof(aSnepUri) - 1U);
+        }
+        break;
+
+    case PHLN_LLCP_PTYPE_CC:
+        LlcpBench_ParseTlv(pPeer, pRx, wRxLen);
+        pPeer->bLocalSap = (uint8_t)PHLN_LLCP_PDU_GET_SSAP(pRx[1]);
+        pPeer->bConnected = 2U;
+        break;
+
+    case PHLN_LLCP_PTYPE_INFO:
+        LlcpBench_Sequence(pPeer, bPtype, pRx);
+        pPeer->bVr = (uint8_t)((pPeer->bVr + 1U) & 0x0FU);
+        if ((wRxLen < (3U + PHNP_SNEP_HEADER_SIZE)) || (pRx[3] != PHNP_SNEP_VER))
+        {
+            pPeer->dwDataErrors++;
+        }
+        else if (pRx[4] == PHNP_SNEP_RES_CONT)
+        {
+            pPeer->bContinue = 1U;
+        }
+        else if (pRx[4] == PHNP_SNEP_RES_SUCCESS)
+        {
+            pPeer->bSuccess = 1U;
+        }
+        else
+        {
+            pPeer->dwDataErrors++;
+        }
+        break;
+
+    case PHLN_LLCP_PTYPE_RR:
+        LlcpBench_Sequence(pPeer, bPtype, pRx);
+        break;
+
+    case PHLN_LLCP_PTYPE_RNR:
+        pPeer->dwRnr++;
+        break;
+
+    default:
+        break;
+    }
+
+    if ((pPeer->bConnected == 2U) && (pPeer->dwBytes < pPeer->dwMsgLen) &&
+        ((pPeer->dwIPdus == 0U) || (pPeer->bContinue != 0U)) &&
+        (PHLN_LLCP_SW_MOD16_DIFF(pPeer->bVs, pPeer->bVsa) < LlcpBench_LocalRw(pPeer)))
+    {
+        wLen = LlcpBench_IHeader(pPeer, pPeer->bVr, pFrame);
+        wData = pPeer->wLocalMiu;
+        if (pPeer->dwIPdus == 0U)
+        {
+            pFrame[wLen++] = PHNP_SNEP_VER;
+            pFrame[wLen++] = PHNP_SNEP_REQ_PUT;
+            pFrame[wLen++] = (uint8_t)(pPeer->dwMsgLen >> 24U);
+            pFrame[wLen++] = (uint8_t)(pPeer->dwMsgLen >> 16U);
+            pFrame[wLen++] = (uint8_t)(pPeer->dwMsgLen >> 8U);
+            pFrame[wLen++] = (uint8_t)(pPeer->dwMsgLen);
+            wData = (uint16_t)(wData - PHNP_SNEP_HEADER_SIZE);
+        }
+        if (wData > (pPeer->dwMsgLen - pPeer->dwBytes))
+        {
+            wData = (uint16_t)(pPeer->dwMsgLen - pPeer->dwBytes);
+        }
+        for (i = 0; i < wData; i++)
+        {
+            pFrame[wLen++] = LlcpBench_Pattern(pPeer->dwBytes + i);
+        }
+        pPeer->dwBytes += wData;
+        pPeer->dwIPdus++;
+        return wLen;
+    }
+    if (pPeer->bVr != pPeer->bVra)
+    {
+        return LlcpBench_Rr(pPeer, pPeer->bVr, pFrame);
+    }
+
+    pFrame[0] = 0x00U;
+    pFrame[1] = 0x00U;
+    return 2U;
+}
+
+/* ================== Application ================== */
+
+static phlnLlcp_Sw_DataParams_t s_llcp;
+static phnpSnep_Sw_DataParams_t s_snep;
+static phlnLlcp_Transport_Socket_t s_socket;
+static uint8_t s_link_rx[32];
+static uint8_t s_socket_rx[PHLN_LLCP_TLV_RW_VALUE * PHLN_LLCP_MIU];
+static uint8_t s_ndef[LLCP_BENCH_LEN_MAX];
+static uint8_t s_put[LLCP_BENCH_LEN_MAX];
+
+static uint32_t s_len;
+static uint32_t s_socket_buf_len;
+static uint8_t s_scenario;
+static uint32_t s_put_len;
+static phStatus_t s_app_status;
+
+extern phlnLlcp_Transport_Socket_t gsphlnLlcp_Socket;
+extern phlnLlcp_Transport_Socket_t *gpphlnLlcp_Socket_RegSockets;
+
+static void *LlcpBench_App(void *pArg)
+{
+    uint8_t bClientReq = 0;
+
+    (void)pArg;
+    (void)pthread_mutex_lock(&s_lock);
+    s_app_status = phnpSnep_Sw_Init(&s_snep, sizeof(s_snep), &s_llcp, &s_socket);
+    if (s_scenario == LLCP_BENCH_SCN_PUT)
+    {
+        if (s_app_status == PH_ERR_SUCCESS)
+        {
+            s_app_status = phnpSnep_Sw_ClientInit(&s_snep, phnpSnep_Default_Server, NULL, s_socket_rx,
+                s_socket_buf_len);
+        }
+        if (s_app_status == PH_ERR_SUCCESS)
+        {
+            s_app_status = phnpSnep_Sw_Put(&s_snep, s_ndef, s_len);
+        }
+    }
+    else
+    {
+        if (s_app_status == PH_ERR_SUCCESS)
+        {
+            s_app_status = phnpSnep_Sw_ServerInit(&s_snep, phnpSnep_Default_Server, NULL, s_socket_rx,
+                s_socket_buf_len);
+        }
+        if (s_app_status == PH_ERR_SUCCESS)
+        {
+            s_app_status = phnpSnep_Sw_ServerListen(&s_snep, 0, NULL, NULL, &bClientReq);
+        }
+        if (s_app_status == PH_ERR_SUCCESS)
+        {
+            s_app_status = phnpSnep_Sw_ServerSendResponse(&s_snep, bClientReq, NULL, 0, sizeof(s_put), s_put,
+                &s_put_len);
+        }
+    }
+    s_app_done = 1U;
+    (void)pthread_cond_broadcast(&s_cond);
+    (void)pthread_mutex_unlock(&s_lock);
+    return NULL;
+}
+
+/* Lets the application run until it blocks on a semaphore without a pending post, caller holds s_lock. */
+static void LlcpBench_WaitApp(void)
+{
+    while ((s_app_done == 0U) && ((s_app_wait == NULL) || (s_app_wait->dwCount != 0U)))
+    {
+        (void)pthread_cond_wait(&s_cond, &s_lock);
+    }
+}
+
+static uint32_t LlcpBench_FrameUs(uint16_t wLen)
+{
+    return (uint32_t)((((uint64_t)wLen + LLCP_BENCH_DEP_OVERHEAD) * 8U * 1000000U) / LLCP_BENCH_BITRATE)
+        + LLCP_BENCH_TURNAROUND_US;
+}
+
+/* Air time of one LLC PDU, chained over DEP frames, every chained frame is answered by an ACK frame. */
+static uint32_t LlcpBench_AirUs(uint16_t wPduLen)
+{
+    uint32_t dwUs = 0;
+
+    while (wPduLen > LLCP_BENCH_DEP_FRAME)
+    {
+        dwUs += LlcpBench_FrameUs(LLCP_BENCH_DEP_FRAME) + LlcpBench_FrameUs(0U);
+        wPduLen = (uint16_t)(wPduLen - LLCP_BENCH_DEP_FRAME);
+    }
+    return dwUs + LlcpBench_FrameUs(wPduLen);
+}
+
+/* ================== Runs ================== */
+
+typedef struct
+{
+    uint8_t bScenario;
+    uint16_t wMiu;
+    uint8_t bRw;
+    uint32_t dwTurns;
+    uint32_t dwSymmTurns;
+    uint32_t dwLocalRr;
+    uint64_t qwAirUs;
+    uint8_t bDeadlock;
+    uint8_t bDataOk;
+    phStatus_t wStatus;
+    LlcpBench_Peer_t sPeer;
+} LlcpBench_Run_t;
+
+static int LlcpBench_Run(LlcpBench_Run_t *pRun, uint32_t dwRxBps)
+{
+    static const uint8_t aSymm[2] = { 0x00U, 0x00U };
+    pthread_t thApp;
+    phTools_Q_t *pQ;
+    phlnLlcp_Transport_Socket_t *pSocket;
+    static uint8_t baRx[PHLN_LLCP_MIU + 16U];
+    uint16_t wRxLen;
+    uint8_t bPerformRx;
+    uint8_t bPtype;
+    phStatus_t wStatus;
+    uint32_t i;
+
+    (void)memset(&s_llcp, 0, sizeof(s_llcp));
+    (void)memset(&s_snep, 0, sizeof(s_snep));
+    (void)memset(&s_socket, 0, sizeof(s_socket));
+    (void)memset(&gsphlnLlcp_Socket, 0, sizeof(gsphlnLlcp_Socket));
+    (void)memset(s_sem_pool, 0, sizeof(s_sem_pool));
+    (void)memset(s_put, 0, sizeof(s_put));
+    (void)memset(&pRun->sPeer, 0, sizeof(pRun->sPeer));
+    pRun->sPeer.bScenario = pRun->bScenario;
+    pRun->sPeer.bRw = pRun->bRw;
+    pRun->sPeer.wMiu = pRun->wMiu;
+    pRun->sPeer.dwRxBps = dwRxBps;
+    pRun->sPeer.dwMsgLen = s_len;
+    pRun->sPeer.wLocalRw = -1;
+    s_sem_used = 0;
+    s_put_len = 0;
+    s_app_wait = NULL;
+    s_app_done = 0U;
+    s_scenario = pRun->bScenario;
+    s_mac_miu = pRun->wMiu;
+    /* put: the client only receives SNEP responses, one receive slot. serve: RW slots of one MIU each. */
+    s_socket_buf_len = (pRun->bScenario == LLCP_BENCH_SCN_PUT) ? PHLN_LLCP_MIU : ((uint32_t)pRun->bRw * PHLN_LLCP_MIU);
+    (void)phTools_Q_Init();
+
+    /* Link management socket as set up by phlnLlcp_Sw_Activate */
+    gpphlnLlcp_Socket_RegSockets = NULL;
+    if ((phlnLlcp_Sw_Transport_Socket_Init(&s_llcp, &gsphlnLlcp_Socket, PHLN_LLCP_TRANSPORT_SERVER_CONNECTIONORIENTED,
+            s_link_rx, sizeof(s_link_rx)) != PH_ERR_SUCCESS) ||
+        (phlnLlcp_Sw_Int_Transport_Socket_Register(&gsphlnLlcp_Socket, PHLN_LLCP_TRANSPORT_SERVER_CONNECTIONORIENTED,
+            0U, NULL, PHLN_LLCP_DEFAULTLINK_SOCKET) != PH_ERR_SUCCESS))
+    {
+        return -1;
+    }
+    gsphlnLlcp_Socket.bState = PHLN_LLCP_SOCKET_INFO_EX;
+
+    (void)pthread_mutex_lock(&s_lock);
+    if (pthread_create(&thApp, NULL, LlcpBench_App, NULL) != 0)
+    {
+        (void)pthread_mutex_unlock(&s_lock);
+        return -1;
+    }
+    LlcpBench_WaitApp();
+
+    pRun->dwTurns = 0;
+    pRun->dwSymmTurns = 0;
+    pRun->dwLocalRr = 0;
+    pRun->qwAirUs = 0;
+    pRun->bDeadlock = 0;
+    wStatus = PH_ERR_SUCCESS;
+    while (!((s_app_done != 0U) && (s_q_head == NULL)))
+    {
+        if (pRun->dwTurns >= LLCP_BENCH_TURN_LIMIT)
+        {
+            pRun->bDeadlock = 1U;
+            break;
+        }
+
+        /* Initiator half-turn: queued PDU, or SYMM from the expired SYMM timer */
+        bPerformRx = 1U;
+        pQ = phTools_Q_Receive(0U);
+        if (pQ == NULL)
+        {
+            pQ = phTools_Q_Get(0U, PH_ON);
+            pQ->pbData = (uint8_t *)aSymm;
+            pQ->dwLength = sizeof(aSymm);
+            pQ->bType = PH_TOOLS_Q_DATA_TO_BE_SENT;
+            pQ->wFrameOpt = PH_TRANSMIT_DEFAULT;
+            pQ->pSender = &gsphlnLlcp_Socket;
+        }
+        s_tx_ready = 0U;
+        wStatus = phlnLlcp_Sw_Int_Send(pQ, &bPerformRx);
+        (void)phTools_Q_Release(pQ, 0U);
+        if (wStatus != PH_ERR_SUCCESS)
+        {
+            break;
+        }
+        if ((bPerformRx == 0U) || (s_tx_ready == 0U))
+        {
+            LlcpBench_WaitApp();
+            continue;
+        }
+        bPtype = (uint8_t)PHLN_LLCP_PDU_GET_PTYPE(s_tx_frame[0], s_tx_frame[1]);
+        pRun->dwSymmTurns += (bPtype == PHLN_LLCP_PTYPE_SYMM) ? 1U : 0U;
+        pRun->dwLocalRr += (bPtype == PHLN_LLCP_PTYPE_RR) ? 1U : 0U;
+
+        /* Target half-turn and processing of its PDU */
+        pRun->qwAirUs += LlcpBench_AirUs(s_tx_len);
+        if (pRun->bScenario == LLCP_BENCH_SCN_PUT)
+        {
+            wRxLen = LlcpBench_ServerRespond(&pRun->sPeer, pRun->qwAirUs, s_tx_frame, s_tx_len, baRx);
+        }
+        else
+        {
+            wRxLen = LlcpBench_ClientRespond(&pRun->sPeer, s_tx_frame, s_tx_len, baRx);
+        }
+        pRun->qwAirUs += LlcpBench_AirUs(wRxLen);
+        pRun->dwTurns++;
+
+        bPtype = (uint8_t)PHLN_LLCP_PDU_GET_PTYPE(baRx[0], baRx[1]);
+        pSocket = NULL;
+        wStatus = phlnLlcp_Sw_Int_Pdu_Process(&s_llcp, baRx, wRxLen, bPtype, &pSocket);
+        if (phlnLlcp_Sw_Int_PostEvents(wStatus, bPtype, pSocket, baRx, s_llcp.bAgreedVersion) == PH_ON)
+        {
+            wStatus = phlnLlcp_Sw_Int_Pdu_Handle(wStatus, pSocket, baRx, wRxLen);
+        }
+        else
+        {
+            wStatus = PH_ERR_SUCCESS;
+        }
+        if (wStatus != PH_ERR_SUCCESS)
+        {
+            break;
+        }
+        LlcpBench_WaitApp();
+    }
+    pRun->wStatus = (wStatus != PH_ERR_SUCCESS) ? wStatus : s_app_status;
+
+    if (s_app_done == 0U)
+    {
+        /* Unblock a stuck application, the run has already failed. */
+        s_socket.wStatus = PH_ERR_ABORTED;
+        s_socket.bState = PHLN_LLCP_SOCKET_DISC;
+        for (i = 0; i < s_sem_used; i++)
+        {
+            s_sem_pool[i].dwCount = 1U;
+        }
+        (void)pthread_cond_broadcast(&s_cond);
+    }
+    (void)pthread_mutex_unlock(&s_lock);
+    (void)pthread_join(thApp, NULL);
+
+    pRun->bDataOk = 1U;
+    if (pRun->bScenario == LLCP_BENCH_SCN_PUT)
+    {
+        pRun->bDataOk = ((pRun->sPeer.dwTotal == s_len) && (pRun->sPeer.dwBytes == s_len)) ? 1U : 0U;
+    }
+    else
+    {
+        pRun->bDataOk = ((s_put_len == s_len) && (pRun->sPeer.bSuccess != 0U)) ? 1U : 0U;
+        for (i = 0; (i < s_put_len) && (pRun->bDataOk != 0U); i++)
+        {
+            pRun->bDataOk = (s_put[i] == LlcpBench_Pattern(i)) ? 1U : 0U;
+        }
+    }
+    return 0;
+}
+
+static double LlcpBench_Bps(const LlcpBench_Run_t *pRun)
+{
+    return (pRun->qwAirUs != 0U) ? ((double)s_len * 1e6 / (double)pRun->qwAirUs) : 0.0;
+}
+
+static const LlcpBench_Run_t *LlcpBench_Find(const LlcpBench_Run_t *pRuns, uint32_t dwRuns, uint8_t bScenario,
+    uint16_t wMiu, uint8_t bRw)
+{
+    uint32_t r;
+
+    for (r = 0; r < dwRuns; r++)
+    {
+        if ((pRuns[r].bScenario == bScenario) && (pRuns[r].wMiu == wMiu) && (pRuns[r].bRw == bRw))
+        {
+            return &pRuns[r];
+        }
+    }
+    return NULL;
+}
+
+/* ================== Main ================== */
+
+int main(int argc, char *argv[])
+{
+    static const uint16_t aPutMiu[] = { PHLN_LLCP_DEFAULT_SPEC_MIU, 248U, PHLN_LLCP_MIU };
+    static const uint8_t aRw[] = { 1U, 4U, 15U };
+    static LlcpBench_Run_t aRun[(sizeof(aPutMiu) * sizeof(aRw)) + sizeof(aRw) + 1U];
+    const LlcpBench_Run_t *pRw1;
+    const LlcpBench_Run_t *pRw4;
+    const LlcpBench_Run_t *pRw15;
+    const LlcpBench_Run_t *pBase;
+    uint32_t dwRuns = 0;
+    uint32_t dwRxBps = LLCP_BENCH_RX_BPS_DEFAULT;
+    uint32_t dwFailures = 0;
+    uint32_t dwCases = 0;
+    uint32_t m;
+    uint32_t r;
+    int16_t wExpRw;
+    int i;
+
+    s_len = LLCP_BENCH_LEN_DEFAULT;
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--len") == 0) && ((i + 1) < argc))
+        {
+            s_len = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "--rx-bps") == 0) && ((i + 1) < argc))
+        {
+            dwRxBps = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--len <bytes>] [--rx-bps <bytes/s>]\n", argv[0]);
+            return 2;
+        }
+    }
+    if ((s_len <= PHLN_LLCP_MIU) || (s_len > LLCP_BENCH_LEN_MAX))
+    {
+        fprintf(stderr, "--len must be %u..%u\n", PHLN_LLCP_MIU + 1U, LLCP_BENCH_LEN_MAX);
+        return 2;
+    }
+    for (i = 0; i < (int)s_len; i++)
+    {
+        s_ndef[i] = LlcpBench_Pattern((uint32_t)i);
+    }
+
+    for (m = 0; m < sizeof(aPutMiu) / sizeof(aPutMiu[0]); m++)
+    {
+        for (r = 0; r < sizeof(aRw); r++)
+        {
+            aRun[dwRuns].bScenario = LLCP_BENCH_SCN_PUT;
+            aRun[dwRuns].wMiu = aPutMiu[m];
+            aRun[dwRuns++].bRw = aRw[r];
+        }
+    }
+    /* Remote RW 0, every fragment waits for RR */
+    aRun[dwRuns].bScenario = LLCP_BENCH_SCN_PUT;
+    aRun[dwRuns].wMiu = PHLN_LLCP_MIU;
+    aRun[dwRuns++].bRw = 0U;
+    for (r = 0; r < sizeof(aRw); r++)
+    {
+        aRun[dwRuns].bScenario = LLCP_BENCH_SCN_SERVE;
+        aRun[dwRuns].wMiu = PHLN_LLCP_MIU;
+        aRun[dwRuns++].bRw = aRw[r];
+    }
+
+    for (r = 0; r < dwRuns; r++)
+    {
+        if (LlcpBench_Run(&aRun[r], dwRxBps) != 0)
+        {
+            fprintf(stderr, "llcp_loop_bench: setup failed\n");
+            return 1;
+        }
+
+        /* Completes without deadlock, the whole message in order and inside the announced windows. The local LLC
+         * announces one receive slot per MIU of socket buffer as RW (the default RW without TLV) and the MIU. */
+        wExpRw = (aRun[r].bScenario == LLCP_BENCH_SCN_PUT) ? 1 : (int16_t)aRun[r].bRw;
+        dwCases++;
+        if ((aRun[r].bDeadlock != 0U) || (aRun[r].wStatus != PH_ERR_SUCCESS) || (aRun[r].bDataOk == 0U) ||
+            (aRun[r].sPeer.dwWindowViolations != 0U) || (aRun[r].sPeer.dwSeqErrors != 0U) ||
+            (aRun[r].sPeer.dwDataErrors != 0U) || (aRun[r].sPeer.dwRnr != 0U) ||
+            (((aRun[r].sPeer.wLocalRw < 0) ? (int16_t)PHLN_LLCP_RW_DEFAULT : aRun[r].sPeer.wLocalRw) != wExpRw) ||
+            ((aRun[r].bScenario == LLCP_BENCH_SCN_SERVE) && (aRun[r].sPeer.wLocalMiu != aRun[r].wMiu)))
+        {
+            dwFailures++;
+        }
+    }
+
+    /* The remote forwards slower than the air time at RW 1, a wider window has to pay off. */
+    pRw1 = LlcpBench_Find(aRun, dwRuns, LLCP_BENCH_SCN_PUT, PHLN_LLCP_MIU, 1U);
+    pRw4 = LlcpBench_Find(aRun, dwRuns, LLCP_BENCH_SCN_PUT, PHLN_LLCP_MIU, 4U);
+    pRw15 = LlcpBench_Find(aRun, dwRuns, LLCP_BENCH_SCN_PUT, PHLN_LLCP_MIU, 15U);
+    dwCases++;
+    if ((dwRxBps != 0U) && (pRw4->qwAirUs >= pRw1->qwAirUs))
+    {
+        dwFailures++;
+    }
+    dwCases++;
+    if (pRw15->qwAirUs > pRw4->qwAirUs)
+    {
+        dwFailures++;
+    }
+    /* The extended MIU must beat the default spec MIU at the same window. */
+    pBase = LlcpBench_Find(aRun, dwRuns, LLCP_BENCH_SCN_PUT, PHLN_LLCP_DEFAULT_SPEC_MIU, 4U);
+    dwCases++;
+    if (pRw4->qwAirUs >= pBase->qwAirUs)
+    {
+        dwFailures++;
+    }
+    /* The local application releases each slot at once, more slots must not cost more than the RW TLV in CC. */
+    dwCases++;
+    if (LlcpBench_Find(aRun, dwRuns, LLCP_BENCH_SCN_SERVE, PHLN_LLCP_MIU, 4U)->qwAirUs >
+        (LlcpBench_Find(aRun, dwRuns, LLCP_BENCH_SCN_SERVE, PHLN_LLCP_MIU, 1U)->qwAirUs + LLCP_BENCH_RW_TLV_US))
+    {
+        dwFailures++;
+    }
+
+    printf("{\n  \"rev\": \"%s\",\n  \"len\": %u,\n  \"ext_miu\": %u,\n  \"local_rw_max\": %u,\n  \"rx_bps\": %u,\n"
+        "  \"runs\": [\n", NFCRDLIB_BENCH_REV, s_len, (unsigned)PHLN_LLCP_MIU, (unsigned)PHLN_LLCP_TLV_RW_VALUE, dwRxBps);
+    for (r = 0; r < dwRuns; r++)
+    {
+        printf("    {\"scenario\": \"%s\", \"miu\": %u, \"rw\": %u, \"status\": \"0x%04X\", \"deadlock\": %s, "
+            "\"data_ok\": %s, \"turns\": %u, \"symm_turns\": %u, \"i_pdus\": %u, \"local_rr\": %u, \"remote_rr\": %u, "
+            "\"local_rw\": %d, \"local_miu\": %u, \"window_violations\": %u, \"seq_errors\": %u, \"rnr\": %u, "
+            "\"air_ms\": %.3f, \"bytes_per_s\": %.0f}%s\n",
+            (aRun[r].bScenario == LLCP_BENCH_SCN_PUT) ? "put" : "serve", aRun[r].wMiu, aRun[r].bRw,
+            aRun[r].wStatus, (aRun[r].bDeadlock != 0U) ? "true" : "false", (aRun[r].bDataOk != 0U) ? "true" : "false",
+            aRun[r].dwTurns, aRun[r].dwSymmTurns, aRun[r].sPeer.dwIPdus, aRun[r].dwLocalRr, aRun[r].sPeer.dwRrSent,
+            aRun[r].sPeer.wLocalRw, aRun[r].sPeer.wLocalMiu, aRun[r].sPeer.dwWindowViolations,
+            aRun[r].sPeer.dwSeqErrors, aRun[r].sPeer.dwRnr, (double)aRun[r].qwAirUs / 1000.0,
+            LlcpBench_Bps(&aRun[r]), ((r + 1U) < dwRuns) ? "," : "");
+    }
+    printf("  ],\n  \"put_ext_miu\": {\"rw1_bytes_per_s\": %.0f, \"rw4_bytes_per_s\": %.0f, \"rw15_bytes_per_s\": %.0f, "
+        "\"rw4_speedup\": %.3f, \"rw15_speedup\": %.3f, \"miu128_rw4_bytes_per_s\": %.0f},\n",
+        LlcpBench_Bps(pRw1), LlcpBench_Bps(pRw4), LlcpBench_Bps(pRw15),
+        LlcpBench_Bps(pRw4) / LlcpBench_Bps(pRw1), LlcpBench_Bps(pRw15) / LlcpBench_Bps(pRw1), LlcpBench_Bps(pBase));
+    printf("  \"verify\": {\"cases\": %u, \"failures\": %u}\n}\n", dwCases, dwFailures);
+
+    return (dwFailures == 0U) ? 0 : 1;
+}
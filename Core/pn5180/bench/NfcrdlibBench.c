@@ -0,0 +1,5281 @@
+/*
+ * NfcrdlibBench.c
+ *
+ * Host micro-benchmarks for the compute kernels of the reader library
+ * The real library sources are linked (see CMakeLists.txt), only the tag
+ * access below phalTop and mful_bulk is replaced by an in-memory Type 2 tag
+ * and the PN5180 HAL below phNfcLib_15693 by a simulated ISO15693 tag.
+ * boot_prof runs on a simulated cycle counter driven through the boot
+ * sequence of main() and the demo, and emvco_analyzer on an EMVCo loopback
+ * card with injected faults behind the ISO14443-4 PAL.
+ * Results are written as JSON to stdout so they can be compared across commits.
+ *
+ * Usage: nfcrdlib_bench [--filter <substr>] [--samples <n>] [--sample-ms <ms>]
+ *                       [--m4-model] [--m4-cpi <cpi>] [--m4-mhz <mhz>]
+ *                       [--turnaround-us <us>]
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#define _GNU_SOURCE
+#include <ph_Status.h>
+#include <phTools.h>
+#include <phCryptoSym.h>
+#include <phCryptoRng.h>
+#include <phhalHw.h>
+#include <phKeyStore.h>
+#include <phpalI14443p4.h>
+#include <phpalMifare.h>
+#include <phalMful.h>
+#include <phalTop.h>
+#include <phpalSli15693.h>
+#include "../library/comps/phCryptoRng/src/Sw/phCryptoRng_Sw.h"
+#include "../library/comps/phCryptoRng/src/Sw/phCryptoRng_Sw_Int.h"
+#include "../library/comps/phpalI14443p4/src/Sw/phpalI14443p4_Sw_Int.h"
+#include "../library/comps/phalTop/src/Sw/phalTop_Sw_Int_T2T.h"
+#include "phNfcLib_Initialization.h"
+#include "phNfcLib_Int.h"
+#include "cmd_plan.h"
+#include "orig_check.h"
+#include "mful_bulk.h"
+#include "boot_prof.h"
+#include "feedback.h"
+#include "emv_resume.h"
+#include "emvco_analyzer.h"
+#include "emv_sched.h"
+#include "multi_reader.h"
+#include "emv_oda.h"
+#include "lpcd_mgr.h"
+#include <phhalHw_Pn5180_Instr.h>
+#include <phhalHw_Pn5180_Reg.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#ifndef NFCRDLIB_BENCH_REV
+#define NFCRDLIB_BENCH_REV              "unknown"
+#endif
+
+/* ================== Configuration ================== */
+#define BENCH_SAMPLES_DEFAULT           31U         /* Timed samples per case */
+#define BENCH_SAMPLE_MS_DEFAULT         5U          /* Target duration of one sample */
+#define BENCH_WARMUP_MS                 20U         /* Untimed run before calibration */
+#define BENCH_SAMPLES_MAX               255U
+
+#define BENCH_M4_CPI_DEFAULT            1.3         /* Cortex-M4 cycles per instruction, flash with ART enabled */
+#define BENCH_M4_MHZ_DEFAULT            80.0        /* STM32L431 SYSCLK */
+
+#define BENCH_DATA_LEN                  256U
+#define BENCH_PARITY_LEN                64U
+#define BENCH_PARITY_VERIFY_LEN         64U         /* Input lengths 0..64 are checked against the reference */
+#define BENCH_PARITY_VERIFY_MAX         80U         /* Buffer, encoded 64 bytes need 72 */
+#define BENCH_PARITY_VERIFY_TRIALS      16U
+#define BENCH_T2T_SIZE                  (4U * 231U) /* NTAG216 user memory plus header */
+#define BENCH_NDEF_LEN                  240U        /* Below PH_NXPNFCRDLIB_CONFIG_MAX_NDEF_DATA */
+
+/* Command plan simulator: ISO15693 tag behind phNfcLib, Linux host on USART1 */
+#define BENCH_V_BLOCKS                  64U
+#define BENCH_V_BLOCK_SIZE              4U
+#define BENCH_V_MARK                    0x5AU       /* Byte 5 of the dump, the plan writes when it matches */
+#define BENCH_V_TX_KBPS                 26.48       /* 1 out of 4 */
+#define BENCH_V_RX_KBPS                 26.69       /* High data rate, one subcarrier */
+#define BENCH_V_SOF_EOF_US              226.5       /* Reader and tag SOF + EOF */
+#define BENCH_V_T1_US                   320.9
+#define BENCH_V_WRITE_US                5000.0      /* Tag programming time assumed for WRITE SINGLE BLOCK */
+#define BENCH_UART_BAUD                 115200.0    /* MX_USART1_UART_Init, 10 bits per byte */
+#define BENCH_TURNAROUND_US_DEFAULT     2000U       /* Linux tty wake-up and host decision per round trip */
+
+/* Ultralight / NTAG simulator: ISO14443A 106 kbit/s, PN5180 HAL buffer */
+#define BENCH_UL_SECTORS                2U
+#define BENCH_UL_SECTOR_SIZE            (256U * 4U)
+#define BENCH_UL_RX_BUFSIZE             600U        /* PH_NXPNFCRDLIB_CONFIG_HAL_RX_BUFFSIZE */
+#define BENCH_UL_ETU_US                 9.44        /* 128/fc, one bit */
+#define BENCH_UL_FDT_US                 86.4        /* 1172/fc, reader frame to tag reply */
+#define BENCH_UL_HOST_US                250.0       /* PN5180 SPI load, IRQ and HAL per exchange, assumed */
+#define BENCH_UL_WRITE_US               4100.0      /* EEPROM programming of one page, NTAG21x data sheet */
+#define BENCH_UL_PASSIVE_ACK_US         1000.0      /* SECTOR_SELECT packet 2 is acknowledged by a timeout */
+#define BENCH_UL_PROFILE_DEFAULT        2U          /* NTAG216, the phalTop image */
+
+/* ISO15693 write alike simulator: phNfcLib_15693 and phpalSli15693_Sw on a simulated PN5180 HAL */
+#define BENCH_VICC_BLOCKS               256U
+#define BENCH_VICC_EOF_US               37.76       /* Reader EOF alone, 1 out of 4 */
+#define BENCH_VICC_PERSO_BLOCKS         64U         /* Personalisation written block by block */
+#define BENCH_VICC_SLOW_US              21000U      /* Programming time past PH_NFCLIB_15693_TIMEOUT_LONG_US */
+
+#define BENCH_PN5180_INSTR_US           30.0        /* PN5180 instruction: NSS, BUSY handshake, assumed */
+
+/* Boot sequence: power-on to the first poll cycle, the phase costs follow the code paths */
+#define BENCH_BOOT_MSI_HZ               4000000U    /* Core clock until SystemClock_Config */
+#define BENCH_BOOT_SYSCLK_HZ            80000000U
+#define BENCH_BOOT_HAL_INIT_US          60.0        /* SysTick, NVIC grouping, MSP init, assumed */
+#define BENCH_BOOT_CLOCK_US             250.0       /* PLL lock and flash wait states, assumed */
+#define BENCH_BOOT_MX_INIT_US           120.0       /* Six MX_*_Init, assumed */
+#define BENCH_BOOT_BANNER_BYTES         33U         /* "Start Iskboard NFC Program v1.0" */
+#define BENCH_BOOT_RAM_REPORT_BYTES     220U        /* RamBudget_Report, eight lines */
+#define BENCH_BOOT_BEEP_MS              300U        /* beep_start(1, 300): 300 ms on, 300 ms off */
+#define BENCH_BOOT_BAL_BYTES            51U         /* "[DiscoveryLoop]" and phApp_CPU_Init lines */
+#define BENCH_BOOT_RESET_MS             2U          /* PHHAL_HW_PN5180_RESET_DELAY_MILLI_SECS, three times */
+#define BENCH_BOOT_TESTBUS_MS           2U          /* PHHAL_HW_PN5180_DELAY_TO_CHECK_TESTBUS */
+#define BENCH_BOOT_DEBUG_DELAY_MS       1000U       /* HAL_Delay around the firmware version read, twice */
+#define BENCH_BOOT_FW_BYTES             20U         /* "PN-Firmware = 04 00" */
+#define BENCH_BOOT_NFCLIB_INSTR         3.0         /* Firmware version, test bus flag, power gear size */
+#define BENCH_BOOT_NFCLIB_SW_US         150.0       /* Key store, crypto, PAL, AL and discovery loop init, assumed */
+#define BENCH_BOOT_DRBG_US              500.0       /* HSI48 start, 48 entropy bytes, seed and 64 byte pool, assumed */
+#define BENCH_BOOT_DRBG_BYTES           50U         /* "DRBG seeded from hardware entropy, pool 64 bytes" */
+#define BENCH_BOOT_COMP_US              50.0
+#define BENCH_BOOT_IRQ_US               20.0
+#define BENCH_BOOT_PROFILE_INSTR        40.0        /* LoadProfile, listen mode setup, field off */
+#define BENCH_BOOT_PROFILE_BYTES        33U         /* "Entering Discovery Loop Demo..." */
+
+/* Feedback scheduler: mock one-shot timer, the removal poll loop of EMV_WaitForCardRemoval */
+#define BENCH_FB_LOG_MAX                64U
+#define BENCH_FB_POLL_MS                100U        /* HAL_Delay(100) between removal polls */
+#define BENCH_FB_POLL_RUN_MS            5U          /* phacDiscLoop_Run in the removal state, assumed */
+#define BENCH_FB_RUNS                   10000U      /* Host timing of Feedback_Play and one edge */
+
+/* EMV resume: Visa card model, the field drops at a state and the card is presented again */
+#define BENCH_RS_ACTIVATE_MS            15U         /* Field on to ATS, assumed */
+#define BENCH_RS_SELECT_MS              12U         /* PPSE or AID SELECT, assumed */
+#define BENCH_RS_GPO_MS                 60U         /* GPO with cryptogram generation, assumed */
+#define BENCH_RS_READ_MS                10U         /* READ RECORD, assumed */
+#define BENCH_RS_IA_MS                  120U        /* INTERNAL AUTHENTICATE, RSA on the card, assumed */
+#define BENCH_RS_HOST_MS                50U         /* Batched host decisions, assumed */
+#define BENCH_RS_TIMEOUT_MS             5U          /* Exchange that finds the field gone, FWT and retries */
+#define BENCH_RS_STATE_DELAY_MS         500U        /* HAL_Delay(500) after each state of EMV_ProcessPaymentFlow */
+#define BENCH_RS_RETAP_MS               2000U       /* Card presented again after the tear */
+#define BENCH_RS_SFIS                   3U          /* SFI 1..3 hold two records each, SFI 4 none */
+#define BENCH_RS_RECS_PER_SFI           2U
+#define BENCH_RS_AMOUNT                 2500U
+#define BENCH_RS_CURRENCY               0x0156U
+
+/* EMVCo loopback analyzer: test card behind the PN5180 HAL, the real ISO14443-4 PAL in EMVCo mode */
+#define BENCH_LB_HZ                     80000000U   /* Simulated SystemCoreClock for DWT->CYCCNT */
+#define BENCH_LB_APDUS                  32U         /* Loopback commands before EOT */
+#define BENCH_LB_CARD_US                1500.0      /* Card processing per C-APDU, assumed */
+#define BENCH_LB_SLOW_US                20000.0     /* Injected latency, below FWT */
+#define BENCH_LB_WTX_US                 30000.0     /* Card time before S(WTX) and after the S(WTX) response */
+#define BENCH_LB_FWI                    7U
+#define BENCH_LB_FWT_US                 39656U      /* FWI 7 plus delta TPCD, set at activation */
+#define BENCH_LB_FSDI                   8U          /* FSD and FSC 256, no chaining for the test commands */
+#define BENCH_LB_ACTIVATE_US            8000.0      /* Polling to ATS, assumed */
+#define BENCH_LB_RF_RESET_US            5100.0      /* EmvcoRfReset */
+#define BENCH_LB_SCRIPT_MAX             64U
+#define BENCH_LB_SESSIONS               200U        /* Report: loopback sessions per profile */
+#define BENCH_LB_RTT_MAX                8192U
+
+/* EMV scheduler: READ RECORD through EMV_Sched_ExchangeApdu while the records stream to the host on USART1 */
+#define BENCH_OV_RECORDS                8U
+#define BENCH_OV_CARD_US                6000.0      /* READ RECORD on the card, assumed */
+#define BENCH_OV_UART_BYTE_US           86.8        /* 115200 baud 8N1 */
+#define BENCH_OV_POLL_US                20.0        /* One pass of the scheduler loop with the HAL poll, assumed */
+#define BENCH_OV_FLAG_US                1.0         /* One read of a UART status flag */
+#define BENCH_OV_HOST_MAX               8192U
+
+/* Multi-reader simulator, PHDRIVER_READER_COUNT virtual PN5180 on one SPI bus */
+#define BENCH_MR_SPI_US                 12.0        /* One PN5180 register access or command, assumed */
+#define BENCH_MR_LOOP_US                1.0         /* Tick read in the scheduler loop */
+#define BENCH_MR_WUPA_US                100.0       /* WUPA on air plus FDT */
+#define BENCH_MR_ATQA_US                180.0       /* WUPA out and ATQA back */
+#define BENCH_MR_ACTIVATE_US            9000.0      /* Discovery loop activating a present card, assumed */
+#define BENCH_MR_FULL_POLL_US           22000.0     /* Discovery loop over A/B/F/V without a card, assumed */
+#define BENCH_MR_RESET_US               5100.0      /* Field off and GTA minimum */
+#define BENCH_MR_SIM_MS                 10000U      /* Simulated time per rate figure */
+
+/* LPCD: AGC of the simulated antenna, one LPCD wake-up check per period */
+#define BENCH_LP_GEAR                   0x0400U     /* AGC gear bits of the empty field */
+#define BENCH_LP_AGC                    480.0       /* AGC value of the empty field */
+#define BENCH_LP_DISCOVERY_MS           30U         /* Discovery loop after a wake-up, assumed */
+#define BENCH_LP_FIXED_PERIOD_MS        300U        /* Baseline: reference taken once, threshold_init, fixed period */
+#define BENCH_LP_SIM_MS                 (60U * 60U * 1000U)
+#define BENCH_LP_E2PROM_THRESHOLD       0x37U
+#define BENCH_LP_E2PROM_REFVAL_CONTROL  0x38U
+
+/* Ultralight AES authenticate, reader side timed one by one */
+#define BENCH_AUTH_RUNS                 2001U
+
+/* ================== Types ================== */
+
+typedef struct {
+    const char *name;
+    const char *component;
+    uint32_t bytes;                     /* Payload bytes per operation, 0 when not meaningful */
+    void (*run)(void);
+} Bench_Case_t;
+
+typedef struct {
+    double min_ns;
+    double median_ns;
+    double mean_ns;
+    double stddev_ns;
+    double p90_ns;
+    uint64_t ops;
+    double instr_per_op;                /* < 0 when the counter is unavailable */
+} Bench_Result_t;
+
+typedef struct {
+    const char *filter;
+    uint32_t samples;
+    uint32_t sample_ms;
+    uint8_t m4_model;
+    double m4_cpi;
+    double m4_mhz;
+    uint32_t turnaround_us;
+} Bench_Options_t;
+
+/* ================== Kernel state ================== */
+
+static volatile uint32_t s_sink;        /* Keeps results alive */
+static phStatus_t s_status;
+
+static uint8_t s_data[BENCH_DATA_LEN];
+static uint8_t s_out[BENCH_DATA_LEN + 16U];
+static uint8_t s_parity_in[BENCH_PARITY_LEN];
+static uint8_t s_parity_enc[BENCH_PARITY_LEN + (BENCH_PARITY_LEN / 8U) + 1U];
+static uint16_t s_parity_enc_len;
+static uint8_t s_parity_enc_bits;
+
+static phCryptoSym_Sw_DataParams_t s_sym;
+static phCryptoSym_Sw_DataParams_t s_sym_rng;
+static phCryptoRng_Sw_DataParams_t s_rng;
+static phCryptoSym_Sw_DataParams_t s_sym_auth;
+static phCryptoSym_Sw_DataParams_t s_sym_auth_rng;
+static phCryptoRng_Sw_DataParams_t s_auth_rng;
+
+static const uint8_t s_aes_key[16] = {
+    0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+};
+static const uint8_t s_des_key[16] = {
+    0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10
+};
+static uint8_t s_iv[16];
+
+static phalMful_Sw_DataParams_t s_mful;
+static phalTop_Sw_DataParams_t s_top;
+static uint8_t s_t2t[BENCH_UL_SECTORS * BENCH_UL_SECTOR_SIZE];
+static uint8_t s_ndef[BENCH_T2T_SIZE];
+
+/* Simulated Ultralight / NTAG, memory in s_t2t, one block of 256 pages per sector */
+typedef struct {
+    const char *name;
+    uint8_t version[PHAL_MFUL_VERSION_LENGTH];
+    uint16_t pages[BENCH_UL_SECTORS];           /* Readable pages per sector */
+    uint16_t dump[BENCH_UL_SECTORS];            /* Pages 0.. of each sector in the MfulBulk dump */
+    uint16_t user_pages;
+    uint8_t sram;                               /* FAST_WRITE accepted */
+} Bench_UlProfile_t;
+
+static const Bench_UlProfile_t s_ul_profiles[] = {
+    { "NTAG213",          { 0x00, 0x04, 0x04, 0x02, 0x01, 0x00, 0x0F, 0x03 }, { 0x2D, 0 },   { 0x2D, 0 },   36,  0 },
+    { "NTAG215",          { 0x00, 0x04, 0x04, 0x02, 0x01, 0x00, 0x11, 0x03 }, { 0x87, 0 },   { 0x87, 0 },   126, 0 },
+    { "NTAG216",          { 0x00, 0x04, 0x04, 0x02, 0x01, 0x00, 0x13, 0x03 }, { 0xE7, 0 },   { 0xE7, 0 },   222, 0 },
+    { "NTAG I2C 1k",      { 0x00, 0x04, 0x04, 0x05, 0x02, 0x01, 0x13, 0x03 }, { 0xE3, 0 },   { 0xE3, 0 },   222, 0 },
+    { "NTAG I2C 2k",      { 0x00, 0x04, 0x04, 0x05, 0x02, 0x01, 0x15, 0x03 }, { 256, 0xE0 }, { 256, 0xE0 }, 476, 0 },
+    { "NTAG I2C plus 1k", { 0x00, 0x04, 0x04, 0x05, 0x02, 0x02, 0x13, 0x03 }, { 256, 0 },    { 0xE7, 0 },   222, 1 },
+    { "NTAG I2C plus 2k", { 0x00, 0x04, 0x04, 0x05, 0x02, 0x02, 0x15, 0x03 }, { 256, 256 },  { 0xE2, 256 }, 478, 1 },
+    { "NTAG210",          { 0x00, 0x04, 0x04, 0x01, 0x01, 0x00, 0x0B, 0x03 }, { 0x14, 0 },   { 0, 0 },      0,   0 },
+};
+
+#define BENCH_UL_PROFILES               (sizeof(s_ul_profiles) / sizeof(s_ul_profiles[0]))
+#define BENCH_UL_PROFILES_KNOWN         (BENCH_UL_PROFILES - 1U)    /* NTAG210 is not in the mful_bulk table */
+
+static const Bench_UlProfile_t *s_ul = &s_ul_profiles[BENCH_UL_PROFILE_DEFAULT];
+static uint8_t s_ul_sector;
+static uint8_t s_ul_sram[MFUL_BULK_SRAM_SIZE];
+static uint8_t s_ul_rx[BENCH_UL_RX_BUFSIZE];
+static uint32_t s_ul_get_version;
+static double s_ul_air_us;
+static phpalMifare_Sw_DataParams_t s_ul_pal;
+static const uint8_t s_ul_uid[7] = { 0x04, 0x3C, 0x91, 0x5A, 0x12, 0x64, 0x80 };
+static uint8_t s_ul_dump[BENCH_UL_SECTORS * BENCH_UL_SECTOR_SIZE];
+static uint8_t s_ul_new[BENCH_UL_SECTORS * BENCH_UL_SECTOR_SIZE];
+
+static uint8_t s_vtag[BENCH_V_BLOCKS * BENCH_V_BLOCK_SIZE];
+static uint8_t s_vtag_rx[BENCH_V_BLOCK_SIZE];
+static uint16_t s_vtag_rx_len;
+static double s_vtag_air_us;            /* Modelled RF time of all exchanges so far */
+static uint8_t s_plan_out[CMD_PLAN_OUT_SIZE];
+
+/* Simulated VICC, UID LSB first: byte 6 IC manufacturer, byte 5 IC type */
+typedef struct {
+    const char *name;
+    uint8_t uid[8];
+    uint8_t icref;
+    uint16_t program_us;                /* Per block */
+} Bench_ViccProfile_t;
+
+static const Bench_ViccProfile_t s_vicc_profiles[] = {
+    { "fast",   { 0x21, 0x43, 0x65, 0x87, 0x01, 0x02, 0x04, 0xE0 }, 0x01, 1400U },
+    { "slix2",  { 0x22, 0x43, 0x65, 0x87, 0x01, 0x08, 0x04, 0xE0 }, 0x02, 3200U },
+    { "slow",   { 0x23, 0x43, 0x65, 0x87, 0x01, 0x0A, 0x04, 0xE0 }, 0x03, 6500U },
+};
+
+#define BENCH_VICC_PROFILES             (sizeof(s_vicc_profiles) / sizeof(s_vicc_profiles[0]))
+
+static phhalHw_Pn5180_DataParams_t s_vicc_hal;
+static phNfcLib_DataParams_t s_vicc_lib;
+static phNfcLib_InternalState_t s_vicc_state;
+phNfcLib_DataParams_t *gpphNfcLib_Params = &s_vicc_lib;
+phNfcLib_InternalState_t *gpphNfcLib_State = &s_vicc_state;
+
+static const Bench_ViccProfile_t *s_vicc = &s_vicc_profiles[0];
+static uint16_t s_vicc_program_us;
+static uint8_t s_vicc_mem[BENCH_VICC_BLOCKS * BENCH_V_BLOCK_SIZE];
+static uint8_t s_vicc_tx[64];
+static uint16_t s_vicc_tx_len;
+static uint8_t s_vicc_rx[16];
+static uint8_t s_vicc_sof = 1;          /* PHHAL_HW_CONFIG_SYMBOL_START, off for an EOF alone */
+static uint32_t s_vicc_timeout_us;
+static uint8_t s_vicc_pending;          /* Write alike with option flag waits for its EOF */
+static double s_vicc_ready_us;          /* Programming done */
+static double s_vicc_us;                /* Simulated time */
+static uint32_t s_vicc_eofs;
+
+/* Originality signatures of bench keys, the NXP private keys are not available */
+static const uint8_t s_orig_key128[33] = {
+    0x04, 0x34, 0xF6, 0x77, 0xCE, 0x3D, 0xDF, 0x51, 0x96, 0x5D, 0x77, 0xB6, 0xA0, 0xDA, 0x4C, 0x57,
+    0xF0, 0xD0, 0xAC, 0x6E, 0x0A, 0x13, 0x7B, 0x09, 0x51, 0x46, 0x0B, 0x2D, 0x8B, 0x91, 0xFE, 0x27,
+    0x38
+};
+static const uint8_t s_orig_key224[57] = {
+    0x04, 0xD9, 0x5E, 0x28, 0xA3, 0x84, 0x89, 0x51, 0x08, 0xE2, 0x99, 0xC2, 0x4C, 0x2D, 0xB8, 0x3F,
+    0x50, 0x12, 0x4F, 0xD6, 0x04, 0x23, 0xA8, 0x20, 0xA2, 0x6C, 0x00, 0x1C, 0xA8, 0x37, 0x98, 0x3F,
+    0x57, 0xFC, 0x96, 0x3C, 0x76, 0x49, 0x33, 0xAB, 0x11, 0x1F, 0x04, 0x49, 0x06, 0x56, 0x69, 0x7E,
+    0xFA, 0xB9, 0x77, 0x75, 0x4B, 0xB5, 0x9F, 0x2D, 0x33
+};
+static const uint8_t s_orig_uid_mful[7] = {
+    0x04, 0xA1, 0xB2, 0xC3, 0xD4, 0xE5, 0x80
+};
+static const uint8_t s_orig_sig_mful[32] = {
+    0x30, 0x5F, 0x0E, 0x33, 0x05, 0x20, 0xE5, 0x93, 0xF6, 0x5A, 0x98, 0x3D, 0x03, 0xC5, 0xE0, 0x94,
+    0xDB, 0x03, 0x9C, 0x0E, 0x1B, 0x1A, 0x2A, 0x66, 0xEE, 0x02, 0xAE, 0xC7, 0xD5, 0x50, 0x95, 0x93
+};
+static const uint8_t s_orig_uid_icode[8] = {
+    0xE0, 0x04, 0x01, 0x50, 0x12, 0x34, 0x56, 0x78
+};
+static const uint8_t s_orig_sig_icode[32] = {
+    0x8F, 0x90, 0x3A, 0x3A, 0xCA, 0xD8, 0xE6, 0xD5, 0x06, 0xB7, 0x10, 0xD2, 0x68, 0x47, 0x3F, 0xFB,
+    0x64, 0x0D, 0xCE, 0x67, 0xA8, 0xF3, 0x7A, 0x76, 0x40, 0xC7, 0x14, 0x7F, 0xFF, 0x33, 0x9C, 0xE3
+};
+static const uint8_t s_orig_uid_ntag42x[7] = {
+    0x04, 0x51, 0x8A, 0xB2, 0xC3, 0x6A, 0x80
+};
+static const uint8_t s_orig_sig_ntag42x[56] = {
+    0xBF, 0x8F, 0x66, 0xA0, 0x94, 0x9D, 0x33, 0xF2, 0x69, 0x91, 0x25, 0xE8, 0x7B, 0x0A, 0x9A, 0x7C,
+    0xD9, 0xEE, 0x5D, 0x97, 0x2E, 0xD3, 0xD9, 0xFB, 0x7C, 0xF9, 0x8A, 0x92, 0x20, 0x23, 0xA8, 0x65,
+    0x3E, 0x20, 0xDF, 0x56, 0x60, 0x08, 0xD4, 0x8B, 0x4C, 0x5D, 0x09, 0x29, 0xC4, 0x07, 0x7F, 0x56,
+    0xDA, 0x54, 0x92, 0x5D, 0xF3, 0xB0, 0x9A, 0x26
+};
+
+/* Signatures on the all-zero UID under the built-in NXP keys: u1 = 0, so r = x(kQ), s = r / k */
+static const uint8_t s_orig_forged_mful[32] = {
+    0xC6, 0x87, 0x0F, 0x5F, 0x20, 0x64, 0xC5, 0xBD, 0xEE, 0x0C, 0x66, 0x4B, 0xB9, 0xB2, 0x33, 0x7A,
+    0xD4, 0xE1, 0xAB, 0x1C, 0x52, 0xD1, 0xF5, 0x35, 0xE0, 0xB5, 0x2B, 0x1F, 0x06, 0xDA, 0xBB, 0x8B
+};
+static const uint8_t s_orig_forged_icode[32] = {
+    0x93, 0x71, 0x4E, 0x58, 0x03, 0xDA, 0x21, 0x5F, 0x7D, 0x23, 0xFE, 0xBC, 0xFE, 0xA7, 0xF1, 0xAF,
+    0xDA, 0x4D, 0x6C, 0xC3, 0xC5, 0xA6, 0x41, 0xA5, 0x71, 0x70, 0x63, 0x4E, 0x8C, 0xD4, 0x68, 0x9A
+};
+static const uint8_t s_orig_forged_ntag42x[56] = {
+    0xCB, 0x6E, 0x20, 0xFB, 0x84, 0x0A, 0x9C, 0x6A, 0x34, 0x72, 0x4A, 0xB4, 0xC1, 0x48, 0x49, 0xF5,
+    0xA7, 0xE2, 0xFE, 0x38, 0x16, 0x0C, 0x83, 0x9C, 0x66, 0x86, 0x8A, 0xC9, 0x09, 0x7D, 0xE1, 0xA4,
+    0xA2, 0xD3, 0x7A, 0x93, 0x09, 0xFA, 0xB5, 0xBF, 0x1E, 0x04, 0xA7, 0xCE, 0x99, 0xE6, 0x36, 0x4A,
+    0x0F, 0x22, 0xC5, 0xCF, 0x68, 0x58, 0x8B, 0x99
+};
+
+/* ================== In-memory Type 2 tag ================== */
+
+/* One exchange: reader frame of tx_bytes, tag reply of rx_bits (9 per byte, 4 for an ACK) */
+static void Bench_UlAir(uint32_t tx_bytes, uint32_t rx_bits)
+{
+    s_ul_air_us += BENCH_UL_HOST_US + BENCH_UL_FDT_US + (tx_bytes * 9U + 2U + rx_bits + 2U) * BENCH_UL_ETU_US;
+}
+
+static uint8_t *Bench_UlPage(uint8_t page)
+{
+    return &s_t2t[s_ul_sector * BENCH_UL_SECTOR_SIZE + (uint32_t)page * 4U];
+}
+
+/* phalTop_Sw_Int_T2T and mful_bulk go through phalMful, these serve the memory in s_t2t */
+phStatus_t phalMful_Sw_Read(phalMful_Sw_DataParams_t *pDataParams, uint8_t bAddress, uint8_t *pData)
+{
+    (void)pDataParams;
+    if (bAddress >= s_ul->pages[s_ul_sector]) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_AL_MFUL);
+    }
+    /* Four pages, rolling over to page 0 at the end of the sector */
+    for (uint8_t i = 0; i < 4U; i++) {
+        memcpy(&pData[i * 4U], Bench_UlPage((uint8_t)((bAddress + i) % s_ul->pages[s_ul_sector])), 4U);
+    }
+    Bench_UlAir(4U, 18U * 9U);
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phalMful_Sw_Write(phalMful_Sw_DataParams_t *pDataParams, uint8_t bAddress, uint8_t *pData)
+{
+    (void)pDataParams;
+    if (bAddress >= s_ul->pages[s_ul_sector]) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_AL_MFUL);
+    }
+    memcpy(Bench_UlPage(bAddress), pData, 4U);
+    Bench_UlAir(8U, 4U);
+    s_ul_air_us += BENCH_UL_WRITE_US;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phalMful_Sw_SectorSelect(phalMful_Sw_DataParams_t *pDataParams, uint8_t bSecNo)
+{
+    (void)pDataParams;
+    Bench_UlAir(4U, 4U);
+    if (bSecNo >= BENCH_UL_SECTORS || s_ul->pages[bSecNo] == 0U) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_AL_MFUL);
+    }
+    s_ul_sector = bSecNo;
+    s_ul_air_us += BENCH_UL_HOST_US + (6U * 9U + 2U) * BENCH_UL_ETU_US + BENCH_UL_PASSIVE_ACK_US;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phalMful_Sw_GetVersion(phalMful_Sw_DataParams_t *pDataParams, uint8_t *pVersion)
+{
+    (void)pDataParams;
+    memcpy(pVersion, s_ul->version, PHAL_MFUL_VERSION_LENGTH);
+    s_ul_get_version++;
+    Bench_UlAir(3U, 10U * 9U);
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phalMful_Sw_FastRead(phalMful_Sw_DataParams_t *pDataParams, uint8_t bStartAddr, uint8_t bEndAddr,
+                                uint8_t **ppData, uint16_t *pNumBytes)
+{
+    uint16_t len = (uint16_t)((bEndAddr - bStartAddr + 1U) * 4U);
+
+    (void)pDataParams;
+    if (bStartAddr > bEndAddr || bEndAddr >= s_ul->pages[s_ul_sector]) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_AL_MFUL);
+    }
+    if (len + MFUL_BULK_RX_OVERHEAD > BENCH_UL_RX_BUFSIZE) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_BUFFER_OVERFLOW, PH_COMP_HAL);
+    }
+    memcpy(s_ul_rx, Bench_UlPage(bStartAddr), len);
+    *ppData = s_ul_rx;
+    *pNumBytes = len;
+    Bench_UlAir(5U, (len + 2U) * 9U);
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phalMful_Sw_FastWrite(phalMful_Sw_DataParams_t *pDataParams, uint8_t *pData)
+{
+    (void)pDataParams;
+    Bench_UlAir(3U + MFUL_BULK_SRAM_SIZE + 2U, 4U);
+    if (!s_ul->sram) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_AL_MFUL);
+    }
+    memcpy(s_ul_sram, pData, MFUL_BULK_SRAM_SIZE);
+    return PH_ERR_SUCCESS;
+}
+
+/* Switch the simulated tag, memory filled with a pattern per sector and page */
+static void Bench_UlLoad(uint32_t profile)
+{
+    s_ul = &s_ul_profiles[profile];
+    s_ul_sector = 0;
+    s_ul_get_version = 0;
+    s_ul_air_us = 0.0;
+    memset(s_ul_sram, 0, sizeof(s_ul_sram));
+    for (uint32_t i = 0; i < sizeof(s_t2t); i++) {
+        s_t2t[i] = (uint8_t)(i * 7U + (i >> 10) * 3U + profile);
+    }
+}
+
+/* Expected dump of the loaded profile */
+static uint16_t Bench_UlExpected(uint8_t *dst)
+{
+    uint16_t pages = 0;
+
+    for (uint32_t sec = 0; sec < BENCH_UL_SECTORS; sec++) {
+        memcpy(&dst[pages * 4U], &s_t2t[sec * BENCH_UL_SECTOR_SIZE], s_ul->dump[sec] * 4U);
+        pages = (uint16_t)(pages + s_ul->dump[sec]);
+    }
+    return pages;
+}
+
+/* ================== In-memory ISO15693 tag ================== */
+
+/* CmdPlan_NfcLibExchange runs unchanged on top of these, addressed frames: flags, cmd, UID, block, CRC */
+phNfcLib_Status_t phNfcLib_Transmit(void * const pTxBuffer, uint16_t wTxBufferLength)
+{
+    const phNfcLib_I15693_t *m = &((phNfcLib_Transmit_t *)pTxBuffer)->phNfcLib_ISO15693;
+    uint32_t offset = (uint32_t)m->wBlockNumber * BENCH_V_BLOCK_SIZE;
+    uint32_t tx_bytes = 13U, rx_bytes;
+
+    (void)wTxBufferLength;
+    s_vtag_rx_len = 0;
+    if (offset >= sizeof(s_vtag)) {
+        return PH_NFCLIB_STATUS_RF_TIMEOUT_ERROR;
+    }
+    if (m->bCommand == ISO15693_ReadSingleBlock) {
+        memcpy(s_vtag_rx, &s_vtag[offset], BENCH_V_BLOCK_SIZE);
+        s_vtag_rx_len = BENCH_V_BLOCK_SIZE;
+        rx_bytes = 3U + BENCH_V_BLOCK_SIZE;
+    } else if (m->bCommand == ISO15693_WriteSingleBlock) {
+        memcpy(&s_vtag[offset], m->pBuffer, BENCH_V_BLOCK_SIZE);
+        tx_bytes += BENCH_V_BLOCK_SIZE;
+        rx_bytes = 3U;
+        s_vtag_air_us += BENCH_V_WRITE_US;
+    } else {
+        return PH_NFCLIB_STATUS_INVALID_PARAMETER;
+    }
+    s_vtag_air_us += BENCH_V_SOF_EOF_US + BENCH_V_T1_US + (tx_bytes * 8.0) / (BENCH_V_TX_KBPS / 1000.0) +
+                     (rx_bytes * 8.0) / (BENCH_V_RX_KBPS / 1000.0);
+    return PH_NFCLIB_STATUS_SUCCESS;
+}
+
+phNfcLib_Status_t phNfcLib_Receive(uint8_t * const pRxBuffer, uint16_t *pNumberOfBytes, uint8_t *pMoreDataAvailable)
+{
+    (void)pMoreDataAvailable;
+    if (s_vtag_rx_len > *pNumberOfBytes) {
+        return PH_NFCLIB_STATUS_BUFFER_OVERFLOW;
+    }
+    memcpy(pRxBuffer, s_vtag_rx, s_vtag_rx_len);
+    *pNumberOfBytes = s_vtag_rx_len;
+    return PH_NFCLIB_STATUS_SUCCESS;
+}
+
+static void Bench_VTag_Build(void)
+{
+    for (uint32_t i = 0; i < sizeof(s_vtag); i++) {
+        s_vtag[i] = (uint8_t)(i * 13U + 1U);
+    }
+    s_vtag[5] = BENCH_V_MARK;
+    s_vtag_air_us = 0.0;
+}
+
+/*
+ * "Read blocks 0..63, then write blocks 62 and 63 if byte 5 == BENCH_V_MARK"
+ * Byte 5 is byte 1 of block 1, it is read again for the branch
+ */
+static const uint8_t s_plan_read_cond_write[] = {
+    /*  0 */ CMD_PLAN_OP_SET_I, 0x00, 0x00,
+    /*  3 */ CMD_PLAN_OP_XCHG, CMD_PLAN_KIND_I15693 | CMD_PLAN_KIND_ADD_I, ISO15693_ReadSingleBlock, 0x00, 0x00, 0x00, 0,
+    /* 10 */ CMD_PLAN_OP_EXPECT_OK,
+    /* 11 */ CMD_PLAN_OP_CAPTURE, 0, 0,
+    /* 14 */ CMD_PLAN_OP_LOOP, 1, 0x00, BENCH_V_BLOCKS, 0x00, 3,
+    /* 20 */ CMD_PLAN_OP_XCHG, CMD_PLAN_KIND_I15693, ISO15693_ReadSingleBlock, 0x00, 0x01, 0x00, 0,
+    /* 27 */ CMD_PLAN_OP_BR, CMD_PLAN_COND_BYTE_NE, 1, 0xFF, BENCH_V_MARK, 0x00, 58,
+    /* 34 */ CMD_PLAN_OP_XCHG, CMD_PLAN_KIND_I15693, ISO15693_WriteSingleBlock, 0x00, 62, 0x00, 4, 0xDE, 0xAD, 0xBE, 0xEF,
+    /* 45 */ CMD_PLAN_OP_EXPECT_OK,
+    /* 46 */ CMD_PLAN_OP_XCHG, CMD_PLAN_KIND_I15693, ISO15693_WriteSingleBlock, 0x00, 63, 0x00, 4, 0xCA, 0xFE, 0xF0, 0x0D,
+    /* 57 */ CMD_PLAN_OP_EXPECT_OK,
+    /* 58 */ CMD_PLAN_OP_END
+};
+
+/* ================== Simulated ISO15693 tag behind the HAL ================== */
+
+/* Reader frame with CRC, tag reply with CRC after t1 */
+static void Bench_ViccAir(uint32_t tx_bytes, uint32_t rx_bytes)
+{
+    s_vicc_us += ((tx_bytes + 2U) * 8.0) / (BENCH_V_TX_KBPS / 1000.0);
+    if (rx_bytes != 0U) {
+        s_vicc_us += BENCH_V_SOF_EOF_US + BENCH_V_T1_US + ((rx_bytes + 2U) * 8.0) / (BENCH_V_RX_KBPS / 1000.0);
+    }
+}
+
+static phStatus_t Bench_ViccSilent(void)
+{
+    s_vicc_us += s_vicc_timeout_us;
+    return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_HAL);
+}
+
+/* Addressed frames: flags, command, UID, parameters */
+static phStatus_t Bench_ViccExchange(uint8_t **ppRxBuffer, uint16_t *pRxLength)
+{
+    const uint8_t *f = s_vicc_tx;
+    uint16_t rx_len = 1;
+    uint32_t first, blocks;
+
+    *ppRxBuffer = s_vicc_rx;
+    *pRxLength = 0;
+    s_vicc_rx[0] = 0x00;
+
+    /* EOF alone: ignored while the tag is still programming */
+    if (s_vicc_sof == 0U && s_vicc_tx_len == 0U) {
+        s_vicc_eofs++;
+        s_vicc_us += BENCH_VICC_EOF_US;
+        if (s_vicc_pending == 0U || s_vicc_us < s_vicc_ready_us) {
+            return Bench_ViccSilent();
+        }
+        s_vicc_pending = 0;
+        Bench_ViccAir(0, 1U);
+        *pRxLength = 1;
+        return PH_ERR_SUCCESS;
+    }
+
+    s_vicc_pending = 0;
+    Bench_ViccAir(s_vicc_tx_len, 0);
+    if (s_vicc_tx_len < 10U || memcmp(&f[2], s_vicc->uid, 8) != 0) {
+        return Bench_ViccSilent();
+    }
+    switch (f[1]) {
+    case 0x21:      /* WRITE SINGLE BLOCK */
+    case 0x24:      /* WRITE MULTIPLE BLOCKS */
+        first = f[10];
+        blocks = (f[1] == 0x21) ? 1U : f[11] + 1U;
+        if (first + blocks > BENCH_VICC_BLOCKS ||
+            s_vicc_tx_len != (f[1] == 0x21 ? 11U : 12U) + blocks * BENCH_V_BLOCK_SIZE) {
+            return Bench_ViccSilent();
+        }
+        memcpy(&s_vicc_mem[first * BENCH_V_BLOCK_SIZE], &f[s_vicc_tx_len - blocks * BENCH_V_BLOCK_SIZE],
+               blocks * BENCH_V_BLOCK_SIZE);
+        s_vicc_ready_us = s_vicc_us + (double)s_vicc_program_us * blocks;
+        if ((f[0] & PHPAL_SLI15693_FLAG_OPTION) != 0U) {
+            s_vicc_pending = 1;
+            return Bench_ViccSilent();
+        }
+        s_vicc_us = s_vicc_ready_us;
+        break;
+    case 0x2B:      /* GET SYSTEM INFORMATION, IC reference only */
+        s_vicc_rx[1] = 0x08;
+        memcpy(&s_vicc_rx[2], s_vicc->uid, 8);
+        s_vicc_rx[10] = s_vicc->icref;
+        rx_len = 11;
+        break;
+    default:
+        return Bench_ViccSilent();
+    }
+    Bench_ViccAir(0, rx_len);
+    *pRxLength = rx_len;
+    return PH_ERR_SUCCESS;
+}
+
+static void Bench_ViccLoad(uint32_t profile, uint16_t program_us)
+{
+    s_vicc = &s_vicc_profiles[profile];
+    s_vicc_program_us = program_us;
+    s_vicc_pending = 0;
+    s_vicc_eofs = 0;
+    s_vicc_us = 0.0;
+}
+
+static phStatus_t Bench_ViccSetup(void)
+{
+    phStatus_t status;
+
+    memset(&s_vicc_hal, 0, sizeof(s_vicc_hal));
+    s_vicc_hal.wId = PH_COMP_HAL | PHHAL_HW_PN5180_ID;
+    memset(&s_vicc_lib, 0, sizeof(s_vicc_lib));
+    memset(&s_vicc_state, 0, sizeof(s_vicc_state));
+    s_vicc_lib.sDiscLoop.pHalDataParams = &s_vicc_hal;
+    PH_CHECK_SUCCESS_FCT(status, phpalSli15693_Sw_Init(&s_vicc_lib.spalSli15693, sizeof(s_vicc_lib.spalSli15693),
+                                                       &s_vicc_hal));
+    /* Addressed after activation, high data rate */
+    s_vicc_lib.spalSli15693.bFlags = PHPAL_SLI15693_FLAG_DATA_RATE;
+    phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_FIXED);
+    Bench_ViccLoad(0, s_vicc_profiles[0].program_us);
+    return PH_ERR_SUCCESS;
+}
+
+/* One ISO15693 command through phNfcLib_15693 to the simulated tag */
+static phStatus_t Bench_ViccCmd(phNfcLib_I15693_Commands_t cmd, uint8_t option, uint16_t block, uint16_t blocks,
+                                uint8_t *data)
+{
+    phNfcLib_Transmit_t t;
+
+    memset(&t, 0, sizeof(t));
+    t.phNfcLib_ISO15693.bCommand = cmd;
+    t.phNfcLib_ISO15693.bOption = option;
+    t.phNfcLib_ISO15693.wBlockNumber = block;
+    t.phNfcLib_ISO15693.wNumBlocks = blocks;
+    t.phNfcLib_ISO15693.pBuffer = data;
+    memcpy(t.phNfcLib_ISO15693.bUid, s_vicc->uid, 8);
+    return phNfcLib_ISO15693_Transmit(&t, (uint16_t)(blocks * BENCH_V_BLOCK_SIZE));
+}
+
+/* Write the personalisation block by block, modelled time in ms */
+static double Bench_ViccPerso(uint8_t option)
+{
+    uint8_t block[BENCH_V_BLOCK_SIZE];
+    double start = s_vicc_us;
+
+    for (uint16_t b = 0; b < BENCH_VICC_PERSO_BLOCKS; b++) {
+        memset(block, (int)(b + option), sizeof(block));
+        (void)Bench_ViccCmd(ISO15693_WriteSingleBlock, option, b, 1U, block);
+    }
+    return (s_vicc_us - start) / 1000.0;
+}
+
+/* ================== Type A air time ================== */
+
+static uint64_t Bench_NowNs(void);
+
+/* Type A frame at 106 kbit/s with SOF and EOF, parity included */
+static double Bench_TypeAAirUs(uint16_t bytes)
+{
+    return (bytes * 9.0 + 2.0) * BENCH_UL_ETU_US;
+}
+
+/* ================== Boot sequence simulator ================== */
+
+static uint32_t s_boot_cyc;                     /* Simulated DWT->CYCCNT */
+static uint32_t s_boot_hz = BENCH_BOOT_MSI_HZ;  /* Simulated SystemCoreClock */
+static double s_boot_release_us;                /* Early PN5180 reset released */
+static double s_boot_us;
+
+uint32_t BootProf_HostCycles(void)
+{
+    return s_boot_cyc;
+}
+
+uint32_t BootProf_HostHz(void)
+{
+    return s_boot_hz;
+}
+
+static void Bench_BootSpend(double us)
+{
+    s_boot_cyc += (uint32_t)(us * (s_boot_hz / 1000000U));
+    s_boot_us += us;
+}
+
+static double Bench_UartUs(uint32_t bytes)
+{
+    return bytes * 10.0 * 1000000.0 / BENCH_UART_BAUD;
+}
+
+/* main() and nfc_discovery_main() up to the first poll cycle, fast: BOOT_FAST */
+static void Bench_BootRun(uint8_t fast)
+{
+    s_boot_hz = BENCH_BOOT_MSI_HZ;
+    s_boot_us = 0.0;
+    BootProf_Start(fast);
+
+    Bench_BootSpend(BENCH_BOOT_HAL_INIT_US);
+    BootProf_Mark(BOOT_PHASE_HAL_INIT);
+    Bench_BootSpend(BENCH_BOOT_CLOCK_US);
+    s_boot_hz = BENCH_BOOT_SYSCLK_HZ;
+    BootProf_Mark(BOOT_PHASE_CLOCK);
+    if (fast) {
+        Bench_BootSpend(BOOT_FAST_RESET_LOW_US);
+        s_boot_release_us = s_boot_us;
+    }
+    Bench_BootSpend(BENCH_BOOT_MX_INIT_US);
+    BootProf_Mark(BOOT_PHASE_PERIPH);
+
+    Bench_BootSpend(Bench_UartUs(BENCH_BOOT_BANNER_BYTES + (fast ? 0U : BENCH_BOOT_RAM_REPORT_BYTES)));
+    BootProf_Mark(BOOT_PHASE_BANNER);
+    Bench_BootSpend(fast ? 5.0 : 2.0 * BENCH_BOOT_BEEP_MS * 1000.0);
+    BootProf_Mark(BOOT_PHASE_BEEP);
+    Bench_BootSpend(Bench_UartUs(BENCH_BOOT_BAL_BYTES));
+    BootProf_Mark(BOOT_PHASE_BAL);
+
+    /* phhalHw_Pn5180_Init: the full reset, or only what is left of the front-end start-up */
+    if (fast) {
+        double ready_us = s_boot_release_us + BOOT_FAST_PN5180_BOOT_US;
+        Bench_BootSpend((ready_us > s_boot_us) ? ready_us - s_boot_us : 0.0);
+    } else {
+        Bench_BootSpend(3.0 * BENCH_BOOT_RESET_MS * 1000.0 + 2.0 * BENCH_BOOT_DEBUG_DELAY_MS * 1000.0);
+    }
+    Bench_BootSpend(BENCH_BOOT_TESTBUS_MS * 1000.0 + BENCH_BOOT_NFCLIB_INSTR * BENCH_PN5180_INSTR_US +
+                    Bench_UartUs(BENCH_BOOT_FW_BYTES) + BENCH_BOOT_NFCLIB_SW_US);
+    BootProf_Mark(BOOT_PHASE_NFCLIB);
+    Bench_BootSpend(fast ? 1.0 : BENCH_BOOT_DRBG_US + Bench_UartUs(BENCH_BOOT_DRBG_BYTES));
+    BootProf_Mark(BOOT_PHASE_DRBG);
+    Bench_BootSpend(BENCH_BOOT_COMP_US);
+    BootProf_Mark(BOOT_PHASE_COMP);
+    Bench_BootSpend(BENCH_BOOT_IRQ_US);
+    BootProf_Mark(BOOT_PHASE_IRQ);
+    Bench_BootSpend(BENCH_BOOT_PROFILE_INSTR * BENCH_PN5180_INSTR_US + Bench_UartUs(BENCH_BOOT_PROFILE_BYTES));
+    BootProf_Mark(BOOT_PHASE_PROFILE);
+    BootProf_Mark(BOOT_PHASE_FIRST_POLL);
+}
+
+/* ================== Feedback timer simulator ================== */
+
+typedef struct {
+    uint32_t t_ms;
+    uint8_t outputs;
+} Bench_FbEdge_t;
+
+static uint32_t s_fb_now_ms;
+static uint32_t s_fb_deadline_ms;
+static uint8_t s_fb_armed;
+static uint8_t s_fb_out;
+static Bench_FbEdge_t s_fb_log[BENCH_FB_LOG_MAX];
+static uint32_t s_fb_log_n;
+
+void Feedback_HostOutputs(uint8_t outputs)
+{
+    if (outputs != s_fb_out && s_fb_log_n < BENCH_FB_LOG_MAX) {
+        s_fb_log[s_fb_log_n].t_ms = s_fb_now_ms;
+        s_fb_log[s_fb_log_n].outputs = outputs;
+        s_fb_log_n++;
+    }
+    s_fb_out = outputs;
+}
+
+void Feedback_HostArm(uint16_t ms)
+{
+    s_fb_deadline_ms = s_fb_now_ms + ms;
+    s_fb_armed = 1;
+}
+
+void Feedback_HostDisarm(void)
+{
+    s_fb_armed = 0;
+}
+
+static void Bench_FbReset(void)
+{
+    s_fb_now_ms = 0;
+    s_fb_armed = 0;
+    s_fb_out = FEEDBACK_OUT_OFF;
+    s_fb_log_n = 0;
+    Feedback_Init();
+}
+
+/* Time passes, the one-pulse timer fires at its deadline like TIM7 */
+static void Bench_FbAdvance(uint32_t ms)
+{
+    uint32_t target = s_fb_now_ms + ms;
+
+    while (s_fb_armed && s_fb_deadline_ms <= target) {
+        s_fb_now_ms = s_fb_deadline_ms;
+        s_fb_armed = 0;
+        Feedback_OnTimer();
+    }
+    s_fb_now_ms = target;
+}
+
+static uint8_t Bench_FbLogIs(const Bench_FbEdge_t *expect, uint32_t n)
+{
+    if (s_fb_log_n != n) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        if (s_fb_log[i].t_ms != expect[i].t_ms || s_fb_log[i].outputs != expect[i].outputs) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ================== EMV resume simulator ================== */
+
+typedef struct {
+    uint32_t amount;
+    uint8_t random_uid;                         /* 08 xx xx xx, new on every activation */
+    uint8_t uid_variant;                        /* Another card with a fixed UID */
+    uint8_t label_variant;                      /* Other application label behind the same AID */
+    uint8_t pdol_variant;                       /* Other PDOL behind the same AID */
+    uint8_t aip_variant;                        /* Other AIP in the GPO response */
+    uint8_t pan_variant;                        /* Other PAN in SFI 1 record 1 */
+} Bench_RsCard_t;
+
+typedef struct {
+    EMV_Payment_State_t drop_state;             /* EMV_STATE_IDLE: the card stays */
+    uint8_t drop_after;                         /* Card commands of drop_state answered before the drop */
+    EMV_Payment_State_t state;
+    uint8_t state_apdus;
+    uint8_t gone;
+    uint8_t resumed;                            /* EMV_Resume_Lookup matched */
+    uint32_t t_ms;                              /* Activation to success or tear */
+    uint32_t delay_ms;                          /* Part of t_ms in the observation delay between states */
+    uint32_t field_ms;                          /* Last card command answered */
+    uint32_t apdus;
+    uint32_t reads;                             /* READ RECORD commands */
+} Bench_RsTap_t;
+
+static Bench_RsCard_t s_rs_card;
+static Bench_RsTap_t s_rs;
+static EMV_Payment_Context_t s_rs_ctx;
+static uint32_t s_rs_now_ms = 1000U;
+static uint16_t s_rs_atc;
+static uint8_t s_rs_uid_seq;
+
+static void Bench_RsCardReset(void)
+{
+    memset(&s_rs_card, 0, sizeof(s_rs_card));
+    s_rs_card.amount = BENCH_RS_AMOUNT;
+    EMV_Resume_Clear();
+}
+
+/* Directory with the Visa AID only, the fixed AID list of the demo tries MasterCard first */
+static uint16_t Bench_RsPpseResp(uint8_t *buf)
+{
+    static const uint8_t resp[] = {
+        0x6F, 0x23, 0x84, 0x0E, '2', 'P', 'A', 'Y', '.', 'S', 'Y', 'S', '.', 'D', 'D', 'F', '0', '1',
+        0xA5, 0x11, 0xBF, 0x0C, 0x0E, 0x61, 0x0C, 0x4F, 0x07, 0xA0, 0x00, 0x00, 0x00, 0x03, 0x10, 0x10,
+        0x87, 0x01, 0x01, 0x90, 0x00
+    };
+
+    memcpy(buf, resp, sizeof(resp));
+    return (uint16_t)sizeof(resp);
+}
+
+/* PDOL 9F66 (TTQ) and 9F02 (amount) */
+static uint16_t Bench_RsSelectResp(uint8_t *buf)
+{
+    static const uint8_t resp[] = {
+        0x6F, 0x1D, 0x84, 0x07, 0xA0, 0x00, 0x00, 0x00, 0x03, 0x10, 0x10,
+        0xA5, 0x12, 0x50, 0x04, 'V', 'I', 'S', 'A', 0x87, 0x01, 0x01,
+        0x9F, 0x38, 0x06, 0x9F, 0x66, 0x04, 0x9F, 0x02, 0x06, 0x90, 0x00
+    };
+
+    memcpy(buf, resp, sizeof(resp));
+    buf[18] ^= s_rs_card.label_variant;
+    buf[27] ^= s_rs_card.pdol_variant;
+    return (uint16_t)sizeof(resp);
+}
+
+/* Format 2, ATC and application cryptogram new on every GPO */
+static uint16_t Bench_RsGpoResp(uint8_t *buf)
+{
+    static const uint8_t resp[] = {
+        0x77, 0x22, 0x82, 0x02, 0x39, 0x00,
+        0x94, 0x0C, 0x08, 0x01, 0x02, 0x00, 0x10, 0x01, 0x02, 0x00, 0x18, 0x01, 0x02, 0x01,
+        0x9F, 0x36, 0x02, 0x00, 0x00,
+        0x9F, 0x26, 0x08, 0, 0, 0, 0, 0, 0, 0, 0, 0x90, 0x00
+    };
+
+    memcpy(buf, resp, sizeof(resp));
+    buf[4] ^= s_rs_card.aip_variant;
+    s_rs_atc++;
+    buf[23] = (uint8_t)(s_rs_atc >> 8);
+    buf[24] = (uint8_t)s_rs_atc;
+    for (uint8_t i = 0; i < 8U; i++) {
+        buf[28 + i] = (uint8_t)(s_rs_atc * 37U + i * 11U);
+    }
+    return (uint16_t)sizeof(resp);
+}
+
+/* SFI 1 record 1 carries the PAN, 0: record not found (6A83) */
+static uint16_t Bench_RsRecord(uint8_t sfi, uint8_t record, uint8_t *buf)
+{
+    static const uint8_t pan[] = {
+        0x70, 0x0A, 0x5A, 0x08, 0x47, 0x61, 0x73, 0x90, 0x01, 0x01, 0x00, 0x10, 0x90, 0x00
+    };
+
+    if (sfi < 1U || sfi > BENCH_RS_SFIS || record < 1U || record > BENCH_RS_RECS_PER_SFI) {
+        return 0;
+    }
+    if (sfi == 1U && record == 1U) {
+        memcpy(buf, pan, sizeof(pan));
+        buf[11] ^= s_rs_card.pan_variant;
+        return (uint16_t)sizeof(pan);
+    }
+    buf[0] = 0x70;
+    buf[1] = 0x04;
+    buf[2] = 0x8C;
+    buf[3] = 0x02;
+    buf[4] = sfi;
+    buf[5] = record;
+    buf[6] = 0x90;
+    buf[7] = 0x00;
+    return 8U;
+}
+
+/* One card command, fails once the field has dropped */
+static uint8_t Bench_RsApdu(uint32_t ms)
+{
+    if (s_rs.gone || (s_rs.state == s_rs.drop_state && s_rs.state_apdus >= s_rs.drop_after)) {
+        s_rs.gone = 1;
+        s_rs.t_ms += BENCH_RS_TIMEOUT_MS;
+        return 0;
+    }
+    s_rs.apdus++;
+    s_rs.state_apdus++;
+    s_rs.t_ms += ms;
+    s_rs.field_ms = s_rs.t_ms;
+    return 1;
+}
+
+/* The card side of each state, resume calls at the same points as emv_payment_flow.c */
+static EMV_Result_t Bench_RsRun(EMV_Payment_State_t state, EMV_Payment_State_t *next)
+{
+    EMV_Complete_Card_Data_t *card = &s_rs_ctx.card_data;
+    const uint8_t *cached;
+    uint16_t cached_len, len;
+    uint8_t buf[32];
+    uint8_t sfi, record;
+
+    switch (state) {
+    case EMV_STATE_APP_SELECTION:
+        *next = EMV_STATE_APP_INITIALIZATION;
+        if (s_rs_ctx.resuming) {
+            if (!Bench_RsApdu(BENCH_RS_SELECT_MS)) {
+                return EMV_ERROR_COMMUNICATION;
+            }
+            card->app_select_len = Bench_RsSelectResp(card->app_select_data);
+            if (EMV_Resume_MatchSelect(card)) {
+                return EMV_SUCCESS;
+            }
+            s_rs_ctx.resuming = 0;
+        }
+        /* PPSE, MasterCard refused (6A82), Visa: the demo walks its fixed AID list */
+        for (uint8_t i = 0; i < 3U; i++) {
+            if (!Bench_RsApdu(BENCH_RS_SELECT_MS)) {
+                return EMV_ERROR_APP_SELECT;
+            }
+            if (i == 0U) {
+                card->ppse_len = Bench_RsPpseResp(card->ppse_data);
+            }
+        }
+        card->app_select_len = Bench_RsSelectResp(card->app_select_data);
+        return EMV_SUCCESS;
+
+    case EMV_STATE_APP_INITIALIZATION:
+        *next = EMV_STATE_READ_APP_DATA;
+        if (!Bench_RsApdu(BENCH_RS_GPO_MS)) {
+            return EMV_ERROR_COMMUNICATION;
+        }
+        card->gpo_len = Bench_RsGpoResp(card->gpo_data);
+        if (!s_rs_ctx.resuming) {
+            return EMV_SUCCESS;
+        }
+        if (!EMV_Resume_MatchGpo(card)) {
+            s_rs_ctx.resuming = 0;
+            return EMV_SUCCESS;
+        }
+        if (EMV_Resume_PanRecord(&sfi, &record, &cached, &cached_len)) {
+            if (!Bench_RsApdu(BENCH_RS_READ_MS)) {
+                return EMV_ERROR_COMMUNICATION;
+            }
+            s_rs.reads++;
+            len = Bench_RsRecord(sfi, record, buf);
+            if (len != cached_len || memcmp(buf, cached, len) != 0) {
+                EMV_Resume_Drop();
+                s_rs_ctx.resuming = 0;
+                return EMV_SUCCESS;
+            }
+        }
+        (void)EMV_Resume_Restore(card);
+        if (EMV_Resume_RecordsComplete()) {
+            *next = EMV_STATE_OFFLINE_DATA_AUTH;
+        }
+        return EMV_SUCCESS;
+
+    case EMV_STATE_READ_APP_DATA:
+        /* EMV_CollectAllRecords */
+        *next = EMV_STATE_OFFLINE_DATA_AUTH;
+        for (sfi = 1; sfi <= 4U; sfi++) {
+            for (record = 1; record <= 5U; record++) {
+                uint8_t have = 0;
+
+                for (uint8_t i = 0; i < card->sfi_record_count; i++) {
+                    if (card->sfi_record_sfi[i] == sfi && card->sfi_record_num[i] == record) {
+                        have = 1;
+                    }
+                }
+                if (have) {
+                    continue;
+                }
+                if (!Bench_RsApdu(BENCH_RS_READ_MS)) {
+                    return EMV_ERROR_COMMUNICATION;
+                }
+                s_rs.reads++;
+                len = Bench_RsRecord(sfi, record, buf);
+                if (len == 0U) {
+                    break;
+                }
+                if (card->sfi_record_count < 10U) {
+                    memcpy(card->sfi_records[card->sfi_record_count], buf, len);
+                    card->sfi_record_lens[card->sfi_record_count] = len;
+                    card->sfi_record_sfi[card->sfi_record_count] = sfi;
+                    card->sfi_record_num[card->sfi_record_count] = record;
+                    card->sfi_record_count++;
+                }
+            }
+        }
+        return (card->sfi_record_count > 0U) ? EMV_SUCCESS : EMV_ERROR_READ_RECORD;
+
+    case EMV_STATE_OFFLINE_DATA_AUTH:
+        /* No signature for the host, the stage fails like a lost host link */
+        *next = EMV_STATE_PROCESSING_RESTRICTIONS;
+        if (!Bench_RsApdu(BENCH_RS_IA_MS)) {
+            return EMV_ERROR_COMMUNICATION;
+        }
+        s_rs.t_ms += BENCH_RS_HOST_MS;
+        return EMV_SUCCESS;
+
+    default:
+        /* Decided on the device or from the batched host reply, no card command */
+        *next = (state == EMV_STATE_SCRIPT_PROCESSING) ? EMV_STATE_SUCCESS : (EMV_Payment_State_t)(state + 1);
+        return EMV_SUCCESS;
+    }
+}
+
+/* EMV_ProcessPaymentFlow from card activation, drop_state EMV_STATE_IDLE: the card stays */
+static EMV_Payment_State_t Bench_RsTap(EMV_Payment_State_t drop_state, uint8_t drop_after)
+{
+    EMV_Complete_Card_Data_t *card = &s_rs_ctx.card_data;
+    EMV_Payment_State_t state = EMV_STATE_APP_SELECTION;
+    EMV_Payment_State_t next = EMV_STATE_FAILED;
+    EMV_Result_t result;
+
+    memset(&s_rs, 0, sizeof(s_rs));
+    s_rs.drop_state = drop_state;
+    s_rs.drop_after = drop_after;
+    memset(&s_rs_ctx, 0, sizeof(s_rs_ctx));
+    card->amount = s_rs_card.amount;
+    card->currency_code = BENCH_RS_CURRENCY;
+    if (s_rs_card.random_uid) {
+        static const uint8_t uid[] = { 0x08, 0x00, 0x5C, 0x91 };
+
+        memcpy(card->card_uid, uid, sizeof(uid));
+        card->card_uid[1] = ++s_rs_uid_seq;
+        card->card_uid_len = (uint8_t)sizeof(uid);
+    } else {
+        static const uint8_t uid[] = { 0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+
+        memcpy(card->card_uid, uid, sizeof(uid));
+        card->card_uid[6] ^= s_rs_card.uid_variant;
+        card->card_uid_len = (uint8_t)sizeof(uid);
+    }
+
+    s_rs.t_ms = BENCH_RS_ACTIVATE_MS;
+    s_rs_ctx.resuming = EMV_Resume_Lookup(card, s_rs_now_ms + s_rs.t_ms);
+    s_rs.resumed = s_rs_ctx.resuming;
+
+    while (state != EMV_STATE_SUCCESS) {
+        s_rs.state = state;
+        s_rs.state_apdus = 0;
+        result = Bench_RsRun(state, &next);
+        if (result != EMV_SUCCESS) {
+            s_rs_ctx.failed_state = state;
+            s_rs_ctx.current_state = EMV_STATE_FAILED;
+            s_rs_ctx.last_error = result;
+            EMV_Resume_Save(&s_rs_ctx, s_rs_now_ms + s_rs.t_ms);
+            s_rs_now_ms += s_rs.t_ms;
+            return EMV_STATE_FAILED;
+        }
+        if (!s_rs_ctx.resuming) {
+            s_rs.t_ms += BENCH_RS_STATE_DELAY_MS;
+            s_rs.delay_ms += BENCH_RS_STATE_DELAY_MS;
+        }
+        state = next;
+    }
+    EMV_Resume_Clear();
+    s_rs_now_ms += s_rs.t_ms;
+    return EMV_STATE_SUCCESS;
+}
+
+/* Records of the last tap are those of a clean read, in any order */
+static uint8_t Bench_RsRecordsComplete(void)
+{
+    const EMV_Complete_Card_Data_t *card = &s_rs_ctx.card_data;
+    uint8_t buf[32];
+    uint16_t len;
+
+    if (card->sfi_record_count != BENCH_RS_SFIS * BENCH_RS_RECS_PER_SFI) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < card->sfi_record_count; i++) {
+        len = Bench_RsRecord(card->sfi_record_sfi[i], card->sfi_record_num[i], buf);
+        if (len == 0U || len != card->sfi_record_lens[i] || memcmp(buf, card->sfi_records[i], len) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ================== EMVCo loopback simulator ================== */
+
+#define BENCH_LB_F_LOSE_CMD             0x01U       /* Reader frame not received by the card */
+#define BENCH_LB_F_LOSE_RESP            0x02U       /* Card frame lost on the way back */
+#define BENCH_LB_F_CORRUPT              0x04U       /* Card frame received with a CRC error */
+#define BENCH_LB_F_WTX                  0x08U       /* C-APDU answered with S(WTX) first */
+#define BENCH_LB_F_SLOW                 0x10U       /* Card processing BENCH_LB_SLOW_US longer */
+
+typedef struct {
+    const char *name;
+    uint16_t lose_cmd;                          /* Per mille of reader frames */
+    uint16_t lose_resp;                         /* Per mille of card frames */
+    uint16_t corrupt;                           /* Per mille of card frames */
+    uint16_t wtx;                               /* Per mille of C-APDUs */
+    uint32_t jitter_us;                         /* Extra card processing time, uniform 0..jitter_us */
+} Bench_LbProfile_t;
+
+static const Bench_LbProfile_t s_lb_profiles[] = {
+    { "clean",   0,  0,  0,  0,   0U },
+    { "latency", 0,  0,  0,  0,   8000U },
+    { "wtx",     0,  0,  0,  100, 0U },
+    { "lossy",   20, 20, 20, 0,   0U },
+    { "harsh",   30, 30, 30, 50,  8000U },
+};
+
+#define BENCH_LB_PROFILES               (sizeof(s_lb_profiles) / sizeof(s_lb_profiles[0]))
+
+/* Card side of ISO/IEC 14443-4, PICC rules C, D, 11 and 12 */
+typedef struct {
+    uint8_t blk;                                /* PICC block number */
+    uint8_t apdus;                              /* Loopback commands issued */
+    uint8_t issued[64];                         /* Last command issued, expected back without SW */
+    uint8_t issued_len;
+    uint8_t last[72];                           /* Last block sent, for rule 11 */
+    uint8_t last_len;
+    uint8_t pending[72];                        /* I-Block held back behind S(WTX) */
+    uint8_t pending_len;
+    uint32_t frames;                            /* Reader frames since activation */
+    uint32_t mismatches;                        /* C-APDU other than the R-APDU without SW */
+    uint32_t lost;                              /* Frames the fault injection ate */
+} Bench_LbCard_t;
+
+static phhalHw_Pn5180_DataParams_t s_lb_hal;
+static phpalI14443p4_Sw_DataParams_t s_lb_pal;
+static const Bench_LbProfile_t *s_lb_prof = &s_lb_profiles[0];
+static Bench_LbCard_t s_lb_card;
+static uint8_t s_lb_script[BENCH_LB_SCRIPT_MAX]; /* Faults by reader frame index, before the profile */
+static uint32_t s_lb_rng = 1U;
+static uint8_t s_lb_tx[300];
+static uint16_t s_lb_tx_len;
+static uint8_t s_lb_rx[300];
+static uint16_t s_lb_startpos;
+static uint32_t s_lb_timeout_us;
+static double s_lb_us;                          /* Simulated time */
+static uint64_t s_lb_card_ns;                   /* Host time spent in the card model */
+static uint8_t s_lb_frame[EMVCO_ANALYZER_FRAME_LEN];
+static uint16_t s_lb_frame_len;
+static uint32_t s_lb_frames;                    /* Summaries sent */
+static EmvcoAnalyzer_Window_t s_lb_sent;        /* Counters of the summaries sent, added up by the host */
+
+typedef struct {
+    uint32_t sessions;
+    uint32_t completed;                         /* EOT received */
+    uint32_t exchanges;
+    uint32_t errors;
+    uint64_t bytes;                             /* C-APDU and R-APDU */
+    double loop_us;                             /* Sum of the round trips */
+    uint64_t pal_ns;                            /* Host time in phpalI14443p4_Exchange without the card model */
+    uint64_t analyzer_ns;                       /* Host time in EmvcoAnalyzer_Begin / End */
+    uint32_t rtt_n;
+    double rtt_us[BENCH_LB_RTT_MAX];
+} Bench_LbRun_t;
+
+static Bench_LbRun_t s_lb_run;
+
+uint32_t EmvcoAnalyzer_HostCycles(void)
+{
+    return (uint32_t)(uint64_t)(s_lb_us * (BENCH_LB_HZ / 1000000U));
+}
+
+uint32_t EmvcoAnalyzer_HostHz(void)
+{
+    return BENCH_LB_HZ;
+}
+
+uint32_t EmvcoAnalyzer_HostMs(void)
+{
+    return (uint32_t)(uint64_t)(s_lb_us / 1000.0);
+}
+
+static uint32_t Bench_LbU32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint16_t Bench_LbU16(const uint8_t *p)
+{
+    return (uint16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+
+/* Summary frame as the host decodes it, 0 when the layout is off */
+static uint8_t Bench_LbParse(const uint8_t *f, uint16_t len, EmvcoAnalyzer_Window_t *w, uint16_t *seq,
+                             uint32_t *period_ms)
+{
+    uint16_t pos = 8;
+
+    if (len != EMVCO_ANALYZER_FRAME_LEN || f[0] != 0xAA || f[1] != 0x55 ||
+        f[2] != EMVCO_ANALYZER_LINUX_CMD_SUMMARY || Bench_LbU16(&f[3]) != EMVCO_ANALYZER_SUMMARY_LEN ||
+        f[5] != EMVCO_ANALYZER_VERSION || f[len - 2U] != 0x0D || f[len - 1U] != 0x0A) {
+        return 0;
+    }
+    memset(w, 0, sizeof(*w));
+    *seq = Bench_LbU16(&f[6]);
+    *period_ms = Bench_LbU32(&f[pos]);
+    pos += 4U;
+    w->exchanges = Bench_LbU32(&f[pos]);
+    w->errors = Bench_LbU32(&f[pos + 4U]);
+    w->rf_resets = Bench_LbU16(&f[pos + 8U]);
+    w->loopbacks = Bench_LbU16(&f[pos + 10U]);
+    pos += 12U;
+    w->wtx = Bench_LbU32(&f[pos]);
+    w->naks = Bench_LbU32(&f[pos + 4U]);
+    w->retransmits = Bench_LbU32(&f[pos + 8U]);
+    w->tx_bytes = Bench_LbU32(&f[pos + 12U]);
+    w->rx_bytes = Bench_LbU32(&f[pos + 16U]);
+    w->rtt_min_us = Bench_LbU32(&f[pos + 20U]);
+    w->rtt_max_us = Bench_LbU32(&f[pos + 24U]);
+    w->rtt_sum_us = Bench_LbU32(&f[pos + 28U]);
+    pos += 32U;
+    if (f[pos++] != EMVCO_ANALYZER_RTT_BINS) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < EMVCO_ANALYZER_RTT_BINS; i++, pos += 2U) {
+        w->rtt_hist[i] = Bench_LbU16(&f[pos]);
+    }
+    if (f[pos++] != EMVCO_ANALYZER_EVENT_BINS) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < EMVCO_ANALYZER_EVENT_BINS; i++, pos += 2U) {
+        w->wtx_hist[i] = Bench_LbU16(&f[pos]);
+    }
+    for (uint8_t i = 0; i < EMVCO_ANALYZER_EVENT_BINS; i++, pos += 2U) {
+        w->retry_hist[i] = Bench_LbU16(&f[pos]);
+    }
+    return (pos + 2U == len) ? 1U : 0U;
+}
+
+void EmvcoAnalyzer_HostSend(const uint8_t *frame, uint16_t len)
+{
+    EmvcoAnalyzer_Window_t w;
+    uint16_t seq;
+    uint32_t period_ms;
+
+    memcpy(s_lb_frame, frame, len);
+    s_lb_frame_len = len;
+    s_lb_frames++;
+    if (Bench_LbParse(frame, len, &w, &seq, &period_ms)) {
+        s_lb_sent.exchanges += w.exchanges;
+        s_lb_sent.errors += w.errors;
+        s_lb_sent.wtx += w.wtx;
+        s_lb_sent.naks += w.naks;
+        s_lb_sent.retransmits += w.retransmits;
+    }
+}
+
+static uint32_t Bench_LbRand(uint32_t range)
+{
+    s_lb_rng = s_lb_rng * 1103515245UL + 12345UL;
+    return (range != 0U) ? ((s_lb_rng >> 8) % range) : 0U;
+}
+
+static uint8_t Bench_LbFaults(void)
+{
+    uint8_t f = 0;
+
+    if (s_lb_card.frames < BENCH_LB_SCRIPT_MAX && s_lb_script[s_lb_card.frames] != 0U) {
+        return s_lb_script[s_lb_card.frames];
+    }
+    if (Bench_LbRand(1000U) < s_lb_prof->lose_cmd) {
+        f |= BENCH_LB_F_LOSE_CMD;
+    }
+    if (Bench_LbRand(1000U) < s_lb_prof->lose_resp) {
+        f |= BENCH_LB_F_LOSE_RESP;
+    }
+    if (Bench_LbRand(1000U) < s_lb_prof->corrupt) {
+        f |= BENCH_LB_F_CORRUPT;
+    }
+    if (Bench_LbRand(1000U) < s_lb_prof->wtx) {
+        f |= BENCH_LB_F_WTX;
+    }
+    return f;
+}
+
+/* Test application: every R-APDU carries the next command, EOT after BENCH_LB_APDUS */
+static uint8_t Bench_LbApdu(const uint8_t *capdu, uint16_t len, uint8_t *rapdu)
+{
+    static const uint8_t eot[] = { 0x00, 0x70, 0x00, 0x00, 0x00, 0x90, 0x00 };
+    uint8_t n, data;
+
+    if (s_lb_card.apdus == 0U) {
+        if (len < 5U || capdu[1] != 0xA4) {
+            s_lb_card.mismatches++;
+        }
+    } else if (len != s_lb_card.issued_len || memcmp(capdu, s_lb_card.issued, len) != 0) {
+        s_lb_card.mismatches++;
+    }
+    if (s_lb_card.apdus >= BENCH_LB_APDUS) {
+        memcpy(rapdu, eot, sizeof(eot));
+        return (uint8_t)sizeof(eot);
+    }
+
+    n = ++s_lb_card.apdus;
+    data = (uint8_t)((n * 11U) % 48U);
+    s_lb_card.issued[0] = 0x80;
+    s_lb_card.issued[1] = 0xCA;
+    s_lb_card.issued[2] = 0x9F;
+    s_lb_card.issued[3] = n;
+    s_lb_card.issued[4] = data;
+    for (uint8_t i = 0; i < data; i++) {
+        s_lb_card.issued[5U + i] = (uint8_t)(n + i);
+    }
+    s_lb_card.issued_len = (uint8_t)(5U + data);
+    memcpy(rapdu, s_lb_card.issued, s_lb_card.issued_len);
+    rapdu[s_lb_card.issued_len] = 0x90;
+    rapdu[s_lb_card.issued_len + 1U] = 0x00;
+    return (uint8_t)(s_lb_card.issued_len + 2U);
+}
+
+/* One reader frame (PCB, INF) to the card, the card block in s_lb_rx */
+static phStatus_t Bench_LbCardExchange(uint8_t **ppRxBuffer, uint16_t *pRxLength)
+{
+    const uint8_t *f = s_lb_tx;
+    const uint8_t pcb = f[0];
+    uint64_t t0 = Bench_NowNs();
+    uint8_t faults = Bench_LbFaults();
+    double sent_us, proc_us = 0.0;
+    uint8_t *out = s_lb_card.last;
+    uint8_t out_len = 0;
+
+    *ppRxBuffer = s_lb_rx;
+    *pRxLength = 0;
+    s_lb_card.frames++;
+    s_lb_us += BENCH_UL_HOST_US + Bench_TypeAAirUs((uint16_t)(s_lb_tx_len + 2U));
+    sent_us = s_lb_us;
+
+    if ((faults & BENCH_LB_F_LOSE_CMD) != 0U || s_lb_tx_len == 0U) {
+        s_lb_card.lost++;
+        s_lb_us += s_lb_timeout_us;
+        s_lb_card_ns += Bench_NowNs() - t0;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_HAL);
+    }
+
+    if ((pcb & 0xE2U) == 0x02U) {
+        /* Rule D: block number of the I-Block received */
+        s_lb_card.blk = pcb & 0x01U;
+        out[0] = (uint8_t)(0x02U | s_lb_card.blk);
+        out_len = (uint8_t)(1U + Bench_LbApdu(&f[1], (uint16_t)(s_lb_tx_len - 1U), &out[1]));
+        proc_us = BENCH_LB_CARD_US + (double)Bench_LbRand(s_lb_prof->jitter_us + 1U);
+        if ((faults & BENCH_LB_F_SLOW) != 0U) {
+            proc_us += BENCH_LB_SLOW_US;
+        }
+        if ((faults & BENCH_LB_F_WTX) != 0U) {
+            memcpy(s_lb_card.pending, out, out_len);
+            s_lb_card.pending_len = out_len;
+            out[0] = 0xF2;
+            out[1] = 0x01;
+            out_len = 2;
+            proc_us = BENCH_LB_WTX_US;
+        }
+        s_lb_card.last_len = out_len;
+    } else if ((pcb & 0xF7U) == 0xF2U && s_lb_card.pending_len != 0U) {
+        /* S(WTX) response: the held back I-Block after the extra time */
+        memcpy(out, s_lb_card.pending, s_lb_card.pending_len);
+        out_len = s_lb_card.pending_len;
+        s_lb_card.pending_len = 0;
+        s_lb_card.last_len = out_len;
+        proc_us = BENCH_LB_WTX_US;
+    } else if ((pcb & 0xE6U) == 0xA2U) {
+        if ((pcb & 0x01U) == s_lb_card.blk) {
+            /* Rule 11: send the last block again */
+            out_len = s_lb_card.last_len;
+        } else if ((pcb & 0x10U) != 0U) {
+            /* Rule 12: R(NAK) for a block never received, R(ACK) */
+            out = s_lb_rx;
+            out[0] = (uint8_t)(0xA2U | s_lb_card.blk);
+            out_len = 1;
+        }
+    } else if ((pcb & 0xF7U) == 0xC2U) {
+        out = s_lb_rx;
+        out[0] = 0xC2;
+        out_len = 1;
+    }
+
+    if (out_len == 0U || BENCH_UL_FDT_US + proc_us >= (double)s_lb_timeout_us ||
+        (faults & BENCH_LB_F_LOSE_RESP) != 0U) {
+        /* Nothing sent, or not before the reader gave up */
+        s_lb_card.lost += (out_len != 0U) ? 1U : 0U;
+        s_lb_us = sent_us + s_lb_timeout_us;
+        s_lb_card_ns += Bench_NowNs() - t0;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_HAL);
+    }
+    s_lb_us += BENCH_UL_FDT_US + proc_us + Bench_TypeAAirUs((uint16_t)(out_len + 2U));
+    if ((faults & BENCH_LB_F_CORRUPT) != 0U) {
+        s_lb_card.lost++;
+        s_lb_card_ns += Bench_NowNs() - t0;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INTEGRITY_ERROR, PH_COMP_HAL);
+    }
+    if (out != s_lb_rx) {
+        memcpy(s_lb_rx, out, out_len);
+    }
+    *pRxLength = out_len;
+    s_lb_card_ns += Bench_NowNs() - t0;
+    return PH_ERR_SUCCESS;
+}
+
+/* Field on, activation and protocol parameters as phpalI14443p4a leaves them in EMVCo mode */
+static phStatus_t Bench_LbActivate(void)
+{
+    phStatus_t status;
+
+    s_lb_us += BENCH_LB_ACTIVATE_US;
+    memset(&s_lb_card, 0, sizeof(s_lb_card));
+    s_lb_card.blk = 1U;                         /* Rule C */
+    s_lb_timeout_us = BENCH_LB_FWT_US;
+    s_lb_startpos = 0;
+    PH_CHECK_SUCCESS_FCT(status, phpalI14443p4_Sw_ResetProtocol(&s_lb_pal));
+    return phpalI14443p4_Sw_SetProtocol(&s_lb_pal, PH_OFF, 0, PH_OFF, 0, BENCH_LB_FWI, BENCH_LB_FSDI, BENCH_LB_FSDI);
+}
+
+static void Bench_LbReset(const Bench_LbProfile_t *profile)
+{
+    s_lb_prof = profile;
+    memset(s_lb_script, 0, sizeof(s_lb_script));
+    s_lb_rng = 1U;
+    s_lb_us = 0.0;
+    s_lb_card_ns = 0;
+    s_lb_frames = 0;
+    s_lb_frame_len = 0;
+    memset(&s_lb_sent, 0, sizeof(s_lb_sent));
+    memset(&s_lb_run, 0, sizeof(s_lb_run));
+    (void)phpalI14443p4_Sw_Init(&s_lb_pal, sizeof(s_lb_pal), &s_lb_hal);
+    (void)phpalI14443p4_Sw_SetConfig(&s_lb_pal, PHPAL_I14443P4_CONFIG_OPE_MODE, RD_LIB_MODE_EMVCO);
+    EmvcoAnalyzer_Init(&s_lb_pal);
+}
+
+/* EmvcoDataExchange of the demo in analyzer mode */
+static phStatus_t Bench_LbExchange(uint8_t *cmd, uint16_t cmd_len, uint8_t **resp, uint16_t *resp_len)
+{
+    uint64_t t0, t1, t2, card_ns = s_lb_card_ns;
+    double start_us = s_lb_us;
+    phStatus_t status;
+
+    t0 = Bench_NowNs();
+    EmvcoAnalyzer_Begin();
+    t1 = Bench_NowNs();
+    status = phpalI14443p4_Exchange(&s_lb_pal, PH_EXCHANGE_DEFAULT, cmd, cmd_len, resp, resp_len);
+    t2 = Bench_NowNs();
+    if (status != PH_ERR_SUCCESS) {
+        *resp_len = 0;
+    }
+    EmvcoAnalyzer_End(status, cmd_len, *resp_len);
+
+    s_lb_run.analyzer_ns += (t1 - t0) + (Bench_NowNs() - t2);
+    s_lb_run.pal_ns += (t2 - t1) - (s_lb_card_ns - card_ns);
+    s_lb_run.exchanges++;
+    s_lb_run.errors += (status != PH_ERR_SUCCESS) ? 1U : 0U;
+    s_lb_run.bytes += (uint64_t)cmd_len + *resp_len;
+    s_lb_run.loop_us += s_lb_us - start_us;
+    if (s_lb_run.rtt_n < BENCH_LB_RTT_MAX) {
+        s_lb_run.rtt_us[s_lb_run.rtt_n++] = s_lb_us - start_us;
+    }
+    return status;
+}
+
+/* EmvcoProfileProcess for one activation: EmvcoDataLoopBack, then EmvcoRfReset */
+static uint8_t Bench_LbSession(void)
+{
+    static uint8_t ppse[] = {
+        0x00, 0xA4, 0x04, 0x00, 0x0E, 0x32, 0x50, 0x41, 0x59, 0x2E, 0x53, 0x59, 0x53, 0x2E, 0x44, 0x44, 0x46, 0x30,
+        0x31, 0x00
+    };
+    static uint8_t cmd[256];
+    uint8_t *resp = NULL;
+    uint16_t resp_len = 0, cmd_len = (uint16_t)sizeof(ppse);
+    uint8_t eot = 0;
+
+    EmvcoAnalyzer_Poll();
+    s_lb_run.sessions++;
+    if (Bench_LbActivate() != PH_ERR_SUCCESS) {
+        return 0;
+    }
+    EmvcoAnalyzer_Loopback();
+    (void)Bench_LbExchange(ppse, cmd_len, &resp, &resp_len);
+    while (resp_len > 0U) {
+        if (resp_len >= 6U && resp[1] == 0x70) {
+            eot = 1;
+            break;
+        }
+        if (resp_len >= 6U && resp[resp_len - 2U] == 0x90) {
+            cmd_len = (uint16_t)(resp_len - 2U);
+            memcpy(cmd, resp, cmd_len);
+            (void)Bench_LbExchange(cmd, cmd_len, &resp, &resp_len);
+        } else if (resp_len < 6U) {
+            (void)Bench_LbExchange(ppse, (uint16_t)sizeof(ppse), &resp, &resp_len);
+        } else {
+            break;
+        }
+    }
+    s_lb_run.completed += eot;
+
+    s_lb_us += BENCH_LB_RF_RESET_US;
+    EmvcoAnalyzer_RfReset();
+    return eot;
+}
+
+/* ================== EMV scheduler simulator ================== */
+
+/* Record data lengths of the card, a 70 template each */
+static const uint8_t s_ov_rec_len[BENCH_OV_RECORDS] = { 180U, 220U, 96U, 140U, 200U, 64U, 230U, 120U };
+
+static phhalHw_Pn5180_DataParams_t s_ov_hal;
+static phpalI14443p4_Sw_DataParams_t s_ov_pal;
+static double s_ov_us;                          /* Simulated time */
+static double s_ov_done_us;                     /* Card answer to the frame in flight received */
+static double s_ov_uart_free_us;                /* Shift register empty */
+static double s_ov_card_us;                     /* Sum of submit to answer */
+static uint8_t s_ov_pending;
+static uint8_t s_ov_blk;
+static uint8_t s_ov_tx[300];
+static uint16_t s_ov_tx_len;
+static uint8_t s_ov_rx[300];
+static uint16_t s_ov_rx_len;
+static uint8_t s_ov_host[BENCH_OV_HOST_MAX];    /* Bytes on the host side of USART1 */
+static uint32_t s_ov_host_len;
+
+typedef struct {
+    double total_us;                            /* First submit to the last stop bit */
+    double serial_us;                           /* Same exchanges, each record sent blocking after its read */
+    uint32_t frames;                            /* Record frames queued */
+    uint32_t dropped;
+    uint32_t errors;
+} Bench_OvTap_t;
+
+int EMV_Uplink_HostTxEmpty(void)
+{
+    if (s_ov_us + BENCH_OV_UART_BYTE_US >= s_ov_uart_free_us) {
+        return 1;
+    }
+    s_ov_us += BENCH_OV_FLAG_US;
+    return 0;
+}
+
+void EMV_Uplink_HostTxByte(uint8_t b)
+{
+    double start = (s_ov_us > s_ov_uart_free_us) ? s_ov_us : s_ov_uart_free_us;
+
+    s_ov_uart_free_us = start + BENCH_OV_UART_BYTE_US;
+    if (s_ov_host_len < BENCH_OV_HOST_MAX) {
+        s_ov_host[s_ov_host_len++] = b;
+    }
+}
+
+int EMV_Uplink_HostTxDone(void)
+{
+    if (s_ov_us >= s_ov_uart_free_us) {
+        return 1;
+    }
+    s_ov_us += BENCH_OV_FLAG_US;
+    return 0;
+}
+
+/* READ RECORD card, answers I-Blocks only, the answer is due after air time and processing */
+static void Bench_OvCard(void)
+{
+    const uint8_t *apdu = &s_ov_tx[1];
+    uint8_t rec = apdu[2];
+    uint8_t len;
+
+    s_ov_blk = s_ov_tx[0] & 0x01U;
+    s_ov_rx[0] = (uint8_t)(0x02U | s_ov_blk);
+    if (s_ov_tx_len < 5U || apdu[1] != 0xB2 || rec == 0U || rec > BENCH_OV_RECORDS) {
+        s_ov_rx[1] = 0x6A;
+        s_ov_rx[2] = 0x83;
+        s_ov_rx_len = 3;
+    } else {
+        len = s_ov_rec_len[rec - 1U];
+        s_ov_rx[1] = 0x70;
+        s_ov_rx[2] = (uint8_t)(len - 2U);
+        for (uint8_t i = 2; i < len; i++) {
+            s_ov_rx[1U + i] = (uint8_t)(rec * 31U + i);
+        }
+        s_ov_rx[1U + len] = 0x90;
+        s_ov_rx[2U + len] = 0x00;
+        s_ov_rx_len = (uint16_t)(len + 3U);
+    }
+    s_ov_done_us = s_ov_us + BENCH_UL_HOST_US + Bench_TypeAAirUs((uint16_t)(s_ov_tx_len + 2U)) + BENCH_UL_FDT_US +
+                   BENCH_OV_CARD_US + Bench_TypeAAirUs((uint16_t)(s_ov_rx_len + 2U));
+    s_ov_card_us += s_ov_done_us - s_ov_us;
+}
+
+static phStatus_t Bench_OvActivate(void)
+{
+    phStatus_t status;
+
+    s_ov_us = 0.0;
+    s_ov_uart_free_us = 0.0;
+    s_ov_card_us = 0.0;
+    s_ov_pending = 0;
+    s_ov_host_len = 0;
+    PH_CHECK_SUCCESS_FCT(status, phpalI14443p4_Sw_ResetProtocol(&s_ov_pal));
+    return phpalI14443p4_Sw_SetProtocol(&s_ov_pal, PH_OFF, 0, PH_OFF, 0, BENCH_LB_FWI, BENCH_LB_FSDI, BENCH_LB_FSDI);
+}
+
+/* Record frame as EMV_QueueRecordToLinux builds it */
+static uint16_t Bench_OvFrame(uint8_t sfi, uint8_t rec, const uint8_t *data, uint16_t len, uint8_t *frame)
+{
+    frame[0] = 0xAA;
+    frame[1] = 0x55;
+    frame[2] = 0x17;
+    frame[3] = (uint8_t)((len + 2U) >> 8);
+    frame[4] = (uint8_t)(len + 2U);
+    frame[5] = sfi;
+    frame[6] = rec;
+    memcpy(&frame[7], data, len);
+    frame[7U + len] = 0x0D;
+    frame[8U + len] = 0x0A;
+    return (uint16_t)(len + 9U);
+}
+
+/* Record frames found in the host stream, in order and intact, text between frames skipped */
+static uint32_t Bench_OvHostFrames(void)
+{
+    uint32_t pos = 0, frames = 0;
+
+    while (pos + 9U <= s_ov_host_len) {
+        uint16_t len, rec_len;
+        uint8_t rec;
+
+        if (s_ov_host[pos] != 0xAA || s_ov_host[pos + 1U] != 0x55) {
+            pos++;
+            continue;
+        }
+        len = (uint16_t)((s_ov_host[pos + 3U] << 8) | s_ov_host[pos + 4U]);
+        rec = s_ov_host[pos + 6U];
+        if (s_ov_host[pos + 2U] != 0x17 || rec != frames + 1U || pos + 7U + len > s_ov_host_len) {
+            return frames;
+        }
+        rec_len = s_ov_rec_len[rec - 1U];
+        if (len != rec_len + 4U || s_ov_host[pos + 7U] != 0x70 || s_ov_host[pos + 7U + rec_len] != 0x90 ||
+            s_ov_host[pos + 5U + len] != 0x0D || s_ov_host[pos + 6U + len] != 0x0A) {
+            return frames;
+        }
+        for (uint8_t i = 2; i < rec_len; i++) {
+            if (s_ov_host[pos + 7U + i] != (uint8_t)(rec * 31U + i)) {
+                return frames;
+            }
+        }
+        frames++;
+        pos += 7U + len;
+    }
+    return frames;
+}
+
+/* One tap: every record read through the scheduler, queued for the host, optionally with debug text after it */
+static void Bench_OvTap(uint8_t text, Bench_OvTap_t *tap)
+{
+    static uint8_t frame[300];
+    uint32_t dropped = EMV_Uplink_Dropped();
+    uint32_t up_bytes = 0;
+    uint8_t *rx;
+    uint16_t rx_len;
+
+    memset(tap, 0, sizeof(*tap));
+    if (Bench_OvActivate() != PH_ERR_SUCCESS) {
+        tap->errors++;
+        return;
+    }
+    EMV_Uplink_Start();
+    for (uint8_t rec = 1; rec <= BENCH_OV_RECORDS; rec++) {
+        uint8_t apdu[5] = { 0x00, 0xB2, rec, 0x0C, 0x00 };
+        uint16_t frame_len;
+
+        if (EMV_Sched_ExchangeApdu(apdu, sizeof(apdu), &rx, &rx_len) != PH_ERR_SUCCESS || rx_len < 2U) {
+            tap->errors++;
+            continue;
+        }
+        frame_len = Bench_OvFrame(1U, rec, rx, rx_len, frame);
+        up_bytes += frame_len;
+        tap->frames += (EMV_Uplink_Queue(frame, frame_len) != 0U) ? 1U : 0U;
+        if (text) {
+            char line[40];
+            int n = snprintf(line, sizeof(line), "SFI 1 Record %u: %u bytes\r\n", rec, (unsigned)(rx_len - 2U));
+
+            for (int i = 0; i < n; i++) {
+                (void)EMV_Uplink_PutChar((uint8_t)line[i]);
+            }
+            up_bytes += (uint32_t)n;
+        }
+    }
+    EMV_Uplink_Flush();
+    tap->total_us = s_ov_us;
+    tap->serial_us = s_ov_card_us + up_bytes * BENCH_OV_UART_BYTE_US;
+    tap->dropped = EMV_Uplink_Dropped() - dropped;
+}
+
+/* ================== Multi-reader simulator ================== */
+
+static phhalHw_Pn5180_DataParams_t s_mr_hal[PHDRIVER_READER_COUNT];
+static phacDiscLoop_Sw_DataParams_t s_mr_disc[PHDRIVER_READER_COUNT];
+static uint8_t s_mr_sel;
+static double s_mr_us;                                  /* Simulated time */
+static uint8_t s_mr_card[PHDRIVER_READER_COUNT];        /* Card in front of the antenna */
+static uint8_t s_mr_field[PHDRIVER_READER_COUNT];
+static double s_mr_on_us[PHDRIVER_READER_COUNT];
+static double s_mr_off_us[PHDRIVER_READER_COUNT];
+static uint8_t s_mr_pending[PHDRIVER_READER_COUNT];     /* WUPA in flight */
+static double s_mr_done_us[PHDRIVER_READER_COUNT];      /* Its ATQA or timeout */
+static uint32_t s_mr_cb_mask;                           /* Readers reported to the card callback */
+
+typedef struct {
+    uint32_t field_ons;
+    uint32_t wupas;
+    uint32_t polls;                                     /* IRQ_STATUS reads over SPI */
+    uint32_t runs;                                      /* Discovery loop runs */
+    uint32_t detections;
+    uint32_t violations;                                /* Field reset or GTA shorter than 5.1ms */
+} Bench_MrStats_t;
+
+static Bench_MrStats_t s_mr;
+
+/* Demo globals the reader switch updates */
+phhalHw_Pn5180_DataParams_t *pHal;
+phacDiscLoop_Sw_DataParams_t *pDiscLoop;
+
+void *phNfcLib_GetDataParams(uint16_t wComponent)
+{
+    switch (wComponent) {
+    case PH_COMP_PAL_ISO14443P4:
+        return &s_ov_pal;
+    case PH_COMP_HAL:
+        return &s_mr_hal[s_mr_sel];
+    case PH_COMP_AC_DISCLOOP:
+        return &s_mr_disc[s_mr_sel];
+    case PH_COMP_CRYPTORNG:
+        return &s_rng;
+    default:
+        return NULL;
+    }
+}
+
+phNfcLib_Status_t phNfcLib_SelectReader(uint8_t bReader)
+{
+    if (bReader >= PHDRIVER_READER_COUNT) {
+        return PH_NFCLIB_STATUS_INVALID_PARAMETER;
+    }
+    s_mr_sel = bReader;
+    return PH_NFCLIB_STATUS_SUCCESS;
+}
+
+phNfcLib_Status_t phNfcLib_SetContext(phNfcLib_AppContext_t *pAppContext)
+{
+    (void)pAppContext;
+    return PH_NFCLIB_STATUS_SUCCESS;
+}
+
+phNfcLib_Status_t phNfcLib_Init(void)
+{
+    return PH_NFCLIB_STATUS_SUCCESS;
+}
+
+phStatus_t phbalReg_Init(void *pDataParams, uint16_t wSizeOfDataParams)
+{
+    (void)pDataParams; (void)wSizeOfDataParams;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phbalReg_SetConfig(void *pDataParams, uint16_t wConfig, uint32_t dwValue)
+{
+    (void)pDataParams; (void)wConfig; (void)dwValue;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phApp_Comp_Init(void *pDiscLoopParams)
+{
+    (void)pDiscLoopParams;
+    return PH_ERR_SUCCESS;
+}
+
+uint32_t MultiReader_HostTick(void)
+{
+    s_mr_us += BENCH_MR_LOOP_US;
+    return (uint32_t)(s_mr_us / 1000.0);
+}
+
+/* The PN5180 raises IRQ once the ATQA is in or its timer ran out */
+uint8_t phDriver_ReaderIrqPending(uint8_t bReader)
+{
+    return (bReader < PHDRIVER_READER_COUNT && s_mr_pending[bReader] && s_mr_us >= s_mr_done_us[bReader]) ? 1U : 0U;
+}
+
+/* Present card is activated, an empty field is searched for every technology */
+phStatus_t phacDiscLoop_Sw_Run(phacDiscLoop_Sw_DataParams_t *pDataParams, uint8_t bEntryPoint)
+{
+    const uint8_t r = (uint8_t)(pDataParams - s_mr_disc);
+
+    (void)bEntryPoint;
+    s_mr.runs++;
+    if (s_mr_card[r]) {
+        s_mr_us += BENCH_MR_ACTIVATE_US;
+        s_mr.detections++;
+        return PH_ADD_COMPCODE_FIXED(PHAC_DISCLOOP_DEVICE_ACTIVATED, PH_COMP_AC_DISCLOOP);
+    }
+    s_mr_us += BENCH_MR_FULL_POLL_US;
+    return PH_ADD_COMPCODE_FIXED(PHAC_DISCLOOP_NO_TECH_DETECTED, PH_COMP_AC_DISCLOOP);
+}
+
+phStatus_t phacDiscLoop_Sw_SetConfig(phacDiscLoop_Sw_DataParams_t *pDataParams, uint16_t wConfig, uint16_t wValue)
+{
+    (void)pDataParams; (void)wConfig; (void)wValue;
+    return PH_ERR_SUCCESS;
+}
+
+static int Bench_MrIndex(const phhalHw_Pn5180_DataParams_t *pDataParams)
+{
+    for (int i = 0; i < (int)PHDRIVER_READER_COUNT; i++) {
+        if (pDataParams == &s_mr_hal[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void Bench_MrCard(uint8_t reader, void *disc, phStatus_t status)
+{
+    if (disc == &s_mr_disc[reader] && (status & PH_ERR_MASK) == PHAC_DISCLOOP_DEVICE_ACTIVATED) {
+        s_mr_cb_mask |= 1U << reader;
+    }
+}
+
+/* Fresh readers, cards as in the mask, every field off long ago */
+static phStatus_t Bench_MrSetup(uint32_t cards)
+{
+    memset(&s_mr, 0, sizeof(s_mr));
+    s_mr_us = 0.0;
+    s_mr_cb_mask = 0;
+    for (uint32_t i = 0; i < PHDRIVER_READER_COUNT; i++) {
+        s_mr_card[i] = (uint8_t)((cards >> i) & 1U);
+        s_mr_field[i] = 0;
+        s_mr_pending[i] = 0;
+        s_mr_off_us[i] = -1.0e9;
+        s_mr_on_us[i] = -1.0e9;
+    }
+    return MultiReader_Init();
+}
+
+/* MultiReader_PollRound back to back for the given simulated time, returns the detections */
+static uint32_t Bench_MrRun(uint32_t ms)
+{
+    uint32_t found = 0;
+    uint32_t mask;
+
+    while (s_mr_us < ms * 1000.0) {
+        mask = MultiReader_PollRound(Bench_MrCard);
+        for (; mask != 0U; mask &= mask - 1U) {
+            found++;
+        }
+    }
+    return found;
+}
+
+/* Same probe and the same full rounds, each reader waited for in turn as before */
+static uint32_t Bench_MrSerialRun(uint32_t ms)
+{
+    uint8_t cmd = 0x52U;
+    uint8_t *rx;
+    uint16_t rx_len;
+    uint32_t round = 0;
+    uint32_t found = 0;
+    phhalHw_Pn5180_DataParams_t *hal;
+
+    while (s_mr_us < ms * 1000.0) {
+        round++;
+        for (uint32_t i = 0; i < PHDRIVER_READER_COUNT; i++) {
+            hal = &s_mr_hal[i];
+            s_mr_us = fmax(s_mr_us, s_mr_off_us[i] + MULTI_READER_FIELD_OFF_MS * 1000.0);
+            if ((round % MULTI_READER_FULL_POLL_ROUNDS) != 0U) {
+                (void)phhalHw_Pn5180_ApplyProtocolSettings(hal, PHHAL_HW_CARDTYPE_ISO14443A);
+                (void)phhalHw_Pn5180_FieldOn(hal);
+                s_mr_us = fmax(s_mr_us, s_mr_on_us[i] + MULTI_READER_GUARD_MS * 1000.0);
+                for (uint32_t k = 0; k < 4U; k++) {
+                    (void)phhalHw_Pn5180_SetConfig(hal, PHHAL_HW_CONFIG_TXLASTBITS, 7U);
+                }
+                (void)phhalHw_Pn5180_ExchangeSubmit(hal, PH_EXCHANGE_DEFAULT, &cmd, 1U);
+                s_mr_us = fmax(s_mr_us, s_mr_done_us[i]);
+                if (phhalHw_Pn5180_ExchangePoll(hal, &rx, &rx_len) != PH_ERR_SUCCESS) {
+                    (void)phhalHw_Pn5180_FieldOff(hal);
+                    continue;
+                }
+            }
+            if ((phacDiscLoop_Sw_Run(&s_mr_disc[i], PHAC_DISCLOOP_ENTRY_POINT_POLL) & PH_ERR_MASK) ==
+                PHAC_DISCLOOP_DEVICE_ACTIVATED) {
+                found++;
+            }
+            (void)phhalHw_Pn5180_FieldOff(hal);
+        }
+    }
+    return found;
+}
+
+/* ================== LPCD simulator ================== */
+
+typedef struct {
+    const char *name;
+    double drift_per_min;           /* Background AGC drift, counts per minute */
+    double step;                    /* Background step at half time, e.g. metal placed next to the antenna */
+    uint16_t noise;                 /* Uniform noise, +- counts */
+    double card_drop;               /* AGC drop with a card on the antenna */
+    uint32_t tap_every_ms;          /* 0 for no card */
+    uint32_t tap_ms;                /* Card presence per tap */
+} Bench_LpScenario_t;
+
+typedef struct {
+    uint32_t wakes;
+    uint32_t false_wakes;
+    uint32_t late_false_wakes;      /* In the last quarter of the run */
+    uint32_t taps;
+    uint32_t missed;                /* Taps without a wake-up while the card was there */
+    uint32_t threshold_changes;
+    uint32_t hyst_violations;       /* E2PROM threshold off the adapted one by the hysteresis after Arm */
+} Bench_LpRun_t;
+
+static const Bench_LpScenario_t s_lp_scenarios[] = {
+    { "quiet_taps", 0.0, 0.0, 2U, 60.0, 20000U, 2000U },
+    { "slow_drift", 0.5, 0.0, 2U, 60.0, 30000U, 2000U },
+    { "metal_step", 0.0, 40.0, 2U, 60.0, 30000U, 2000U },
+    { "noisy", 0.0, 0.0, 24U, 120.0, 30000U, 2000U },
+};
+
+static phhalHw_Pn5180_DataParams_t s_lp_hal;
+static const Bench_LpScenario_t *s_lp_sc;
+static uint32_t s_lp_ms;
+static uint32_t s_lp_rand;
+static uint16_t s_lp_gear;
+static uint8_t s_lp_card;
+static uint8_t s_lp_field;
+static uint8_t s_lp_e2prom[2];          /* Threshold, REFVAL_CONTROL */
+static uint32_t s_lp_e2prom_writes;
+static uint16_t s_lp_ref_reg;
+
+uint32_t LpcdMgr_HostTick(void)
+{
+    return s_lp_ms;
+}
+
+static double Bench_LpBackground(void)
+{
+    double agc = BENCH_LP_AGC + s_lp_sc->drift_per_min * (s_lp_ms / 60000.0);
+
+    return (s_lp_ms >= BENCH_LP_SIM_MS / 2U) ? agc + s_lp_sc->step : agc;
+}
+
+/* One AGC reading: gear and value as in AGC_REF_CONFIG */
+static uint16_t Bench_LpAgc(void)
+{
+    double agc = Bench_LpBackground() - (s_lp_card ? s_lp_sc->card_drop : 0.0);
+    int32_t noise;
+
+    s_lp_rand = s_lp_rand * 1103515245U + 12345U;
+    noise = (int32_t)((s_lp_rand >> 16) % (2U * s_lp_sc->noise + 1U)) - (int32_t)s_lp_sc->noise;
+    agc += noise;
+    if (agc < 0.0) {
+        agc = 0.0;
+    }
+    if (agc > AGC_REF_CONFIG_AGC_VALUE_MASK) {
+        agc = AGC_REF_CONFIG_AGC_VALUE_MASK;
+    }
+    return (uint16_t)(s_lp_gear | (uint16_t)(agc + 0.5));
+}
+
+static phStatus_t Bench_LpSource(void *ctx, uint16_t *pAgc)
+{
+    (void)ctx;
+    *pAgc = Bench_LpAgc();
+    return PH_ERR_SUCCESS;
+}
+
+/* The PN5180 wakes when the AGC leaves reference +- threshold, or on another gear */
+static uint8_t Bench_LpWakes(uint16_t reference, uint8_t threshold)
+{
+    uint16_t agc = Bench_LpAgc();
+    int32_t diff = (int32_t)(agc & AGC_REF_CONFIG_AGC_VALUE_MASK) - (int32_t)(reference & AGC_REF_CONFIG_AGC_VALUE_MASK);
+
+    if ((agc & AGC_REF_CONFIG_AGC_GEAR_MASK) != (reference & AGC_REF_CONFIG_AGC_GEAR_MASK)) {
+        return 1;
+    }
+    return (diff > threshold || -diff > threshold) ? 1U : 0U;
+}
+
+phStatus_t phhalHw_Pn5180_Int_LPCD_SetConfig(phhalHw_Pn5180_DataParams_t *pDataParams, uint16_t wConfig,
+                                             uint16_t wValue)
+{
+    if (pDataParams != &s_lp_hal) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+    }
+    if (wConfig == PHHAL_HW_CONFIG_LPCD_REF) {
+        s_lp_ref_reg = wValue;
+    }
+    return PH_ERR_SUCCESS;
+}
+
+static uint8_t *Bench_LpE2Prom(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t bAddress, uint8_t bLength)
+{
+    if (pDataParams != &s_lp_hal || bLength != 1U || bAddress < BENCH_LP_E2PROM_THRESHOLD ||
+        bAddress > BENCH_LP_E2PROM_REFVAL_CONTROL) {
+        return NULL;
+    }
+    return &s_lp_e2prom[bAddress - BENCH_LP_E2PROM_THRESHOLD];
+}
+
+phStatus_t phhalHw_Pn5180_Instr_ReadE2Prom(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t bE2PromAddress,
+                                           uint8_t *pReadData, uint8_t bDataLength)
+{
+    const uint8_t *cell = Bench_LpE2Prom(pDataParams, bE2PromAddress, bDataLength);
+
+    if (cell == NULL) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_HAL);
+    }
+    *pReadData = *cell;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_Instr_WriteE2Prom(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t bE2PromAddress,
+                                            uint8_t *pDataToWrite, uint8_t bDataLength)
+{
+    uint8_t *cell = Bench_LpE2Prom(pDataParams, bE2PromAddress, bDataLength);
+
+    if (cell == NULL) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_HAL);
+    }
+    *cell = *pDataToWrite;
+    s_lp_e2prom_writes++;
+    return PH_ERR_SUCCESS;
+}
+
+/* AGC_REF_CONFIG reads the AGC while the field is on */
+phStatus_t phhalHw_Pn5180_Instr_ReadRegister(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t bRegister,
+                                             uint32_t *pValue)
+{
+    if (pDataParams != &s_lp_hal || bRegister != AGC_REF_CONFIG || !s_lp_field) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+    }
+    *pValue = Bench_LpAgc();
+    return PH_ERR_SUCCESS;
+}
+
+/* Runs are stepped by Bench_LpRun, power-down LPCD itself is not entered */
+phStatus_t phhalHw_Pn5180_Lpcd(phhalHw_Pn5180_DataParams_t *pDataParams)
+{
+    (void)pDataParams;
+    return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+}
+
+/* Fresh antenna and E2PROM, the PN5180 defaults: threshold 0x10, reference from the E2PROM */
+static void Bench_LpReset(const Bench_LpScenario_t *sc)
+{
+    s_lp_sc = sc;
+    s_lp_ms = 0;
+    s_lp_rand = 0x1F123BB5U;
+    s_lp_gear = BENCH_LP_GEAR;
+    s_lp_card = 0;
+    s_lp_field = 0;
+    s_lp_e2prom[0] = 0x10;
+    s_lp_e2prom[1] = 0x00;
+    s_lp_e2prom_writes = 0;
+    s_lp_ref_reg = 0;
+}
+
+/*
+ * One LPCD check per period for duration_ms, card taps as in the scenario.
+ * mgr NULL runs the baseline: reference measured once, threshold_init, fixed period.
+ */
+static void Bench_LpRun(LpcdMgr_t *mgr, uint32_t duration_ms, Bench_LpRun_t *run)
+{
+    const LpcdMgr_Stats_t *st = (mgr != NULL) ? LpcdMgr_GetStats(mgr) : NULL;
+    uint16_t fixed_ref = Bench_LpAgc();
+    uint32_t end = s_lp_ms + duration_ms;
+    uint32_t tap = UINT32_MAX;
+    uint8_t tap_seen = 1;
+    uint8_t last_th = (st != NULL) ? st->threshold : 0U;
+
+    memset(run, 0, sizeof(*run));
+    while (s_lp_ms < end) {
+        uint8_t threshold = 0x10;
+        uint16_t reference = fixed_ref;
+        uint32_t period = BENCH_LP_FIXED_PERIOD_MS;
+
+        if (mgr != NULL) {
+            (void)LpcdMgr_Arm(mgr);
+            threshold = (mgr->pHal != NULL) ? s_lp_e2prom[0] : st->threshold;
+            reference = (mgr->pHal != NULL) ? s_lp_ref_reg : st->reference;
+            period = st->period_ms;
+            if (mgr->pHal != NULL && (uint8_t)abs((int)st->threshold - (int)s_lp_e2prom[0]) >= mgr->cfg.e2prom_hyst) {
+                run->hyst_violations++;
+            }
+            if (st->threshold != last_th) {
+                run->threshold_changes++;
+                last_th = st->threshold;
+            }
+        }
+
+        s_lp_ms += period;
+        s_lp_card = (s_lp_sc->tap_every_ms != 0U && (s_lp_ms % s_lp_sc->tap_every_ms) < s_lp_sc->tap_ms) ? 1U : 0U;
+        if (s_lp_card && s_lp_ms / s_lp_sc->tap_every_ms != tap) {
+            /* A new tap, the previous one had its chance */
+            run->missed += tap_seen ? 0U : 1U;
+            tap = s_lp_ms / s_lp_sc->tap_every_ms;
+            tap_seen = 0;
+            run->taps++;
+        }
+
+        if (!Bench_LpWakes(reference, threshold)) {
+            continue;
+        }
+        run->wakes++;
+        if (s_lp_card) {
+            tap_seen = 1;
+        } else {
+            run->false_wakes++;
+            run->late_false_wakes += (s_lp_ms >= end - duration_ms / 4U) ? 1U : 0U;
+        }
+        if (mgr != NULL) {
+            LpcdMgr_OnWake(mgr);
+            s_lp_ms += BENCH_LP_DISCOVERY_MS;
+            LpcdMgr_OnDiscovery(mgr, s_lp_card);
+        } else {
+            s_lp_ms += BENCH_LP_DISCOVERY_MS;
+        }
+    }
+    run->missed += tap_seen ? 0U : 1U;
+}
+
+/* Manager on the injected AGC source, or on the HAL stubs reading AGC_REF_CONFIG */
+static phStatus_t Bench_LpStart(LpcdMgr_t *mgr, const Bench_LpScenario_t *sc, uint8_t with_hal)
+{
+    phStatus_t status;
+
+    Bench_LpReset(sc);
+    if (with_hal) {
+        return LpcdMgr_Init(mgr, &s_lp_hal, NULL);
+    }
+    PH_CHECK_SUCCESS_FCT(status, LpcdMgr_Init(mgr, NULL, NULL));
+    LpcdMgr_SetAgcSource(mgr, Bench_LpSource, NULL);
+    return LpcdMgr_Calibrate(mgr);
+}
+
+/* ================== EMV offline data authentication vectors ================== */
+
+/*
+ * Test card of a made-up scheme: CA key 1024 bit (index 92), issuer key 768 bit,
+ * ICC key 512 bit, all with exponent 3. Issuer and ICC modulus do not fit the
+ * certificates, so the remainders 92 and 9F48 are exercised. Record 1 is the
+ * one signed for ODA (AFL 08 01 04 01) and 9F4A adds the AIP: 4000 for the SSAD,
+ * 2000 in the ICC certificate. The DDA and fDDA signatures are over the
+ * unpredictable number 11223344, fDDA also over amount 12.34 and currency 0156.
+ */
+static const uint8_t s_oda_ca_mod[128] = {
+    0xC3, 0xBA, 0x21, 0x0D, 0x45, 0x47, 0x4E, 0x77, 0x71, 0xC0, 0xE7, 0xB7, 0xF5, 0x3C, 0xF0, 0x6B,
+    0x5B, 0x91, 0x80, 0x9C, 0x50, 0x35, 0xF5, 0x68, 0xFB, 0xC1, 0xC9, 0x8A, 0x2E, 0xFF, 0x28, 0x16,
+    0xC1, 0x52, 0x07, 0x41, 0x74, 0x5B, 0xCF, 0xCC, 0xA1, 0x3F, 0x36, 0x6C, 0xB3, 0xC8, 0x07, 0xC5,
+    0xEB, 0xB7, 0xE3, 0xDF, 0x70, 0x35, 0xC8, 0x6D, 0x21, 0xDA, 0x6A, 0x28, 0x42, 0x4C, 0x2C, 0x03,
+    0xD6, 0x1B, 0x1B, 0x5C, 0xFB, 0xA4, 0xD5, 0x4A, 0x7E, 0xC6, 0xF9, 0x69, 0x07, 0xCE, 0x0B, 0x6A,
+    0xA8, 0x81, 0xAE, 0xDA, 0xE3, 0xDD, 0xC8, 0x24, 0x8E, 0x65, 0x0F, 0x93, 0x84, 0x01, 0xBB, 0x7A,
+    0x02, 0xAF, 0x91, 0x3A, 0xDA, 0x0B, 0x9B, 0x07, 0x46, 0x73, 0x46, 0x49, 0x7A, 0x80, 0x88, 0x66,
+    0xCB, 0x0E, 0x69, 0xB7, 0x49, 0xCC, 0x78, 0x30, 0x32, 0x31, 0xE3, 0xC7, 0x6F, 0x22, 0x69, 0x43,
+};
+
+static const uint8_t s_oda_rec1[28] = {
+    0x70, 0x1A, 0x5A, 0x08, 0x47, 0x61, 0x73, 0x90, 0x01, 0x01, 0x00, 0x10, 0x5F, 0x24, 0x03, 0x29,
+    0x12, 0x31, 0x9F, 0x4A, 0x01, 0x82, 0x5F, 0x25, 0x03, 0x24, 0x01, 0x01,
+};
+
+static const uint8_t s_oda_rec2[147] = {
+    0x70, 0x81, 0x90, 0x8F, 0x01, 0x92, 0x90, 0x81, 0x80, 0xA1, 0xE3, 0x7A, 0x17, 0xA6, 0xBA, 0xA9,
+    0x3B, 0x97, 0x2A, 0xBF, 0x6A, 0x12, 0x62, 0x6D, 0x60, 0x7C, 0x4C, 0x8D, 0xD4, 0x31, 0x9F, 0x3F,
+    0xFD, 0x5A, 0x88, 0xFD, 0xB0, 0x64, 0x6E, 0x40, 0xB2, 0x4F, 0x73, 0x9A, 0x62, 0x9D, 0x68, 0xA7,
+    0x63, 0xB3, 0x18, 0xBD, 0xBC, 0x48, 0xAE, 0x9E, 0x26, 0xF7, 0x60, 0xDB, 0xC3, 0xD0, 0x24, 0x07,
+    0x8C, 0x1D, 0x3B, 0x0C, 0x29, 0x3C, 0x8F, 0x82, 0xB1, 0xDB, 0x27, 0x6F, 0x5B, 0x1F, 0x09, 0x41,
+    0xD7, 0x0A, 0xDB, 0x0B, 0xEA, 0x85, 0xD9, 0xBD, 0x20, 0x32, 0x53, 0xE1, 0xFF, 0xB3, 0xBE, 0x65,
+    0x1A, 0x0A, 0xAB, 0x73, 0x44, 0xCD, 0x30, 0xAE, 0xEC, 0xE4, 0x87, 0x1C, 0xE9, 0x66, 0x97, 0x8A,
+    0x60, 0x19, 0x3D, 0x8B, 0xAF, 0x87, 0xE7, 0x96, 0x8E, 0xAD, 0xEE, 0xA8, 0xD8, 0x0C, 0xDF, 0xBA,
+    0x28, 0x09, 0x87, 0xE8, 0x12, 0x81, 0x74, 0x33, 0x4B, 0x92, 0x04, 0xC0, 0xBF, 0xD9, 0x5F, 0x9F,
+    0x32, 0x01, 0x03,
+};
+
+static const uint8_t s_oda_rec3[124] = {
+    0x70, 0x7A, 0x9F, 0x46, 0x60, 0xBC, 0xF2, 0xFC, 0x10, 0xB6, 0x53, 0x95, 0x82, 0x87, 0x31, 0x71,
+    0xBF, 0x44, 0xBC, 0x8A, 0xFC, 0xA9, 0x6E, 0x7B, 0x16, 0x0C, 0x47, 0x03, 0x3D, 0xB6, 0x51, 0xC4,
+    0x38, 0x2B, 0x59, 0xCC, 0x23, 0x75, 0x55, 0xBB, 0xB0, 0xCC, 0xC4, 0x4D, 0x96, 0xD9, 0xB3, 0x48,
+    0x81, 0x93, 0x9A, 0x34, 0x0F, 0xCB, 0x72, 0xED, 0xD3, 0xBF, 0x15, 0x1E, 0xB8, 0x4C, 0xB6, 0xDC,
+    0xEF, 0xC9, 0xE9, 0xFA, 0xB9, 0x7F, 0x8F, 0xD2, 0x92, 0x12, 0xFD, 0x22, 0x08, 0xCE, 0x10, 0x86,
+    0x19, 0x4A, 0xDD, 0x27, 0x90, 0x0E, 0x4D, 0xD1, 0x52, 0x9F, 0x83, 0xCC, 0x2D, 0x10, 0x34, 0xF3,
+    0xE0, 0x34, 0x58, 0x31, 0xCC, 0x9F, 0x47, 0x01, 0x03, 0x9F, 0x48, 0x0A, 0x1A, 0x19, 0x1D, 0xA1,
+    0x62, 0x13, 0xFE, 0x41, 0x9D, 0xC5, 0x9F, 0x49, 0x03, 0x9F, 0x37, 0x04,
+};
+
+static const uint8_t s_oda_rec4[100] = {
+    0x70, 0x62, 0x93, 0x60, 0xB9, 0x53, 0xC5, 0xE7, 0x1B, 0x4D, 0x95, 0x2B, 0xA6, 0xC4, 0x79, 0xEC,
+    0xBF, 0xFB, 0xEF, 0xE6, 0xDD, 0x6B, 0x58, 0x52, 0x81, 0xA3, 0x9D, 0x24, 0xCE, 0x6B, 0xDA, 0xD4,
+    0xEF, 0x1B, 0x25, 0xC9, 0x68, 0x18, 0xF7, 0x06, 0x4E, 0xE3, 0x77, 0x16, 0xF3, 0xCA, 0xA6, 0x4A,
+    0xD5, 0x66, 0x1E, 0xDA, 0x67, 0xF6, 0xD1, 0x47, 0x6E, 0x1B, 0xAF, 0x02, 0x67, 0x03, 0x92, 0x96,
+    0xB8, 0xF1, 0x0D, 0x10, 0x5C, 0xA8, 0xE4, 0xA1, 0x75, 0xEA, 0xC1, 0x12, 0xED, 0x8E, 0x35, 0xB6,
+    0xDF, 0xB5, 0x0C, 0x14, 0xE7, 0xB4, 0x83, 0x13, 0x44, 0x3D, 0x2D, 0x8B, 0x9D, 0xB7, 0x8B, 0xC2,
+    0xE9, 0x3E, 0x89, 0x47,
+};
+
+static const uint8_t s_oda_dda_resp[66] = {
+    0x80, 0x40, 0xA3, 0x5C, 0x16, 0x1C, 0xB5, 0x13, 0x54, 0x11, 0x76, 0x2B, 0x2B, 0xA8, 0xDD, 0xFD,
+    0xBA, 0xCE, 0x57, 0xF2, 0x74, 0xCB, 0xFD, 0xE1, 0xE9, 0x39, 0x93, 0xDF, 0xB8, 0x0B, 0xA2, 0x63,
+    0x09, 0x99, 0x3E, 0x69, 0x34, 0x2E, 0x0B, 0x86, 0x68, 0x95, 0x99, 0x93, 0x89, 0xB9, 0xD9, 0xC2,
+    0xD6, 0x98, 0xA6, 0xFF, 0x86, 0xAA, 0x6E, 0x1A, 0x39, 0x97, 0x8B, 0x80, 0xD9, 0x8F, 0x87, 0x3C,
+    0x84, 0xEC,
+};
+
+static const uint8_t s_oda_fdda_gpo[94] = {
+    0x77, 0x5C, 0x82, 0x02, 0x20, 0x00, 0x94, 0x04, 0x08, 0x01, 0x04, 0x01, 0x9F, 0x36, 0x02, 0x00,
+    0x01, 0x9F, 0x69, 0x07, 0x01, 0xA1, 0xB2, 0xC3, 0xD4, 0x00, 0x00, 0x9F, 0x4B, 0x40, 0x19, 0x95,
+    0xE5, 0xBD, 0xB7, 0x6D, 0xCF, 0xFD, 0xFD, 0xF0, 0xF0, 0x9E, 0x42, 0xC4, 0x5D, 0x27, 0xDA, 0x7D,
+    0x64, 0x1A, 0xF4, 0xA7, 0x3A, 0xED, 0x47, 0x24, 0x0C, 0x0E, 0xE6, 0x44, 0xF1, 0x73, 0x92, 0x35,
+    0xAF, 0x1A, 0x5F, 0x72, 0x25, 0x1F, 0x5D, 0x85, 0x9A, 0xB7, 0xD7, 0x0F, 0x15, 0x00, 0x92, 0xC3,
+    0xA1, 0x79, 0x80, 0x41, 0xC2, 0xDC, 0xC2, 0xB8, 0x03, 0x50, 0x23, 0x4C, 0x58, 0xDA,
+};
+
+static const EMV_ODA_CaKey_t s_oda_ca = {
+    { 0xA0, 0x00, 0x00, 0x00, 0x03 }, 0x92, s_oda_ca_mod, (uint16_t)sizeof(s_oda_ca_mod), { 0x03 }, 1U
+};
+
+/* SELECT response with PDOL 9F66 04 9F02 06 9F37 04 5F2A 02 9A 03 */
+static const uint8_t s_oda_select[] = {
+    0x6F, 0x22, 0x84, 0x07, 0xA0, 0x00, 0x00, 0x00, 0x03, 0x10, 0x10, 0xA5, 0x17, 0x50, 0x04, 0x56,
+    0x49, 0x53, 0x41, 0x9F, 0x38, 0x0E, 0x9F, 0x66, 0x04, 0x9F, 0x02, 0x06, 0x9F, 0x37, 0x04, 0x5F,
+    0x2A, 0x02, 0x9A, 0x03, 0x90, 0x00,
+};
+
+static const uint8_t s_oda_un[4] = { 0x11, 0x22, 0x33, 0x44 };
+
+static EMV_Complete_Card_Data_t s_oda_card;
+static uint8_t s_oda_ia_data[32];
+static uint16_t s_oda_ia_len;
+static uint32_t s_oda_ia_count;
+
+/* Card answer to INTERNAL AUTHENTICATE, signed over s_oda_un whatever the terminal sent */
+EMV_Result_t EMV_InternalAuthenticate(uint8_t *auth_data, uint16_t auth_data_len,
+                                     uint8_t *response, uint16_t *response_len)
+{
+    s_oda_ia_count++;
+    s_oda_ia_len = (auth_data_len < sizeof(s_oda_ia_data)) ? auth_data_len : (uint16_t)sizeof(s_oda_ia_data);
+    memcpy(s_oda_ia_data, auth_data, s_oda_ia_len);
+    memcpy(response, s_oda_dda_resp, sizeof(s_oda_dda_resp));
+    *response_len = (uint16_t)sizeof(s_oda_dda_resp);
+    return EMV_SUCCESS;
+}
+
+static void Bench_OdaCopy(uint8_t *dst, uint16_t *dst_len, const uint8_t *src, uint16_t src_len)
+{
+    memcpy(dst, src, src_len);
+    dst[src_len] = 0x90;
+    dst[src_len + 1U] = 0x00;
+    *dst_len = (uint16_t)(src_len + 2U);
+}
+
+/* Test card as read up to ODA, the AIP selects the method */
+static void Bench_OdaCard(EMV_ODA_Method_t method)
+{
+    static const uint8_t gpo_sda[] = { 0x80, 0x06, 0x40, 0x00, 0x08, 0x01, 0x04, 0x01 };
+    static const uint8_t gpo_dda[] = { 0x80, 0x06, 0x20, 0x00, 0x08, 0x01, 0x04, 0x01 };
+    const uint8_t *rec[4] = { s_oda_rec1, s_oda_rec2, s_oda_rec3, s_oda_rec4 };
+    const uint16_t rec_len[4] = { sizeof(s_oda_rec1), sizeof(s_oda_rec2), sizeof(s_oda_rec3), sizeof(s_oda_rec4) };
+
+    memset(&s_oda_card, 0, sizeof(s_oda_card));
+    memcpy(s_oda_card.app_select_data, s_oda_select, sizeof(s_oda_select));
+    s_oda_card.app_select_len = (uint16_t)sizeof(s_oda_select);
+    if (method == EMV_ODA_SDA) {
+        Bench_OdaCopy(s_oda_card.gpo_data, &s_oda_card.gpo_len, gpo_sda, sizeof(gpo_sda));
+    } else if (method == EMV_ODA_DDA) {
+        Bench_OdaCopy(s_oda_card.gpo_data, &s_oda_card.gpo_len, gpo_dda, sizeof(gpo_dda));
+    } else {
+        Bench_OdaCopy(s_oda_card.gpo_data, &s_oda_card.gpo_len, s_oda_fdda_gpo, sizeof(s_oda_fdda_gpo));
+    }
+    for (uint8_t i = 0; i < 4U; i++) {
+        Bench_OdaCopy(s_oda_card.sfi_records[i], &s_oda_card.sfi_record_lens[i], rec[i], rec_len[i]);
+        s_oda_card.sfi_record_sfi[i] = 1U;
+        s_oda_card.sfi_record_num[i] = (uint8_t)(i + 1U);
+    }
+    s_oda_card.sfi_record_count = 4U;
+    s_oda_card.amount = 1234U;
+    s_oda_card.currency_code = 0x0156U;
+    memcpy(s_oda_card.unpredictable_number, s_oda_un, sizeof(s_oda_un));
+}
+
+/* Authenticate s_oda_card with its own terminal data, or none */
+static EMV_ODA_Result_t Bench_OdaRun(uint8_t with_terminal, EMV_ODA_Method_t *method)
+{
+    EMV_ODA_TerminalData_t terminal;
+
+    EMV_ODA_GetTerminalData(&s_oda_card, &terminal);
+    s_oda_ia_count = 0;
+    return EMV_ODA_Authenticate(&s_oda_card, with_terminal ? &terminal : NULL, method);
+}
+
+/* ================== Link stubs ================== */
+
+/* Referenced by phpalI14443p4_Sw and phCryptoSym_Sw, s_vicc_hal and s_lb_hal are reached by the simulators */
+phStatus_t phhalHw_Pn5180_Exchange(phhalHw_Pn5180_DataParams_t *pDataParams, uint16_t wOption, uint8_t *pTxBuffer,
+                                   uint16_t wTxLength, uint8_t **ppRxBuffer, uint16_t *pRxLength)
+{
+    if (pDataParams == &s_ov_hal) {
+        /* Only the PCB of the asynchronous I-Block is buffered here */
+        if ((wOption & PH_EXCHANGE_BUFFERED_BIT) == 0U || wTxLength > sizeof(s_ov_tx)) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+        }
+        memcpy(s_ov_tx, pTxBuffer, wTxLength);
+        s_ov_tx_len = wTxLength;
+        return PH_ERR_SUCCESS;
+    }
+    if (pDataParams == &s_lb_hal) {
+        if ((wOption & PH_EXCHANGE_LEAVE_BUFFER_BIT) == 0U) {
+            s_lb_tx_len = 0;
+        }
+        if (wTxLength > sizeof(s_lb_tx) - s_lb_tx_len) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_BUFFER_OVERFLOW, PH_COMP_HAL);
+        }
+        if (wTxLength != 0U) {
+            memcpy(&s_lb_tx[s_lb_tx_len], pTxBuffer, wTxLength);
+            s_lb_tx_len = (uint16_t)(s_lb_tx_len + wTxLength);
+        }
+        if ((wOption & PH_EXCHANGE_BUFFERED_BIT) != 0U) {
+            return PH_ERR_SUCCESS;
+        }
+        return Bench_LbCardExchange(ppRxBuffer, pRxLength);
+    }
+    if (pDataParams != &s_vicc_hal) {
+        (void)wOption; (void)pTxBuffer; (void)wTxLength; (void)ppRxBuffer; (void)pRxLength;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+    }
+    if ((wOption & PH_EXCHANGE_LEAVE_BUFFER_BIT) == 0U) {
+        s_vicc_tx_len = 0;
+    }
+    if (wTxLength > sizeof(s_vicc_tx) - s_vicc_tx_len) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_BUFFER_OVERFLOW, PH_COMP_HAL);
+    }
+    if (wTxLength != 0U) {
+        memcpy(&s_vicc_tx[s_vicc_tx_len], pTxBuffer, wTxLength);
+        s_vicc_tx_len = (uint16_t)(s_vicc_tx_len + wTxLength);
+    }
+    if ((wOption & PH_EXCHANGE_BUFFERED_BIT) != 0U) {
+        return PH_ERR_SUCCESS;
+    }
+    return Bench_ViccExchange(ppRxBuffer, pRxLength);
+}
+
+/* s_ov_hal: the frame goes out, the card answer is due at s_ov_done_us. s_mr_hal: WUPA */
+phStatus_t phhalHw_Pn5180_ExchangeSubmit(phhalHw_Pn5180_DataParams_t *pDataParams, uint16_t wOption,
+                                         uint8_t *pTxBuffer, uint16_t wTxLength)
+{
+    const int r = Bench_MrIndex(pDataParams);
+
+    if (r >= 0) {
+        if (!s_mr_field[r] || s_mr_pending[r] || wTxLength != 1U || pTxBuffer[0] != 0x52U) {
+            (void)wOption;
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_HAL);
+        }
+        s_mr_us += 2.0 * BENCH_MR_SPI_US;
+        if (s_mr_us - s_mr_on_us[r] < BENCH_MR_RESET_US) {
+            s_mr.violations++;
+        }
+        s_mr_done_us[r] = s_mr_us + (s_mr_card[r] ? BENCH_MR_ATQA_US : BENCH_MR_WUPA_US + MULTI_READER_ATQA_US);
+        s_mr_pending[r] = 1;
+        s_mr.wupas++;
+        return PH_ERR_SUCCESS;
+    }
+    if (pDataParams != &s_ov_hal || s_ov_pending) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+    }
+    if ((wOption & PH_EXCHANGE_LEAVE_BUFFER_BIT) == 0U) {
+        s_ov_tx_len = 0;
+    }
+    if (wTxLength > sizeof(s_ov_tx) - s_ov_tx_len) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_BUFFER_OVERFLOW, PH_COMP_HAL);
+    }
+    if (wTxLength != 0U) {
+        memcpy(&s_ov_tx[s_ov_tx_len], pTxBuffer, wTxLength);
+        s_ov_tx_len = (uint16_t)(s_ov_tx_len + wTxLength);
+    }
+    Bench_OvCard();
+    s_ov_pending = 1;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_ExchangePoll(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t **ppRxBuffer,
+                                       uint16_t *pRxLength)
+{
+    static uint8_t atqa[2] = { 0x44U, 0x00U };
+    const int r = Bench_MrIndex(pDataParams);
+
+    if (r >= 0) {
+        s_mr_us += BENCH_MR_SPI_US;
+        s_mr.polls++;
+        if (!s_mr_pending[r]) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_HAL);
+        }
+        if (s_mr_us < s_mr_done_us[r]) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_SUCCESS_PENDING, PH_COMP_HAL);
+        }
+        s_mr_pending[r] = 0;
+        if (!s_mr_card[r]) {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_IO_TIMEOUT, PH_COMP_HAL);
+        }
+        *ppRxBuffer = atqa;
+        *pRxLength = sizeof(atqa);
+        return PH_ERR_SUCCESS;
+    }
+    if (pDataParams != &s_ov_hal || !s_ov_pending) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_HAL);
+    }
+    s_ov_us += BENCH_OV_POLL_US;
+    if (s_ov_us < s_ov_done_us) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_SUCCESS_PENDING, PH_COMP_HAL);
+    }
+    s_ov_pending = 0;
+    *ppRxBuffer = s_ov_rx;
+    *pRxLength = s_ov_rx_len;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_SetConfig(phhalHw_Pn5180_DataParams_t *pDataParams, uint16_t wConfig, uint16_t wValue)
+{
+    if (Bench_MrIndex(pDataParams) >= 0) {
+        s_mr_us += BENCH_MR_SPI_US;
+        return PH_ERR_SUCCESS;
+    }
+    if (pDataParams == &s_ov_hal) {
+        /* The card always answers within FWT */
+        (void)wConfig; (void)wValue;
+        return PH_ERR_SUCCESS;
+    }
+    if (pDataParams == &s_lb_hal) {
+        if (wConfig == PHHAL_HW_CONFIG_TIMEOUT_VALUE_US) {
+            s_lb_timeout_us = wValue;
+        } else if (wConfig == PHHAL_HW_CONFIG_TIMEOUT_VALUE_MS) {
+            s_lb_timeout_us = wValue * 1000U;
+        } else if (wConfig == PHHAL_HW_CONFIG_RXBUFFER_STARTPOS) {
+            s_lb_startpos = wValue;
+        }
+        return PH_ERR_SUCCESS;
+    }
+    if (pDataParams != &s_vicc_hal) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+    }
+    if (wConfig == PHHAL_HW_CONFIG_TIMEOUT_VALUE_US) {
+        s_vicc_timeout_us = wValue;
+    } else if (wConfig == PHHAL_HW_CONFIG_TIMEOUT_VALUE_MS) {
+        s_vicc_timeout_us = wValue * 1000U;
+    } else if (wConfig == PHHAL_HW_CONFIG_SYMBOL_START) {
+        s_vicc_sof = (wValue != PH_OFF) ? 1U : 0U;
+    }
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_GetConfig(phhalHw_Pn5180_DataParams_t *pDataParams, uint16_t wConfig, uint16_t *pValue)
+{
+    if (pDataParams == &s_ov_hal) {
+        *pValue = (wConfig == PHHAL_HW_CONFIG_RXBUFFER_BUFSIZE || wConfig == PHHAL_HW_CONFIG_TXBUFFER_BUFSIZE) ?
+                  BENCH_UL_RX_BUFSIZE : 0U;
+        return PH_ERR_SUCCESS;
+    }
+    if (pDataParams == &s_lb_hal) {
+        switch (wConfig) {
+        case PHHAL_HW_CONFIG_RXBUFFER_BUFSIZE:
+        case PHHAL_HW_CONFIG_TXBUFFER_BUFSIZE:
+            *pValue = BENCH_UL_RX_BUFSIZE;
+            break;
+        case PHHAL_HW_CONFIG_RXBUFFER_STARTPOS:
+            *pValue = s_lb_startpos;
+            break;
+        case PHHAL_HW_CONFIG_TIMEOUT_VALUE_US:
+            if (s_lb_timeout_us > 0xFFFFU) {
+                return PH_ADD_COMPCODE_FIXED(PH_ERR_PARAMETER_OVERFLOW, PH_COMP_HAL);
+            }
+            *pValue = (uint16_t)s_lb_timeout_us;
+            break;
+        case PHHAL_HW_CONFIG_TIMEOUT_VALUE_MS:
+            *pValue = (uint16_t)(s_lb_timeout_us / 1000U);
+            break;
+        default:
+            *pValue = 0;
+            break;
+        }
+        return PH_ERR_SUCCESS;
+    }
+    if (pDataParams == &s_vicc_hal && wConfig != PHHAL_HW_CONFIG_RXBUFFER_BUFSIZE) {
+        /* 100 % ASK as configured for ISO15693 */
+        *pValue = (wConfig == PHHAL_HW_CONFIG_ASK100) ? PH_ON :
+                  (wConfig == PHHAL_HW_CONFIG_TIMEOUT_VALUE_US) ? (uint16_t)s_vicc_timeout_us : 0U;
+        return PH_ERR_SUCCESS;
+    }
+    if (wConfig == PHHAL_HW_CONFIG_RXBUFFER_BUFSIZE) {
+        *pValue = BENCH_UL_RX_BUFSIZE;
+        return PH_ERR_SUCCESS;
+    }
+    return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+}
+
+/* s_mr_hal only, field switching with the 5.1ms reset and guard time checked */
+phStatus_t phhalHw_Pn5180_ApplyProtocolSettings(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t bCardType)
+{
+    if (Bench_MrIndex(pDataParams) < 0 || bCardType != PHHAL_HW_CARDTYPE_ISO14443A) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+    }
+    s_mr_us += 4.0 * BENCH_MR_SPI_US;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_FieldOn(phhalHw_Pn5180_DataParams_t *pDataParams)
+{
+    const int r = Bench_MrIndex(pDataParams);
+
+    if (pDataParams == &s_lp_hal) {
+        s_lp_field = 1;
+        return PH_ERR_SUCCESS;
+    }
+    if (r < 0) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+    }
+    s_mr_us += BENCH_MR_SPI_US;
+    if (s_mr_us - s_mr_off_us[r] < BENCH_MR_RESET_US) {
+        s_mr.violations++;
+    }
+    s_mr_field[r] = 1;
+    s_mr_on_us[r] = s_mr_us;
+    s_mr.field_ons++;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_FieldOff(phhalHw_Pn5180_DataParams_t *pDataParams)
+{
+    const int r = Bench_MrIndex(pDataParams);
+
+    if (pDataParams == &s_lp_hal) {
+        s_lp_field = 0;
+        return PH_ERR_SUCCESS;
+    }
+    if (r < 0) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+    }
+    s_mr_us += BENCH_MR_SPI_US;
+    s_mr_field[r] = 0;
+    s_mr_pending[r] = 0;
+    s_mr_off_us[r] = s_mr_us;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_Wait(phhalHw_Pn5180_DataParams_t *pDataParams, uint8_t bUnit, uint16_t wTimeout)
+{
+    (void)pDataParams;
+    s_vicc_us += (bUnit == PHHAL_HW_TIME_MILLISECONDS) ? wTimeout * 1000.0 : (double)wTimeout;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phKeyStore_Sw_GetKey(phKeyStore_Sw_DataParams_t *pDataParams, uint16_t wKeyNo, uint16_t wKeyVersion,
+                                uint8_t bKeyBufSize, uint8_t *pKey, uint16_t *pKeyType)
+{
+    (void)pDataParams; (void)wKeyNo; (void)wKeyVersion; (void)bKeyBufSize; (void)pKey; (void)pKeyType;
+    return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_KEYSTORE);
+}
+
+static void Bench_T2T_Build(void)
+{
+    uint32_t i = 16U;
+    uint32_t ndef_len = BENCH_NDEF_LEN;
+
+    s_ul = &s_ul_profiles[BENCH_UL_PROFILE_DEFAULT];
+    s_ul_sector = 0;
+    memset(s_t2t, 0, sizeof(s_t2t));
+    /* NTAG216: UID/lock header, CC E1 10 6D 00 */
+    s_t2t[12] = 0xE1; s_t2t[13] = 0x10; s_t2t[14] = 0x6D; s_t2t[15] = 0x00;
+
+    /* Lock control TLV, memory control TLV and a NULL TLV in front of the NDEF */
+    s_t2t[i++] = 0x01; s_t2t[i++] = 0x03; s_t2t[i++] = 0xE2; s_t2t[i++] = 0x20; s_t2t[i++] = 0x44;
+    s_t2t[i++] = 0x02; s_t2t[i++] = 0x03; s_t2t[i++] = 0xE3; s_t2t[i++] = 0x04; s_t2t[i++] = 0x44;
+    s_t2t[i++] = 0x00;
+
+    /* NDEF TLV with one short URI record */
+    s_t2t[i++] = 0x03; s_t2t[i++] = (uint8_t)ndef_len;
+    s_t2t[i++] = 0xD1; s_t2t[i++] = 0x01; s_t2t[i++] = (uint8_t)(ndef_len - 4U); s_t2t[i++] = 0x55;
+    for (uint32_t n = 4U; n < ndef_len; n++) {
+        s_t2t[i++] = (uint8_t)('a' + (n % 26U));
+    }
+    s_t2t[i] = 0xFE;
+}
+
+/* ================== Kernels ================== */
+
+static void K_Crc16(void)
+{
+    uint16_t crc;
+    s_status = phTools_CalculateCrc16(PH_TOOLS_CRC_OPTION_DEFAULT, PH_TOOLS_CRC16_PRESET_ISO14443A,
+                                      PH_TOOLS_CRC16_POLY_ISO14443, s_data, BENCH_DATA_LEN, &crc);
+    s_sink += crc;
+}
+
+static void K_Crc32(void)
+{
+    uint32_t crc;
+    s_status = phTools_CalculateCrc32(PH_TOOLS_CRC_OPTION_DEFAULT, PH_TOOLS_CRC32_PRESET_DF8,
+                                      PH_TOOLS_CRC32_POLY_DF8, s_data, BENCH_DATA_LEN, &crc);
+    s_sink += crc;
+}
+
+static void K_ParityEncode(void)
+{
+    uint16_t len;
+    uint8_t bits;
+    s_status = phTools_EncodeParity(PH_TOOLS_PARITY_OPTION_ODD, s_parity_in, BENCH_PARITY_LEN, 0,
+                                    (uint16_t)sizeof(s_out), s_out, &len, &bits);
+    s_sink += len + bits;
+}
+
+static void K_ParityDecode(void)
+{
+    uint16_t len;
+    uint8_t bits;
+    s_status = phTools_DecodeParity(PH_TOOLS_PARITY_OPTION_ODD, s_parity_enc, s_parity_enc_len, s_parity_enc_bits,
+                                    (uint16_t)sizeof(s_out), s_out, &len, &bits);
+    s_sink += len + bits;
+}
+
+static void K_ParityEncodeRef(void)
+{
+    uint16_t len;
+    uint8_t bits;
+    s_status = phTools_EncodeParityRef(PH_TOOLS_PARITY_OPTION_ODD, s_parity_in, BENCH_PARITY_LEN, 0,
+                                       (uint16_t)sizeof(s_out), s_out, &len, &bits);
+    s_sink += len + bits;
+}
+
+static void K_ParityDecodeRef(void)
+{
+    uint16_t len;
+    uint8_t bits;
+    s_status = phTools_DecodeParityRef(PH_TOOLS_PARITY_OPTION_ODD, s_parity_enc, s_parity_enc_len, s_parity_enc_bits,
+                                       (uint16_t)sizeof(s_out), s_out, &len, &bits);
+    s_sink += len + bits;
+}
+
+static void K_AesKeyLoad(void)
+{
+    s_status = phCryptoSym_LoadKeyDirect(&s_sym, (uint8_t *)s_aes_key, PH_CRYPTOSYM_KEY_TYPE_AES128);
+    s_sink += s_status;
+}
+
+static void K_AesEcb16(void)
+{
+    s_status = phCryptoSym_Encrypt(&s_sym, PH_CRYPTOSYM_CIPHER_MODE_ECB, s_data, 16U, s_out);
+    s_sink += s_out[0];
+}
+
+static void K_AesCbcEnc(void)
+{
+    (void)phCryptoSym_LoadIv(&s_sym, s_iv, 16U);
+    s_status = phCryptoSym_Encrypt(&s_sym, PH_CRYPTOSYM_CIPHER_MODE_CBC, s_data, BENCH_DATA_LEN, s_out);
+    s_sink += s_out[0];
+}
+
+static void K_AesCbcDec(void)
+{
+    (void)phCryptoSym_LoadIv(&s_sym, s_iv, 16U);
+    s_status = phCryptoSym_Decrypt(&s_sym, PH_CRYPTOSYM_CIPHER_MODE_CBC, s_data, BENCH_DATA_LEN, s_out);
+    s_sink += s_out[0];
+}
+
+static void K_AesCmac(void)
+{
+    uint8_t mac_len;
+    (void)phCryptoSym_LoadIv(&s_sym, s_iv, 16U);
+    s_status = phCryptoSym_CalculateMac(&s_sym, PH_CRYPTOSYM_MAC_MODE_CMAC, s_data, 64U, s_out, &mac_len);
+    s_sink += s_out[0] + mac_len;
+}
+
+static void K_Des2k3Cbc(void)
+{
+    (void)phCryptoSym_LoadKeyDirect(&s_sym, (uint8_t *)s_des_key, PH_CRYPTOSYM_KEY_TYPE_2K3DES);
+    (void)phCryptoSym_LoadIv(&s_sym, s_iv, 8U);
+    s_status = phCryptoSym_Encrypt(&s_sym, PH_CRYPTOSYM_CIPHER_MODE_CBC, s_data, 64U, s_out);
+    s_sink += s_out[0];
+}
+
+static void K_RngGenerate(void)
+{
+    s_status = phCryptoRng_Sw_Generate(&s_rng, NULL, 0, 16U, s_out);
+    s_sink += s_out[0];
+}
+
+static void K_I4BuildBlocks(void)
+{
+    uint16_t len;
+    uint16_t total = 0;
+
+    (void)phpalI14443p4_Sw_BuildIBlock(1U, 0x01U, 0U, 0x00U, 1U, 1U, s_out, &len);
+    total += len;
+    (void)phpalI14443p4_Sw_BuildRBlock(1U, 0x01U, 0U, 1U, s_out, &len);
+    total += len;
+    s_status = phpalI14443p4_Sw_BuildSBlock(1U, 0x01U, 1U, 0x05U, s_out, &len);
+    s_sink += total + len;
+}
+
+static void K_TopT2TCheckRead(void)
+{
+    uint8_t state;
+    uint32_t len = 0;
+
+    s_status = phalTop_Sw_Int_T2T_CheckNdef(&s_top, &state);
+    if (s_status == PH_ERR_SUCCESS) {
+        s_status = phalTop_Sw_Int_T2T_ReadNdef(&s_top, s_ndef, &len);
+    }
+    s_sink += state + len;
+}
+
+static void K_CmdPlanValidate(void)
+{
+    s_status = (phStatus_t)CmdPlan_Validate(s_plan_read_cond_write, (uint16_t)sizeof(s_plan_read_cond_write), NULL);
+    s_sink += s_status;
+}
+
+/* Interpreter and simplified API glue, the tag answers instantly */
+static void K_CmdPlanRun(void)
+{
+    CmdPlan_Result_t result;
+
+    s_status = (phStatus_t)CmdPlan_Execute(s_plan_read_cond_write, (uint16_t)sizeof(s_plan_read_cond_write),
+                                           s_plan_out, (uint16_t)sizeof(s_plan_out), &result);
+    s_sink += result.out_len + result.exchanges;
+}
+
+/* Cache cleared, every call runs the comb evaluation */
+static void K_OrigCheckMful(void)
+{
+    OrigCheck_ClearCache();
+    s_status = (phStatus_t)OrigCheck_VerifyOriginality(s_orig_uid_mful, sizeof(s_orig_uid_mful), s_orig_sig_mful,
+                                                       sizeof(s_orig_sig_mful), ORIG_TAG_MFUL);
+    s_sink += s_status;
+}
+
+static void K_OrigCheckMfulGeneric(void)
+{
+    s_status = (phStatus_t)OrigCheck_VerifyGeneric(s_orig_uid_mful, sizeof(s_orig_uid_mful), s_orig_sig_mful,
+                                                   sizeof(s_orig_sig_mful), ORIG_TAG_MFUL);
+    s_sink += s_status;
+}
+
+static void K_OrigCheckNtag42x(void)
+{
+    OrigCheck_ClearCache();
+    s_status = (phStatus_t)OrigCheck_VerifyOriginality(s_orig_uid_ntag42x, sizeof(s_orig_uid_ntag42x),
+                                                       s_orig_sig_ntag42x, sizeof(s_orig_sig_ntag42x),
+                                                       ORIG_TAG_NTAG42X);
+    s_sink += s_status;
+}
+
+static void K_OrigCheckNtag42xGeneric(void)
+{
+    s_status = (phStatus_t)OrigCheck_VerifyGeneric(s_orig_uid_ntag42x, sizeof(s_orig_uid_ntag42x),
+                                                   s_orig_sig_ntag42x, sizeof(s_orig_sig_ntag42x),
+                                                   ORIG_TAG_NTAG42X);
+    s_sink += s_status;
+}
+
+/* Same tag presented again */
+static void K_OrigCheckCacheHit(void)
+{
+    s_status = (phStatus_t)OrigCheck_VerifyOriginality(s_orig_uid_ntag42x, sizeof(s_orig_uid_ntag42x),
+                                                       s_orig_sig_ntag42x, sizeof(s_orig_sig_ntag42x),
+                                                       ORIG_TAG_NTAG42X);
+    s_sink += s_status;
+}
+
+/* NTAG216 image of phalTop, layout cached after the first call */
+static void K_MfulReadAll(void)
+{
+    MfulBulk_Result_t result;
+
+    s_status = MfulBulk_ReadAll(&s_mful, s_ul_uid, sizeof(s_ul_uid), s_ul_dump, (uint16_t)sizeof(s_ul_dump), &result);
+    s_sink += result.bytes + s_ul_dump[4];
+}
+
+static const Bench_Case_t s_cases[] = {
+    { "crc16_iso14443a_256",    "phTools",          BENCH_DATA_LEN,     K_Crc16 },
+    { "crc32_df8_256",          "phTools",          BENCH_DATA_LEN,     K_Crc32 },
+    { "parity_encode_64",       "phTools",          BENCH_PARITY_LEN,   K_ParityEncode },
+    { "parity_decode_64",       "phTools",          BENCH_PARITY_LEN,   K_ParityDecode },
+    { "parity_encode_64_ref",   "phTools",          BENCH_PARITY_LEN,   K_ParityEncodeRef },
+    { "parity_decode_64_ref",   "phTools",          BENCH_PARITY_LEN,   K_ParityDecodeRef },
+    { "aes128_load_key",        "phCryptoSym_Sw",   0,                  K_AesKeyLoad },
+    { "aes128_ecb_enc_16",      "phCryptoSym_Sw",   16U,                K_AesEcb16 },
+    { "aes128_cbc_enc_256",     "phCryptoSym_Sw",   BENCH_DATA_LEN,     K_AesCbcEnc },
+    { "aes128_cbc_dec_256",     "phCryptoSym_Sw",   BENCH_DATA_LEN,     K_AesCbcDec },
+    { "aes128_cmac_64",         "phCryptoSym_Sw",   64U,                K_AesCmac },
+    { "des2k3_cbc_enc_64",      "phCryptoSym_Sw",   64U,                K_Des2k3Cbc },
+    { "ctr_drbg_generate_16",   "phCryptoRng_Sw",   16U,                K_RngGenerate },
+    { "i14443p4_build_irs",     "phpalI14443p4_Sw", 0,                  K_I4BuildBlocks },
+    { "top_t2t_check_read",     "phalTop_Sw",       BENCH_NDEF_LEN,     K_TopT2TCheckRead },
+    { "cmd_plan_validate",      "cmd_plan",         0,                  K_CmdPlanValidate },
+    { "cmd_plan_run_67_xchg",   "cmd_plan",         BENCH_V_BLOCKS * BENCH_V_BLOCK_SIZE, K_CmdPlanRun },
+    { "orig_mful_comb",         "orig_check",       0,                  K_OrigCheckMful },
+    { "orig_mful_generic",      "orig_check",       0,                  K_OrigCheckMfulGeneric },
+    { "orig_ntag42x_comb",      "orig_check",       0,                  K_OrigCheckNtag42x },
+    { "orig_ntag42x_generic",   "orig_check",       0,                  K_OrigCheckNtag42xGeneric },
+    { "orig_cache_hit",         "orig_check",       0,                  K_OrigCheckCacheHit },
+    { "mful_read_all_ntag216",  "mful_bulk",        BENCH_T2T_SIZE,     K_MfulReadAll },
+};
+
+/* Cases that reload the key leave AES loaded for the next ones */
+static void Bench_Prepare(const Bench_Case_t *c)
+{
+    if (strncmp(c->name, "aes", 3) == 0) {
+        (void)phCryptoSym_LoadKeyDirect(&s_sym, (uint8_t *)s_aes_key, PH_CRYPTOSYM_KEY_TYPE_AES128);
+    }
+}
+
+/* ================== Equivalence checks ================== */
+
+typedef phStatus_t (*Bench_ParityFct_t)(uint8_t, uint8_t *, uint16_t, uint8_t, uint16_t, uint8_t *, uint16_t *, uint8_t *);
+
+static uint32_t s_lcg = 0x12345678U;
+
+static uint8_t Bench_Rand8(void)
+{
+    s_lcg = s_lcg * 1103515245U + 12345U;
+    return (uint8_t)(s_lcg >> 16);
+}
+
+/* Run both implementations on the same input, 1 when status, lengths and data agree */
+static uint8_t Bench_ParitySame(Bench_ParityFct_t fast, Bench_ParityFct_t ref, uint8_t option, uint8_t *in,
+                                uint16_t len, uint8_t bits)
+{
+    uint8_t out_fast[BENCH_PARITY_VERIFY_MAX + 16U], out_ref[BENCH_PARITY_VERIFY_MAX + 16U];
+    uint16_t len_fast = 0xFFFFU, len_ref = 0xFFFFU;
+    uint8_t bits_fast = 0xFFU, bits_ref = 0xFFU;
+    phStatus_t st_fast, st_ref;
+
+    st_fast = fast(option, in, len, bits, (uint16_t)sizeof(out_fast), out_fast, &len_fast, &bits_fast);
+    st_ref = ref(option, in, len, bits, (uint16_t)sizeof(out_ref), out_ref, &len_ref, &bits_ref);
+    if (st_fast != st_ref) {
+        return 0;
+    }
+    if (st_fast != PH_ERR_SUCCESS) {
+        return 1;
+    }
+    return (len_fast == len_ref && bits_fast == bits_ref && memcmp(out_fast, out_ref, len_ref) == 0) ? 1U : 0U;
+}
+
+/* Every length 0..BENCH_PARITY_VERIFY_LEN with every bInBufferBits value, both options:
+ * encode of random data, decode of valid frames, of frames with one flipped bit and of random data */
+static uint32_t Bench_VerifyParity(uint32_t *pFailures)
+{
+    uint8_t in[BENCH_PARITY_VERIFY_MAX];
+    uint8_t enc[BENCH_PARITY_VERIFY_MAX + 16U];
+    uint16_t enc_len;
+    uint8_t enc_bits;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+    for (uint8_t option = PH_TOOLS_PARITY_OPTION_EVEN; option <= PH_TOOLS_PARITY_OPTION_ODD; option++) {
+        for (uint16_t len = 0; len <= BENCH_PARITY_VERIFY_LEN; len++) {
+            for (uint8_t bits = 0; bits < 8U; bits++) {
+                for (uint8_t trial = 0; trial < BENCH_PARITY_VERIFY_TRIALS; trial++) {
+                    for (uint16_t i = 0; i < sizeof(in); i++) {
+                        in[i] = Bench_Rand8();
+                    }
+                    *pFailures += 1U - Bench_ParitySame(phTools_EncodeParity, phTools_EncodeParityRef, option, in, len, bits);
+                    *pFailures += 1U - Bench_ParitySame(phTools_DecodeParity, phTools_DecodeParityRef, option, in, len, bits);
+                    cases += 2U;
+
+                    if (phTools_EncodeParityRef(option, in, len, bits, (uint16_t)sizeof(enc), enc, &enc_len, &enc_bits)
+                        != PH_ERR_SUCCESS || enc_len == 0U) {
+                        continue;
+                    }
+                    *pFailures += 1U - Bench_ParitySame(phTools_DecodeParity, phTools_DecodeParityRef, option, enc,
+                                                        enc_len, enc_bits);
+                    enc[Bench_Rand8() % enc_len] ^= (uint8_t)(1U << (Bench_Rand8() % 8U));
+                    *pFailures += 1U - Bench_ParitySame(phTools_DecodeParity, phTools_DecodeParityRef, option, enc,
+                                                        enc_len, enc_bits);
+                    cases += 2U;
+                }
+            }
+        }
+    }
+    return cases;
+}
+
+/* One plan, its expected code and the offset it must stop at */
+typedef struct {
+    const uint8_t *plan;
+    uint16_t len;
+    CmdPlan_Code_t code;
+    uint16_t pc;
+} Bench_PlanCheck_t;
+
+static const uint8_t s_plan_trunc[] = { CMD_PLAN_OP_XCHG, CMD_PLAN_KIND_RAW, 0, 0, 0, 0, 4, 0x30, 0x00 };
+static const uint8_t s_plan_mid_jump[] = { CMD_PLAN_OP_SET_I, 0, 0, CMD_PLAN_OP_JMP, 0, 1 };
+static const uint8_t s_plan_bad_kind[] = { CMD_PLAN_OP_END, CMD_PLAN_OP_XCHG, 0x05, 0, 0, 0, 0, 0 };
+static const uint8_t s_plan_bad_cond[] = { CMD_PLAN_OP_BR, 0x07, 0, 0, 0, 0, 0 };
+static const uint8_t s_plan_bad_op[] = { CMD_PLAN_OP_EXPECT_OK, 0x42 };
+static const uint8_t s_plan_spin[] = { CMD_PLAN_OP_JMP, 0, 0 };
+static const uint8_t s_plan_fail[] = { CMD_PLAN_OP_EXPECT_OK, CMD_PLAN_OP_FAIL, 0x77 };
+static const uint8_t s_plan_range[] = {
+    CMD_PLAN_OP_XCHG, CMD_PLAN_KIND_I15693, ISO15693_ReadSingleBlock, 0, 0, 0, 0,
+    CMD_PLAN_OP_CAPTURE, 2, 3
+};
+static const uint8_t s_plan_lost[] = {
+    CMD_PLAN_OP_XCHG, CMD_PLAN_KIND_I15693, ISO15693_ReadSingleBlock, 0x01, 0x00, 0, 0,
+    CMD_PLAN_OP_BR, CMD_PLAN_COND_ERR, 0, 0, 0, 0, 16,
+    CMD_PLAN_OP_EXPECT_OK, CMD_PLAN_OP_END,
+    CMD_PLAN_OP_FAIL, 0x01
+};
+
+static const Bench_PlanCheck_t s_plan_checks[] = {
+    { s_plan_trunc,     sizeof(s_plan_trunc),     CMD_PLAN_ERR_FORMAT,  0 },
+    { s_plan_mid_jump,  sizeof(s_plan_mid_jump),  CMD_PLAN_ERR_FORMAT,  3 },
+    { s_plan_bad_kind,  sizeof(s_plan_bad_kind),  CMD_PLAN_ERR_FORMAT,  1 },
+    { s_plan_bad_cond,  sizeof(s_plan_bad_cond),  CMD_PLAN_ERR_FORMAT,  0 },
+    { s_plan_bad_op,    sizeof(s_plan_bad_op),    CMD_PLAN_ERR_FORMAT,  1 },
+    { s_plan_spin,      sizeof(s_plan_spin),      CMD_PLAN_ERR_STEPS,   0 },
+    { s_plan_fail,      sizeof(s_plan_fail),      CMD_PLAN_ERR_ABORT,   1 },
+    { s_plan_range,     sizeof(s_plan_range),     CMD_PLAN_ERR_RANGE,   7 },
+    { s_plan_lost,      sizeof(s_plan_lost),      CMD_PLAN_ERR_ABORT,   16 },
+};
+
+/* The scenario plan must dump the tag and write both blocks, the other plans must stop where expected */
+static uint32_t Bench_VerifyCmdPlan(uint32_t *pFailures)
+{
+    CmdPlan_Result_t result;
+    uint8_t before[sizeof(s_vtag)];
+    uint16_t bad_pc;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+    Bench_VTag_Build();
+    memcpy(before, s_vtag, sizeof(before));
+    cases++;
+    if (CmdPlan_Validate(s_plan_read_cond_write, (uint16_t)sizeof(s_plan_read_cond_write), NULL) != CMD_PLAN_OK ||
+        CmdPlan_Execute(s_plan_read_cond_write, (uint16_t)sizeof(s_plan_read_cond_write), s_plan_out,
+                        (uint16_t)sizeof(s_plan_out), &result) != CMD_PLAN_OK ||
+        result.exchanges != BENCH_V_BLOCKS + 3U || result.out_len != sizeof(before) ||
+        memcmp(s_plan_out, before, sizeof(before)) != 0 ||
+        memcmp(&s_vtag[62U * BENCH_V_BLOCK_SIZE], "\xDE\xAD\xBE\xEF\xCA\xFE\xF0\x0D", 8U) != 0) {
+        (*pFailures)++;
+    }
+
+    /* No match: nothing written */
+    Bench_VTag_Build();
+    s_vtag[5] = (uint8_t)~BENCH_V_MARK;
+    memcpy(before, s_vtag, sizeof(before));
+    cases++;
+    if (CmdPlan_Execute(s_plan_read_cond_write, (uint16_t)sizeof(s_plan_read_cond_write), s_plan_out,
+                        (uint16_t)sizeof(s_plan_out), &result) != CMD_PLAN_OK ||
+        result.exchanges != BENCH_V_BLOCKS + 1U || memcmp(s_vtag, before, sizeof(before)) != 0) {
+        (*pFailures)++;
+    }
+
+    /* Output buffer one block short */
+    cases++;
+    if (CmdPlan_Execute(s_plan_read_cond_write, (uint16_t)sizeof(s_plan_read_cond_write), s_plan_out,
+                        (uint16_t)(sizeof(before) - 1U), &result) != CMD_PLAN_ERR_OVERFLOW || result.pc != 11U) {
+        (*pFailures)++;
+    }
+
+    for (uint32_t i = 0; i < sizeof(s_plan_checks) / sizeof(s_plan_checks[0]); i++) {
+        const Bench_PlanCheck_t *c = &s_plan_checks[i];
+        cases++;
+        if (c->code == CMD_PLAN_ERR_FORMAT) {
+            bad_pc = 0xFFFFU;
+            if (CmdPlan_Validate(c->plan, c->len, &bad_pc) != c->code || bad_pc != c->pc ||
+                CmdPlan_Load(c->plan, c->len) != c->code) {
+                (*pFailures)++;
+            }
+        } else if (CmdPlan_Validate(c->plan, c->len, NULL) != CMD_PLAN_OK ||
+                   CmdPlan_Execute(c->plan, c->len, s_plan_out, (uint16_t)sizeof(s_plan_out), &result) != c->code ||
+                   result.pc != c->pc) {
+            (*pFailures)++;
+        }
+    }
+
+    Bench_VTag_Build();
+    return cases;
+}
+
+/* Stored tables, built-in keys, valid and altered signatures on both paths, key and length checks */
+static uint32_t Bench_VerifyOrigCheck(uint32_t *pFailures)
+{
+    static const struct {
+        OrigCheck_TagType_t type;
+        const uint8_t *key;
+        uint8_t key_len;
+        const uint8_t *uid;
+        uint8_t uid_len;
+        const uint8_t *sig;
+        uint8_t sig_len;
+        const uint8_t *forged;
+    } vec[] = {
+        { ORIG_TAG_MFUL, s_orig_key128, sizeof(s_orig_key128), s_orig_uid_mful, sizeof(s_orig_uid_mful),
+          s_orig_sig_mful, sizeof(s_orig_sig_mful), s_orig_forged_mful },
+        { ORIG_TAG_ICODE, s_orig_key128, sizeof(s_orig_key128), s_orig_uid_icode, sizeof(s_orig_uid_icode),
+          s_orig_sig_icode, sizeof(s_orig_sig_icode), s_orig_forged_icode },
+        { ORIG_TAG_NTAG42X, s_orig_key224, sizeof(s_orig_key224), s_orig_uid_ntag42x, sizeof(s_orig_uid_ntag42x),
+          s_orig_sig_ntag42x, sizeof(s_orig_sig_ntag42x), s_orig_forged_ntag42x },
+    };
+    OrigCheck_Stats_t stats;
+    uint8_t buf[ORIG_CHECK_MAX_SIG + 1U];
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+    OrigCheck_Init();
+    cases += 2U;
+    if (OrigCheck_SelfTest() != ORIG_CHECK_OK) {
+        (*pFailures)++;
+    }
+
+    /* Built-in NXP keys from flash, before any OrigCheck_SetPublicKey */
+    for (uint32_t i = 0; i < sizeof(vec) / sizeof(vec[0]); i++) {
+        cases += 2U;
+        /* Bench-signed tags are no NXP originals */
+        if (OrigCheck_VerifyOriginality(vec[i].uid, vec[i].uid_len, vec[i].sig, vec[i].sig_len, vec[i].type) !=
+            ORIG_CHECK_ERR_SIGNATURE ||
+            OrigCheck_VerifyGeneric(vec[i].uid, vec[i].uid_len, vec[i].sig, vec[i].sig_len, vec[i].type) !=
+            ORIG_CHECK_ERR_SIGNATURE) {
+            (*pFailures)++;
+        }
+        /* A clone with UID 0 and the signature made from the public key */
+        memset(buf, 0, sizeof(buf));
+        if (OrigCheck_VerifyOriginality(buf, vec[i].uid_len, vec[i].forged, vec[i].sig_len, vec[i].type) !=
+            ORIG_CHECK_ERR_SIGNATURE ||
+            OrigCheck_VerifyGeneric(buf, vec[i].uid_len, vec[i].forged, vec[i].sig_len, vec[i].type) !=
+            ORIG_CHECK_ERR_SIGNATURE) {
+            (*pFailures)++;
+        }
+    }
+
+    memcpy(buf, s_orig_key128, sizeof(s_orig_key128));
+    buf[sizeof(s_orig_key128) - 1U] ^= 0x01U;
+    if (OrigCheck_SetPublicKey(ORIG_TAG_ICODE, buf, sizeof(s_orig_key128)) != ORIG_CHECK_ERR_PARAM) {
+        (*pFailures)++;
+    }
+
+    for (uint32_t i = 0; i < sizeof(vec) / sizeof(vec[0]); i++) {
+        cases += 7U;
+        if (OrigCheck_SetPublicKey(vec[i].type, vec[i].key, vec[i].key_len) != ORIG_CHECK_OK ||
+            OrigCheck_VerifyOriginality(vec[i].uid, vec[i].uid_len, vec[i].sig, vec[i].sig_len, vec[i].type) !=
+            ORIG_CHECK_OK ||
+            OrigCheck_VerifyGeneric(vec[i].uid, vec[i].uid_len, vec[i].sig, vec[i].sig_len, vec[i].type) !=
+            ORIG_CHECK_OK) {
+            (*pFailures)++;
+        }
+        /* One bit of r, one bit of s */
+        for (uint8_t half = 0; half < 2U; half++) {
+            memcpy(buf, vec[i].sig, vec[i].sig_len);
+            buf[half * (vec[i].sig_len / 2U) + 3U] ^= 0x10U;
+            if (OrigCheck_VerifyOriginality(vec[i].uid, vec[i].uid_len, buf, vec[i].sig_len, vec[i].type) !=
+                ORIG_CHECK_ERR_SIGNATURE ||
+                OrigCheck_VerifyGeneric(vec[i].uid, vec[i].uid_len, buf, vec[i].sig_len, vec[i].type) !=
+                ORIG_CHECK_ERR_SIGNATURE) {
+                (*pFailures)++;
+            }
+        }
+        /* Copied signature on another UID */
+        memcpy(buf, vec[i].uid, vec[i].uid_len);
+        buf[vec[i].uid_len - 1U] ^= 0x01U;
+        if (OrigCheck_VerifyOriginality(buf, vec[i].uid_len, vec[i].sig, vec[i].sig_len, vec[i].type) !=
+            ORIG_CHECK_ERR_SIGNATURE) {
+            (*pFailures)++;
+        }
+        /* r = 0, then r and s above n */
+        memset(buf, 0, sizeof(buf));
+        memcpy(&buf[vec[i].sig_len / 2U], vec[i].sig, vec[i].sig_len / 2U);
+        if (OrigCheck_VerifyOriginality(vec[i].uid, vec[i].uid_len, buf, vec[i].sig_len, vec[i].type) !=
+            ORIG_CHECK_ERR_SIGNATURE) {
+            (*pFailures)++;
+        }
+        memset(buf, 0xFF, sizeof(buf));
+        if (OrigCheck_VerifyOriginality(vec[i].uid, vec[i].uid_len, buf, vec[i].sig_len, vec[i].type) !=
+            ORIG_CHECK_ERR_SIGNATURE) {
+            (*pFailures)++;
+        }
+        if (OrigCheck_VerifyOriginality(vec[i].uid, vec[i].uid_len, vec[i].sig, (uint8_t)(vec[i].sig_len - 1U),
+                                        vec[i].type) != ORIG_CHECK_ERR_PARAM) {
+            (*pFailures)++;
+        }
+    }
+
+    /* Second presentation of a verified tag comes from the cache */
+    cases++;
+    OrigCheck_Init();
+    (void)OrigCheck_VerifyOriginality(vec[2].uid, vec[2].uid_len, vec[2].sig, vec[2].sig_len, vec[2].type);
+    (void)OrigCheck_VerifyOriginality(vec[2].uid, vec[2].uid_len, vec[2].sig, vec[2].sig_len, vec[2].type);
+    OrigCheck_GetStats(&stats);
+    if (stats.verified != 1U || stats.cache_hits != 1U) {
+        (*pFailures)++;
+    }
+    return cases;
+}
+
+/* Dump, skipped and changed pages, sector switching and the SRAM on every simulated profile */
+static uint32_t Bench_VerifyMfulBulk(uint32_t *pFailures)
+{
+    MfulBulk_Result_t result;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+    for (uint32_t p = 0; p < BENCH_UL_PROFILES_KNOWN; p++) {
+        uint16_t pages, requests = 0;
+        uint16_t first, last, mid;
+        uint8_t sram[MFUL_BULK_SRAM_SIZE];
+        phStatus_t status;
+
+        MfulBulk_ClearCache();
+        Bench_UlLoad(p);
+        pages = Bench_UlExpected(s_ul_new);
+        for (uint32_t sec = 0; sec < BENCH_UL_SECTORS; sec++) {
+            requests = (uint16_t)(requests + (s_ul->dump[sec] + 148U) / 149U);
+        }
+
+        /* First tap learns the layout, fewest FAST_READs, back in sector 0 */
+        cases += 2U;
+        status = MfulBulk_ReadAll(&s_mful, s_ul_uid, sizeof(s_ul_uid), s_ul_dump, (uint16_t)sizeof(s_ul_dump), &result);
+        if (status != PH_ERR_SUCCESS || result.cache_hit || strcmp(result.profile, s_ul->name) != 0 ||
+            result.pages != pages || result.bytes != pages * 4U || memcmp(s_ul_dump, s_ul_new, pages * 4U) != 0 ||
+            result.requests != requests || result.sector_selects != (s_ul->dump[1] ? 2U : 0U) || s_ul_sector != 0U) {
+            (*pFailures)++;
+        }
+        status = MfulBulk_ReadAll(&s_mful, s_ul_uid, sizeof(s_ul_uid), s_ul_dump, (uint16_t)sizeof(s_ul_dump), &result);
+        if (status != PH_ERR_SUCCESS || !result.cache_hit || s_ul_get_version != 1U ||
+            result.user_pages != s_ul->user_pages || result.user_first != 4U) {
+            (*pFailures)++;
+        }
+
+        /* Unchanged data is not written, three changed pages are, including one in sector 1 */
+        cases += 2U;
+        first = result.user_first;
+        last = (uint16_t)(first + result.user_pages - 1U);
+        mid = s_ul->dump[1] ? (uint16_t)(s_ul->dump[0] + 5U) : (uint16_t)(first + 5U);
+        status = MfulBulk_WriteRange(&s_mful, s_ul_uid, sizeof(s_ul_uid), first, &s_ul_new[first * 4U],
+                                     (uint16_t)(result.user_pages * 4U), &result);
+        if (status != PH_ERR_SUCCESS || result.pages_written != 0U || result.pages_skipped != s_ul->user_pages) {
+            (*pFailures)++;
+        }
+        s_ul_new[first * 4U] ^= 0xFFU;
+        s_ul_new[mid * 4U + 1U] ^= 0xFFU;
+        s_ul_new[last * 4U + 3U] ^= 0xFFU;
+        status = MfulBulk_WriteRange(&s_mful, s_ul_uid, sizeof(s_ul_uid), first, &s_ul_new[first * 4U],
+                                     (uint16_t)(result.user_pages * 4U), &result);
+        (void)Bench_UlExpected(s_ul_dump);
+        if (status != PH_ERR_SUCCESS || result.pages_written != 3U ||
+            result.pages_skipped != s_ul->user_pages - 3U || memcmp(s_ul_dump, s_ul_new, pages * 4U) != 0 ||
+            s_ul_sector != 0U) {
+            (*pFailures)++;
+        }
+
+        /* Header, past the user memory, partial page */
+        cases += 3U;
+        if (MfulBulk_WriteRange(&s_mful, s_ul_uid, sizeof(s_ul_uid), 3U, s_ul_new, 4U, &result) !=
+            PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_GENERIC)) {
+            (*pFailures)++;
+        }
+        if (MfulBulk_WriteRange(&s_mful, s_ul_uid, sizeof(s_ul_uid), last, s_ul_new, 8U, &result) !=
+            PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_GENERIC)) {
+            (*pFailures)++;
+        }
+        if (MfulBulk_WriteRange(&s_mful, s_ul_uid, sizeof(s_ul_uid), first, s_ul_new, 6U, &result) !=
+            PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_GENERIC)) {
+            (*pFailures)++;
+        }
+
+        /* FAST_WRITE only where the tag has it */
+        cases++;
+        for (uint32_t i = 0; i < sizeof(sram); i++) {
+            sram[i] = (uint8_t)(i + p);
+        }
+        status = MfulBulk_WriteSram(&s_mful, s_ul_uid, sizeof(s_ul_uid), sram, &result);
+        if (s_ul->sram ? (status != PH_ERR_SUCCESS || memcmp(s_ul_sram, sram, sizeof(sram)) != 0) :
+            (status != PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_GENERIC))) {
+            (*pFailures)++;
+        }
+    }
+
+    /* GET_VERSION reply without a layout */
+    cases++;
+    MfulBulk_ClearCache();
+    Bench_UlLoad(BENCH_UL_PROFILES - 1U);
+    if (MfulBulk_ReadAll(&s_mful, s_ul_uid, sizeof(s_ul_uid), s_ul_dump, (uint16_t)sizeof(s_ul_dump), &result) !=
+        PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_GENERIC)) {
+        (*pFailures)++;
+    }
+
+    MfulBulk_ClearCache();
+    Bench_T2T_Build();
+    return cases;
+}
+
+/* Learned programming time per block of the loaded VICC, 0 when not learned */
+static uint16_t Bench_ViccLearned(void)
+{
+    for (uint32_t i = 0; i < PH_NFCLIB_I15693_WRITE_TIMING_ENTRIES; i++) {
+        const phNfcLib_I15693_WriteTiming_t *e = &s_vicc_state.asI15693WriteTiming[i];
+        if (e->bValid && e->bMfgCode == s_vicc->uid[6] && e->bIcType == s_vicc->uid[5] && e->bIcRef == s_vicc->icref) {
+            return e->wBlockUs;
+        }
+    }
+    return 0;
+}
+
+static uint32_t Bench_VerifyI15693Write(uint32_t *pFailures)
+{
+    uint8_t data[4U * BENCH_V_BLOCK_SIZE];
+    uint32_t cases = 0;
+    uint16_t learned;
+    phStatus_t status;
+
+    *pFailures = 0;
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(0xA0U + i);
+    }
+
+    /* Fixed timing: one EOF after the long timeout */
+    cases++;
+    phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_FIXED);
+    Bench_ViccLoad(1, s_vicc_profiles[1].program_us);
+    status = Bench_ViccCmd(ISO15693_WriteSingleBlock, 1U, 7U, 1U, data);
+    if (status != PH_ERR_SUCCESS || s_vicc_eofs != 1U || s_vicc_us < 20060.0 ||
+        memcmp(&s_vicc_mem[7U * BENCH_V_BLOCK_SIZE], data, BENCH_V_BLOCK_SIZE) != 0 || Bench_ViccLearned() != 0U) {
+        (*pFailures)++;
+    }
+
+    phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_ADAPTIVE);
+    for (uint32_t p = 0; p < BENCH_VICC_PROFILES; p++) {
+        const uint16_t program_us = s_vicc_profiles[p].program_us;
+
+        /* IC reference from GetSystemInformation */
+        cases++;
+        Bench_ViccLoad(p, program_us);
+        status = Bench_ViccCmd(ISO15693_GetSystemInformation, 0U, 0U, 0U, NULL);
+        if (status != PH_ERR_SUCCESS || s_vicc_state.bI15693IcRef != s_vicc->icref) {
+            (*pFailures)++;
+        }
+
+        /* First write learns, at most one step above the programming time */
+        cases++;
+        data[0] = (uint8_t)p;
+        status = Bench_ViccCmd(ISO15693_WriteSingleBlock, 1U, 3U, 1U, data);
+        learned = Bench_ViccLearned();
+        if (status != PH_ERR_SUCCESS || learned < program_us ||
+            learned > program_us + 2000U ||
+            memcmp(&s_vicc_mem[3U * BENCH_V_BLOCK_SIZE], data, BENCH_V_BLOCK_SIZE) != 0) {
+            (*pFailures)++;
+        }
+
+        /* Later writes send one EOF, also for several blocks */
+        cases += 2U;
+        s_vicc_eofs = 0;
+        status = Bench_ViccCmd(ISO15693_WriteSingleBlock, 1U, 4U, 1U, data);
+        if (status != PH_ERR_SUCCESS || s_vicc_eofs != 1U || Bench_ViccLearned() != learned) {
+            (*pFailures)++;
+        }
+        s_vicc_eofs = 0;
+        status = Bench_ViccCmd(ISO15693_WriteMultipleBlocks, 1U, 8U, 4U, data);
+        if (status != PH_ERR_SUCCESS || s_vicc_eofs != 1U ||
+            memcmp(&s_vicc_mem[8U * BENCH_V_BLOCK_SIZE], data, sizeof(data)) != 0) {
+            (*pFailures)++;
+        }
+
+        /* Without the option flag the tag answers when done, no EOF */
+        cases++;
+        s_vicc_eofs = 0;
+        status = Bench_ViccCmd(ISO15693_WriteSingleBlock, 0U, 5U, 1U, data);
+        if (status != PH_ERR_SUCCESS || s_vicc_eofs != 0U) {
+            (*pFailures)++;
+        }
+    }
+
+    /* The other IC types kept their own times */
+    cases++;
+    Bench_ViccLoad(0, s_vicc_profiles[0].program_us);
+    (void)Bench_ViccCmd(ISO15693_GetSystemInformation, 0U, 0U, 0U, NULL);
+    if (Bench_ViccLearned() == 0U || Bench_ViccCmd(ISO15693_WriteSingleBlock, 1U, 6U, 1U, data) != PH_ERR_SUCCESS ||
+        s_vicc_eofs != 1U) {
+        (*pFailures)++;
+    }
+
+    /* Tag of a learned type programming slower: probed again and the time raised */
+    cases++;
+    Bench_ViccLoad(1, s_vicc_profiles[1].program_us);
+    learned = Bench_ViccLearned();
+    Bench_ViccLoad(1, (uint16_t)(learned + 2500U));
+    (void)Bench_ViccCmd(ISO15693_GetSystemInformation, 0U, 0U, 0U, NULL);
+    s_vicc_eofs = 0;
+    if (Bench_ViccCmd(ISO15693_WriteSingleBlock, 1U, 10U, 1U, data) != PH_ERR_SUCCESS || s_vicc_eofs < 2U ||
+        Bench_ViccLearned() < learned + 2500U) {
+        (*pFailures)++;
+    }
+
+    /* Slower than the fixed timing allows: both give up with the timeout, nothing learned */
+    cases += 2U;
+    phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_FIXED);
+    Bench_ViccLoad(2, BENCH_VICC_SLOW_US);
+    if ((Bench_ViccCmd(ISO15693_WriteSingleBlock, 1U, 9U, 1U, data) & PH_ERR_MASK) != PH_ERR_IO_TIMEOUT) {
+        (*pFailures)++;
+    }
+    phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_ADAPTIVE);
+    Bench_ViccLoad(2, BENCH_VICC_SLOW_US);
+    if ((Bench_ViccCmd(ISO15693_WriteSingleBlock, 1U, 9U, 1U, data) & PH_ERR_MASK) != PH_ERR_IO_TIMEOUT ||
+        Bench_ViccLearned() != 0U) {
+        (*pFailures)++;
+    }
+
+    phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_FIXED);
+    return cases;
+}
+
+static uint32_t Bench_VerifyBootProf(uint32_t *pFailures)
+{
+    const BootProf_Record_t *cur = BootProf_Current();
+    BootProf_Record_t first;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+
+    /* Power-on: nothing retained, only the time origin is stamped */
+    cases++;
+    BootProf_Clear();
+    s_boot_cyc = 0;
+    s_boot_hz = BENCH_BOOT_MSI_HZ;
+    BootProf_Start(0U);
+    if (BootProf_Previous() != NULL || cur->boot_count != 1U || BootProf_PhaseUs(cur, BOOT_PHASE_MAIN) != 0U ||
+        BootProf_PhaseUs(cur, BOOT_PHASE_HAL_INIT) != BOOT_PROF_NOT_REACHED) {
+        (*pFailures)++;
+    }
+
+    /* Each interval counts at the clock of its start: 4000 cycles at 4 MHz, then 500 us at 80 MHz */
+    cases++;
+    s_boot_cyc += 4000U;
+    BootProf_Mark(BOOT_PHASE_HAL_INIT);
+    s_boot_hz = BENCH_BOOT_SYSCLK_HZ;
+    BootProf_Mark(BOOT_PHASE_CLOCK);
+    s_boot_cyc += 80U * 500U;
+    BootProf_Mark(BOOT_PHASE_PERIPH);
+    if (cur->t_us[BOOT_PHASE_HAL_INIT] != 1000U || BootProf_PhaseUs(cur, BOOT_PHASE_CLOCK) != 0U ||
+        BootProf_PhaseUs(cur, BOOT_PHASE_PERIPH) != 500U) {
+        (*pFailures)++;
+    }
+
+    /* Cycles below one microsecond carry over to the next mark */
+    cases++;
+    s_boot_cyc += 40U;
+    BootProf_Mark(BOOT_PHASE_BANNER);
+    s_boot_cyc += 40U;
+    BootProf_Mark(BOOT_PHASE_BEEP);
+    if (cur->t_us[BOOT_PHASE_BANNER] != 1500U || cur->t_us[BOOT_PHASE_BEEP] != 1501U) {
+        (*pFailures)++;
+    }
+
+    /* A phase keeps its first stamp, an out of range phase is ignored */
+    cases++;
+    s_boot_cyc += 80U * 100U;
+    BootProf_Mark(BOOT_PHASE_PERIPH);
+    BootProf_Mark(BOOT_PHASE_COUNT);
+    if (cur->t_us[BOOT_PHASE_PERIPH] != 1500U || strcmp(BootProf_PhaseName(BOOT_PHASE_COUNT), "?") != 0) {
+        (*pFailures)++;
+    }
+
+    /* A skipped phase: the next one is measured from the last stamp before it */
+    cases++;
+    BootProf_Mark(BOOT_PHASE_NFCLIB);
+    if (BootProf_PhaseUs(cur, BOOT_PHASE_BAL) != BOOT_PROF_NOT_REACHED ||
+        BootProf_PhaseUs(cur, BOOT_PHASE_NFCLIB) != 100U) {
+        (*pFailures)++;
+    }
+
+    /* Warm reset: the record moves to the previous boot, the cycle counter may wrap during a phase */
+    cases++;
+    first = *cur;
+    s_boot_cyc = 0xFFFFFFFFU - 80U * 50U;
+    s_boot_hz = BENCH_BOOT_SYSCLK_HZ;
+    BootProf_Start(1U);
+    s_boot_cyc += 80U * 120U;
+    BootProf_Mark(BOOT_PHASE_HAL_INIT);
+    if (BootProf_Previous() == NULL || memcmp(BootProf_Previous(), &first, sizeof(first)) != 0 ||
+        cur->boot_count != 2U || cur->fast != 1U || cur->t_us[BOOT_PHASE_HAL_INIT] != 120U) {
+        (*pFailures)++;
+    }
+
+    /* A record damaged across the reset counts as power-on */
+    cases++;
+    ((BootProf_Record_t *)cur)->t_us[BOOT_PHASE_HAL_INIT] ^= 1U;
+    BootProf_Start(0U);
+    if (BootProf_Previous() != NULL || cur->boot_count != 1U) {
+        (*pFailures)++;
+    }
+
+    /* BOOT_FAST on the boot model: every phase stamped, the fast boot reaches the poll loop first */
+    cases++;
+    BootProf_Clear();
+    Bench_BootRun(0U);
+    Bench_BootRun(1U);
+    {
+        const BootProf_Record_t *prev = BootProf_Previous();
+        uint8_t all = 1U;
+
+        for (uint8_t i = 0; i < (uint8_t)BOOT_PHASE_COUNT; i++) {
+            if (cur->t_us[i] == BOOT_PROF_NOT_REACHED || prev == NULL || prev->t_us[i] == BOOT_PROF_NOT_REACHED) {
+                all = 0U;
+            }
+        }
+        if (!all || prev->fast != 0U || cur->t_us[BOOT_PHASE_FIRST_POLL] >= prev->t_us[BOOT_PHASE_FIRST_POLL]) {
+            (*pFailures)++;
+        }
+    }
+    return cases;
+}
+
+static uint32_t Bench_VerifyFeedback(uint32_t *pFailures)
+{
+    static const Bench_FbEdge_t boot[] = { { 0, FEEDBACK_OUT_ON }, { 300, FEEDBACK_OUT_OFF } };
+    static const Bench_FbEdge_t success[] = {
+        { 0, FEEDBACK_OUT_ON }, { 200, FEEDBACK_OUT_OFF }, { 400, FEEDBACK_OUT_ON }, { 600, FEEDBACK_OUT_OFF }
+    };
+    static const Bench_FbEdge_t failure[] = {
+        { 0, FEEDBACK_OUT_ON }, { 100, FEEDBACK_OUT_OFF }, { 200, FEEDBACK_OUT_ON }, { 300, FEEDBACK_OUT_OFF },
+        { 400, FEEDBACK_OUT_ON }, { 500, FEEDBACK_OUT_OFF }
+    };
+    static const Bench_FbEdge_t too_slow[] = {
+        { 0, FEEDBACK_OUT_ON }, { 60, FEEDBACK_OUT_OFF }, { 120, FEEDBACK_OUT_ON }, { 180, FEEDBACK_OUT_OFF },
+        { 240, FEEDBACK_OUT_ON }, { 640, FEEDBACK_OUT_OFF }
+    };
+    static const Bench_FbEdge_t remove_card[] = {
+        { 0, FEEDBACK_OUT_ON }, { 80, FEEDBACK_OUT_OFF }, { 1000, FEEDBACK_OUT_ON }, { 1080, FEEDBACK_OUT_OFF },
+        { 2000, FEEDBACK_OUT_ON }, { 2080, FEEDBACK_OUT_OFF }, { 3000, FEEDBACK_OUT_ON }, { 3080, FEEDBACK_OUT_OFF }
+    };
+    /* Failure cut off in its first gap, success runs from the preemption on */
+    static const Bench_FbEdge_t preempt_gap[] = {
+        { 0, FEEDBACK_OUT_ON }, { 100, FEEDBACK_OUT_OFF }, { 150, FEEDBACK_OUT_ON }, { 350, FEEDBACK_OUT_OFF },
+        { 550, FEEDBACK_OUT_ON }, { 750, FEEDBACK_OUT_OFF }
+    };
+    /* Remove-card cut off while on: no extra edge, the new first step lasts its full length */
+    static const Bench_FbEdge_t preempt_on[] = {
+        { 0, FEEDBACK_OUT_ON }, { 240, FEEDBACK_OUT_OFF }, { 440, FEEDBACK_OUT_ON }, { 640, FEEDBACK_OUT_OFF }
+    };
+    static const struct {
+        Feedback_Pattern_t pattern;
+        const Bench_FbEdge_t *edges;
+        uint32_t n;
+    } once[] = {
+        { FEEDBACK_BOOT, boot, 2 },
+        { FEEDBACK_SUCCESS, success, 4 },
+        { FEEDBACK_FAILURE, failure, 6 },
+        { FEEDBACK_TOO_SLOW, too_slow, 6 }
+    };
+    const Feedback_Stats_t *st = Feedback_GetStats();
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+
+    /* Init: idle, outputs off, timer stopped */
+    cases++;
+    Bench_FbReset();
+    if (Feedback_Current() != FEEDBACK_NONE || s_fb_out != FEEDBACK_OUT_OFF || s_fb_armed || st->plays != 0U) {
+        (*pFailures)++;
+    }
+
+    /* One-shot patterns: every edge on time, one interrupt per edge after the first, timer stopped at the end */
+    for (uint32_t i = 0; i < sizeof(once) / sizeof(once[0]); i++) {
+        cases++;
+        Bench_FbReset();
+        Feedback_Play(once[i].pattern);
+        Bench_FbAdvance(5000U);
+        if (!Bench_FbLogIs(once[i].edges, once[i].n) || Feedback_Current() != FEEDBACK_NONE || s_fb_armed ||
+            st->edges != once[i].n - 1U || st->completed != 1U ||
+            Feedback_PatternMs(once[i].pattern) != once[i].edges[once[i].n - 1U].t_ms) {
+            (*pFailures)++;
+        }
+    }
+
+    /* Remove-card repeats until stopped, the stop switches the outputs off */
+    cases++;
+    Bench_FbReset();
+    Feedback_Play(FEEDBACK_REMOVE_CARD);
+    Bench_FbAdvance(3500U);
+    if (!Bench_FbLogIs(remove_card, 8) || Feedback_Current() != FEEDBACK_REMOVE_CARD || !s_fb_armed ||
+        Feedback_PatternMs(FEEDBACK_REMOVE_CARD) != 1000U) {
+        (*pFailures)++;
+    }
+    cases++;
+    Feedback_Stop();
+    Bench_FbAdvance(3000U);
+    if (Feedback_Current() != FEEDBACK_NONE || s_fb_armed || s_fb_log_n != 8U || st->preempted != 1U ||
+        st->completed != 0U) {
+        (*pFailures)++;
+    }
+
+    /* Preemption in a gap: the old deadline is dropped, the new pattern starts at once */
+    cases++;
+    Bench_FbReset();
+    Feedback_Play(FEEDBACK_FAILURE);
+    Bench_FbAdvance(150U);
+    Feedback_Play(FEEDBACK_SUCCESS);
+    Bench_FbAdvance(5000U);
+    if (!Bench_FbLogIs(preempt_gap, 6) || st->plays != 2U || st->preempted != 1U || st->completed != 1U) {
+        (*pFailures)++;
+    }
+
+    /* Preemption while on */
+    cases++;
+    Bench_FbReset();
+    Feedback_Play(FEEDBACK_REMOVE_CARD);
+    Bench_FbAdvance(40U);
+    Feedback_Play(FEEDBACK_SUCCESS);
+    Bench_FbAdvance(5000U);
+    if (!Bench_FbLogIs(preempt_on, 4) || Feedback_Current() != FEEDBACK_NONE) {
+        (*pFailures)++;
+    }
+
+    /* Out of range pattern stops, a late interrupt while idle is ignored */
+    cases++;
+    Bench_FbReset();
+    Feedback_Play(FEEDBACK_BOOT);
+    Feedback_Play(FEEDBACK_COUNT);
+    Feedback_OnTimer();
+    if (Feedback_Current() != FEEDBACK_NONE || s_fb_out != FEEDBACK_OUT_OFF || s_fb_armed || st->edges != 0U ||
+        Feedback_PatternMs(FEEDBACK_NONE) != 0U) {
+        (*pFailures)++;
+    }
+    return cases;
+}
+
+static uint32_t Bench_VerifyEmvResume(uint32_t *pFailures)
+{
+    const EMV_Resume_Stats_t *st = EMV_Resume_GetStats();
+    EMV_Resume_Stats_t before;
+    uint32_t full_apdus, full_reads;
+    uint16_t torn_atc;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+
+    /* Clean tap: the reference, nothing kept */
+    cases++;
+    Bench_RsCardReset();
+    before = *st;
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || !Bench_RsRecordsComplete() ||
+        st->saved != before.saved || s_rs.resumed) {
+        (*pFailures)++;
+    }
+    full_apdus = s_rs.apdus;
+    full_reads = s_rs.reads;
+
+    /* Tear after three records and a miss: the re-tap reads only the rest, GPO is sent again */
+    cases++;
+    Bench_RsCardReset();
+    before = *st;
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    torn_atc = s_rs_atc;
+    s_rs_now_ms += BENCH_RS_RETAP_MS;
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || !s_rs.resumed || !Bench_RsRecordsComplete() ||
+        st->saved != before.saved + 1U || st->resumed != before.resumed + 1U ||
+        st->records_reused != before.records_reused + 3U || s_rs.reads != full_reads - 3U ||
+        s_rs.apdus != full_apdus - 2U - 3U || s_rs_atc != torn_atc + 1U ||
+        s_rs_ctx.card_data.gpo_data[24] != (uint8_t)s_rs_atc) {
+        (*pFailures)++;
+    }
+
+    /* Re-tap after the window: full flow */
+    cases++;
+    Bench_RsCardReset();
+    before = *st;
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    s_rs_now_ms += EMV_RESUME_WINDOW_MS + 1U;
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || s_rs.resumed || s_rs.apdus != full_apdus ||
+        st->expired != before.expired + 1U) {
+        (*pFailures)++;
+    }
+
+    /* Other amount, other card: dropped, full flow */
+    cases++;
+    Bench_RsCardReset();
+    before = *st;
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    s_rs_card.amount++;
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || s_rs.resumed || s_rs.apdus != full_apdus) {
+        (*pFailures)++;
+    }
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    s_rs_card.uid_variant = 1U;
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || s_rs.resumed || s_rs.apdus != full_apdus ||
+        st->mismatched != before.mismatched + 2U) {
+        (*pFailures)++;
+    }
+
+    /* Other label, same AID and PDOL: the FCI around them is not compared */
+    cases++;
+    Bench_RsCardReset();
+    before = *st;
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    s_rs_card.label_variant = 1U;
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || !s_rs.resumed || s_rs.reads != full_reads - 3U ||
+        !Bench_RsRecordsComplete() || st->resumed != before.resumed + 1U) {
+        (*pFailures)++;
+    }
+
+    /* Other PDOL: the direct SELECT is wasted, PPSE and a full read follow */
+    cases++;
+    Bench_RsCardReset();
+    before = *st;
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    s_rs_card.pdol_variant = 1U;
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || !s_rs.resumed || s_rs.apdus != full_apdus + 1U ||
+        !Bench_RsRecordsComplete() || st->resumed != before.resumed || st->mismatched != before.mismatched + 1U) {
+        (*pFailures)++;
+    }
+
+    /* Other AIP: nothing reused */
+    cases++;
+    Bench_RsCardReset();
+    before = *st;
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    s_rs_card.aip_variant = 0x40U;
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || s_rs.reads != full_reads ||
+        !Bench_RsRecordsComplete() || st->resumed != before.resumed) {
+        (*pFailures)++;
+    }
+
+    /* Tear at INTERNAL AUTHENTICATE: SELECT, GPO, INTERNAL AUTHENTICATE, no READ RECORD */
+    cases++;
+    Bench_RsCardReset();
+    (void)Bench_RsTap(EMV_STATE_OFFLINE_DATA_AUTH, 0);
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || s_rs.apdus != 3U || s_rs.reads != 0U ||
+        !Bench_RsRecordsComplete()) {
+        (*pFailures)++;
+    }
+
+    /* Random UID: the PAN record is read again before anything is reused */
+    cases++;
+    Bench_RsCardReset();
+    s_rs_card.random_uid = 1U;
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || !s_rs.resumed || s_rs.reads != full_reads - 2U ||
+        !Bench_RsRecordsComplete()) {
+        (*pFailures)++;
+    }
+
+    /* Random UID, another PAN behind it: dropped after the one READ RECORD */
+    cases++;
+    Bench_RsCardReset();
+    s_rs_card.random_uid = 1U;
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    s_rs_card.pan_variant = 1U;
+    before = *st;
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || s_rs.reads != full_reads + 1U ||
+        !Bench_RsRecordsComplete() || st->resumed != before.resumed || st->mismatched != before.mismatched + 1U) {
+        (*pFailures)++;
+    }
+
+    /* Random UID and records without a PAN: not trusted */
+    cases++;
+    Bench_RsCardReset();
+    s_rs_card.random_uid = 1U;
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    memmove(s_rs_ctx.card_data.sfi_records[0], s_rs_ctx.card_data.sfi_records[1], 256);
+    s_rs_ctx.card_data.sfi_record_lens[0] = s_rs_ctx.card_data.sfi_record_lens[1];
+    EMV_Resume_Clear();
+    EMV_Resume_Save(&s_rs_ctx, s_rs_now_ms);
+    s_rs_ctx.card_data.card_uid[1]++;
+    if (EMV_Resume_Lookup(&s_rs_ctx.card_data, s_rs_now_ms) || EMV_Resume_FailedState() != EMV_STATE_IDLE) {
+        (*pFailures)++;
+    }
+
+    /* Tear in application selection, after the PPSE and after the refused AID: one SELECT of the directory AID */
+    for (uint8_t after = 1U; after <= 2U; after++) {
+        cases++;
+        Bench_RsCardReset();
+        before = *st;
+        (void)Bench_RsTap(EMV_STATE_APP_SELECTION, after);
+        s_rs_now_ms += BENCH_RS_RETAP_MS;
+        if (st->saved != before.saved + 1U || EMV_Resume_FailedState() != EMV_STATE_APP_SELECTION ||
+            Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || !s_rs.resumed || s_rs.apdus != full_apdus - 2U ||
+            s_rs.reads != full_reads || !Bench_RsRecordsComplete() || st->resumed != before.resumed + 1U ||
+            st->records_reused != before.records_reused) {
+            (*pFailures)++;
+        }
+    }
+
+    /* The resumed tap torn again at GPO: the entry now has the SELECT, the third tap still skips the PPSE */
+    cases++;
+    Bench_RsCardReset();
+    before = *st;
+    (void)Bench_RsTap(EMV_STATE_APP_SELECTION, 1U);
+    (void)Bench_RsTap(EMV_STATE_APP_INITIALIZATION, 0);
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || !s_rs.resumed || s_rs.apdus != full_apdus - 2U ||
+        st->saved != before.saved + 2U || EMV_Resume_FailedState() != EMV_STATE_IDLE) {
+        (*pFailures)++;
+    }
+
+    /* Tear before the PPSE answered: nothing kept; on a resuming re-tap the entry is kept with a new stamp */
+    cases++;
+    Bench_RsCardReset();
+    before = *st;
+    (void)Bench_RsTap(EMV_STATE_APP_SELECTION, 0);
+    if (st->saved != before.saved || EMV_Resume_FailedState() != EMV_STATE_IDLE) {
+        (*pFailures)++;
+    }
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 4U);
+    s_rs_now_ms += EMV_RESUME_WINDOW_MS - 100U;
+    (void)Bench_RsTap(EMV_STATE_APP_SELECTION, 0);
+    s_rs_now_ms += EMV_RESUME_WINDOW_MS - 100U;
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || !s_rs.resumed ||
+        st->saved != before.saved + 1U || s_rs.reads != full_reads - 3U) {
+        (*pFailures)++;
+    }
+
+    /* Torn again further on: the entry grows, the third tap reads nothing */
+    cases++;
+    Bench_RsCardReset();
+    (void)Bench_RsTap(EMV_STATE_READ_APP_DATA, 2U);
+    (void)Bench_RsTap(EMV_STATE_OFFLINE_DATA_AUTH, 0);
+    if (Bench_RsTap(EMV_STATE_IDLE, 0) != EMV_STATE_SUCCESS || s_rs.reads != 0U || !Bench_RsRecordsComplete() ||
+        EMV_Resume_FailedState() != EMV_STATE_IDLE) {
+        (*pFailures)++;
+    }
+    Bench_RsCardReset();
+    return cases;
+}
+
+static uint32_t Bench_LbHistSum(const uint16_t *hist, uint32_t bins)
+{
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < bins; i++) {
+        n += hist[i];
+    }
+    return n;
+}
+
+/* One clean session with the faults of script[] at reader frames at[] */
+static uint8_t Bench_LbScripted(const uint8_t *at, const uint8_t *faults, uint32_t n)
+{
+    Bench_LbReset(&s_lb_profiles[0]);
+    for (uint32_t i = 0; i < n; i++) {
+        s_lb_script[at[i]] = faults[i];
+    }
+    return Bench_LbSession();
+}
+
+static uint32_t Bench_VerifyEmvcoAnalyzer(uint32_t *pFailures)
+{
+    static const uint8_t at_one[] = { 4U };
+    static const uint8_t at_three[] = { 4U, 5U, 6U };
+    static const uint8_t slow[] = { BENCH_LB_F_SLOW };
+    static const uint8_t wtx[] = { BENCH_LB_F_WTX };
+    static const uint8_t lose_resp[] = { BENCH_LB_F_LOSE_RESP };
+    static const uint8_t lose_cmd[] = { BENCH_LB_F_LOSE_CMD };
+    static const uint8_t corrupt[] = { BENCH_LB_F_CORRUPT };
+    static const uint8_t lose_three[] = { BENCH_LB_F_LOSE_CMD, BENCH_LB_F_LOSE_CMD, BENCH_LB_F_LOSE_CMD };
+    const EmvcoAnalyzer_Window_t *w = EmvcoAnalyzer_Window();
+    const uint32_t clean = BENCH_LB_APDUS + 1U;
+    EmvcoAnalyzer_Window_t parsed;
+    uint16_t hist[EMVCO_ANALYZER_RTT_BINS];
+    uint8_t frame[EMVCO_ANALYZER_FRAME_LEN];
+    uint16_t seq, value = 0;
+    uint32_t period_ms;
+    double sum = 0.0, lo = 1e12, hi = 0.0;
+    uint8_t *resp;
+    uint16_t resp_len;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+
+    /* Clean session: PPSE and the loopback commands up to EOT, no protocol event, one RF reset */
+    cases++;
+    if (!Bench_LbScripted(NULL, NULL, 0) || s_lb_card.mismatches != 0U || w->exchanges != clean ||
+        w->errors != 0U || w->wtx != 0U || w->naks != 0U || w->retransmits != 0U || w->loopbacks != 1U ||
+        w->rf_resets != 1U || w->wtx_hist[0] != clean || w->retry_hist[0] != clean ||
+        w->tx_bytes + w->rx_bytes != s_lb_run.bytes) {
+        (*pFailures)++;
+    }
+
+    /* RTT from the cycle counter: min, max, sum and log2 bins as the simulated round trips */
+    cases++;
+    memset(hist, 0, sizeof(hist));
+    for (uint32_t i = 0; i < s_lb_run.rtt_n; i++) {
+        uint32_t us = (uint32_t)s_lb_run.rtt_us[i];
+        uint32_t bin = 0;
+
+        while (bin < EMVCO_ANALYZER_RTT_BINS - 1U && us >= (128U << (bin + 1U))) {
+            bin++;
+        }
+        hist[bin]++;
+        sum += s_lb_run.rtt_us[i];
+        lo = (s_lb_run.rtt_us[i] < lo) ? s_lb_run.rtt_us[i] : lo;
+        hi = (s_lb_run.rtt_us[i] > hi) ? s_lb_run.rtt_us[i] : hi;
+    }
+    if (memcmp(hist, w->rtt_hist, sizeof(hist)) != 0 || fabs(w->rtt_sum_us - sum) > clean ||
+        fabs(w->rtt_min_us - lo) > 1.0 || fabs(w->rtt_max_us - hi) > 1.0 || w->rtt_min_us < BENCH_LB_CARD_US) {
+        (*pFailures)++;
+    }
+
+    /* Injected latency below FWT: one slow round trip, no recovery */
+    cases++;
+    if (!Bench_LbScripted(at_one, slow, 1) || w->exchanges != clean || w->naks != 0U ||
+        w->rtt_max_us < BENCH_LB_CARD_US + BENCH_LB_SLOW_US || w->rtt_hist[7] != 1U) {
+        (*pFailures)++;
+    }
+
+    /* S(WTX): answered once, the exchange takes the two card delays, the PAL counter is taken */
+    cases++;
+    if (!Bench_LbScripted(at_one, wtx, 1) || w->exchanges != clean || w->wtx != 1U || w->wtx_hist[1] != 1U ||
+        w->naks != 0U || w->errors != 0U || w->rtt_max_us < 2.0 * BENCH_LB_WTX_US ||
+        phpalI14443p4_GetConfig(&s_lb_pal, PHPAL_I14443P4_CONFIG_STAT_WTX, &value) != PH_ERR_SUCCESS || value != 0U) {
+        (*pFailures)++;
+    }
+
+    /* Response lost: R(NAK), the card sends its last block again (rule 11) */
+    cases++;
+    if (!Bench_LbScripted(at_one, lose_resp, 1) || s_lb_card.mismatches != 0U || w->exchanges != clean ||
+        w->naks != 1U || w->retransmits != 0U || w->retry_hist[1] != 1U || w->errors != 0U ||
+        w->rtt_max_us < BENCH_LB_FWT_US) {
+        (*pFailures)++;
+    }
+
+    /* Command lost: R(NAK), R(ACK) from the card (rule 12), the I-Block is sent again (rule 6) */
+    cases++;
+    if (!Bench_LbScripted(at_one, lose_cmd, 1) || s_lb_card.mismatches != 0U || w->exchanges != clean ||
+        w->naks != 1U || w->retransmits != 1U || w->retry_hist[2] != 1U || w->errors != 0U) {
+        (*pFailures)++;
+    }
+
+    /* CRC error on the response: handled as a lost response */
+    cases++;
+    if (!Bench_LbScripted(at_one, corrupt, 1) || w->exchanges != clean || w->naks != 1U ||
+        w->retransmits != 0U || w->errors != 0U) {
+        (*pFailures)++;
+    }
+
+    /* Command and both R(NAK) lost: EMVCo gives up after two R(NAK), the loopback ends, RF reset */
+    cases++;
+    if (Bench_LbScripted(at_three, lose_three, 3) || w->exchanges != 5U || w->errors != 1U || w->naks != 2U ||
+        w->retry_hist[2] != 1U || w->rf_resets != 1U || w->loopbacks != 1U) {
+        (*pFailures)++;
+    }
+
+    /* Summary frame: fixed length, decoded by the host to the same window */
+    cases++;
+    if (EmvcoAnalyzer_BuildSummary(frame, (uint16_t)(sizeof(frame) - 1U)) != 0U ||
+        EmvcoAnalyzer_BuildSummary(frame, (uint16_t)sizeof(frame)) != EMVCO_ANALYZER_FRAME_LEN ||
+        !Bench_LbParse(frame, EMVCO_ANALYZER_FRAME_LEN, &parsed, &seq, &period_ms) ||
+        memcmp(&parsed, w, sizeof(parsed)) != 0 || seq != 0U || period_ms != EmvcoAnalyzer_HostMs()) {
+        (*pFailures)++;
+    }
+
+    /* Periodic summaries: one per EMVCO_ANALYZER_REPORT_MS, nothing lost between windows */
+    cases++;
+    Bench_LbReset(&s_lb_profiles[0]);
+    while (s_lb_us < 3.5 * 1000.0 * EMVCO_ANALYZER_REPORT_MS) {
+        (void)Bench_LbSession();
+    }
+    if (s_lb_frames != 3U || !Bench_LbParse(s_lb_frame, s_lb_frame_len, &parsed, &seq, &period_ms) ||
+        seq != 2U || EmvcoAnalyzer_Sequence() != 3U || period_ms < EMVCO_ANALYZER_REPORT_MS ||
+        period_ms > EMVCO_ANALYZER_REPORT_MS + 400U || s_lb_sent.exchanges + w->exchanges != s_lb_run.exchanges ||
+        Bench_LbHistSum(parsed.rtt_hist, EMVCO_ANALYZER_RTT_BINS) != parsed.exchanges) {
+        (*pFailures)++;
+    }
+
+    /* PAL statistics without the analyzer: loaded by SetConfig, saturated, retransmission counted */
+    cases++;
+    Bench_LbReset(&s_lb_profiles[0]);
+    (void)Bench_LbActivate();
+    s_lb_script[0] = BENCH_LB_F_LOSE_CMD;
+    s_lb_script[1] = BENCH_LB_F_LOSE_CMD;
+    (void)phpalI14443p4_SetConfig(&s_lb_pal, PHPAL_I14443P4_CONFIG_STAT_NAK, 0xFFFEU);
+    if (phpalI14443p4_Exchange(&s_lb_pal, PH_EXCHANGE_DEFAULT, s_data, 8U, &resp, &resp_len) != PH_ERR_SUCCESS ||
+        phpalI14443p4_GetConfig(&s_lb_pal, PHPAL_I14443P4_CONFIG_STAT_NAK, &value) != PH_ERR_SUCCESS ||
+        value != 0xFFFFU ||
+        phpalI14443p4_GetConfig(&s_lb_pal, PHPAL_I14443P4_CONFIG_STAT_RETRANSMIT, &value) != PH_ERR_SUCCESS ||
+        value != 1U ||
+        phpalI14443p4_SetConfig(&s_lb_pal, PHPAL_I14443P4_CONFIG_STAT_NAK, 5U) != PH_ERR_SUCCESS ||
+        phpalI14443p4_GetConfig(&s_lb_pal, PHPAL_I14443P4_CONFIG_STAT_NAK, &value) != PH_ERR_SUCCESS ||
+        value != 5U) {
+        (*pFailures)++;
+    }
+
+    Bench_LbReset(&s_lb_profiles[0]);
+    return cases;
+}
+
+static uint32_t Bench_VerifyEmvSched(uint32_t *pFailures)
+{
+    static uint8_t big[1000];
+    Bench_OvTap_t tap;
+    uint32_t dropped;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+
+    /* Inactive uplink leaves the UART to the caller */
+    cases++;
+    if (EMV_Uplink_PutChar('x') != 0) {
+        (*pFailures)++;
+    }
+
+    /* Every record reaches the host intact and in order, overlapped with the reads */
+    cases++;
+    Bench_OvTap(0U, &tap);
+    if (tap.errors != 0U || tap.frames != BENCH_OV_RECORDS || tap.dropped != 0U ||
+        Bench_OvHostFrames() != BENCH_OV_RECORDS || tap.total_us >= tap.serial_us) {
+        (*pFailures)++;
+    }
+
+    /* Debug text between the frames never splits one */
+    cases++;
+    Bench_OvTap(1U, &tap);
+    if (tap.errors != 0U || tap.frames != BENCH_OV_RECORDS || Bench_OvHostFrames() != BENCH_OV_RECORDS ||
+        s_ov_host_len <= tap.frames * 9U) {
+        (*pFailures)++;
+    }
+
+    /* Full ring: the frame is dropped whole, nothing waits for the UART; short text still fits */
+    cases++;
+    (void)Bench_OvActivate();
+    memset(big, 0x5A, sizeof(big));
+    dropped = EMV_Uplink_Dropped();
+    EMV_Uplink_Start();
+    if (EMV_Uplink_Queue(big, sizeof(big)) != sizeof(big) || EMV_Uplink_Queue(big, 100U) != 0U ||
+        EMV_Uplink_Dropped() != dropped + 1U || EMV_Uplink_PutChar('x') != 1 || s_ov_us != 0.0) {
+        (*pFailures)++;
+    }
+    EMV_Uplink_Flush();
+    if (s_ov_host_len != sizeof(big) + 1U || s_ov_host[sizeof(big)] != (uint8_t)'x' ||
+        EMV_Uplink_Queue(big, 1U) != 0U) {
+        (*pFailures)++;
+    }
+
+    return cases;
+}
+
+static uint32_t Bench_VerifyMultiReader(uint32_t *pFailures)
+{
+    const uint32_t all = (1U << PHDRIVER_READER_COUNT) - 1U;
+    uint32_t mask = 0;
+    uint32_t field_ons;
+    double t0;
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+
+    /* Every reader comes up with its field off */
+    cases++;
+    if (Bench_MrSetup(0U) != PH_ERR_SUCCESS || s_mr.field_ons != 0U || s_mr_sel != 0U || pHal != &s_mr_hal[0]) {
+        (*pFailures)++;
+    }
+
+    /* One round probes all rested readers at once: about one guard time, not one per reader */
+    cases++;
+    s_mr_us += 10000.0;
+    t0 = s_mr_us;
+    if (MultiReader_PollRound(Bench_MrCard) != 0U || s_mr.field_ons != PHDRIVER_READER_COUNT ||
+        s_mr.wupas != PHDRIVER_READER_COUNT || s_mr_us - t0 > (MULTI_READER_GUARD_MS + 1U) * 1000.0) {
+        (*pFailures)++;
+    }
+
+    /* A reader whose field was just switched off sits the next round out */
+    cases++;
+    field_ons = s_mr.field_ons;
+    if (MultiReader_PollRound(Bench_MrCard) != 0U || s_mr.field_ons != field_ons) {
+        (*pFailures)++;
+    }
+
+    /* Cards on readers 1 and 3 are activated there and reported with their own discovery loop */
+    cases++;
+    (void)Bench_MrSetup(0x0AU);
+    for (uint32_t k = 0; k < 4U && mask == 0U; k++) {
+        s_mr_us += 10000.0;
+        mask = MultiReader_PollRound(Bench_MrCard);
+    }
+    if (mask != 0x0AU || s_mr_cb_mask != 0x0AU || s_mr.runs != 2U) {
+        (*pFailures)++;
+    }
+
+    /* Every MULTI_READER_FULL_POLL_ROUNDS round runs the full discovery loop on each reader */
+    cases++;
+    (void)Bench_MrSetup(0U);
+    for (uint32_t k = 0; k < MULTI_READER_FULL_POLL_ROUNDS; k++) {
+        s_mr_us += 10000.0;
+        (void)MultiReader_PollRound(Bench_MrCard);
+    }
+    if (s_mr.runs != PHDRIVER_READER_COUNT ||
+        s_mr.field_ons != (MULTI_READER_FULL_POLL_ROUNDS - 1U) * PHDRIVER_READER_COUNT) {
+        (*pFailures)++;
+    }
+
+    /* IRQ per reader: one IRQ_STATUS read per WUPA, no SPI polling while the answers are due */
+    cases++;
+    (void)Bench_MrSetup(0x05U);
+    (void)Bench_MrRun(2000U);
+    if (s_mr.wupas == 0U || s_mr.polls != s_mr.wupas) {
+        (*pFailures)++;
+    }
+
+    /* No field reset or guard time below 5.1ms, all cards found */
+    cases++;
+    (void)Bench_MrSetup(all);
+    if (Bench_MrRun(2000U) == 0U || s_mr_cb_mask != all || s_mr.violations != 0U) {
+        (*pFailures)++;
+    }
+
+    return cases;
+}
+
+static uint32_t Bench_VerifyLpcdMgr(uint32_t *pFailures)
+{
+    static LpcdMgr_t mgr;
+    const LpcdMgr_Stats_t *st = LpcdMgr_GetStats(&mgr);
+    Bench_LpRun_t run, base;
+    uint32_t cases = 0;
+    uint16_t ref;
+
+    *pFailures = 0;
+
+    /* Injected source: first measurement is the reference, no E2PROM without a HAL */
+    cases++;
+    if (Bench_LpStart(&mgr, &s_lp_scenarios[0], 0) != PH_ERR_SUCCESS ||
+        (st->reference & AGC_REF_CONFIG_AGC_GEAR_MASK) != BENCH_LP_GEAR ||
+        abs((int)(st->reference & AGC_REF_CONFIG_AGC_VALUE_MASK) - (int)BENCH_LP_AGC) > 2 ||
+        st->recalibrations != 1U || s_lp_e2prom_writes != 0U) {
+        (*pFailures)++;
+    }
+
+    /* Quiet antenna: every tap wakes, no false wakes, the period comes down to the minimum */
+    cases++;
+    Bench_LpRun(&mgr, BENCH_LP_SIM_MS, &run);
+    if (run.taps == 0U || run.missed != 0U || run.false_wakes != 0U || st->detections != run.wakes ||
+        st->period_ms != mgr.cfg.period_min_ms || st->latency_max_ms != BENCH_LP_DISCOVERY_MS) {
+        (*pFailures)++;
+    }
+
+    /* Slow drift: the periodic recalibration follows it, the fixed reference wakes all the time */
+    cases++;
+    (void)Bench_LpStart(&mgr, &s_lp_scenarios[1], 0);
+    Bench_LpRun(&mgr, BENCH_LP_SIM_MS, &run);
+    Bench_LpReset(&s_lp_scenarios[1]);
+    Bench_LpRun(NULL, BENCH_LP_SIM_MS, &base);
+    if (run.missed != 0U || run.late_false_wakes != 0U || run.false_wakes * 10U > base.false_wakes ||
+        abs((int)(st->reference & AGC_REF_CONFIG_AGC_VALUE_MASK) - (int)Bench_LpBackground()) >= st->threshold) {
+        (*pFailures)++;
+    }
+
+    /* Metal next to the antenna: a few false wakes re-measure the background, then quiet again */
+    cases++;
+    (void)Bench_LpStart(&mgr, &s_lp_scenarios[2], 0);
+    Bench_LpRun(&mgr, BENCH_LP_SIM_MS, &run);
+    if (run.missed != 0U || run.false_wakes == 0U || run.false_wakes > 2U * mgr.cfg.window ||
+        run.late_false_wakes != 0U) {
+        (*pFailures)++;
+    }
+
+    /* Noisy antenna: threshold raised above the noise, cards still seen */
+    cases++;
+    (void)Bench_LpStart(&mgr, &s_lp_scenarios[3], 0);
+    Bench_LpRun(&mgr, BENCH_LP_SIM_MS, &run);
+    if (run.missed != 0U || run.late_false_wakes != 0U || st->threshold <= s_lp_scenarios[3].noise ||
+        st->noise == 0U) {
+        (*pFailures)++;
+    }
+
+    /* Another receiver gear restarts the average instead of folding into it */
+    cases++;
+    (void)Bench_LpStart(&mgr, &s_lp_scenarios[0], 0);
+    s_lp_gear = (uint16_t)(BENCH_LP_GEAR << 1);
+    ref = Bench_LpAgc();
+    s_lp_rand = 0x1F123BB5U;
+    (void)LpcdMgr_Calibrate(&mgr);
+    if (st->reference != ref) {
+        (*pFailures)++;
+    }
+
+    /* On the HAL: AGC read with the field on and off again, reference in the register, control byte set once */
+    cases++;
+    if (Bench_LpStart(&mgr, &s_lp_scenarios[3], 1) != PH_ERR_SUCCESS || s_lp_field != 0U ||
+        s_lp_ref_reg != st->reference || s_lp_e2prom[1] != 0x01U || s_lp_e2prom_writes != 1U) {
+        (*pFailures)++;
+    }
+
+    /* E2PROM threshold only rewritten beyond the hysteresis, never left off by more after Arm */
+    cases++;
+    Bench_LpRun(&mgr, BENCH_LP_SIM_MS, &run);
+    if (run.threshold_changes == 0U || run.hyst_violations != 0U || st->e2prom_writes >= run.threshold_changes ||
+        st->e2prom_writes + 1U != s_lp_e2prom_writes || st->threshold_e2prom != s_lp_e2prom[0] || run.missed != 0U) {
+        (*pFailures)++;
+    }
+
+    return cases;
+}
+
+static uint32_t Bench_VerifyEmvOda(uint32_t *pFailures)
+{
+    static const uint8_t pdol_data[19] = {
+        0x36, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x34, 0x11, 0x22, 0x33, 0x44, 0x01, 0x56,
+        0x00, 0x00, 0x00
+    };
+    EMV_ODA_Method_t method;
+    EMV_ODA_TerminalData_t terminal;
+    uint8_t buf[32];
+    uint8_t un[2][4];
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+    EMV_ODA_ClearIssuerCache();
+    (void)EMV_ODA_AddCaKey(&s_oda_ca);
+
+    /* GPO data follows the PDOL: TTQ, n12 amount, unpredictable number, currency, zero filled date */
+    cases++;
+    Bench_OdaCard(EMV_ODA_SDA);
+    if (EMV_ODA_BuildPdol(&s_oda_card, buf, sizeof(buf)) != (int)sizeof(pdol_data) ||
+        memcmp(buf, pdol_data, sizeof(pdol_data)) != 0 || EMV_ODA_BuildPdol(&s_oda_card, buf, 8U) != -1) {
+        (*pFailures)++;
+    }
+
+    /* Unpredictable numbers come from the DRBG, a new one per transaction */
+    cases++;
+    if (EMV_ODA_Unpredictable(un[0], 4U) != 0 || EMV_ODA_Unpredictable(un[1], 4U) != 0 ||
+        memcmp(un[0], un[1], 4U) == 0) {
+        (*pFailures)++;
+    }
+
+    /* SDA: issuer key recovered through the remainder, SSAD over record 1 and the AIP */
+    cases++;
+    if (Bench_OdaRun(1U, &method) != EMV_ODA_OK || method != EMV_ODA_SDA) {
+        (*pFailures)++;
+    }
+
+    /* SDA: one changed byte of the signed record (effective date) */
+    cases++;
+    s_oda_card.sfi_records[0][27] ^= 0x01U;
+    if (Bench_OdaRun(1U, &method) != EMV_ODA_FAILED) {
+        (*pFailures)++;
+    }
+
+    /* DDA: INTERNAL AUTHENTICATE carries the DDOL data, the GPO unpredictable number */
+    cases++;
+    Bench_OdaCard(EMV_ODA_DDA);
+    if (Bench_OdaRun(1U, &method) != EMV_ODA_OK || method != EMV_ODA_DDA || s_oda_ia_count != 1U ||
+        s_oda_ia_len != 4U || memcmp(s_oda_ia_data, s_oda_un, 4U) != 0) {
+        (*pFailures)++;
+    }
+
+    /* DDA: signature over another unpredictable number */
+    cases++;
+    s_oda_card.unpredictable_number[3] ^= 0x01U;
+    if (Bench_OdaRun(1U, &method) != EMV_ODA_FAILED) {
+        (*pFailures)++;
+    }
+
+    /* DDA without terminal data draws its own number, which the canned signature does not cover */
+    cases++;
+    Bench_OdaCard(EMV_ODA_DDA);
+    if (Bench_OdaRun(0U, &method) != EMV_ODA_FAILED || s_oda_ia_count != 1U || s_oda_ia_len != 4U ||
+        memcmp(s_oda_ia_data, s_oda_un, 4U) == 0) {
+        (*pFailures)++;
+    }
+
+    /* fDDA: SDAD from the GPO over unpredictable number, amount, currency and 9F69, no card command */
+    cases++;
+    Bench_OdaCard(EMV_ODA_FDDA);
+    if (Bench_OdaRun(1U, &method) != EMV_ODA_OK || method != EMV_ODA_FDDA || s_oda_ia_count != 0U) {
+        (*pFailures)++;
+    }
+
+    /* fDDA: amount differs from the one the card signed */
+    cases++;
+    s_oda_card.amount = 1235U;
+    if (Bench_OdaRun(1U, &method) != EMV_ODA_FAILED) {
+        (*pFailures)++;
+    }
+
+    /* fDDA without the GPO values is left to the host */
+    cases++;
+    if (Bench_OdaRun(0U, &method) != EMV_ODA_NOT_SUPPORTED) {
+        (*pFailures)++;
+    }
+
+    /* CA index the terminal has no key for */
+    cases++;
+    Bench_OdaCard(EMV_ODA_SDA);
+    s_oda_card.sfi_records[1][5] = 0x93U;
+    if (Bench_OdaRun(1U, &method) != EMV_ODA_NO_CA_KEY) {
+        (*pFailures)++;
+    }
+
+    /* Amount and currency as BCD */
+    cases++;
+    s_oda_card.amount = 9876543U;
+    EMV_ODA_GetTerminalData(&s_oda_card, &terminal);
+    if (memcmp(terminal.amount, "\x00\x00\x09\x87\x65\x43", 6U) != 0 || terminal.currency[0] != 0x01U ||
+        terminal.currency[1] != 0x56U) {
+        (*pFailures)++;
+    }
+
+    return cases;
+}
+
+/* NIST CAVP CTR_DRBG.rsp, [AES-128 use df] [PredictionResistance = False] [EntropyInputLen = 128]
+ * [NonceLen = 64] [PersonalizationStringLen = 0] [AdditionalInputLen = 0] [ReturnedBitsLen = 512] COUNT = 0 */
+static const uint8_t s_drbg_entropy[16] = {
+    0x89, 0x0E, 0xB0, 0x67, 0xAC, 0xF7, 0x38, 0x2E, 0xFF, 0x80, 0xB0, 0xC7, 0x3B, 0xC8, 0x72, 0xC6
+};
+static const uint8_t s_drbg_nonce[8] = {
+    0xAA, 0xD4, 0x71, 0xEF, 0x3E, 0xF1, 0xD2, 0x03
+};
+static const uint8_t s_drbg_returned[64] = {
+    0xA5, 0x51, 0x4E, 0xD7, 0x09, 0x5F, 0x64, 0xF3, 0xD0, 0xD3, 0xA5, 0x76, 0x03, 0x94, 0xAB, 0x42,
+    0x06, 0x2F, 0x37, 0x3A, 0x25, 0x07, 0x2A, 0x6E, 0xA6, 0xBC, 0xFD, 0x84, 0x89, 0xE9, 0x4A, 0xF6,
+    0xCF, 0x18, 0x65, 0x9F, 0xEA, 0x22, 0xED, 0x1C, 0xA0, 0xA9, 0xE3, 0x3F, 0x71, 0x8B, 0x11, 0x5E,
+    0xE5, 0x36, 0xB1, 0x28, 0x09, 0xC3, 0x1B, 0x72, 0xB0, 0x8D, 0xDD, 0x8B, 0xE1, 0x91, 0x0F, 0xA3
+};
+
+/* Known answer, length checks and the pool across phCryptoRng_Seed */
+static uint32_t Bench_VerifyDrbg(uint32_t *pFailures)
+{
+    static phCryptoSym_Sw_DataParams_t sym[2];
+    static phCryptoRng_Sw_DataParams_t rng[2];
+    uint8_t out[2][64];
+    uint8_t big[PHCRYPTORNG_SW_MAX_DF_INPUT + 1U];
+    uint8_t seed[16];
+    uint32_t cases = 0;
+
+    *pFailures = 0;
+    memset(big, 0x5A, sizeof(big));
+    for (uint32_t i = 0; i < 2U; i++) {
+        (void)phCryptoSym_Sw_Init(&sym[i], sizeof(sym[i]), NULL);
+        (void)phCryptoRng_Sw_Init(&rng[i], sizeof(rng[i]), &sym[i]);
+    }
+
+    /* CAVP: instantiate with entropy || nonce, generate 512 bits twice, the second output is the answer */
+    cases++;
+    if (phCryptoRng_Sw_Instantiate(&rng[0], (uint8_t *)s_drbg_entropy, sizeof(s_drbg_entropy),
+                                   (uint8_t *)s_drbg_nonce, sizeof(s_drbg_nonce), NULL, 0) != PH_ERR_SUCCESS ||
+        phCryptoRng_Sw_Generate(&rng[0], NULL, 0, sizeof(out[0]), out[0]) != PH_ERR_SUCCESS ||
+        phCryptoRng_Sw_Generate(&rng[0], NULL, 0, sizeof(out[0]), out[0]) != PH_ERR_SUCCESS ||
+        memcmp(out[0], s_drbg_returned, sizeof(s_drbg_returned)) != 0) {
+        (*pFailures)++;
+    }
+
+    /* Seed material beyond max_number_of_bits, or without entropy, is refused */
+    cases++;
+    if (phCryptoRng_Sw_Instantiate(&rng[1], big, sizeof(big), NULL, 0, NULL, 0) == PH_ERR_SUCCESS ||
+        phCryptoRng_Sw_Instantiate(&rng[1], big, 0, big, 8U, NULL, 0) == PH_ERR_SUCCESS ||
+        phCryptoRng_Sw_Reseed(&rng[0], big, sizeof(big), NULL, 0) == PH_ERR_SUCCESS ||
+        phCryptoRng_Sw_Generate(&rng[0], big, sizeof(big), 16U, out[0]) == PH_ERR_SUCCESS) {
+        (*pFailures)++;
+    }
+
+    /* Additional input changes the output, the empty one does not */
+    cases++;
+    for (uint32_t i = 0; i < 2U; i++) {
+        (void)phCryptoRng_Sw_Init(&rng[i], sizeof(rng[i]), &sym[i]);
+        (void)phCryptoRng_Sw_Instantiate(&rng[i], (uint8_t *)s_drbg_entropy, sizeof(s_drbg_entropy),
+                                         (uint8_t *)s_drbg_nonce, sizeof(s_drbg_nonce), NULL, 0);
+    }
+    (void)phCryptoRng_Sw_Generate(&rng[0], big, 0, 16U, out[0]);
+    (void)phCryptoRng_Sw_Generate(&rng[1], NULL, 0, 16U, out[1]);
+    if (memcmp(out[0], out[1], 16U) != 0 ||
+        phCryptoRng_Sw_Generate(&rng[0], big, 16U, 16U, out[0]) != PH_ERR_SUCCESS ||
+        phCryptoRng_Sw_Generate(&rng[1], NULL, 0, 16U, out[1]) != PH_ERR_SUCCESS || memcmp(out[0], out[1], 16U) == 0) {
+        (*pFailures)++;
+    }
+
+    /* A seed given to a working DRBG leaves the pool in place */
+    cases++;
+    for (uint32_t i = 0; i < 2U; i++) {
+        (void)phCryptoRng_Sw_Init(&rng[i], sizeof(rng[i]), &sym[i]);
+        (void)phCryptoRng_Sw_Seed(&rng[i], big, 32U);
+        (void)phCryptoRng_Sw_RefillPool(&rng[i]);
+    }
+    memset(seed, 0xC3, sizeof(seed));
+    (void)phCryptoRng_Seed(&rng[0], seed, sizeof(seed));
+    if (rng[0].wPoolLen != PH_CRYPTORNG_SW_POOL_SIZE || phCryptoRng_Rnd(&rng[0], 16U, out[0]) != PH_ERR_SUCCESS ||
+        phCryptoRng_Rnd(&rng[1], 16U, out[1]) != PH_ERR_SUCCESS || memcmp(out[0], out[1], 16U) != 0) {
+        (*pFailures)++;
+    }
+
+    /* ... and is mixed in before the DRBG runs again */
+    cases++;
+    (void)phCryptoRng_Rnd(&rng[0], rng[0].wPoolLen, big);
+    (void)phCryptoRng_Rnd(&rng[1], rng[1].wPoolLen, big);
+    if (phCryptoRng_Rnd(&rng[0], 16U, out[0]) != PH_ERR_SUCCESS || phCryptoRng_Rnd(&rng[1], 16U, out[1]) != PH_ERR_SUCCESS ||
+        memcmp(out[0], out[1], 16U) == 0 || rng[0].bSeedPending != PH_OFF) {
+        (*pFailures)++;
+    }
+
+    return cases;
+}
+
+static phStatus_t Bench_Setup(void)
+{
+    phStatus_t status;
+    uint8_t seed[32];
+
+    for (uint32_t i = 0; i < BENCH_DATA_LEN; i++) {
+        s_data[i] = (uint8_t)(i * 29U + 7U);
+    }
+    memcpy(s_parity_in, s_data, BENCH_PARITY_LEN);
+    PH_CHECK_SUCCESS_FCT(status, phTools_EncodeParity(PH_TOOLS_PARITY_OPTION_ODD, s_parity_in, BENCH_PARITY_LEN, 0,
+                                                      (uint16_t)sizeof(s_parity_enc), s_parity_enc,
+                                                      &s_parity_enc_len, &s_parity_enc_bits));
+
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_Sw_Init(&s_sym, sizeof(s_sym), NULL));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_Sw_Init(&s_sym_rng, sizeof(s_sym_rng), NULL));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoRng_Sw_Init(&s_rng, sizeof(s_rng), &s_sym_rng));
+    memcpy(seed, s_data, sizeof(seed));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoRng_Sw_Seed(&s_rng, seed, (uint8_t)sizeof(seed)));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_Sw_Init(&s_sym_auth, sizeof(s_sym_auth), NULL));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_Sw_Init(&s_sym_auth_rng, sizeof(s_sym_auth_rng), NULL));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoRng_Sw_Init(&s_auth_rng, sizeof(s_auth_rng), &s_sym_auth_rng));
+    seed[0] ^= 0xFFU;
+    PH_CHECK_SUCCESS_FCT(status, phCryptoRng_Sw_Seed(&s_auth_rng, seed, (uint8_t)sizeof(seed)));
+
+    Bench_T2T_Build();
+    s_ul_pal.wId = PH_COMP_PAL_MIFARE | PHPAL_MIFARE_SW_ID;
+    s_mful.wId = PH_COMP_AL_MFUL | PHAL_MFUL_SW_ID;
+    s_mful.pPalMifareDataParams = &s_ul_pal;
+    /* Only the T2T mapping is linked, so the layer is set up without phalTop_Sw_Init */
+    memset(&s_top, 0, sizeof(s_top));
+    s_top.wId = PH_COMP_AL_TOP | PHAL_TOP_SW_ID;
+    s_top.pTopTagsDataParams[PHAL_TOP_TAG_TYPE_T2T_TAG - 1U] = &s_mful;
+    s_top.bTagType = PHAL_TOP_TAG_TYPE_T2T_TAG;
+
+    Bench_VTag_Build();
+    PH_CHECK_SUCCESS_FCT(status, Bench_ViccSetup());
+
+    memset(&s_lb_hal, 0, sizeof(s_lb_hal));
+    s_lb_hal.wId = PH_COMP_HAL | PHHAL_HW_PN5180_ID;
+    Bench_LbReset(&s_lb_profiles[0]);
+
+    memset(&s_ov_hal, 0, sizeof(s_ov_hal));
+    s_ov_hal.wId = PH_COMP_HAL | PHHAL_HW_PN5180_ID;
+    PH_CHECK_SUCCESS_FCT(status, phpalI14443p4_Sw_Init(&s_ov_pal, sizeof(s_ov_pal), &s_ov_hal));
+    PH_CHECK_SUCCESS_FCT(status, phpalI14443p4_Sw_SetConfig(&s_ov_pal, PHPAL_I14443P4_CONFIG_OPE_MODE, RD_LIB_MODE_EMVCO));
+
+    return PH_ERR_SUCCESS;
+}
+
+/* ================== Measurement ================== */
+
+static uint64_t Bench_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#if defined(__linux__)
+static int s_perf_fd = -1;
+
+static void Bench_CounterOpen(void)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    s_perf_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/* Retired user-mode instructions of one batch, < 0 when not available */
+static double Bench_CountInstructions(void (*run)(void), uint64_t batch)
+{
+    long long count = 0;
+
+    if (s_perf_fd < 0) {
+        return -1.0;
+    }
+    ioctl(s_perf_fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(s_perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+    for (uint64_t i = 0; i < batch; i++) {
+        run();
+    }
+    ioctl(s_perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(s_perf_fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) {
+        return -1.0;
+    }
+    return (double)count / (double)batch;
+}
+#else
+static void Bench_CounterOpen(void) {}
+static double Bench_CountInstructions(void (*run)(void), uint64_t batch)
+{
+    (void)run; (void)batch;
+    return -1.0;
+}
+#endif /* __linux__ */
+
+static int Bench_CompareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void Bench_Run(const Bench_Case_t *c, const Bench_Options_t *opt, Bench_Result_t *r)
+{
+    double samples[BENCH_SAMPLES_MAX];
+    uint64_t batch = 1, t0, elapsed;
+    double sum = 0.0, var = 0.0;
+
+    Bench_Prepare(c);
+
+    /* Warm-up: caches, branch predictors and CPU frequency settle */
+    t0 = Bench_NowNs();
+    do {
+        c->run();
+    } while ((Bench_NowNs() - t0) < (uint64_t)BENCH_WARMUP_MS * 1000000ULL);
+
+    /* Calibrate the batch so one sample lasts about sample_ms */
+    for (;;) {
+        t0 = Bench_NowNs();
+        for (uint64_t i = 0; i < batch; i++) {
+            c->run();
+        }
+        elapsed = Bench_NowNs() - t0;
+        if (elapsed >= (uint64_t)opt->sample_ms * 1000000ULL || batch >= (1ULL << 30)) {
+            break;
+        }
+        batch *= 2U;
+    }
+
+    for (uint32_t s = 0; s < opt->samples; s++) {
+        t0 = Bench_NowNs();
+        for (uint64_t i = 0; i < batch; i++) {
+            c->run();
+        }
+        samples[s] = (double)(Bench_NowNs() - t0) / (double)batch;
+        sum += samples[s];
+    }
+
+    r->mean_ns = sum / opt->samples;
+    for (uint32_t s = 0; s < opt->samples; s++) {
+        var += (samples[s] - r->mean_ns) * (samples[s] - r->mean_ns);
+    }
+    r->stddev_ns = (opt->samples > 1U) ? sqrt(var / (opt->samples - 1U)) : 0.0;
+    qsort(samples, opt->samples, sizeof(samples[0]), Bench_CompareDouble);
+    r->min_ns = samples[0];
+    r->median_ns = samples[opt->samples / 2U];
+    r->p90_ns = samples[(opt->samples * 9U) / 10U];
+    r->ops = batch * opt->samples;
+    r->instr_per_op = opt->m4_model ? Bench_CountInstructions(c->run, batch) : -1.0;
+}
+
+/* ================== Report ================== */
+
+static void Bench_PrintResult(const Bench_Case_t *c, const Bench_Result_t *r, const Bench_Options_t *opt, uint8_t last)
+{
+    printf("    {\"name\": \"%s\", \"component\": \"%s\", \"bytes\": %u, \"status\": \"0x%04X\",\n",
+           c->name, c->component, (unsigned)c->bytes, (unsigned)s_status);
+    printf("     \"ops\": %llu, \"ns_min\": %.1f, \"ns_median\": %.1f, \"ns_mean\": %.1f, \"ns_stddev\": %.1f, \"ns_p90\": %.1f",
+           (unsigned long long)r->ops, r->min_ns, r->median_ns, r->mean_ns, r->stddev_ns, r->p90_ns);
+    if (c->bytes != 0U) {
+        printf(", \"mb_per_s\": %.2f", (double)c->bytes * 1000.0 / r->median_ns);
+    }
+    if (opt->m4_model) {
+        if (r->instr_per_op >= 0.0) {
+            double cycles = r->instr_per_op * opt->m4_cpi;
+            printf(",\n     \"host_instr\": %.0f, \"m4_cycles_est\": %.0f, \"m4_us_est\": %.2f",
+                   r->instr_per_op, cycles, cycles / opt->m4_mhz);
+        } else {
+            printf(",\n     \"host_instr\": null, \"m4_cycles_est\": null, \"m4_us_est\": null");
+        }
+    }
+    printf("}%s\n", last ? "" : ",");
+}
+
+/* ================== Command plan simulator ================== */
+
+typedef struct {
+    uint32_t round_trips;
+    uint32_t exchanges;
+    uint32_t uart_bytes;
+    double air_us;
+} Bench_PlanSim_t;
+
+/* Frame bytes of an upload carrying plan_len bytecode bytes */
+static uint32_t Bench_UploadBytes(uint16_t plan_len)
+{
+    return 7U + plan_len;
+}
+
+/*
+ * Per-command: the host sends a one-exchange plan per card command and decides
+ * the branch itself from the dump, 66 round trips
+ */
+static void Bench_SimPerCommand(Bench_PlanSim_t *sim)
+{
+    uint8_t read[] = { CMD_PLAN_OP_XCHG, CMD_PLAN_KIND_I15693, ISO15693_ReadSingleBlock, 0, 0, 0, 0,
+                       CMD_PLAN_OP_CAPTURE, 0, 0, CMD_PLAN_OP_END };
+    uint8_t write[] = { CMD_PLAN_OP_XCHG, CMD_PLAN_KIND_I15693, ISO15693_WriteSingleBlock, 0, 62, 0, 4,
+                        0xDE, 0xAD, 0xBE, 0xEF, CMD_PLAN_OP_EXPECT_OK, CMD_PLAN_OP_END };
+    uint8_t frame[CMD_PLAN_RESULT_HEADER + CMD_PLAN_OUT_SIZE + 7U];
+    uint8_t dump[sizeof(s_vtag)];
+    CmdPlan_Result_t result;
+    uint8_t *plan;
+    uint16_t plan_len;
+    uint32_t n_cmds = BENCH_V_BLOCKS;
+
+    Bench_VTag_Build();
+    memset(sim, 0, sizeof(*sim));
+    for (uint32_t i = 0; i < n_cmds; i++) {
+        if (i < BENCH_V_BLOCKS) {
+            read[4] = (uint8_t)i;
+            plan = read;
+            plan_len = (uint16_t)sizeof(read);
+        } else {
+            write[4] = (uint8_t)(62U + i - BENCH_V_BLOCKS);
+            plan = write;
+            plan_len = (uint16_t)sizeof(write);
+        }
+        (void)CmdPlan_Execute(plan, plan_len, s_plan_out, (uint16_t)sizeof(s_plan_out), &result);
+        if (i < BENCH_V_BLOCKS) {
+            memcpy(&dump[i * BENCH_V_BLOCK_SIZE], s_plan_out, BENCH_V_BLOCK_SIZE);
+        }
+        /* Host side decision once the dump is complete */
+        if (i + 1U == BENCH_V_BLOCKS && dump[5] == BENCH_V_MARK) {
+            n_cmds += 2U;
+        }
+        sim->round_trips++;
+        sim->exchanges += result.exchanges;
+        sim->uart_bytes += Bench_UploadBytes(plan_len) +
+                           CmdPlan_BuildResultFrame(&result, s_plan_out, frame, (uint16_t)sizeof(frame));
+    }
+    sim->air_us = s_vtag_air_us;
+}
+
+/* Single plan: one upload with its acknowledge, one result frame */
+static void Bench_SimPlan(Bench_PlanSim_t *sim)
+{
+    uint8_t frame[CMD_PLAN_RESULT_HEADER + CMD_PLAN_OUT_SIZE + 7U];
+    CmdPlan_Result_t result;
+
+    Bench_VTag_Build();
+    memset(sim, 0, sizeof(*sim));
+    memset(&result, 0, sizeof(result));
+    sim->uart_bytes = Bench_UploadBytes((uint16_t)sizeof(s_plan_read_cond_write)) +
+                      CmdPlan_BuildResultFrame(&result, NULL, frame, (uint16_t)sizeof(frame));
+    (void)CmdPlan_Load(s_plan_read_cond_write, (uint16_t)sizeof(s_plan_read_cond_write));
+    (void)CmdPlan_Run(s_plan_out, (uint16_t)sizeof(s_plan_out), &result);
+    sim->round_trips = 1;
+    sim->exchanges = result.exchanges;
+    sim->uart_bytes += CmdPlan_BuildResultFrame(&result, s_plan_out, frame, (uint16_t)sizeof(frame));
+    sim->air_us = s_vtag_air_us;
+}
+
+static double Bench_SimPrint(const char *name, const Bench_PlanSim_t *sim, const Bench_Options_t *opt,
+                             uint8_t card_waits_for_host, uint8_t last)
+{
+    double uart_us = sim->uart_bytes * 10.0 * 1e6 / BENCH_UART_BAUD;
+    double host_us = (double)sim->round_trips * opt->turnaround_us;
+    double total_us = uart_us + host_us + sim->air_us;
+    /* A plan is uploaded before the tap, the card only waits for its exchanges and the result frame */
+    double field_us = card_waits_for_host ? total_us : sim->air_us;
+
+    printf("    \"%s\": {\"round_trips\": %u, \"exchanges\": %u, \"uart_bytes\": %u, \"uart_ms\": %.2f, "
+           "\"host_ms\": %.2f, \"air_ms\": %.2f, \"total_ms\": %.2f, \"in_field_ms\": %.2f}%s\n",
+           name, (unsigned)sim->round_trips, (unsigned)sim->exchanges, (unsigned)sim->uart_bytes, uart_us / 1000.0,
+           host_us / 1000.0, sim->air_us / 1000.0, total_us / 1000.0, field_us / 1000.0, last ? "" : ",");
+    return field_us;
+}
+
+/* Modelled latency of the scenario plan, round trip per command against one plan */
+static void Bench_PlanSimReport(const Bench_Options_t *opt)
+{
+    Bench_PlanSim_t per_cmd, plan;
+    double t_cmd, t_plan;
+
+    Bench_SimPerCommand(&per_cmd);
+    Bench_SimPlan(&plan);
+    printf("  \"plan_sim\": {\"scenario\": \"read %u blocks, write 2 if byte 5 matches\", \"baud\": %.0f, "
+           "\"turnaround_us\": %u,\n", (unsigned)BENCH_V_BLOCKS, BENCH_UART_BAUD, (unsigned)opt->turnaround_us);
+    t_cmd = Bench_SimPrint("per_command", &per_cmd, opt, 1, 0);
+    t_plan = Bench_SimPrint("plan", &plan, opt, 0, 0);
+    printf("    \"in_field_speedup\": %.2f\n  },\n", t_cmd / t_plan);
+    Bench_VTag_Build();
+}
+
+/* ================== Ultralight / NTAG simulator ================== */
+
+/* READ of four pages at a time, the path phalMful offers without mful_bulk */
+static void Bench_UlReadPerPage(void)
+{
+    uint8_t buf[PHAL_MFUL_READ_BLOCK_LENGTH];
+
+    for (uint8_t sec = 0; sec < BENCH_UL_SECTORS; sec++) {
+        if (s_ul->dump[sec] == 0U) {
+            continue;
+        }
+        if (sec != s_ul_sector) {
+            (void)phalMful_Sw_SectorSelect(&s_mful, sec);
+        }
+        for (uint16_t page = 0; page < s_ul->dump[sec]; page += 4U) {
+            (void)phalMful_Sw_Read(&s_mful, (uint8_t)page, buf);
+        }
+    }
+    if (s_ul_sector != 0U) {
+        (void)phalMful_Sw_SectorSelect(&s_mful, 0);
+    }
+}
+
+/* Modelled full-memory read and write time per tag profile */
+static void Bench_MfulSimReport(void)
+{
+    MfulBulk_Result_t result;
+
+    printf("  \"mful_sim\": {\"rx_buffer\": %u, \"host_us\": %.0f, \"write_us\": %.0f,\n",
+           (unsigned)BENCH_UL_RX_BUFSIZE, BENCH_UL_HOST_US, BENCH_UL_WRITE_US);
+    for (uint32_t p = 0; p < BENCH_UL_PROFILES_KNOWN; p++) {
+        double read_ms, read_cached_ms, read_page_ms, write_ms, write_same_ms, sram_ms = 0.0;
+        uint16_t requests;
+        uint16_t user_first, user_bytes;
+
+        MfulBulk_ClearCache();
+        Bench_UlLoad(p);
+        Bench_UlReadPerPage();
+        read_page_ms = s_ul_air_us / 1000.0;
+
+        s_ul_air_us = 0.0;
+        (void)MfulBulk_ReadAll(&s_mful, s_ul_uid, sizeof(s_ul_uid), s_ul_dump, (uint16_t)sizeof(s_ul_dump), &result);
+        read_ms = s_ul_air_us / 1000.0;
+        s_ul_air_us = 0.0;
+        (void)MfulBulk_ReadAll(&s_mful, s_ul_uid, sizeof(s_ul_uid), s_ul_dump, (uint16_t)sizeof(s_ul_dump), &result);
+        read_cached_ms = s_ul_air_us / 1000.0;
+        requests = result.requests;
+        user_first = result.user_first;
+        user_bytes = (uint16_t)(result.user_pages * 4U);
+
+        /* Same data again, then every byte changed */
+        s_ul_air_us = 0.0;
+        (void)MfulBulk_WriteRange(&s_mful, s_ul_uid, sizeof(s_ul_uid), user_first, &s_ul_dump[user_first * 4U],
+                                  user_bytes, &result);
+        write_same_ms = s_ul_air_us / 1000.0;
+        for (uint32_t i = 0; i < user_bytes; i++) {
+            s_ul_new[i] = (uint8_t)~s_ul_dump[user_first * 4U + i];
+        }
+        s_ul_air_us = 0.0;
+        (void)MfulBulk_WriteRange(&s_mful, s_ul_uid, sizeof(s_ul_uid), user_first, s_ul_new, user_bytes, &result);
+        write_ms = s_ul_air_us / 1000.0;
+
+        if (s_ul->sram) {
+            s_ul_air_us = 0.0;
+            (void)MfulBulk_WriteSram(&s_mful, s_ul_uid, sizeof(s_ul_uid), s_ul_new, &result);
+            sram_ms = s_ul_air_us / 1000.0;
+        }
+
+        printf("    \"%s\": {\"bytes\": %u, \"fast_reads\": %u, \"read_ms\": %.2f, \"read_cached_ms\": %.2f, "
+               "\"read_per_page_ms\": %.2f, \"user_bytes\": %u, \"write_ms\": %.2f, \"write_unchanged_ms\": %.2f",
+               s_ul->name, (unsigned)(Bench_UlExpected(s_ul_new) * 4U), (unsigned)requests, read_ms, read_cached_ms,
+               read_page_ms, (unsigned)user_bytes, write_ms, write_same_ms);
+        if (s_ul->sram) {
+            printf(", \"sram_64_ms\": %.2f", sram_ms);
+        }
+        printf("}%s\n", (p + 1U == BENCH_UL_PROFILES_KNOWN) ? "" : ",");
+    }
+    printf("  },\n");
+    MfulBulk_ClearCache();
+    Bench_T2T_Build();
+}
+
+/* Modelled personalisation time, fixed against adaptive EOF timing */
+static void Bench_I15693WriteSimReport(void)
+{
+    printf("  \"i15693_write_sim\": {\"blocks\": %u,\n", (unsigned)BENCH_VICC_PERSO_BLOCKS);
+    for (uint32_t p = 0; p < BENCH_VICC_PROFILES; p++) {
+        double fixed_ms, learn_ms, adaptive_ms, no_option_ms;
+
+        Bench_ViccLoad(p, s_vicc_profiles[p].program_us);
+        phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_FIXED);
+        fixed_ms = Bench_ViccPerso(1U);
+        phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_ADAPTIVE);
+        (void)Bench_ViccCmd(ISO15693_GetSystemInformation, 0U, 0U, 0U, NULL);
+        learn_ms = Bench_ViccPerso(1U);
+        adaptive_ms = Bench_ViccPerso(1U);
+        no_option_ms = Bench_ViccPerso(0U);
+
+        printf("    \"%s\": {\"program_us\": %u, \"learned_us\": %u, \"fixed_ms\": %.1f, \"adaptive_first_ms\": %.1f, "
+               "\"adaptive_ms\": %.1f, \"no_option_ms\": %.1f}%s\n",
+               s_vicc->name, (unsigned)s_vicc_program_us, (unsigned)Bench_ViccLearned(), fixed_ms, learn_ms,
+               adaptive_ms, no_option_ms, (p + 1U == BENCH_VICC_PROFILES) ? "" : ",");
+    }
+    printf("  },\n");
+    phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_FIXED);
+}
+
+/* Modelled power-on to first poll per phase, the normal boot retained across the warm reset into the fast one */
+static void Bench_BootSimReport(void)
+{
+    const BootProf_Record_t *fast, *normal;
+
+    BootProf_Clear();
+    Bench_BootRun(0U);
+    Bench_BootRun(1U);
+    fast = BootProf_Current();
+    normal = BootProf_Previous();
+
+    printf("  \"boot_sim\": {\"boots\": %u, \"phases_us\": {", (unsigned)fast->boot_count);
+    for (uint8_t i = 1; i < (uint8_t)BOOT_PHASE_COUNT; i++) {
+        printf("\"%s\": [%u, %u]%s", BootProf_PhaseName((BootProf_Phase_t)i),
+               (unsigned)BootProf_PhaseUs(normal, (BootProf_Phase_t)i),
+               (unsigned)BootProf_PhaseUs(fast, (BootProf_Phase_t)i), (i + 1U == BOOT_PHASE_COUNT) ? "" : ", ");
+    }
+    printf("},\n    \"normal_to_first_poll_ms\": %.2f, \"fast_to_first_poll_ms\": %.2f},\n",
+           normal->t_us[BOOT_PHASE_FIRST_POLL] / 1000.0, fast->t_us[BOOT_PHASE_FIRST_POLL] / 1000.0);
+}
+
+/* Removal poll loop while a pattern plays: waiting for the pattern in the loop against the TIM7 scheduler */
+static void Bench_FeedbackSimReport(void)
+{
+    static const Feedback_Pattern_t patterns[] = {
+        FEEDBACK_BOOT, FEEDBACK_SUCCESS, FEEDBACK_FAILURE, FEEDBACK_TOO_SLOW, FEEDBACK_REMOVE_CARD
+    };
+    static const char *const names[] = { "boot", "success", "failure", "too_slow", "remove_card" };
+    const uint32_t cycle = BENCH_FB_POLL_MS + BENCH_FB_POLL_RUN_MS;
+    const Feedback_Stats_t *st = Feedback_GetStats();
+    uint64_t t0;
+    double play_ns, edge_ns;
+
+    /* Host cost of the thread side and of one interrupt */
+    Bench_FbReset();
+    t0 = Bench_NowNs();
+    for (uint32_t i = 0; i < BENCH_FB_RUNS; i++) {
+        Feedback_Play((i & 1U) ? FEEDBACK_FAILURE : FEEDBACK_SUCCESS);
+    }
+    play_ns = (double)(Bench_NowNs() - t0) / BENCH_FB_RUNS;
+    Bench_FbReset();
+    Feedback_Play(FEEDBACK_REMOVE_CARD);
+    t0 = Bench_NowNs();
+    for (uint32_t i = 0; i < BENCH_FB_RUNS; i++) {
+        Feedback_OnTimer();
+    }
+    edge_ns = (double)(Bench_NowNs() - t0) / BENCH_FB_RUNS;
+    Feedback_Stop();
+
+    printf("  \"feedback_sim\": {\"play_ns\": %.1f, \"edge_ns\": %.1f, \"poll_ms\": %u, \"patterns\": {", play_ns,
+           edge_ns, (unsigned)cycle);
+    for (uint32_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++) {
+        uint32_t len = Feedback_PatternMs(patterns[p]);
+        uint32_t polls = 0, edges;
+        double worst_block = 0.0, worst_timer = 0.0, sum_block = 0.0, sum_timer = 0.0;
+
+        /* Polls during the pattern with the scheduler: the loop keeps its period */
+        Bench_FbReset();
+        Feedback_Play(patterns[p]);
+        for (uint32_t t = 0; t < len; t += cycle) {
+            Bench_FbAdvance(cycle);
+            polls++;
+        }
+        edges = st->edges;
+        Feedback_Stop();
+
+        /* Card removed at every millisecond of the pattern, detected at the next poll */
+        for (uint32_t r = 0; r < len; r++) {
+            double timer = (double)(cycle - (r % cycle));
+            double block = (double)(len - r) + BENCH_FB_POLL_RUN_MS;
+
+            sum_timer += timer;
+            sum_block += block;
+            worst_timer = (timer > worst_timer) ? timer : worst_timer;
+            worst_block = (block > worst_block) ? block : worst_block;
+        }
+        printf("\"%s\": {\"ms\": %u, \"edges\": %u, \"polls\": %u, \"cpu_us\": %.3f, "
+               "\"removal_latency_ms\": {\"blocking\": [%.1f, %.1f], \"timer\": [%.1f, %.1f]}}%s",
+               names[p], (unsigned)len, (unsigned)edges, (unsigned)polls, (play_ns + edges * edge_ns) / 1000.0,
+               sum_block / len, worst_block, sum_timer / len, worst_timer,
+               (p + 1U == sizeof(patterns) / sizeof(patterns[0])) ? "" : ", ");
+    }
+    printf("}},\n");
+}
+
+/* Field dropped at each state, time to completion of the re-tap with and without the resume cache,
+ * card_ms leaves out the observation delays a resumed tap skips */
+static void Bench_EmvResumeSimReport(void)
+{
+    static const EMV_Payment_State_t states[] = {
+        EMV_STATE_APP_SELECTION, EMV_STATE_APP_INITIALIZATION, EMV_STATE_READ_APP_DATA, EMV_STATE_OFFLINE_DATA_AUTH
+    };
+    static const uint8_t after[] = { 1U, 0U, 4U, 0U };
+    static const char *const names[] = { "app_selection", "app_initialization", "read_app_data", "offline_data_auth" };
+    Bench_RsTap_t clean, torn, full, resume;
+
+    Bench_RsCardReset();
+    (void)Bench_RsTap(EMV_STATE_IDLE, 0);
+    clean = s_rs;
+
+    printf("  \"emv_resume_sim\": {\"window_ms\": %u, \"retap_after_ms\": %u, \"state_delay_ms\": %u, "
+           "\"clean\": {\"ms\": %u, \"card_ms\": %u, \"field_ms\": %u, \"apdus\": %u},\n    \"drops\": {",
+           (unsigned)EMV_RESUME_WINDOW_MS, (unsigned)BENCH_RS_RETAP_MS, (unsigned)BENCH_RS_STATE_DELAY_MS,
+           (unsigned)clean.t_ms, (unsigned)(clean.t_ms - clean.delay_ms), (unsigned)clean.field_ms,
+           (unsigned)clean.apdus);
+    for (uint8_t i = 0; i < (uint8_t)(sizeof(states) / sizeof(states[0])); i++) {
+        Bench_RsCardReset();
+        (void)Bench_RsTap(states[i], after[i]);
+        torn = s_rs;
+        EMV_Resume_Clear();
+        s_rs_now_ms += BENCH_RS_RETAP_MS;
+        (void)Bench_RsTap(EMV_STATE_IDLE, 0);
+        full = s_rs;
+
+        Bench_RsCardReset();
+        (void)Bench_RsTap(states[i], after[i]);
+        s_rs_now_ms += BENCH_RS_RETAP_MS;
+        (void)Bench_RsTap(EMV_STATE_IDLE, 0);
+        resume = s_rs;
+
+        printf("%s\n      \"%s\": {\"torn_ms\": %u, "
+               "\"full\": {\"ms\": %u, \"card_ms\": %u, \"field_ms\": %u, \"apdus\": %u}, "
+               "\"resume\": {\"ms\": %u, \"card_ms\": %u, \"field_ms\": %u, \"apdus\": %u, \"resumed\": %u}}",
+               i ? "," : "", names[i], (unsigned)torn.t_ms, (unsigned)full.t_ms,
+               (unsigned)(full.t_ms - full.delay_ms), (unsigned)full.field_ms, (unsigned)full.apdus,
+               (unsigned)resume.t_ms, (unsigned)(resume.t_ms - resume.delay_ms), (unsigned)resume.field_ms,
+               (unsigned)resume.apdus, (unsigned)resume.resumed);
+    }
+    printf("\n    }},\n");
+    Bench_RsCardReset();
+}
+
+static void Bench_EmvcoAnalyzerSimReport(void)
+{
+    static double rtt[BENCH_LB_RTT_MAX];
+
+    printf("  \"emvco_analyzer_sim\": {\"sessions\": %u, \"apdus\": %u, \"fwt_us\": %u, \"report_ms\": %u, "
+           "\"frame_bytes\": %u,\n    \"profiles\": {",
+           (unsigned)BENCH_LB_SESSIONS, (unsigned)BENCH_LB_APDUS, (unsigned)BENCH_LB_FWT_US,
+           (unsigned)EMVCO_ANALYZER_REPORT_MS, (unsigned)EMVCO_ANALYZER_FRAME_LEN);
+    for (uint32_t p = 0; p < BENCH_LB_PROFILES; p++) {
+        const EmvcoAnalyzer_Window_t *w = EmvcoAnalyzer_Window();
+        uint32_t n;
+        double loop_s;
+
+        Bench_LbReset(&s_lb_profiles[p]);
+        for (uint32_t s = 0; s < BENCH_LB_SESSIONS; s++) {
+            (void)Bench_LbSession();
+        }
+        n = s_lb_run.rtt_n;
+        memcpy(rtt, s_lb_run.rtt_us, n * sizeof(rtt[0]));
+        qsort(rtt, n, sizeof(rtt[0]), Bench_CompareDouble);
+        loop_s = s_lb_run.loop_us / 1e6;
+
+        printf("%s\n      \"%s\": {\"completed\": %u, \"exchanges\": %u, \"errors\": %u, \"naks\": %u, "
+               "\"retransmits\": %u, \"wtx\": %u, \"rtt_us\": {\"mean\": %.1f, \"p50\": %.1f, \"p90\": %.1f, "
+               "\"p99\": %.1f}, \"bytes_per_s\": %.0f, \"pal_ns_per_exchange\": %.1f, "
+               "\"analyzer_ns_per_exchange\": %.1f, \"summaries\": %u, \"uart_bytes_per_s\": %.1f}",
+               p ? "," : "", s_lb_profiles[p].name, (unsigned)s_lb_run.completed, (unsigned)s_lb_run.exchanges,
+               (unsigned)s_lb_run.errors, (unsigned)(s_lb_sent.naks + w->naks),
+               (unsigned)(s_lb_sent.retransmits + w->retransmits), (unsigned)(s_lb_sent.wtx + w->wtx),
+               n ? s_lb_run.loop_us / s_lb_run.exchanges : 0.0, n ? rtt[n / 2U] : 0.0,
+               n ? rtt[(n * 9U) / 10U] : 0.0, n ? rtt[(n * 99U) / 100U] : 0.0,
+               (loop_s > 0.0) ? (double)s_lb_run.bytes / loop_s : 0.0,
+               s_lb_run.exchanges ? (double)s_lb_run.pal_ns / s_lb_run.exchanges : 0.0,
+               s_lb_run.exchanges ? (double)s_lb_run.analyzer_ns / s_lb_run.exchanges : 0.0,
+               (unsigned)s_lb_frames,
+               (s_lb_us > 0.0) ? (double)s_lb_frames * EMVCO_ANALYZER_FRAME_LEN / (s_lb_us / 1e6) : 0.0);
+    }
+    printf("\n    }},\n");
+    Bench_LbReset(&s_lb_profiles[0]);
+}
+
+/* Records read through the scheduler while USART1 streams them, against reading and sending one after the other */
+static void Bench_EmvSchedSimReport(void)
+{
+    Bench_OvTap_t tap;
+    uint32_t bytes = 0;
+
+    Bench_OvTap(0U, &tap);
+    for (uint32_t i = 0; i < BENCH_OV_RECORDS; i++) {
+        bytes += s_ov_rec_len[i] + 11U;
+    }
+    printf("  \"emv_sched_sim\": {\"records\": %u, \"uplink_bytes\": %u, \"card_us\": %.0f, \"uart_byte_us\": %.1f, "
+           "\"serial_ms\": %.2f, \"overlapped_ms\": %.2f, \"gain\": %.2f, \"dropped\": %u},\n",
+           (unsigned)BENCH_OV_RECORDS, (unsigned)bytes, BENCH_OV_CARD_US, BENCH_OV_UART_BYTE_US,
+           tap.serial_us / 1000.0, tap.total_us / 1000.0, (tap.total_us > 0.0) ? tap.serial_us / tap.total_us : 0.0,
+           (unsigned)tap.dropped);
+}
+
+/* Four virtual readers polled round by round, overlapped against one after the other */
+static void Bench_MultiReaderSimReport(void)
+{
+    const uint32_t all = (1U << PHDRIVER_READER_COUNT) - 1U;
+    const double sec = BENCH_MR_SIM_MS / 1000.0;
+    double idle_ov, idle_serial, det_ov, det_serial;
+    uint32_t polls, wupas;
+
+    (void)Bench_MrSetup(0U);
+    (void)Bench_MrRun(BENCH_MR_SIM_MS);
+    idle_ov = s_mr.wupas / sec;
+    (void)Bench_MrSetup(0U);
+    (void)Bench_MrSerialRun(BENCH_MR_SIM_MS);
+    idle_serial = s_mr.wupas / sec;
+
+    (void)Bench_MrSetup(all);
+    det_ov = Bench_MrRun(BENCH_MR_SIM_MS) / sec;
+    polls = s_mr.polls;
+    wupas = s_mr.wupas;
+    (void)Bench_MrSetup(all);
+    det_serial = Bench_MrSerialRun(BENCH_MR_SIM_MS) / sec;
+
+    printf("  \"multi_reader_sim\": {\"readers\": %u, \"sim_ms\": %u, \"spi_us\": %.0f, \"activate_us\": %.0f, "
+           "\"idle_probes_per_s\": {\"overlapped\": %.1f, \"serial\": %.1f, \"gain\": %.2f}, "
+           "\"detections_per_s\": {\"overlapped\": %.1f, \"serial\": %.1f, \"gain\": %.2f}, "
+           "\"polls_per_wupa\": %.2f},\n",
+           (unsigned)PHDRIVER_READER_COUNT, (unsigned)BENCH_MR_SIM_MS, BENCH_MR_SPI_US, BENCH_MR_ACTIVATE_US,
+           idle_ov, idle_serial, (idle_serial > 0.0) ? idle_ov / idle_serial : 0.0,
+           det_ov, det_serial, (det_serial > 0.0) ? det_ov / det_serial : 0.0,
+           (wupas > 0U) ? (double)polls / wupas : 0.0);
+}
+
+/* Per scenario, one simulated hour: manager vs. a reference taken once */
+static void Bench_LpcdSimReport(void)
+{
+    static LpcdMgr_t mgr;
+    const LpcdMgr_Stats_t *st = LpcdMgr_GetStats(&mgr);
+    const uint32_t n = (uint32_t)(sizeof(s_lp_scenarios) / sizeof(s_lp_scenarios[0]));
+    Bench_LpRun_t run, base;
+
+    printf("  \"lpcd_sim\": {\"sim_ms\": %u, \"fixed_period_ms\": %u, \"scenarios\": [\n",
+           (unsigned)BENCH_LP_SIM_MS, (unsigned)BENCH_LP_FIXED_PERIOD_MS);
+    for (uint32_t i = 0; i < n; i++) {
+        Bench_LpReset(&s_lp_scenarios[i]);
+        Bench_LpRun(NULL, BENCH_LP_SIM_MS, &base);
+        (void)Bench_LpStart(&mgr, &s_lp_scenarios[i], 1);
+        Bench_LpRun(&mgr, BENCH_LP_SIM_MS, &run);
+        printf("    {\"name\": \"%s\", \"taps\": %u, "
+               "\"fixed\": {\"wakes\": %u, \"false_wakes\": %u, \"missed\": %u}, "
+               "\"managed\": {\"wakes\": %u, \"false_wakes\": %u, \"missed\": %u, \"recalibrations\": %u, "
+               "\"threshold\": %u, \"threshold_e2prom\": %u, \"threshold_changes\": %u, \"e2prom_writes\": %u, "
+               "\"period_ms\": %u, \"noise\": %u, \"latency_avg_ms\": %u}}%s\n",
+               s_lp_scenarios[i].name, (unsigned)run.taps, (unsigned)base.wakes, (unsigned)base.false_wakes,
+               (unsigned)base.missed, (unsigned)run.wakes, (unsigned)run.false_wakes, (unsigned)run.missed,
+               (unsigned)st->recalibrations, (unsigned)st->threshold, (unsigned)st->threshold_e2prom,
+               (unsigned)run.threshold_changes, (unsigned)st->e2prom_writes, (unsigned)st->period_ms,
+               (unsigned)st->noise, (unsigned)st->latency_avg_ms, (i + 1U == n) ? "" : ",");
+    }
+    printf("  ]},\n");
+}
+
+/* ================== Authentication latency ================== */
+
+/* Reader side of phalMful_Sw_AuthenticateAES, the tag's E(K, RndA') is stood in by a decrypt of the same size */
+static phStatus_t Bench_AuthAes(void)
+{
+    static const uint8_t ek_rnd_b[16] = {
+        0x3A, 0x61, 0x0C, 0x9E, 0x52, 0xD7, 0x18, 0x44, 0xB5, 0x0F, 0x7C, 0xE3, 0x29, 0x86, 0xA1, 0x5D
+    };
+    phStatus_t status;
+    uint8_t rnd_a[16], rnd_b[16], buf[32], sv[32], mac[16];
+    uint8_t mac_len;
+
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_LoadKeyDirect(&s_sym_auth, (uint8_t *)s_aes_key, PH_CRYPTOSYM_KEY_TYPE_AES128));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_LoadIv(&s_sym_auth, s_iv, 16U));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_Decrypt(&s_sym_auth, PH_CRYPTOSYM_CIPHER_MODE_CBC, (uint8_t *)ek_rnd_b, 16U, rnd_b));
+
+    /* The challenge: seeded with RndB, then drawn */
+    PH_CHECK_SUCCESS_FCT(status, phCryptoRng_Seed(&s_auth_rng, rnd_b, 16U));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoRng_Rnd(&s_auth_rng, 16U, rnd_a));
+
+    memcpy(buf, rnd_a, 16U);
+    memcpy(&buf[16], &rnd_b[1], 15U);
+    buf[31] = rnd_b[0];
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_LoadIv(&s_sym_auth, s_iv, 16U));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_Encrypt(&s_sym_auth, PH_CRYPTOSYM_CIPHER_MODE_CBC, buf, 32U, buf));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_LoadIv(&s_sym_auth, s_iv, 16U));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_Decrypt(&s_sym_auth, PH_CRYPTOSYM_CIPHER_MODE_CBC, &buf[16], 16U, &buf[16]));
+
+    /* Session key from RndA and RndB */
+    memcpy(sv, "\x5A\xA5\x00\x01\x00\x80", 6U);
+    sv[6] = rnd_a[0];
+    sv[7] = rnd_a[1];
+    for (uint32_t i = 0; i < 6U; i++) {
+        sv[8U + i] = rnd_a[2U + i] ^ rnd_b[i];
+    }
+    memcpy(&sv[14], &rnd_b[6], 10U);
+    memcpy(&sv[24], &rnd_a[8], 8U);
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_LoadIv(&s_sym_auth, s_iv, 16U));
+    PH_CHECK_SUCCESS_FCT(status, phCryptoSym_CalculateMac(&s_sym_auth, PH_CRYPTOSYM_MAC_MODE_CMAC, sv, 32U, mac, &mac_len));
+    return phCryptoSym_LoadKeyDirect(&s_sym_auth, mac, PH_CRYPTOSYM_KEY_TYPE_AES128);
+}
+
+/* Median of n samples, sorts them */
+static double Bench_Median(double *samples, uint32_t n)
+{
+    qsort(samples, n, sizeof(samples[0]), Bench_CompareDouble);
+    return samples[n / 2U];
+}
+
+/* Each authenticate timed alone: challenge from the pool topped up in between, against the DRBG run inline */
+static void Bench_AuthSimReport(void)
+{
+    static double pool_ns[BENCH_AUTH_RUNS], inline_ns[BENCH_AUTH_RUNS], refill_ns[BENCH_AUTH_RUNS];
+    uint8_t drain[PH_CRYPTORNG_SW_POOL_SIZE];
+    uint32_t errors = 0;
+    uint64_t t0;
+
+    for (uint32_t i = 0; i < BENCH_AUTH_RUNS; i++) {
+        /* Idle time or APDU in flight */
+        t0 = Bench_NowNs();
+        errors += (phCryptoRng_Sw_RefillPool(&s_auth_rng) != PH_ERR_SUCCESS);
+        refill_ns[i] = (double)(Bench_NowNs() - t0);
+
+        t0 = Bench_NowNs();
+        errors += (Bench_AuthAes() != PH_ERR_SUCCESS);
+        pool_ns[i] = (double)(Bench_NowNs() - t0);
+    }
+    for (uint32_t i = 0; i < BENCH_AUTH_RUNS; i++) {
+        /* Pool emptied beforehand, the pending seed and the generate run in the authenticate */
+        (void)phCryptoRng_Rnd(&s_auth_rng, s_auth_rng.wPoolLen, drain);
+
+        t0 = Bench_NowNs();
+        errors += (Bench_AuthAes() != PH_ERR_SUCCESS);
+        inline_ns[i] = (double)(Bench_NowNs() - t0);
+    }
+
+    {
+        double pool = Bench_Median(pool_ns, BENCH_AUTH_RUNS);
+        double in = Bench_Median(inline_ns, BENCH_AUTH_RUNS);
+
+        printf("  \"auth_latency\": {\"auth\": \"mful_aes_reader\", \"runs\": %u, \"errors\": %u, "
+               "\"inline_ns_median\": %.1f, \"pool_ns_median\": %.1f, \"refill_ns_median\": %.1f, \"gain\": %.2f},\n",
+               (unsigned)BENCH_AUTH_RUNS, (unsigned)errors, in, pool, Bench_Median(refill_ns, BENCH_AUTH_RUNS),
+               (pool > 0.0) ? in / pool : 0.0);
+    }
+}
+
+static int Bench_ParseArgs(int argc, char **argv, Bench_Options_t *opt)
+{
+    opt->filter = NULL;
+    opt->samples = BENCH_SAMPLES_DEFAULT;
+    opt->sample_ms = BENCH_SAMPLE_MS_DEFAULT;
+    opt->m4_model = 0;
+    opt->m4_cpi = BENCH_M4_CPI_DEFAULT;
+    opt->m4_mhz = BENCH_M4_MHZ_DEFAULT;
+    opt->turnaround_us = BENCH_TURNAROUND_US_DEFAULT;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && (i + 1) < argc) {
+            opt->filter = argv[++i];
+        } else if (strcmp(argv[i], "--samples") == 0 && (i + 1) < argc) {
+            opt->samples = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--sample-ms") == 0 && (i + 1) < argc) {
+            opt->sample_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--m4-model") == 0) {
+            opt->m4_model = 1;
+        } else if (strcmp(argv[i], "--m4-cpi") == 0 && (i + 1) < argc) {
+            opt->m4_model = 1;
+            opt->m4_cpi = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--m4-mhz") == 0 && (i + 1) < argc) {
+            opt->m4_model = 1;
+            opt->m4_mhz = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--turnaround-us") == 0 && (i + 1) < argc) {
+            opt->turnaround_us = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [--filter s] [--samples n] [--sample-ms ms] [--m4-model] [--m4-cpi x] [--m4-mhz f]"
+                    " [--turnaround-us us]\n",
+                    argv[0]);
+            return -1;
+        }
+    }
+    if (opt->samples == 0U || opt->samples > BENCH_SAMPLES_MAX) {
+        opt->samples = BENCH_SAMPLES_DEFAULT;
+    }
+    if (opt->sample_ms == 0U) {
+        opt->sample_ms = BENCH_SAMPLE_MS_DEFAULT;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    Bench_Options_t opt;
+    Bench_Result_t result;
+    const uint32_t n_cases = (uint32_t)(sizeof(s_cases) / sizeof(s_cases[0]));
+    uint32_t selected[sizeof(s_cases) / sizeof(s_cases[0])];
+    uint32_t n_selected = 0;
+    phStatus_t status;
+    uint32_t verify_cases, verify_failures;
+    uint32_t plan_cases, plan_failures;
+    uint32_t orig_cases, orig_failures;
+    uint32_t mful_cases, mful_failures;
+    uint32_t i15693_cases, i15693_failures;
+    uint32_t boot_cases, boot_failures;
+    uint32_t fb_cases, fb_failures;
+    uint32_t rs_cases, rs_failures;
+    uint32_t lb_cases, lb_failures;
+    uint32_t ov_cases, ov_failures;
+    uint32_t mr_cases, mr_failures;
+    uint32_t oda_cases, oda_failures;
+    uint32_t drbg_cases, drbg_failures;
+    uint32_t lp_cases, lp_failures;
+
+    if (Bench_ParseArgs(argc, argv, &opt) != 0) {
+        return 2;
+    }
+    status = Bench_Setup();
+    if (status != PH_ERR_SUCCESS) {
+        fprintf(stderr, "setup failed: 0x%04X\n", (unsigned)status);
+        return 1;
+    }
+    verify_cases = Bench_VerifyParity(&verify_failures);
+    plan_cases = Bench_VerifyCmdPlan(&plan_failures);
+    orig_cases = Bench_VerifyOrigCheck(&orig_failures);
+    mful_cases = Bench_VerifyMfulBulk(&mful_failures);
+    i15693_cases = Bench_VerifyI15693Write(&i15693_failures);
+    boot_cases = Bench_VerifyBootProf(&boot_failures);
+    fb_cases = Bench_VerifyFeedback(&fb_failures);
+    rs_cases = Bench_VerifyEmvResume(&rs_failures);
+    lb_cases = Bench_VerifyEmvcoAnalyzer(&lb_failures);
+    ov_cases = Bench_VerifyEmvSched(&ov_failures);
+    mr_cases = Bench_VerifyMultiReader(&mr_failures);
+    oda_cases = Bench_VerifyEmvOda(&oda_failures);
+    drbg_cases = Bench_VerifyDrbg(&drbg_failures);
+    lp_cases = Bench_VerifyLpcdMgr(&lp_failures);
+    if (opt.m4_model) {
+        Bench_CounterOpen();
+    }
+    for (uint32_t i = 0; i < n_cases; i++) {
+        if (opt.filter == NULL || strstr(s_cases[i].name, opt.filter) != NULL ||
+            strstr(s_cases[i].component, opt.filter) != NULL) {
+            selected[n_selected++] = i;
+        }
+    }
+
+    printf("{\n  \"suite\": \"nfcrdlib_bench\",\n  \"revision\": \"%s\",\n", NFCRDLIB_BENCH_REV);
+#if defined(__VERSION__)
+    printf("  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    printf("  \"samples\": %u,\n  \"sample_ms\": %u,\n", (unsigned)opt.samples, (unsigned)opt.sample_ms);
+    printf("  \"verify\": {\"parity\": {\"cases\": %u, \"failures\": %u}, "
+           "\"cmd_plan\": {\"cases\": %u, \"failures\": %u}, \"orig_check\": {\"cases\": %u, \"failures\": %u}, "
+           "\"mful_bulk\": {\"cases\": %u, \"failures\": %u}, \"i15693_write\": {\"cases\": %u, \"failures\": %u}, "
+           "\"boot_prof\": {\"cases\": %u, \"failures\": %u}, "
+           "\"feedback\": {\"cases\": %u, \"failures\": %u}, \"emv_resume\": {\"cases\": %u, \"failures\": %u}, "
+           "\"emvco_analyzer\": {\"cases\": %u, \"failures\": %u}, \"emv_sched\": {\"cases\": %u, \"failures\": %u}, "
+           "\"multi_reader\": {\"cases\": %u, \"failures\": %u}, \"emv_oda\": {\"cases\": %u, \"failures\": %u}, "
+           "\"ctr_drbg\": {\"cases\": %u, \"failures\": %u}, \"lpcd_mgr\": {\"cases\": %u, \"failures\": %u}},\n",
+           (unsigned)verify_cases, (unsigned)verify_failures, (unsigned)plan_cases, (unsigned)plan_failures,
+           (unsigned)orig_cases, (unsigned)orig_failures, (unsigned)mful_cases, (unsigned)mful_failures,
+           (unsigned)i15693_cases, (unsigned)i15693_failures,
+           (unsigned)boot_cases, (unsigned)boot_failures, (unsigned)fb_cases, (unsigned)fb_failures,
+           (unsigned)rs_cases, (unsigned)rs_failures, (unsigned)lb_cases, (unsigned)lb_failures,
+           (unsigned)ov_cases, (unsigned)ov_failures, (unsigned)mr_cases, (unsigned)mr_failures,
+           (unsigned)oda_cases, (unsigned)oda_failures, (unsigned)drbg_cases, (unsigned)drbg_failures,
+           (unsigned)lp_cases, (unsigned)lp_failures);
+    Bench_PlanSimReport(&opt);
+    Bench_MfulSimReport();
+    Bench_I15693WriteSimReport();
+    Bench_BootSimReport();
+    Bench_FeedbackSimReport();
+    Bench_EmvResumeSimReport();
+    Bench_EmvcoAnalyzerSimReport();
+    Bench_EmvSchedSimReport();
+    Bench_MultiReaderSimReport();
+    Bench_LpcdSimReport();
+    Bench_AuthSimReport();
+    if (opt.m4_model) {
+        /* Host instruction counts scaled by a CPI, a first-order estimate for the Cortex-M4 build */
+        printf("  \"m4_model\": {\"cpi\": %.2f, \"mhz\": %.1f},\n", opt.m4_cpi, opt.m4_mhz);
+    } else {
+        printf("  \"m4_model\": null,\n");
+    }
+    printf("  \"results\": [\n");
+    for (uint32_t i = 0; i < n_selected; i++) {
+        const Bench_Case_t *c = &s_cases[selected[i]];
+        Bench_Run(c, &opt, &result);
+        Bench_PrintResult(c, &result, &opt, (uint8_t)(i + 1U == n_selected));
+        fflush(stdout);
+    }
+    printf("  ]\n}\n");
+    return (verify_failures == 0U && plan_failures == 0U && orig_failures == 0U && mful_failures == 0U &&
+            i15693_failures == 0U && boot_failures == 0U &&
+            fb_failures == 0U && rs_failures == 0U && lb_failures == 0U && ov_failures == 0U &&
+            mr_failures == 0U && oda_failures == 0U && drbg_failures == 0U && lp_failures == 0U) ? 0 : 1;
+}
@@ -0,0 +1,335 @@
+/*
+ * SunBatchBench.c
+ *
+ * Throughput of SUN message verification on the Linux backend
+ * The single call path is the reader library itself, phalMfNtag42XDna_Sw_CalculateMACSDM
+ * (after phalMfNtag42XDna_Sw_DecryptSDMPICCData for encrypted PICCData) and
+ * phalMful_Sw_CalculateSunCMAC per message, the batch path is SunBatch_Verify.
+ * Every batch status is checked against the single call result first.
+ * Results are written as JSON to stdout.
+ *
+ * Usage: sun_batch_bench [--messages <n>] [--threads <n>] [--keys <n>]
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#define _GNU_SOURCE
+#include <ph_Status.h>
+#include <phCryptoSym.h>
+#include <phKeyStore.h>
+#include <phalMful.h>
+#include <phalMfNtag42XDna.h>
+#include "../library/comps/phalMfNtag42XDna/src/Sw/phalMfNtag42XDna_Sw.h"
+#include "../library/comps/phalMful/src/Sw/phalMful_Sw.h"
+#include "../host/SunBatch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef NFCRDLIB_BENCH_REV
+#define NFCRDLIB_BENCH_REV              "unknown"
+#endif
+
+/* ================== Configuration ================== */
+#define SUN_BENCH_MESSAGES_DEFAULT      20000U
+#define SUN_BENCH_KEYS_DEFAULT          8U          /* Distinct SDM file read keys in the message mix */
+#define SUN_BENCH_KEYS_MAX              32U
+#define SUN_BENCH_PICC_KEY_NO           SUN_BENCH_KEYS_MAX  /* Meta read key, after the MAC keys */
+#define SUN_BENCH_INPUT_MAX             96U         /* MAC input, the URL part covered by SDMMAC */
+#define SUN_BENCH_ROUNDS                5U          /* Timed passes, best one reported */
+
+/* ================== Fixtures ================== */
+
+static phKeyStore_Sw_DataParams_t s_ks;
+static phKeyStore_Sw_KeyEntry_t s_ks_entries[SUN_BENCH_KEYS_MAX + 1U];
+static phKeyStore_Sw_KeyVersionPair_t s_ks_pairs[SUN_BENCH_KEYS_MAX + 1U];
+static phKeyStore_Sw_KUCEntry_t s_ks_kuc[1];
+
+static phCryptoSym_Sw_DataParams_t s_sym_enc;
+static phCryptoSym_Sw_DataParams_t s_sym_mac;
+static phalMfNtag42XDna_Sw_DataParams_t s_ntag;
+static phalMful_Sw_DataParams_t s_mful;
+
+static SunBatch_Msg_t *s_msgs;
+static uint8_t *s_inputs;
+static phStatus_t *s_expect;                /* Single call result of every message */
+
+static uint32_t s_lcg = 0x2468ACE1U;
+
+static uint8_t Bench_Rand8(void)
+{
+    s_lcg = s_lcg * 1103515245U + 12345U;
+    return (uint8_t)(s_lcg >> 16);
+}
+
+static double Bench_NowSec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int Bench_Setup(void)
+{
+    uint8_t aKey[16];
+    uint32_t k;
+
+    if (phKeyStore_Sw_Init(&s_ks, sizeof(s_ks), s_ks_entries, SUN_BENCH_KEYS_MAX + 1U, s_ks_pairs, 1,
+                           s_ks_kuc, 1) != PH_ERR_SUCCESS) {
+        return -1;
+    }
+    for (k = 0; k <= SUN_BENCH_KEYS_MAX; k++) {
+        for (uint8_t i = 0; i < sizeof(aKey); i++) {
+            aKey[i] = Bench_Rand8();
+        }
+        if (phKeyStore_FormatKeyEntry(&s_ks, (uint16_t)k, PH_CRYPTOSYM_KEY_TYPE_AES128) != PH_ERR_SUCCESS ||
+            phKeyStore_SetKeyAtPos(&s_ks, (uint16_t)k, 0, PH_CRYPTOSYM_KEY_TYPE_AES128, aKey, 0) != PH_ERR_SUCCESS) {
+            return -1;
+        }
+    }
+
+    (void)phCryptoSym_Sw_Init(&s_sym_enc, sizeof(s_sym_enc), &s_ks);
+    (void)phCryptoSym_Sw_Init(&s_sym_mac, sizeof(s_sym_mac), &s_ks);
+
+    /* Only the members used by the SDM helpers, there is no card behind them */
+    memset(&s_ntag, 0, sizeof(s_ntag));
+    s_ntag.wId = PH_COMP_AL_MFNTAG42XDNA | PHAL_MFNTAG42XDNA_SW_ID;
+    s_ntag.pKeyStoreDataParams = &s_ks;
+    s_ntag.pCryptoDataParamsEnc = &s_sym_enc;
+    s_ntag.pCryptoDataParamsMac = &s_sym_mac;
+
+    memset(&s_mful, 0, sizeof(s_mful));
+    s_mful.wId = PH_COMP_AL_MFUL | PHAL_MFUL_SW_ID;
+    s_mful.pKeyStoreDataParams = &s_ks;
+    s_mful.pCryptoDataParams = &s_sym_mac;
+    return 0;
+}
+
+/* Encrypted PICCData as the tag mirrors it: AES-CBC, zero IV, meta read key */
+static void Bench_EncryptPicc(SunBatch_Msg_t *pMsg)
+{
+    uint8_t aPlain[16];
+    uint8_t aIv[16];
+    uint8_t bPos = 1;
+
+    for (uint8_t i = 0; i < sizeof(aPlain); i++) {
+        aPlain[i] = Bench_Rand8();
+    }
+    aPlain[0] = (uint8_t)(0xC0U | pMsg->bUidLen);
+    memcpy(&aPlain[bPos], pMsg->aUid, pMsg->bUidLen);
+    bPos = (uint8_t)(bPos + pMsg->bUidLen);
+    memcpy(&aPlain[bPos], pMsg->aReadCtr, 3);
+
+    memset(aIv, 0, sizeof(aIv));
+    (void)phCryptoSym_LoadKey(&s_sym_enc, SUN_BENCH_PICC_KEY_NO, 0, PH_CRYPTOSYM_KEY_TYPE_AES128);
+    (void)phCryptoSym_LoadIv(&s_sym_enc, aIv, sizeof(aIv));
+    (void)phCryptoSym_Encrypt(&s_sym_enc, PH_CRYPTOSYM_CIPHER_MODE_CBC, aPlain, sizeof(aPlain), pMsg->aPiccEnc);
+}
+
+/* The single call path, what a backend without SunBatch does per message */
+static phStatus_t Bench_VerifySingle(const SunBatch_Msg_t *pIn)
+{
+    SunBatch_Msg_t sMsg = *pIn;
+    uint8_t aMac[16];
+    uint8_t aPlain[16];
+    phStatus_t wStatus;
+
+    if (sMsg.bType == SUN_BATCH_MFUL_AES) {
+        wStatus = phalMful_Sw_CalculateSunCMAC(&s_mful, sMsg.wKeyNo, sMsg.wKeyVer, (uint8_t *)sMsg.pMacInput,
+                                               sMsg.wMacInputLen, aMac);
+        if (wStatus != PH_ERR_SUCCESS) {
+            return wStatus;
+        }
+        return (memcmp(aMac, sMsg.aMac, 8) == 0) ? PH_ERR_SUCCESS :
+               PH_ADD_COMPCODE_FIXED(PH_ERR_AUTH_ERROR, PH_COMP_AL_MFUL);
+    }
+
+    if ((sMsg.bFlags & SUN_BATCH_FLAG_PICC_ENC) != 0U) {
+        wStatus = phalMfNtag42XDna_Sw_DecryptSDMPICCData(&s_ntag, sMsg.wPiccKeyNo, sMsg.wPiccKeyVer, sMsg.aPiccEnc,
+                                                        sizeof(sMsg.aPiccEnc), aPlain);
+        if (wStatus != PH_ERR_SUCCESS) {
+            return wStatus;
+        }
+        sMsg.bUidLen = (uint8_t)(aPlain[0] & 0x0FU);
+        memcpy(sMsg.aUid, &aPlain[1], sMsg.bUidLen);
+        memcpy(sMsg.aReadCtr, &aPlain[1U + sMsg.bUidLen], 3);
+    }
+    wStatus = phalMfNtag42XDna_Sw_CalculateMACSDM(&s_ntag, sMsg.bSdmOption, sMsg.wKeyNo, sMsg.wKeyVer, sMsg.aUid,
+                                                  sMsg.bUidLen, sMsg.aReadCtr, (uint8_t *)sMsg.pMacInput,
+                                                  sMsg.wMacInputLen, aMac);
+    if (wStatus != PH_ERR_SUCCESS) {
+        return wStatus;
+    }
+    return (memcmp(aMac, sMsg.aMac, 8) == 0) ? PH_ERR_SUCCESS :
+           PH_ADD_COMPCODE_FIXED(PH_ERR_AUTH_ERROR, PH_COMP_AL_MFNTAG42XDNA);
+}
+
+/*
+ * Message mix: 3/4 NTAG 424 SDM (half of them with encrypted PICCData),
+ * 1/4 Ultralight AES, about 1/8 tampered, a few zero and overflowed counters
+ */
+static void Bench_BuildMessages(uint32_t dwCount, uint32_t dwKeys)
+{
+    for (uint32_t m = 0; m < dwCount; m++) {
+        SunBatch_Msg_t *pMsg = &s_msgs[m];
+        uint8_t *pInput = &s_inputs[m * SUN_BENCH_INPUT_MAX];
+        uint8_t bSel = Bench_Rand8();
+        uint8_t aMac[16];
+        uint8_t i;
+
+        memset(pMsg, 0, sizeof(*pMsg));
+        pMsg->bType = ((bSel & 0x03U) == 0U) ? SUN_BATCH_MFUL_AES : SUN_BATCH_NTAG42X_SDM;
+        pMsg->wKeyNo = (uint16_t)(Bench_Rand8() % dwKeys);
+        pMsg->wPiccKeyNo = SUN_BENCH_PICC_KEY_NO;
+        pMsg->bSdmOption = PHAL_MFNTAG42XDNA_VCUID_PRESENT | PHAL_MFNTAG42XDNA_RDCTR_PRESENT;
+        pMsg->bUidLen = 7;
+        for (i = 0; i < 7U; i++) {
+            pMsg->aUid[i] = Bench_Rand8();
+        }
+        pMsg->aReadCtr[0] = Bench_Rand8();
+        pMsg->aReadCtr[1] = Bench_Rand8();
+        pMsg->aReadCtr[2] = 0;
+        if ((bSel & 0xF0U) == 0x10U) {
+            memset(pMsg->aReadCtr, 0x00, 3);            /* Left out of SV2 */
+        } else if ((bSel & 0xF0U) == 0x20U && (bSel & 0x0CU) == 0U) {
+            memset(pMsg->aReadCtr, 0xFF, 3);            /* PH_ERR_PARAMETER_OVERFLOW */
+        }
+        pMsg->wMacInputLen = (uint16_t)(Bench_Rand8() % SUN_BENCH_INPUT_MAX);
+        for (i = 0; i < pMsg->wMacInputLen; i++) {
+            pInput[i] = Bench_Rand8();
+        }
+        pMsg->pMacInput = pInput;
+
+        if (pMsg->bType == SUN_BATCH_NTAG42X_SDM && (bSel & 0x04U) != 0U) {
+            pMsg->bFlags = SUN_BATCH_FLAG_PICC_ENC;
+            Bench_EncryptPicc(pMsg);
+        }
+
+        if (pMsg->bType == SUN_BATCH_MFUL_AES) {
+            (void)phalMful_Sw_CalculateSunCMAC(&s_mful, pMsg->wKeyNo, 0, pInput, pMsg->wMacInputLen, aMac);
+        } else {
+            (void)phalMfNtag42XDna_Sw_CalculateMACSDM(&s_ntag, pMsg->bSdmOption, pMsg->wKeyNo, 0, pMsg->aUid,
+                                                      pMsg->bUidLen, pMsg->aReadCtr, pInput, pMsg->wMacInputLen, aMac);
+        }
+        memcpy(pMsg->aMac, aMac, 8);
+        if ((bSel & 0x38U) == 0x08U) {
+            pMsg->aMac[Bench_Rand8() & 7U] ^= (uint8_t)(1U << (Bench_Rand8() & 7U));
+        }
+
+        /* The batch gets UID and counter only from the encrypted PICCData */
+        if ((pMsg->bFlags & SUN_BATCH_FLAG_PICC_ENC) != 0U) {
+            memset(pMsg->aUid, 0, sizeof(pMsg->aUid));
+            memset(pMsg->aReadCtr, 0, sizeof(pMsg->aReadCtr));
+            pMsg->bUidLen = 0;
+        }
+    }
+}
+
+/* ================== Main ================== */
+
+int main(int argc, char **argv)
+{
+    uint32_t dwCount = SUN_BENCH_MESSAGES_DEFAULT;
+    uint32_t dwKeys = SUN_BENCH_KEYS_DEFAULT;
+    uint32_t dwThreads = 0;
+    uint32_t dwFail = 0, dwValid = 0;
+    uint32_t aThreads[2];
+    double dBest, dT0, dSingle = 0;
+    SunBatch_t *pBatch;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--messages") == 0 && i + 1 < argc) {
+            dwCount = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            dwThreads = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--keys") == 0 && i + 1 < argc) {
+            dwKeys = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [--messages <n>] [--threads <n>] [--keys <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (dwCount == 0U || dwKeys == 0U || dwKeys > SUN_BENCH_KEYS_MAX) {
+        fprintf(stderr, "messages must be > 0, keys 1..%u\n", SUN_BENCH_KEYS_MAX);
+        return 2;
+    }
+
+    s_msgs = calloc(dwCount, sizeof(*s_msgs));
+    s_inputs = calloc(dwCount, SUN_BENCH_INPUT_MAX);
+    s_expect = calloc(dwCount, sizeof(*s_expect));
+    pBatch = calloc(1, sizeof(*pBatch));
+    if (s_msgs == NULL || s_inputs == NULL || s_expect == NULL || pBatch == NULL || Bench_Setup() != 0) {
+        fprintf(stderr, "setup failed\n");
+        return 1;
+    }
+    Bench_BuildMessages(dwCount, dwKeys);
+
+    /* Single call path, also the reference for the batch results */
+    dBest = 1e30;
+    for (uint32_t r = 0; r < SUN_BENCH_ROUNDS; r++) {
+        dT0 = Bench_NowSec();
+        for (uint32_t m = 0; m < dwCount; m++) {
+            s_expect[m] = Bench_VerifySingle(&s_msgs[m]);
+        }
+        dT0 = Bench_NowSec() - dT0;
+        dBest = (dT0 < dBest) ? dT0 : dBest;
+    }
+    dSingle = (double)dwCount / dBest;
+    for (uint32_t m = 0; m < dwCount; m++) {
+        dwValid += (s_expect[m] == PH_ERR_SUCCESS) ? 1U : 0U;
+    }
+
+    printf("{\n  \"rev\": \"%s\",\n  \"messages\": %u,\n  \"keys\": %u,\n  \"valid\": %u,\n",
+           NFCRDLIB_BENCH_REV, dwCount, dwKeys, dwValid);
+    printf("  \"single_call\": { \"verify_per_s\": %.0f },\n  \"batch\": [\n", dSingle);
+
+    aThreads[0] = 1;
+    aThreads[1] = dwThreads;
+    for (uint32_t t = 0; t < 2U; t++) {
+        uint32_t dwMatched = 0;
+
+        if (SunBatch_Init(pBatch, &s_ks, aThreads[t]) != PH_ERR_SUCCESS) {
+            fprintf(stderr, "SunBatch_Init failed\n");
+            return 1;
+        }
+        /* --threads 0 on one CPU, or --threads 1: the single thread run is done already */
+        if (t != 0U && pBatch->dwThreads == 1U) {
+            SunBatch_DeInit(pBatch);
+            break;
+        }
+        dBest = 1e30;
+        for (uint32_t r = 0; r < SUN_BENCH_ROUNDS; r++) {
+            /* First round includes loading the keys, the best is the warm cache case */
+            dT0 = Bench_NowSec();
+            dwMatched = SunBatch_Verify(pBatch, s_msgs, dwCount);
+            dT0 = Bench_NowSec() - dT0;
+            dBest = (dT0 < dBest) ? dT0 : dBest;
+
+            for (uint32_t m = 0; m < dwCount; m++) {
+                if (s_msgs[m].wStatus != s_expect[m]) {
+                    if (dwFail < 5U) {
+                        fprintf(stderr, "message %u: batch %04X, single call %04X\n", m, s_msgs[m].wStatus,
+                                s_expect[m]);
+                    }
+                    dwFail++;
+                }
+            }
+        }
+        printf("%s    { \"threads\": %u, \"verify_per_s\": %.0f, \"speedup\": %.2f, \"matched\": %u }",
+               (t == 0U) ? "" : ",\n", pBatch->dwThreads, (double)dwCount / dBest, ((double)dwCount / dBest) / dSingle,
+               dwMatched);
+        SunBatch_DeInit(pBatch);
+    }
+    printf("\n  ],\n  \"verify\": { \"mismatches\": %u }\n}\n", dwFail);
+
+    free(pBatch);
+    free(s_expect);
+    free(s_inputs);
+    free(s_msgs);
+    return (dwFail == 0U) ? 0 : 1;
+}
@@ -54,12 +54,30 @@
 #include "phhalHw_Pn5180_Instr.h"
 #include "emv_transaction.h"  // 获取卡基本信息并打印
 #include "emv_payment_flow.h" // 卡交易支付流程
+#include "emv_sched.h"        // APDU等待期间运行后台任务
+#include "emv_oda.h"          // GPO的PDOL数据与不可预知数
+#include "lpcd_mgr.h"         // 自校准LPCD
+#include "rng_entropy.h"      // 硬件熵源与随机数池
+#include "boot_prof.h"        // 启动阶段计时
+#include "ram_budget.h"       // 快速启动时RAM报告推迟到第一次空闲
+#include "feedback.h"         // 定时器中断驱动的蜂鸣/LED提示
+#include "cmd_plan.h"         // 主机下发的命令计划
+#include "inventory_a.h"      // 叠放A卡一次全部列出
+#include "inventory_epc.h"    // 场内全部ISO18000-3m3标签
+#include "mfc_dump.h"         // MIFARE Classic整卡读取
+#include "icode_bulk.h"       // ISO15693标签整片存储区读取
+#include "felica_batch.h"     // 场内全部FeliCa卡片及多块读写
 
 /* defines */
 #define PH_OSAL_NULLOS         1
 #define ENABLE_DISC_CONFIG	// 1
 #define NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS  // 支持ISO14443A
 #define NXPBUILD__PHAC_DISCLOOP_TYPEV_TAGS  // 支持ISO15693
+#define INVENTORY_A_BUDGET_MS   200U    // 多张A卡盘点的时间上限 Type A inventory time budget
+#define MFC_DUMP_SIZE           1024U   // 整卡读取缓冲区，Mini/1K卡 Dump buffer, Mini and 1K cards
+#define ICODE_DUMP_SIZE         512U    // ICODE/NTAG 5读取缓冲区，超出部分不读 ISO15693 dump buffer, the rest is skipped
+#define FELICA_READ_SERVICE     0x000BU // 无需认证的只读服务 Read-only service without authentication
+#define FELICA_READ_BLOCKS      4U      // 每张FeliCa卡读取的块数 Blocks read from every FeliCa card
 /*******************************************************************************
 **   Definitions
 *******************************************************************************/
@@ -100,6 +118,13 @@ void TestRFField(void);
  */
 static uint16_t bSavePollTechCfg;
 static volatile uint8_t bInfLoop = 1U;
+static uint8_t bBootReported = 0U;
+
+#ifdef PH_EXAMPLE1_LPCD_MGR_ENABLE
+/* LPCD manager: self-calibrating reference, threshold and period follow the false-wake rate */
+static LpcdMgr_t sLpcdMgr;
+static uint8_t bLpcdMgrReady = 0U;
+#endif /* PH_EXAMPLE1_LPCD_MGR_ENABLE */
 
 /*******************************************************************************
 **   Prototypes
@@ -111,6 +136,22 @@ uint16_t NFCForumProcess(uint16_t wEntryPoint, phStatus_t DiscLoopStatus);
 #ifdef ENABLE_DISC_CONFIG
 static phStatus_t LoadProfile(phacDiscLoop_Profile_t bProfile);
 #endif /* ENABLE_DISC_CONFIG */
+static void CmdPlanProcess(void);
+#ifdef NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS
+static void InventoryAProcess(void);
+#endif /* NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS */
+#ifdef NXPBUILD__PHAC_DISCLOOP_I18000P3M3_TAGS
+static void InventoryEpcProcess(void);
+#endif /* NXPBUILD__PHAC_DISCLOOP_I18000P3M3_TAGS */
+#ifdef NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS
+static void MfcDumpProcess(void);
+#endif /* NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS */
+#ifdef NXPBUILD__PHAC_DISCLOOP_TYPEV_TAGS
+static void IcodeDumpProcess(void);
+#endif /* NXPBUILD__PHAC_DISCLOOP_TYPEV_TAGS */
+#ifdef NXPBUILD__PHAC_DISCLOOP_FELICA_TAGS
+static void FelicaBatchProcess(void);
+#endif /* NXPBUILD__PHAC_DISCLOOP_FELICA_TAGS */
 
 /*******************************************************************************
 **   Code
@@ -147,25 +188,41 @@ int nfc_discovery_main(void)
         dwStatus = phNfcLib_SetContext(&AppContext);
         CHECK_NFCLIB_STATUS(dwStatus);
 #endif
+        BootProf_Mark(BOOT_PHASE_BAL);
 
         /* 4.初始化NFC库：Initialize library */
         dwStatus = phNfcLib_Init();
         CHECK_NFCLIB_STATUS(dwStatus);
         if(dwStatus != PH_NFCLIB_STATUS_SUCCESS) break;
+        BootProf_Mark(BOOT_PHASE_NFCLIB);
 
         /* 5. 获取关键组件指针：Set the generic pointer */
         pHal = phNfcLib_GetDataParams(PH_COMP_HAL);			// 硬件抽象层
         pDiscLoop = phNfcLib_GetDataParams(PH_COMP_AC_DISCLOOP);	// Discovery Loop 组件
 
+#ifdef NXPBUILD__PH_CRYPTORNG_SW
+        /* 用STM32 RNG为DRBG播种并预生成随机数池：Seed the DRBG from the RNG peripheral and fill its pool */
+#if BOOT_FAST
+        /* 推迟到第一次空闲或第一张卡 Deferred to the first idle time or the first card */
+        status = RngEntropy_DeferAttach(phNfcLib_GetDataParams(PH_COMP_CRYPTORNG));
+#else
+        status = RngEntropy_AttachDrbg(phNfcLib_GetDataParams(PH_COMP_CRYPTORNG));
+#endif /* BOOT_FAST */
+        CHECK_STATUS(status);
+#endif /* NXPBUILD__PH_CRYPTORNG_SW */
+        BootProf_Mark(BOOT_PHASE_DRBG);
+
         /* 6.初始化其他组件：Initialize other components that are not initialized by NFCLIB and configure Discovery Loop. */
         status = phApp_Comp_Init(pDiscLoop);
         CHECK_STATUS(status);
         if(status != PH_ERR_SUCCESS) break;
+        BootProf_Mark(BOOT_PHASE_COMP);
 
         /* 7.配置中断：Perform Platform Init */
         status = phApp_Configure_IRQ();
         CHECK_STATUS(status);
         if(status != PH_ERR_SUCCESS) break;
+        BootProf_Mark(BOOT_PHASE_IRQ);
 
 #ifndef PH_OSAL_NULLOS
 
@@ -240,12 +297,14 @@ void DiscoveryLoop_Demo(void  *pDataParams)
     /* 4. 关闭射频场，准备进行新一轮发现（防止错误识别）Switch off RF field */
     statustmp = phhalHw_FieldOff(pHal);
     CHECK_STATUS(statustmp);
+    BootProf_Mark(BOOT_PHASE_PROFILE);
 //1    DEBUG_PRINTF("RF Field OFF status: 0x%04X\r\n", statustmp);
 
 //1    TestRFField();
 
     while(1)
     {
+        BootProf_Mark(BOOT_PHASE_FIRST_POLL);	/* 只记录第一次 Only the first cycle is stamped */
     	DEBUG_PRINTF("Poll cycle start...\r\n");
 
         /* 每一次轮询开始前将轮询状态设为"检测中"，有些场景中如果上一次卡片未移除，需设置成"removal"状态
@@ -258,10 +317,6 @@ void DiscoveryLoop_Demo(void  *pDataParams)
 
 #ifdef NXPBUILD__PHHAL_HW_RC663
         if (wEntryPoint == PHAC_DISCLOOP_ENTRY_POINT_POLL)
-#else
-        /* Configure LPCD */
-        if ((status & PH_ERR_MASK) == PHAC_DISCLOOP_LPCD_NO_TECH_DETECTED)
-#endif
         {
             status = phApp_ConfigureLPCD();
             CHECK_STATUS(status);
@@ -270,8 +325,30 @@ void DiscoveryLoop_Demo(void  *pDataParams)
         /* Bool to enable LPCD feature. */
         status = phacDiscLoop_SetConfig(pDataParams, PHAC_DISCLOOP_CONFIG_ENABLE_LPCD, PH_ON);
         CHECK_STATUS(status);
+#endif
 #endif /* PH_EXAMPLE1_LPCD_ENABLE*/
 
+#ifdef PH_EXAMPLE1_LPCD_MGR_ENABLE
+        /* LPCD由LpcdMgr执行，唤醒后再运行发现循环，以统计误唤醒和唤醒到激活的延迟
+         * LPCD is run by the manager, the discovery loop polls after the wake-up */
+        if (wEntryPoint == PHAC_DISCLOOP_ENTRY_POINT_POLL)
+        {
+            if (!bLpcdMgrReady)
+            {
+                status = LpcdMgr_Init(&sLpcdMgr, pHal, NULL);
+                CHECK_STATUS(status);
+                bLpcdMgrReady = 1U;
+            }
+            status = LpcdMgr_Arm(&sLpcdMgr);
+            CHECK_STATUS(status);
+            status = LpcdMgr_Wait(&sLpcdMgr);
+            CHECK_STATUS(status);
+        }
+
+        status = phacDiscLoop_SetConfig(pDataParams, PHAC_DISCLOOP_CONFIG_ENABLE_LPCD, PH_OFF);
+        CHECK_STATUS(status);
+#endif /* PH_EXAMPLE1_LPCD_MGR_ENABLE */
+
         /* 启动轮询核心函数
          * Start discovery loop */
         /* PROGRAM BLOCK HERE at first, problem is solved */
@@ -279,11 +356,25 @@ void DiscoveryLoop_Demo(void  *pDataParams)
         /* 输出：0x4080  或者  0x4083, 是否表示错误? 成功检测到卡返回0x408B */
         DEBUG_PRINTF("Discovery result: 0x%04X\r\n", status);
 
+#ifdef PH_EXAMPLE1_LPCD_MGR_ENABLE
+        /* 唤醒后未发现任何卡/设备即为误唤醒 A wake-up without any technology or device is a false wake */
+        LpcdMgr_OnDiscovery(&sLpcdMgr, (uint8_t)((((status & PH_ERR_MASK) >= PHAC_DISCLOOP_MULTI_TECH_DETECTED) &&
+                                                   ((status & PH_ERR_MASK) <= PHAC_DISCLOOP_ACTIVATED_BY_PEER)) ||
+                                                  ((status & PH_ERR_MASK) == PHAC_DISCLOOP_NO_DEVICE_RESOLVED) ||
+                                                  ((status & PH_ERR_MASK) == PHAC_DISCLOOP_COLLISION_PENDING)));
+#endif /* PH_EXAMPLE1_LPCD_MGR_ENABLE */
+
         /* ========== EMV交易处理集成点 ========== */
         if((status & PH_ERR_MASK) == PHAC_DISCLOOP_DEVICE_ACTIVATED)
         {
             DEBUG_PRINTF("Card activated, checking EMV compatibility\r\n");
 
+#ifdef NXPBUILD__PH_CRYPTORNG_SW
+            /* 卡在第一次空闲前到达时，在这里完成推迟的DRBG播种 First card before the first idle time */
+            statustmp = RngEntropy_AttachPending();
+            CHECK_STATUS(statustmp);
+#endif /* NXPBUILD__PH_CRYPTORNG_SW */
+
             /* 检查是否为EMV兼容卡片 */
             if (EMV_IsEMVCompatibleCard(pDataParams))
             {
@@ -304,6 +395,13 @@ void DiscoveryLoop_Demo(void  *pDataParams)
                 /* 继续下一次轮询 */
                 continue;
             }
+            else if (CmdPlan_IsLoaded())
+            {
+                /* 主机已下发命令计划：在这张卡上执行并回传结果，卡片移开后继续轮询 */
+                CmdPlanProcess();
+                EMV_WaitForCardRemoval(pDataParams);
+                continue;
+            }
             else
             {
                 DEBUG_PRINTF("Non-EMV card, using original processing flow\r\n");
@@ -334,11 +432,256 @@ void DiscoveryLoop_Demo(void  *pDataParams)
             CHECK_STATUS(statustmp);	// error
 
             DEBUG_PRINTF("Poll cycle complete, waiting...\r\n");
+            (void)CmdPlan_PollHost();  /* 空闲时处理主机的命令计划上传 Host plan upload */
+#ifdef NXPBUILD__PH_CRYPTORNG_SW
+            RngEntropy_Idle();  /* 空闲时补充随机数池 Refill the random pool while idle */
+#endif /* NXPBUILD__PH_CRYPTORNG_SW */
+            if (!bBootReported)
+            {
+                /* 第一次空闲时打印启动各阶段耗时 Boot profile once the reader is polling */
+                bBootReported = 1U;
+                BootProf_Report();
+#if BOOT_FAST
+                RamBudget_Report();
+#endif /* BOOT_FAST */
+            }
             HAL_Delay(1000);  // 1秒延时，方便观察
         }
     }
 }
 
+/* 执行主机下发的命令计划：
+ * phNfcLib_Transmit/Receive 需要简化API的激活状态，发现循环激活的卡先复位场再由 phNfcLib_Activate 重新激活
+ */
+static void CmdPlanProcess(void)
+{
+    phNfcLib_Status_t dwStatus;
+    phNfcLib_PeerInfo_t sPeerInfo = {0};
+    phStatus_t statustmp;
+
+    DEBUG_PRINTF("Non-EMV card, running the host command plan\r\n");
+
+    statustmp = phhalHw_FieldReset(pHal);
+    CHECK_STATUS(statustmp);
+
+    dwStatus = phNfcLib_Activate(PH_NFCLIB_TECHNOLOGY_INITIATOR_ISO_14443_A | PH_NFCLIB_TECHNOLOGY_INITIATOR_ISO_15693,
+                                 &sPeerInfo, NULL);
+    if (dwStatus == PH_NFCLIB_STATUS_PEER_ACTIVATION_DONE)
+    {
+        /* ISO15693命令总是带地址发送 Addressed ISO15693 exchanges */
+        if (sPeerInfo.dwActivatedType == E_PH_NFCLIB_ISO15693)
+        {
+            CmdPlan_SetUid(sPeerInfo.uTi.uInitiator.tIso15693.TagIndex[0].pUid);
+        }
+        (void)CmdPlan_RunAndReport();
+    }
+    else
+    {
+        DEBUG_PRINTF("Plan: card not activated, status 0x%08lX\r\n", (unsigned long)dwStatus);
+    }
+    (void)phNfcLib_Deactivate(PH_NFCLIB_DEACTIVATION_MODE_RF_OFF, &sPeerInfo);
+
+    /* 简化API改写了轮询技术配置，恢复 Restore the poll configuration changed by phNfcLib_Activate */
+    statustmp = phacDiscLoop_SetConfig(pDiscLoop, PHAC_DISCLOOP_CONFIG_PAS_POLL_TECH_CFG, bSavePollTechCfg);
+    CHECK_STATUS(statustmp);
+}
+
+#ifdef NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS
+/* 盘点场内全部A卡，已解析的卡片被HALT，结果放在静态区
+ * Every Type A card in the field, resolved cards are left halted */
+static void InventoryAProcess(void)
+{
+    static InventoryA_Result_t sInventoryA;
+    phStatus_t status;
+    uint8_t bIndex;
+
+    status = InventoryA_Run(pDiscLoop->pPal1443p3aDataParams, INVENTORY_A_BUDGET_MS, &sInventoryA);
+    if (status != PH_ERR_SUCCESS)
+    {
+        DEBUG_PRINTF("\tType A inventory failed: 0x%04X\n", status);
+        return;
+    }
+
+    for (bIndex = 0; bIndex < sInventoryA.count; bIndex++)
+    {
+        DEBUG_PRINTF("\tCard %d UID: ", bIndex + 1);
+        phApp_Print_Buff(sInventoryA.cards[bIndex].uid, sInventoryA.cards[bIndex].uid_len);
+        DEBUG_PRINTF(" SAK: 0x%02X ATQA: %02X %02X\n", sInventoryA.cards[bIndex].sak,
+                     sInventoryA.cards[bIndex].atqa[0], sInventoryA.cards[bIndex].atqa[1]);
+    }
+    DEBUG_PRINTF("\t%d Type A cards, %u frames, %lu ms%s\n", sInventoryA.count, sInventoryA.frames,
+                 (unsigned long)sInventoryA.elapsed_ms, sInventoryA.complete ? "" : ", more cards left");
+}
+#endif /* NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS */
+
+#ifdef NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS
+/* MIFARE Classic常用的公开密钥 Well known MIFARE Classic keys */
+static const uint8_t aMfcKeys[][PHPAL_MIFARE_KEY_LENGTH] = {
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },     // 出厂默认 Transport key
+    { 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5 },     // MAD key A
+    { 0xD3, 0xF7, 0xD3, 0xF7, 0xD3, 0xF7 },     // NDEF key A
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+};
+
+/* 读取已激活的MIFARE Classic卡全部扇区，同一张卡再次出现时直接使用缓存的扇区密钥
+ * Dump the activated MIFARE Classic card, the next tap of the same UID uses the cached keys */
+static void MfcDumpProcess(void)
+{
+    static uint8_t aMfcDump[MFC_DUMP_SIZE];
+    static MfcDump_Result_t sMfcDump;
+    phStatus_t status;
+    uint8_t bSak = pDiscLoop->sTypeATargetInfo.aTypeA_I3P3[0].aSak;
+    uint8_t bSector;
+
+    if (MfcDump_SectorOffset(MfcDump_SectorCount(bSak)) > sizeof(aMfcDump))
+    {
+        DEBUG_PRINTF("\tMIFARE Classic %d sectors, larger than the dump buffer\n", MfcDump_SectorCount(bSak));
+        return;
+    }
+
+    status = MfcDump_Run(pDiscLoop->pPal1443p3aDataParams, phNfcLib_GetDataParams(PH_COMP_PAL_MIFARE),
+                         pDiscLoop->sTypeATargetInfo.aTypeA_I3P3[0].aUid,
+                         pDiscLoop->sTypeATargetInfo.aTypeA_I3P3[0].bUidSize, bSak,
+                         aMfcKeys, (uint8_t)(sizeof(aMfcKeys) / sizeof(aMfcKeys[0])),
+                         aMfcDump, sizeof(aMfcDump), &sMfcDump);
+    if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS && (status & PH_ERR_MASK) != PH_ERR_AUTH_ERROR)
+    {
+        DEBUG_PRINTF("\tMIFARE Classic dump failed: 0x%04X\n", status);
+        return;
+    }
+
+    for (bSector = 0; bSector < sMfcDump.sectors; bSector++)
+    {
+        if (sMfcDump.sector_key[bSector] == MFC_DUMP_KEY_NONE)
+        {
+            DEBUG_PRINTF("\tSector %2d: no key\n", bSector);
+            continue;
+        }
+        DEBUG_PRINTF("\tSector %2d key %c%d: ", bSector, (sMfcDump.sector_key[bSector] & MFC_DUMP_KEY_B) ? 'B' : 'A',
+                     sMfcDump.sector_key[bSector] & ~MFC_DUMP_KEY_B);
+        phApp_Print_Buff(&aMfcDump[MfcDump_SectorOffset(bSector)],
+                         (uint8_t)(MfcDump_SectorOffset(bSector + 1U) - MfcDump_SectorOffset(bSector)));
+        DEBUG_PRINTF("\n");
+    }
+}
+#endif /* NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS */
+
+#ifdef NXPBUILD__PHAC_DISCLOOP_TYPEV_TAGS
+/* 读取已激活ISO15693标签的用户存储区，标签支持时切换到更高速率
+ * Dump the activated ISO15693 tag, at a higher data rate when the tag offers one */
+static void IcodeDumpProcess(void)
+{
+    static uint8_t aIcodeDump[ICODE_DUMP_SIZE];
+    static IcodeBulk_Result_t sIcodeDump;
+    phStatus_t status;
+    uint16_t wOffset;
+
+    /* PN5180接收ISO15693最高53kbit/s PN5180 receives ISO15693 up to 53 kbit/s */
+    status = IcodeBulk_ReadAll(phNfcLib_GetDataParams(PH_COMP_AL_ICODE), ICODE_BULK_RATE_53,
+                               aIcodeDump, sizeof(aIcodeDump), &sIcodeDump);
+    if (status != PH_ERR_SUCCESS)
+    {
+        DEBUG_PRINTF("\tICODE dump failed after %u bytes: 0x%04X\n", sIcodeDump.bytes, status);
+        return;
+    }
+
+    DEBUG_PRINTF("\t%u blocks x %u bytes, %u read in %lu ms:\n", sIcodeDump.blocks, sIcodeDump.block_size,
+                 sIcodeDump.bytes, (unsigned long)sIcodeDump.elapsed_ms);
+    for (wOffset = 0; wOffset < sIcodeDump.bytes; wOffset += 16U)
+    {
+        DEBUG_PRINTF("\t%04X: ", wOffset);
+        phApp_Print_Buff(&aIcodeDump[wOffset], (uint8_t)(((sIcodeDump.bytes - wOffset) < 16U) ? (sIcodeDump.bytes - wOffset) : 16U));
+        DEBUG_PRINTF("\n");
+    }
+}
+#endif /* NXPBUILD__PHAC_DISCLOOP_TYPEV_TAGS */
+
+#ifdef NXPBUILD__PHAC_DISCLOOP_FELICA_TAGS
+/* 发现循环只激活一张FeliCa卡，这里轮询场内全部卡片，每张读取前几块
+ * The discovery loop activates one FeliCa card: poll all of them and read the first blocks of each */
+static void FelicaBatchProcess(void)
+{
+    static const uint8_t aSystemCode[2] = { 0xFF, 0xFF };
+    static FelicaBatch_Card_t aCards[FELICA_BATCH_MAX_CARDS];
+    static uint8_t aBlocks[FELICA_READ_BLOCKS * FELICA_BATCH_BLOCK_SIZE];
+    phpalFelica_Sw_DataParams_t *pPalFelica = phNfcLib_GetDataParams(PH_COMP_PAL_FELICA);
+    FelicaBatch_Item_t aItems[FELICA_READ_BLOCKS];
+    FelicaBatch_Stats_t sStats;
+    phStatus_t status;
+    uint8_t bCount;
+    uint8_t bIndex;
+    uint8_t bBlock;
+
+    status = FelicaBatch_Poll(pPalFelica, aSystemCode, aCards, &bCount);
+    if (status != PH_ERR_SUCCESS)
+    {
+        DEBUG_PRINTF("\tFeliCa poll failed: 0x%04X\n", status);
+        return;
+    }
+
+    for (bBlock = 0; bBlock < FELICA_READ_BLOCKS; bBlock++)
+    {
+        aItems[bBlock].service = FELICA_READ_SERVICE;
+        aItems[bBlock].block = bBlock;
+    }
+
+    for (bIndex = 0; bIndex < bCount; bIndex++)
+    {
+        DEBUG_PRINTF("\tCard %d %s kbit/s IDm: ", bIndex + 1, (aCards[bIndex].rate == FELICA_BATCH_RATE_424) ? "424" : "212");
+        phApp_Print_Buff(aCards[bIndex].idm_pmm, 8);
+        DEBUG_PRINTF("\n");
+
+        status = FelicaBatch_SelectCard(pPalFelica, &aCards[bIndex]);
+        if (status == PH_ERR_SUCCESS)
+        {
+            status = FelicaBatch_Read(phNfcLib_GetDataParams(PH_COMP_AL_FELICA), aItems, FELICA_READ_BLOCKS, aBlocks, &sStats);
+        }
+        if (status != PH_ERR_SUCCESS)
+        {
+            DEBUG_PRINTF("\t\tRead failed: 0x%04X\n", status);
+            continue;
+        }
+        for (bBlock = 0; bBlock < FELICA_READ_BLOCKS; bBlock++)
+        {
+            DEBUG_PRINTF("\t\tBlock %d: ", bBlock);
+            phApp_Print_Buff(&aBlocks[bBlock * FELICA_BATCH_BLOCK_SIZE], FELICA_BATCH_BLOCK_SIZE);
+            DEBUG_PRINTF("\n");
+        }
+    }
+}
+#endif /* NXPBUILD__PHAC_DISCLOOP_FELICA_TAGS */
+
+#ifdef NXPBUILD__PHAC_DISCLOOP_I18000P3M3_TAGS
+/* 轮询的设备上限为1，发现循环只报告第一张标签，这里盘点场内全部18000-3m3标签
+ * The poll device limit is 1, the discovery loop stops at the first tag: inventory all of them */
+static void InventoryEpcProcess(void)
+{
+    static InventoryEpc_Result_t sInventoryEpc;
+    InventoryEpc_Config_t sConfig;
+    phStatus_t status;
+    uint8_t bIndex;
+
+    InventoryEpc_DefaultConfig(&sConfig);
+    status = InventoryEpc_Run(pDiscLoop->pPal18000p3m3DataParams, &sConfig, &sInventoryEpc);
+    if (status != PH_ERR_SUCCESS)
+    {
+        DEBUG_PRINTF("\tEPC inventory failed: 0x%04X\n", status);
+        return;
+    }
+
+    for (bIndex = 0; bIndex < sInventoryEpc.count; bIndex++)
+    {
+        DEBUG_PRINTF("\tTag %d PC: %02X %02X UII: ", bIndex + 1, sInventoryEpc.tags[bIndex].pc[0],
+                     sInventoryEpc.tags[bIndex].pc[1]);
+        phApp_Print_Buff(sInventoryEpc.tags[bIndex].uii, sInventoryEpc.tags[bIndex].uii_len);
+        DEBUG_PRINTF("\n");
+    }
+    DEBUG_PRINTF("\t%u EPC tags, %d rounds, last Q %d, %lu ms%s\n", sInventoryEpc.tags_seen, sInventoryEpc.rounds,
+                 sInventoryEpc.last_q, (unsigned long)sInventoryEpc.elapsed_ms,
+                 sInventoryEpc.complete ? "" : ", more tags left");
+}
+#endif /* NXPBUILD__PHAC_DISCLOOP_I18000P3M3_TAGS */
+
 /* 应用层主逻辑处理函数：
  * 1.输出识别到的卡信息
  * 2.执行冲突解决和卡激活
@@ -422,6 +765,15 @@ uint16_t NFCForumProcess(uint16_t wEntryPoint, phStatus_t DiscLoopStatus)
             DEBUG_PRINTF (" \n Multiple cards resolved: %d cards \n",wNumberOfTags);
             phApp_PrintTagInfo(pDiscLoop, wNumberOfTags, wTechDetected);
 
+#ifdef NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS
+            if((wNumberOfTags > 1) && (wTechDetected == PHAC_DISCLOOP_POS_BIT_MASK_A))
+            {
+                /* 叠放的多张A卡(票卡、卡包)：列出全部卡片，而不只激活第一张
+                 * Stacked Type A cards: every UID/SAK/ATQA instead of activating index 0 */
+                InventoryAProcess();
+            }
+            else
+#endif /* NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS */
             if(wNumberOfTags > 1)
             {
                 /* Get 1st Detected Technology and Activate device at index 0 */
@@ -488,6 +840,37 @@ uint16_t NFCForumProcess(uint16_t wEntryPoint, phStatus_t DiscLoopStatus)
 
             phApp_PrintTagInfo(pDiscLoop, wNumberOfTags, wTechDetected);
 
+#ifdef NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS
+            if(PHAC_DISCLOOP_CHECK_ANDMASK(wTechDetected, PHAC_DISCLOOP_POS_BIT_MASK_A) &&
+               (MfcDump_SectorCount(pDiscLoop->sTypeATargetInfo.aTypeA_I3P3[0].aSak) != 0U))
+            {
+                /* MIFARE Classic：读出全部扇区 */
+                MfcDumpProcess();
+            }
+#endif /* NXPBUILD__PHAC_DISCLOOP_TYPEA_TAGS */
+#ifdef NXPBUILD__PHAC_DISCLOOP_TYPEV_TAGS
+            if(PHAC_DISCLOOP_CHECK_ANDMASK(wTechDetected, PHAC_DISCLOOP_POS_BIT_MASK_V))
+            {
+                /* ICODE/NTAG 5：读出全部用户存储区 */
+                IcodeDumpProcess();
+            }
+#endif /* NXPBUILD__PHAC_DISCLOOP_TYPEV_TAGS */
+#ifdef NXPBUILD__PHAC_DISCLOOP_FELICA_TAGS
+            if(PHAC_DISCLOOP_CHECK_ANDMASK(wTechDetected, PHAC_DISCLOOP_POS_BIT_MASK_F212) ||
+               PHAC_DISCLOOP_CHECK_ANDMASK(wTechDetected, PHAC_DISCLOOP_POS_BIT_MASK_F424))
+            {
+                /* FeliCa：场内全部卡片，各读前几块 */
+                FelicaBatchProcess();
+            }
+#endif /* NXPBUILD__PHAC_DISCLOOP_FELICA_TAGS */
+#ifdef NXPBUILD__PHAC_DISCLOOP_I18000P3M3_TAGS
+            if(PHAC_DISCLOOP_CHECK_ANDMASK(wTechDetected, PHAC_DISCLOOP_POS_BIT_MASK_18000P3M3))
+            {
+                /* 堆叠标签(StackIt等)：列出全部UII */
+                InventoryEpcProcess();
+            }
+#endif /* NXPBUILD__PHAC_DISCLOOP_I18000P3M3_TAGS */
+
             /* Switch to LISTEN mode after POLL mode */
         }
         else if((DiscLoopStatus & PH_ERR_MASK) == PHAC_DISCLOOP_ACTIVE_TARGET_ACTIVATED)
@@ -1179,11 +1562,18 @@ void EMV_WaitForCardRemoval(void *pDataParams)
     // Run removal detection
     phStatus_t status;
     int removal_attempts = 0;
+    uint8_t prompted = 0;
     do {
         status = phacDiscLoop_Run(pDiscLoop, PHAC_DISCLOOP_ENTRY_POINT_POLL);
         HAL_Delay(100);
         removal_attempts++;
 
+        // Card still there once the result pattern has played: repeat the remove-card beep
+        if (!prompted && Feedback_Current() == FEEDBACK_NONE) {
+            Feedback_Play(FEEDBACK_REMOVE_CARD);
+            prompted = 1;
+        }
+
         // Avoid infinite waiting
         if (removal_attempts > 100) { // 10 seconds timeout
             DEBUG_PRINTF("Card removal detection timeout\r\n");
@@ -1191,6 +1581,9 @@ void EMV_WaitForCardRemoval(void *pDataParams)
         }
     } while ((status & PH_ERR_MASK) != PHAC_DISCLOOP_NO_TECH_DETECTED);
 
+    if (Feedback_Current() == FEEDBACK_REMOVE_CARD) {
+        Feedback_Stop();
+    }
     DEBUG_PRINTF("Card removed\r\n");
 
     // Reset to detection mode, prepare for next polling
@@ -1336,18 +1729,41 @@ EMV_Result_t EMV_CollectApplicationInfo(EMV_Complete_Card_Data_t *card_data)
 // ==================================================
 EMV_Result_t EMV_CollectGPOInfo(EMV_Complete_Card_Data_t *card_data)
 {
-    uint8_t gpo_apdu[] = {
-        0x80, 0xA8, 0x00, 0x00, 0x02, 0x83, 0x00, 0x00
-    };
+    // 80 A8 00 00 Lc 83 L [PDOL数据] 00
+    uint8_t gpo_apdu[5 + 2 + 128 + 1];
+    uint16_t gpo_len = 0;
+    int pdol_len;
 
     phStatus_t status;
     uint8_t *ppRxBuffer;
     uint16_t wRxLen = 0;
 
+    // 每笔交易新的不可预知数(9F37), 来自DRBG, fDDA/DDA签名都覆盖它
+    if (EMV_ODA_Unpredictable(card_data->unpredictable_number, sizeof(card_data->unpredictable_number)) != 0) {
+        return EMV_ERROR_GPO;
+    }
+
+    // 按选择应用响应中的PDOL(9F38)填入终端数据, 没有PDOL时发送空的83模板
+    pdol_len = EMV_ODA_BuildPdol(card_data, &gpo_apdu[7], 128);
+    if (pdol_len < 0) {
+        DEBUG_PRINTF("PDOL too long\r\n");
+        return EMV_ERROR_GPO;
+    }
+
+    gpo_apdu[gpo_len++] = 0x80;  // CLA
+    gpo_apdu[gpo_len++] = 0xA8;  // INS: GET PROCESSING OPTIONS
+    gpo_apdu[gpo_len++] = 0x00;  // P1
+    gpo_apdu[gpo_len++] = 0x00;  // P2
+    gpo_apdu[gpo_len++] = (uint8_t)(pdol_len + 2);  // Lc
+    gpo_apdu[gpo_len++] = 0x83;  // 命令模板
+    gpo_apdu[gpo_len++] = (uint8_t)pdol_len;
+    gpo_len += (uint16_t)pdol_len;
+    gpo_apdu[gpo_len++] = 0x00;  // Le
+
     status = phpalI14443p4_Exchange(
         phNfcLib_GetDataParams(PH_COMP_PAL_ISO14443P4),
         PH_EXCHANGE_DEFAULT,
-        gpo_apdu, sizeof(gpo_apdu),
+        gpo_apdu, gpo_len,
         &ppRxBuffer, &wRxLen
     );
 
@@ -1376,7 +1792,7 @@ EMV_Result_t EMV_CollectAllRecords(EMV_Complete_Card_Data_t *card_data)
     uint8_t sfi_list[] = {1, 2, 3, 4};
     uint8_t max_records_per_sfi = 5;
 
-    card_data->sfi_record_count = 0;
+    // sfi_record_count由EMV_Payment_Initialize清零, 续接交易时已含断开前读到的记录
 
     for (int sfi_idx = 0; sfi_idx < sizeof(sfi_list); sfi_idx++) {
         uint8_t sfi = sfi_list[sfi_idx];
@@ -1389,15 +1805,30 @@ EMV_Result_t EMV_CollectAllRecords(EMV_Complete_Card_Data_t *card_data)
             phStatus_t status;
             uint8_t *ppRxBuffer;
             uint16_t wRxLen = 0;
+            uint8_t cached = 0;
 
-            status = phpalI14443p4_Exchange(
-                phNfcLib_GetDataParams(PH_COMP_PAL_ISO14443P4),
-                PH_EXCHANGE_DEFAULT,
-                read_record_apdu, sizeof(read_record_apdu),
-                &ppRxBuffer, &wRxLen
-            );
+            // 断开前已读取的记录不再重读
+            for (uint8_t i = 0; i < card_data->sfi_record_count; i++) {
+                if (card_data->sfi_record_sfi[i] == sfi && card_data->sfi_record_num[i] == record) {
+                    cached = 1;
+                    break;
+                }
+            }
+            if (cached) {
+                continue;
+            }
+
+            // 卡片处理期间上传已读取的记录
+            status = EMV_Sched_ExchangeApdu(read_record_apdu, sizeof(read_record_apdu),
+                                            &ppRxBuffer, &wRxLen);
+
+            if (status != PH_ERR_SUCCESS) {
+                // 卡片离开射频场, 已读取的记录保留给下次挥卡
+                DEBUG_PRINTF("READ RECORD SFI %d Record %d failed: 0x%04X\r\n", sfi, record, status);
+                return EMV_ERROR_COMMUNICATION;
+            }
 
-            if (status == PH_ERR_SUCCESS && wRxLen >= 2) {
+            if (wRxLen >= 2) {
                 uint8_t sw1 = ppRxBuffer[wRxLen-2];
                 uint8_t sw2 = ppRxBuffer[wRxLen-1];
 
@@ -1405,10 +1836,15 @@ EMV_Result_t EMV_CollectAllRecords(EMV_Complete_Card_Data_t *card_data)
                     // 成功读取记录
                     if (card_data->sfi_record_count < 10) {
                         card_data->sfi_record_lens[card_data->sfi_record_count] = wRxLen;
+                        card_data->sfi_record_sfi[card_data->sfi_record_count] = sfi;
+                        card_data->sfi_record_num[card_data->sfi_record_count] = record;
                         memcpy(card_data->sfi_records[card_data->sfi_record_count],
                                ppRxBuffer, wRxLen);
                         card_data->sfi_record_count++;
 
+                        /* Dropped when the uplink ring is full, sent again after the read */
+                        (void)EMV_QueueRecordToLinux(sfi, record, ppRxBuffer, wRxLen);
+
                         DEBUG_PRINTF("SFI %d Record %d: %d bytes\r\n", sfi, record, wRxLen-2);
                     }
                 } else {
@@ -1537,14 +1973,18 @@ EMV_Result_t EMV_WaitForLinuxResult(EMV_Complete_Card_Data_t *card_data)
 void EMV_ShowSuccessIndication(void)
 {
     DEBUG_PRINTF("Transaction Successful!\r\n");
-    // 可以添加LED闪烁、蜂鸣器提示等
-    // beep_start(2, 200);  // 成功提示音
+    Feedback_Play(FEEDBACK_SUCCESS);  // 成功提示音，TIM7中断播放，不阻塞
 }
 
 void EMV_ShowFailureIndication(void)
 {
     DEBUG_PRINTF("Transaction Failed!\r\n");
-    // 可以添加LED闪烁、蜂鸣器提示等
-    // beep_start(3, 100);  // 失败提示音
+    Feedback_Play(FEEDBACK_FAILURE);  // 失败提示音
+}
+
+void EMV_ShowCardTooSlowIndication(void)
+{
+    DEBUG_PRINTF("Card left the field too early, please tap again!\r\n");
+    Feedback_Play(FEEDBACK_TOO_SLOW); // 短-短-长
 }
 
@@ -37,6 +37,12 @@ int nfc_discovery_main(void);
 //1        #define PH_EXAMPLE1_LPCD_ENABLE             /* If LPCD needs to be configured and used over HAL or over DiscLoop */
 #endif
 
+/* PN5180：发现循环之前由LpcdMgr执行自校准的掉电LPCD，EMVCo模式下同样有效
+ * Self-calibrating power-down LPCD run by LpcdMgr ahead of the discovery loop, also with the EMVCo profile */
+#if defined (NXPBUILD__PHHAL_HW_PN5180)
+        #define PH_EXAMPLE1_LPCD_MGR_ENABLE
+#endif
+
 
 /* Enables configuring of Discovery loop */
 #define ENABLE_DISC_CONFIG
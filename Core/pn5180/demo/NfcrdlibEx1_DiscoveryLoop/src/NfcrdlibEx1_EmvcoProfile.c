@@ -25,6 +25,7 @@
 #include <phApp_Init.h>
 #include <NfcrdlibEx1_DiscoveryLoop.h>
 #include <NfcrdlibEx1_EmvcoProfile.h>
+#include <emvco_analyzer.h>
 
 #ifdef ENABLE_EMVCO_PROF
 /*******************************************************************************
@@ -35,6 +36,7 @@
 #define MiN_VALID_DATA_SIZE                     6
 #define PHAC_EMVCO_MAX_BUFFSIZE               600               /**< Maximum buffer size for Emvco. */
 //#define RUN_TEST_SUIT
+//#define EMVCO_ANALYZER                                        /**< Time each loopback exchange, summary frames to the host instead of APDU dumps */
 
 typedef enum{
     eEmdRes_EOT = 0x70,
@@ -101,6 +103,18 @@ void EmvcoProfileProcess (phacDiscLoop_Sw_DataParams_t * pDataParams,phStatus_t
 {
 	phStatus_t status = eDiscStatus;
 
+#ifdef EMVCO_ANALYZER
+	static uint8_t bAnalyzerInit = 0;
+
+	if (!bAnalyzerInit)
+	{
+		EmvcoAnalyzer_Init(phNfcLib_GetDataParams(PH_COMP_PAL_ISO14443P4));
+		bAnalyzerInit = 1;
+	}
+	/* Windows without a card are reported too */
+	EmvcoAnalyzer_Poll();
+#endif
+
 	if((status & PH_ERR_MASK) == PHAC_DISCLOOP_DEVICE_ACTIVATED)
 	{
 		status = EmvcoDataLoopBack(pDataParams);
@@ -134,6 +148,9 @@ static void EmvcoRfReset(phacDiscLoop_Sw_DataParams_t * pDataParams)
     status = phhalHw_FieldOn(pDataParams->pHalDataParams);
     CHECK_STATUS(status);
 
+#ifdef EMVCO_ANALYZER
+    EmvcoAnalyzer_RfReset();
+#endif
 }
 
 /**
@@ -154,6 +171,9 @@ static phStatus_t EmvcoDataLoopBack(phacDiscLoop_Sw_DataParams_t * pDataParams)
     uint8_t bRemovalProcedure = PH_OFF;
     cmdsize = sizeof(PPSE_SELECT_APDU);
 
+#ifdef EMVCO_ANALYZER
+    EmvcoAnalyzer_Loopback();
+#endif
     status = EmvcoDataExchange(PPSE_SELECT_APDU, cmdsize, &response_buffer, &respsize);
 
 #ifndef RUN_TEST_SUIT
@@ -253,20 +273,30 @@ static phStatus_t EmvcoDataExchange(uint8_t * com_buffer, uint8_t cmdsize, uint8
     uint8_t *ppRxBuffer;
     uint16_t wRxLen = 0;
 
+#ifdef EMVCO_ANALYZER
+    // 分析模式不打印APDU: 串口输出会拉长往返时间, 且与二进制统计帧共用串口
+    EmvcoAnalyzer_Begin();
+#else
     // 打印发送的C-APDU
     DEBUG_PRINTF("\n=== C-APDU SEND (%d bytes) ===\n", cmdsize);
     phApp_Print_Buff(com_buffer, cmdsize);
+#endif
 
     status = phpalI14443p4_Exchange(phNfcLib_GetDataParams(PH_COMP_PAL_ISO14443P4), PH_EXCHANGE_DEFAULT,
     		com_buffer, cmdsize, &ppRxBuffer, &wRxLen);
+#ifdef EMVCO_ANALYZER
+    EmvcoAnalyzer_End(status, cmdsize, wRxLen);
+#endif
     if (PH_ERR_SUCCESS == status)
     {
         /* set the pointer to the start of the R-APDU */
         *resp_buffer = &ppRxBuffer[0];
 
+#ifndef EMVCO_ANALYZER
         // 打印接收的R-APDU
         DEBUG_PRINTF("\n=== R-APDU RECV (%d bytes) ===\n", wRxLen);
         phApp_Print_Buff(ppRxBuffer, wRxLen);
+#endif
     }
     else
     {
@@ -334,7 +334,15 @@ phStatus_t phApp_Configure_IRQ()
     pinCfg.bPullSelect = PHDRIVER_PIN_IRQ_PULL_CFG;	// 上拉
     pinCfg.eInterruptConfig = PIN_IRQ_TRIGGER_TYPE;	// 下降沿触发
 
+#ifdef PHDRIVER_STM32L431_BOARD
+    /* IRQ pin of every PN5180 front-end in the reader table */
+    for (uint32_t i = 0; i < PHDRIVER_READER_COUNT; i++)
+    {
+        phDriver_PinConfig(gkphDriver_ReaderCfg[i].pIrqPort, gkphDriver_ReaderCfg[i].wIrqPin, PH_DRIVER_PINFUNC_INTERRUPT, &pinCfg);
+    }
+#else
     phDriver_PinConfig(PHDRIVER_PIN_IRQ, PH_DRIVER_PINFUNC_INTERRUPT, &pinCfg);
+#endif /* PHDRIVER_STM32L431_BOARD */
 #endif
 
 #ifdef PHDRIVER_LPC1769
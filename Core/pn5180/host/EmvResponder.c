@@ -0,0 +1,238 @@
+/*
+ * EmvResponder.c
+ *
+ * Reference Linux responder for the EMV host link of emv_payment_flow.c
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "EmvResponder.h"
+
+#include <string.h>
+
+#define EMV_RESP_HEAD_LEN           5U      /* AA 55 CMD LEN_H LEN_L */
+#define EMV_RESP_TAIL_LEN           2U      /* 0D 0A */
+#define EMV_RESP_BATCH_FIXED_LEN    9U      /* STAGES AMOUNT(4) CURRENCY(2) TYPE ODA */
+#define EMV_RESP_ODA_VERIFIED       0x01U   /* ODA byte: verified on the reader */
+
+/* Authorisation Response Code 8A "00", approved */
+static const uint8_t s_auth_response[] = { 0x8A, 0x02, 0x30, 0x30 };
+
+void EmvResponder_Init(EmvResponder_t *pResp)
+{
+    memset(pResp, 0, sizeof(*pResp));
+    pResp->dwFloorLimit = EMV_RESP_FLOOR_LIMIT;
+}
+
+const EmvResponder_Record_t *EmvResponder_FindRecord(const EmvResponder_t *pResp, uint8_t bSfi, uint8_t bRec)
+{
+    for (uint32_t i = 0; i < pResp->dwRecordCount; i++) {
+        if (pResp->aRecords[i].bSfi == bSfi && pResp->aRecords[i].bRec == bRec) {
+            return &pResp->aRecords[i];
+        }
+    }
+    return NULL;
+}
+
+/* ================== Requests ================== */
+
+static void EmvResponder_StoreRecord(EmvResponder_t *pResp, const uint8_t *pData, uint16_t wLen)
+{
+    EmvResponder_Record_t *pRec;
+
+    if (wLen < 2U || wLen - 2U > EMV_RESP_RECORD_SIZE) {
+        pResp->dwBadFrames++;
+        return;
+    }
+
+    /* First record after a decision: a new tap */
+    if (pResp->bDecided) {
+        pResp->dwRecordCount = 0;
+        pResp->bDecided = 0;
+    }
+
+    /* A resumed tap sends the records it had already read once more */
+    pRec = (EmvResponder_Record_t *)EmvResponder_FindRecord(pResp, pData[0], pData[1]);
+    if (pRec != NULL) {
+        pResp->dwRecordsReplaced++;
+    } else if (pResp->dwRecordCount < EMV_RESP_MAX_RECORDS) {
+        pRec = &pResp->aRecords[pResp->dwRecordCount++];
+    } else {
+        pResp->dwRecordsDropped++;
+        return;
+    }
+
+    pRec->bSfi = pData[0];
+    pRec->bRec = pData[1];
+    pRec->wLen = (uint16_t)(wLen - 2U);
+    memcpy(pRec->aData, &pData[2], pRec->wLen);
+}
+
+/* Decision of stage bit (1 << bStage) */
+static uint8_t EmvResponder_Decide(const EmvResponder_t *pResp, uint8_t bStage, uint32_t dwAmount, uint8_t bOda)
+{
+    switch (1U << bStage) {
+        case EMV_RESP_STAGE_OFFLINE_DATA_AUTH:
+            /* Verification needs the uplinked records */
+            if (bOda == EMV_RESP_ODA_VERIFIED || pResp->dwRecordCount != 0U) {
+                return EMV_RESP_SUCCESS;
+            }
+            return EMV_RESP_DECLINED;
+
+        case EMV_RESP_STAGE_TERMINAL_RISK_MGMT:
+        case EMV_RESP_STAGE_TERMINAL_ACTION:
+            return (dwAmount > pResp->dwFloorLimit) ? EMV_RESP_ONLINE_REQUIRED : EMV_RESP_OFFLINE_APPROVED;
+
+        case EMV_RESP_STAGE_ONLINE_PROCESSING:
+            return EMV_RESP_APPROVED;
+
+        default:
+            return EMV_RESP_SUCCESS;
+    }
+}
+
+static uint32_t EmvResponder_Reply(EmvResponder_t *pResp, uint8_t bResp, const uint8_t *pData, uint16_t wLen,
+                                   uint8_t *pReply, uint32_t dwSize)
+{
+    if (EMV_RESP_HEAD_LEN + (uint32_t)wLen + EMV_RESP_TAIL_LEN > dwSize) {
+        return 0;
+    }
+    pReply[0] = 0xAA;
+    pReply[1] = 0x55;
+    pReply[2] = bResp;
+    pReply[3] = (uint8_t)(wLen >> 8);
+    pReply[4] = (uint8_t)wLen;
+    memcpy(&pReply[EMV_RESP_HEAD_LEN], pData, wLen);
+    pReply[EMV_RESP_HEAD_LEN + wLen] = 0x0D;
+    pReply[EMV_RESP_HEAD_LEN + wLen + 1U] = 0x0A;
+    pResp->dwReplies++;
+    return EMV_RESP_HEAD_LEN + wLen + EMV_RESP_TAIL_LEN;
+}
+
+/* [DECIDED][decision per requested stage][AUTH_LEN(2)][AUTH RESP][SCRIPT_LEN(2)][SCRIPTS] */
+static uint32_t EmvResponder_Batch(EmvResponder_t *pResp, const uint8_t *pData, uint16_t wLen,
+                                   uint8_t *pReply, uint32_t dwSize)
+{
+    uint8_t aData[1U + EMV_RESP_STAGE_COUNT + 2U + sizeof(s_auth_response) + 2U];
+    uint16_t wPos = 1;
+    uint32_t dwAmount;
+    uint8_t bStages;
+
+    if (wLen < EMV_RESP_BATCH_FIXED_LEN) {
+        pResp->dwBadFrames++;
+        return EmvResponder_Reply(pResp, EMV_RESP_ERROR, NULL, 0, pReply, dwSize);
+    }
+    bStages = (uint8_t)(pData[0] & ((1U << EMV_RESP_STAGE_COUNT) - 1U));
+    dwAmount = ((uint32_t)pData[1] << 24) | ((uint32_t)pData[2] << 16) | ((uint32_t)pData[3] << 8) | pData[4];
+
+    aData[0] = bStages;
+    for (uint8_t i = 0; i < EMV_RESP_STAGE_COUNT; i++) {
+        if (bStages & (1U << i)) {
+            aData[wPos++] = EmvResponder_Decide(pResp, i, dwAmount, pData[8]);
+        }
+    }
+    if (bStages & EMV_RESP_STAGE_ONLINE_PROCESSING) {
+        aData[wPos++] = 0;
+        aData[wPos++] = (uint8_t)sizeof(s_auth_response);
+        memcpy(&aData[wPos], s_auth_response, sizeof(s_auth_response));
+        wPos += (uint16_t)sizeof(s_auth_response);
+    } else {
+        aData[wPos++] = 0;
+        aData[wPos++] = 0;
+    }
+    /* No issuer scripts */
+    aData[wPos++] = 0;
+    aData[wPos++] = 0;
+
+    pResp->bDecided = 1;
+    return EmvResponder_Reply(pResp, EMV_RESP_SUCCESS, aData, wPos, pReply, dwSize);
+}
+
+/* Per-stage request: the decision is the response code, online processing adds the authorisation response */
+static uint32_t EmvResponder_Stage(EmvResponder_t *pResp, uint8_t bCmd, const uint8_t *pData, uint16_t wLen,
+                                   uint8_t *pReply, uint32_t dwSize)
+{
+    uint8_t bStage = (uint8_t)(bCmd - EMV_RESP_CMD_OFFLINE_DATA_AUTH);
+    uint32_t dwAmount = 0;
+    uint8_t bOda = 0;
+    uint8_t bResp;
+
+    /* Same data as the batch request when the reader sends it, else the amount is unknown */
+    if (wLen >= EMV_RESP_BATCH_FIXED_LEN) {
+        dwAmount = ((uint32_t)pData[1] << 24) | ((uint32_t)pData[2] << 16) | ((uint32_t)pData[3] << 8) | pData[4];
+        bOda = pData[8];
+    }
+    bResp = EmvResponder_Decide(pResp, bStage, dwAmount, bOda);
+
+    pResp->bDecided = 1;
+    if ((1U << bStage) == EMV_RESP_STAGE_ONLINE_PROCESSING) {
+        return EmvResponder_Reply(pResp, bResp, s_auth_response, (uint16_t)sizeof(s_auth_response), pReply, dwSize);
+    }
+    return EmvResponder_Reply(pResp, bResp, NULL, 0, pReply, dwSize);
+}
+
+static uint32_t EmvResponder_Handle(EmvResponder_t *pResp, uint8_t *pReply, uint32_t dwSize)
+{
+    const uint8_t *pData = &pResp->aFrame[EMV_RESP_HEAD_LEN];
+    uint16_t wLen = (uint16_t)(pResp->dwFrameLen - EMV_RESP_HEAD_LEN - EMV_RESP_TAIL_LEN);
+    uint8_t bCmd = pResp->aFrame[2];
+
+    pResp->dwFrames++;
+    if (bCmd == EMV_RESP_CMD_RECORD_UPLINK) {
+        /* Streamed while the card is read, never answered */
+        EmvResponder_StoreRecord(pResp, pData, wLen);
+        return 0;
+    }
+    if (bCmd == EMV_RESP_CMD_BATCH_DECISION) {
+        return EmvResponder_Batch(pResp, pData, wLen, pReply, dwSize);
+    }
+    if (bCmd >= EMV_RESP_CMD_OFFLINE_DATA_AUTH && bCmd <= EMV_RESP_CMD_SCRIPT_PROCESSING) {
+        return EmvResponder_Stage(pResp, bCmd, pData, wLen, pReply, dwSize);
+    }
+    pResp->dwBadFrames++;
+    return EmvResponder_Reply(pResp, EMV_RESP_ERROR, NULL, 0, pReply, dwSize);
+}
+
+/* ================== Frame parser ================== */
+
+uint32_t EmvResponder_Feed(EmvResponder_t *pResp, const uint8_t *pData, uint32_t dwLen,
+                           uint8_t *pReply, uint32_t dwSize)
+{
+    uint32_t dwOut = 0;
+
+    for (uint32_t i = 0; i < dwLen; i++) {
+        uint8_t b = pData[i];
+
+        /* Resync on AA 55 */
+        if (pResp->dwFramePos == 0U) {
+            pResp->dwFramePos = (b == 0xAAU) ? 1U : 0U;
+            continue;
+        }
+        if (pResp->dwFramePos == 1U) {
+            pResp->dwFramePos = (b == 0x55U) ? 2U : ((b == 0xAAU) ? 1U : 0U);
+            continue;
+        }
+
+        pResp->aFrame[pResp->dwFramePos++] = b;
+        if (pResp->dwFramePos == EMV_RESP_HEAD_LEN) {
+            uint32_t dwDataLen = ((uint32_t)pResp->aFrame[3] << 8) | pResp->aFrame[4];
+
+            if (dwDataLen > EMV_RESP_FRAME_SIZE) {
+                pResp->dwBadFrames++;
+                pResp->dwFramePos = 0;
+                continue;
+            }
+            pResp->dwFrameLen = EMV_RESP_HEAD_LEN + dwDataLen + EMV_RESP_TAIL_LEN;
+        }
+        if (pResp->dwFramePos > EMV_RESP_HEAD_LEN && pResp->dwFramePos == pResp->dwFrameLen) {
+            pResp->dwFramePos = 0;
+            if (pResp->aFrame[pResp->dwFrameLen - 2U] != 0x0DU || pResp->aFrame[pResp->dwFrameLen - 1U] != 0x0AU) {
+                pResp->dwBadFrames++;
+                continue;
+            }
+            dwOut += EmvResponder_Handle(pResp, &pReply[dwOut], dwSize - dwOut);
+        }
+    }
+    return dwOut;
+}
@@ -0,0 +1,110 @@
+/*
+ * EmvResponder.h
+ *
+ * Reference Linux responder for the EMV host link of emv_payment_flow.c
+ * Frames: [AA 55][CMD][LEN_H][LEN_L][DATA][0D 0A] from the reader,
+ *         [AA 55][RESP][LEN_H][LEN_L][DATA][0D 0A] back to it
+ * Answers the per-stage requests (0x10..0x16) and LINUX_CMD_BATCH_DECISION,
+ * keeps the records streamed with LINUX_CMD_RECORD_UPLINK
+ *
+ * Host only, not part of the firmware build
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef EMVRESPONDER_H_
+#define EMVRESPONDER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Protocol, as in emv_payment_flow.h ================== */
+#define EMV_RESP_CMD_OFFLINE_DATA_AUTH      0x10U
+#define EMV_RESP_CMD_SCRIPT_PROCESSING      0x16U
+#define EMV_RESP_CMD_RECORD_UPLINK          0x17U
+#define EMV_RESP_CMD_BATCH_DECISION         0x18U
+
+#define EMV_RESP_STAGE_OFFLINE_DATA_AUTH    0x01U
+#define EMV_RESP_STAGE_PROCESS_RESTRICTIONS 0x02U
+#define EMV_RESP_STAGE_TERMINAL_RISK_MGMT   0x04U
+#define EMV_RESP_STAGE_TERMINAL_ACTION      0x08U
+#define EMV_RESP_STAGE_ONLINE_PROCESSING    0x10U
+#define EMV_RESP_STAGE_ISSUER_AUTH          0x20U
+#define EMV_RESP_STAGE_SCRIPT_PROCESSING    0x40U
+#define EMV_RESP_STAGE_COUNT                7U
+
+#define EMV_RESP_SUCCESS                    0x00U
+#define EMV_RESP_APPROVED                   0x01U
+#define EMV_RESP_DECLINED                   0x02U
+#define EMV_RESP_ONLINE_REQUIRED            0x03U
+#define EMV_RESP_OFFLINE_APPROVED           0x04U
+#define EMV_RESP_ERROR                      0xFFU
+
+/* ================== Configuration ================== */
+#define EMV_RESP_MAX_RECORDS                64U     /* Records of one tap */
+#define EMV_RESP_RECORD_SIZE                256U
+#define EMV_RESP_FRAME_SIZE                 1024U   /* s_batch_frame of the reader */
+#define EMV_RESP_FLOOR_LIMIT                10000U  /* Cents, EMV_TERMINAL_FLOOR_LIMIT of the reader */
+
+/* ================== Types ================== */
+
+/* One record, (bSfi, bRec) is the key: a record sent again replaces the first copy */
+typedef struct {
+    uint8_t bSfi;
+    uint8_t bRec;
+    uint16_t wLen;
+    uint8_t aData[EMV_RESP_RECORD_SIZE];
+} EmvResponder_Record_t;
+
+typedef struct {
+    /* Records of the current tap, cleared by the first record after a decision */
+    EmvResponder_Record_t aRecords[EMV_RESP_MAX_RECORDS];
+    uint32_t dwRecordCount;
+    uint8_t bDecided;
+
+    /* Decision policy */
+    uint32_t dwFloorLimit;
+
+    /* Receive state of the frame parser */
+    uint8_t aFrame[EMV_RESP_FRAME_SIZE + 7U];
+    uint32_t dwFramePos;
+    uint32_t dwFrameLen;
+
+    /* Statistics */
+    uint32_t dwFrames;
+    uint32_t dwReplies;
+    uint32_t dwRecordsReplaced;
+    uint32_t dwRecordsDropped;
+    uint32_t dwBadFrames;
+} EmvResponder_t;
+
+/* ================== Functions ================== */
+
+/**
+ * @brief Reset the record table, the parser and the statistics
+ */
+void EmvResponder_Init(EmvResponder_t *pResp);
+
+/**
+ * @brief Feed bytes received from the reader, resyncs on AA 55
+ * @param pReply   Receives the reply frames of the requests completed by these bytes
+ * @param dwSize   Size of pReply, a reply that does not fit is dropped
+ * @return Number of reply bytes written to pReply
+ */
+uint32_t EmvResponder_Feed(EmvResponder_t *pResp, const uint8_t *pData, uint32_t dwLen,
+                           uint8_t *pReply, uint32_t dwSize);
+
+/**
+ * @brief Record of the current tap with this SFI and record number, NULL if not uplinked
+ */
+const EmvResponder_Record_t *EmvResponder_FindRecord(const EmvResponder_t *pResp, uint8_t bSfi, uint8_t bRec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMVRESPONDER_H_ */
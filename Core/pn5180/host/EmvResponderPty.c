@@ -0,0 +1,150 @@
+/*
+ * EmvResponderPty.c
+ *
+ * EmvResponder on a pseudo terminal, or on the serial port of the reader
+ *
+ *   ./emv_host_responder                  prints the pty to connect the reader side to
+ *   ./emv_host_responder --tty /dev/ttyUSB0
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#define _GNU_SOURCE
+
+#include "EmvResponder.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t s_stop;
+static EmvResponder_t s_resp;
+
+static void Pty_Stop(int sig)
+{
+    (void)sig;
+    s_stop = 1;
+}
+
+/* Raw 8N1, the USART1 settings of the reader */
+static int Pty_Raw(int fd)
+{
+    struct termios tio;
+
+    if (tcgetattr(fd, &tio) != 0) {
+        return -1;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    return tcsetattr(fd, TCSANOW, &tio);
+}
+
+static int Pty_Open(const char *pTty)
+{
+    int fd;
+
+    if (pTty != NULL) {
+        fd = open(pTty, O_RDWR | O_NOCTTY);
+    } else {
+        fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (fd >= 0 && (grantpt(fd) != 0 || unlockpt(fd) != 0)) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (fd < 0 || Pty_Raw(fd) != 0) {
+        return -1;
+    }
+    if (pTty == NULL) {
+        printf("pty: %s\n", ptsname(fd));
+        fflush(stdout);
+    }
+    return fd;
+}
+
+static int Pty_WriteAll(int fd, const uint8_t *pData, uint32_t dwLen)
+{
+    while (dwLen != 0U) {
+        ssize_t n = write(fd, pData, dwLen);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        pData += n;
+        dwLen -= (uint32_t)n;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static uint8_t aRx[4096];
+    static uint8_t aTx[4U * EMV_RESP_FRAME_SIZE];
+    const char *pTty = NULL;
+    struct sigaction sa;
+    int fd;
+
+    EmvResponder_Init(&s_resp);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tty") == 0 && i + 1 < argc) {
+            pTty = argv[++i];
+        } else if (strcmp(argv[i], "--floor-limit") == 0 && i + 1 < argc) {
+            s_resp.dwFloorLimit = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [--tty <device>] [--floor-limit <cents>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    fd = Pty_Open(pTty);
+    if (fd < 0) {
+        perror(pTty != NULL ? pTty : "posix_openpt");
+        return 1;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = Pty_Stop;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    while (!s_stop) {
+        ssize_t n = read(fd, aRx, sizeof(aRx));
+        uint32_t dwOut;
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            /* EIO on the master side: no reader has the pty open yet */
+            if (errno == EIO && pTty == NULL) {
+                usleep(10000);
+                continue;
+            }
+            perror("read");
+            break;
+        }
+        dwOut = EmvResponder_Feed(&s_resp, aRx, (uint32_t)n, aTx, sizeof(aTx));
+        if (dwOut != 0U && Pty_WriteAll(fd, aTx, dwOut) != 0) {
+            perror("write");
+            break;
+        }
+    }
+
+    fprintf(stderr, "frames %u replies %u records %u replaced %u dropped %u bad %u\n",
+            s_resp.dwFrames, s_resp.dwReplies, s_resp.dwRecordCount, s_resp.dwRecordsReplaced,
+            s_resp.dwRecordsDropped, s_resp.dwBadFrames);
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,475 @@
+/*
+ * SunBatch.c
+ *
+ * Batch verification of SUN messages on the Linux backend
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#include "SunBatch.h"
+#include <phKeyStore.h>
+#include <phalMfNtag42XDna.h>
+#include "../library/comps/phCryptoSym/src/Sw/phCryptoSym_Sw_Aes.h"
+#include "../library/comps/phalMfNtag42XDna/src/Sw/phalMfNtag42XDna_Sw_Int.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#define SUN_BATCH_AES_ROUNDS        10U
+#define SUN_BATCH_AES_NK            4U
+#define SUN_BATCH_AES_NK_MAX        44U     /* 4 * (rounds + 1) words of round keys */
+#define SUN_BATCH_NO_KEY            0xFFU
+#define SUN_BATCH_MAC_SIZE          8U      /* Truncated MAC, odd bytes of the CMAC */
+
+/* ================== AES-CMAC on the phCryptoSym_Sw round keys ================== */
+
+static void SunBatch_Expand(phCryptoSym_Sw_DataParams_t *pAes, const uint8_t *pKey)
+{
+    pAes->wKeyType = PH_CRYPTOSYM_KEY_TYPE_AES128;
+    (void)phCryptoSym_Sw_Aes_KeyExpansion(pAes, pKey, SUN_BATCH_AES_NK, SUN_BATCH_AES_NK_MAX);
+}
+
+/* Left shift by one bit, conditional XOR of Rb = 0x87 (SP 800-38B) */
+static void SunBatch_Dbl(const uint8_t *pIn, uint8_t *pOut)
+{
+    uint8_t carry = (uint8_t)(pIn[0] >> 7);
+
+    for (uint8_t i = 0; i < 15U; i++) {
+        pOut[i] = (uint8_t)((pIn[i] << 1) | (pIn[i + 1U] >> 7));
+    }
+    pOut[15] = (uint8_t)((pIn[15] << 1) ^ (carry ? 0x87U : 0x00U));
+}
+
+static void SunBatch_Subkeys(phCryptoSym_Sw_DataParams_t *pAes, uint8_t *pK1, uint8_t *pK2)
+{
+    uint8_t aL[PH_CRYPTOSYM_AES_BLOCK_SIZE];
+
+    memset(aL, 0, sizeof(aL));
+    (void)phCryptoSym_Sw_Aes_EncryptBlock(pAes, aL, SUN_BATCH_AES_ROUNDS);
+    SunBatch_Dbl(aL, pK1);
+    SunBatch_Dbl(pK1, pK2);
+    memset(aL, 0, sizeof(aL));
+}
+
+/* One CMAC chain of the interleaved set */
+typedef struct {
+    phCryptoSym_Sw_DataParams_t *pAes;
+    const uint8_t *pK1;
+    const uint8_t *pK2;
+    const uint8_t *pData;
+    uint16_t wLen;
+    uint16_t wBlocks;
+    uint8_t aState[PH_CRYPTOSYM_AES_BLOCK_SIZE];
+} SunBatch_Lane_t;
+
+/*
+ * CMAC of up to SUN_BATCH_LANES independent messages, block i of every lane is
+ * processed before block i + 1 of any, so the chains do not wait on each other
+ */
+static void SunBatch_CmacLanes(SunBatch_Lane_t *pLanes, uint32_t dwLanes)
+{
+    uint16_t wMax = 0;
+    uint32_t l;
+
+    for (l = 0; l < dwLanes; l++) {
+        pLanes[l].wBlocks = (uint16_t)((pLanes[l].wLen == 0U) ? 1U : ((pLanes[l].wLen + 15U) / 16U));
+        memset(pLanes[l].aState, 0, PH_CRYPTOSYM_AES_BLOCK_SIZE);
+        if (pLanes[l].wBlocks > wMax) {
+            wMax = pLanes[l].wBlocks;
+        }
+    }
+
+    for (uint16_t b = 0; b < wMax; b++) {
+        for (l = 0; l < dwLanes; l++) {
+            SunBatch_Lane_t *pLane = &pLanes[l];
+            const uint8_t *pBlock = &pLane->pData[(uint32_t)b * 16U];
+            uint8_t i;
+
+            if (b >= pLane->wBlocks) {
+                continue;
+            }
+            if (b + 1U < pLane->wBlocks) {
+                for (i = 0; i < 16U; i++) {
+                    pLane->aState[i] ^= pBlock[i];
+                }
+            } else {
+                /* Last block: complete with K1, else padded with 80 00 .. and K2 */
+                uint16_t wRem = (uint16_t)(pLane->wLen - (uint32_t)b * 16U);
+                if (wRem == 16U) {
+                    for (i = 0; i < 16U; i++) {
+                        pLane->aState[i] ^= (uint8_t)(pBlock[i] ^ pLane->pK1[i]);
+                    }
+                } else {
+                    for (i = 0; i < 16U; i++) {
+                        uint8_t bIn = (i < wRem) ? pBlock[i] : ((i == wRem) ? 0x80U : 0x00U);
+                        pLane->aState[i] ^= (uint8_t)(bIn ^ pLane->pK2[i]);
+                    }
+                }
+            }
+            (void)phCryptoSym_Sw_Aes_EncryptBlock(pLane->pAes, pLane->aState, SUN_BATCH_AES_ROUNDS);
+        }
+    }
+}
+
+/* ================== Master key cache ================== */
+
+static uint8_t SunBatch_KeyIndex(SunBatch_t *pBatch, uint16_t wKeyNo, uint16_t wKeyVer, uint32_t dwStamp,
+                                 phStatus_t *pStatus)
+{
+    SunBatch_Key_t *pEntry;
+    uint8_t aKey[PH_CRYPTOSYM_AES128_KEY_SIZE];
+    uint16_t wKeyType = 0;
+    uint32_t i, dwVictim = SUN_BATCH_KEY_CACHE;
+
+    for (i = 0; i < SUN_BATCH_KEY_CACHE; i++) {
+        pEntry = &pBatch->aKeys[i];
+        if (pEntry->bValid && pEntry->wKeyNo == wKeyNo && pEntry->wKeyVer == wKeyVer) {
+            pEntry->dwLastUse = dwStamp;
+            return (uint8_t)i;
+        }
+    }
+
+    /* Free slot, else the least recently used one not needed by this batch */
+    for (i = 0; i < SUN_BATCH_KEY_CACHE; i++) {
+        pEntry = &pBatch->aKeys[i];
+        if (!pEntry->bValid) {
+            dwVictim = i;
+            break;
+        }
+        if (pEntry->dwLastUse != dwStamp &&
+            (dwVictim == SUN_BATCH_KEY_CACHE || pEntry->dwLastUse < pBatch->aKeys[dwVictim].dwLastUse)) {
+            dwVictim = i;
+        }
+    }
+    if (dwVictim == SUN_BATCH_KEY_CACHE) {
+        *pStatus = PH_ADD_COMPCODE_FIXED(PH_ERR_RESOURCE_ERROR, PH_COMP_GENERIC);
+        return SUN_BATCH_NO_KEY;
+    }
+
+    *pStatus = phKeyStore_GetKey(pBatch->pKeyStore, wKeyNo, wKeyVer, PH_CRYPTOSYM_AES128_KEY_SIZE, aKey, &wKeyType);
+    if (*pStatus != PH_ERR_SUCCESS) {
+        return SUN_BATCH_NO_KEY;
+    }
+    if (wKeyType != PH_CRYPTOSYM_KEY_TYPE_AES128) {
+        *pStatus = PH_ADD_COMPCODE_FIXED(PH_ERR_KEY, PH_COMP_AL_MFNTAG42XDNA);
+        return SUN_BATCH_NO_KEY;
+    }
+
+    pEntry = &pBatch->aKeys[dwVictim];
+    SunBatch_Expand(&pEntry->sAes, aKey);
+    SunBatch_Subkeys(&pEntry->sAes, pEntry->aK1, pEntry->aK2);
+    pEntry->wKeyNo = wKeyNo;
+    pEntry->wKeyVer = wKeyVer;
+    pEntry->dwLastUse = dwStamp;
+    pEntry->bValid = 1;
+    memset(aKey, 0, sizeof(aKey));
+    return (uint8_t)dwVictim;
+}
+
+/* Caller thread: every key of the batch is expanded before the workers start */
+static void SunBatch_ResolveKeys(SunBatch_t *pBatch, SunBatch_Msg_t *pMsgs, uint32_t dwCount)
+{
+    uint32_t dwStamp = ++pBatch->dwUse;
+    uint16_t wLastNo = 0xFFFFU, wLastVer = 0xFFFFU;
+    uint8_t bLastIdx = SUN_BATCH_NO_KEY;
+
+    for (uint32_t m = 0; m < dwCount; m++) {
+        SunBatch_Msg_t *pMsg = &pMsgs[m];
+
+        pMsg->wStatus = PH_ERR_SUCCESS;
+        pMsg->bKeyIdx = SUN_BATCH_NO_KEY;
+        pMsg->bPiccKeyIdx = SUN_BATCH_NO_KEY;
+
+        /* Tapped URLs of one product line share a key, skip the cache scan */
+        if (bLastIdx != SUN_BATCH_NO_KEY && pMsg->wKeyNo == wLastNo && pMsg->wKeyVer == wLastVer) {
+            pMsg->bKeyIdx = bLastIdx;
+        } else {
+            pMsg->bKeyIdx = SunBatch_KeyIndex(pBatch, pMsg->wKeyNo, pMsg->wKeyVer, dwStamp, &pMsg->wStatus);
+            if (pMsg->bKeyIdx == SUN_BATCH_NO_KEY) {
+                continue;
+            }
+            bLastIdx = pMsg->bKeyIdx;
+            wLastNo = pMsg->wKeyNo;
+            wLastVer = pMsg->wKeyVer;
+        }
+
+        if ((pMsg->bFlags & SUN_BATCH_FLAG_PICC_ENC) != 0U) {
+            pMsg->bPiccKeyIdx = SunBatch_KeyIndex(pBatch, pMsg->wPiccKeyNo, pMsg->wPiccKeyVer, dwStamp,
+                                                  &pMsg->wStatus);
+            if (pMsg->bPiccKeyIdx == SUN_BATCH_NO_KEY) {
+                pMsg->bKeyIdx = SUN_BATCH_NO_KEY;
+            }
+        }
+    }
+}
+
+/* ================== Verification ================== */
+
+/* PICCData = PICCDataTag || UID || SDMReadCtr || padding, decrypted in place of the plain mirror */
+static phStatus_t SunBatch_DecryptPicc(SunBatch_t *pBatch, SunBatch_Msg_t *pMsg)
+{
+    uint8_t aPlain[PH_CRYPTOSYM_AES_BLOCK_SIZE];
+    uint8_t bPos = 1;
+
+    memcpy(aPlain, pMsg->aPiccEnc, sizeof(aPlain));
+    (void)phCryptoSym_Sw_Aes_DecryptBlock(&pBatch->aKeys[pMsg->bPiccKeyIdx].sAes, aPlain, SUN_BATCH_AES_ROUNDS);
+
+    if ((aPlain[0] & 0x80U) != 0U) {
+        pMsg->bUidLen = (uint8_t)(aPlain[0] & 0x0FU);
+        if (pMsg->bUidLen > sizeof(pMsg->aUid)) {
+            memset(aPlain, 0, sizeof(aPlain));
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_AUTH_ERROR, PH_COMP_AL_MFNTAG42XDNA);
+        }
+        memcpy(pMsg->aUid, &aPlain[bPos], pMsg->bUidLen);
+        bPos = (uint8_t)(bPos + pMsg->bUidLen);
+    }
+    if ((aPlain[0] & 0x40U) != 0U) {
+        memcpy(pMsg->aReadCtr, &aPlain[bPos], sizeof(pMsg->aReadCtr));
+    }
+    memset(aPlain, 0, sizeof(aPlain));
+    return PH_ERR_SUCCESS;
+}
+
+/* SV2 = 3C C3 00 01 00 80 [|| VCUID][|| SDMReadCtr][|| zero padding], as phalMfNtag42XDna_Sw_CalculateMACSDM */
+static phStatus_t SunBatch_Sv2(const SunBatch_Msg_t *pMsg, uint8_t *pSv)
+{
+    uint32_t dwCtr = (uint32_t)pMsg->aReadCtr[0] | ((uint32_t)pMsg->aReadCtr[1] << 8) |
+                     ((uint32_t)pMsg->aReadCtr[2] << 16);
+    uint8_t bLen = 0;
+
+    if (dwCtr == 0xFFFFFFU) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_PARAMETER_OVERFLOW, PH_COMP_AL_MFNTAG42XDNA);
+    }
+    if (pMsg->bUidLen > sizeof(pMsg->aUid)) {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_AL_MFNTAG42XDNA);
+    }
+
+    memset(pSv, 0, PH_CRYPTOSYM_AES_BLOCK_SIZE);
+    pSv[bLen++] = 0x3CU;
+    pSv[bLen++] = 0xC3U;
+    pSv[bLen++] = 0x00U;
+    pSv[bLen++] = 0x01U;
+    pSv[bLen++] = 0x00U;
+    pSv[bLen++] = 0x80U;
+    if ((pMsg->bSdmOption & PHAL_MFNTAG42XDNA_VCUID_PRESENT) != 0U) {
+        memcpy(&pSv[bLen], pMsg->aUid, pMsg->bUidLen);
+        bLen = (uint8_t)(bLen + pMsg->bUidLen);
+    }
+    if ((pMsg->bSdmOption & PHAL_MFNTAG42XDNA_RDCTR_PRESENT) != 0U && dwCtr != 0U) {
+        pSv[bLen++] = pMsg->aReadCtr[0];
+        pSv[bLen++] = pMsg->aReadCtr[1];
+        pSv[bLen++] = pMsg->aReadCtr[2];
+    }
+    return PH_ERR_SUCCESS;
+}
+
+static uint8_t SunBatch_MacEqual(const uint8_t *pA, const uint8_t *pB)
+{
+    uint8_t bDiff = 0;
+
+    for (uint8_t i = 0; i < SUN_BATCH_MAC_SIZE; i++) {
+        bDiff |= (uint8_t)(pA[i] ^ pB[i]);
+    }
+    return (uint8_t)(bDiff == 0U);
+}
+
+static void SunBatch_Chunk(SunBatch_t *pBatch, SunBatch_Msg_t *pMsgs, uint32_t dwCount)
+{
+    uint8_t aSesKey[SUN_BATCH_CHUNK][PH_CRYPTOSYM_AES128_KEY_SIZE];
+    uint8_t aSesK1[SUN_BATCH_LANES][PH_CRYPTOSYM_AES_BLOCK_SIZE];
+    uint8_t aSesK2[SUN_BATCH_LANES][PH_CRYPTOSYM_AES_BLOCK_SIZE];
+    phCryptoSym_Sw_DataParams_t aSesAes[SUN_BATCH_LANES];
+    SunBatch_Lane_t aLanes[SUN_BATCH_LANES];
+    uint32_t aLaneMsg[SUN_BATCH_LANES];
+    uint32_t dwLanes = 0;
+    uint32_t m;
+
+    /* Pass 1: session keys of the whole chunk, one block CMAC of SV2 each under the cached master key */
+    for (m = 0; m < dwCount; m++) {
+        SunBatch_Msg_t *pMsg = &pMsgs[m];
+        SunBatch_Key_t *pKey;
+
+        if (pMsg->bKeyIdx == SUN_BATCH_NO_KEY || pMsg->bType != SUN_BATCH_NTAG42X_SDM) {
+            continue;
+        }
+        if ((pMsg->bFlags & SUN_BATCH_FLAG_PICC_ENC) != 0U) {
+            pMsg->wStatus = SunBatch_DecryptPicc(pBatch, pMsg);
+        }
+        if (pMsg->wStatus == PH_ERR_SUCCESS) {
+            pMsg->wStatus = SunBatch_Sv2(pMsg, aSesKey[m]);
+        }
+        if (pMsg->wStatus != PH_ERR_SUCCESS) {
+            pMsg->bKeyIdx = SUN_BATCH_NO_KEY;
+            continue;
+        }
+        /* SV2 is always one complete block */
+        pKey = &pBatch->aKeys[pMsg->bKeyIdx];
+        for (uint8_t i = 0; i < 16U; i++) {
+            aSesKey[m][i] ^= pKey->aK1[i];
+        }
+        (void)phCryptoSym_Sw_Aes_EncryptBlock(&pKey->sAes, aSesKey[m], SUN_BATCH_AES_ROUNDS);
+    }
+
+    /* Pass 2: MAC input CMACs, SUN_BATCH_LANES messages interleaved */
+    for (m = 0; m <= dwCount; m++) {
+        if (m < dwCount && pMsgs[m].bKeyIdx != SUN_BATCH_NO_KEY) {
+            SunBatch_Msg_t *pMsg = &pMsgs[m];
+            SunBatch_Lane_t *pLane = &aLanes[dwLanes];
+
+            if (pMsg->bType == SUN_BATCH_NTAG42X_SDM) {
+                SunBatch_Expand(&aSesAes[dwLanes], aSesKey[m]);
+                SunBatch_Subkeys(&aSesAes[dwLanes], aSesK1[dwLanes], aSesK2[dwLanes]);
+                pLane->pAes = &aSesAes[dwLanes];
+                pLane->pK1 = aSesK1[dwLanes];
+                pLane->pK2 = aSesK2[dwLanes];
+            } else {
+                /* Ultralight AES SUN: the master key itself, nothing to derive */
+                pLane->pAes = &pBatch->aKeys[pMsg->bKeyIdx].sAes;
+                pLane->pK1 = pBatch->aKeys[pMsg->bKeyIdx].aK1;
+                pLane->pK2 = pBatch->aKeys[pMsg->bKeyIdx].aK2;
+            }
+            pLane->pData = pMsg->pMacInput;
+            pLane->wLen = pMsg->wMacInputLen;
+            aLaneMsg[dwLanes++] = m;
+        }
+        if (dwLanes == SUN_BATCH_LANES || (m == dwCount && dwLanes > 0U)) {
+            SunBatch_CmacLanes(aLanes, dwLanes);
+            for (uint32_t l = 0; l < dwLanes; l++) {
+                SunBatch_Msg_t *pMsg = &pMsgs[aLaneMsg[l]];
+                phalMfNtag42XDna_Sw_Int_TruncateMac(aLanes[l].aState);
+                if (!SunBatch_MacEqual(aLanes[l].aState, pMsg->aMac)) {
+                    pMsg->wStatus = PH_ADD_COMPCODE_FIXED(PH_ERR_AUTH_ERROR, (pMsg->bType == SUN_BATCH_MFUL_AES) ?
+                                                          PH_COMP_AL_MFUL : PH_COMP_AL_MFNTAG42XDNA);
+                }
+            }
+            dwLanes = 0;
+        }
+    }
+
+    memset(aSesKey, 0, sizeof(aSesKey));
+    memset(aSesAes, 0, sizeof(aSesAes));
+}
+
+/* ================== Thread pool ================== */
+
+static void SunBatch_Work(SunBatch_t *pBatch)
+{
+    uint32_t dwFirst;
+
+    while ((dwFirst = __atomic_fetch_add(&pBatch->dwNext, SUN_BATCH_CHUNK, __ATOMIC_RELAXED)) < pBatch->dwCount) {
+        uint32_t dwNum = pBatch->dwCount - dwFirst;
+        SunBatch_Chunk(pBatch, &pBatch->pMsgs[dwFirst], (dwNum < SUN_BATCH_CHUNK) ? dwNum : SUN_BATCH_CHUNK);
+    }
+}
+
+static void *SunBatch_Thread(void *pArg)
+{
+    SunBatch_t *pBatch = ((SunBatch_Worker_t *)pArg)->pBatch;
+    uint32_t dwSeen = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&pBatch->lock);
+        while (!pBatch->bStop && pBatch->dwGeneration == dwSeen) {
+            pthread_cond_wait(&pBatch->start, &pBatch->lock);
+        }
+        if (pBatch->bStop) {
+            pthread_mutex_unlock(&pBatch->lock);
+            return NULL;
+        }
+        dwSeen = pBatch->dwGeneration;
+        pthread_mutex_unlock(&pBatch->lock);
+
+        SunBatch_Work(pBatch);
+
+        pthread_mutex_lock(&pBatch->lock);
+        if (--pBatch->dwBusy == 0U) {
+            pthread_cond_signal(&pBatch->done);
+        }
+        pthread_mutex_unlock(&pBatch->lock);
+    }
+}
+
+phStatus_t SunBatch_Init(SunBatch_t *pBatch, void *pKeyStore, uint32_t dwThreads)
+{
+    long lCpus;
+
+    memset(pBatch, 0, sizeof(*pBatch));
+    pBatch->pKeyStore = pKeyStore;
+    if (dwThreads == 0U) {
+        lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+        dwThreads = (lCpus > 0) ? (uint32_t)lCpus : 1U;
+    }
+    if (dwThreads > SUN_BATCH_MAX_THREADS) {
+        dwThreads = SUN_BATCH_MAX_THREADS;
+    }
+    pthread_mutex_init(&pBatch->lock, NULL);
+    pthread_cond_init(&pBatch->start, NULL);
+    pthread_cond_init(&pBatch->done, NULL);
+
+    /* The caller is thread 0 */
+    pBatch->dwThreads = 1;
+    for (uint32_t t = 1; t < dwThreads; t++) {
+        pBatch->aWorkers[t].pBatch = pBatch;
+        if (pthread_create(&pBatch->aWorkers[t].thread, NULL, SunBatch_Thread, &pBatch->aWorkers[t]) != 0) {
+            SunBatch_DeInit(pBatch);
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_RESOURCE_ERROR, PH_COMP_GENERIC);
+        }
+        pBatch->dwThreads++;
+    }
+    return PH_ERR_SUCCESS;
+}
+
+uint32_t SunBatch_Verify(SunBatch_t *pBatch, SunBatch_Msg_t *pMsgs, uint32_t dwCount)
+{
+    uint32_t dwValid = 0;
+
+    SunBatch_ResolveKeys(pBatch, pMsgs, dwCount);
+
+    pBatch->pMsgs = pMsgs;
+    pBatch->dwCount = dwCount;
+    pBatch->dwNext = 0;
+    if (pBatch->dwThreads > 1U && dwCount > SUN_BATCH_CHUNK) {
+        pthread_mutex_lock(&pBatch->lock);
+        pBatch->dwBusy = pBatch->dwThreads - 1U;
+        pBatch->dwGeneration++;
+        pthread_cond_broadcast(&pBatch->start);
+        pthread_mutex_unlock(&pBatch->lock);
+
+        SunBatch_Work(pBatch);
+
+        pthread_mutex_lock(&pBatch->lock);
+        while (pBatch->dwBusy != 0U) {
+            pthread_cond_wait(&pBatch->done, &pBatch->lock);
+        }
+        pthread_mutex_unlock(&pBatch->lock);
+    } else {
+        SunBatch_Work(pBatch);
+    }
+
+    for (uint32_t m = 0; m < dwCount; m++) {
+        dwValid += (pMsgs[m].wStatus == PH_ERR_SUCCESS) ? 1U : 0U;
+    }
+    return dwValid;
+}
+
+void SunBatch_FlushKeys(SunBatch_t *pBatch)
+{
+    memset(pBatch->aKeys, 0, sizeof(pBatch->aKeys));
+}
+
+void SunBatch_DeInit(SunBatch_t *pBatch)
+{
+    pthread_mutex_lock(&pBatch->lock);
+    pBatch->bStop = 1;
+    pthread_cond_broadcast(&pBatch->start);
+    pthread_mutex_unlock(&pBatch->lock);
+    for (uint32_t t = 1; t < pBatch->dwThreads; t++) {
+        pthread_join(pBatch->aWorkers[t].thread, NULL);
+    }
+    pBatch->dwThreads = 0;
+    pthread_cond_destroy(&pBatch->start);
+    pthread_cond_destroy(&pBatch->done);
+    pthread_mutex_destroy(&pBatch->lock);
+    SunBatch_FlushKeys(pBatch);
+}
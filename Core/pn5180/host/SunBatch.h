@@ -0,0 +1,148 @@
+/*
+ * SunBatch.h
+ *
+ * Batch verification of SUN (Secure Unique NFC) messages on the Linux backend
+ * NTAG 424 DNA SDM MACs and MIFARE Ultralight AES SUN CMACs, built on the same
+ * phKeyStore / phCryptoSym_Sw components as phalMfNtag42XDna_Sw_CalculateMACSDM,
+ * phalMfNtag42XDna_Sw_DecryptSDMPICCData and phalMful_Sw_CalculateSunCMAC
+ *
+ * Host only (pthreads), not part of the firmware build
+ *
+ * Created on: Oct 19, 2026
+ * Author: Administrator
+ */
+
+#ifndef SUNBATCH_H_
+#define SUNBATCH_H_
+
+#include <ph_Status.h>
+#include <phCryptoSym.h>
+#include <pthread.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================== Configuration ================== */
+#define SUN_BATCH_MAX_THREADS       32U
+#define SUN_BATCH_KEY_CACHE         64U     /* Expanded master keys kept across batches */
+#define SUN_BATCH_LANES             4U      /* Messages whose CMAC chains are interleaved */
+#define SUN_BATCH_CHUNK             64U     /* Messages a worker takes at a time */
+
+/* Message types */
+#define SUN_BATCH_NTAG42X_SDM       0x00U   /* SDMMAC with KSesSDMFileReadMAC derived from the SDM file read key */
+#define SUN_BATCH_MFUL_AES          0x01U   /* Ultralight AES SUN CMAC, computed with the key itself */
+
+/* bFlags */
+#define SUN_BATCH_FLAG_PICC_ENC     0x01U   /* UID and counter come from aPiccEnc, decrypted with the meta read key */
+
+/* ================== Types ================== */
+
+typedef struct {
+    /* [In] */
+    uint8_t bType;                          /* SUN_BATCH_NTAG42X_SDM or SUN_BATCH_MFUL_AES */
+    uint8_t bFlags;
+    uint8_t bSdmOption;                     /* PHAL_MFNTAG42XDNA_VCUID_PRESENT | PHAL_MFNTAG42XDNA_RDCTR_PRESENT */
+    uint16_t wKeyNo;                        /* SDM file read (MAC) key or Ultralight AES key */
+    uint16_t wKeyVer;
+    uint16_t wPiccKeyNo;                    /* SDM meta read key, SUN_BATCH_FLAG_PICC_ENC only */
+    uint16_t wPiccKeyVer;
+    uint8_t aPiccEnc[16];                   /* Encrypted PICCData, SUN_BATCH_FLAG_PICC_ENC only */
+    uint8_t aUid[7];                        /* In when mirrored in plain, out when decrypted */
+    uint8_t bUidLen;
+    uint8_t aReadCtr[3];                    /* SDMReadCtr, LSB first as mirrored in the URL */
+    const uint8_t *pMacInput;               /* Bytes covered by the MAC */
+    uint16_t wMacInputLen;
+    uint8_t aMac[8];                        /* MAC received in the URL */
+
+    /* [Out] */
+    phStatus_t wStatus;                     /* PH_ERR_SUCCESS: MAC matches, PH_ERR_AUTH_ERROR: mismatch, otherwise why not verified */
+
+    /* Internal */
+    uint8_t bKeyIdx;
+    uint8_t bPiccKeyIdx;
+} SunBatch_Msg_t;
+
+/* Expanded master key with its CMAC subkeys */
+typedef struct {
+    uint16_t wKeyNo;
+    uint16_t wKeyVer;
+    uint32_t dwLastUse;
+    uint8_t bValid;
+    uint8_t aK1[PH_CRYPTOSYM_AES_BLOCK_SIZE];
+    uint8_t aK2[PH_CRYPTOSYM_AES_BLOCK_SIZE];
+    phCryptoSym_Sw_DataParams_t sAes;       /* Round keys, read only while workers run */
+} SunBatch_Key_t;
+
+typedef struct SunBatch SunBatch_t;
+
+typedef struct {
+    SunBatch_t *pBatch;
+    pthread_t thread;
+} SunBatch_Worker_t;
+
+struct SunBatch {
+    void *pKeyStore;                        /* phKeyStore data params holding the AES128 master keys */
+    SunBatch_Key_t aKeys[SUN_BATCH_KEY_CACHE];
+    uint32_t dwUse;
+
+    SunBatch_Worker_t aWorkers[SUN_BATCH_MAX_THREADS];
+    uint32_t dwThreads;                     /* Including the caller */
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    uint32_t dwGeneration;
+    uint32_t dwBusy;
+    uint8_t bStop;
+
+    SunBatch_Msg_t *pMsgs;                  /* Current batch */
+    uint32_t dwCount;
+    uint32_t dwNext;                        /* Next chunk, taken atomically */
+};
+
+/* ================== Interface ================== */
+
+/**
+ * @brief Start the worker threads
+ * @param pBatch Batch context
+ * @param pKeyStore phKeyStore data params the master keys are read from
+ * @param dwThreads Threads verifying a batch including the caller, 0: one per online CPU
+ * @return PH_ERR_SUCCESS, or PH_ERR_RESOURCE_ERROR when a thread cannot be created
+ */
+phStatus_t SunBatch_Init(SunBatch_t *pBatch, void *pKeyStore, uint32_t dwThreads);
+
+/**
+ * @brief Verify a batch of SUN messages, sets wStatus of every message
+ *
+ * Master keys are read from the key store and expanded once, then stay in the
+ * cache for later batches. Session keys are derived for all messages in one
+ * pass and the CMACs of SUN_BATCH_LANES messages are computed interleaved.
+ * Messages are split across the worker threads in chunks of SUN_BATCH_CHUNK.
+ *
+ * Results match phalMfNtag42XDna_Sw_CalculateMACSDM, including its handling
+ * of a zero SDMReadCtr, which is left out of SV2. Messages needing more than
+ * SUN_BATCH_KEY_CACHE distinct keys in one batch get PH_ERR_RESOURCE_ERROR.
+ *
+ * @param pBatch Batch context
+ * @param pMsgs Messages
+ * @param dwCount Number of messages
+ * @return Number of messages whose MAC matched
+ */
+uint32_t SunBatch_Verify(SunBatch_t *pBatch, SunBatch_Msg_t *pMsgs, uint32_t dwCount);
+
+/**
+ * @brief Forget the expanded keys, call after the key store was changed
+ */
+void SunBatch_FlushKeys(SunBatch_t *pBatch);
+
+/**
+ * @brief Stop the worker threads and wipe the key cache
+ */
+void SunBatch_DeInit(SunBatch_t *pBatch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUNBATCH_H_ */
@@ -35,6 +35,18 @@
 /** \brief Increment the 16 byte value V by 1 mod 2^128.  */
 static void phCryptoRng_Sw_IncrementV( phCryptoRng_Sw_DataParams_t * pDataParams );
 
+/** \brief Reseed from the entropy source when the reseed interval is reached. */
+static phStatus_t phCryptoRng_Sw_ReseedIfDue( phCryptoRng_Sw_DataParams_t * pDataParams );
+
+/** \brief Drop the pre-generated bytes, they belong to the previous working state. */
+static void phCryptoRng_Sw_FlushPool( phCryptoRng_Sw_DataParams_t * pDataParams );
+
+/** \brief Instantiate, or reseed a working DRBG, with a seed of #PHCRYPTORNG_SW_SEEDLEN bytes. */
+static phStatus_t phCryptoRng_Sw_SeedNow( phCryptoRng_Sw_DataParams_t * pDataParams, uint8_t * pSeed );
+
+/** \brief Reseed with the seeds collected by #phCryptoRng_Sw_Seed since the DRBG last ran. */
+static phStatus_t phCryptoRng_Sw_ApplyPendingSeed( phCryptoRng_Sw_DataParams_t * pDataParams );
+
 static const uint8_t PH_CRYPTOSYM_SW_CONST_ROM phCryptoRng_Sw_BlockCipherDf_DefaultKey[PHCRYPTORNG_SW_KEYLEN] =
 {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
 
@@ -51,7 +63,14 @@ phStatus_t phCryptoRng_Sw_Init(phCryptoRng_Sw_DataParams_t * pDataParams, uint16
     pDataParams->wId = PH_COMP_CRYPTORNG | PH_CRYPTORNG_SW_ID;
     pDataParams->pCryptoDataParams = pCryptoDataParams;
     (void) memset(pDataParams->V, 0, (size_t) sizeof(pDataParams->V));
+    (void) memset(pDataParams->Key, 0, (size_t) sizeof(pDataParams->Key));
     pDataParams->bState = PHCRYPTORNG_SW_STATE_INIT;
+    pDataParams->pEntropyCb = NULL;
+    pDataParams->pEntropyContext = NULL;
+    pDataParams->dwReseedInterval = PHCRYPTORNG_SW_MAX_REQUESTS;
+    pDataParams->bSeedPending = PH_OFF;
+    (void) memset(pDataParams->aPendingSeed, 0, (size_t) sizeof(pDataParams->aPendingSeed));
+    phCryptoRng_Sw_FlushPool(pDataParams);
 
     return PH_ERR_SUCCESS;
 }
@@ -60,6 +79,7 @@ phStatus_t phCryptoRng_Sw_Seed(phCryptoRng_Sw_DataParams_t * pDataParams, uint8_
 {
     phStatus_t  PH_MEMLOC_REM statusTmp;
     uint8_t     PH_MEMLOC_REM aSeed[PHCRYPTORNG_SW_SEEDLEN];
+    uint8_t     PH_MEMLOC_REM bIndex;
 
     /* we do not set the seed to 0 as we like randomness in here... */
 
@@ -72,12 +92,38 @@ phStatus_t phCryptoRng_Sw_Seed(phCryptoRng_Sw_DataParams_t * pDataParams, uint8_
         (void) memcpy(aSeed, pSeed, bSeedLength);
     }
 
+    if (pDataParams->bState == PHCRYPTORNG_SW_STATE_INIT)
+    {
+        statusTmp = phCryptoRng_Sw_SeedNow(pDataParams, aSeed);
+    }
+    else
+    {
+        /* A working DRBG takes the seed the next time it runs, so bytes already in the pool stay
+         * usable. Authentications seed with the card challenge right before drawing their own. */
+        for (bIndex = 0; bIndex < PHCRYPTORNG_SW_SEEDLEN; bIndex++)
+        {
+            pDataParams->aPendingSeed[bIndex] ^= aSeed[bIndex];
+        }
+        pDataParams->bSeedPending = PH_ON;
+        statusTmp = PH_ERR_SUCCESS;
+    }
+
+    /* Clear seed for security reasons */
+    (void) memset(aSeed, 0x00, (size_t) sizeof(aSeed));
+
+    return PH_ADD_COMPCODE(statusTmp, PH_COMP_CRYPTORNG);
+}
+
+static phStatus_t phCryptoRng_Sw_SeedNow(phCryptoRng_Sw_DataParams_t * pDataParams, uint8_t * pSeed)
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+
     if (pDataParams->bState == PHCRYPTORNG_SW_STATE_INIT)
     {
         statusTmp = phCryptoRng_Sw_Instantiate(
             pDataParams,
-            aSeed,
-            (uint16_t)sizeof(aSeed),
+            pSeed,
+            PHCRYPTORNG_SW_SEEDLEN,
             NULL,
             0,
             NULL,
@@ -87,24 +133,107 @@ phStatus_t phCryptoRng_Sw_Seed(phCryptoRng_Sw_DataParams_t * pDataParams, uint8_
     {
         statusTmp = phCryptoRng_Sw_Reseed(
             pDataParams,
-            aSeed,
-            (uint16_t)sizeof(aSeed),
+            pSeed,
+            PHCRYPTORNG_SW_SEEDLEN,
             NULL,
             0);
     }
 
+    return statusTmp;
+}
+
+static phStatus_t phCryptoRng_Sw_ApplyPendingSeed(phCryptoRng_Sw_DataParams_t * pDataParams)
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+
+    if (pDataParams->bSeedPending == PH_OFF)
+    {
+        return PH_ERR_SUCCESS;
+    }
+
+    statusTmp = phCryptoRng_Sw_SeedNow(pDataParams, pDataParams->aPendingSeed);
+    pDataParams->bSeedPending = PH_OFF;
+
+    /* Clear seed for security reasons */
+    (void) memset(pDataParams->aPendingSeed, 0x00, (size_t) sizeof(pDataParams->aPendingSeed));
+
     return PH_ADD_COMPCODE(statusTmp, PH_COMP_CRYPTORNG);
 }
 
 phStatus_t phCryptoRng_Sw_Rnd(phCryptoRng_Sw_DataParams_t * pDataParams, uint16_t  wNoOfRndBytes, uint8_t * pRnd)
 {
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+
+    /* Serve from the pool, each byte is handed out once */
+    if ((pDataParams->bState == PHCRYPTORNG_SW_STATE_WORKING) && (wNoOfRndBytes <= pDataParams->wPoolLen))
+    {
+        pDataParams->wPoolLen = (uint16_t)(pDataParams->wPoolLen - wNoOfRndBytes);
+        (void) memcpy(pRnd, &pDataParams->aPool[pDataParams->wPoolLen], wNoOfRndBytes);
+        (void) memset(&pDataParams->aPool[pDataParams->wPoolLen], 0x00, wNoOfRndBytes);
+        return PH_ERR_SUCCESS;
+    }
+
+    PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_ApplyPendingSeed(pDataParams));
+    PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_ReseedIfDue(pDataParams));
+
     return phCryptoRng_Sw_Generate(
         pDataParams,
         NULL,
+        0,
         wNoOfRndBytes,
         pRnd);
 }
 
+phStatus_t phCryptoRng_Sw_SetEntropySource(phCryptoRng_Sw_DataParams_t * pDataParams, phCryptoRng_Sw_EntropyCb_t pEntropyCb,
+    void * pContext, uint32_t dwReseedInterval)
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+    uint8_t     PH_MEMLOC_REM aEntropy[PHCRYPTORNG_SW_SEEDLEN];
+
+    PH_ASSERT_NULL (pDataParams);
+    PH_ASSERT_NULL (pEntropyCb);
+
+    pDataParams->pEntropyCb = pEntropyCb;
+    pDataParams->pEntropyContext = pContext;
+    pDataParams->dwReseedInterval = (dwReseedInterval != 0U) ? dwReseedInterval : PHCRYPTORNG_SW_MAX_REQUESTS;
+
+    PH_CHECK_SUCCESS_FCT(statusTmp, pEntropyCb(pContext, aEntropy, (uint16_t)sizeof(aEntropy)));
+    statusTmp = phCryptoRng_Sw_SeedNow(pDataParams, aEntropy);
+    phCryptoRng_Sw_FlushPool(pDataParams);
+
+    /* Clear entropy for security reasons */
+    (void) memset(aEntropy, 0x00, (size_t) sizeof(aEntropy));
+
+    return PH_ADD_COMPCODE(statusTmp, PH_COMP_CRYPTORNG);
+}
+
+phStatus_t phCryptoRng_Sw_RefillPool(phCryptoRng_Sw_DataParams_t * pDataParams)
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+
+    if(pDataParams->bState != PHCRYPTORNG_SW_STATE_WORKING)
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_CRYPTORNG);
+    }
+
+    PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_ApplyPendingSeed(pDataParams));
+    PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_ReseedIfDue(pDataParams));
+
+    if (pDataParams->wPoolLen < PH_CRYPTORNG_SW_POOL_SIZE)
+    {
+        /* Bytes still in the pool stay, the new ones are appended in one request */
+        PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_Generate(
+            pDataParams,
+            NULL,
+            0,
+            (uint16_t)(PH_CRYPTORNG_SW_POOL_SIZE - pDataParams->wPoolLen),
+            &pDataParams->aPool[pDataParams->wPoolLen]));
+        pDataParams->wPoolLen = PH_CRYPTORNG_SW_POOL_SIZE;
+    }
+
+    return PH_ERR_SUCCESS;
+}
+
 phStatus_t phCryptoRng_Sw_Update(phCryptoRng_Sw_DataParams_t * pDataParams, uint8_t * pProvidedData)
 {
     phStatus_t  PH_MEMLOC_REM statusTmp;
@@ -173,9 +302,10 @@ phStatus_t phCryptoRng_Sw_Update(phCryptoRng_Sw_DataParams_t * pDataParams, uint
     #error "No valid cipher available"
 #else
     /* Load the new key into the Crypto Data Params structure */
+    (void) memcpy(pDataParams->Key, aKey, PHCRYPTORNG_SW_KEYLEN);
     PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoSym_LoadKeyDirect(
         pDataParams->pCryptoDataParams,
-        aKey,
+        pDataParams->Key,
         PH_CRYPTOSYM_KEY_TYPE_AES128));
 #endif /* PH_CRYPTOSYM_SW_AES */
 
@@ -188,14 +318,16 @@ phStatus_t phCryptoRng_Sw_Instantiate(phCryptoRng_Sw_DataParams_t * pDataParams,
     uint8_t * pNonce, uint8_t bNonceLength, uint8_t * pPersonalizationString, uint8_t bPersonalizationString)
 {
     phStatus_t  PH_MEMLOC_REM statusTmp;
-    uint8_t     PH_MEMLOC_REM aSeedMaterial[PHCRYPTORNG_SW_SEEDLEN];
+    uint8_t     PH_MEMLOC_REM aSeedMaterial[PHCRYPTORNG_SW_MAX_DF_INPUT];
+    uint16_t    PH_MEMLOC_REM wSeedMaterialLength;
 
     /* Reset state to be init again. */
     pDataParams->bState = PHCRYPTORNG_SW_STATE_INIT;
 
     /* do we have a wrong input data length? */
-    /* Comment: Ensure that the length of the seed_material is exactly seedlen bits. */
-    if(PHCRYPTORNG_SW_SEEDLEN != (wEntropyInputLength + bNonceLength + bPersonalizationString))
+    /* Comment: Block_Cipher_df takes any seed_material length up to max_number_of_bits. */
+    wSeedMaterialLength = (uint16_t)(wEntropyInputLength + bNonceLength + bPersonalizationString);
+    if((wEntropyInputLength == 0U) || (wSeedMaterialLength > PHCRYPTORNG_SW_MAX_DF_INPUT))
     {
         return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_CRYPTORNG);
     }
@@ -210,6 +342,8 @@ phStatus_t phCryptoRng_Sw_Instantiate(phCryptoRng_Sw_DataParams_t * pDataParams,
     /* 2. seed_material = Block_Cipher_df (seed_material, seedlen). */
     PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_BlockCipherDf(
         pDataParams,
+        aSeedMaterial,
+        wSeedMaterialLength,
         aSeedMaterial));
 
     /* Note: Reset the Key and the V-Value. */
@@ -219,10 +353,10 @@ phStatus_t phCryptoRng_Sw_Instantiate(phCryptoRng_Sw_DataParams_t * pDataParams,
     #error "No valid cipher available"
 #else
     /* 3. Key = 0 exp keylen. Comment: keylen bits of zeros. */
-    /* Also reset the key, this can be done by loading V into the key register, as we set it to 0 before. */
+    (void) memset(pDataParams->Key, 0, PHCRYPTORNG_SW_KEYLEN);
     PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoSym_LoadKeyDirect(
         pDataParams->pCryptoDataParams,
-        pDataParams->V,
+        pDataParams->Key,
         PH_CRYPTOSYM_KEY_TYPE_AES128));
 #endif /* PH_CRYPTOSYM_SW_AES */
 
@@ -248,7 +382,8 @@ phStatus_t phCryptoRng_Sw_Reseed(phCryptoRng_Sw_DataParams_t * pDataParams, uint
     uint8_t * pAdditionalInput, uint8_t bAdditionalInputLength)
 {
     phStatus_t  PH_MEMLOC_REM statusTmp;
-    uint8_t     PH_MEMLOC_REM aSeedMaterial[PHCRYPTORNG_SW_SEEDLEN];
+    uint8_t     PH_MEMLOC_REM aSeedMaterial[PHCRYPTORNG_SW_MAX_DF_INPUT];
+    uint16_t    PH_MEMLOC_REM wSeedMaterialLength;
 
     /* Check for operational state */
     if(pDataParams->bState != PHCRYPTORNG_SW_STATE_WORKING)
@@ -256,8 +391,9 @@ phStatus_t phCryptoRng_Sw_Reseed(phCryptoRng_Sw_DataParams_t * pDataParams, uint
         return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_CRYPTORNG);
     }
 
-    /* Comment: Ensure that the length of the seed_material is exactly seedlen bits. */
-    if(PHCRYPTORNG_SW_SEEDLEN != (wEntropyInputLength + bAdditionalInputLength))
+    /* Comment: Block_Cipher_df takes any seed_material length up to max_number_of_bits. */
+    wSeedMaterialLength = (uint16_t)(wEntropyInputLength + bAdditionalInputLength);
+    if((wEntropyInputLength == 0U) || (wSeedMaterialLength > PHCRYPTORNG_SW_MAX_DF_INPUT))
     {
         return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_CRYPTORNG);
     }
@@ -271,8 +407,20 @@ phStatus_t phCryptoRng_Sw_Reseed(phCryptoRng_Sw_DataParams_t * pDataParams, uint
     /* 2. seed_material = Block_Cipher_df (seed_material, seedlen). */
     PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_BlockCipherDf(
         pDataParams,
+        aSeedMaterial,
+        wSeedMaterialLength,
         aSeedMaterial));
 
+#ifndef PH_CRYPTOSYM_SW_AES
+    #error "No valid cipher available"
+#else
+    /* Block_Cipher_df replaced the key in the crypto unit, restore the working key. */
+    PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoSym_LoadKeyDirect(
+        pDataParams->pCryptoDataParams,
+        pDataParams->Key,
+        PH_CRYPTOSYM_KEY_TYPE_AES128));
+#endif /* PH_CRYPTOSYM_SW_AES */
+
     /* Update using aSeedMaterial as the personalization string. */
     /* 3. (Key, V) = Update (seed_material, Key, V). */
     PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_Update(pDataParams, aSeedMaterial));
@@ -289,11 +437,14 @@ phStatus_t phCryptoRng_Sw_Reseed(phCryptoRng_Sw_DataParams_t * pDataParams, uint
     return PH_ERR_SUCCESS;
 }
 
-phStatus_t phCryptoRng_Sw_Generate(phCryptoRng_Sw_DataParams_t * pDataParams, uint8_t * pAdditionalInput, uint16_t wNumBytesRequested,
-    uint8_t * pRndBytes)
+phStatus_t phCryptoRng_Sw_Generate(phCryptoRng_Sw_DataParams_t * pDataParams, uint8_t * pAdditionalInput, uint8_t bAdditionalInputLength,
+    uint16_t wNumBytesRequested, uint8_t * pRndBytes)
 {
     phStatus_t  PH_MEMLOC_REM statusTmp;
     uint16_t    PH_MEMLOC_REM wIndex;
+    uint8_t     PH_MEMLOC_REM aOutputBlock[PHCRYPTORNG_SW_OUTLEN];
+    uint8_t     PH_MEMLOC_REM aAdditionalInput[PHCRYPTORNG_SW_SEEDLEN];
+    uint8_t *   PH_MEMLOC_REM pProvidedData = NULL;
 
     /* Check for operational state */
     if(pDataParams->bState != PHCRYPTORNG_SW_STATE_WORKING)
@@ -307,17 +458,36 @@ phStatus_t phCryptoRng_Sw_Generate(phCryptoRng_Sw_DataParams_t * pDataParams, ui
         return PH_ADD_COMPCODE_FIXED(PH_ERR_INTERNAL_ERROR, PH_COMP_CRYPTORNG);
     }
 
+    if(bAdditionalInputLength > PHCRYPTORNG_SW_MAX_DF_INPUT)
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_CRYPTORNG);
+    }
+
     /* 2. If (additional_input ? Null), then */
-    if(pAdditionalInput != NULL)
+    if((pAdditionalInput != NULL) && (bAdditionalInputLength != 0U))
     {
         /* 2.1 additional_input = Block_Cipher_df (additional_input, seedlen). */
         PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_BlockCipherDf(
             pDataParams,
-            pAdditionalInput));
+            pAdditionalInput,
+            bAdditionalInputLength,
+            aAdditionalInput));
+
+#ifndef PH_CRYPTOSYM_SW_AES
+        #error "No valid cipher available"
+#else
+        /* Block_Cipher_df replaced the key in the crypto unit, restore the working key. */
+        PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoSym_LoadKeyDirect(
+            pDataParams->pCryptoDataParams,
+            pDataParams->Key,
+            PH_CRYPTOSYM_KEY_TYPE_AES128));
+#endif /* PH_CRYPTOSYM_SW_AES */
 
         /* 2.2 (Key, V) = Update (additional_input, Key, V). */
-        PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_Update(pDataParams, pAdditionalInput));
+        PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_Update(pDataParams, aAdditionalInput));
+        pProvidedData = aAdditionalInput;
     }
+    /* Else additional_input = 0 exp seedlen, Update skips the XOR for NULL. */
 
     /* 3. temp = Null. */
     /* 4. While (len (temp) < requested_number_of_bits) do: */
@@ -329,30 +499,37 @@ phStatus_t phCryptoRng_Sw_Generate(phCryptoRng_Sw_DataParams_t * pDataParams, ui
         phCryptoRng_Sw_IncrementV(pDataParams);
 
         /* 4.2 output_block = Block_Encrypt (Key, V). */
+        /* NOTE: V stays the counter, the block is encrypted into a separate buffer. */
         PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoSym_Encrypt(pDataParams->pCryptoDataParams,
             PH_CRYPTOSYM_CIPHER_MODE_ECB,
             pDataParams->V,
             PHCRYPTORNG_SW_OUTLEN,
-            pDataParams->V));
+            aOutputBlock));
 
         /* 4.3 temp = temp || output_block. */
         if(wNumBytesRequested >= PHCRYPTORNG_SW_OUTLEN)
         {
-            (void) memcpy(&pRndBytes[wIndex], pDataParams->V, PHCRYPTORNG_SW_OUTLEN);
+            (void) memcpy(&pRndBytes[wIndex], aOutputBlock, PHCRYPTORNG_SW_OUTLEN);
             wNumBytesRequested = wNumBytesRequested - PHCRYPTORNG_SW_OUTLEN;
         }
         else
         {
-            (void) memcpy(&pRndBytes[wIndex], pDataParams->V, wNumBytesRequested);
+            (void) memcpy(&pRndBytes[wIndex], aOutputBlock, wNumBytesRequested);
             wNumBytesRequested = 0;
         }
         wIndex = wIndex + PHCRYPTORNG_SW_OUTLEN;
     }
 
     /* 5. returned_bits = Leftmost requested_number_of_bits of temp. */
+    /* Clear output block for security reasons */
+    (void) memset(aOutputBlock, 0x00, (size_t) sizeof(aOutputBlock));
+
     /* Comment: Update for backtracking resistance. */
     /* 6. (Key, V) = Update (additional_input, Key, V). */
-    PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_Update(pDataParams, NULL));
+    PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoRng_Sw_Update(pDataParams, pProvidedData));
+
+    /* Clear additional input for security reasons */
+    (void) memset(aAdditionalInput, 0x00, (size_t) sizeof(aAdditionalInput));
 
     /* 7. reseed_counter = reseed_counter + 1. */
     pDataParams->dwRequestCounter++;
@@ -361,12 +538,19 @@ phStatus_t phCryptoRng_Sw_Generate(phCryptoRng_Sw_DataParams_t * pDataParams, ui
     return PH_ERR_SUCCESS;
 }
 
-phStatus_t phCryptoRng_Sw_BlockCipherDf(phCryptoRng_Sw_DataParams_t * pDataParams, uint8_t * pIoString)
+phStatus_t phCryptoRng_Sw_BlockCipherDf(phCryptoRng_Sw_DataParams_t * pDataParams, uint8_t * pInput, uint16_t wInputLength,
+    uint8_t * pOutput)
 {
     phStatus_t  PH_MEMLOC_REM statusTmp;
-    uint8_t     PH_MEMLOC_REM aCipher[4U * PHCRYPTORNG_SW_OUTLEN];
+    uint8_t     PH_MEMLOC_REM aCipher[PHCRYPTORNG_SW_DF_BUFLEN];
+    uint16_t    PH_MEMLOC_REM wCipherLength;
     uint8_t     PH_MEMLOC_REM bMacLength;
 
+    if(wInputLength > PHCRYPTORNG_SW_MAX_DF_INPUT)
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_CRYPTORNG);
+    }
+
     /* The cipher consists of IV || L || N || Input String || padding and needs to be done twice for IV = 0 and IV = 1*/
 
 #ifndef PH_CRYPTOSYM_SW_AES
@@ -384,19 +568,22 @@ phStatus_t phCryptoRng_Sw_BlockCipherDf(phCryptoRng_Sw_DataParams_t * pDataParam
     (void) memset(aCipher, 0x00, (size_t) sizeof(aCipher));
 
     /* Prepare the cipher */
-    /* We use the integers in LSB FIRST format - length is always 32 bits*/
+    /* Integers are 32 bit big endian as in sec. 10.3.2 of NIST SP 800-90A, only the low byte is non zero */
     /* S = L || N || input_string || 0x80. */
     /* 2. L = len (input_string)/8. */
-    aCipher[PHCRYPTORNG_SW_OUTLEN] = 0x20;
+    aCipher[PHCRYPTORNG_SW_OUTLEN + 3U] = (uint8_t)wInputLength;
 
     /* 3. N = number_of_bits_to_return/8. */
-    aCipher[PHCRYPTORNG_SW_OUTLEN + 4U] = 0x20;
+    aCipher[PHCRYPTORNG_SW_OUTLEN + 7U] = PHCRYPTORNG_SW_SEEDLEN;
 
     /* 4. S = L || N || input_string || 0x80. */
-    (void) memcpy(&aCipher[PHCRYPTORNG_SW_OUTLEN + 8U], pIoString, PHCRYPTORNG_SW_SEEDLEN);
+    (void) memcpy(&aCipher[PHCRYPTORNG_SW_OUTLEN + 8U], pInput, wInputLength);
 
     /* Add Padding */
-    aCipher[PHCRYPTORNG_SW_OUTLEN + 8U + PHCRYPTORNG_SW_SEEDLEN] = 0x80;
+    /* 5. While (len (S) mod outlen) != 0, S = S || 0x00. The buffer is already zero. */
+    aCipher[PHCRYPTORNG_SW_OUTLEN + 8U + wInputLength] = 0x80;
+    wCipherLength = (uint16_t)(PHCRYPTORNG_SW_OUTLEN + 8U + wInputLength + 1U);
+    wCipherLength = (uint16_t)((wCipherLength + PHCRYPTORNG_SW_OUTLEN - 1U) & ~(PHCRYPTORNG_SW_OUTLEN - 1U));
 
     /* The cipher now needs to be CBC-Maced twice. Both times using an IV of zero */
     /* FIRST ITERATION */
@@ -420,8 +607,8 @@ phStatus_t phCryptoRng_Sw_BlockCipherDf(phCryptoRng_Sw_DataParams_t * pDataParam
         pDataParams->pCryptoDataParams,
         PH_CRYPTOSYM_MAC_MODE_CBCMAC,
         aCipher,
-        (4U * PHCRYPTORNG_SW_OUTLEN),
-        pIoString,
+        wCipherLength,
+        pOutput,
         &bMacLength));
 
     /* SECOND ITERATION */
@@ -435,12 +622,12 @@ phStatus_t phCryptoRng_Sw_BlockCipherDf(phCryptoRng_Sw_DataParams_t * pDataParam
     /* 4.2 chaining_value = Block_Encrypt (Key, input_block).  */
     /* 5. output_block = chaining_value.  */
     /* Set the MAC mode to CBC mac which is equal to BCC*/
-    aCipher[0] = 0x01;
+    aCipher[3] = 0x01;
     PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoSym_CalculateMac(pDataParams->pCryptoDataParams,
         PH_CRYPTOSYM_MAC_MODE_CBCMAC,
         aCipher,
-        (4U * PHCRYPTORNG_SW_OUTLEN),
-        &pIoString[bMacLength],
+        wCipherLength,
+        &pOutput[bMacLength],
         &bMacLength));
 
     /* Finally we have calculated the Key */
@@ -451,48 +638,74 @@ phStatus_t phCryptoRng_Sw_BlockCipherDf(phCryptoRng_Sw_DataParams_t * pDataParam
     /* We can load the newly created key */
     PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoSym_LoadKeyDirect(
         pDataParams->pCryptoDataParams,
-        pIoString,
+        pOutput,
         PH_CRYPTOSYM_KEY_TYPE_AES128));
 #endif /* PH_CRYPTOSYM_SW_AES */
 
     /* 11. X = Next outlen bits of temp. */
     /* 13.1 X = Block_Encrypt (K, X). */
     /* 13.2 temp = temp || X. */
-    /* Encrypt X (which is upper part of pIoString) into lower part of pIoString. */
+    /* Encrypt X (which is upper part of pOutput) into lower part of pOutput. */
     PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoSym_Encrypt(pDataParams->pCryptoDataParams,
         PH_CRYPTOSYM_CIPHER_MODE_ECB,
-        &pIoString[PHCRYPTORNG_SW_KEYLEN],
+        &pOutput[PHCRYPTORNG_SW_KEYLEN],
         PHCRYPTORNG_SW_OUTLEN,
-        pIoString));
+        pOutput));
 
     /* 11. X = Next outlen bits of temp. */
     /* 13.1 X = Block_Encrypt (K, X). */
     /* 13.2 temp = temp || X. */
-    /* Encrypt X (which is now lower part of pIoString) into upper part of pIoString. */
+    /* Encrypt X (which is now lower part of pOutput) into upper part of pOutput. */
     PH_CHECK_SUCCESS_FCT(statusTmp, phCryptoSym_Encrypt(pDataParams->pCryptoDataParams,
         PH_CRYPTOSYM_CIPHER_MODE_ECB,
-        pIoString,
+        pOutput,
         PHCRYPTORNG_SW_OUTLEN,
-        &pIoString[PHCRYPTORNG_SW_KEYLEN]));
+        &pOutput[PHCRYPTORNG_SW_KEYLEN]));
 
     return PH_ERR_SUCCESS;
 }
 
+static phStatus_t phCryptoRng_Sw_ReseedIfDue(phCryptoRng_Sw_DataParams_t * pDataParams)
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+    uint8_t     PH_MEMLOC_REM aEntropy[PHCRYPTORNG_SW_SEEDLEN];
+
+    if ((pDataParams->pEntropyCb == NULL) || (pDataParams->dwRequestCounter < pDataParams->dwReseedInterval))
+    {
+        return PH_ERR_SUCCESS;
+    }
+
+    PH_CHECK_SUCCESS_FCT(statusTmp, pDataParams->pEntropyCb(pDataParams->pEntropyContext, aEntropy, (uint16_t)sizeof(aEntropy)));
+    statusTmp = phCryptoRng_Sw_Reseed(pDataParams, aEntropy, (uint16_t)sizeof(aEntropy), NULL, 0);
+    phCryptoRng_Sw_FlushPool(pDataParams);
+
+    /* Clear entropy for security reasons */
+    (void) memset(aEntropy, 0x00, (size_t) sizeof(aEntropy));
+
+    return PH_ADD_COMPCODE(statusTmp, PH_COMP_CRYPTORNG);
+}
+
+static void phCryptoRng_Sw_FlushPool(phCryptoRng_Sw_DataParams_t * pDataParams)
+{
+    (void) memset(pDataParams->aPool, 0x00, (size_t) sizeof(pDataParams->aPool));
+    pDataParams->wPoolLen = 0;
+}
+
 static void phCryptoRng_Sw_IncrementV(phCryptoRng_Sw_DataParams_t * pDataParams)
 {
     uint8_t PH_MEMLOC_REM bIndex;
 
-    /* Increment the V value of the pDataParams structure by 1 mod 2^128. Note: LSB is stored in position 0. */
-    for(bIndex = 0; bIndex < PHCRYPTORNG_SW_OUTLEN; ++bIndex)
+    /* Increment the V value of the pDataParams structure by 1 mod 2^128. Note: LSB is stored in position OUTLEN - 1 (big endian as in NIST SP 800-90A). */
+    for(bIndex = PHCRYPTORNG_SW_OUTLEN; bIndex > 0U; --bIndex)
     {
-        if(pDataParams->V[bIndex] < 0xFFU)
+        if(pDataParams->V[bIndex - 1U] < 0xFFU)
         {
-            ++pDataParams->V[bIndex];
+            ++pDataParams->V[bIndex - 1U];
             break;
         }
         else
         {
-            pDataParams->V[bIndex] = 0x00;
+            pDataParams->V[bIndex - 1U] = 0x00;
         }
     }
 }
@@ -46,6 +46,13 @@
 #define PHCRYPTORNG_SW_SEEDLEN  (PHCRYPTORNG_SW_OUTLEN + PHCRYPTORNG_SW_KEYLEN)
 #define PHCRYPTORNG_SW_MAX_BITS_DF_FUNCTION                                 512U
 
+/** \brief Longest input string of #phCryptoRng_Sw_BlockCipherDf, in bytes. */
+#define PHCRYPTORNG_SW_MAX_DF_INPUT                 (PHCRYPTORNG_SW_MAX_BITS_DF_FUNCTION / 8U)
+
+/** \brief IV || L || N || input string || 0x80, padded to whole blocks. */
+#define PHCRYPTORNG_SW_DF_BUFLEN    ((((PHCRYPTORNG_SW_OUTLEN + 8U + PHCRYPTORNG_SW_MAX_DF_INPUT + 1U) + \
+                                        (PHCRYPTORNG_SW_OUTLEN - 1U)) / PHCRYPTORNG_SW_OUTLEN) * PHCRYPTORNG_SW_OUTLEN)
+
 #define PHCRYPTORNG_SW_STATE_INIT                                           0x00U   /* Default State */
 #define PHCRYPTORNG_SW_STATE_WORKING                                        0x01U   /* Working State */
 
@@ -70,7 +77,7 @@ phStatus_t phCryptoRng_Sw_Update(
 
 /**
  * \brief Implements the instantiate function according to NIST SP800-90 section 10.2.1.3.2 (using derivation function).
- * Note: the length of all inputs together needs to be exactly #PHCRYPTORNG_SW_SEEDLEN
+ * Note: the length of all inputs together may not exceed #PHCRYPTORNG_SW_MAX_DF_INPUT, the entropy input is mandatory
  *
  * \return Status code
  * \retval #PH_ERR_SUCCESS Operation successful.
@@ -87,7 +94,7 @@ phStatus_t phCryptoRng_Sw_Instantiate(
 
 /**
  * \brief Implements the reseed function according to section 10.2.1.4.2 (using derivation function).
- * Note: the length of all inputs together needs to be exactly #PHCRYPTORNG_SW_SEEDLEN
+ * Note: the length of all inputs together may not exceed #PHCRYPTORNG_SW_MAX_DF_INPUT, the entropy input is mandatory
  *
  * \return Status code
  * \retval #PH_ERR_SUCCESS Operation successful.
@@ -102,7 +109,7 @@ phStatus_t phCryptoRng_Sw_Reseed(
 
 /**
  * \brief Implements the generate function according to section 10.2.1.5.2 (using derivation function).
- * Note: the length of the additional input needs to be exactly #PHCRYPTORNG_SW_SEEDLEN.
+ * Note: the length of the additional input may not exceed #PHCRYPTORNG_SW_MAX_DF_INPUT.
  * If an application does not support additional input, the pointer has to be set to NULL.
  *
  * \return Status code
@@ -111,6 +118,7 @@ phStatus_t phCryptoRng_Sw_Reseed(
 phStatus_t phCryptoRng_Sw_Generate(
         phCryptoRng_Sw_DataParams_t * pDataParams,                              /**< [In] Pointer to this layers parameter structure. */
         uint8_t * pAdditionalInput,                                             /**< [In] Additional Input can be NULL). */
+        uint8_t bAdditionalInputLength,                                         /**< [In] Length of Additional Input provided. */
         uint16_t wNumBytesRequested,                                            /**< [In] Amount of bytes requested. */
         uint8_t * pRndBytes                                                     /**< [Out] Random bytes generated. */
     );
@@ -119,14 +127,16 @@ phStatus_t phCryptoRng_Sw_Generate(
  * \brief Implements the BlockCipherDf according to NIST SP800-90 section 10.4.2.
  * Note: inside there are 10 encryptions performed. Although this takes quite some time, the implication on
  * overall system performance is rather low as this function is only called at startup and during reseeding.
- * Note: The input string needs to be exactly #PHCRYPTORNG_SW_SEEDLEN bytes.
+ * Note: The input string may be up to #PHCRYPTORNG_SW_MAX_DF_INPUT bytes, #PHCRYPTORNG_SW_SEEDLEN bytes are returned.
  *
  * \return Status code
  * \retval #PH_ERR_SUCCESS Operation successful.
  */
 phStatus_t phCryptoRng_Sw_BlockCipherDf(
         phCryptoRng_Sw_DataParams_t * pDataParams,                              /**< [In] Pointer to this layers parameter structure. */
-        uint8_t * pIoString                                                     /**< [InOut] pIoString of PHCRYPTORNG_SW_SEEDLEN bytes - contains input data and later output data. */
+        uint8_t * pInput,                                                       /**< [In] Input string, may be the same buffer as pOutput. */
+        uint16_t wInputLength,                                                  /**< [In] Length of the input string. */
+        uint8_t * pOutput                                                       /**< [Out] #PHCRYPTORNG_SW_SEEDLEN bytes of derived seed material. */
     );
 
 /**
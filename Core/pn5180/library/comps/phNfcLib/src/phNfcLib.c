@@ -1550,6 +1550,23 @@ phNfcLib_Status_t phNfcLib_SetConfig_Value(
             }
             break;
 
+#ifdef NXPBUILD__PH_NFCLIB_ISO_15693
+        case PH_NFCLIB_CONFIG_I15693_WRITE_TIMING:
+            if (gphNfcLib_State.bNfcLibState != eNfcLib_ResetState)
+            {
+                if ((dwValue == PH_NFCLIB_I15693_WRITE_TIMING_FIXED) || (dwValue == PH_NFCLIB_I15693_WRITE_TIMING_ADAPTIVE))
+                {
+                    phNfcLib_ISO15693_SetWriteTiming((uint8_t)dwValue);
+                    dwStatus = PH_NFCLIB_STATUS_SUCCESS;
+                }
+                else
+                {
+                    dwStatus = PH_NFCLIB_STATUS_INVALID_PARAMETER;
+                }
+            }
+            break;
+#endif /* NXPBUILD__PH_NFCLIB_ISO_15693 */
+
         default:
             dwStatus = PH_NFCLIB_STATUS_INVALID_PARAMETER;
             break;
@@ -1639,6 +1656,13 @@ phNfcLib_Status_t phNfcLib_GetConfig(
             }
             break;
 
+#ifdef NXPBUILD__PH_NFCLIB_ISO_15693
+        case PH_NFCLIB_CONFIG_I15693_WRITE_TIMING:
+            *pConfigParam = gphNfcLib_State.bI15693WriteTiming;
+            *pConfigParamLength = 1;
+            break;
+#endif /* NXPBUILD__PH_NFCLIB_ISO_15693 */
+
         default:
             dwStatus = PH_NFCLIB_STATUS_INVALID_PARAMETER;
             break;
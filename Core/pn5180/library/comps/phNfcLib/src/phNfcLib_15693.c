@@ -29,6 +29,10 @@
 #define PH_NFCLIB_15693_TIMEOUT_SHORT_US    384U
 #define PH_NFCLIB_15693_TIMEOUT_LONG_US   20060U
 
+#define PH_NFCLIB_15693_WRITE_START_US     2000U   /**< Wait per block before the first EOF for an IC type not learned yet. */
+#define PH_NFCLIB_15693_WRITE_STEP_US      1000U   /**< Further wait when the VICC ignored the EOF. */
+#define PH_NFCLIB_15693_WRITE_PROBE_US     (PHPAL_SLI15693_TIMEOUT_SHORT_US + 200U)  /**< One ignored EOF: EOF, SOF and short timeout. */
+
 #define PH_NFCLIB_15693_FLAGS_DSFID    0x01U   /**< Response flag DSFID. */
 #define PH_NFCLIB_15693_FLAGS_AFI      0x02U   /**< Response flag AFI. */
 #define PH_NFCLIB_15693_FLAGS_MEMSIZE  0x04U   /**< Response flag MEMSIZE. */
@@ -58,12 +62,36 @@ static phStatus_t NfcLib_WriteAlikeHandling(
                                      phStatus_t wExchangeStatus
                                      );
 
+static phStatus_t NfcLib_WriteAlikeAdaptive(void);
+
+static phNfcLib_I15693_WriteTiming_t * NfcLib_WriteTimingEntry(
+                                     const uint8_t * pUid
+                                     );
+
+void phNfcLib_ISO15693_SetWriteTiming(uint8_t bMode)
+{
+    uint8_t bIndex;
+
+    gphNfcLib_State.bI15693WriteTiming = bMode;
+    gphNfcLib_State.bI15693IcRef = PH_NFCLIB_I15693_IC_REF_UNKNOWN;
+    gphNfcLib_State.wI15693WriteClock = 0;
+    gphNfcLib_State.wI15693WriteBlocks = 0;
+    gphNfcLib_State.wI15693WriteWaitUs = 0;
+    gphNfcLib_State.pI15693Write = NULL;
+
+    for (bIndex = 0; bIndex < PH_NFCLIB_I15693_WRITE_TIMING_ENTRIES; bIndex++)
+    {
+        gphNfcLib_State.asI15693WriteTiming[bIndex].bValid = PH_OFF;
+    }
+}
+
 phStatus_t phNfcLib_ISO15693_Transmit(void * const pTxBuffer, uint16_t wTxBufferLength)
 {
     phStatus_t   wStatus  = PH_ERR_INVALID_PARAMETER;
     phStatus_t   statusTmp = PH_ERR_INVALID_PARAMETER;
     uint8_t      bCommand[5];
     uint8_t bExpLength = 0;
+    uint32_t dwWaitUs;
 
     (void)phpalSli15693_SetSerialNo(&gphNfcLib_Params.spalSli15693,
         ((phNfcLib_Transmit_t *)pTxBuffer)->phNfcLib_ISO15693.bUid,
@@ -95,6 +123,43 @@ phStatus_t phNfcLib_ISO15693_Transmit(void * const pTxBuffer, uint16_t wTxBuffer
                 gphNfcLib_Params.sDiscLoop.pHalDataParams,
                 PHHAL_HW_CONFIG_TIMEOUT_VALUE_US,
                 PH_NFCLIB_15693_TIMEOUT_LONG_US));
+
+        /* Adaptive write timing: EOF after the programming time learned for this IC type */
+        gphNfcLib_State.pI15693Write = NULL;
+        if ((gphNfcLib_State.bI15693WriteTiming == PH_NFCLIB_I15693_WRITE_TIMING_ADAPTIVE) &&
+            (0u != (((phNfcLib_Transmit_t *)pTxBuffer)->phNfcLib_ISO15693.bOption)))
+        {
+            gphNfcLib_State.pI15693Write = NfcLib_WriteTimingEntry(((phNfcLib_Transmit_t *)pTxBuffer)->phNfcLib_ISO15693.bUid);
+
+            gphNfcLib_State.wI15693WriteBlocks = 1;
+            if ((((phNfcLib_Transmit_t *)pTxBuffer)->phNfcLib_ISO15693.bCommand == ISO15693_WriteMultipleBlocks) ||
+                (((phNfcLib_Transmit_t *)pTxBuffer)->phNfcLib_ISO15693.bCommand == ISO15693_Extended_WriteMultipleBlocks))
+            {
+                if (((phNfcLib_Transmit_t *)pTxBuffer)->phNfcLib_ISO15693.wNumBlocks > 1U)
+                {
+                    gphNfcLib_State.wI15693WriteBlocks = ((phNfcLib_Transmit_t *)pTxBuffer)->phNfcLib_ISO15693.wNumBlocks;
+                }
+            }
+
+            if (gphNfcLib_State.pI15693Write->bValid != PH_OFF)
+            {
+                dwWaitUs = (uint32_t)gphNfcLib_State.pI15693Write->wBlockUs * gphNfcLib_State.wI15693WriteBlocks;
+            }
+            else
+            {
+                dwWaitUs = (uint32_t)PH_NFCLIB_15693_WRITE_START_US * gphNfcLib_State.wI15693WriteBlocks;
+            }
+            if (dwWaitUs > 0xFFFFU)
+            {
+                dwWaitUs = 0xFFFFU;
+            }
+            gphNfcLib_State.wI15693WriteWaitUs = (uint16_t)dwWaitUs;
+
+            PH_CHECK_SUCCESS_FCT(wStatus, phhalHw_SetConfig(
+                    gphNfcLib_Params.sDiscLoop.pHalDataParams,
+                    PHHAL_HW_CONFIG_TIMEOUT_VALUE_US,
+                    gphNfcLib_State.wI15693WriteWaitUs));
+        }
     }
     else
     {
@@ -621,6 +686,13 @@ phStatus_t phNfcLib_ISO15693_Transmit(void * const pTxBuffer, uint16_t wTxBuffer
         {
             return PH_ERR_PROTOCOL_ERROR;
         }
+
+        /* Remember the IC reference, it tells apart IC revisions with different programming times */
+        if (0U != ((gphNfcLib_State.pRxBuffer[0]) & PH_NFCLIB_15693_FLAGS_ICREF))
+        {
+            (void)memcpy(gphNfcLib_State.aI15693IcRefUid, ((phNfcLib_Transmit_t *)pTxBuffer)->phNfcLib_ISO15693.bUid, 8);
+            gphNfcLib_State.bI15693IcRef = gphNfcLib_State.pRxBuffer[bExpLength - 1U];
+        }
         break;
 
     case ISO15693_ExtendedGetSystemInformation:
@@ -787,6 +859,11 @@ static phStatus_t NfcLib_WriteAlikeHandling(
 
         /* Timeout is correct behaviour, send EOF */
     case PH_ERR_IO_TIMEOUT:
+        if (gphNfcLib_State.pI15693Write != NULL)
+        {
+            return NfcLib_WriteAlikeAdaptive();
+        }
+
         /* card answers after next EOF -> correct status is timeout */
         return phpalSli15693_SendEof(
             &gphNfcLib_Params.spalSli15693,
@@ -815,4 +892,108 @@ static phStatus_t NfcLib_WriteAlikeHandling(
         return wExchangeStatus;
     }
 }
+
+static phNfcLib_I15693_WriteTiming_t * NfcLib_WriteTimingEntry(
+                                     const uint8_t * pUid
+                                     )
+{
+    phNfcLib_I15693_WriteTiming_t * pEntry;
+    phNfcLib_I15693_WriteTiming_t * pOldest = &gphNfcLib_State.asI15693WriteTiming[0];
+    uint8_t bIcRef = PH_NFCLIB_I15693_IC_REF_UNKNOWN;
+    uint8_t bIndex;
+
+    /* IC reference is only known for the VICC GetSystemInformation was last sent to */
+    if (memcmp(gphNfcLib_State.aI15693IcRefUid, pUid, 8) == 0)
+    {
+        bIcRef = gphNfcLib_State.bI15693IcRef;
+    }
+
+    ++gphNfcLib_State.wI15693WriteClock;
+    for (bIndex = 0; bIndex < PH_NFCLIB_I15693_WRITE_TIMING_ENTRIES; bIndex++)
+    {
+        pEntry = &gphNfcLib_State.asI15693WriteTiming[bIndex];
+        if ((pEntry->bValid != PH_OFF) && (pEntry->bMfgCode == pUid[6]) &&
+            (pEntry->bIcType == pUid[5]) && (pEntry->bIcRef == bIcRef))
+        {
+            pEntry->wLastUse = gphNfcLib_State.wI15693WriteClock;
+            return pEntry;
+        }
+
+        /* Free entry first, otherwise the least recently used one */
+        if ((pOldest->bValid != PH_OFF) && ((pEntry->bValid == PH_OFF) ||
+            ((uint16_t)(gphNfcLib_State.wI15693WriteClock - pEntry->wLastUse) > (uint16_t)(gphNfcLib_State.wI15693WriteClock - pOldest->wLastUse))))
+        {
+            pOldest = pEntry;
+        }
+    }
+
+    pOldest->bValid = PH_OFF;
+    pOldest->bMfgCode = pUid[6];
+    pOldest->bIcType = pUid[5];
+    pOldest->bIcRef = bIcRef;
+    pOldest->wBlockUs = PH_NFCLIB_15693_WRITE_START_US;
+    pOldest->wLastUse = gphNfcLib_State.wI15693WriteClock;
+    return pOldest;
+}
+
+static phStatus_t NfcLib_WriteAlikeAdaptive(void)
+{
+    phStatus_t   status;
+    phStatus_t   statusTmp;
+    uint8_t      bDsfid;
+    uint8_t      bUid[PHPAL_SLI15693_UID_LENGTH];
+    uint8_t      bUidLength;
+    uint8_t      bData[1];
+    uint16_t     wDataLength = 0;
+    uint32_t     dwWaitUs = gphNfcLib_State.wI15693WriteWaitUs;
+    uint32_t     dwBlockUs;
+    uint8_t      bSteps = 0;
+    phNfcLib_I15693_WriteTiming_t * pEntry = gphNfcLib_State.pI15693Write;
+
+    gphNfcLib_State.pI15693Write = NULL;
+
+    do
+    {
+        /* A VICC still programming ignores the EOF */
+        status = phpalSli15693_SendEof(
+            &gphNfcLib_Params.spalSli15693,
+            PHPAL_SLI15693_EOF_WRITE_ALIKE_PROBE,
+            &bDsfid,
+            bUid,
+            &bUidLength,
+            bData,
+            &wDataLength);
+
+        if ((status & PH_ERR_MASK) != PH_ERR_IO_TIMEOUT)
+        {
+            /* Learn the time of a new IC type, raise the time when the EOF came too early */
+            if (((status & PH_ERR_MASK) == PH_ERR_SUCCESS) && ((pEntry->bValid == PH_OFF) || (bSteps != 0U)))
+            {
+                dwBlockUs = (dwWaitUs + gphNfcLib_State.wI15693WriteBlocks - 1U) / gphNfcLib_State.wI15693WriteBlocks;
+                pEntry->wBlockUs = (uint16_t)dwBlockUs;
+                pEntry->bValid = PH_ON;
+            }
+            return status;
+        }
+
+        dwWaitUs += PH_NFCLIB_15693_WRITE_PROBE_US + PH_NFCLIB_15693_WRITE_STEP_US;
+        ++bSteps;
+
+        PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_Wait(
+            gphNfcLib_Params.spalSli15693.pHalDataParams,
+            PHHAL_HW_TIME_MICROSECONDS,
+            PH_NFCLIB_15693_WRITE_STEP_US));
+    }
+    while (dwWaitUs < ((uint32_t)PH_NFCLIB_15693_TIMEOUT_LONG_US * gphNfcLib_State.wI15693WriteBlocks));
+
+    /* Not answered within the fixed timing per block, last EOF as in fixed mode */
+    return phpalSli15693_SendEof(
+        &gphNfcLib_Params.spalSli15693,
+        PHPAL_SLI15693_EOF_WRITE_ALIKE,
+        &bDsfid,
+        bUid,
+        &bUidLength,
+        bData,
+        &wDataLength);
+}
 #endif /* NXPBUILD__PH_NFCLIB_ISO_15693*/
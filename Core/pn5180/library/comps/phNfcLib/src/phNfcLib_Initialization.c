@@ -24,6 +24,8 @@
 #ifdef NXPBUILD__PHNFCLIB
 
 #include "phNfcLib_Initialization.h"
+#include "phNfcLib_Int.h"
+#include <ph_RefDefs.h>
 
 /*******************************************************************************
 **   Macro Declaration
@@ -58,8 +60,12 @@
 **   Global Variable Declaration
 *******************************************************************************/
 
-phNfcLib_DataParams_t    gphNfcLib_Params;
-phNfcLib_InternalState_t gphNfcLib_State;
+phNfcLib_DataParams_t    gphNfcLib_ReaderParams[PH_NXPNFCRDLIB_CONFIG_READER_COUNT];
+/* Reader state holds the HAL TX/RX buffers, kept out of the main RAM bank */
+PH_MEMLOC_RAM2 phNfcLib_InternalState_t gphNfcLib_ReaderState[PH_NXPNFCRDLIB_CONFIG_READER_COUNT];
+
+phNfcLib_DataParams_t    * gpphNfcLib_Params = &gphNfcLib_ReaderParams[0];
+phNfcLib_InternalState_t * gpphNfcLib_State  = &gphNfcLib_ReaderState[0];
 
 #ifdef NXPBUILD__PHAL_MFDUOX_SW
 static uint8_t aCmdBuffer[PHAL_MFDUOX_CMD_BUFFER_SIZE_MINIMUM];
@@ -84,7 +90,7 @@ static uint8_t          aSeed[SEED_COUNT];
 
 #ifdef NXPBUILD__PH_TMIUTILS
 #define TMI_BUFFER_SIZE 255                     /* TMI Buffer Size */
-static uint8_t aTmi_Buffer[TMI_BUFFER_SIZE];
+PH_MEMLOC_RAM2 static uint8_t aTmi_Buffer[TMI_BUFFER_SIZE];
 #endif /* NXPBUILD__PH_TMIUTILS */
 
 #ifdef NXPBUILD__PHAL_VCA_SW
@@ -101,7 +107,7 @@ static phalVca_Sw_DataParams_t     sVca;
 #endif /* NXPBUILD__PHAL_VCA_SW */
 
 #ifdef NXPBUILD__PH_TMIUTILS
-static phTMIUtils_t                sTMI;
+PH_MEMLOC_RAM2 static phTMIUtils_t                sTMI;
 #endif /* NXPBUILD__PH_TMIUTILS */
 
 #if defined(NXPBUILD__PHAL_VCA_SAM_NONX) && defined(NXPBUILD__PHAL_VCA_SAMAV3_NONX)
@@ -112,7 +118,7 @@ static phalVca_SamAV3_NonX_DataParams_t   sVca_SamNonX;
           defined (NXPBUILD__PHAL_MFDFEVX_SAM_NONX) || defined (NXPBUILD__PHAL_MFPEVX_SAM_NONX) || defined(NXPBUILD__PHAL_MFDUOX_SW) */
 
 #ifdef NXPBUILD__PH_CRYPTOSYM_SW
-static phCryptoSym_Sw_DataParams_t sCryptoSymRng;
+PH_MEMLOC_RAM2 static phCryptoSym_Sw_DataParams_t sCryptoSymRng;
 #endif /* NXPBUILD__PH_CRYPTOSYM_SW */
 
 #if defined (NXPBUILD__PH_KEYSTORE_SW) || defined(NXPBUILD__PH_KEYSTORE_SAMAV3)
@@ -124,9 +130,9 @@ static uint8_t gphNfcLib_Key[12] = {0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0x
  * SW Key Structure Pointers
  */
 #ifdef NXPBUILD__PH_KEYSTORE_SW
-static phKeyStore_Sw_KeyEntry_t        gpKeyEntries[NUMBER_OF_KEYENTRIES];
-static phKeyStore_Sw_KeyVersionPair_t  gpKeyVersionPairs[NUMBER_OF_KEYVERSIONPAIRS * NUMBER_OF_KEYENTRIES];
-static phKeyStore_Sw_KUCEntry_t        gpKUCEntries[NUMBER_OF_KUCENTRIES];
+PH_MEMLOC_RAM2 static phKeyStore_Sw_KeyEntry_t        gpKeyEntries[NUMBER_OF_KEYENTRIES];
+PH_MEMLOC_RAM2 static phKeyStore_Sw_KeyVersionPair_t  gpKeyVersionPairs[NUMBER_OF_KEYVERSIONPAIRS * NUMBER_OF_KEYENTRIES];
+PH_MEMLOC_RAM2 static phKeyStore_Sw_KUCEntry_t        gpKUCEntries[NUMBER_OF_KUCENTRIES];
 #endif /* NXPBUILD__PH_KEYSTORE_SW */
 
 #ifdef NXPBUILD__PHCE_T4T_SW
@@ -135,7 +141,7 @@ static phKeyStore_Sw_KUCEntry_t        gpKUCEntries[NUMBER_OF_KUCENTRIES];
  * between application thread and reader library thread. Refer phceT4T_Init in
  * phceT4T.h for more info.
  * */
-uint8_t aAppHCEBuf[PH_NXPNFCRDLIB_CONFIG_HCE_BUFF_LENGTH];
+PH_MEMLOC_RAM2 uint8_t aAppHCEBuf[PH_NXPNFCRDLIB_CONFIG_HCE_BUFF_LENGTH];
 #endif /* NXPBUILD__PHCE_T4T_SW */
 
 #ifdef NXPBUILD__PHPAL_I14443P4_SW
@@ -233,6 +239,30 @@ uint8_t aAppHCEBuf[PH_NXPNFCRDLIB_CONFIG_HCE_BUFF_LENGTH];
 /*******************************************************************************
 **   Function Declarations
 *******************************************************************************/
+phNfcLib_Status_t phNfcLib_SelectReader(uint8_t bReader)
+{
+    if (bReader >= PH_NXPNFCRDLIB_CONFIG_READER_COUNT)
+    {
+        return PH_NFCLIB_STATUS_INVALID_PARAMETER;
+    }
+
+    /* Only switch between transactions, a peer activated on this reader stays with it */
+    if (((phNfcLib_StateMachine_t)gphNfcLib_State.bNfcLibState) == eNfcLib_DeactOngoingState)
+    {
+        return PH_NFCLIB_STATUS_INVALID_STATE;
+    }
+
+    gpphNfcLib_Params = &gphNfcLib_ReaderParams[bReader];
+    gpphNfcLib_State  = &gphNfcLib_ReaderState[bReader];
+
+    return PH_NFCLIB_STATUS_SUCCESS;
+}
+
+uint8_t phNfcLib_GetSelectedReader(void)
+{
+    return (uint8_t)(gpphNfcLib_Params - &gphNfcLib_ReaderParams[0]);
+}
+
 /**
 * This function will initialize Reader Library Common Layer Components
 */
@@ -909,6 +939,9 @@ phNfcLib_Status_t phNfcLib_Init(void)
             gphNfcLib_State.bAuthMode         = PH_NFCLIB_MFDF_NOT_AUTHENTICATED;
             gphNfcLib_Params.pNfcLib_ErrCallbck = NULL;
             gphNfcLib_State.bFsdi             = PH_NXPNFCRDLIB_CONFIG_FSDI_VALUE;
+#ifdef NXPBUILD__PH_NFCLIB_ISO_15693
+            phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_FIXED);
+#endif /* NXPBUILD__PH_NFCLIB_ISO_15693 */
 
             dwStatus = PH_NFCLIB_STATUS_SUCCESS;
         }
@@ -953,6 +986,9 @@ phNfcLib_Status_t phNfcLib_DeInit(void)
         gphNfcLib_State.bAuthMode = PH_NFCLIB_MFDF_NOT_AUTHENTICATED;
         gphNfcLib_Params.pNfcLib_ErrCallbck = NULL;
         gphNfcLib_State.bFsdi             = PH_NXPNFCRDLIB_CONFIG_FSDI_VALUE;
+#ifdef NXPBUILD__PH_NFCLIB_ISO_15693
+        phNfcLib_ISO15693_SetWriteTiming(PH_NFCLIB_I15693_WRITE_TIMING_FIXED);
+#endif /* NXPBUILD__PH_NFCLIB_ISO_15693 */
 
         dwStatus = PH_NFCLIB_STATUS_SUCCESS;
     }
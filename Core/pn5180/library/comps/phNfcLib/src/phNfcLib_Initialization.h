@@ -40,6 +40,22 @@ typedef phStatus_t (*pphNfcLib_Config_Profile)(void);
 /* By default invalid authentication status */
 #define PH_NFCLIB_MFDF_NOT_AUTHENTICATED             0xFFU   /**< No authentication. */
 
+#define PH_NFCLIB_I15693_WRITE_TIMING_ENTRIES        4U      /**< IC types whose programming time is remembered. */
+#define PH_NFCLIB_I15693_IC_REF_UNKNOWN              0xFFU   /**< No GetSystemInformation with IC reference seen. */
+
+/**
+* \brief Programming time learned for one ISO 15693 IC type
+*/
+typedef struct
+{
+    uint8_t  bMfgCode;                                             /* UID byte 6, IC manufacturer */
+    uint8_t  bIcType;                                              /* UID byte 5, IC type on NXP tags */
+    uint8_t  bIcRef;                                               /* IC reference from GetSystemInformation */
+    uint8_t  bValid;
+    uint16_t wBlockUs;                                             /* Time from the end of the command to the EOF, per block */
+    uint16_t wLastUse;
+} phNfcLib_I15693_WriteTiming_t;
+
 /**
 * \brief NFCLIB parameter structure
 */
@@ -281,10 +297,30 @@ typedef struct
     uint16_t wActivatedUIDLength;                                  /* Length of the activated UID */
     uint8_t* pActivatedUid;                                        /* Contains the pointer of the activated Uid */
     uint8_t bFsdi;                                                 /* Frame Size Device Integer value. Note: This Parameter is used only in EMVCo profile. */
+#ifdef NXPBUILD__PH_NFCLIB_ISO_15693
+    uint8_t  bI15693WriteTiming;                                   /* PH_NFCLIB_I15693_WRITE_TIMING_FIXED or _ADAPTIVE */
+    uint8_t  bI15693IcRef;                                         /* IC reference of the last GetSystemInformation */
+    uint8_t  aI15693IcRefUid[8];                                   /* UID it was received from */
+    uint16_t wI15693WriteClock;                                    /* Use counter of the learned entries */
+    uint16_t wI15693WriteBlocks;                                   /* Blocks of the write alike command in progress */
+    uint16_t wI15693WriteWaitUs;                                   /* Its wait before the first EOF */
+    phNfcLib_I15693_WriteTiming_t * pI15693Write;                  /* Its IC type entry */
+    phNfcLib_I15693_WriteTiming_t asI15693WriteTiming[PH_NFCLIB_I15693_WRITE_TIMING_ENTRIES];
+#endif /* NXPBUILD__PH_NFCLIB_ISO_15693 */
 } phNfcLib_InternalState_t;
 
-extern phNfcLib_DataParams_t    gphNfcLib_Params;
-extern phNfcLib_InternalState_t gphNfcLib_State;
+/**
+ * One stack instance (HAL, PAL, AL, discovery loop and NFCLIB state) per front-end.
+ * The NFCLIB code always works on the active instance selected by \ref phNfcLib_SelectReader.
+ */
+extern phNfcLib_DataParams_t    gphNfcLib_ReaderParams[PH_NXPNFCRDLIB_CONFIG_READER_COUNT];
+extern phNfcLib_InternalState_t gphNfcLib_ReaderState[PH_NXPNFCRDLIB_CONFIG_READER_COUNT];
+
+extern phNfcLib_DataParams_t    * gpphNfcLib_Params;
+extern phNfcLib_InternalState_t * gpphNfcLib_State;
+
+#define gphNfcLib_Params    (*gpphNfcLib_Params)    /**< Active reader instance. */
+#define gphNfcLib_State     (*gpphNfcLib_State)     /**< State of the active reader instance. */
 
 #endif /* NXPBUILD__PHNFCLIB */
 
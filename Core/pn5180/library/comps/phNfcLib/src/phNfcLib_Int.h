@@ -77,6 +77,7 @@ phStatus_t phNfcLib_MFDF_Transmit(void * const pTxBuffer, uint16_t wTxBufferLeng
 
 #ifdef NXPBUILD__PH_NFCLIB_ISO_15693
 phStatus_t phNfcLib_ISO15693_Transmit(void * const pTxBuffer, uint16_t wTxBufferLength);
+void phNfcLib_ISO15693_SetWriteTiming(uint8_t bMode);
 #endif /* NXPBUILD__PH_NFCLIB_ISO_15693 */
 
 #ifdef NXPBUILD__PH_NFCLIB_ISO_18000
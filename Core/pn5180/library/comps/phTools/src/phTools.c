@@ -38,6 +38,27 @@
 
 static uint8_t phTools_CalcParity(uint8_t bDataByte, uint8_t bOption);
 
+/** \brief Even parity (XOR of all bits) of every byte value, XOR with #PH_TOOLS_PARITY_OPTION_ODD gives odd parity. */
+static const uint8_t PH_MEMLOC_CONST_ROM phTools_ParityTable[256] =
+{
+    0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U,
+    0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U,
+    0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U,
+    0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U,
+    0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U,
+    0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U,
+    0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U,
+    0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U,
+    0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U,
+    0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U,
+    0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U,
+    0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U,
+    0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U,
+    0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U,
+    0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U,
+    0x00U, 0x01U, 0x01U, 0x00U, 0x01U, 0x00U, 0x00U, 0x01U, 0x01U, 0x00U, 0x00U, 0x01U, 0x00U, 0x01U, 0x01U, 0x00U
+};
+
 phStatus_t phTools_EncodeParity(
                                 uint8_t bOption,
                                 uint8_t * pInBuffer,
@@ -48,6 +69,293 @@ phStatus_t phTools_EncodeParity(
                                 uint16_t * pOutBufferLength,
                                 uint8_t * pOutBufferBits
                                 )
+{
+    uint16_t    PH_MEMLOC_REM wByteIndexIn;
+    uint16_t    PH_MEMLOC_REM wByteIndexOut;
+    uint16_t    PH_MEMLOC_REM wInByteCount;
+    uint32_t    PH_MEMLOC_REM dwBits;
+    uint8_t     PH_MEMLOC_REM bNumBits;
+    uint8_t *   PH_MEMLOC_REM pIn;
+    uint8_t *   PH_MEMLOC_REM pOut;
+
+    /* Parameter check */
+    if (((bOption != PH_TOOLS_PARITY_OPTION_EVEN) && (bOption != PH_TOOLS_PARITY_OPTION_ODD)) || (bInBufferBits > 7U))
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_TOOLS);
+    }
+
+    /* Retrieve full input byte count */
+    if (bInBufferBits == 0U)
+    {
+        wInByteCount = wInBufferLength;
+    }
+    else
+    {
+        wInByteCount = wInBufferLength - 1u;
+    }
+
+    /* Retrieve number of (additional) full bytes */
+    (*pOutBufferLength) = (uint16_t)((uint16_t)(wInByteCount + bInBufferBits) >> 3U);
+
+    /* Retrieve output bits */
+    *pOutBufferBits = (uint8_t)((uint16_t)(wInByteCount + bInBufferBits) % 8U);
+
+    /* Increment output length in case of incomplete byte */
+    if (*pOutBufferBits > 0U)
+    {
+        ++(*pOutBufferLength);
+    }
+
+    /* Overflow check */
+    if ((*pOutBufferLength) > (0xFFFFU - wInByteCount))
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_TOOLS);
+    }
+
+    /* Calculate number of output bytes */
+    (*pOutBufferLength) = wInByteCount + (*pOutBufferLength);
+
+    /* Buffer overflow check*/
+    if (wOutBufferSize < (*pOutBufferLength))
+    {
+        (*pOutBufferLength) = 0;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_BUFFER_OVERFLOW, PH_COMP_TOOLS);
+    }
+
+    wByteIndexIn = 0;
+    wByteIndexOut = 0;
+
+    /* 8 data bytes with their parity bits fill exactly 9 output bytes, so the shifts are fixed. */
+    /* Byte n of the group starts at bit 9n, its parity bit is bit n of output byte n + 1. */
+    while ((wByteIndexIn + 8U) <= wInByteCount)
+    {
+        pIn = &pInBuffer[wByteIndexIn];
+        pOut = &pOutBuffer[wByteIndexOut];
+
+        pOut[0] = pIn[0];
+        pOut[1] = (uint8_t)((phTools_ParityTable[pIn[0]] ^ bOption)        | (uint8_t)(pIn[1] << 1U));
+        pOut[2] = (uint8_t)((pIn[1] >> 7U) | ((phTools_ParityTable[pIn[1]] ^ bOption) << 1U) | (uint8_t)(pIn[2] << 2U));
+        pOut[3] = (uint8_t)((pIn[2] >> 6U) | ((phTools_ParityTable[pIn[2]] ^ bOption) << 2U) | (uint8_t)(pIn[3] << 3U));
+        pOut[4] = (uint8_t)((pIn[3] >> 5U) | ((phTools_ParityTable[pIn[3]] ^ bOption) << 3U) | (uint8_t)(pIn[4] << 4U));
+        pOut[5] = (uint8_t)((pIn[4] >> 4U) | ((phTools_ParityTable[pIn[4]] ^ bOption) << 4U) | (uint8_t)(pIn[5] << 5U));
+        pOut[6] = (uint8_t)((pIn[5] >> 3U) | ((phTools_ParityTable[pIn[5]] ^ bOption) << 5U) | (uint8_t)(pIn[6] << 6U));
+        pOut[7] = (uint8_t)((pIn[6] >> 2U) | ((phTools_ParityTable[pIn[6]] ^ bOption) << 6U) | (uint8_t)(pIn[7] << 7U));
+        pOut[8] = (uint8_t)((pIn[7] >> 1U) | ((phTools_ParityTable[pIn[7]] ^ bOption) << 7U));
+
+        wByteIndexIn += 8U;
+        wByteIndexOut += 9U;
+    }
+
+    /* Remaining full bytes: append data and parity as 9 bit words to a bit accumulator */
+    dwBits = 0;
+    bNumBits = 0;
+    for (; wByteIndexIn < wInByteCount; ++wByteIndexIn)
+    {
+        dwBits |= ((uint32_t)pInBuffer[wByteIndexIn] | ((uint32_t)(phTools_ParityTable[pInBuffer[wByteIndexIn]] ^ bOption) << 8U)) << bNumBits;
+        bNumBits += 9U;
+        while (bNumBits >= 8U)
+        {
+            pOutBuffer[wByteIndexOut++] = (uint8_t)dwBits;
+            dwBits >>= 8U;
+            bNumBits -= 8U;
+        }
+    }
+
+    /* Incomplete last byte, no parity */
+    if (bInBufferBits > 0U)
+    {
+        dwBits |= (uint32_t)((uint8_t)(pInBuffer[wByteIndexIn] & (uint8_t)(0xFFU >> (8U - bInBufferBits)))) << bNumBits;
+        bNumBits += bInBufferBits;
+        if (bNumBits >= 8U)
+        {
+            pOutBuffer[wByteIndexOut++] = (uint8_t)dwBits;
+            dwBits >>= 8U;
+            bNumBits -= 8U;
+        }
+    }
+
+    /* Flush, bits above the valid ones are already zero */
+    if (bNumBits > 0U)
+    {
+        pOutBuffer[wByteIndexOut] = (uint8_t)dwBits;
+    }
+
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phTools_DecodeParity(
+                                uint8_t bOption,
+                                uint8_t * pInBuffer,
+                                uint16_t wInBufferLength,
+                                uint8_t bInBufferBits,
+                                uint16_t wOutBufferSize,
+                                uint8_t * pOutBuffer,
+                                uint16_t * pOutBufferLength,
+                                uint8_t * pOutBufferBits
+                                )
+{
+    uint16_t    PH_MEMLOC_REM wByteIndexIn;
+    uint16_t    PH_MEMLOC_REM wByteIndexOut;
+    uint16_t    PH_MEMLOC_REM wCheckedLength;
+    uint8_t     PH_MEMLOC_REM bBitPosition;
+    uint16_t    PH_MEMLOC_REM wDiv;
+    uint8_t     PH_MEMLOC_REM bMod;
+    uint8_t     PH_MEMLOC_REM bParity;
+    uint8_t     PH_MEMLOC_REM bReceived;
+    uint8_t *   PH_MEMLOC_REM pIn;
+    uint8_t *   PH_MEMLOC_REM pOut;
+
+    /* Parameter check */
+    if (((bOption != PH_TOOLS_PARITY_OPTION_EVEN) && (bOption != PH_TOOLS_PARITY_OPTION_ODD)) || (bInBufferBits > 7U))
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_TOOLS);
+    }
+
+    /* Parameter check */
+    if (wInBufferLength == 0U)
+    {
+        /* Zero input length is simply passed through */
+        if (bInBufferBits == 0U)
+        {
+            (*pOutBufferLength) = 0;
+            *pOutBufferBits = 0;
+            return PH_ERR_SUCCESS;
+        }
+        /* Invalid parameter */
+        else
+        {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_TOOLS);
+        }
+    }
+
+    /* Retrieve DIV and MOD */
+    if (bInBufferBits == 0U)
+    {
+        wDiv = (uint16_t)(wInBufferLength / 9U);
+        bMod = (uint8_t)(wInBufferLength % 9U);
+    }
+    else
+    {
+        wDiv = (uint16_t)((wInBufferLength - 1U) / 9U);
+        bMod = (uint8_t)((wInBufferLength - 1U) % 9U);
+    }
+
+    /* Calculate number of output bytes */
+    (*pOutBufferLength) = (uint16_t)((wDiv << 3U) + bMod);
+    if (bMod > bInBufferBits)
+    {
+        --(*pOutBufferLength);
+    }
+
+    /* Calculate number of rest-bits of output */
+    *pOutBufferBits = (uint8_t)((8U - (((8U + ((*pOutBufferLength) % 8U)) - bInBufferBits) % 8U)) % 8U);
+
+    /* Increment output length in case of incomplete byte */
+    if (*pOutBufferBits > 0U)
+    {
+        ++(*pOutBufferLength);
+    }
+
+    /* Buffer overflow check*/
+    if (wOutBufferSize < (*pOutBufferLength))
+    {
+        (*pOutBufferLength) = 0;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_BUFFER_OVERFLOW, PH_COMP_TOOLS);
+    }
+
+    /* An incomplete last byte carries no parity */
+    wCheckedLength = (*pOutBufferBits == 0U) ? (*pOutBufferLength) : (uint16_t)((*pOutBufferLength) - 1U);
+
+    wByteIndexIn = 0U;
+    wByteIndexOut = 0U;
+
+    /* 9 input bytes hold 8 data bytes and their parity bits, so the shifts are fixed. */
+    /* The parity bit of data byte n is bit n of input byte n + 1. */
+    while (((wByteIndexOut + 8U) <= wCheckedLength) && ((wByteIndexIn + 9U) <= wInBufferLength))
+    {
+        pIn = &pInBuffer[wByteIndexIn];
+        pOut = &pOutBuffer[wByteIndexOut];
+
+        pOut[0] = pIn[0];
+        pOut[1] = (uint8_t)((pIn[1] >> 1U) | (uint8_t)(pIn[2] << 7U));
+        pOut[2] = (uint8_t)((pIn[2] >> 2U) | (uint8_t)(pIn[3] << 6U));
+        pOut[3] = (uint8_t)((pIn[3] >> 3U) | (uint8_t)(pIn[4] << 5U));
+        pOut[4] = (uint8_t)((pIn[4] >> 4U) | (uint8_t)(pIn[5] << 4U));
+        pOut[5] = (uint8_t)((pIn[5] >> 5U) | (uint8_t)(pIn[6] << 3U));
+        pOut[6] = (uint8_t)((pIn[6] >> 6U) | (uint8_t)(pIn[7] << 2U));
+        pOut[7] = (uint8_t)((pIn[7] >> 7U) | (uint8_t)(pIn[8] << 1U));
+
+        /* Check all 8 parity bits at once */
+        bParity = (uint8_t)(phTools_ParityTable[pOut[0]]
+            | (uint8_t)(phTools_ParityTable[pOut[1]] << 1U)
+            | (uint8_t)(phTools_ParityTable[pOut[2]] << 2U)
+            | (uint8_t)(phTools_ParityTable[pOut[3]] << 3U)
+            | (uint8_t)(phTools_ParityTable[pOut[4]] << 4U)
+            | (uint8_t)(phTools_ParityTable[pOut[5]] << 5U)
+            | (uint8_t)(phTools_ParityTable[pOut[6]] << 6U)
+            | (uint8_t)(phTools_ParityTable[pOut[7]] << 7U));
+        bReceived = (uint8_t)((pIn[1] & 0x01U) | (pIn[2] & 0x02U) | (pIn[3] & 0x04U) | (pIn[4] & 0x08U)
+            | (pIn[5] & 0x10U) | (pIn[6] & 0x20U) | (pIn[7] & 0x40U) | (pIn[8] & 0x80U));
+        if ((uint8_t)(bParity ^ (uint8_t)(0U - bOption)) != bReceived)
+        {
+            return PH_ADD_COMPCODE_FIXED(PH_ERR_INTEGRITY_ERROR, PH_COMP_TOOLS);
+        }
+
+        wByteIndexIn += 9U;
+        wByteIndexOut += 8U;
+    }
+
+    /* Remaining bytes one at a time, the group loop leaves the input aligned */
+    bBitPosition = 7U;
+    for (; wByteIndexOut < (*pOutBufferLength); ++wByteIndexOut, ++wByteIndexIn, --bBitPosition)
+    {
+        /* Append source bits to output */
+        pOutBuffer[wByteIndexOut] = (uint8_t)(pInBuffer[wByteIndexIn] >> (7U - bBitPosition));
+
+        /* If there is more data bits in the sourcebyte append it to next data byte */
+        if ((wByteIndexIn + 1U) < wInBufferLength)
+        {
+            /* Append remaining bits to output */
+            pOutBuffer[wByteIndexOut] |= (uint8_t)(pInBuffer[wByteIndexIn + 1U] << (1U + bBitPosition));
+
+            /* Perform parity checking if this isn't an incomplete byte */
+            if (wByteIndexOut < wCheckedLength)
+            {
+                bParity = phTools_ParityTable[pOutBuffer[wByteIndexOut]] ^ bOption;
+                if (((pInBuffer[wByteIndexIn + 1U] >> (7U - bBitPosition)) & 0x01U) != bParity)
+                {
+                    return PH_ADD_COMPCODE_FIXED(PH_ERR_INTEGRITY_ERROR, PH_COMP_TOOLS);
+                }
+            }
+        }
+
+        /* We have reached the 8th parity bit, the input buffer index is now one ahead */
+        if (bBitPosition == 0U)
+        {
+            bBitPosition = 8;
+            ++wByteIndexIn;
+        }
+    }
+
+    /* Mask out invalid bits of last byte */
+    if (*pOutBufferBits > 0U)
+    {
+        pOutBuffer[(*pOutBufferLength) - 1U] &= (uint8_t)(0xFFU >> (8U - *pOutBufferBits));
+    }
+
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phTools_EncodeParityRef(
+                                uint8_t bOption,
+                                uint8_t * pInBuffer,
+                                uint16_t wInBufferLength,
+                                uint8_t bInBufferBits,
+                                uint16_t wOutBufferSize,
+                                uint8_t * pOutBuffer,
+                                uint16_t * pOutBufferLength,
+                                uint8_t * pOutBufferBits
+                                )
 {
     uint16_t    PH_MEMLOC_REM wByteIndexIn;
     uint16_t    PH_MEMLOC_REM wByteIndexOut;
@@ -154,7 +462,7 @@ phStatus_t phTools_EncodeParity(
     return PH_ERR_SUCCESS;
 }
 
-phStatus_t phTools_DecodeParity(
+phStatus_t phTools_DecodeParityRef(
                                 uint8_t bOption,
                                 uint8_t * pInBuffer,
                                 uint16_t wInBufferLength,
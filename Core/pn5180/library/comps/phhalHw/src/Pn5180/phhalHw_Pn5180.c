@@ -39,6 +39,13 @@
 #include "BoardSelection.h"
 #include <stdio.h>
 
+/* Boards with several front-ends resolve the control pins through the BAL of each HAL instance. */
+#ifndef PHDRIVER_PIN_BUSY_BAL
+#define PHDRIVER_PIN_RESET_BAL(pBal)         PHDRIVER_PIN_RESET
+#define PHDRIVER_PIN_BUSY_BAL(pBal)          PHDRIVER_PIN_BUSY
+#define PHDRIVER_PIN_SSEL_BAL(pBal)          PHDRIVER_PIN_SSEL
+#endif /* PHDRIVER_PIN_BUSY_BAL */
+
 #define PHHAL_HW_15693_TX26_SYMBOL23         0x04U     /**< Value of SYMBOL Register for TX26 Baud Rate */
 #define PHHAL_HW_15693_TX53_SYMBOL23         0x05U     /**< Value of SYMBOL Register for TX53 Baud Rate */
 #define PHHAL_HW_15693_TX106_SYMBOL23        0x06U     /**< Value of SYMBOL Register for TX106 Baud Rate */
@@ -52,8 +59,12 @@
 #define PHHAL_HW_15693_RX106_BAUDRATE_VALUE  0x0004U   /**< Value for BAUD RATE field for RX106 Baud Rate */
 
 static void phhalHw_Pn5180_EventCallback(void * pDataParams);
-static void phhalHw_Pn5180_Reset(void);
+static void phhalHw_Pn5180_Reset(void * pBalDataParams);
 static void phhalHw_Pn5180_GuardTimeCallBck(void);
+static phStatus_t phhalHw_Pn5180_ExchangeStart(phhalHw_Pn5180_DataParams_t * pDataParams, uint16_t wOption, uint8_t * pTxBuffer,
+    uint16_t wTxLength, uint8_t ** ppRxBuffer, uint16_t * pRxLength, uint32_t * pIrqWaitFor);
+static phStatus_t phhalHw_Pn5180_ExchangeComplete(phhalHw_Pn5180_DataParams_t * pDataParams, uint32_t dwIrqWaitFor,
+    uint8_t ** ppRxBuffer, uint16_t * pRxLength);
 #ifndef _WIN32
 static void phhalHw_Pn5180_WriteSSEL(phbalReg_Type_t *pBalDataParams, uint8_t bValue);
 #endif
@@ -261,6 +272,7 @@ phStatus_t phhalHw_Pn5180_Init(
 //    uint8_t    PH_MEMLOC_REM bPowerStatus[16];
     uint8_t PH_MEMLOC_BUF bDigitalDelayCfg;
     uint8_t    InitGearSize = 0x01;  // 1
+    uint8_t    bEarlyReset = PH_OFF;
 #ifndef _WIN32
     phDriver_Pin_Config_t pinCfg;
 #endif
@@ -313,6 +325,8 @@ phStatus_t phhalHw_Pn5180_Init(
     pDataParams->bOpeMode               = RD_LIB_MODE_NFC;
     pDataParams->dwFelicaEmdReg         = 0U;
     pDataParams->bRxMultiple            = PH_OFF;
+    pDataParams->bAsyncExchange         = PH_OFF;
+    pDataParams->dwAsyncIrqWaitFor      = 0U;
     pDataParams->bNfcipMode             = PH_OFF;
     pDataParams->bJewelActivated        = PH_OFF;
     pDataParams->bLpcdMode              = PHHAL_HW_PN5180_LPCD_MODE_DEFAULT;
@@ -358,8 +372,15 @@ phStatus_t phhalHw_Pn5180_Init(
         PH_CHECK_SUCCESS_FCT(statusTmp, phDriver_PinConfig(PHDRIVER_PIN_BUSY, PH_DRIVER_PINFUNC_INPUT, &pinCfg));
     }
 #endif
-    /* Reset Pn5180 Front-end. */
-    phhalHw_Pn5180_Reset();
+#ifdef PHDRIVER_EARLY_RESET_READY
+    /* Reset pulse already sent by the platform during MCU start-up, only wait for the front-end. */
+    bEarlyReset = PHDRIVER_EARLY_RESET_READY();
+#endif /* PHDRIVER_EARLY_RESET_READY */
+    if (bEarlyReset == PH_OFF)
+    {
+        /* Reset Pn5180 Front-end. */
+        phhalHw_Pn5180_Reset(pBalDataParams);
+    }
 
     if(((phbalReg_Type_t *)pBalDataParams)->bBalType == PHBAL_REG_TYPE_SPI)
     {
@@ -371,7 +392,7 @@ phStatus_t phhalHw_Pn5180_Init(
         /* delay of ~2 ms */
         phDriver_TimerStart(PH_DRIVER_TIMER_MILLI_SECS, PHHAL_HW_PN5180_DELAY_TO_CHECK_TESTBUS, NULL);
 
-        if (phDriver_PinRead(PHDRIVER_PIN_BUSY, PH_DRIVER_PINFUNC_INPUT) == PH_ON)
+        if (phDriver_PinRead(PHDRIVER_PIN_BUSY_BAL(pBalDataParams), PH_DRIVER_PINFUNC_INPUT) == PH_ON)
         {
 
             pDataParams->bIsTestBusEnabled = PH_ON;
@@ -382,10 +403,16 @@ phStatus_t phhalHw_Pn5180_Init(
     }
 
 #endif
-    HAL_Delay(1000);
+    if (bEarlyReset == PH_OFF)
+    {
+        HAL_Delay(1000);
+    }
     PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_Pn5180_Instr_ReadE2Prom(pDataParams, PHHAL_HW_PN5180_FIRMWARE_VERSION_ADDR, bFirmwareVer, 2U));
     printf("PN-Firmware = %02X %02X\n", bFirmwareVer[1], bFirmwareVer[0]);	// PN-Firmware = 04 00
-    HAL_Delay(1000);
+    if (bEarlyReset == PH_OFF)
+    {
+        HAL_Delay(1000);
+    }
     if ( (0xFFU == bFirmwareVer[0]) && (0xFFU == bFirmwareVer[1]) )
     {
         /* SPI Read problem... it is returing all FFFFs..
@@ -665,6 +692,124 @@ phStatus_t phhalHw_Pn5180_Exchange(
     uint8_t ** ppRxBuffer,
     uint16_t * pRxLength
     )
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+    uint32_t    PH_MEMLOC_REM dwIrqWaitFor = 0U;
+
+    if (pDataParams->bAsyncExchange != PH_OFF)
+    {
+        /* Response of a submitted exchange has not been collected yet */
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_HAL);
+    }
+
+    PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_Pn5180_ExchangeStart(pDataParams, wOption, pTxBuffer, wTxLength,
+        ppRxBuffer, pRxLength, &dwIrqWaitFor));
+
+    /* Data has only been buffered */
+    if (dwIrqWaitFor == 0U)
+    {
+        return PH_ERR_SUCCESS;
+    }
+
+    return phhalHw_Pn5180_ExchangeComplete(pDataParams, dwIrqWaitFor, ppRxBuffer, pRxLength);
+}
+
+phStatus_t phhalHw_Pn5180_ExchangeSubmit(
+    phhalHw_Pn5180_DataParams_t * pDataParams,
+    uint16_t wOption,
+    uint8_t * pTxBuffer,
+    uint16_t wTxLength
+    )
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+    uint32_t    PH_MEMLOC_REM dwIrqWaitFor = 0U;
+    uint8_t *   PH_MEMLOC_REM pRxBuffer = NULL;
+    uint16_t    PH_MEMLOC_REM wRxLength = 0U;
+
+    if (pDataParams->bAsyncExchange != PH_OFF)
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_HAL);
+    }
+
+    /* Only complete frames can be submitted, buffering is done with phhalHw_Pn5180_Exchange */
+    if (0U != (wOption & PH_EXCHANGE_BUFFERED_BIT))
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_HAL);
+    }
+
+    PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_Pn5180_ExchangeStart(pDataParams, wOption, pTxBuffer, wTxLength,
+        &pRxBuffer, &wRxLength, &dwIrqWaitFor));
+
+    pDataParams->dwAsyncIrqWaitFor = dwIrqWaitFor;
+    pDataParams->bAsyncExchange = PH_ON;
+
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phhalHw_Pn5180_ExchangePoll(
+    phhalHw_Pn5180_DataParams_t * pDataParams,
+    uint8_t ** ppRxBuffer,
+    uint16_t * pRxLength
+    )
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+    uint32_t    PH_MEMLOC_REM dwRegister = 0U;
+    phOsal_EventBits_t PH_MEMLOC_REM dwEventFlags = 0U;
+
+    if (pDataParams->bAsyncExchange == PH_OFF)
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_HAL);
+    }
+
+    if ((ppRxBuffer == NULL) || (pRxLength == NULL))
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_HAL);
+    }
+
+    /* Abort requested through phhalHw_Pn5180_AsyncAbort */
+    (void)phOsal_EventGet(&pDataParams->HwEventObj.EventHandle, &dwEventFlags);
+    if (0U != (dwEventFlags & E_PH_OSAL_EVT_ABORT))
+    {
+        pDataParams->bAsyncExchange = PH_OFF;
+
+        PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_Pn5180_Int_IdleCommand(pDataParams));
+
+        /* Disable IRQ sources */
+        PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_Pn5180_Instr_WriteRegisterAndMask(pDataParams, IRQ_ENABLE,
+            (uint32_t)~pDataParams->dwAsyncIrqWaitFor));
+
+        (void)phOsal_EventClear(&pDataParams->HwEventObj.EventHandle, E_OS_EVENT_OPT_NONE, E_PH_OSAL_EVT_ABORT, NULL);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_ABORTED, PH_COMP_HAL);
+    }
+
+    /* Single IRQ_STATUS read, the same condition phhalHw_Pn5180_WaitIrq loops on */
+    statusTmp = phhalHw_Pn5180_Instr_ReadRegister(pDataParams, IRQ_STATUS, &dwRegister);
+    if (statusTmp != PH_ERR_SUCCESS)
+    {
+        pDataParams->bAsyncExchange = PH_OFF;
+        (void)phhalHw_Pn5180_Int_IdleCommand(pDataParams);
+        return statusTmp;
+    }
+
+    if (0U == (dwRegister & pDataParams->dwAsyncIrqWaitFor))
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_SUCCESS_PENDING, PH_COMP_HAL);
+    }
+
+    pDataParams->bAsyncExchange = PH_OFF;
+
+    return phhalHw_Pn5180_ExchangeComplete(pDataParams, pDataParams->dwAsyncIrqWaitFor, ppRxBuffer, pRxLength);
+}
+
+static phStatus_t phhalHw_Pn5180_ExchangeStart(
+    phhalHw_Pn5180_DataParams_t * pDataParams,
+    uint16_t wOption,
+    uint8_t * pTxBuffer,
+    uint16_t wTxLength,
+    uint8_t ** ppRxBuffer,
+    uint16_t * pRxLength,
+    uint32_t * pIrqWaitFor
+    )
 {
     phStatus_t  PH_MEMLOC_REM statusTmp;
     phStatus_t  PH_MEMLOC_REM status = PH_ERR_SUCCESS;
@@ -798,6 +943,7 @@ phStatus_t phhalHw_Pn5180_Exchange(
 
         if (0U != (wOption & PH_EXCHANGE_BUFFERED_BIT ))
         {
+            *pIrqWaitFor = 0U;
             return PH_ERR_SUCCESS;
         }
 
@@ -919,17 +1065,30 @@ phStatus_t phhalHw_Pn5180_Exchange(
         PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_Pn5180_SetConfig(pDataParams, PHHAL_HW_CONFIG_TXLASTBITS, 0x00U));
     }
 
+    *pIrqWaitFor = dwIrqWaitFor;
+    return PH_ERR_SUCCESS;
+}
+
+static phStatus_t phhalHw_Pn5180_ExchangeComplete(
+    phhalHw_Pn5180_DataParams_t * pDataParams,
+    uint32_t dwIrqWaitFor,
+    uint8_t ** ppRxBuffer,
+    uint16_t * pRxLength
+    )
+{
+    phStatus_t  PH_MEMLOC_REM status;
+
     status  = phhalHw_Pn5180_Receive_Int(pDataParams,dwIrqWaitFor,ppRxBuffer,pRxLength,PH_ON);
 
     if( (status & PH_ERR_MASK) != PH_ERR_SUCCESS)
     {
         /*load idle command*/
-        statusTmp = phhalHw_Pn5180_Int_IdleCommand(pDataParams);
+        (void)phhalHw_Pn5180_Int_IdleCommand(pDataParams);
     }
 
     if (pDataParams->bOpeMode != RD_LIB_MODE_EMVCO)
     {
-        statusTmp = phhalHw_Pn5180_Instr_WriteRegisterAndMask(pDataParams, TIMER1_CONFIG, (uint32_t)(~TIMER1_CONFIG_T1_ENABLE_MASK));
+        (void)phhalHw_Pn5180_Instr_WriteRegisterAndMask(pDataParams, TIMER1_CONFIG, (uint32_t)(~TIMER1_CONFIG_T1_ENABLE_MASK));
     }
 
     return status;
@@ -2966,7 +3125,7 @@ phStatus_t phhalHw_Pn5180_BalExchange(
 
 #ifndef _WIN32
         /* Wait for the Busy to be low */
-        while(phDriver_PinRead(PHDRIVER_PIN_BUSY, PH_DRIVER_PINFUNC_INPUT));
+        while(phDriver_PinRead(PHDRIVER_PIN_BUSY_BAL(pDataParams->pBalDataParams), PH_DRIVER_PINFUNC_INPUT));
 #endif
 
 #ifdef _WIN32
@@ -2994,7 +3153,7 @@ phStatus_t phhalHw_Pn5180_BalExchange(
         if (pDataParams->bIsTestBusEnabled == PH_ON)
         {
             /* Wait for the Busy Pin to go high when TestBus is enabled. */
-            while(!phDriver_PinRead(PHDRIVER_PIN_BUSY, PH_DRIVER_PINFUNC_INPUT));
+            while(!phDriver_PinRead(PHDRIVER_PIN_BUSY_BAL(pDataParams->pBalDataParams), PH_DRIVER_PINFUNC_INPUT));
         }
 
         /* Disable chip select connected to reader IC by pulling NSS high. */
@@ -3004,7 +3163,7 @@ phStatus_t phhalHw_Pn5180_BalExchange(
         if (0U != wRxBufSize)
         {
 #ifndef _WIN32
-            while(phDriver_PinRead(PHDRIVER_PIN_BUSY, PH_DRIVER_PINFUNC_INPUT));
+            while(phDriver_PinRead(PHDRIVER_PIN_BUSY_BAL(pDataParams->pBalDataParams), PH_DRIVER_PINFUNC_INPUT));
 #endif
 
             /* Send it to the chip */
@@ -3033,7 +3192,7 @@ phStatus_t phhalHw_Pn5180_BalExchange(
             if (pDataParams->bIsTestBusEnabled == PH_ON)
             {
                 /* Wait for the Busy Pin to go high when TestBus is enabled. */
-                while(!phDriver_PinRead(PHDRIVER_PIN_BUSY, PH_DRIVER_PINFUNC_INPUT));
+                while(!phDriver_PinRead(PHDRIVER_PIN_BUSY_BAL(pDataParams->pBalDataParams), PH_DRIVER_PINFUNC_INPUT));
             }
 
             /* Disable chip select connected to reader IC by pulling NSS high. */
@@ -3753,6 +3912,8 @@ phStatus_t phhalHw_Pn5180_DeInit(
     pDataParams->wAdditionalInfo        = 0U;
     pDataParams->bRfResetAfterTo        = PH_OFF;
     pDataParams->bRxMultiple            = PH_OFF;
+    pDataParams->bAsyncExchange         = PH_OFF;
+    pDataParams->dwAsyncIrqWaitFor      = 0U;
     pDataParams->bActiveMode            = PH_OFF;
     pDataParams->bRfca                  = PH_ON;
     pDataParams->wTargetMode            = PH_OFF;
@@ -3776,20 +3937,20 @@ phStatus_t phhalHw_Pn5180_DeInit(
     return phOsal_EventDelete(&pDataParams->HwEventObj.EventHandle);
 }
 
-static void phhalHw_Pn5180_Reset(void)
+static void phhalHw_Pn5180_Reset(void * pBalDataParams)
 {
     /* As per current design, phDriver will not be implemented on PC Host side */
 #ifndef _WIN32
     /* Send the reset pulse to FE to reset. */
-    phDriver_PinWrite(PHDRIVER_PIN_RESET, RESET_POWERUP_LEVEL);
+    phDriver_PinWrite(PHDRIVER_PIN_RESET_BAL(pBalDataParams), RESET_POWERUP_LEVEL);
     /* delay of ~2 ms */
     phDriver_TimerStart(PH_DRIVER_TIMER_MILLI_SECS, PHHAL_HW_PN5180_RESET_DELAY_MILLI_SECS, NULL);
 
-    phDriver_PinWrite(PHDRIVER_PIN_RESET, RESET_POWERDOWN_LEVEL);
+    phDriver_PinWrite(PHDRIVER_PIN_RESET_BAL(pBalDataParams), RESET_POWERDOWN_LEVEL);
     /* delay of ~2 ms */
     phDriver_TimerStart(PH_DRIVER_TIMER_MILLI_SECS, PHHAL_HW_PN5180_RESET_DELAY_MILLI_SECS, NULL);
 
-    phDriver_PinWrite(PHDRIVER_PIN_RESET, RESET_POWERUP_LEVEL);
+    phDriver_PinWrite(PHDRIVER_PIN_RESET_BAL(pBalDataParams), RESET_POWERUP_LEVEL);
     /* delay of ~2 ms */
     phDriver_TimerStart(PH_DRIVER_TIMER_MILLI_SECS, PHHAL_HW_PN5180_RESET_DELAY_MILLI_SECS, NULL);
 #endif /*_WIN32*/
@@ -3800,7 +3961,7 @@ static void phhalHw_Pn5180_WriteSSEL(phbalReg_Type_t *pBalDataParams, uint8_t bV
 {
     if (pBalDataParams->bBalType == PHBAL_REG_TYPE_SPI)
     {
-        phDriver_PinWrite(PHDRIVER_PIN_SSEL, bValue);
+        phDriver_PinWrite(PHDRIVER_PIN_SSEL_BAL(pBalDataParams), bValue);
     }
 }
 #endif /* _WIN32 */
@@ -260,6 +260,29 @@ phStatus_t phhalHw_Pn5180_Exchange(
     uint16_t * pRxLength    /**< [Out] Number of received data bytes. */
     );
 
+/**
+* \brief PN5180 implementation of phhalHw_ExchangeSubmit
+*
+* \sa phhalHw_ExchangeSubmit
+*/
+phStatus_t phhalHw_Pn5180_ExchangeSubmit(
+    phhalHw_Pn5180_DataParams_t * pDataParams,       /**<[In] DataParams representing this layer. */
+    uint16_t wOption,       /**< [In] Option parameter. */
+    uint8_t * pTxBuffer,    /**< [In] Data to transmit. */
+    uint16_t wTxLength      /**< [In] Number of bytes to transmit. */
+    );
+
+/**
+* \brief PN5180 implementation of phhalHw_ExchangePoll
+*
+* \sa phhalHw_ExchangePoll
+*/
+phStatus_t phhalHw_Pn5180_ExchangePoll(
+    phhalHw_Pn5180_DataParams_t * pDataParams,       /**<[In] DataParams representing this layer. */
+    uint8_t ** ppRxBuffer,  /**< [Out] Pointer to received data. */
+    uint16_t * pRxLength    /**< [Out] Number of received data bytes. */
+    );
+
 /**
 * \brief PN5180 implementation of phhalHw_SetConfig
 *
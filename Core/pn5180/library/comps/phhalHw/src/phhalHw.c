@@ -330,6 +330,115 @@ phStatus_t phhalHw_Exchange(
     return status;
 }
 
+phStatus_t phhalHw_ExchangeSubmit(
+                                  void * pDataParams,
+                                  uint16_t wOption,
+                                  uint8_t * pTxBuffer,
+                                  uint16_t wTxLength
+                                  )
+{
+    phStatus_t PH_MEMLOC_REM status;
+
+    PH_LOG_HELPER_ALLOCATE_TEXT(bFunctionName, "phhalHw_ExchangeSubmit");
+    /*PH_LOG_HELPER_ALLOCATE_PARAMNAME(pDataParams);*/
+    PH_LOG_HELPER_ALLOCATE_PARAMNAME(wOption);
+    PH_LOG_HELPER_ALLOCATE_PARAMNAME(pTxBuffer);
+    PH_LOG_HELPER_ALLOCATE_PARAMNAME(status);
+    PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+    PH_LOG_HELPER_ADDPARAM_UINT16(PH_LOG_LOGTYPE_DEBUG, wOption_log, &wOption);
+    PH_LOG_HELPER_ADDPARAM_BUFFER(PH_LOG_LOGTYPE_DEBUG, pTxBuffer_log, pTxBuffer, wTxLength);
+    PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_ENTER);
+    PH_ASSERT_NULL (pDataParams);
+    if (0U != (wTxLength)) PH_ASSERT_NULL (pTxBuffer);
+
+    /* Check data parameters */
+    if (PH_GET_COMPCODE(pDataParams) != PH_COMP_HAL)
+    {
+        status = PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_DATA_PARAMS, PH_COMP_HAL);
+
+        PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+        PH_LOG_HELPER_ADDPARAM_UINT16(PH_LOG_LOGTYPE_INFO, status_log, &status);
+        PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_LEAVE);
+        return status;
+    }
+
+    /* perform operation on active layer */
+    switch (PH_GET_COMPID(pDataParams))
+    {
+#ifdef NXPBUILD__PHHAL_HW_PN5180
+    case PHHAL_HW_PN5180_ID:
+        status = phhalHw_Pn5180_ExchangeSubmit((phhalHw_Pn5180_DataParams_t*)pDataParams, wOption, pTxBuffer, wTxLength);
+        break;
+#endif  /* NXPBUILD__PHHAL_HW_PN5180 */
+
+    default:
+        status = PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+        break;
+    }
+
+    PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+    PH_LOG_HELPER_ADDPARAM_UINT16(PH_LOG_LOGTYPE_INFO, status_log, &status);
+    PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_LEAVE);
+
+    return status;
+}
+
+phStatus_t phhalHw_ExchangePoll(
+                                void * pDataParams,
+                                uint8_t ** ppRxBuffer,
+                                uint16_t * pRxLength
+                                )
+{
+    phStatus_t PH_MEMLOC_REM status;
+
+    PH_LOG_HELPER_ALLOCATE_TEXT(bFunctionName, "phhalHw_ExchangePoll");
+    /*PH_LOG_HELPER_ALLOCATE_PARAMNAME(pDataParams);*/
+    PH_LOG_HELPER_ALLOCATE_PARAMNAME(ppRxBuffer);
+    PH_LOG_HELPER_ALLOCATE_PARAMNAME(status);
+    PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+    PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_ENTER);
+    PH_ASSERT_NULL (pDataParams);
+
+    /* Check data parameters */
+    if (PH_GET_COMPCODE(pDataParams) != PH_COMP_HAL)
+    {
+        status = PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_DATA_PARAMS, PH_COMP_HAL);
+
+        PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+        PH_LOG_HELPER_ADDPARAM_UINT16(PH_LOG_LOGTYPE_INFO, status_log, &status);
+        PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_LEAVE);
+        return status;
+    }
+
+    /* perform operation on active layer */
+    switch (PH_GET_COMPID(pDataParams))
+    {
+#ifdef NXPBUILD__PHHAL_HW_PN5180
+    case PHHAL_HW_PN5180_ID:
+        status = phhalHw_Pn5180_ExchangePoll((phhalHw_Pn5180_DataParams_t*)pDataParams, ppRxBuffer, pRxLength);
+        break;
+#endif  /* NXPBUILD__PHHAL_HW_PN5180 */
+
+    default:
+        status = PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_COMMAND, PH_COMP_HAL);
+        break;
+    }
+
+    PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+#ifdef NXPBUILD__PH_LOG
+    if ((((status & PH_ERR_MASK) == PH_ERR_SUCCESS) ||
+        ((status & PH_ERR_MASK) == PH_ERR_SUCCESS_INCOMPLETE_BYTE)) &&
+        (ppRxBuffer != NULL))
+    {
+        PH_LOG_HELPER_ADDPARAM_BUFFER(PH_LOG_LOGTYPE_DEBUG, ppRxBuffer_log, *ppRxBuffer, *pRxLength);
+    }
+#endif
+    PH_LOG_HELPER_ADDPARAM_UINT16(PH_LOG_LOGTYPE_INFO, status_log, &status);
+    PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_LEAVE);
+
+    return status;
+}
+
 phStatus_t phhalHw_ApplyProtocolSettings(
     void * pDataParams,
     uint8_t bMode
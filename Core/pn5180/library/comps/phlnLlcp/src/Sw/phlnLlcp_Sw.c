@@ -414,6 +414,29 @@ phStatus_t phlnLlcp_Sw_Transport_Socket_Init(
     psSocket->eSocketType = eSocketType;
     psSocket->dwBufLen = dwSocketRxBufferSize;
     psSocket->pbRxBuffer = pSocketRxBuffer;
+    psSocket->pbRxRing = pSocketRxBuffer;
+
+    /* Split the Rx buffer of Connection-oriented sockets into one receive slot per MIU, the number of slots is the
+    * local receive window. Connection-less sockets receive into the whole buffer. */
+    if (eSocketType == PHLN_LLCP_TRANSPORT_CONNECTIONLESS)
+    {
+        psSocket->bRxSlots = 0;
+        psSocket->wRxSlotLen = 0;
+    }
+    else
+    {
+        psSocket->bRxSlots = (uint8_t)((dwSocketRxBufferSize / PHLN_LLCP_MIU) < PHLN_LLCP_TLV_RW_VALUE ?
+            (dwSocketRxBufferSize / PHLN_LLCP_MIU) : PHLN_LLCP_TLV_RW_VALUE);
+        if (psSocket->bRxSlots == 0U)
+        {
+            psSocket->bRxSlots = 1;
+        }
+        psSocket->wRxSlotLen = (uint16_t)(dwSocketRxBufferSize / psSocket->bRxSlots);
+    }
+    psSocket->bRxIn = 0;
+    psSocket->bRxOut = 0;
+    psSocket->bRxWait = PH_OFF;
+    psSocket->bRxAckReq = 0;
 
     psSocket->fReady = (uint8_t) 1U;
 
@@ -489,11 +512,38 @@ phStatus_t phlnLlcp_Sw_Transport_Socket_Receive(
 
     timePeriodToWait.unitPeriod = OS_TIMER_UNIT_MSEC;
     timePeriodToWait.period = PHOSAL_MAX_DELAY;
-
-    /* Block on receive semaphore */
-    PH_CHECK_SUCCESS_FCT(bRetstatus, phOsal_SemPend(&psSocket->xRxSema.SemHandle, timePeriodToWait));
     PH_UNUSED_VARIABLE(pDataParams);
-    return PH_ADD_COMPCODE(psSocket->wStatus, PH_COMP_LN_LLCP);
+
+    if (psSocket->bRxSlots == 0U)
+    {
+        /* Block on receive semaphore */
+        PH_CHECK_SUCCESS_FCT(bRetstatus, phOsal_SemPend(&psSocket->xRxSema.SemHandle, timePeriodToWait));
+        return PH_ADD_COMPCODE(psSocket->wStatus, PH_COMP_LN_LLCP);
+    }
+
+    /* Acknowledge the slots released by the application since the last call. */
+    PH_CHECK_SUCCESS_FCT(bRetstatus, phlnLlcp_Sw_Int_RxAck(psSocket));
+
+    /* Block on receive semaphore until an I PDU is buffered or the data link connection is closed. */
+    while (psSocket->bRxIn == psSocket->bRxOut)
+    {
+        if (psSocket->bState == PHLN_LLCP_SOCKET_DISC)
+        {
+            return PH_ADD_COMPCODE(psSocket->wStatus, PH_COMP_LN_LLCP);
+        }
+
+        psSocket->bRxWait = PH_ON;
+        if (psSocket->bRxIn != psSocket->bRxOut)
+        {
+            psSocket->bRxWait = PH_OFF;
+            break;
+        }
+        PH_CHECK_SUCCESS_FCT(bRetstatus, phOsal_SemPend(&psSocket->xRxSema.SemHandle, timePeriodToWait));
+        psSocket->bRxWait = PH_OFF;
+    }
+
+    phlnLlcp_Sw_Int_RxDeliver(psSocket);
+    return PH_ERR_SUCCESS;
 }
 
 phStatus_t phlnLlcp_Sw_Transport_Socket_Unregister(
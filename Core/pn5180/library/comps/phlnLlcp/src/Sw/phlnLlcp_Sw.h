@@ -44,6 +44,7 @@
 #define PHLN_LLCP_VERSION_MINOR_MASK          0x0FU            /**< Mask to apply to get minor version number. */
 
 #define PHLN_LLCP_DEFAULT_SPEC_MIU            128U             /**< Default or minimum LLCP MIU value as per LLCP specification v1.1. */
+#define PHLN_LLCP_SW_MIUX_MASK                0x07FFU          /**< MIUX is an 11 bit value, upper bits of the TLV value are reserved. */
 
 #define PHLN_LLCP_PDU_MERGE_DSAP(dsap, ptype)           \
   ( (((ptype) & /* */ 0x0CU) >> 2U) | ((dsap) << 2U) )
@@ -80,6 +80,18 @@ phStatus_t phlnLlcp_Sw_Int_Transport_Socket_Register(
     pSocket->sSeq.bSendAck_Vsa = 0;
     pSocket->sSeq.bRxState_Vr = 0;
     pSocket->sSeq.bRxAck_Vra = 0;
+    pSocket->bRRw = PHLN_LLCP_RW_DEFAULT;
+    pSocket->bTxPending = PH_OFF;
+    pSocket->bRrCredit = PH_OFF;
+    pSocket->bRxIn = 0;
+    pSocket->bRxOut = 0;
+    pSocket->bRxWait = PH_OFF;
+    pSocket->bRxAckReq = 0;
+    pSocket->fReady = (uint8_t)1U;
+    if (pSocket->pbRxRing != NULL)
+    {
+        pSocket->pbRxBuffer = pSocket->pbRxRing;
+    }
     pSocket->pNext = NULL;
 
     if ((eType != PHLN_LLCP_DEFAULTLINK_SOCKET) && (gpphlnLlcp_Socket_RegSockets == NULL))
@@ -308,8 +320,9 @@ phStatus_t phlnLlcp_Sw_Int_ParseGenBytes(uint8_t *pGenBytes, uint16_t wLength, p
             wIndex += 3U;
             break;
 
-            /* discard RW as we are fixed to 1 */
         case PHLN_LLCP_TLV_TYPE_RW:
+            /* RW is a 4 bit value, upper bits are reserved. */
+            pLMBytes->bRw = pGenBytes[wIndex + 2U] & PHLN_LLCP_RW_MAX;
             wIndex += 3U;
             break;
 
@@ -604,12 +617,26 @@ phStatus_t phlnLlcp_Sw_Int_Send(phTools_Q_t *psMsgQueue, uint8_t *pbPerformRx)
     phlnLlcp_Transport_Socket_t * PH_MEMLOC_REM psSocket = psMsgQueue->pSender;
   //  phlnLlcp_PType_t              PH_MEMLOC_REM epType;
     uint8_t                          PH_MEMLOC_REM epType;
+    phlnLlcp_Transport_Socket_t * PH_MEMLOC_REM psRrSocket;
+    uint8_t                       PH_MEMLOC_REM bRrSent;
     phStatus_t bRetstatus;
     *pbPerformRx = (uint8_t) 1U;
 
     if (psMsgQueue->bLlcpData == PH_ON)
     {
         psMsgQueue->bLlcpData = PH_OFF;
+        epType = (PHLN_LLCP_PDU_GET_PTYPE(psMsgQueue->bLlcpBuf[0], psMsgQueue->bLlcpBuf[1]));
+        if ((epType == PHLN_LLCP_PTYPE_RR) || (epType == PHLN_LLCP_PTYPE_RNR))
+        {
+            /* Acknowledge all I PDUs released until now, an I PDU sent meanwhile may already carry a newer N(R). */
+            psRrSocket = phlnLlcp_Transport_Socket_Search((uint8_t)PHLN_LLCP_PDU_GET_SSAP(psMsgQueue->bLlcpBuf[1]),
+                (uint8_t)PHLN_LLCP_PDU_GET_DSAP(psMsgQueue->bLlcpBuf[0]), 0);
+            if (psRrSocket != NULL)
+            {
+                psMsgQueue->bLlcpBuf[2] = PHLN_LLCP_SW_RX_ACK(psRrSocket);
+                psRrSocket->sSeq.bRxAck_Vra = psMsgQueue->bLlcpBuf[2];
+            }
+        }
         return phlnLlcp_MacTransmit(PH_TRANSMIT_DEFAULT, psMsgQueue->bLlcpBuf, (uint16_t)psMsgQueue->dwLength);
     }
     else
@@ -623,6 +650,20 @@ phStatus_t phlnLlcp_Sw_Int_Send(phTools_Q_t *psMsgQueue, uint8_t *pbPerformRx)
             {
                 psSocket->bState = PHLN_LLCP_SOCKET_DISC;
             }
+            else if (epType == PHLN_LLCP_PTYPE_SYMM)
+            {
+                /* Use the turn to acknowledge I PDUs the application has released meanwhile. */
+                bRrSent = PH_OFF;
+                PH_CHECK_SUCCESS_FCT(wStatus, phlnLlcp_Sw_Int_Pdu_RrPending(&bRrSent));
+                if (bRrSent == PH_ON)
+                {
+                    return PH_ERR_SUCCESS;
+                }
+            }
+            else
+            {
+                ;/* Do nothing */
+            }
             /* Forward the buffer as it is. */
             return phlnLlcp_MacTransmit(PH_TRANSMIT_DEFAULT, psMsgQueue->pbData, (uint16_t)psMsgQueue->dwLength);
         }
@@ -691,6 +732,7 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_Process(phlnLlcp_Sw_DataParams_t * pDataParams,
     uint8_t    PH_MEMLOC_REM bRsap;
     uint8_t    PH_MEMLOC_REM bUriLen;
     uint8_t    PH_MEMLOC_REM bSDREQPresent;
+    uint8_t    PH_MEMLOC_REM bSlot;
     uint8_t *  PH_MEMLOC_REM pUri = NULL;
     phlnLlcp_Transport_Socket_t * PH_MEMLOC_REM psSocket = NULL;
     phlnLlcp_LMDataParams_t PH_MEMLOC_REM sLMBytes = {0};
@@ -746,14 +788,16 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_Process(phlnLlcp_Sw_DataParams_t * pDataParams,
         (*ppsSocket)->bState = PHLN_LLCP_SOCKET_INFO_EX;
         (*ppsSocket)->bRsap = bRsap;
         (void)phlnLlcp_Sw_Int_ParseGenBytes(&pRxBuffer[2], (uint16_t)(dwLength - 2u), &sLMBytes);
-        (*ppsSocket)->wRMiu = sLMBytes.wMiu + 128U;
+        (*ppsSocket)->wRMiu = (sLMBytes.wMiu & PHLN_LLCP_SW_MIUX_MASK) + 128U;
+        (*ppsSocket)->bRRw = (0U != (sLMBytes.bAvailableTlv & PHLN_LLCP_TLV_RW_MASK)) ? sLMBytes.bRw : PHLN_LLCP_RW_DEFAULT;
         break;
 
     case PHLN_LLCP_PTYPE_CC:
         (*ppsSocket)->bState = PHLN_LLCP_SOCKET_INFO_EX;
         (void)phlnLlcp_Sw_Int_ParseGenBytes(&pRxBuffer[2], (uint16_t)(dwLength - 2u), &sLMBytes);
         (*ppsSocket)->bRsap = bRsap; /* Helps while connected through Uri */
-        (*ppsSocket)->wRMiu = sLMBytes.wMiu + 128U;
+        (*ppsSocket)->wRMiu = (sLMBytes.wMiu & PHLN_LLCP_SW_MIUX_MASK) + 128U;
+        (*ppsSocket)->bRRw = (0U != (sLMBytes.bAvailableTlv & PHLN_LLCP_TLV_RW_MASK)) ? sLMBytes.bRw : PHLN_LLCP_RW_DEFAULT;
         break;
 
     case PHLN_LLCP_PTYPE_DISC:
@@ -777,13 +821,36 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_Process(phlnLlcp_Sw_DataParams_t * pDataParams,
         }
         else
         {
-            if((*ppsSocket)->sSeq.bSendState_Vs == bNr)
+            /* Piggybacked N(R) may acknowledge any number of outstanding I PDUs within the remote receive window. */
+            if(PHLN_LLCP_SW_NR_VALID(*ppsSocket, bNr))
             {
                 /* Update the Vsa */
                 (*ppsSocket)->sSeq.bSendAck_Vsa = bNr;
 
+                if ((*ppsSocket)->bRxSlots != 0U)
+                {
+                    /* Buffer the I PDU in the next free receive slot. The remote LLC only sends within the window
+                    * acknowledged by N(R), so a slot is free unless the remote violates the receive window. */
+                    if ((dwLength - PHLN_LLCP_HEADER_SIZE) > (*ppsSocket)->wRxSlotLen)
+                    {
+                        wStatus = PH_ERR_LLCP_PDU_INFO_ERR;
+                    }
+                    else if (PHLN_LLCP_SW_RX_OCCUPIED(*ppsSocket) >= (*ppsSocket)->bRxSlots)
+                    {
+                        wStatus = PH_ERR_LLCP_BUSY;
+                    }
+                    else
+                    {
+                        bSlot = (uint8_t)((*ppsSocket)->bRxIn % (*ppsSocket)->bRxSlots);
+                        (*ppsSocket)->awRxLen[bSlot] = (uint16_t)(dwLength - PHLN_LLCP_HEADER_SIZE);
+                        (void)memcpy(&(*ppsSocket)->pbRxRing[(uint32_t)bSlot * (*ppsSocket)->wRxSlotLen],
+                            (uint8_t *)(pRxBuffer + PHLN_LLCP_HEADER_SIZE), (*ppsSocket)->awRxLen[bSlot]);
+                        (*ppsSocket)->bRxIn = (uint8_t)(((*ppsSocket)->bRxIn + 1U) % (2U * (*ppsSocket)->bRxSlots));
+                        PHLN_LLCP_SW_MOD16_INC((*ppsSocket)->sSeq.bRxState_Vr);
+                    }
+                }
                 /* CHeck for the ready flag to copy the received data to the sockets Rx buffer */
-                if((*ppsSocket)->fReady == (uint8_t)1U)
+                else if((*ppsSocket)->fReady == (uint8_t)1U)
                 {
                     (*ppsSocket)->fReady = (uint8_t)0U;
                     /* If Received Data length is more than the Socket Buffer Size then throw
@@ -816,6 +883,10 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_Process(phlnLlcp_Sw_DataParams_t * pDataParams,
         {
             if ((dwLength - PHLN_LLCP_SNL_HEADER_SIZE) <= (*ppsSocket)->dwBufLen)
             {
+                if ((*ppsSocket)->pbRxRing != NULL)
+                {
+                    (*ppsSocket)->pbRxBuffer = (*ppsSocket)->pbRxRing;
+                }
                 (*ppsSocket)->dwLength = dwLength - PHLN_LLCP_SNL_HEADER_SIZE;
                 (void)memcpy((*ppsSocket)->pbRxBuffer, (uint8_t *)(pRxBuffer + PHLN_LLCP_SNL_HEADER_SIZE), (*ppsSocket)->dwLength);
             }
@@ -866,10 +937,13 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_Process(phlnLlcp_Sw_DataParams_t * pDataParams,
 
     case PHLN_LLCP_PTYPE_RR:
         bNr = pRxBuffer[2] & 0x0FU;
-        if((*ppsSocket)->sSeq.bSendState_Vs == bNr)
+        /* RR may acknowledge a part of the I PDUs sent within the remote receive window. */
+        if(PHLN_LLCP_SW_NR_VALID(*ppsSocket, bNr))
         {
             /* Update the Vsa */
             (*ppsSocket)->sSeq.bSendAck_Vsa = bNr;
+            /* With a remote receive window of zero, RR is the only indication that one I PDU is accepted. */
+            (*ppsSocket)->bRrCredit = PH_ON;
         }
         else
         {
@@ -879,6 +953,7 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_Process(phlnLlcp_Sw_DataParams_t * pDataParams,
 
     case PHLN_LLCP_PTYPE_RNR:
         bNr = pRxBuffer[2] & 0x0FU;
+        (*ppsSocket)->bRrCredit = PH_OFF;
 
         if(((*ppsSocket)->sSeq.bSendState_Vs - (uint8_t)1U) == bNr)
         {
@@ -981,8 +1056,12 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_Handle(phStatus_t wProcessStatus,
         switch(wProcessStatus)
         {
         case PH_ERR_SUCCESS:
-            /* Send RR PDU. */
-            wStatus = phlnLlcp_Sw_Int_Pdu_RrOrRnr(psSocket, PHLN_LLCP_PTYPE_RR);
+            /* Send RR PDU if released receive slots are not acknowledged yet. Otherwise the I PDU is acknowledged
+            * once the application releases its slot, by RR or by N(R) of the next I PDU sent. */
+            if (PHLN_LLCP_SW_RX_ACK(psSocket) != psSocket->sSeq.bRxAck_Vra)
+            {
+                wStatus = phlnLlcp_Sw_Int_Pdu_RrOrRnr(psSocket, PHLN_LLCP_PTYPE_RR);
+            }
             break;
 
         case PH_ERR_LLCP_BUSY:
@@ -1064,6 +1143,44 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_Handle(phStatus_t wProcessStatus,
     return wStatus;
 }
 
+void phlnLlcp_Sw_Int_RxDeliver(phlnLlcp_Transport_Socket_t *psSocket)
+{
+    uint8_t PH_MEMLOC_REM bSlot;
+
+    /* Point the socket to the oldest buffered I PDU, its slot stays in use until the application sets 'fReady'. */
+    bSlot = (uint8_t)(psSocket->bRxOut % psSocket->bRxSlots);
+    psSocket->pbRxBuffer = &psSocket->pbRxRing[(uint32_t)bSlot * psSocket->wRxSlotLen];
+    psSocket->dwLength = psSocket->awRxLen[bSlot];
+    psSocket->fReady = (uint8_t)0U;
+    psSocket->bRxOut = (uint8_t)((psSocket->bRxOut + 1U) % (2U * psSocket->bRxSlots));
+}
+
+phStatus_t phlnLlcp_Sw_Int_RxAck(phlnLlcp_Transport_Socket_t *psSocket)
+{
+    uint8_t PH_MEMLOC_REM bAck;
+    uint8_t PH_MEMLOC_REM bUnacked;
+    uint8_t PH_MEMLOC_REM bPending;
+
+    /* Count released slots neither acknowledged to the remote LLC nor requested by an RR still queued. */
+    bAck = PHLN_LLCP_SW_RX_ACK(psSocket);
+    bUnacked = (uint8_t)PHLN_LLCP_SW_MOD16_DIFF(bAck, psSocket->sSeq.bRxAck_Vra);
+    bPending = (uint8_t)PHLN_LLCP_SW_MOD16_DIFF(bAck, psSocket->bRxAckReq);
+    if (bPending < bUnacked)
+    {
+        bUnacked = bPending;
+    }
+
+    /* Request RR once half of the window is released or nothing is left to receive, otherwise the
+    * acknowledgement goes with the next I PDU or replaces the next SYMM PDU. */
+    if ((bUnacked != 0U) &&
+        ((bUnacked >= ((psSocket->bRxSlots + 1U) / 2U)) || (psSocket->bRxIn == psSocket->bRxOut)))
+    {
+        psSocket->bRxAckReq = bAck;
+        return phlnLlcp_Sw_Int_Pdu_RrOrRnr(psSocket, PHLN_LLCP_PTYPE_RR);
+    }
+    return PH_ERR_SUCCESS;
+}
+
 uint16_t phlnLlcp_Sw_Int_PostEvents(phStatus_t wProcessStatus,
                                     uint8_t epType,
                                     phlnLlcp_Transport_Socket_t *psSocket,
@@ -1105,17 +1222,54 @@ uint16_t phlnLlcp_Sw_Int_PostEvents(phStatus_t wProcessStatus,
             break;
 
         case PHLN_LLCP_PTYPE_INFO:
-            if (psSocket->bState == PHLN_LLCP_SOCKET_INFO_SEND_EX)
+            if ((psSocket->bState == PHLN_LLCP_SOCKET_INFO_SEND_EX) &&
+                ((psSocket->bRxSlots == 0U) || (psSocket->fReady == (uint8_t)1U)))
             {
+                /* Hand the oldest buffered I PDU to the application blocked in Socket Send. */
+                if (psSocket->bRxSlots != 0U)
+                {
+                    phlnLlcp_Sw_Int_RxDeliver(psSocket);
+                }
+                psSocket->bTxPending = PH_OFF;
                 psSocket->wStatus = PH_ERR_SUCCESS_INFO_RECEIVED;
                 psSocket->bState = PHLN_LLCP_SOCKET_INFO_EX;
                 PH_CHECK_SUCCESS_FCT(bRetstatus, phOsal_SemPost(&psSocket->xSema.SemHandle, E_OS_SEM_OPT_NONE));
             }
-            else
+            else if (psSocket->bState == PHLN_LLCP_SOCKET_INFO_SEND_EX)
+            {
+                /* The application still holds a receive slot, keep the I PDU buffered and only release the sender
+                * if the piggybacked N(R) opened the remote receive window. */
+                if ((psSocket->bTxPending == PH_ON) && (PHLN_LLCP_SW_TX_WINDOW_OPEN(psSocket)))
+                {
+                    psSocket->bTxPending = PH_OFF;
+                    psSocket->bState = PHLN_LLCP_SOCKET_INFO_EX;
+                    psSocket->wStatus = PH_ERR_SUCCESS;
+                    PH_CHECK_SUCCESS_FCT(bRetstatus, phOsal_SemPost(&psSocket->xSema.SemHandle, E_OS_SEM_OPT_NONE));
+                }
+            }
+            else if (psSocket->bRxSlots == 0U)
             {
                 psSocket->wStatus = PH_ERR_SUCCESS;
                 PH_CHECK_SUCCESS_FCT(bRetstatus, phOsal_SemPost(&psSocket->xRxSema.SemHandle, E_OS_SEM_OPT_NONE));
             }
+            else
+            {
+                /* Only wake up Socket Receive if it waits, buffered I PDUs are picked up by the next call. */
+                psSocket->wStatus = PH_ERR_SUCCESS;
+                if (psSocket->bRxWait == PH_ON)
+                {
+                    psSocket->bRxWait = PH_OFF;
+                    PH_CHECK_SUCCESS_FCT(bRetstatus, phOsal_SemPost(&psSocket->xRxSema.SemHandle, E_OS_SEM_OPT_NONE));
+                }
+            }
+
+            /* The piggybacked N(R) may open the remote receive window for a sender waiting in Socket Send. */
+            if ((psSocket->bState == PHLN_LLCP_SOCKET_INFO_EX) && (psSocket->bTxPending == PH_ON) &&
+                (PHLN_LLCP_SW_TX_WINDOW_OPEN(psSocket)))
+            {
+                psSocket->bTxPending = PH_OFF;
+                PH_CHECK_SUCCESS_FCT(bRetstatus, phOsal_SemPost(&psSocket->xSema.SemHandle, E_OS_SEM_OPT_NONE));
+            }
             break;
 
         case PHLN_LLCP_PTYPE_SNL:
@@ -1152,9 +1306,15 @@ uint16_t phlnLlcp_Sw_Int_PostEvents(phStatus_t wProcessStatus,
 
         case PHLN_LLCP_PTYPE_RR:
             wTxFlag = PH_OFF;
-            psSocket->bState = PHLN_LLCP_SOCKET_INFO_EX;
-            psSocket->wStatus = PH_ERR_SUCCESS;
-            PH_CHECK_SUCCESS_FCT(bRetstatus, phOsal_SemPost(&psSocket->xSema.SemHandle, E_OS_SEM_OPT_NONE));
+            /* Only unblock the sender if it waits for the remote receive window to open. Sends that fitted into
+            * the window have already been released after transmission. */
+            if ((psSocket->bTxPending == PH_ON) && (PHLN_LLCP_SW_TX_WINDOW_OPEN(psSocket)))
+            {
+                psSocket->bTxPending = PH_OFF;
+                psSocket->bState = PHLN_LLCP_SOCKET_INFO_EX;
+                psSocket->wStatus = PH_ERR_SUCCESS;
+                PH_CHECK_SUCCESS_FCT(bRetstatus, phOsal_SemPost(&psSocket->xSema.SemHandle, E_OS_SEM_OPT_NONE));
+            }
             break;
 
         case PHLN_LLCP_PTYPE_RNR:
@@ -58,6 +58,44 @@ typedef enum /*phlnLlcp_SocketType*/{
 #define PHLN_LLCP_SW_MOD16_DEC(x) if ((x) == 0U) { (x) = 14; }                      \
                                      else { (x)--; }
 
+/**
+* Number of steps from y to x in modulo 16 sequence space.
+*/
+#define PHLN_LLCP_SW_MOD16_DIFF(x, y)  ((uint8_t)(((uint8_t)(x) - (uint8_t)(y)) & 0x0FU))
+
+/**
+* N(R) is acceptable if it lies between V(SA) and V(S), both inclusive, in modulo 16 sequence space.
+*/
+#define PHLN_LLCP_SW_NR_VALID(psSocket, bNr)                                         \
+    (PHLN_LLCP_SW_MOD16_DIFF((bNr), (psSocket)->sSeq.bSendAck_Vsa) <=                \
+     PHLN_LLCP_SW_MOD16_DIFF((psSocket)->sSeq.bSendState_Vs, (psSocket)->sSeq.bSendAck_Vsa))
+
+/**
+* True if one more I PDU can be sent without exceeding the remote receive window.
+* With a remote RW of zero, only after an RR has been received and all I PDUs sent are acknowledged.
+*/
+#define PHLN_LLCP_SW_TX_WINDOW_OPEN(psSocket)                                        \
+    (((psSocket)->bRRw == 0U) ?                                                       \
+     (((psSocket)->bRrCredit == PH_ON) &&                                             \
+      ((psSocket)->sSeq.bSendState_Vs == (psSocket)->sSeq.bSendAck_Vsa)) :            \
+     (PHLN_LLCP_SW_MOD16_DIFF((psSocket)->sSeq.bSendState_Vs, (psSocket)->sSeq.bSendAck_Vsa) < (psSocket)->bRRw))
+
+/**
+* Receive slots in use: I PDUs buffered for the application plus the slot it holds until 'fReady' is set again.
+* Only valid for sockets with receive slots.
+*/
+#define PHLN_LLCP_SW_RX_OCCUPIED(psSocket)                                          \
+    ((uint8_t)((((psSocket)->bRxIn + (2U * (psSocket)->bRxSlots) - (psSocket)->bRxOut) %             \
+                (2U * (psSocket)->bRxSlots)) + (((psSocket)->fReady == 0U) ? 1U : 0U)))
+
+/**
+* N(R) that may be sent. An I PDU is acknowledged once its receive slot is free again, so the remote LLC can never
+* have more I PDUs outstanding than there are free slots. Sockets without receive slots acknowledge on reception.
+*/
+#define PHLN_LLCP_SW_RX_ACK(psSocket)                                               \
+    (((psSocket)->bRxSlots == 0U) ? (psSocket)->sSeq.bRxState_Vr :                   \
+     (uint8_t)(((psSocket)->sSeq.bRxState_Vr + 16U - PHLN_LLCP_SW_RX_OCCUPIED(psSocket)) & 0x0FU))
+
 #define PHLN_LLCP_SW_FIRST_TID    0x80U
 /**
 * As per mod16 if x > y then true
@@ -146,6 +184,10 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_ConnectionLess_InfoEx(phlnLlcp_Transport_Socket_t
                                                      uint16_t wFrameOpt,
                                                      uint8_t *pbPerformRx);
 
+phStatus_t phlnLlcp_Sw_Int_ReleaseTxWindow(phlnLlcp_Transport_Socket_t *psSocket);
+
+phStatus_t phlnLlcp_Sw_Int_WaitTxWindow(phlnLlcp_Transport_Socket_t *psSocket);
+
 phStatus_t phlnLlcp_Sw_Int_Pdu_InfoEx(phlnLlcp_Transport_Socket_t *psSocket,
                                       uint8_t *pbTxData,
                                       uint16_t wLength,
@@ -171,6 +213,12 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_DiscOrDm(phlnLlcp_Transport_Socket_t *psSocket,
 
 phStatus_t phlnLlcp_Sw_Int_Pdu_Snl(uint8_t bTid, uint8_t bSap);
 
+phStatus_t phlnLlcp_Sw_Int_Pdu_RrPending(uint8_t *pbSent);
+
+phStatus_t phlnLlcp_Sw_Int_RxAck(phlnLlcp_Transport_Socket_t *psSocket);
+
+void phlnLlcp_Sw_Int_RxDeliver(phlnLlcp_Transport_Socket_t *psSocket);
+
 phStatus_t phlnLlcp_Sw_Int_Pdu_RrOrRnr(phlnLlcp_Transport_Socket_t *psSocket,
                                        uint8_t bPtype
                                        );
@@ -48,6 +48,31 @@
 * ***************************************************************************************************************** */
 static void *gphlnLlcp_MacDataParams;
 static uint32_t gphlnLlcp_MacType;
+static uint16_t gwphlnLlcp_MacMaxMiu = PHLN_LLCP_MIU;
+
+/* *****************************************************************************************************************
+* Static Functions
+* ***************************************************************************************************************** */
+static phStatus_t phlnLlcp_Sw_MacGetHalRxBufSize(uint16_t *pwBufSize)
+{
+    phStatus_t PH_MEMLOC_REM wStatus = PH_ERR_USE_CONDITION;
+
+    if (gphlnLlcp_MacType == PHLN_LLCP_INITIATOR)
+    {
+#ifdef NXPBUILD__PHPAL_I18092MPI
+        wStatus = phhalHw_GetConfig(((phpalI18092mPI_Sw_DataParams_t *)gphlnLlcp_MacDataParams)->pHalDataParams,
+            PHHAL_HW_CONFIG_RXBUFFER_BUFSIZE, pwBufSize);
+#endif /* NXPBUILD__PHPAL_I18092MPI */
+    }
+    else
+    {
+#ifdef NXPBUILD__PHPAL_I18092MT
+        wStatus = phhalHw_GetConfig(((phpalI18092mT_Sw_DataParams_t *)gphlnLlcp_MacDataParams)->pHalDataParams,
+            PHHAL_HW_CONFIG_RXBUFFER_BUFSIZE, pwBufSize);
+#endif /* NXPBUILD__PHPAL_I18092MT */
+    }
+    return wStatus;
+}
 
 /* *****************************************************************************************************************
 * Private Functions
@@ -136,6 +161,25 @@ phStatus_t phlnLlcp_Sw_MacInit(phlnLlcp_Sw_DataParams_t * pDataParams, uint8_t b
 #endif /* NXPBUILD__PHPAL_I18092MT */
     }
 
+    /* Limit the MIU advertised on data link connections to what fits into the HAL Rx buffer,
+     * I PDUs larger than one MAC frame are received through MAC chaining into that buffer. */
+    gwphlnLlcp_MacMaxMiu = PHLN_LLCP_MIU;
+    if (phlnLlcp_Sw_MacGetHalRxBufSize(&wValue) == PH_ERR_SUCCESS)
+    {
+        if (wValue > (PHLN_LLCP_MAC_HEADER_SIZE + PHLN_LLCP_HEADER_SIZE + PHLN_LLCP_DEFAULT_SPEC_MIU))
+        {
+            wValue -= (PHLN_LLCP_MAC_HEADER_SIZE + PHLN_LLCP_HEADER_SIZE);
+            if (wValue < gwphlnLlcp_MacMaxMiu)
+            {
+                gwphlnLlcp_MacMaxMiu = wValue;
+            }
+        }
+        else
+        {
+            gwphlnLlcp_MacMaxMiu = PHLN_LLCP_DEFAULT_SPEC_MIU;
+        }
+    }
+
     /* Create LLC SYMM and LTO Timer during Init and never delete these timers. */
     PH_CHECK_SUCCESS_FCT(wStatus, phlnLlcp_Timers_InitSym(pDataParams, &phlnLlcp_SymTimerCallback));
     PH_CHECK_SUCCESS_FCT(wStatus, phlnLlcp_Timers_InitLto(pDataParams, &phlnLlcp_LtoTimerCallback));
@@ -176,6 +220,11 @@ phStatus_t phlnLlcp_Sw_MacInit(phlnLlcp_Sw_DataParams_t * pDataParams, uint8_t b
     return wStatus;
 }
 
+uint16_t phlnLlcp_Sw_MacGetMaxMiu(void)
+{
+    return gwphlnLlcp_MacMaxMiu;
+}
+
 phStatus_t phlnLlcp_MacTransmit(uint16_t wFrameOpt, uint8_t* pTxBuffer, uint16_t wTxLength)
 {
     phStatus_t PH_MEMLOC_REM wStatus = PH_ERR_USE_CONDITION;
@@ -36,6 +36,7 @@
 * ***************************************************************************************************************** */
 #define PHLN_LLCP_ALLOWED_FRAMESIZE              0x03U   /**< FSL value for max. framesize of 254 Bytes. */
 #define PHLN_LLCP_RWT_MIN_US                     302U    /**< Minimum response waiting time as per ISO/IEC 18092:2004(E) section 12.5.1.2.1. */
+#define PHLN_LLCP_MAC_HEADER_SIZE                0x04U   /**< DEP_REQ/DEP_RES overhead (LEN, CMD0, CMD1, PFB) reserved in the HAL Rx buffer. */
 
 /* *****************************************************************************************************************
 *   Function Prototypes
@@ -49,6 +50,12 @@ phStatus_t phlnLlcp_Sw_MacInit(phlnLlcp_Sw_DataParams_t * pDataParams, uint8_t b
 
 void phlnLlcp_Sw_MacHAL_ShutDown(void);
 
+/**
+* Returns the largest MIU that can be received into the HAL Rx buffer, limited to #PHLN_LLCP_MIU.
+* Valid after \ref phlnLlcp_Sw_MacInit.
+*/
+uint16_t phlnLlcp_Sw_MacGetMaxMiu(void);
+
 phStatus_t phlnLlcp_MacTransmit(uint16_t wFrameOpt, uint8_t* pTxBuffer, uint16_t wTxLength);
 
 phStatus_t phlnLlcp_MacReceive(uint16_t wFrameOpt, uint8_t **ppRxBuffer, uint16_t *pRxLength);
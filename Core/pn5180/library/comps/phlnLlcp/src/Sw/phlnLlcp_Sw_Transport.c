@@ -32,6 +32,11 @@
 #include "phlnLlcp_Sw_Int.h"
 #include "phlnLlcp_Sw_Mac.h"
 
+/* *****************************************************************************************************************
+* Extern Variables
+* ***************************************************************************************************************** */
+extern phlnLlcp_Transport_Socket_t *gpphlnLlcp_Socket_RegSockets;
+
 phStatus_t phlnLlcp_Sw_Int_Socket_SendInt(phlnLlcp_Transport_Socket_t* psSocket,
                                           uint8_t* pTxBuffer,
                                           uint32_t dwLength,
@@ -93,8 +98,22 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_CcOrC(phlnLlcp_Transport_Socket_t *psSocket,
     baPdu[wLength++] = PHLN_LLCP_TLV_TYPE_MIUX;
     baPdu[wLength++] = PHLN_LLCP_TLV_LENGTH_MIUX;
 
-    wLMiu = (uint16_t)((psSocket->dwBufLen > PHLN_LLCP_MIU) ? PHLN_LLCP_MIU: psSocket->dwBufLen);
-    wLMiu -= 128u;
+    /* Advertise the largest MIU that fits into both a receive slot of the socket and the HAL Rx buffer. */
+    wLMiu = phlnLlcp_Sw_MacGetMaxMiu();
+    if ((psSocket->bRxSlots != 0U) && (psSocket->wRxSlotLen < wLMiu))
+    {
+        wLMiu = psSocket->wRxSlotLen;
+    }
+    else if (psSocket->dwBufLen < wLMiu)
+    {
+        wLMiu = (uint16_t)psSocket->dwBufLen;
+    }
+    else
+    {
+        ;/* Do nothing */
+    }
+    wLMiu = (wLMiu > PHLN_LLCP_DEFAULT_SPEC_MIU) ? (uint16_t)(wLMiu - PHLN_LLCP_DEFAULT_SPEC_MIU) : 0U;
+    wLMiu &= PHLN_LLCP_SW_MIUX_MASK;
 
     baPdu[wLength++] = (uint8_t)((wLMiu & 0xFF00U) >> 8U);
     baPdu[wLength++] = (uint8_t)(wLMiu & 0xFFU);
@@ -103,7 +122,7 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_CcOrC(phlnLlcp_Transport_Socket_t *psSocket,
     {
         baPdu[wLength++] = PHLN_LLCP_TLV_TYPE_RW;
         baPdu[wLength++] = PHLN_LLCP_TLV_LENGTH_RW;
-        baPdu[wLength++] = PHLN_LLCP_TLV_RW_VALUE;
+        baPdu[wLength++] = (psSocket->bRxSlots != 0U) ? psSocket->bRxSlots : PHLN_LLCP_RW_DEFAULT;
 
         /* Add SN to TLV bytes sent during Connect PDU. */
         baPdu[wLength++] = PHLN_LLCP_TLV_TYPE_SN;
@@ -121,12 +140,20 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_CcOrC(phlnLlcp_Transport_Socket_t *psSocket,
     {
         baPdu[wLength++] = PHLN_LLCP_TLV_TYPE_RW;
         baPdu[wLength++] = PHLN_LLCP_TLV_LENGTH_RW;
-        baPdu[wLength++] = PHLN_LLCP_TLV_RW_VALUE;
+        baPdu[wLength++] = (psSocket->bRxSlots != 0U) ? psSocket->bRxSlots : PHLN_LLCP_RW_DEFAULT;
 
         wStatus = phlnLlcp_MacTransmit(PH_TRANSMIT_DEFAULT, baPdu, wLength);
     }
     else
     {
+        /* Without RW TLV the remote LLC assumes the default receive window. */
+        if ((psSocket->bRxSlots != 0U) && (psSocket->bRxSlots != PHLN_LLCP_RW_DEFAULT))
+        {
+            baPdu[wLength++] = PHLN_LLCP_TLV_TYPE_RW;
+            baPdu[wLength++] = PHLN_LLCP_TLV_LENGTH_RW;
+            baPdu[wLength++] = psSocket->bRxSlots;
+        }
+
         wStatus = phlnLlcp_Sw_Int_HandleMsgQueue(baPdu, wLength, (uint8_t)PH_TOOLS_Q_DATA_TO_BE_SENT);
 
         /* Change the socket state from Connect pending to Info Exchange */
@@ -206,12 +233,38 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_RrOrRnr(phlnLlcp_Transport_Socket_t *psSocket,
     uint16_t PH_MEMLOC_REM wLength;
     uint8_t  PH_MEMLOC_REM pResPdu[3];
 
-    wLength = phlnLlcp_Sw_Int_Pdu_FrameHeader(bPtype, psSocket->bRsap, psSocket->bLsap, psSocket->sSeq.bRxState_Vr,
+    /* N(R) and V(RA) are updated again when the PDU is transmitted. */
+    wLength = phlnLlcp_Sw_Int_Pdu_FrameHeader(bPtype, psSocket->bRsap, psSocket->bLsap, PHLN_LLCP_SW_RX_ACK(psSocket),
         0, pResPdu);
 
-    psSocket->sSeq.bRxAck_Vra = psSocket->sSeq.bRxState_Vr;
-
     return phlnLlcp_Sw_Int_HandleMsgQueue(pResPdu, wLength, (uint8_t)PH_TOOLS_Q_DATA_TO_BE_SENT);
 }
 
+phStatus_t phlnLlcp_Sw_Int_Pdu_RrPending(uint8_t *pbSent)
+{
+    phlnLlcp_Transport_Socket_t * PH_MEMLOC_REM psSocket = gpphlnLlcp_Socket_RegSockets;
+    uint16_t                      PH_MEMLOC_REM wLength;
+    uint8_t                       PH_MEMLOC_REM baRrPdu[3];
+
+    *pbSent = PH_OFF;
+
+    /* Send RR instead of SYMM for the first data link connection with released but unacknowledged receive slots. */
+    while (psSocket != NULL)
+    {
+        if ((psSocket->bRxSlots != 0U) &&
+            ((psSocket->bState == PHLN_LLCP_SOCKET_INFO_EX) || (psSocket->bState == PHLN_LLCP_SOCKET_INFO_SEND_EX)) &&
+            (PHLN_LLCP_SW_RX_ACK(psSocket) != psSocket->sSeq.bRxAck_Vra))
+        {
+            psSocket->sSeq.bRxAck_Vra = PHLN_LLCP_SW_RX_ACK(psSocket);
+            wLength = phlnLlcp_Sw_Int_Pdu_FrameHeader(PHLN_LLCP_PTYPE_RR, psSocket->bRsap, psSocket->bLsap,
+                psSocket->sSeq.bRxAck_Vra, 0, baRrPdu);
+
+            *pbSent = PH_ON;
+            return phlnLlcp_MacTransmit(PH_TRANSMIT_DEFAULT, baRrPdu, wLength);
+        }
+        psSocket = psSocket->pNext;
+    }
+    return PH_ERR_SUCCESS;
+}
+
 #endif /* NXPBUILD__PHLN_LLCP_SW */
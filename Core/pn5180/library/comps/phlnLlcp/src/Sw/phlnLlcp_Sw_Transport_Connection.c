@@ -120,12 +120,21 @@ phStatus_t phlnLlcp_Sw_Transport_Socket_Send(
                                              uint16_t wFrameOpt
                                              )
 {
+    phStatus_t PH_MEMLOC_REM wStatus;
+
     /* Check for Valid input parameters. */
     if ((pClientSocket == NULL) || (pTxBuffer == NULL))
     {
         return (PH_ERR_INVALID_PARAMETER | PH_COMP_LN_LLCP);
     }
     PH_UNUSED_VARIABLE(pDataParams);
+
+    /* The first fragment of an I PDU waits until the remote LLC accepts it. A sender released by a received I PDU
+    * may still find the remote receive window closed. */
+    if ((wFrameOpt == PH_TRANSMIT_DEFAULT) || (wFrameOpt == PH_TRANSMIT_BUFFER_FIRST))
+    {
+        PH_CHECK_SUCCESS_FCT(wStatus, phlnLlcp_Sw_Int_WaitTxWindow(pClientSocket));
+    }
     return phlnLlcp_Sw_Int_Socket_SendInt(pClientSocket, pTxBuffer, dwTxBufferSize, wFrameOpt, PHLN_LLCP_SOCKET_INFO_SEND_EX);
 }
 
@@ -276,6 +285,44 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_SnlEx(phlnLlcp_Transport_Socket_t *psSocket,
     return PH_ADD_COMPCODE(wStatus, PH_COMP_LN_LLCP);
 }
 
+phStatus_t phlnLlcp_Sw_Int_ReleaseTxWindow(phlnLlcp_Transport_Socket_t *psSocket)
+{
+    /* If the remote receive window still has room, release the application blocked in Socket Send right away
+     * so that the next I PDU is queued while this one is outstanding. Otherwise the application stays blocked
+     * until RR or an I PDU acknowledges enough I PDUs (RW = 1 behaves as stop-and-wait). */
+    if (PHLN_LLCP_SW_TX_WINDOW_OPEN(psSocket))
+    {
+        psSocket->bTxPending = PH_OFF;
+        psSocket->bState = PHLN_LLCP_SOCKET_INFO_EX;
+        psSocket->wStatus = PH_ERR_SUCCESS;
+        return phOsal_SemPost(&psSocket->xSema.SemHandle, E_OS_SEM_OPT_NONE);
+    }
+
+    psSocket->bTxPending = PH_ON;
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phlnLlcp_Sw_Int_WaitTxWindow(phlnLlcp_Transport_Socket_t *psSocket)
+{
+    phStatus_t PH_MEMLOC_REM wStatus;
+    phOsal_TimerPeriodObj_t timePeriodToWait;
+
+    timePeriodToWait.unitPeriod = OS_TIMER_UNIT_MSEC;
+    timePeriodToWait.period = PHOSAL_MAX_DELAY;
+
+    /* Block the application until RR or the N(R) of an I PDU opens the remote receive window. A remote receive
+     * window of zero accepts no I PDU until the remote sends RR. The LLCP task keeps the link alive with SYMM PDUs
+     * meanwhile. */
+    if (PHLN_LLCP_SW_TX_WINDOW_OPEN(psSocket))
+    {
+        return PH_ERR_SUCCESS;
+    }
+
+    psSocket->bTxPending = PH_ON;
+    PH_CHECK_SUCCESS_FCT(wStatus, phOsal_SemPend(&psSocket->xSema.SemHandle, timePeriodToWait));
+    return PH_ADD_COMPCODE(psSocket->wStatus, PH_COMP_LN_LLCP);
+}
+
 phStatus_t phlnLlcp_Sw_Int_Pdu_InfoEx(phlnLlcp_Transport_Socket_t *psSocket,
                                       uint8_t *pbTxData,
                                       uint16_t wLength,
@@ -288,9 +335,10 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_InfoEx(phlnLlcp_Transport_Socket_t *psSocket,
     switch(wFrameOpt)
     {
     case PH_TRANSMIT_BUFFER_FIRST:
-        /* frame I PDU */
+        /* frame I PDU, V(RA) is the N(R) carried in the header */
+        psSocket->sSeq.bRxAck_Vra = PHLN_LLCP_SW_RX_ACK(psSocket);
         PHLN_LLCP_PDU_FRAME_HEADER(psSocket->bRsap, PHLN_LLCP_PTYPE_INFO, psSocket->bLsap, psSocket->sSeq.bSendState_Vs,
-            psSocket->sSeq.bRxState_Vr, baLlcpHeader);
+            psSocket->sSeq.bRxAck_Vra, baLlcpHeader);
         /* Send I PDU frame Header */
         PH_CHECK_SUCCESS_FCT(wStatus, phlnLlcp_MacTransmit(PH_TRANSMIT_BUFFER_FIRST, baLlcpHeader, 3));
         /* Append above layers header, inform above layers header is NOT the last fragment */
@@ -302,19 +350,28 @@ phStatus_t phlnLlcp_Sw_Int_Pdu_InfoEx(phlnLlcp_Transport_Socket_t *psSocket,
         /* Just pass the buffer to the lower layer */
         wStatus = phlnLlcp_MacTransmit(PH_TRANSMIT_BUFFER_LAST, pbTxData, wLength);
         PHLN_LLCP_SW_MOD16_INC(psSocket->sSeq.bSendState_Vs);
-        psSocket->sSeq.bRxAck_Vra = psSocket->sSeq.bRxState_Vr;
+        psSocket->bRrCredit = PH_OFF;
+        if (wStatus == PH_ERR_SUCCESS)
+        {
+            wStatus = phlnLlcp_Sw_Int_ReleaseTxWindow(psSocket);
+        }
         break;
 
     case PH_TRANSMIT_DEFAULT:
         /* frame I PDU */
+        psSocket->sSeq.bRxAck_Vra = PHLN_LLCP_SW_RX_ACK(psSocket);
         PHLN_LLCP_PDU_FRAME_HEADER(psSocket->bRsap, PHLN_LLCP_PTYPE_INFO, psSocket->bLsap, psSocket->sSeq.bSendState_Vs,
-            psSocket->sSeq.bRxState_Vr, baLlcpHeader);
+            psSocket->sSeq.bRxAck_Vra, baLlcpHeader);
         PHLN_LLCP_SW_MOD16_INC(psSocket->sSeq.bSendState_Vs);
-        psSocket->sSeq.bRxAck_Vra = psSocket->sSeq.bRxState_Vr;
+        psSocket->bRrCredit = PH_OFF;
         /* Send I PDU frame Header */
         PH_CHECK_SUCCESS_FCT(wStatus, phlnLlcp_MacTransmit(PH_TRANSMIT_BUFFER_FIRST, baLlcpHeader, 3));
         /* Append above layers data, inform above layers data is the last fragment */
         wStatus = phlnLlcp_MacTransmit(PH_TRANSMIT_BUFFER_LAST, pbTxData, wLength);
+        if (wStatus == PH_ERR_SUCCESS)
+        {
+            wStatus = phlnLlcp_Sw_Int_ReleaseTxWindow(psSocket);
+        }
         break;
 
     case PH_TRANSMIT_BUFFER_CONT :
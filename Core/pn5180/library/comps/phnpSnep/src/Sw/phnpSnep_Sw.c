@@ -421,6 +421,7 @@ phStatus_t phnpSnep_Sw_ServerSendResponse(
                         return (PH_ERR_PROTOCOL_ERROR | PH_COMP_NP_SNEP);
                     }
 
+                    /* GET fragments are pipelined within the remote receive window by the LLCP layer. */
                     do{
                         dwMsgLen = dwRespDataLen - dwLength;
                         dwMsgLen = (dwMsgLen > pLocSocket->wRMiu)? pLocSocket->wRMiu: dwMsgLen;
@@ -521,7 +522,9 @@ phStatus_t phnpSnep_Sw_Put(
             return (PH_ERR_PROTOCOL_ERROR | PH_COMP_NP_SNEP);
         }
 
-        /* Continue sending the remaining bytes to the SNEP server */
+        /* Continue sending the remaining bytes to the SNEP server.
+         * Socket Send returns as soon as the fragment is transmitted while the remote receive window has room,
+         * so up to RW fragments are in flight before the sender waits for an acknowledgement. */
         dwRemBytesToSend -= dwLength;
         while (0U != dwRemBytesToSend)
         {
@@ -35,6 +35,16 @@ static const uint16_t PH_MEMLOC_CONST_ROM bI14443p4_FsTable[13] = {16, 24, 32,
                                                                    512, 1024,
                                                                    2048, 4096};
 
+/* Exchange statistics saturate instead of wrapping */
+#define PHPAL_I14443P4_SW_STAT_INC(wStat)                               \
+    do                                                                  \
+    {                                                                   \
+        if ((wStat) < 0xFFFFU)                                          \
+        {                                                               \
+            ++(wStat);                                                  \
+        }                                                               \
+    } while (0)
+
 #define PHPAL_I14443P4_SW_IS_BLOCKNR_EQUAL(bPcb)                        \
     (                                                                   \
         ((((bPcb) & PHPAL_I14443P4_SW_PCB_BLOCKNR) ^ pDataParams->bPcbBlockNum) == 0U) \
@@ -115,6 +125,12 @@ static const uint16_t PH_MEMLOC_CONST_ROM bI14443p4_FsTable[13] = {16, 24, 32,
     ? 1u : 0u                                                                 \
     )
 
+static phStatus_t phpalI14443p4_Sw_SetWtxTimeout(phpalI14443p4_Sw_DataParams_t * pDataParams, uint8_t bWtxm,
+    uint16_t * pTimeoutPrev, uint8_t * pTimeoutInMs);
+static phStatus_t phpalI14443p4_Sw_AsyncSendIBlock(phpalI14443p4_Sw_DataParams_t * pDataParams);
+static phStatus_t phpalI14443p4_Sw_AsyncRestoreTimeout(phpalI14443p4_Sw_DataParams_t * pDataParams);
+static phStatus_t phpalI14443p4_Sw_AsyncRecoveryFailed(phpalI14443p4_Sw_DataParams_t * pDataParams, phStatus_t status);
+
 phStatus_t phpalI14443p4_Sw_Init(
                                  phpalI14443p4_Sw_DataParams_t * pDataParams,
                                  uint16_t wSizeOfDataParams,
@@ -133,6 +149,11 @@ phStatus_t phpalI14443p4_Sw_Init(
     pDataParams->pHalDataParams = pHalDataParams;
     pDataParams->bOpeMode       = RD_LIB_MODE_NFC;
 
+    /* Statistics survive ResetProtocol, only cleared here or via SetConfig */
+    pDataParams->wStatWtx        = 0;
+    pDataParams->wStatNak        = 0;
+    pDataParams->wStatRetransmit = 0;
+
     /* Reset protocol to defaults */
     return phpalI14443p4_Sw_ResetProtocol(pDataParams);
 }
@@ -192,6 +213,15 @@ phStatus_t phpalI14443p4_Sw_ResetProtocol(
     pDataParams->bFsci              = PHPAL_I14443P4_SW_FSCI_DEFAULT;
     pDataParams->bMaxRetryCount     = PHPAL_I14443P4_SW_MAX_RETRIES_DEFAULT;
 
+    /* No submitted exchange in flight */
+    pDataParams->pAsyncTxBuffer     = NULL;
+    pDataParams->wAsyncTxLength     = 0x00;
+    pDataParams->wAsyncTimeoutPrev  = 0x00;
+    pDataParams->bAsyncState        = PHPAL_I14443P4_SW_ASYNC_IDLE;
+    pDataParams->bAsyncRetryCount   = 0x00;
+    pDataParams->bAsyncNakCount     = 0x00;
+    pDataParams->bAsyncUseNad       = 0x00;
+
     return PH_ERR_SUCCESS;
 }
 
@@ -878,8 +908,6 @@ phStatus_t phpalI14443p4_Sw_IsoHandling(
     uint8_t     PH_MEMLOC_REM bResponseReceived;
     uint8_t     PH_MEMLOC_REM bWtxm = 0;
     uint8_t     PH_MEMLOC_REM bCheckNad;
-    uint32_t    PH_MEMLOC_REM dwTimeout;
-    uint32_t    PH_MEMLOC_REM dwTimeoutMax = PHPAL_I14443P4_SW_FWT_MAX_US;
     uint16_t    PH_MEMLOC_REM wTimeoutPrev = 0;
     uint8_t     PH_MEMLOC_REM bTimeoutInMs = 0;
     uint8_t     bNAKCount = 0;
@@ -903,58 +931,7 @@ phStatus_t phpalI14443p4_Sw_IsoHandling(
         /* WTX Timeout - set temporary FWT */
         if (bWtxm > 0U)
         {
-            /* Retrieve current timeout */
-            status = phhalHw_GetConfig(pDataParams->pHalDataParams, PHHAL_HW_CONFIG_TIMEOUT_VALUE_US, &wTimeoutPrev);
-
-            /* Timeout is out of range, retrieve it in milliseconds */
-            if ((status & PH_ERR_MASK) == PH_ERR_PARAMETER_OVERFLOW)
-            {
-                PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_GetConfig(pDataParams->pHalDataParams, PHHAL_HW_CONFIG_TIMEOUT_VALUE_MS, &wTimeoutPrev));
-                bTimeoutInMs = 1;
-            }
-            else
-            {
-                PH_CHECK_SUCCESS(status);
-                bTimeoutInMs = 0;
-            }
-
-            /* Calculate temporary WTX timeout */
-            if(pDataParams->bOpeMode == RD_LIB_MODE_ISO)
-            {
-                dwTimeout = (((uint32_t)PHPAL_I14443P4_SW_FWT_MIN_US * ((uint32_t)1U << pDataParams->bFwi)) * (uint32_t)bWtxm) +
-                            (uint32_t)PHPAL_I14443P4_EXT_TIME_US;
-            }
-            else
-            {
-                /* As per Digital Spec V1.1 req 15.3.2.1, NFC Forum Device SHALL wait at least FWTtemp + delta FWTT4AT for a Response */
-                dwTimeout = (((uint32_t)PHPAL_I14443P4_SW_FWT_MIN_US * ((uint32_t)1U << pDataParams->bFwi)) * (uint32_t)bWtxm) +
-                            (uint32_t)PHPAL_I14443P4_SW_DELTA_FWT_US;
-
-                dwTimeoutMax = PHPAL_I14443P4_SW_NFC_FWT_MAX_US;
-
-                if(pDataParams->bOpeMode == RD_LIB_MODE_EMVCO)
-                {
-                    dwTimeout += (uint32_t)PHPAL_I14443P4_SW_DELTA_TPCD_US;
-
-                    dwTimeoutMax = PHPAL_I14443P4_SW_EMVCO_FWT_MAX_US;
-                }
-            }
-
-            /* Limit timeout to FWT max */
-            if (dwTimeout > dwTimeoutMax)
-            {
-                dwTimeout = dwTimeoutMax;
-            }
-
-            /* Set temporary WTX timeout */
-            if (dwTimeout > 0xFFFFU)
-            {
-                PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_SetConfig(pDataParams->pHalDataParams, PHHAL_HW_CONFIG_TIMEOUT_VALUE_MS, (uint16_t)((dwTimeout / 1000U) + 1U)));
-            }
-            else
-            {
-                PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_SetConfig(pDataParams->pHalDataParams, PHHAL_HW_CONFIG_TIMEOUT_VALUE_US, (uint16_t)dwTimeout));
-            }
+            PH_CHECK_SUCCESS_FCT(statusTmp, phpalI14443p4_Sw_SetWtxTimeout(pDataParams, bWtxm, &wTimeoutPrev, &bTimeoutInMs));
         }
 
         /* Call HAL exchange function */
@@ -1143,6 +1120,7 @@ phStatus_t phpalI14443p4_Sw_IsoHandling(
                         else
                         {
                             pDataParams->bStateNow |= PHPAL_I14443P4_SW_STATE_RETRANSMIT_BIT;
+                            PHPAL_I14443P4_SW_STAT_INC(pDataParams->wStatRetransmit);
                         }
                     }
                 }
@@ -1188,6 +1166,7 @@ phStatus_t phpalI14443p4_Sw_IsoHandling(
                         bWtxm,
                         bIsoFrame,
                         &wTxLength));
+                    PHPAL_I14443P4_SW_STAT_INC(pDataParams->wStatWtx);
                 }
                 /* We received an invalid block */
                 else
@@ -1318,6 +1297,7 @@ phStatus_t phpalI14443p4_Sw_IsoHandling(
                     {
                         break;
                     }
+                    PHPAL_I14443P4_SW_STAT_INC(pDataParams->wStatNak);
                     /* Emvco: case_id: TA415_X */
                     if((statusBkUp & PH_ERR_MASK) != PH_ERR_SUCCESS )
                     {
@@ -1374,6 +1354,548 @@ phStatus_t phpalI14443p4_Sw_IsoHandling(
     return status;
 }
 
+phStatus_t phpalI14443p4_Sw_ExchangeSubmit(
+    phpalI14443p4_Sw_DataParams_t * pDataParams,
+    uint8_t * pTxBuffer,
+    uint16_t wTxLength
+    )
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+    uint16_t    PH_MEMLOC_REM wMaxCardFrameSize;
+    uint16_t    PH_MEMLOC_REM wIsoFrameLen;
+    uint16_t    PH_MEMLOC_REM wLastInfLength;
+    uint16_t    PH_MEMLOC_REM wChainLength;
+    uint8_t     PH_MEMLOC_REM bUseNad;
+
+    if (pDataParams->bAsyncState != PHPAL_I14443P4_SW_ASYNC_IDLE)
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_PAL_ISO14443P4);
+    }
+    if (0U != (wTxLength)) PH_ASSERT_NULL_PARAM(pTxBuffer, PH_COMP_PAL_ISO14443P4);
+
+    /* Retrieve maximum frame size of the card */
+    wMaxCardFrameSize = bI14443p4_FsTable[pDataParams->bFsci] - (uint16_t)2U;
+
+    /* Evaluate frame overhead of an unchained I-Block */
+    bUseNad = pDataParams->bNadEnabled;
+    wIsoFrameLen = 1;
+    if (0U != (bUseNad))
+    {
+        ++wIsoFrameLen;
+    }
+    if (0U != (pDataParams->bCidEnabled))
+    {
+        ++wIsoFrameLen;
+    }
+
+    /* Rule 2, ISO/IEC 14443-4:2008(E), PCD chaining.
+     * Only the response to the last block may take up to FWT, the leading blocks are
+     * acknowledged by the card right away and are therefore sent blocking. */
+    if ((wIsoFrameLen + wTxLength) > wMaxCardFrameSize)
+    {
+        /* 7.1.1.3 c), ISO/IEC 14443-4:2008(E), the last block of a chain carries no NAD */
+        wLastInfLength = wMaxCardFrameSize - 1U;
+        if (0U != (pDataParams->bCidEnabled))
+        {
+            --wLastInfLength;
+        }
+        wChainLength = (wTxLength > wLastInfLength) ? (uint16_t)(wTxLength - wLastInfLength) : (uint16_t)1U;
+
+        PH_CHECK_SUCCESS_FCT(statusTmp, phpalI14443p4_Sw_Exchange(
+            pDataParams,
+            PH_EXCHANGE_TXCHAINING,
+            pTxBuffer,
+            wChainLength,
+            NULL,
+            NULL));
+
+        pTxBuffer = &pTxBuffer[wChainLength];
+        wTxLength = wTxLength - wChainLength;
+        bUseNad = 0;
+    }
+
+    /* Last (or only) I-Block, no chaining */
+    pDataParams->bStateNow          = PHPAL_I14443P4_SW_STATE_I_BLOCK_TX;
+    pDataParams->pAsyncTxBuffer     = pTxBuffer;
+    pDataParams->wAsyncTxLength     = wTxLength;
+    pDataParams->bAsyncUseNad       = bUseNad;
+    pDataParams->bAsyncRetryCount   = 0;
+    pDataParams->bAsyncNakCount     = 0;
+
+    PH_CHECK_SUCCESS_FCT(statusTmp, phpalI14443p4_Sw_AsyncSendIBlock(pDataParams));
+
+    pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_I_BLOCK;
+
+    return PH_ERR_SUCCESS;
+}
+
+phStatus_t phpalI14443p4_Sw_ExchangePoll(
+    phpalI14443p4_Sw_DataParams_t * pDataParams,
+    uint8_t ** ppRxBuffer,
+    uint16_t * pRxLength
+    )
+{
+    phStatus_t  PH_MEMLOC_REM status;
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+    uint8_t     PH_MEMLOC_REM bIsoFrame[3];
+    uint16_t    PH_MEMLOC_REM wIsoFrameLen = 0;
+    uint8_t *   PH_MEMLOC_REM pResp = NULL;
+    uint16_t    PH_MEMLOC_REM wRespLen = 0;
+    uint16_t    PH_MEMLOC_REM wRxOverlappedLen;
+    uint8_t     PH_MEMLOC_REM bInvalidBlock;
+    uint8_t     PH_MEMLOC_REM bWtxm;
+    uint8_t     PH_MEMLOC_REM bTimeoutInMs = 0;
+
+    if (pDataParams->bAsyncState == PHPAL_I14443P4_SW_ASYNC_IDLE)
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_USE_CONDITION, PH_COMP_PAL_ISO14443P4);
+    }
+    if ((ppRxBuffer == NULL) || (pRxLength == NULL))
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_PAL_ISO14443P4);
+    }
+
+    status = phhalHw_ExchangePoll(pDataParams->pHalDataParams, &pResp, &wRespLen);
+    if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS_PENDING)
+    {
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_SUCCESS_PENDING, PH_COMP_PAL_ISO14443P4);
+    }
+
+    *pRxLength = 0;
+
+    /* A temporary S(WTX) timeout only applies to the frame just received */
+    statusTmp = phpalI14443p4_Sw_AsyncRestoreTimeout(pDataParams);
+    if ((statusTmp & PH_ERR_MASK) != PH_ERR_SUCCESS)
+    {
+        pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+        return statusTmp;
+    }
+
+    /* No error handling on abort */
+    if ((status & PH_ERR_MASK) == PH_ERR_ABORTED)
+    {
+        pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+        return status;
+    }
+
+    /* Status --> InvalidBlock mapping */
+    if(pDataParams->bOpeMode == RD_LIB_MODE_EMVCO)
+    {
+        bInvalidBlock = (uint8_t)PHPAL_I14443P4_SW_EMVCO_IS_INVALID_BLOCK_STATUS(status);
+    }
+    else
+    {
+        bInvalidBlock = (uint8_t)PHPAL_I14443P4_SW_IS_INVALID_BLOCK_STATUS(status);
+    }
+
+    if (0U == (bInvalidBlock))
+    {
+        /* MIFARE compliancy: force protocol error on NAK */
+        if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS_INCOMPLETE_BYTE)
+        {
+            status = PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_PAL_ISO14443P4);
+        }
+
+        /* Check for FSD */
+        if (((status & PH_ERR_MASK) == PH_ERR_SUCCESS) && (wRespLen > (bI14443p4_FsTable[pDataParams->bFsdi] - 2U)))
+        {
+            status = PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_PAL_ISO14443P4);
+        }
+
+        if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS)
+        {
+            pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+            return status;
+        }
+
+        /* Signal that we've received something */
+        pDataParams->bAsyncState |= PHPAL_I14443P4_SW_ASYNC_RESP_BIT;
+
+        /* I-Block handling */
+        if (0u != (PHPAL_I14443P4_SW_IS_I_BLOCK(pResp[PHPAL_I14443P4_SW_PCB_POS])))
+        {
+            /* Check if I-Block is valid */
+            status = phpalI14443p4_Sw_IsValidIBlock(
+                pDataParams->bCidEnabled,
+                pDataParams->bCid,
+                pDataParams->bNadEnabled,
+                pDataParams->bNad,
+                pResp,
+                wRespLen);
+
+            /* Blocknumber is equal */
+            if (((status & PH_ERR_MASK) == PH_ERR_SUCCESS) && (PHPAL_I14443P4_SW_IS_BLOCKNR_EQUAL(pResp[PHPAL_I14443P4_SW_PCB_POS]) > 0U))
+            {
+                /* Rule B, ISO/IEC 14443-4:2008(E), toggle Blocknumber */
+                pDataParams->bPcbBlockNum ^= PHPAL_I14443P4_SW_PCB_BLOCKNR;
+
+                /* Do not return protocol bytes, advance to INF field */
+                wRxOverlappedLen = 1;
+                if (0u != (pResp[PHPAL_I14443P4_SW_PCB_POS] & PHPAL_I14443P4_SW_PCB_CID_FOLLOWING))
+                {
+                    wRxOverlappedLen++;
+                }
+                if (0u != (pResp[PHPAL_I14443P4_SW_PCB_POS] & PHPAL_I14443P4_SW_PCB_NAD_FOLLOWING))
+                {
+                    wRxOverlappedLen++;
+                }
+                *ppRxBuffer = &pResp[wRxOverlappedLen];
+                *pRxLength = wRespLen - wRxOverlappedLen;
+
+                pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+
+                /* Card is chaining, remaining blocks are retrieved with PH_EXCHANGE_RXCHAINING */
+                if (0u != (PHPAL_I14443P4_SW_IS_CHAINING(pResp[PHPAL_I14443P4_SW_PCB_POS])))
+                {
+                    pDataParams->bStateNow = PHPAL_I14443P4_SW_STATE_I_BLOCK_RX | PHPAL_I14443P4_SW_STATE_CHAINING_BIT;
+                    return PH_ADD_COMPCODE_FIXED(PH_ERR_SUCCESS_CHAINING, PH_COMP_PAL_ISO14443P4);
+                }
+
+                /* Reception finished */
+                pDataParams->bStateNow = PHPAL_I14443P4_SW_STATE_FINISHED;
+                return PH_ERR_SUCCESS;
+            }
+
+            /* Protocol violation */
+            bInvalidBlock = 1;
+        }
+        /* R(ACK) handling */
+        else if ((PHPAL_I14443P4_SW_IS_R_BLOCK(pResp[PHPAL_I14443P4_SW_PCB_POS]) > 0U) && (PHPAL_I14443P4_SW_IS_ACK(pResp[PHPAL_I14443P4_SW_PCB_POS]) > 0U))
+        {
+            /* Check if R-Block is valid */
+            status = phpalI14443p4_Sw_IsValidRBlock(
+                pDataParams->bCidEnabled,
+                pDataParams->bCid,
+                pResp,
+                wRespLen);
+
+            /* Rule 6, ISO/IEC 14443-4:2008(E), unequal block number, send last I-Block again.
+             * An equal block number is a protocol violation since the last block is not chained. */
+            if (((status & PH_ERR_MASK) == PH_ERR_SUCCESS) &&
+                (0u == (PHPAL_I14443P4_SW_IS_BLOCKNR_EQUAL(pResp[PHPAL_I14443P4_SW_PCB_POS]))) &&
+                (pDataParams->bMaxRetryCount > 0U) && (pDataParams->bAsyncRetryCount < pDataParams->bMaxRetryCount))
+            {
+                ++pDataParams->bAsyncRetryCount;
+                PHPAL_I14443P4_SW_STAT_INC(pDataParams->wStatRetransmit);
+
+                statusTmp = phpalI14443p4_Sw_AsyncSendIBlock(pDataParams);
+                if ((statusTmp & PH_ERR_MASK) != PH_ERR_SUCCESS)
+                {
+                    pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+                    return statusTmp;
+                }
+
+                pDataParams->bAsyncState = (uint8_t)((pDataParams->bAsyncState & (uint8_t)~(uint8_t)PHPAL_I14443P4_SW_ASYNC_STATE_MASK) |
+                    PHPAL_I14443P4_SW_ASYNC_I_BLOCK);
+                return PH_ADD_COMPCODE_FIXED(PH_ERR_SUCCESS_PENDING, PH_COMP_PAL_ISO14443P4);
+            }
+
+            /* Protocol violation */
+            bInvalidBlock = 1;
+        }
+        /* S(WTX) handling */
+        else if ((PHPAL_I14443P4_SW_IS_S_BLOCK(pResp[PHPAL_I14443P4_SW_PCB_POS]) > 0U) && (PHPAL_I14443P4_SW_IS_WTX(pResp[PHPAL_I14443P4_SW_PCB_POS]) > 0U))
+        {
+            /* Check if S-Block is valid */
+            status = phpalI14443p4_Sw_IsValidSBlock(
+                pDataParams->bCidEnabled,
+                pDataParams->bCid,
+                pResp,
+                wRespLen);
+
+            /* Rule 3, ISO/IEC 14443-4:2008(E), S(WTX) handling */
+            if ((status & PH_ERR_MASK) == PH_ERR_SUCCESS)
+            {
+                /* Retrieve WTXM */
+                bWtxm = pResp[wRespLen-1u];
+
+                /* EMV 2.5 */
+                if ((0U != ((bWtxm & PHPAL_I14443P4_SW_S_BLOCK_INF_PLI_MASK))) && (pDataParams->bOpeMode == RD_LIB_MODE_EMVCO))
+                {
+                    pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+                    return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_PAL_ISO14443P4);
+                }
+
+                /* Ignore and clear the Power Level Indication */
+                bWtxm &= 0x3FU;
+
+                /* Treat invalid WTXM value as protocol error, do not perform error correction. */
+                if ((bWtxm == 0U) || (bWtxm > 59U))
+                {
+                    pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+                    return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_PAL_ISO14443P4);
+                }
+
+                /* Generate S(WTX) frame */
+                statusTmp = phpalI14443p4_Sw_BuildSBlock(
+                    pDataParams->bCidEnabled,
+                    pDataParams->bCid,
+                    1,
+                    bWtxm,
+                    bIsoFrame,
+                    &wIsoFrameLen);
+
+                /* Set temporary WTX timeout */
+                if ((statusTmp & PH_ERR_MASK) == PH_ERR_SUCCESS)
+                {
+                    statusTmp = phpalI14443p4_Sw_SetWtxTimeout(pDataParams, bWtxm, &pDataParams->wAsyncTimeoutPrev, &bTimeoutInMs);
+                }
+                if ((statusTmp & PH_ERR_MASK) == PH_ERR_SUCCESS)
+                {
+                    pDataParams->bAsyncState |= (0U != bTimeoutInMs) ? PHPAL_I14443P4_SW_ASYNC_WTX_MS_BIT : PHPAL_I14443P4_SW_ASYNC_WTX_US_BIT;
+                    statusTmp = phhalHw_ExchangeSubmit(pDataParams->pHalDataParams, PH_EXCHANGE_DEFAULT, bIsoFrame, wIsoFrameLen);
+                }
+                if ((statusTmp & PH_ERR_MASK) != PH_ERR_SUCCESS)
+                {
+                    (void)phpalI14443p4_Sw_AsyncRestoreTimeout(pDataParams);
+                    pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+                    return statusTmp;
+                }
+
+                /* Reset retry counter on no error */
+                pDataParams->bAsyncRetryCount = 0;
+                PHPAL_I14443P4_SW_STAT_INC(pDataParams->wStatWtx);
+
+                pDataParams->bAsyncState = (uint8_t)((pDataParams->bAsyncState & (uint8_t)~(uint8_t)PHPAL_I14443P4_SW_ASYNC_STATE_MASK) |
+                    PHPAL_I14443P4_SW_ASYNC_WTX);
+                return PH_ADD_COMPCODE_FIXED(PH_ERR_SUCCESS_PENDING, PH_COMP_PAL_ISO14443P4);
+            }
+
+            /* Protocol violation */
+            bInvalidBlock = 1;
+        }
+        /* We received an invalid block */
+        else
+        {
+            /* Protocol violation */
+            bInvalidBlock = 1;
+        }
+
+        /* Emvco:  case_id TA404_XY and TA401_15 */
+        /* bMaxRetryCount = 0 suppresses the S(DESELECT) behaviour */
+        if((pDataParams->bMaxRetryCount > 0U) && (pDataParams->bOpeMode != RD_LIB_MODE_EMVCO))
+        {
+            /* send S(DESELECT) (ignore return code) */
+            statusTmp = phpalI14443p4_Sw_Deselect(pDataParams);
+        }
+
+        /* bail out with protocol error */
+        pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_PROTOCOL_ERROR, PH_COMP_PAL_ISO14443P4);
+    }
+
+    /* Invalid Block received, same recovery as phpalI14443p4_Sw_IsoHandling for an unchained I-Block */
+    if ((pDataParams->bAsyncRetryCount >= pDataParams->bMaxRetryCount) && (pDataParams->bOpeMode == RD_LIB_MODE_ISO))
+    {
+        return phpalI14443p4_Sw_AsyncRecoveryFailed(pDataParams, status);
+    }
+    else if (pDataParams->bAsyncRetryCount < pDataParams->bMaxRetryCount)
+    {
+        /* Emvco: case_id TA402 TA403 */
+        if (pDataParams->bAsyncNakCount >= pDataParams->bMaxRetryCount)
+        {
+            pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+            return status;
+        }
+        ++pDataParams->bAsyncNakCount;
+
+        /* Rule 4, ISO/IEC 14443-4:2008(E), generate R(NAK) frame */
+        statusTmp = phpalI14443p4_Sw_BuildRBlock(
+            pDataParams->bCidEnabled,
+            pDataParams->bCid,
+            pDataParams->bPcbBlockNum,
+            0,
+            bIsoFrame,
+            &wIsoFrameLen);
+        if ((statusTmp & PH_ERR_MASK) == PH_ERR_SUCCESS)
+        {
+            statusTmp = phhalHw_ExchangeSubmit(pDataParams->pHalDataParams, PH_EXCHANGE_DEFAULT, bIsoFrame, wIsoFrameLen);
+        }
+        if ((statusTmp & PH_ERR_MASK) != PH_ERR_SUCCESS)
+        {
+            pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+            return statusTmp;
+        }
+
+        /* Increment retry count */
+        ++pDataParams->bAsyncRetryCount;
+        PHPAL_I14443P4_SW_STAT_INC(pDataParams->wStatNak);
+
+        pDataParams->bAsyncState = (uint8_t)((pDataParams->bAsyncState & (uint8_t)~(uint8_t)PHPAL_I14443P4_SW_ASYNC_STATE_MASK) |
+            PHPAL_I14443P4_SW_ASYNC_NAK);
+        return PH_ADD_COMPCODE_FIXED(PH_ERR_SUCCESS_PENDING, PH_COMP_PAL_ISO14443P4);
+    }
+    else
+    {
+        /* Bail out if the max. retry count is reached */
+        return phpalI14443p4_Sw_AsyncRecoveryFailed(pDataParams, status);
+    }
+}
+
+static phStatus_t phpalI14443p4_Sw_SetWtxTimeout(
+    phpalI14443p4_Sw_DataParams_t * pDataParams,
+    uint8_t bWtxm,
+    uint16_t * pTimeoutPrev,
+    uint8_t * pTimeoutInMs
+    )
+{
+    phStatus_t  PH_MEMLOC_REM status;
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+    uint32_t    PH_MEMLOC_REM dwTimeout;
+    uint32_t    PH_MEMLOC_REM dwTimeoutMax = PHPAL_I14443P4_SW_FWT_MAX_US;
+
+    /* Retrieve current timeout */
+    status = phhalHw_GetConfig(pDataParams->pHalDataParams, PHHAL_HW_CONFIG_TIMEOUT_VALUE_US, pTimeoutPrev);
+
+    /* Timeout is out of range, retrieve it in milliseconds */
+    if ((status & PH_ERR_MASK) == PH_ERR_PARAMETER_OVERFLOW)
+    {
+        PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_GetConfig(pDataParams->pHalDataParams, PHHAL_HW_CONFIG_TIMEOUT_VALUE_MS, pTimeoutPrev));
+        *pTimeoutInMs = 1;
+    }
+    else
+    {
+        PH_CHECK_SUCCESS(status);
+        *pTimeoutInMs = 0;
+    }
+
+    /* Calculate temporary WTX timeout */
+    if(pDataParams->bOpeMode == RD_LIB_MODE_ISO)
+    {
+        dwTimeout = (((uint32_t)PHPAL_I14443P4_SW_FWT_MIN_US * ((uint32_t)1U << pDataParams->bFwi)) * (uint32_t)bWtxm) +
+                    (uint32_t)PHPAL_I14443P4_EXT_TIME_US;
+    }
+    else
+    {
+        /* As per Digital Spec V1.1 req 15.3.2.1, NFC Forum Device SHALL wait at least FWTtemp + delta FWTT4AT for a Response */
+        dwTimeout = (((uint32_t)PHPAL_I14443P4_SW_FWT_MIN_US * ((uint32_t)1U << pDataParams->bFwi)) * (uint32_t)bWtxm) +
+                    (uint32_t)PHPAL_I14443P4_SW_DELTA_FWT_US;
+
+        dwTimeoutMax = PHPAL_I14443P4_SW_NFC_FWT_MAX_US;
+
+        if(pDataParams->bOpeMode == RD_LIB_MODE_EMVCO)
+        {
+            dwTimeout += (uint32_t)PHPAL_I14443P4_SW_DELTA_TPCD_US;
+
+            dwTimeoutMax = PHPAL_I14443P4_SW_EMVCO_FWT_MAX_US;
+        }
+    }
+
+    /* Limit timeout to FWT max */
+    if (dwTimeout > dwTimeoutMax)
+    {
+        dwTimeout = dwTimeoutMax;
+    }
+
+    /* Set temporary WTX timeout */
+    if (dwTimeout > 0xFFFFU)
+    {
+        PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_SetConfig(pDataParams->pHalDataParams, PHHAL_HW_CONFIG_TIMEOUT_VALUE_MS, (uint16_t)((dwTimeout / 1000U) + 1U)));
+    }
+    else
+    {
+        PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_SetConfig(pDataParams->pHalDataParams, PHHAL_HW_CONFIG_TIMEOUT_VALUE_US, (uint16_t)dwTimeout));
+    }
+
+    return PH_ERR_SUCCESS;
+}
+
+static phStatus_t phpalI14443p4_Sw_AsyncSendIBlock(
+    phpalI14443p4_Sw_DataParams_t * pDataParams
+    )
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+    uint8_t     PH_MEMLOC_REM bIsoFrame[3];
+    uint16_t    PH_MEMLOC_REM wIsoFrameLen = 0;
+
+    /* Generate I-Block frame header */
+    PH_CHECK_SUCCESS_FCT(statusTmp, phpalI14443p4_Sw_BuildIBlock(
+        pDataParams->bCidEnabled,
+        pDataParams->bCid,
+        pDataParams->bAsyncUseNad,
+        pDataParams->bNad,
+        pDataParams->bPcbBlockNum,
+        0,
+        bIsoFrame,
+        &wIsoFrameLen));
+
+    /* Write Frame to HAL TxBuffer but do not preform Exchange */
+    PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_Exchange(
+        pDataParams->pHalDataParams,
+        PH_EXCHANGE_BUFFER_FIRST,
+        bIsoFrame,
+        wIsoFrameLen,
+        NULL,
+        NULL));
+
+    /* Transmit INF field and return without waiting for the response */
+    return phhalHw_ExchangeSubmit(
+        pDataParams->pHalDataParams,
+        PH_EXCHANGE_BUFFER_LAST,
+        pDataParams->pAsyncTxBuffer,
+        pDataParams->wAsyncTxLength);
+}
+
+static phStatus_t phpalI14443p4_Sw_AsyncRestoreTimeout(
+    phpalI14443p4_Sw_DataParams_t * pDataParams
+    )
+{
+    phStatus_t  PH_MEMLOC_REM statusTmp;
+
+    if (0U != (pDataParams->bAsyncState & PHPAL_I14443P4_SW_ASYNC_WTX_US_BIT))
+    {
+        pDataParams->bAsyncState &= (uint8_t)~(uint8_t)PHPAL_I14443P4_SW_ASYNC_WTX_US_BIT;
+        PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_SetConfig(pDataParams->pHalDataParams, PHHAL_HW_CONFIG_TIMEOUT_VALUE_US, pDataParams->wAsyncTimeoutPrev));
+    }
+    else if (0U != (pDataParams->bAsyncState & PHPAL_I14443P4_SW_ASYNC_WTX_MS_BIT))
+    {
+        pDataParams->bAsyncState &= (uint8_t)~(uint8_t)PHPAL_I14443P4_SW_ASYNC_WTX_MS_BIT;
+        PH_CHECK_SUCCESS_FCT(statusTmp, phhalHw_SetConfig(pDataParams->pHalDataParams, PHHAL_HW_CONFIG_TIMEOUT_VALUE_MS, pDataParams->wAsyncTimeoutPrev));
+    }
+    else
+    {
+        /* No temporary timeout active */
+    }
+
+    return PH_ERR_SUCCESS;
+}
+
+static phStatus_t phpalI14443p4_Sw_AsyncRecoveryFailed(
+    phpalI14443p4_Sw_DataParams_t * pDataParams,
+    phStatus_t status
+    )
+{
+    uint8_t     PH_MEMLOC_REM bRetryCount;
+
+    /* Deselect card if behaviour is enabled */
+    if (pDataParams->bMaxRetryCount > 0U)
+    {
+        /* backup retry count */
+        bRetryCount = pDataParams->bMaxRetryCount;
+
+        /* set retry count to zero to send only one S(DESELECT) */
+        pDataParams->bMaxRetryCount = 0;
+
+        /* Emvco Doesnot expect DeSelect Command*/
+        if(pDataParams->bOpeMode != RD_LIB_MODE_EMVCO)
+        {
+            /* send deselect (ignore return code) */
+            (void)phpalI14443p4_Sw_Deselect(pDataParams);
+        }
+        /* restore retry count setting */
+        pDataParams->bMaxRetryCount = bRetryCount;
+
+        /* Return ERR_RECOVERY_FAILED if some response has been received before */
+        if (0U != (pDataParams->bAsyncState & PHPAL_I14443P4_SW_ASYNC_RESP_BIT))
+        {
+            status = PH_ADD_COMPCODE_FIXED(PHPAL_I14443P4_ERR_RECOVERY_FAILED, PH_COMP_PAL_ISO14443P4);
+        }
+    }
+
+    pDataParams->bAsyncState = PHPAL_I14443P4_SW_ASYNC_IDLE;
+    return status;
+}
+
 phStatus_t phpalI14443p4_Sw_IsValidIBlock(
     uint8_t bCheckCid,
     uint8_t bCid,
@@ -1673,6 +2195,21 @@ phStatus_t phpalI14443p4_Sw_SetConfig(
             pDataParams->bOpeMode = (uint8_t)wValue;
             break;
         }
+    case PHPAL_I14443P4_CONFIG_STAT_WTX:
+        {
+            pDataParams->wStatWtx = wValue;
+            break;
+        }
+    case PHPAL_I14443P4_CONFIG_STAT_NAK:
+        {
+            pDataParams->wStatNak = wValue;
+            break;
+        }
+    case PHPAL_I14443P4_CONFIG_STAT_RETRANSMIT:
+        {
+            pDataParams->wStatRetransmit = wValue;
+            break;
+        }
     case PHPAL_I14443P4_CONFIG_BLOCKNO:
         {
             if (wValue == 0U)
@@ -1818,6 +2355,21 @@ phStatus_t phpalI14443p4_Sw_GetConfig(
             *pValue = (uint16_t)pDataParams->bMaxRetryCount;
             break;
         }
+    case PHPAL_I14443P4_CONFIG_STAT_WTX:
+        {
+            *pValue = pDataParams->wStatWtx;
+            break;
+        }
+    case PHPAL_I14443P4_CONFIG_STAT_NAK:
+        {
+            *pValue = pDataParams->wStatNak;
+            break;
+        }
+    case PHPAL_I14443P4_CONFIG_STAT_RETRANSMIT:
+        {
+            *pValue = pDataParams->wStatRetransmit;
+            break;
+        }
     default:
         {
             return PH_ADD_COMPCODE_FIXED(PH_ERR_UNSUPPORTED_PARAMETER, PH_COMP_PAL_ISO14443P4);
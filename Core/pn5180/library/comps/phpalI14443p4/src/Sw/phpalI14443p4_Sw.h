@@ -56,6 +56,18 @@ phStatus_t phpalI14443p4_Sw_Exchange(
                                      uint16_t * pRxLength
                                      );
 
+phStatus_t phpalI14443p4_Sw_ExchangeSubmit(
+                                           phpalI14443p4_Sw_DataParams_t * pDataParams,
+                                           uint8_t * pTxBuffer,
+                                           uint16_t wTxLength
+                                           );
+
+phStatus_t phpalI14443p4_Sw_ExchangePoll(
+                                         phpalI14443p4_Sw_DataParams_t * pDataParams,
+                                         uint8_t ** ppRxBuffer,
+                                         uint16_t * pRxLength
+                                         );
+
 phStatus_t phpalI14443p4_Sw_SetConfig(
                                       phpalI14443p4_Sw_DataParams_t * pDataParams,
                                       uint16_t wConfig,
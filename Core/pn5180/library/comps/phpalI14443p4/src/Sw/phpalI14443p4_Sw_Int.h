@@ -127,6 +127,30 @@
 /** Only 6 bits of the state are pure state codes */
 #define PHPAL_I14443P4_SW_STATE_MASK            0x0FU
 
+/** No submitted exchange in flight */
+#define PHPAL_I14443P4_SW_ASYNC_IDLE            0x00U
+
+/** Submitted exchange waits for the response to an I-Block */
+#define PHPAL_I14443P4_SW_ASYNC_I_BLOCK         0x01U
+
+/** Submitted exchange waits for the response to an S(WTX) response */
+#define PHPAL_I14443P4_SW_ASYNC_WTX             0x02U
+
+/** Submitted exchange waits for the response to an R(NAK) */
+#define PHPAL_I14443P4_SW_ASYNC_NAK             0x03U
+
+/** Only the low nibble of the async state is a state code */
+#define PHPAL_I14443P4_SW_ASYNC_STATE_MASK      0x0FU
+
+/** Temporary WTX timeout is active, given in milliseconds */
+#define PHPAL_I14443P4_SW_ASYNC_WTX_MS_BIT      0x20U
+
+/** Temporary WTX timeout is active, given in microseconds */
+#define PHPAL_I14443P4_SW_ASYNC_WTX_US_BIT      0x40U
+
+/** A valid block has been received during the submitted exchange */
+#define PHPAL_I14443P4_SW_ASYNC_RESP_BIT        0x80U
+
 /** Default Maximum Retry count for ISO/IEC 14443-4:2008(E) Rule 4 and 5 */
 #define PHPAL_I14443P4_SW_MAX_RETRIES_DEFAULT   2U
 
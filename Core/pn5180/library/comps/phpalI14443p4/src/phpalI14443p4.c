@@ -311,6 +311,116 @@ phStatus_t phpalI14443p4_Exchange(
     return status;
 }
 
+phStatus_t phpalI14443p4_ExchangeSubmit(
+                                        void * pDataParams,
+                                        uint8_t * pTxBuffer,
+                                        uint16_t wTxLength
+                                        )
+{
+    phStatus_t PH_MEMLOC_REM status;
+
+    PH_LOG_HELPER_ALLOCATE_TEXT(bFunctionName, "phpalI14443p4_ExchangeSubmit");
+    /*PH_LOG_HELPER_ALLOCATE_PARAMNAME(pDataParams);*/
+    PH_LOG_HELPER_ALLOCATE_PARAMNAME(pTxBuffer);
+    PH_LOG_HELPER_ALLOCATE_PARAMNAME(status);
+    PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+    PH_LOG_HELPER_ADDPARAM_BUFFER(PH_LOG_LOGTYPE_DEBUG, pTxBuffer_log, pTxBuffer, wTxLength);
+    PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_ENTER);
+    PH_ASSERT_NULL (pDataParams);
+    if (0U != (wTxLength)) PH_ASSERT_NULL (pTxBuffer);
+
+    /* Check data parameters */
+    if (PH_GET_COMPCODE(pDataParams) != PH_COMP_PAL_ISO14443P4)
+    {
+        status = PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_DATA_PARAMS, PH_COMP_PAL_ISO14443P4);
+
+        PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+        PH_LOG_HELPER_ADDPARAM_UINT16(PH_LOG_LOGTYPE_INFO, status_log, &status);
+        PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_LEAVE);
+
+        return status;
+    }
+
+    /* perform operation on active layer */
+    switch (PH_GET_COMPID(pDataParams))
+    {
+#ifdef NXPBUILD__PHPAL_I14443P4_SW
+    case PHPAL_I14443P4_SW_ID:
+        status = phpalI14443p4_Sw_ExchangeSubmit((phpalI14443p4_Sw_DataParams_t *)pDataParams, pTxBuffer, wTxLength);
+        break;
+#endif /* NXPBUILD__PHPAL_I14443P4_SW */
+
+    default:
+        status = PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_DATA_PARAMS, PH_COMP_PAL_ISO14443P4);
+        break;
+    }
+
+    PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+    PH_LOG_HELPER_ADDPARAM_UINT16(PH_LOG_LOGTYPE_INFO, status_log, &status);
+    PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_LEAVE);
+
+    return status;
+}
+
+phStatus_t phpalI14443p4_ExchangePoll(
+                                      void * pDataParams,
+                                      uint8_t ** ppRxBuffer,
+                                      uint16_t * pRxLength
+                                      )
+{
+    phStatus_t PH_MEMLOC_REM status;
+
+    PH_LOG_HELPER_ALLOCATE_TEXT(bFunctionName, "phpalI14443p4_ExchangePoll");
+    /*PH_LOG_HELPER_ALLOCATE_PARAMNAME(pDataParams);*/
+    PH_LOG_HELPER_ALLOCATE_PARAMNAME(ppRxBuffer);
+    PH_LOG_HELPER_ALLOCATE_PARAMNAME(status);
+    PH_ASSERT_NULL (pDataParams);
+
+    /* Check data parameters */
+    if (PH_GET_COMPCODE(pDataParams) != PH_COMP_PAL_ISO14443P4)
+    {
+        status = PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_DATA_PARAMS, PH_COMP_PAL_ISO14443P4);
+
+        PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+        PH_LOG_HELPER_ADDPARAM_UINT16(PH_LOG_LOGTYPE_INFO, status_log, &status);
+        PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_LEAVE);
+
+        return status;
+    }
+
+    /* perform operation on active layer */
+    switch (PH_GET_COMPID(pDataParams))
+    {
+#ifdef NXPBUILD__PHPAL_I14443P4_SW
+    case PHPAL_I14443P4_SW_ID:
+        status = phpalI14443p4_Sw_ExchangePoll((phpalI14443p4_Sw_DataParams_t *)pDataParams, ppRxBuffer, pRxLength);
+        break;
+#endif /* NXPBUILD__PHPAL_I14443P4_SW */
+
+    default:
+        status = PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_DATA_PARAMS, PH_COMP_PAL_ISO14443P4);
+        break;
+    }
+
+    /* Do not log every pending poll */
+    if ((status & PH_ERR_MASK) != PH_ERR_SUCCESS_PENDING)
+    {
+        PH_LOG_HELPER_ADDSTRING(PH_LOG_LOGTYPE_INFO, bFunctionName);
+#ifdef NXPBUILD__PH_LOG
+        if ((((status & PH_ERR_MASK) == PH_ERR_SUCCESS) ||
+            ((status & PH_ERR_MASK) == PH_ERR_SUCCESS_CHAINING)) &&
+            (ppRxBuffer != NULL))
+        {
+            PH_LOG_HELPER_ADDPARAM_BUFFER(PH_LOG_LOGTYPE_DEBUG, ppRxBuffer_log, *ppRxBuffer, *pRxLength);
+        }
+#endif
+        PH_LOG_HELPER_ADDPARAM_UINT16(PH_LOG_LOGTYPE_INFO, status_log, &status);
+        PH_LOG_HELPER_EXECUTE(PH_LOG_OPTION_CATEGORY_LEAVE);
+    }
+
+    return status;
+}
+
 phStatus_t phpalI14443p4_SetConfig(
                                    void * pDataParams,
                                    uint16_t wConfig,
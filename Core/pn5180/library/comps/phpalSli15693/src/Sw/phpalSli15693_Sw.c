@@ -19,14 +19,6 @@
 
 */
 
-/* 临时修复：添加缺少的宏定义 */
-#ifndef PHHAL_HW_TIME_MICROSECONDS
-#define PHHAL_HW_TIME_MICROSECONDS    0x00U
-#define PHHAL_HW_TIME_MILLISECONDS    0x01U
-#define PHHAL_HW_TIME_SECONDS         0x02U
-#endif
-
-
 #include <ph_Status.h>
 #include <phpalSli15693.h>
 #include <ph_RefDefs.h>
@@ -120,6 +112,7 @@ phStatus_t phpalSli15693_Sw_SendEof(
     case PHPAL_SLI15693_EOF_NEXT_SLOT_INV_READ:
     case PHPAL_SLI15693_EOF_WRITE_ALIKE:
     case PHPAL_SLI15693_EOF_WRITE_ALIKE_WITH_WAIT:
+    case PHPAL_SLI15693_EOF_WRITE_ALIKE_PROBE:
         break;
     default:
         return PH_ADD_COMPCODE_FIXED(PH_ERR_INVALID_PARAMETER, PH_COMP_PAL_SLI15693);
@@ -146,7 +139,7 @@ phStatus_t phpalSli15693_Sw_SendEof(
         PHHAL_HW_CONFIG_ASK100,
         &wAsk));
 
-    if(bOption == PHPAL_SLI15693_EOF_NEXT_SLOT)
+    if((bOption == PHPAL_SLI15693_EOF_NEXT_SLOT) || (bOption == PHPAL_SLI15693_EOF_WRITE_ALIKE_PROBE))
     {
         if(0U != (wAsk))
         {
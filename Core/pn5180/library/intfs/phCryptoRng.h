@@ -48,17 +48,41 @@ extern "C" {
  * @{
  */
 
+#ifndef PH_CRYPTORNG_SW_POOL_SIZE
+#define PH_CRYPTORNG_SW_POOL_SIZE           64U                                 /**< Bytes of DRBG output kept ready for #phCryptoRng_Rnd. */
+#endif /* PH_CRYPTORNG_SW_POOL_SIZE */
+
+/**
+ * \brief Entropy source used for seeding and scheduled reseeding.
+ *
+ * \return Status code
+ * \retval #PH_ERR_SUCCESS when \b wLength bytes of full entropy were written to \b pEntropy.
+ */
+typedef phStatus_t (*phCryptoRng_Sw_EntropyCb_t)(
+        void * pContext,                                                        /**< [In] Context given to #phCryptoRng_Sw_SetEntropySource. */
+        uint8_t * pEntropy,                                                     /**< [Out] Entropy bytes. */
+        uint16_t wLength                                                        /**< [In] Number of bytes requested. */
+    );
+
 /** \brief Data structure for Random Number's Software layer implementation. */
 typedef struct
 {
     uint16_t wId;                                                               /**< Layer ID for this component, NEVER MODIFY! */
     void * pCryptoDataParams;                                                   /**< Data parameter structure for the AES engine */
     uint8_t V[16];
+    uint8_t Key[16];                                                            /**< Working key, kept here as the derivation function loads its own key into \b pCryptoDataParams. */
     uint32_t dwRequestCounter;                                                  /**< Counts the amount of requests between two seeding procedures.
                                                                                  *   Note: according to NIST SP800-90 for AES this is 2^48, for storage
                                                                                  *   reasons the limit is set to 2^32 in this particular implementation.
                                                                                  */
     uint8_t bState;
+    phCryptoRng_Sw_EntropyCb_t pEntropyCb;                                      /**< Entropy source, NULL when only application seeds are used. */
+    void * pEntropyContext;                                                     /**< Context passed to \b pEntropyCb. */
+    uint32_t dwReseedInterval;                                                  /**< Requests between two reseeds from \b pEntropyCb. */
+    uint16_t wPoolLen;                                                          /**< Bytes available in \b aPool. */
+    uint8_t aPool[PH_CRYPTORNG_SW_POOL_SIZE];                                   /**< Pre-generated DRBG output, consumed from the end. */
+    uint8_t bSeedPending;                                                       /**< \b aPendingSeed holds seeds not yet mixed into the DRBG. */
+    uint8_t aPendingSeed[32];                                                   /**< Seeds given to a working DRBG, XORed, applied before the next generate. */
 } phCryptoRng_Sw_DataParams_t;
 
 /**
@@ -82,6 +106,42 @@ phStatus_t phCryptoRng_Sw_Init(
         void * pCryptoDataParams                                                /**< [In] Pointer to the parameter structure of the symmetric crypto layer. */
     );
 
+/**
+ * \brief Attach an entropy source and seed (or reseed) the DRBG from it.
+ *
+ * From then on the DRBG is reseeded from \b pEntropyCb after every \b dwReseedInterval
+ * requests. Reseeding is done by #phCryptoRng_Sw_RefillPool, or inline by #phCryptoRng_Rnd
+ * when the pool cannot serve a request.
+ *
+ * \return Status code
+ * \retval #PH_ERR_SUCCESS                  Operation successful.
+ * \retval Other Depending on the entropy source and the AES engine.
+ */
+phStatus_t phCryptoRng_Sw_SetEntropySource(
+        phCryptoRng_Sw_DataParams_t * pDataParams,                              /**< [In] Pointer to this layers parameter structure. */
+        phCryptoRng_Sw_EntropyCb_t pEntropyCb,                                  /**< [In] Entropy source. */
+        void * pContext,                                                        /**< [In] Context passed to the entropy source. */
+        uint32_t dwReseedInterval                                               /**< [In] Requests between two reseeds, 0 for the NIST maximum. */
+    );
+
+/**
+ * \brief Reseed when due and top up the pool of pre-generated random bytes.
+ *
+ * Seeds given to a working DRBG through #phCryptoRng_Seed are mixed in here as well, or by
+ * the next #phCryptoRng_Rnd that the pool cannot serve.
+ *
+ * Meant to be called from idle time. Requests to #phCryptoRng_Rnd that fit the pool are
+ * then served by a copy out of the pool instead of running the DRBG.
+ *
+ * \return Status code
+ * \retval #PH_ERR_SUCCESS                  Operation successful.
+ * \retval #PH_ERR_USE_CONDITION            The DRBG is not seeded yet.
+ * \retval Other Depending on the entropy source and the AES engine.
+ */
+phStatus_t phCryptoRng_Sw_RefillPool(
+        phCryptoRng_Sw_DataParams_t * pDataParams                               /**< [In] Pointer to this layers parameter structure. */
+    );
+
 /**
  * end of group phCryptoRng_Sw
  * @}
@@ -370,6 +370,22 @@ extern "C" {
 #define PH_NFCLIB_ACTIVATION_MERGED_SAK_PRIO_14443   0x0U /**< Priority given to ISO 14443 */
 #define PH_NFCLIB_ACTIVATION_MERGED_SAK_PRIO_18092   0x1U /**< Priority given to ISO 18092 */
 
+/**
+ *\}
+ */
+
+/**
+ * @name ISO 15693 Write Timing
+ *
+ * \anchor nfc_lib_definitions_i15693_write_timing
+ * \brief Definitions used as values for #phNfcLib_SetConfig_Value and #phNfcLib_GetConfig when using
+ * configuration tag #PH_NFCLIB_CONFIG_I15693_WRITE_TIMING
+ *
+ * \{
+ */
+#define PH_NFCLIB_I15693_WRITE_TIMING_FIXED          0x0U /**< EOF after #PHPAL_SLI15693_TIMEOUT_LONG_US, any VICC */
+#define PH_NFCLIB_I15693_WRITE_TIMING_ADAPTIVE       0x1U /**< EOF after the programming time learned for the IC type */
+
 /**
  *\}
  */
@@ -627,6 +643,25 @@ extern "C" {
  */
 #define PH_NFCLIB_CONFIG_EMVCO_PROF_FSCI                 0x12U
 
+/**
+ * \anchor I15693_write_timing_configuration
+ * This configuration selects when the EOF of an ISO 15693 write alike command sent with the option flag
+ * (\ref phNfcLib_I15693_t "bOption") is sent.
+ * With #PH_NFCLIB_I15693_WRITE_TIMING_ADAPTIVE the programming time is learned per IC manufacturer, IC type
+ * (UID) and IC reference by sending EOFs early and retrying while the VICC does not answer. The IC reference
+ * is known when #ISO15693_GetSystemInformation was the last one sent to the same VICC. Later writes to the same IC type send the EOF after the learned time multiplied by the number of
+ * blocks. Setting the configuration forgets the learned times.
+ * Note: A VICC that answers an early EOF with an error response is not supported in adaptive mode.
+ * \par Parameter Size
+ * 1 Byte (\p uint8_t)
+ * \par Allowed Values
+ * \li \p #PH_NFCLIB_I15693_WRITE_TIMING_FIXED
+ * \li \p #PH_NFCLIB_I15693_WRITE_TIMING_ADAPTIVE
+ * \par Default Value
+ * \p #PH_NFCLIB_I15693_WRITE_TIMING_FIXED
+ */
+#define PH_NFCLIB_CONFIG_I15693_WRITE_TIMING             0x13U
+
 #define PH_NFCLIB_CONFIG_TARGET_TYPEA_ATQA               0x20U
 #define PH_NFCLIB_CONFIG_TARGET_TYPEA_UID                0x21U
 #define PH_NFCLIB_CONFIG_TARGET_TYPEA_SAK                0x22U
@@ -1071,6 +1106,28 @@ phNfcLib_Status_t phNfcLib_SetContext(
                                       phNfcLib_AppContext_t * pAppContext     /**< [In] Pointers to phNfcLib_AppContext_t structure which provides the context to NFCLIB by Application. */
                                       );
 
+/**
+ *  \brief Select the front-end (reader) the following NFC Library calls work on.
+ *
+ *  Each reader has its own stack instance: BAL context, HAL, PAL, AL, discovery loop and
+ *  NFC Library state. Call this before \ref phNfcLib_SetContext and \ref phNfcLib_Init to
+ *  bring up each reader, then again whenever the application moves to another reader.
+ *  Reader 0 is selected after reset.
+ *
+ * \retval PH_NFCLIB_STATUS_INVALID_PARAMETER
+ * \a bReader is not below #PH_NXPNFCRDLIB_CONFIG_READER_COUNT.
+ * \retval PH_NFCLIB_STATUS_INVALID_STATE
+ * The active reader is in the middle of a deactivation.
+ */
+phNfcLib_Status_t phNfcLib_SelectReader(
+                                        uint8_t bReader     /**< [In] Reader index, 0 to #PH_NXPNFCRDLIB_CONFIG_READER_COUNT - 1. */
+                                        );
+
+/**
+ *  \brief Return the index of the reader selected with \ref phNfcLib_SelectReader.
+ */
+uint8_t phNfcLib_GetSelectedReader(void);
+
 /**
  *  \brief Initialize the NFC Library.
  *
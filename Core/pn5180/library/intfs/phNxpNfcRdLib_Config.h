@@ -43,6 +43,11 @@
     #define PH_NXPNFCRDLIB_CONFIG_HAL_RX_BUFFSIZE                    2060U
 #endif
 
+/**< Number of front-ends driven by the Simplified API Layer, each one gets its own stack instance. */
+#ifndef PH_NXPNFCRDLIB_CONFIG_READER_COUNT
+    #define PH_NXPNFCRDLIB_CONFIG_READER_COUNT                       1U
+#endif
+
 #define PH_NXPNFCRDLIB_CONFIG_ATS_BUFF_LENGTH                    64U       /**< Maximum ATS response buffer length. */
 #define PH_NXPNFCRDLIB_CONFIG_HCE_BUFF_LENGTH                    300U      /**< Buffer length for HCE used when UpdateBinary or Custom commands are supported. */
 
@@ -102,7 +102,8 @@ typedef struct phTools_Q
                                            bSenderType determines the actual type of the sender to allow proper casting. */
     uint8_t *pbData;                  /**< Content of the message, type of the content is given using bType. */
     uint32_t dwLength;                /**< Length of the message. */
-    uint8_t bLlcpBuf[6];              /**< Buffer used to store LLCP formatted PDUs that needs to be sent while processing Message Queue. */
+    uint8_t bLlcpBuf[9];              /**< Buffer used to store LLCP formatted PDUs that needs to be sent while processing Message Queue.
+                                           Sized for a CC PDU carrying the MIUX and RW TLVs. */
     uint8_t bLlcpData;                /**< This variable is used to decide if LLCP framed data should be sent or data from application. */
     struct phTools_Q *pNext;          /**< Pointer to next element in the list/queue. */
     uint16_t wFrameOpt;               /**< Frame Option can take #PH_TRANSMIT_DEFAULT, #PH_TRANSMIT_BUFFER_FIRST,
@@ -113,6 +114,8 @@ typedef struct phTools_Q
 
 /**
 * \brief Calculate even or odd parity.
+*
+* Table driven, 8 input bytes are encoded into 9 output bytes per step.
 * \return Status code
 * \retval #PH_ERR_SUCCESS Operation successful.
 */
@@ -129,6 +132,8 @@ phStatus_t phTools_EncodeParity(
 
 /**
 * \brief Verify and Remove even or odd parity.
+*
+* Table driven, 9 input bytes are decoded into 8 output bytes per step.
 * \return Status code
 * \retval #PH_ERR_SUCCESS Operation successful.
 */
@@ -143,6 +148,42 @@ phStatus_t phTools_DecodeParity(
                                 uint8_t * pOutBufferBits        /**< [Out] Number of valid bits in last byte of pOutBuffer. */
                                 );
 
+/**
+* \brief Bit by bit reference implementation of #phTools_EncodeParity.
+*
+* Same parameters and results, kept to verify the table driven version.
+* \return Status code
+* \retval #PH_ERR_SUCCESS Operation successful.
+*/
+phStatus_t phTools_EncodeParityRef(
+                                uint8_t bOption,                /**< [In] Parity option; e.g. #PH_TOOLS_PARITY_OPTION_EVEN. */
+                                uint8_t * pInBuffer,            /**< [In] Array to input data. */
+                                uint16_t wInBufferLength,       /**< [In] Length of input data in bytes. */
+                                uint8_t bInBufferBits,          /**< [In] Number of valid bits in last byte of pInBuffer. */
+                                uint16_t wOutBufferSize,        /**< [In] Size of the output buffer. */
+                                uint8_t * pOutBuffer,           /**< [Out] Output buffer. */
+                                uint16_t * pOutBufferLength,    /**< [Out] Number of valid bytes in pOutBuffer. */
+                                uint8_t * pOutBufferBits        /**< [Out] Number of valid bits in last byte of pOutBuffer. */
+                                );
+
+/**
+* \brief Bit by bit reference implementation of #phTools_DecodeParity.
+*
+* Same parameters and results, kept to verify the table driven version.
+* \return Status code
+* \retval #PH_ERR_SUCCESS Operation successful.
+*/
+phStatus_t phTools_DecodeParityRef(
+                                uint8_t bOption,                /**< [In] Parity option; e.g. #PH_TOOLS_PARITY_OPTION_EVEN. */
+                                uint8_t * pInBuffer,            /**< [In] Array to input data. */
+                                uint16_t wInBufferLength,       /**< [In] Length of input data in bytes. */
+                                uint8_t bInBufferBits,          /**< [In] Number of valid bits in last byte of pInBuffer. */
+                                uint16_t wOutBufferSize,        /**< [In] Size of the output buffer. */
+                                uint8_t * pOutBuffer,           /**< [Out] Output buffer. */
+                                uint16_t * pOutBufferLength,    /**< [Out] Number of valid bytes in pOutBuffer. */
+                                uint8_t * pOutBufferBits        /**< [Out] Number of valid bits in last byte of pOutBuffer. */
+                                );
+
 /**
 * \brief Calculate a CRC 5
 * \return Status code
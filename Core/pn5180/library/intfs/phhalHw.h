@@ -579,6 +579,9 @@ typedef void (*ppTimerCallBck_t)(void);
 
         uint16_t wWaitIRQDelayWithTestBus;                  /** Wait time needed during Read STATUS register in TestBus mode. */
 
+        uint8_t bAsyncExchange;                             /**< Flag indicates whether an exchange started by \ref phhalHw_Pn5180_ExchangeSubmit is in flight. */
+        uint32_t dwAsyncIrqWaitFor;                         /**< IRQ sources on which the in-flight asynchronous exchange completes. */
+
         phOsal_EventObj_t HwEventObj;                       /**< Handle for Event. */
     /*end */
     } phhalHw_Pn5180_DataParams_t;
@@ -2020,6 +2023,12 @@ typedef struct
 #define phhalHw_Exchange(pDataParams,wOption,pTxBuffer,wTxLength,ppRxBuffer,pRxLength) \
         phhalHw_Pn5180_Exchange((phhalHw_Pn5180_DataParams_t *)pDataParams, wOption, pTxBuffer, wTxLength, ppRxBuffer, pRxLength)
 
+#define phhalHw_ExchangeSubmit(pDataParams, wOption, pTxBuffer, wTxLength) \
+        phhalHw_Pn5180_ExchangeSubmit((phhalHw_Pn5180_DataParams_t *)pDataParams, wOption, pTxBuffer, wTxLength)
+
+#define phhalHw_ExchangePoll(pDataParams, ppRxBuffer, pRxLength) \
+        phhalHw_Pn5180_ExchangePoll((phhalHw_Pn5180_DataParams_t *)pDataParams, ppRxBuffer, pRxLength)
+
 #define phhalHw_ApplyProtocolSettings(pDataParams, bMode) \
         phhalHw_Pn5180_ApplyProtocolSettings((phhalHw_Pn5180_DataParams_t *)pDataParams, bMode)
 
@@ -2269,6 +2278,51 @@ typedef struct
         uint16_t * pRxLength    /**< [Out] Number of received data bytes. */
         );
 
+    /**
+    * \brief Start an exchange and return without waiting for the response.
+    *
+    * Performs the transmit part of \ref phhalHw_Exchange and returns as soon as the frame has been handed over
+    * to the reader IC. The response is collected with \ref phhalHw_ExchangePoll, which has to be called until it
+    * returns a status other than #PH_ERR_SUCCESS_PENDING. In between, the caller is free to do other work that does
+    * not use this HAL instance; the only HAL calls allowed while the exchange is in flight are
+    * \ref phhalHw_ExchangePoll and \ref phhalHw_AsyncAbort.
+    *
+    * \b wOption can be #PH_EXCHANGE_DEFAULT or #PH_EXCHANGE_LEAVE_BUFFER_BIT (to send data preloaded with
+    * \ref phhalHw_Exchange and #PH_EXCHANGE_BUFFERED_BIT). Buffering itself is not supported by this API.
+    *
+    * \return Status code
+    * \retval #PH_ERR_SUCCESS Frame transmitted, response pending.
+    * \retval #PH_ERR_USE_CONDITION Another asynchronous exchange is still in flight.
+    * \retval #PH_ERR_INVALID_PARAMETER \b wOption is invalid.
+    * \retval #PH_ERR_UNSUPPORTED_COMMAND Not supported by the active HAL.
+    * \retval Other Depending on implementation and underlying component.
+    */
+    phStatus_t phhalHw_ExchangeSubmit(
+        void * pDataParams,     /**< [In] Pointer to this layer's parameter structure. */
+        uint16_t wOption,       /**< [In] Option parameter. */
+        uint8_t * pTxBuffer,    /**< [In] Data to transmit. */
+        uint16_t wTxLength      /**< [In] Number of bytes to transmit. */
+        );
+
+    /**
+    * \brief Check for completion of an exchange started with \ref phhalHw_ExchangeSubmit.
+    *
+    * Never blocks. Returns #PH_ERR_SUCCESS_PENDING while the reader IC is still waiting for the response; otherwise
+    * the exchange is finished and the status as well as the response are the same as \ref phhalHw_Exchange would
+    * have returned. An abort requested with \ref phhalHw_AsyncAbort is reported as #PH_ERR_ABORTED.
+    *
+    * \return Status code
+    * \retval #PH_ERR_SUCCESS_PENDING Response not yet available, poll again.
+    * \retval #PH_ERR_USE_CONDITION No asynchronous exchange in flight.
+    * \retval #PH_ERR_ABORTED Exchange aborted by \ref phhalHw_AsyncAbort.
+    * \retval Other See \ref phhalHw_Exchange.
+    */
+    phStatus_t phhalHw_ExchangePoll(
+        void * pDataParams,     /**< [In] Pointer to this layer's parameter structure. */
+        uint8_t ** ppRxBuffer,  /**< [Out] Pointer to received data. */
+        uint16_t * pRxLength    /**< [Out] Number of received data bytes. */
+        );
+
     /**
     * \brief Configure reader IC for a particular reader/initiator protocol.
     *
@@ -86,6 +86,31 @@ typedef enum /*phlnLlcp_PType*/{
 #define PHLN_LLCP_PTYPE_RR		(PHLN_LLCP_PTYPE_INFO + 1U )                                /**< Receive Ready to acknowledge one or more received I PDUs and indicate that the LLC is able to
                                                                                               receive subsequent Information PDUs (I PDUs). */
 #define PHLN_LLCP_PTYPE_RNR      (PHLN_LLCP_PTYPE_INFO + 2U )                               /**< Receive Not Ready is used by LLC to indicate a temporary inability to process subsequent I PDUs. */
+
+/**
+* \name Receive Window size of LLCP
+* Receive window size of one indicates that the local LLC will acknowledge every I PDU before accepting additional I PDUs.
+* PHLN_LLCP_TLV_RW_VALUE is the largest local RW and can be raised up to #PHLN_LLCP_RW_MAX in the build configuration.
+* The Socket Rx buffer of a Connection-oriented socket is split into one receive slot per #PHLN_LLCP_MIU bytes, at most
+* PHLN_LLCP_TLV_RW_VALUE slots, and the number of slots is the RW advertised in CONNECT/CC PDUs. So a local RW of N needs
+* a Socket Rx buffer of N times #PHLN_LLCP_MIU.\n
+* Received I PDUs are buffered in the slots in sequence and acknowledged by N(R) once the application has released their
+* slot by setting 'fReady', so the remote LLC never has more I PDUs outstanding than there are free slots.\n
+* Independent of this value, the sender honours the receive window announced by the remote LLC and keeps up to that
+* many I PDUs unacknowledged, so \ref phlnLlcp_Transport_Socket_Send only blocks once the remote window is full.
+* A remote receive window of zero accepts no I PDU until the remote LLC sends RR, each RR then allows one I PDU.
+*/
+/*@{*/
+#define PHLN_LLCP_RW_DEFAULT                     0x01U                                        /**< RW assumed for the remote LLC if no RW TLV is received. */
+#define PHLN_LLCP_RW_MAX                         0x0FU                                        /**< Largest RW that can be signalled (4 bit value). */
+#ifndef PHLN_LLCP_TLV_RW_VALUE
+#define PHLN_LLCP_TLV_RW_VALUE                   PHLN_LLCP_RW_DEFAULT                         /**< Largest local receive window, i.e. receive slots per socket. */
+#endif /* PHLN_LLCP_TLV_RW_VALUE */
+#if (PHLN_LLCP_TLV_RW_VALUE < 1U) || (PHLN_LLCP_TLV_RW_VALUE > PHLN_LLCP_RW_MAX)
+#error "PHLN_LLCP_TLV_RW_VALUE must be in the range 1 to PHLN_LLCP_RW_MAX"
+#endif
+/*@}*/
+
 /**
 * \brief Socket Type.
 */
@@ -115,14 +140,26 @@ typedef struct phlnLlcp_Transport_Socket{
     struct phlnLlcp_Transport_Socket  *pNext;                                                /**< Pointer to the next Registered Socket. */
     uint8_t                           *pUri;                                                 /**< Pointer to URI (Uniform Resource Identifier). */
     uint32_t                           dwBufLen;                                             /**< The size of the Socket Rx Buffer. */
-    uint8_t                           *pbRxBuffer;                                           /**< Pointer to the Socket Rx buffer. Size of the Socket Buffer should be less than or
-                                                                                                  equal to 248 Bytes and less than HAL Rx Buffer.
-                                                                                                  Note: To achieve better performance Socket Buffer Size should be multiple of 248. */
+    uint8_t                           *pbRxBuffer;                                           /**< Pointer to the data received. For Connection-oriented sockets this is the receive slot
+                                                                                                  of the I PDU returned by the last Socket Receive. */
     uint32_t                           dwLength;                                             /**< Length of the data received. */
+    uint8_t                           *pbRxRing;                                             /**< Socket Rx buffer provided to Socket Init. Size of the Socket Buffer should be less than
+                                                                                                  HAL Rx Buffer. Connection-oriented sockets split it into bRxSlots receive slots.
+                                                                                                  Note: To achieve better performance Socket Buffer Size should be multiple of 248. */
+    uint16_t                           awRxLen[PHLN_LLCP_TLV_RW_VALUE];                      /**< Length of the I PDU buffered in each receive slot. */
+    uint16_t                           wRxSlotLen;                                           /**< Size of one receive slot, largest MIU advertised for the socket. */
+    uint8_t                            bRxSlots;                                             /**< Number of receive slots, this is the local receive window (RW) of the socket. Zero for Connection-less sockets. */
+    uint8_t                            bRxIn;                                                /**< Receive slots filled by the LLCP task, counts modulo 2 * bRxSlots. */
+    uint8_t                            bRxOut;                                               /**< Receive slots handed to the application, counts modulo 2 * bRxSlots. */
+    uint8_t                            bRxWait;                                              /**< Set while the application waits in Socket Receive for the next I PDU. */
+    uint8_t                            bRxAckReq;                                            /**< N(R) of the last RR requested by Socket Receive. */
     uint16_t                           wRMiu;                                                /**< Remote Link's MIU. */
+    uint8_t                            bRRw;                                                 /**< Remote Link's receive window (RW), i.e. number of unacknowledged I PDUs the remote accepts. */
+    uint8_t                            bTxPending;                                           /**< Set while the sender is blocked because the remote receive window is full. */
+    uint8_t                            bRrCredit;                                            /**< Set by RR while the remote receive window is zero, allows one I PDU to be sent. */
     /**
      * Ready to receive flag.
-     * <b>Note</b>: This Flag needs to be set 'True' by the Application after each Socket Receive to receive next Packet as RW (Receive Window) is 1.
+     * <b>Note</b>: This Flag needs to be set 'True' by the Application after each Socket Receive to release the receive slot of the Packet.
      */
     uint8_t                            fReady;
     phlnLlcp_Transport_Socket_Type_t   eSocketType;                                          /**< Based on this, I PDU (Connection-Oriented) or UI PDU (Connection-Less) will be sent. */
@@ -150,6 +187,7 @@ typedef struct /*phlnLlcp_LMDataParams*/{
     uint8_t bOpt;                                                                            /**< Option. */
     uint16_t wMiu;                                                                           /**< maximum information unit (MIU) is max number of octets in information field of an LLC PDU. */
     uint16_t wWks;                                                                           /**< Well-Known Service List. */
+    uint8_t bRw;                                                                             /**< Receive window size (RW). */
     uint16_t bAvailableTlv;                                                                  /**< Bit mask for TLVs availability. */
 } phlnLlcp_LMDataParams_t;
 
@@ -365,6 +403,7 @@ phStatus_t phlnLlcp_Sw_Init(
 #define PHLN_LLCP_TLV_WKS_MASK                   ( 1U << 0x02U )                               /**< Mask used to set WKS in 'bAvailableTlv' of \ref phlnLlcp_LMDataParams_t of Local Link. */
 #define PHLN_LLCP_TLV_LTO_MASK                   ( 1U << 0x03U )                               /**< Mask used to set LTO in 'bAvailableTlv' of \ref phlnLlcp_LMDataParams_t of Local Link. */
 #define PHLN_LLCP_TLV_OPT_MASK                   ( 1U << 0x04U )                               /**< Mask used to set OPT in 'bAvailableTlv' of \ref phlnLlcp_LMDataParams_t of Local Link. */
+#define PHLN_LLCP_TLV_RW_MASK                    ( 1U << 0x05U )                               /**< Mask indicating RW in 'bAvailableTlv' of \ref phlnLlcp_LMDataParams_t after parsing CONNECT/CC TLVs. */
 
 #define PHLN_LLCP_SNL_SUPPORTED_VERSION_VALUE    0x11U                                        /**< SNL needs to be only supported if the agreed version number is v1.1 and greater then v1.1. */
 #define PHLN_LLCP_TLV_VERSION_VALUE              0x12U                                        /**< Major version number is 1, Minor version number is 2. Indicating NFCForum LLPC 1.2 Specification. */
@@ -374,10 +413,19 @@ phStatus_t phlnLlcp_Sw_Init(
 * \name Maximum Information Unit (MIU).
 * Default value of MIU is 248 and HAL Rx Buffer should be approximately around 260bytes or more.
 * This value is chosen for better Performance as MAC will support Frame size of 254Bytes.\n
+* The MIU can be extended up to #PHLN_LLCP_MIU_MAX by defining PHLN_LLCP_MIU in the build configuration. Larger MIU
+* values are received through MAC chaining, so the HAL Rx Buffer has to grow accordingly. The MIU advertised in
+* CONNECT/CC PDUs is limited to the socket buffer size and to the HAL Rx Buffer size available at activation.\n
 * <b>Restriction:</b> NxpNfcRdlib cannot support MIU more than HAL Rx Buffer size.
 */
 /*@{*/
+#define PHLN_LLCP_MIU_MAX                        2175U                                        /**< Largest MIU that can be signalled with the 11 bit MIUX value (0x7FF + 128). */
+#ifndef PHLN_LLCP_MIU
 #define PHLN_LLCP_MIU                            248U                                         /**< Maximum number of bytes in the information field of an LLC PDU that the local LLC is able to receive. */
+#endif /* PHLN_LLCP_MIU */
+#if (PHLN_LLCP_MIU < 128U) || (PHLN_LLCP_MIU > PHLN_LLCP_MIU_MAX)
+#error "PHLN_LLCP_MIU must be in the range 128 to PHLN_LLCP_MIU_MAX"
+#endif
 #define PHLN_LLCP_TLV_MIUX_VALUE                 (PHLN_LLCP_MIU - 128U)                       /**< MIUX (Maximum Information Unit Extension) = Maximum Information Unit (MIU) - 128. */
 /*@}*/
 
@@ -388,13 +436,6 @@ phStatus_t phlnLlcp_Sw_Init(
 */
 #define PHLN_LLCP_SYMM_VALUE                     10U
 
-/**
-* \name Receive Window size of LLCP
-* Receive window size of one indicates that the local LLC will acknowledge every I PDU before accepting additional I PDUs.
-* This is fixed as per design and cannot be changed.
-*/
-#define PHLN_LLCP_TLV_RW_VALUE                   0x01U
-
 /**
 * \name LLCP Device Type.
 * Indicates either NFC Forum Initiator OR Target.
@@ -681,8 +722,8 @@ phStatus_t phlnLlcp_Transport_Socket_ConnectViaUri(
 * \brief Receive is a Blocking call used to receive data on a socket.
 * Can be used by any socket type. Function blocks until dwRxBufferSize bytes have been received or an error occurred.\n
 * Once Data is received on the Socket, User need to set 'fReady' flag of the respective Socket to 'True' in-order to receive next Packet.
-* If the fReady flag is not True then the Link Management will send Receiver Not Ready (RNR) PDU to the remote SAP if it receives an Information
-* PDU for this end point.
+* For Connection-oriented sockets 'fReady' releases the receive slot of the Packet: I PDUs are acknowledged to the remote SAP only after
+* their slot is released, and Receive returns the next buffered I PDU without waiting if one is already available.
 *
 * <em>Sequence of functions that needs to be called prior to this API are as below:</em>\n
 * 1. phlnLlcp_WaitForActivation()\n
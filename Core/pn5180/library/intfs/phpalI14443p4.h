@@ -55,6 +55,16 @@ typedef struct
     uint8_t   bPcbBlockNum;     /**< Current Block-Number; 0/1; */
     uint8_t   bMaxRetryCount;   /**< Maximum Retry count for ISO/IEC 14443-4:2008(E) Rule 4 and 5. */
     uint8_t   bOpeMode;         /**< Operation mode. One of NFC, EMVCo, ISO. */
+    uint8_t * pAsyncTxBuffer;   /**< INF field of the I-Block in flight; kept for Rule 6 retransmission. */
+    uint16_t  wAsyncTxLength;   /**< Length of \c pAsyncTxBuffer. */
+    uint16_t  wAsyncTimeoutPrev;/**< Timeout to restore after a temporary S(WTX) timeout. */
+    uint8_t   bAsyncState;      /**< State of a submitted exchange; #PHPAL_I14443P4_SW_ASYNC_IDLE if none. */
+    uint8_t   bAsyncRetryCount; /**< Retries performed for the submitted exchange. */
+    uint8_t   bAsyncNakCount;   /**< Consecutive R(NAK) sent for the submitted exchange. */
+    uint8_t   bAsyncUseNad;     /**< NAD included in the I-Block in flight. */
+    uint16_t  wStatWtx;         /**< S(WTX) requests answered; see #PHPAL_I14443P4_CONFIG_STAT_WTX. */
+    uint16_t  wStatNak;         /**< R(NAK) sent for a lost or corrupted block; see #PHPAL_I14443P4_CONFIG_STAT_NAK. */
+    uint16_t  wStatRetransmit;  /**< I-Blocks sent again on R(NAK) from the PICC; see #PHPAL_I14443P4_CONFIG_STAT_RETRANSMIT. */
 } phpalI14443p4_Sw_DataParams_t;
 
 /**
@@ -155,6 +165,22 @@ phStatus_t phpalI14443p4_Sw_Init(
  * Default value is #RD_LIB_MODE_NFC.
  * */
 #define PHPAL_I14443P4_CONFIG_OPE_MODE          0x0006U
+
+/**
+* \brief Get / Set the number of S(WTX) requests answered.
+*
+* Exchange statistics count from #phpalI14443p4_Sw_Init across activations
+* and saturate at 0xFFFF; SetConfig loads the counter, usually with 0.
+*/
+#define PHPAL_I14443P4_CONFIG_STAT_WTX          0x0007U
+/**
+* \brief Get / Set the number of R(NAK) sent, ISO/IEC 14443-4:2008(E) Rule 4.
+*/
+#define PHPAL_I14443P4_CONFIG_STAT_NAK          0x0008U
+/**
+* \brief Get / Set the number of I-Blocks retransmitted, ISO/IEC 14443-4:2008(E) Rule 6.
+*/
+#define PHPAL_I14443P4_CONFIG_STAT_RETRANSMIT   0x0009U
 /*@}*/
 
 #ifdef NXPRDLIB_REM_GEN_INTFS
@@ -175,6 +201,12 @@ phStatus_t phpalI14443p4_Sw_Init(
 #define phpalI14443p4_Exchange( pDataParams, wOption, pTxBuffer, wTxLength, ppRxBuffer, pRxLength) \
         phpalI14443p4_Sw_Exchange((phpalI14443p4_Sw_DataParams_t *)pDataParams, wOption, pTxBuffer, wTxLength, ppRxBuffer, pRxLength)
 
+#define phpalI14443p4_ExchangeSubmit( pDataParams, pTxBuffer, wTxLength) \
+        phpalI14443p4_Sw_ExchangeSubmit((phpalI14443p4_Sw_DataParams_t *)pDataParams, pTxBuffer, wTxLength)
+
+#define phpalI14443p4_ExchangePoll( pDataParams, ppRxBuffer, pRxLength) \
+        phpalI14443p4_Sw_ExchangePoll((phpalI14443p4_Sw_DataParams_t *)pDataParams, ppRxBuffer, pRxLength)
+
 #define phpalI14443p4_SetConfig( pDataParams, wConfig, wValue) \
         phpalI14443p4_Sw_SetConfig((phpalI14443p4_Sw_DataParams_t *)pDataParams, wConfig, wValue)
 
@@ -262,6 +294,46 @@ phStatus_t phpalI14443p4_Exchange(
                                   uint16_t * pRxLength      /**< [Out] number of received data bytes. */
                                   );
 
+/**
+* \brief Start a non-blocking ISO14443-4 Data Exchange with Picc.
+*
+* Transmits the complete \c pTxBuffer and returns without waiting for the card.
+* Leading blocks of a frame exceeding FSC are still sent with PCD chaining, only the
+* wait for the response to the last I-Block is deferred to \ref phpalI14443p4_ExchangePoll.
+* No other exchange of this layer or the underlying HAL may be started until the
+* poll function has returned something other than #PH_ERR_SUCCESS_PENDING.
+*
+* \return Status code
+* \retval #PH_ERR_SUCCESS Last I-Block has been transmitted.
+* \retval #PH_ERR_USE_CONDITION An exchange is already in flight.
+* \retval Other Depending on implementation and underlying component.
+*/
+phStatus_t phpalI14443p4_ExchangeSubmit(
+                                        void * pDataParams,     /**< [In] Pointer to this layer's parameter structure. */
+                                        uint8_t * pTxBuffer,    /**< [In] Data to transmit; must stay valid until the exchange completes. */
+                                        uint16_t wTxLength      /**< [In] Length of data to transmit. */
+                                        );
+
+/**
+* \brief Poll a non-blocking ISO14443-4 Data Exchange started with \ref phpalI14443p4_ExchangeSubmit.
+*
+* R(NAK) retries, Rule 6 retransmission and S(WTX) responses are sent from within this function
+* without blocking. On #PH_ERR_SUCCESS_CHAINING the Picc is chaining and the remaining data is
+* retrieved with \ref phpalI14443p4_Exchange using #PH_EXCHANGE_RXCHAINING.
+*
+* \return Status code
+* \retval #PH_ERR_SUCCESS_PENDING Response not yet received, poll again.
+* \retval #PH_ERR_SUCCESS Operation successful.
+* \retval #PH_ERR_SUCCESS_CHAINING First part of a chained response received.
+* \retval #PH_ERR_USE_CONDITION No exchange in flight.
+* \retval Other Depending on implementation and underlying component.
+*/
+phStatus_t phpalI14443p4_ExchangePoll(
+                                      void * pDataParams,       /**< [In] Pointer to this layer's parameter structure. */
+                                      uint8_t ** ppRxBuffer,    /**< [Out] Pointer to received data. */
+                                      uint16_t * pRxLength      /**< [Out] number of received data bytes. */
+                                      );
+
 /**
 * \brief Set configuration parameter.
 * \return Status code
@@ -314,6 +314,13 @@ phStatus_t phpalSli15693_Sw_Init(
  * long waiting time #PHPAL_SLI15693_TIMEOUT_LONG_US.
  * */
 #define PHPAL_SLI15693_EOF_WRITE_ALIKE_WITH_WAIT    0x03U
+
+/**
+ * Send an EOF for write alike commands with the short response timeout, used
+ * to poll a VICC whose programming time is not known. A VICC that is still
+ * programming ignores the EOF, which is reported as #PH_ERR_IO_TIMEOUT.
+ * */
+#define PHPAL_SLI15693_EOF_WRITE_ALIKE_PROBE        0x04U
 /*@}*/
 
 /**
@@ -798,6 +805,7 @@ phStatus_t phpalSli15693_Inventory(
 * \li #PHPAL_SLI15693_EOF_WRITE_ALIKE
 * \li #PHPAL_SLI15693_EOF_NEXT_SLOT_INV_READ
 * \li #PHPAL_SLI15693_EOF_WRITE_ALIKE_WITH_WAIT
+* \li #PHPAL_SLI15693_EOF_WRITE_ALIKE_PROBE
 *
 * \return Status code
 * \retval #PH_ERR_SUCCESS Operation successful.
@@ -46,6 +46,18 @@
 */
 #define PH_MEMLOC_BUF   /* */
 
+/**
+* Space used for large zero-initialised buffers that can live in a second RAM bank
+* (\c .ram2_bss section of the linker script). Empty where no such section exists.
+*/
+#ifndef PH_MEMLOC_RAM2
+#   if defined(__GNUC__) && defined(STM32L431xx)
+#       define PH_MEMLOC_RAM2  __attribute__((section(".ram2_bss")))
+#   else
+#       define PH_MEMLOC_RAM2  /* */
+#   endif
+#endif
+
 /**
 * Space used for fast and frequent access e.g. counters, loop variables).
 */
@@ -56,6 +56,7 @@
 #define PH_ERR_SUCCESS_DESELECTED       ((phStatus_t)0x0074U) /**< DSL is sent for de-selection of target. */
 #define PH_ERR_SUCCESS_RELEASED         ((phStatus_t)0x0075U) /**< RLS is sent for release of target. */
 #define PH_ERR_SUCCESS_INFO_RECEIVED    ((phStatus_t)0x0076U) /**< Received I PDU in response for an I PDU. */
+#define PH_ERR_SUCCESS_PENDING          ((phStatus_t)0x0077U) /**< Asynchronous operation started but not yet completed, poll again. */
 /*@}*/
 
 /** \name Communication Errors
@@ -42,6 +42,51 @@
 //#define PHDRIVER_PIN_DWL          	PN5180_DWL_GPIO_Port, PN5180_DWL_Pin   /**< Download mode pin of Frontend*/
 #define PHDRIVER_PIN_SSEL         	PN5180_NSS_GPIO_Port, PN5180_NSS_Pin
 
+/******************************************************************
+ * Multi-reader configuration
+ * 多个PN5180共用一条SPI总线(SCK/MOSI/MISO)，每个读卡器单独的NSS/BUSY/RST/IRQ
+ * 读卡器0就是上面main.h中的引脚，增加读卡器时在编译选项中重新定义
+ * PHDRIVER_READER_COUNT和PHDRIVER_READER_TABLE
+ ******************************************************************/
+#ifndef PHDRIVER_READER_COUNT
+#define PHDRIVER_READER_COUNT       1U      /**< Number of PN5180 front-ends wired to this MCU. */
+#endif
+
+/** \brief Wiring of one PN5180 front-end. */
+typedef struct phDriver_ReaderCfg
+{
+    SPI_HandleTypeDef * pSpi;               /**< SPI bus the front-end is on. */
+    GPIO_TypeDef * pSselPort;               /**< NSS port. */
+    uint16_t wSselPin;                      /**< NSS pin. */
+    GPIO_TypeDef * pBusyPort;               /**< BUSY port. */
+    uint16_t wBusyPin;                      /**< BUSY pin. */
+    GPIO_TypeDef * pResetPort;              /**< RESET port. */
+    uint16_t wResetPin;                     /**< RESET pin. */
+    GPIO_TypeDef * pIrqPort;                /**< IRQ port. */
+    uint16_t wIrqPin;                       /**< IRQ pin. */
+} phDriver_ReaderCfg_t;
+
+#ifndef PHDRIVER_READER_TABLE
+#define PHDRIVER_READER_TABLE                                                   \
+    {                                                                           \
+        { &hspi3,                                                               \
+          PN5180_NSS_GPIO_Port, PN5180_NSS_Pin,                                 \
+          PN5180_BUSY_GPIO_Port, PN5180_BUSY_Pin,                               \
+          PN5180_RST_GPIO_Port, PN5180_RST_Pin,                                 \
+          PN5180_IRQ_GPIO_Port, PN5180_IRQ_Pin },                               \
+    }
+#endif
+
+/** Reader table, defined in phDriver_STM32L431.c from PHDRIVER_READER_TABLE. */
+extern const phDriver_ReaderCfg_t gkphDriver_ReaderCfg[PHDRIVER_READER_COUNT];
+
+/* Pins of the reader behind a BAL, same (Port, Pin) format as PHDRIVER_PIN_xxx */
+#define PHDRIVER_READER_CFG(pBal)       (((phbalReg_Type_t *)(pBal))->pReaderCfg)
+#define PHDRIVER_PIN_RESET_BAL(pBal)    PHDRIVER_READER_CFG(pBal)->pResetPort, PHDRIVER_READER_CFG(pBal)->wResetPin
+#define PHDRIVER_PIN_IRQ_BAL(pBal)      PHDRIVER_READER_CFG(pBal)->pIrqPort, PHDRIVER_READER_CFG(pBal)->wIrqPin
+#define PHDRIVER_PIN_BUSY_BAL(pBal)     PHDRIVER_READER_CFG(pBal)->pBusyPort, PHDRIVER_READER_CFG(pBal)->wBusyPin
+#define PHDRIVER_PIN_SSEL_BAL(pBal)     PHDRIVER_READER_CFG(pBal)->pSselPort, PHDRIVER_READER_CFG(pBal)->wSselPin
+
 /* These pins are used for EMVCo Interoperability test status indication,
  * not for the generic Reader Library implementation.
  * 状态指示LED - 使用main.h中已定义的LED
@@ -151,6 +196,16 @@
 /* 延时函数声明 - 在tim.c中实现 */
 extern void delay_us(uint16_t us);
 
+/*****************************************************************
+ * Fast boot 快速启动
+ * main()在外设初始化之前已发出复位脉冲，HAL初始化只等待PN5180就绪
+ * (boot_prof.c)，返回0时HAL照常复位
+ ****************************************************************/
+#if defined(BOOT_FAST) && (BOOT_FAST != 0)
+extern uint8_t BootFast_Pn5180WaitReady(void);
+#define PHDRIVER_EARLY_RESET_READY()    BootFast_Pn5180WaitReady()
+#endif
+
 /*****************************************************************
  * 系统配置
  ****************************************************************/
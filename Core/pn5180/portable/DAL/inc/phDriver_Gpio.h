@@ -22,7 +22,12 @@
 #ifndef PHDRIVER_GPIO_H
 #define PHDRIVER_GPIO_H
 
+#if defined(STM32L431xx)
 #include "stm32l431xx.h"	// GPIO_Typedef
+#else
+/* 主机编译(bench)只需要端口指针类型，不引入CMSIS内核头文件 Host builds only pass port pointers around */
+typedef struct phDriver_HostGpio GPIO_TypeDef;
+#endif /* STM32L431xx */
 
 #ifdef __cplusplus
 extern "C" {
@@ -140,6 +145,17 @@ void phDriver_PinWrite(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, uint8_t bValue);
  */
 void phDriver_PinClearIntStatus(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
 
+/**
+ * \brief IRQ-pending state of one front-end in the board reader table, cleared by the call.
+ * Latched from the EXTI line of the reader's IRQ pin; readers whose EXTI line has no handler
+ * are reported from the IRQ pin level, so no SPI access is needed to find the one to service.
+ *
+ * @param[in] bReader      Reader index in the board reader table.
+ *
+ * @return 1 if the reader raised its IRQ, 0 otherwise.
+ */
+uint8_t phDriver_ReaderIrqPending(uint8_t bReader);
+
 /** @}
 * end of phDriver Driver Abstraction Layer (DAL)
 */
@@ -36,6 +36,9 @@ typedef struct
 {
     uint16_t       wId;              /**< Layer ID for this BAL component, NEVER MODIFY! */
     uint8_t        bBalType;         /**< BAL type used by HAL to configure the BAL configured at runtime. */
+#ifdef NXPBUILD__PHDRIVER_STM32
+    const struct phDriver_ReaderCfg * pReaderCfg; /**< Front-end wiring (SPI handle and control pins) this BAL talks to. */
+#endif /* NXPBUILD__PHDRIVER_STM32 */
 } phbalReg_Type_t;
 
 /**
@@ -73,6 +76,7 @@ typedef struct
 #define PHBAL_KERNEL_SPI_MODE_NORMAL        (0x0U)
 #define PHBAL_KERNEL_SPI_MODE_DWL           (0x1U)
 #define PHBAL_CONFIG_SPI_BAUD               (0x2U)
+#define PHBAL_CONFIG_READER                 (0x3U)  /**< Index of the front-end (reader) this BAL drives, see PHDRIVER_READER_COUNT. */
 
 /*@}*/
 
@@ -55,8 +55,63 @@ static volatile uint32_t dwTimerExp;
 // 重写中断回调函数
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim); // 还没实现定义
 
-// 全局变量，用于跟踪IRQ状态
-static volatile uint8_t g_irq_pending = 0;
+// 每个读卡器一位，EXTI中断里置位，phDriver_ReaderIrqPending读取后清除
+static volatile uint32_t g_irq_pending = 0;
+
+/* 各个PN5180读卡器的接线表，读卡器0为main.h中的引脚 */
+const phDriver_ReaderCfg_t gkphDriver_ReaderCfg[PHDRIVER_READER_COUNT] = PHDRIVER_READER_TABLE;
+
+/* 判断是否为某个读卡器的IRQ引脚 */
+static uint8_t phDriver_IsReaderIrqPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+	for (uint32_t i = 0; i < PHDRIVER_READER_COUNT; i++)
+	{
+		if ((gkphDriver_ReaderCfg[i].pIrqPort == GPIOx) && (gkphDriver_ReaderCfg[i].wIrqPin == GPIO_Pin))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/* 读卡器的IRQ是否待处理：EXTI锁存的标志或者IRQ引脚电平 */
+uint8_t phDriver_ReaderIrqPending(uint8_t bReader)
+{
+	uint32_t mask;
+	uint8_t bLevel;
+
+	if (bReader >= PHDRIVER_READER_COUNT)
+	{
+		return false;
+	}
+
+	mask = 1UL << bReader;
+	__disable_irq();
+	if ((g_irq_pending & mask) != 0U)
+	{
+		g_irq_pending &= ~mask;
+		__enable_irq();
+		return true;
+	}
+	__enable_irq();
+
+	/* 没有EXTI处理函数的引脚，按电平判断 */
+	bLevel = (uint8_t)HAL_GPIO_ReadPin(gkphDriver_ReaderCfg[bReader].pIrqPort, gkphDriver_ReaderCfg[bReader].wIrqPin);
+	return (PIN_IRQ_TRIGGER_TYPE == PH_DRIVER_INTERRUPT_FALLINGEDGE) ? (uint8_t)(bLevel == GPIO_PIN_RESET) : bLevel;
+}
+
+/* EXTI回调：同一条EXTI线上的读卡器都标记为待处理 */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+	for (uint32_t i = 0; i < PHDRIVER_READER_COUNT; i++)
+	{
+		if (gkphDriver_ReaderCfg[i].wIrqPin == GPIO_Pin)
+		{
+			g_irq_pending |= 1UL << i;
+		}
+	}
+}
+
 /********************************************************************************
  * PORT/GPIO PIN API's
  *******************************************************************************/
@@ -70,11 +125,11 @@ phStatus_t phDriver_PinConfig(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, phDriver_P
 	if (pPinConfig == NULL)
 	    return PH_DRIVER_ERROR;
 
-	if(GPIO_Pin == PN5180_IRQ_Pin)
+	if(phDriver_IsReaderIrqPin(GPIOx, GPIO_Pin))
 	{
 		GPIO_InitTypeDef GPIO_InitStruct = {0};
 
-		HAL_GPIO_DeInit(PN5180_IRQ_GPIO_Port, PN5180_IRQ_Pin);
+		HAL_GPIO_DeInit(GPIOx, GPIO_Pin);
 
 		mode = (pPinConfig->bPullSelect == PH_DRIVER_PULL_DOWN)?GPIO_PULLDOWN:GPIO_PULLUP;
 		GPIO_InitStruct.Pull = mode;
@@ -97,8 +152,8 @@ phStatus_t phDriver_PinConfig(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, phDriver_P
 				/* Do Nothing. */
 				break;
 	    }
-		GPIO_InitStruct.Pin = PN5180_IRQ_Pin;
-		HAL_GPIO_Init(PN5180_IRQ_GPIO_Port, &GPIO_InitStruct);
+		GPIO_InitStruct.Pin = GPIO_Pin;
+		HAL_GPIO_Init(GPIOx, &GPIO_InitStruct);
 	}
 
     /* 其他GPIO已经在GPIO_INIT实现 */
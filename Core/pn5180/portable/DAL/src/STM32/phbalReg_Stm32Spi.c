@@ -72,6 +72,8 @@ phStatus_t phbalReg_Init(
     // 设置BAL层参数:驱动模块的ID和总线是SPI类型
     ((phbalReg_Type_t *)pDataParams)->wId      = PH_COMP_DRIVER | PHBAL_REG_LPCOPEN_SPI_ID;
     ((phbalReg_Type_t *)pDataParams)->bBalType = PHBAL_REG_TYPE_SPI;
+    // 默认连接读卡器0，多读卡器时通过phbalReg_SetConfig(PHBAL_CONFIG_READER)切换
+    ((phbalReg_Type_t *)pDataParams)->pReaderCfg = &gkphDriver_ReaderCfg[0];
 
     // 初始化SPI（通常在MX_SPI1_Init()中已经完成）
 
@@ -224,8 +226,8 @@ phStatus_t phbalReg_Exchange(
 		txBuf[i] = (pTxBuffer != NULL) ? pTxBuffer[i] : dummyTxByte;
 	}
 
-	// 一次性全双工发送接收
-	if (HAL_SPI_TransmitReceive(&hspi3, txBuf, rxBuf, wTxLength, 1000) != HAL_OK)
+	// 一次性全双工发送接收，使用该读卡器所在的SPI总线
+	if (HAL_SPI_TransmitReceive(((phbalReg_Type_t *)pDataParams)->pReaderCfg->pSpi, txBuf, rxBuf, wTxLength, 1000) != HAL_OK)
 	{
 		return (PH_DRIVER_FAILURE | PH_COMP_DRIVER);
 	}
@@ -275,6 +277,14 @@ phStatus_t phbalReg_SetConfig(
         // 如果需要运行时改变，可以重新配置SPI参数
         // 这里暂时返回成功，实际项目中可能需要重新初始化SPI
         break;
+    case PHBAL_CONFIG_READER:
+        // 选择该BAL驱动的读卡器(NSS/BUSY/RST/IRQ和SPI总线)
+        if (dwValue >= PHDRIVER_READER_COUNT)
+        {
+            return (PH_DRIVER_ERROR | PH_COMP_DRIVER);
+        }
+        ((phbalReg_Type_t *)pDataParams)->pReaderCfg = &gkphDriver_ReaderCfg[dwValue];
+        break;
     default:
         return (PH_DRIVER_ERROR | PH_COMP_DRIVER);
     }
@@ -298,6 +308,9 @@ phStatus_t phbalReg_GetConfig(
         // 需要根据你的实际SPI配置计算
         *pValue = HAL_RCC_GetPCLK2Freq() / 16;  // 假设SPI预分频器为16
         break;
+    case PHBAL_CONFIG_READER:
+        *pValue = (uint32_t)(((phbalReg_Type_t *)pDataParams)->pReaderCfg - &gkphDriver_ReaderCfg[0]);
+        break;
     default:
         return (PH_DRIVER_ERROR | PH_COMP_DRIVER);
     }